@@ -0,0 +1,127 @@
+/* 
+Copyright (c) 2015 Advanced Micro Devices, Inc. All rights reserved.
+ 
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+ 
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+ 
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+
+// custom convolution: the 2D kernels (3xN, 5xN, 7xN, 9xN, MxN) and the separable kernels must all
+// match the reference, which divides sums by scale with truncation towards zero and saturates
+
+#include "unit_tests.h"
+
+static int referenceConvolve(TestImage& src, vx_int32 x, vx_int32 y, vx_int16 * conv, vx_int32 cw, vx_int32 ch, vx_int32 shift)
+{
+	vx_int32 sum = 0, idx = cw * ch - 1;
+	for (vx_int32 i = -(ch >> 1); i <= (ch >> 1); i++) {
+		for (vx_int32 j = -(cw >> 1); j <= (cw >> 1); j++) {
+			sum += (vx_int32)src.row(y + i)[x + j] * (vx_int32)conv[idx--];
+		}
+	}
+	return sum / (1 << shift);
+}
+
+static int convolve2D(TestImage& dst, TestImage& src, vx_int32 offset, vx_int16 * conv, vx_uint32 cw, vx_uint32 ch, vx_int32 shift)
+{
+	vx_uint32 width = dst.width - offset, height = dst.height - ch + 1;
+	vx_uint8 * pSrc = src.row(ch >> 1) + offset;
+	if (dst.bytesPerPixel == 1) {
+		vx_uint8 * pDst = dst.row(ch >> 1) + offset;
+		if (cw == 3) return HafCpu_Convolve_U8_U8_3xN(width, height, pDst, dst.stride, pSrc, src.stride, conv, ch, shift);
+		else if (cw == 5) return HafCpu_Convolve_U8_U8_5xN(width, height, pDst, dst.stride, pSrc, src.stride, conv, ch, shift);
+		else if (cw == 7) return HafCpu_Convolve_U8_U8_7xN(width, height, pDst, dst.stride, pSrc, src.stride, conv, ch, shift);
+		else if (cw == 9) return HafCpu_Convolve_U8_U8_9xN(width, height, pDst, dst.stride, pSrc, src.stride, conv, ch, shift);
+		return HafCpu_Convolve_U8_U8_MxN(width, height, pDst, dst.stride, pSrc, src.stride, conv, cw, ch, shift);
+	}
+	vx_int16 * pDst = (vx_int16 *)dst.row(ch >> 1) + offset;
+	if (cw == 3) return HafCpu_Convolve_S16_U8_3xN(width, height, pDst, dst.stride, pSrc, src.stride, conv, ch, shift);
+	else if (cw == 5) return HafCpu_Convolve_S16_U8_5xN(width, height, pDst, dst.stride, pSrc, src.stride, conv, ch, shift);
+	else if (cw == 7) return HafCpu_Convolve_S16_U8_7xN(width, height, pDst, dst.stride, pSrc, src.stride, conv, ch, shift);
+	else if (cw == 9) return HafCpu_Convolve_S16_U8_9xN(width, height, pDst, dst.stride, pSrc, src.stride, conv, ch, shift);
+	return HafCpu_Convolve_S16_U8_MxN(width, height, pDst, dst.stride, pSrc, src.stride, conv, cw, ch, shift);
+}
+
+static int convolveSeparable(TestImage& dst, TestImage& src, vx_int32 offset, vx_int16 * hCoeff, vx_int16 * vCoeff, vx_uint32 cw, vx_uint32 ch, vx_int32 shift)
+{
+	vx_uint32 width = dst.width - offset, height = dst.height - ch + 1;
+	vx_uint8 * pSrc = src.row(ch >> 1) + offset;
+	vx_uint8 * localData = new vx_uint8[ch * ((width + 15) & ~15) * sizeof(vx_int32) + 16];
+	int status;
+	if (dst.bytesPerPixel == 1)
+		status = HafCpu_ConvolveSeparable_U8_U8(width, height, dst.row(ch >> 1) + offset, dst.stride, pSrc, src.stride, hCoeff, vCoeff, cw, ch, shift, localData);
+	else
+		status = HafCpu_ConvolveSeparable_S16_U8(width, height, (vx_int16 *)dst.row(ch >> 1) + offset, dst.stride, pSrc, src.stride, hCoeff, vCoeff, cw, ch, shift, localData);
+	delete[] localData;
+	return status;
+}
+
+static int compareWithReference(const char * path, TestImage& dst, TestImage& src, vx_int32 offset, vx_int16 * conv, vx_int32 cw, vx_int32 ch, vx_int32 shift)
+{
+	for (vx_int32 y = ch >> 1; y < (vx_int32)dst.height - (ch >> 1); y++) {
+		for (vx_int32 x = offset + (cw >> 1); x < (vx_int32)dst.width - (cw >> 1); x++) {
+			int value = referenceConvolve(src, x, y, conv, cw, ch, shift), result;
+			if (dst.bytesPerPixel == 1) {
+				value = value < 0 ? 0 : (value > 255 ? 255 : value);
+				result = dst.row(y)[x];
+			}
+			else {
+				value = value < SHRT_MIN ? SHRT_MIN : (value > SHRT_MAX ? SHRT_MAX : value);
+				result = ((vx_int16 *)dst.row(y))[x];
+			}
+			TEST_CHECK(result == value, "%s %s %dx%d shift:%d offset:%d mismatch at (%d,%d): %d instead of %d",
+				path, dst.bytesPerPixel == 1 ? "U8" : "S16", cw, ch, shift, offset, x, y, result, value);
+		}
+	}
+	return 0;
+}
+
+int test_convolve()
+{
+	const vx_uint32 width = 101, height = 37;
+	const vx_uint32 sizeList[][2] = { { 3, 3 }, { 3, 5 }, { 5, 5 }, { 7, 3 }, { 9, 9 }, { 1, 5 }, { 1, 9 }, { 9, 1 } };
+	const vx_int32 shiftList[] = { 0, 1, 3, 6 };
+	TestImage src(width, height, 1);
+	src.randomize(42);
+	srand(7);
+	for (vx_uint32 bytesPerPixel = 1; bytesPerPixel <= 2; bytesPerPixel++) {
+		for (size_t s = 0; s < sizeof(sizeList) / sizeof(sizeList[0]); s++) {
+			vx_uint32 cw = sizeList[s][0], ch = sizeList[s][1];
+			for (size_t k = 0; k < sizeof(shiftList) / sizeof(shiftList[0]); k++) {
+				// rank-1 coefficients with mixed signs, so that sums are both positive and negative
+				vx_int16 hCoeff[AGO_MAX_CONVOLUTION_DIM], vCoeff[AGO_MAX_CONVOLUTION_DIM], conv[AGO_MAX_CONVOLUTION_DIM * AGO_MAX_CONVOLUTION_DIM];
+				for (vx_uint32 i = 0; i < cw; i++) hCoeff[i] = (vx_int16)(rand() % 9 - 4);
+				for (vx_uint32 i = 0; i < ch; i++) vCoeff[i] = (vx_int16)(rand() % 9 - 4);
+				hCoeff[0] = -3; vCoeff[ch - 1] = 2;
+				for (vx_uint32 r = 0; r < ch; r++)
+					for (vx_uint32 c = 0; c < cw; c++)
+						conv[r * cw + c] = vCoeff[r] * hCoeff[c];
+				for (vx_int32 offset = 0; offset < 4; offset += 3) {
+					TestImage dst(width, height, bytesPerPixel);
+					TEST_CHECK(!convolve2D(dst, src, offset, conv, cw, ch, shiftList[k]), "2D %ux%u failed", cw, ch);
+					if (compareWithReference("2D", dst, src, offset, conv, cw, ch, shiftList[k]))
+						return -1;
+					TestImage dstSeparable(width, height, bytesPerPixel);
+					TEST_CHECK(!convolveSeparable(dstSeparable, src, offset, hCoeff, vCoeff, cw, ch, shiftList[k]), "separable %ux%u failed", cw, ch);
+					if (compareWithReference("separable", dstSeparable, src, offset, conv, cw, ch, shiftList[k]))
+						return -1;
+				}
+			}
+		}
+	}
+	return 0;
+}
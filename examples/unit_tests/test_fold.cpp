@@ -0,0 +1,162 @@
+/*
+Copyright (c) 2015 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+
+
+// constant folding: nodes that read only uniform images or read-only objects are computed once at verify
+// time and removed, which must give the same output as running them (optimizer flag 0x200); writes to
+// objects marked with VX_DIRECTIVE_AMD_READ_ONLY must fail, since folded results depend on their values.
+
+#include "unit_tests.h"
+
+static const vx_uint32 width = 64, height = 48;
+
+static int accessImage(vx_image image, std::vector<vx_uint8>& pixels, vx_enum usage)
+{
+	vx_rectangle_t rect = { 0, 0, width, height };
+	vx_imagepatch_addressing_t addr;
+	void * ptr = nullptr;
+	pixels.resize(width * height);
+	TEST_CHECK_STATUS(vxAccessImagePatch(image, &rect, 0, &addr, &ptr, usage));
+	for (vx_uint32 y = 0; y < height; y++) {
+		vx_uint8 * row = (vx_uint8 *)ptr + y * addr.stride_y;
+		if (usage == VX_WRITE_ONLY)
+			memcpy(row, &pixels[y * width], width);
+		else
+			memcpy(&pixels[y * width], row, width);
+	}
+	TEST_CHECK_STATUS(vxCommitImagePatch(image, &rect, 0, &addr, ptr));
+	return 0;
+}
+
+// output = (~uniform & input) | lut[uniform]: the Not and TableLookup nodes read only constant data
+static int runGraph(vx_context context, vx_image input, vx_lut lut, vx_uint32 optimizerFlags, std::vector<vx_uint8>& pixels, int& foldCount)
+{
+	vx_pixel_value_t value;
+	value.U8 = 100;
+	vx_graph graph = vxCreateGraph(context);
+	TEST_CHECK_OBJECT(graph);
+	TEST_CHECK_STATUS(vxSetGraphAttribute(graph, VX_GRAPH_ATTRIBUTE_AMD_OPTIMIZER_FLAGS, &optimizerFlags, sizeof(optimizerFlags)));
+	TEST_CHECK_STATUS(vxDirective((vx_reference)graph, VX_DIRECTIVE_AMD_ENABLE_OPTIMIZER_LOG));
+	vx_image uniform = vxCreateUniformImage(context, width, height, VX_DF_IMAGE_U8, &value);
+	vx_image inverted = vxCreateVirtualImage(graph, width, height, VX_DF_IMAGE_U8);
+	vx_image mapped = vxCreateVirtualImage(graph, width, height, VX_DF_IMAGE_U8);
+	vx_image masked = vxCreateVirtualImage(graph, width, height, VX_DF_IMAGE_U8);
+	vx_image output = vxCreateImage(context, width, height, VX_DF_IMAGE_U8);
+	TEST_CHECK_OBJECT(uniform);
+	TEST_CHECK_OBJECT(output);
+	vx_node nodes[] = {
+		vxNotNode(graph, uniform, inverted),
+		vxTableLookupNode(graph, uniform, lut, mapped),
+		vxAndNode(graph, inverted, input, masked),
+		vxOrNode(graph, masked, mapped, output),
+	};
+	for (vx_size i = 0; i < sizeof(nodes) / sizeof(nodes[0]); i++) {
+		TEST_CHECK_OBJECT(nodes[i]);
+		TEST_CHECK_STATUS(vxReleaseNode(&nodes[i]));
+	}
+	TEST_CHECK_STATUS(vxProcessGraph(graph));
+	foldCount = 0;
+	std::vector<AgoOptimizerLogEntry>& log = ((AgoGraph *)graph)->optimizer_log;
+	for (size_t i = 0; i < log.size(); i++) {
+		if (log[i].pass == "fold" && log[i].action == "constant")
+			foldCount++;
+	}
+	if (accessImage(output, pixels, VX_READ_ONLY))
+		return -1;
+	TEST_CHECK_STATUS(vxReleaseGraph(&graph));
+	TEST_CHECK_STATUS(vxReleaseImage(&uniform));
+	TEST_CHECK_STATUS(vxReleaseImage(&inverted));
+	TEST_CHECK_STATUS(vxReleaseImage(&mapped));
+	TEST_CHECK_STATUS(vxReleaseImage(&masked));
+	TEST_CHECK_STATUS(vxReleaseImage(&output));
+	return 0;
+}
+
+int test_fold()
+{
+	vx_context context = vxCreateContext();
+	TEST_CHECK_OBJECT(context);
+	vx_image input = vxCreateImage(context, width, height, VX_DF_IMAGE_U8);
+	vx_lut lut = vxCreateLUT(context, VX_TYPE_UINT8, 256);
+	TEST_CHECK_OBJECT(input);
+	TEST_CHECK_OBJECT(lut);
+	std::vector<vx_uint8> pixels(width * height), table(256);
+	srand(1);
+	for (size_t i = 0; i < pixels.size(); i++)
+		pixels[i] = (vx_uint8)(rand() & 0xff);
+	if (accessImage(input, pixels, VX_WRITE_ONLY))
+		return -1;
+	for (size_t i = 0; i < table.size(); i++)
+		table[i] = (vx_uint8)(i ^ 0x5a);
+	TEST_CHECK_STATUS(vxCopyLUT(lut, &table[0], VX_WRITE_ONLY, VX_MEMORY_TYPE_HOST));
+	TEST_CHECK_STATUS(vxDirective((vx_reference)lut, VX_DIRECTIVE_AMD_READ_ONLY));
+
+	// folded graph must match the graph that runs every node
+	std::vector<vx_uint8> folded, reference;
+	int foldCount = 0, referenceFoldCount = 0;
+	if (runGraph(context, input, lut, 0, folded, foldCount))
+		return -1;
+	if (runGraph(context, input, lut, AGO_GRAPH_OPTIMIZER_FLAG_NO_CONSTANT_FOLDING, reference, referenceFoldCount))
+		return -1;
+	TEST_CHECK(foldCount == 2, "folded %d nodes instead of 2", foldCount);
+	TEST_CHECK(referenceFoldCount == 0, "folded %d nodes with constant folding disabled", referenceFoldCount);
+	for (vx_uint32 i = 0; i < width * height; i++) {
+		vx_uint8 expected = (vx_uint8)((~100 & pixels[i]) | table[100]);
+		TEST_CHECK(folded[i] == reference[i], "folded output mismatch at (%d,%d): %d instead of %d", i % width, i / width, folded[i], reference[i]);
+		TEST_CHECK(reference[i] == expected, "output mismatch at (%d,%d): %d instead of %d", i % width, i / width, reference[i], expected);
+	}
+
+	// writes to read-only objects fail, reads still work
+	vx_status status = vxCopyLUT(lut, &table[0], VX_WRITE_ONLY, VX_MEMORY_TYPE_HOST);
+	TEST_CHECK(status == VX_ERROR_NOT_SUPPORTED, "write to read-only LUT returned %d instead of %d", status, VX_ERROR_NOT_SUPPORTED);
+	vx_map_id mapId;
+	void * ptr = nullptr;
+	status = vxMapLUT(lut, &mapId, &ptr, VX_READ_AND_WRITE, VX_MEMORY_TYPE_HOST, 0);
+	TEST_CHECK(status == VX_ERROR_NOT_SUPPORTED, "read-write map of read-only LUT returned %d instead of %d", status, VX_ERROR_NOT_SUPPORTED);
+	TEST_CHECK_STATUS(vxCopyLUT(lut, &table[0], VX_READ_ONLY, VX_MEMORY_TYPE_HOST));
+
+	vx_int32 value = 3, newValue = 5;
+	vx_scalar scalar = vxCreateScalar(context, VX_TYPE_INT32, &value);
+	TEST_CHECK_OBJECT(scalar);
+	TEST_CHECK_STATUS(vxDirective((vx_reference)scalar, VX_DIRECTIVE_AMD_READ_ONLY));
+	status = vxWriteScalarValue(scalar, &newValue);
+	TEST_CHECK(status == VX_ERROR_NOT_SUPPORTED, "write to read-only scalar returned %d instead of %d", status, VX_ERROR_NOT_SUPPORTED);
+	status = vxCopyScalar(scalar, &newValue, VX_WRITE_ONLY, VX_MEMORY_TYPE_HOST);
+	TEST_CHECK(status == VX_ERROR_NOT_SUPPORTED, "copy to read-only scalar returned %d instead of %d", status, VX_ERROR_NOT_SUPPORTED);
+	TEST_CHECK_STATUS(vxReadScalarValue(scalar, &newValue));
+	TEST_CHECK(newValue == value, "read-only scalar changed from %d to %d", value, newValue);
+
+	vx_int32 thresholdValue = 128;
+	vx_threshold threshold = vxCreateThreshold(context, VX_THRESHOLD_TYPE_BINARY, VX_TYPE_UINT8);
+	TEST_CHECK_OBJECT(threshold);
+	TEST_CHECK_STATUS(vxSetThresholdAttribute(threshold, VX_THRESHOLD_ATTRIBUTE_THRESHOLD_VALUE, &thresholdValue, sizeof(thresholdValue)));
+	TEST_CHECK_STATUS(vxDirective((vx_reference)threshold, VX_DIRECTIVE_AMD_READ_ONLY));
+	status = vxSetThresholdAttribute(threshold, VX_THRESHOLD_ATTRIBUTE_THRESHOLD_VALUE, &newValue, sizeof(newValue));
+	TEST_CHECK(status == VX_ERROR_NOT_SUPPORTED, "write to read-only threshold returned %d instead of %d", status, VX_ERROR_NOT_SUPPORTED);
+
+	TEST_CHECK_STATUS(vxReleaseThreshold(&threshold));
+	TEST_CHECK_STATUS(vxReleaseScalar(&scalar));
+	TEST_CHECK_STATUS(vxReleaseLUT(&lut));
+	TEST_CHECK_STATUS(vxReleaseImage(&input));
+	TEST_CHECK_STATUS(vxReleaseContext(&context));
+	return 0;
+}
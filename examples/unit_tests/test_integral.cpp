@@ -0,0 +1,67 @@
+/* 
+Copyright (c) 2015 Advanced Micro Devices, Inc. All rights reserved.
+ 
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+ 
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+ 
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+
+// integral image: the band-parallel kernel with its carry fix-up must match the serial kernel and
+// a plain reference for any band count, including bands of a single row
+
+#include "unit_tests.h"
+
+int test_integral()
+{
+	const vx_uint32 sizeList[][2] = { { 1, 1 }, { 3, 2 }, { 17, 5 }, { 64, 16 }, { 641, 37 }, { 1023, 70 } };
+	const vx_uint32 bandCountList[] = { 1, 2, 3, 7, 16, AGO_MAX_CPU_THREADS };
+	for (size_t s = 0; s < sizeof(sizeList) / sizeof(sizeList[0]); s++) {
+		vx_uint32 width = sizeList[s][0], height = sizeList[s][1];
+		TestImage src(width, height, 1);
+		src.randomize(width * 31 + height);
+		// plain reference
+		std::vector<vx_uint32> ref(width * height);
+		for (vx_uint32 y = 0; y < height; y++) {
+			vx_uint32 rowSum = 0;
+			for (vx_uint32 x = 0; x < width; x++) {
+				rowSum += src.row(y)[x];
+				ref[y * width + x] = rowSum + (y > 0 ? ref[(y - 1) * width + x] : 0);
+			}
+		}
+		TestImage dstSerial(width, height, 4);
+		TEST_CHECK(!HafCpu_IntegralImage_U32_U8(width, height, (vx_uint32 *)dstSerial.row(0), dstSerial.stride, src.row(0), src.stride), "serial %ux%u failed", width, height);
+		for (vx_uint32 y = 0; y < height; y++) {
+			for (vx_uint32 x = 0; x < width; x++) {
+				vx_uint32 value = ((vx_uint32 *)dstSerial.row(y))[x];
+				TEST_CHECK(value == ref[y * width + x], "serial %ux%u mismatch at (%u,%u): %u instead of %u", width, height, x, y, value, ref[y * width + x]);
+			}
+		}
+		for (size_t b = 0; b < sizeof(bandCountList) / sizeof(bandCountList[0]); b++) {
+			TestImage dst(width, height, 4);
+			TEST_CHECK(!HafCpu_IntegralImage_U32_U8_Parallel(width, height, (vx_uint32 *)dst.row(0), dst.stride, src.row(0), src.stride, bandCountList[b]),
+				"parallel %ux%u bands:%u failed", width, height, bandCountList[b]);
+			for (vx_uint32 y = 0; y < height; y++) {
+				for (vx_uint32 x = 0; x < width; x++) {
+					vx_uint32 value = ((vx_uint32 *)dst.row(y))[x];
+					TEST_CHECK(value == ref[y * width + x], "parallel %ux%u bands:%u mismatch at (%u,%u): %u instead of %u",
+						width, height, bandCountList[b], x, y, value, ref[y * width + x]);
+				}
+			}
+		}
+	}
+	return 0;
+}
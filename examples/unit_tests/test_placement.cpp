@@ -0,0 +1,171 @@
+/*
+Copyright (c) 2015 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+
+// CPU/GPU placement with the target cost model: on random graphs with CPU-only, GPU-only, affinity and
+// virtual data, the min-cut placement must cost the same as the best placement found by brute force.
+// GPU support is marked on nodes directly, so that the test doesn't need an OpenCL device.
+
+#include "unit_tests.h"
+#include <math.h>
+
+static double placementCost(AgoContext * context, std::vector<AgoNode *>& nodes, std::vector<vx_uint32>& target)
+{
+	// frame time of a placement: node costs, and a data sync for each producer with consumers on the other device
+	AgoTargetCostModel& model = context->target_cost_model;
+	const vx_uint32 host = (vx_uint32)nodes.size();
+	double cost = 0;
+	std::map<AgoData *, std::pair<std::vector<vx_uint32>, std::vector<vx_uint32>>> dataAccess;
+	for (vx_uint32 i = 0; i < nodes.size(); i++) {
+		AgoNode * node = nodes[i];
+		double pixels = 1;
+		for (vx_uint32 arg = 0; arg < node->paramCount; arg++) {
+			AgoData * data = node->paramList[arg];
+			if (data) {
+				pixels = std::max(pixels, (double)data->u.img.width * data->u.img.height);
+				if (node->akernel->argConfig[arg] & AGO_KERNEL_ARG_OUTPUT_FLAG)
+					dataAccess[data].first.push_back(i);
+				if (node->akernel->argConfig[arg] & AGO_KERNEL_ARG_INPUT_FLAG)
+					dataAccess[data].second.push_back(i);
+			}
+		}
+		AgoTargetCost& kernelCost = model.kernel_cost[node->akernel->name];
+		cost += pixels * (target[i] == AGO_KERNEL_FLAG_DEVICE_GPU ? kernelCost.gpu : kernelCost.cpu);
+	}
+	for (auto& it : dataAccess) {
+		std::vector<vx_uint32>& producers = it.second.first;
+		std::vector<vx_uint32>& consumers = it.second.second;
+		if (!it.first->isVirtual) {
+			if (producers.empty()) producers.push_back(host);
+			else consumers.push_back(host);
+		}
+		for (vx_uint32 p : producers) {
+			vx_uint32 producerTarget = (p == host) ? AGO_KERNEL_FLAG_DEVICE_CPU : target[p];
+			bool sync = false;
+			for (vx_uint32 c : consumers) {
+				if (c != p && ((c == host) ? AGO_KERNEL_FLAG_DEVICE_CPU : target[c]) != producerTarget)
+					sync = true;
+			}
+			if (sync)
+				cost += model.transfer_nsec_latency + model.transfer_nsec_per_byte * it.first->size;
+		}
+	}
+	return cost;
+}
+
+static int testPlacement(vx_context context, unsigned int seed)
+{
+	srand(seed);
+	AgoContext * acontext = (AgoContext *)context;
+	AgoTargetCostModel& model = acontext->target_cost_model;
+	model.calibrated = true;
+	model.transfer_nsec_per_byte = (float)(rand() % 100) * 0.01f;
+	model.transfer_nsec_latency = (float)(rand() % 100) * 1000.0f;
+	const char * kernelNames[] = {
+		"org.khronos.openvx.not", "org.khronos.openvx.and", "org.khronos.openvx.or", "org.khronos.openvx.absdiff",
+		"org.khronos.openvx.box_3x3", "org.khronos.openvx.gaussian_3x3", "org.khronos.openvx.median_3x3",
+	};
+	for (size_t k = 0; k < sizeof(kernelNames) / sizeof(kernelNames[0]); k++) {
+		AgoTargetCost cost = { (float)(rand() % 100) * 0.01f, (float)(rand() % 100) * 0.01f };
+		model.kernel_cost[kernelNames[k]] = cost;
+	}
+	vx_uint32 width = 16 << (rand() % 4), height = 16 << (rand() % 4);
+	vx_graph graph = vxCreateGraph(context);
+	TEST_CHECK_OBJECT(graph);
+	// random graph: each node reads earlier images and writes a new image, which is virtual or not
+	std::vector<vx_image> images;
+	for (int i = 0; i < 2; i++) {
+		images.push_back(vxCreateImage(context, width, height, VX_DF_IMAGE_U8));
+		TEST_CHECK_OBJECT(images.back());
+	}
+	int nodeCount = 1 + rand() % 12;
+	for (int i = 0; i < nodeCount; i++) {
+		vx_image in1 = images[rand() % images.size()], in2 = images[rand() % images.size()];
+		vx_image out = (rand() & 1) ? vxCreateVirtualImage(graph, width, height, VX_DF_IMAGE_U8) : vxCreateImage(context, width, height, VX_DF_IMAGE_U8);
+		TEST_CHECK_OBJECT(out);
+		images.push_back(out);
+		vx_node node = nullptr;
+		switch (rand() % 7) {
+		case 0: node = vxNotNode(graph, in1, out); break;
+		case 1: node = vxAndNode(graph, in1, in2, out); break;
+		case 2: node = vxOrNode(graph, in1, in2, out); break;
+		case 3: node = vxAbsDiffNode(graph, in1, in2, out); break;
+		case 4: node = vxBox3x3Node(graph, in1, out); break;
+		case 5: node = vxGaussian3x3Node(graph, in1, out); break;
+		default: node = vxMedian3x3Node(graph, in1, out); break;
+		}
+		TEST_CHECK_OBJECT(node);
+		TEST_CHECK_STATUS(vxReleaseNode(&node));
+	}
+	// mark supported targets and affinity
+	std::vector<AgoNode *> nodes;
+	for (AgoNode * node = ((AgoGraph *)graph)->nodeList.head; node; node = node->next) {
+		int choice = rand() % 10;
+		node->target_support_flags = AGO_KERNEL_FLAG_DEVICE_CPU | AGO_KERNEL_FLAG_DEVICE_GPU;
+		if (choice == 0) node->target_support_flags = AGO_KERNEL_FLAG_DEVICE_CPU;
+		else if (choice == 1) node->target_support_flags = AGO_KERNEL_FLAG_DEVICE_GPU;
+		else if (choice == 2) node->attr_affinity.device_type = AGO_KERNEL_FLAG_DEVICE_CPU;
+		else if (choice == 3) node->attr_affinity.device_type = AGO_KERNEL_FLAG_DEVICE_GPU;
+		nodes.push_back(node);
+	}
+	std::map<AgoNode *, vx_uint32> nodeTarget;
+	TEST_CHECK(!agoOptimizeDramaAllocPlaceTargets((AgoGraph *)graph, nodeTarget), "placement failed");
+	// placement from min-cut, and brute force over nodes that can run on either device
+	std::vector<vx_uint32> target(nodes.size()), fixed(nodes.size());
+	std::vector<vx_uint32> freeNodes;
+	for (vx_uint32 i = 0; i < nodes.size(); i++) {
+		AgoNode * node = nodes[i];
+		vx_uint32 flags = node->target_support_flags;
+		if (node->attr_affinity.device_type && (flags & node->attr_affinity.device_type))
+			flags = node->attr_affinity.device_type;
+		if (flags == (AGO_KERNEL_FLAG_DEVICE_CPU | AGO_KERNEL_FLAG_DEVICE_GPU)) {
+			TEST_CHECK(nodeTarget.count(node), "node#%u without affinity has no target", i);
+			freeNodes.push_back(i);
+		}
+		fixed[i] = (flags & AGO_KERNEL_FLAG_DEVICE_CPU) ? AGO_KERNEL_FLAG_DEVICE_CPU : AGO_KERNEL_FLAG_DEVICE_GPU;
+		target[i] = nodeTarget.count(node) ? nodeTarget[node] : fixed[i];
+		TEST_CHECK(target[i] & flags, "node#%u placed on unsupported target", i);
+	}
+	double cutCost = placementCost(acontext, nodes, target), bestCost = 1e30;
+	for (vx_uint32 mask = 0; mask < (1u << freeNodes.size()); mask++) {
+		std::vector<vx_uint32> trial = fixed;
+		for (size_t i = 0; i < freeNodes.size(); i++)
+			trial[freeNodes[i]] = (mask & (1u << i)) ? AGO_KERNEL_FLAG_DEVICE_GPU : AGO_KERNEL_FLAG_DEVICE_CPU;
+		bestCost = std::min(bestCost, placementCost(acontext, nodes, trial));
+	}
+	TEST_CHECK(fabs(cutCost - bestCost) <= 1e-6 * std::max(1.0, bestCost), "seed:%u nodes:%d min-cut cost %.3f instead of %.3f", seed, nodeCount, cutCost, bestCost);
+	for (size_t i = 0; i < images.size(); i++)
+		TEST_CHECK_STATUS(vxReleaseImage(&images[i]));
+	TEST_CHECK_STATUS(vxReleaseGraph(&graph));
+	return 0;
+}
+
+int test_placement()
+{
+	vx_context context = vxCreateContext();
+	TEST_CHECK_OBJECT(context);
+	for (unsigned int seed = 1; seed <= 200; seed++) {
+		if (testPlacement(context, seed))
+			return -1;
+	}
+	TEST_CHECK_STATUS(vxReleaseContext(&context));
+	return 0;
+}
@@ -0,0 +1,149 @@
+/*
+Copyright (c) 2015 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+
+
+// rebinding node parameters of a verified graph: scalars whose values picked kernels during graph
+// optimization (e.g., Harris and Canny gradient_size) must be rejected, while scalars that are only
+// read at execute time (e.g., Harris sensitivity) must rebind and give the same result as a new graph.
+// With AGO_GRAPH_CACHE_DIR, the second verify of the same graph loads the optimized graph from cache,
+// which must reject the same rebinds.
+
+#include "unit_tests.h"
+
+static const vx_uint32 width = 64, height = 48;
+
+static int fillImage(vx_image image, unsigned int seed)
+{
+	vx_rectangle_t rect = { 0, 0, width, height };
+	vx_imagepatch_addressing_t addr;
+	void * ptr = nullptr;
+	TEST_CHECK_STATUS(vxAccessImagePatch(image, &rect, 0, &addr, &ptr, VX_WRITE_ONLY));
+	srand(seed);
+	for (vx_uint32 y = 0; y < height; y++)
+		for (vx_uint32 x = 0; x < width; x++)
+			((vx_uint8 *)ptr)[y * addr.stride_y + x] = (vx_uint8)(rand() & 0xff);
+	TEST_CHECK_STATUS(vxCommitImagePatch(image, &rect, 0, &addr, ptr));
+	return 0;
+}
+
+static int harrisCorners(vx_context context, vx_image input, vx_float32 sensitivity, vx_size& numCorners)
+{
+	vx_float32 strength = 0.0001f, distance = 3.0f;
+	vx_graph graph = vxCreateGraph(context);
+	vx_scalar scalarStrength = vxCreateScalar(context, VX_TYPE_FLOAT32, &strength);
+	vx_scalar scalarDistance = vxCreateScalar(context, VX_TYPE_FLOAT32, &distance);
+	vx_scalar scalarSensitivity = vxCreateScalar(context, VX_TYPE_FLOAT32, &sensitivity);
+	vx_array corners = vxCreateArray(context, VX_TYPE_KEYPOINT, width * height);
+	vx_scalar scalarCorners = vxCreateScalar(context, VX_TYPE_SIZE, &numCorners);
+	vx_node node = vxHarrisCornersNode(graph, input, scalarStrength, scalarDistance, scalarSensitivity, 3, 3, corners, scalarCorners);
+	TEST_CHECK_OBJECT(node);
+	TEST_CHECK_STATUS(vxProcessGraph(graph));
+	TEST_CHECK_STATUS(vxReadScalarValue(scalarCorners, &numCorners));
+	TEST_CHECK_STATUS(vxReleaseNode(&node));
+	TEST_CHECK_STATUS(vxReleaseGraph(&graph));
+	TEST_CHECK_STATUS(vxReleaseScalar(&scalarStrength));
+	TEST_CHECK_STATUS(vxReleaseScalar(&scalarDistance));
+	TEST_CHECK_STATUS(vxReleaseScalar(&scalarSensitivity));
+	TEST_CHECK_STATUS(vxReleaseScalar(&scalarCorners));
+	TEST_CHECK_STATUS(vxReleaseArray(&corners));
+	return 0;
+}
+
+int test_rebind()
+{
+	vx_context context = vxCreateContext();
+	TEST_CHECK_OBJECT(context);
+	vx_image input = vxCreateImage(context, width, height, VX_DF_IMAGE_U8);
+	vx_image edges = vxCreateImage(context, width, height, VX_DF_IMAGE_U8);
+	TEST_CHECK_OBJECT(input);
+	TEST_CHECK_OBJECT(edges);
+	if (fillImage(input, 1))
+		return -1;
+
+	// Harris corners: gradient_size and block_size pick kernels, sensitivity is read at execute time
+	vx_float32 strength = 0.0001f, distance = 3.0f, sensitivity = 0.04f, newSensitivity = 0.15f;
+	vx_int32 gradientSize = 3, newGradientSize = 5, blockSize = 3;
+	vx_size numCorners = 0, expectedCorners = 0;
+	vx_graph graph = vxCreateGraph(context);
+	TEST_CHECK_OBJECT(graph);
+	vx_scalar scalarStrength = vxCreateScalar(context, VX_TYPE_FLOAT32, &strength);
+	vx_scalar scalarDistance = vxCreateScalar(context, VX_TYPE_FLOAT32, &distance);
+	vx_scalar scalarSensitivity = vxCreateScalar(context, VX_TYPE_FLOAT32, &sensitivity);
+	vx_scalar scalarNewSensitivity = vxCreateScalar(context, VX_TYPE_FLOAT32, &newSensitivity);
+	vx_scalar scalarNewGradientSize = vxCreateScalar(context, VX_TYPE_INT32, &newGradientSize);
+	vx_array corners = vxCreateArray(context, VX_TYPE_KEYPOINT, width * height);
+	vx_scalar scalarCorners = vxCreateScalar(context, VX_TYPE_SIZE, &numCorners);
+	vx_node harris = vxHarrisCornersNode(graph, input, scalarStrength, scalarDistance, scalarSensitivity, gradientSize, blockSize, corners, scalarCorners);
+	TEST_CHECK_OBJECT(harris);
+	TEST_CHECK_STATUS(vxVerifyGraph(graph));
+	vx_status status = vxSetParameterByIndex(harris, 4, (vx_reference)scalarNewGradientSize);
+	TEST_CHECK(status == VX_ERROR_NOT_SUPPORTED, "rebind of Harris gradient_size returned %d instead of %d", status, VX_ERROR_NOT_SUPPORTED);
+	TEST_CHECK_STATUS(vxSetParameterByIndex(harris, 3, (vx_reference)scalarNewSensitivity));
+	TEST_CHECK_STATUS(vxProcessGraph(graph));
+	TEST_CHECK_STATUS(vxReadScalarValue(scalarCorners, &numCorners));
+	if (harrisCorners(context, input, newSensitivity, expectedCorners))
+		return -1;
+	TEST_CHECK(numCorners == expectedCorners, "Harris with rebound sensitivity found %d corners instead of %d", (int)numCorners, (int)expectedCorners);
+	TEST_CHECK_STATUS(vxReleaseNode(&harris));
+	TEST_CHECK_STATUS(vxReleaseGraph(&graph));
+
+	// Canny edge detector: gradient_size picks the Sobel kernel
+	vx_int32 lower = 40, upper = 120;
+	vx_threshold hyst = vxCreateThreshold(context, VX_THRESHOLD_TYPE_RANGE, VX_TYPE_UINT8);
+	TEST_CHECK_OBJECT(hyst);
+	TEST_CHECK_STATUS(vxSetThresholdAttribute(hyst, VX_THRESHOLD_ATTRIBUTE_THRESHOLD_LOWER, &lower, sizeof(lower)));
+	TEST_CHECK_STATUS(vxSetThresholdAttribute(hyst, VX_THRESHOLD_ATTRIBUTE_THRESHOLD_UPPER, &upper, sizeof(upper)));
+	const char * cacheDir = getenv("AGO_GRAPH_CACHE_DIR");
+	for (int run = 0; run < 2; run++) {
+		graph = vxCreateGraph(context);
+		TEST_CHECK_OBJECT(graph);
+		TEST_CHECK_STATUS(vxDirective((vx_reference)graph, VX_DIRECTIVE_AMD_ENABLE_OPTIMIZER_LOG));
+		vx_node canny = vxCannyEdgeDetectorNode(graph, input, hyst, gradientSize, VX_NORM_L1, edges);
+		TEST_CHECK_OBJECT(canny);
+		TEST_CHECK_STATUS(vxVerifyGraph(graph));
+		if (run > 0 && cacheDir && cacheDir[0]) {
+			bool cacheHit = false;
+			std::vector<AgoOptimizerLogEntry>& log = ((AgoGraph *)graph)->optimizer_log;
+			for (size_t i = 0; i < log.size(); i++)
+				cacheHit = cacheHit || (log[i].pass == "cache" && log[i].action == "hit");
+			TEST_CHECK(cacheHit, "Canny graph wasn't loaded from graph cache in %s", cacheDir);
+		}
+		status = vxSetParameterByIndex(canny, 2, (vx_reference)scalarNewGradientSize);
+		TEST_CHECK(status == VX_ERROR_NOT_SUPPORTED, "rebind of Canny gradient_size returned %d instead of %d", status, VX_ERROR_NOT_SUPPORTED);
+		TEST_CHECK_STATUS(vxProcessGraph(graph));
+		TEST_CHECK_STATUS(vxReleaseNode(&canny));
+		TEST_CHECK_STATUS(vxReleaseGraph(&graph));
+	}
+
+	TEST_CHECK_STATUS(vxReleaseThreshold(&hyst));
+	TEST_CHECK_STATUS(vxReleaseScalar(&scalarStrength));
+	TEST_CHECK_STATUS(vxReleaseScalar(&scalarDistance));
+	TEST_CHECK_STATUS(vxReleaseScalar(&scalarSensitivity));
+	TEST_CHECK_STATUS(vxReleaseScalar(&scalarNewSensitivity));
+	TEST_CHECK_STATUS(vxReleaseScalar(&scalarNewGradientSize));
+	TEST_CHECK_STATUS(vxReleaseScalar(&scalarCorners));
+	TEST_CHECK_STATUS(vxReleaseArray(&corners));
+	TEST_CHECK_STATUS(vxReleaseImage(&input));
+	TEST_CHECK_STATUS(vxReleaseImage(&edges));
+	TEST_CHECK_STATUS(vxReleaseContext(&context));
+	return 0;
+}
@@ -0,0 +1,155 @@
+/*
+Copyright (c) 2015 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+
+
+// required regions: CPU nodes compute only the part of their virtual outputs that later nodes read,
+// which must give the same crops as computing whole images (optimizer flag 0x400), for neighborhood
+// kernels with a halo, fused element-wise chains, and ROI images of virtual images.
+
+#include "unit_tests.h"
+
+static const vx_uint32 width = 128, height = 96;
+static const vx_rectangle_t cropRect = { 40, 30, 72, 62 };
+
+static int accessImage(vx_image image, vx_uint32 w, vx_uint32 h, std::vector<vx_uint8>& pixels, vx_enum usage)
+{
+	vx_rectangle_t rect = { 0, 0, w, h };
+	vx_imagepatch_addressing_t addr;
+	void * ptr = nullptr;
+	pixels.resize(w * h);
+	TEST_CHECK_STATUS(vxAccessImagePatch(image, &rect, 0, &addr, &ptr, usage));
+	for (vx_uint32 y = 0; y < h; y++) {
+		vx_uint8 * row = (vx_uint8 *)ptr + y * addr.stride_y;
+		if (usage == VX_WRITE_ONLY)
+			memcpy(row, &pixels[y * w], w);
+		else
+			memcpy(&pixels[y * w], row, w);
+	}
+	TEST_CHECK_STATUS(vxCommitImagePatch(image, &rect, 0, &addr, ptr));
+	return 0;
+}
+
+static int countLogEntries(vx_graph graph, const char * pass, const char * action)
+{
+	int count = 0;
+	std::vector<AgoOptimizerLogEntry>& log = ((AgoGraph *)graph)->optimizer_log;
+	for (size_t i = 0; i < log.size(); i++) {
+		if (log[i].pass == pass && log[i].action == action)
+			count++;
+	}
+	return count;
+}
+
+// blurred = Gaussian3x3(~(Box3x3(input) + input)), cropElemwise = ~blurred[cropRect], cropBox = Box3x3(blurred[cropRect])
+static int runGraph(vx_context context, vx_image input, vx_uint32 optimizerFlags,
+	std::vector<vx_uint8>& cropElemwise, std::vector<vx_uint8>& cropBox, int& regionCount)
+{
+	vx_uint32 cropWidth = cropRect.end_x - cropRect.start_x, cropHeight = cropRect.end_y - cropRect.start_y;
+	vx_graph graph = vxCreateGraph(context);
+	TEST_CHECK_OBJECT(graph);
+	TEST_CHECK_STATUS(vxSetGraphAttribute(graph, VX_GRAPH_ATTRIBUTE_AMD_OPTIMIZER_FLAGS, &optimizerFlags, sizeof(optimizerFlags)));
+	TEST_CHECK_STATUS(vxDirective((vx_reference)graph, VX_DIRECTIVE_AMD_ENABLE_OPTIMIZER_LOG));
+	vx_image box = vxCreateVirtualImage(graph, width, height, VX_DF_IMAGE_U8);
+	vx_image sum = vxCreateVirtualImage(graph, width, height, VX_DF_IMAGE_U8);
+	vx_image inverted = vxCreateVirtualImage(graph, width, height, VX_DF_IMAGE_U8);
+	vx_image blurred = vxCreateVirtualImage(graph, width, height, VX_DF_IMAGE_U8);
+	vx_image roi = vxCreateImageFromROI(blurred, &cropRect);
+	vx_image outputElemwise = vxCreateImage(context, cropWidth, cropHeight, VX_DF_IMAGE_U8);
+	vx_image outputBox = vxCreateImage(context, cropWidth, cropHeight, VX_DF_IMAGE_U8);
+	TEST_CHECK_OBJECT(roi);
+	TEST_CHECK_OBJECT(outputElemwise);
+	TEST_CHECK_OBJECT(outputBox);
+	vx_node nodes[] = {
+		vxBox3x3Node(graph, input, box),
+		vxAddNode(graph, box, input, VX_CONVERT_POLICY_SATURATE, sum),
+		vxNotNode(graph, sum, inverted),
+		vxGaussian3x3Node(graph, inverted, blurred),
+		vxNotNode(graph, roi, outputElemwise),
+		vxBox3x3Node(graph, roi, outputBox),
+	};
+	for (vx_size i = 0; i < sizeof(nodes) / sizeof(nodes[0]); i++) {
+		TEST_CHECK_OBJECT(nodes[i]);
+		TEST_CHECK_STATUS(vxReleaseNode(&nodes[i]));
+	}
+	TEST_CHECK_STATUS(vxProcessGraph(graph));
+	regionCount = countLogEntries(graph, "alloc", "region");
+	if (!(optimizerFlags & AGO_GRAPH_OPTIMIZER_FLAG_NO_ELEMWISE_FUSION)) {
+		TEST_CHECK(countLogEntries(graph, "merge", "fuse") > 0, "element-wise chain wasn't fused");
+	}
+	if (accessImage(outputElemwise, cropWidth, cropHeight, cropElemwise, VX_READ_ONLY))
+		return -1;
+	if (accessImage(outputBox, cropWidth, cropHeight, cropBox, VX_READ_ONLY))
+		return -1;
+	TEST_CHECK_STATUS(vxReleaseGraph(&graph));
+	TEST_CHECK_STATUS(vxReleaseImage(&box));
+	TEST_CHECK_STATUS(vxReleaseImage(&sum));
+	TEST_CHECK_STATUS(vxReleaseImage(&inverted));
+	TEST_CHECK_STATUS(vxReleaseImage(&blurred));
+	TEST_CHECK_STATUS(vxReleaseImage(&roi));
+	TEST_CHECK_STATUS(vxReleaseImage(&outputElemwise));
+	TEST_CHECK_STATUS(vxReleaseImage(&outputBox));
+	return 0;
+}
+
+int test_region()
+{
+	vx_context context = vxCreateContext();
+	TEST_CHECK_OBJECT(context);
+	vx_image input = vxCreateImage(context, width, height, VX_DF_IMAGE_U8);
+	TEST_CHECK_OBJECT(input);
+	std::vector<vx_uint8> pixels(width * height);
+	srand(1);
+	for (size_t i = 0; i < pixels.size(); i++)
+		pixels[i] = (vx_uint8)(rand() & 0xff);
+	if (accessImage(input, width, height, pixels, VX_WRITE_ONLY))
+		return -1;
+
+	// compare with and without element-wise fusion: crops must match the graph that computes whole images
+	vx_uint32 cropWidth = cropRect.end_x - cropRect.start_x, cropHeight = cropRect.end_y - cropRect.start_y;
+	vx_uint32 flagsList[] = { 0, AGO_GRAPH_OPTIMIZER_FLAG_NO_ELEMWISE_FUSION };
+	for (vx_size i = 0; i < sizeof(flagsList) / sizeof(flagsList[0]); i++) {
+		std::vector<vx_uint8> elemwise, box, referenceElemwise, referenceBox;
+		int regionCount = 0, referenceRegionCount = 0;
+		if (runGraph(context, input, flagsList[i], elemwise, box, regionCount))
+			return -1;
+		if (runGraph(context, input, flagsList[i] | AGO_GRAPH_OPTIMIZER_FLAG_NO_REQUIRED_REGIONS, referenceElemwise, referenceBox, referenceRegionCount))
+			return -1;
+		TEST_CHECK(regionCount > 0, "no node computes a partial region with optimizer flags 0x%x", flagsList[i]);
+		TEST_CHECK(referenceRegionCount == 0, "%d nodes compute partial regions with required regions disabled", referenceRegionCount);
+		for (vx_uint32 y = 0; y < cropHeight; y++) {
+			for (vx_uint32 x = 0; x < cropWidth; x++) {
+				vx_uint32 j = y * cropWidth + x;
+				TEST_CHECK(elemwise[j] == referenceElemwise[j], "element-wise crop mismatch at (%d,%d) with optimizer flags 0x%x: %d instead of %d",
+					x, y, flagsList[i], elemwise[j], referenceElemwise[j]);
+				// border pixels of a neighborhood kernel with undefined border mode aren't defined
+				if (x > 0 && y > 0 && x < cropWidth - 1 && y < cropHeight - 1) {
+					TEST_CHECK(box[j] == referenceBox[j], "Box3x3 crop mismatch at (%d,%d) with optimizer flags 0x%x: %d instead of %d",
+						x, y, flagsList[i], box[j], referenceBox[j]);
+				}
+			}
+		}
+	}
+
+	TEST_CHECK_STATUS(vxReleaseImage(&input));
+	TEST_CHECK_STATUS(vxReleaseContext(&context));
+	return 0;
+}
@@ -0,0 +1,132 @@
+/*
+Copyright (c) 2015 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+
+// warp affine/perspective: the band-parallel warp engine must match the reference for nearest and
+// bilinear interpolation with undefined, replicate and constant borders, including sources too
+// small for the vector path and band counts larger than the number of rows.
+// nearest must match exactly, except where the source coordinate is within float precision of a
+// pixel boundary; bilinear may differ by one because of the float weights.
+
+#include "unit_tests.h"
+#include <math.h>
+
+static vx_uint8 referenceTap(TestImage& src, vx_int32 x, vx_int32 y, vx_enum borderMode, vx_uint8 border)
+{
+	if (x < 0 || y < 0 || x >= (vx_int32)src.width || y >= (vx_int32)src.height) {
+		if (borderMode == VX_BORDER_MODE_CONSTANT)
+			return border;
+		x = x < 0 ? 0 : (x >= (vx_int32)src.width ? (vx_int32)src.width - 1 : x);
+		y = y < 0 ? 0 : (y >= (vx_int32)src.height ? (vx_int32)src.height - 1 : y);
+	}
+	return src.row(y)[x];
+}
+
+// returns -1 when the source coordinate is too close to a pixel boundary to expect an exact nearest result
+static int referenceWarp(TestImage& src, const vx_float32 m[3][3], vx_int32 x, vx_int32 y, vx_enum interpolation, vx_enum borderMode, vx_uint8 border)
+{
+	vx_float32 z = m[0][2] * x + m[1][2] * y + m[2][2];
+	vx_float32 sx = (m[0][0] * x + m[1][0] * y + m[2][0]) / z;
+	vx_float32 sy = (m[0][1] * x + m[1][1] * y + m[2][1]) / z;
+	vx_float32 x0 = floorf(sx), y0 = floorf(sy);
+	if (interpolation == VX_INTERPOLATION_TYPE_NEAREST_NEIGHBOR) {
+		if (sx - x0 < 1e-3f || x0 + 1 - sx < 1e-3f || sy - y0 < 1e-3f || y0 + 1 - sy < 1e-3f)
+			return -1;
+		return referenceTap(src, (vx_int32)x0, (vx_int32)y0, borderMode, border);
+	}
+	if (borderMode != VX_BORDER_MODE_CONSTANT) {
+		// replicate clamps the source coordinate
+		sx = sx < 0 ? 0 : (sx > src.width - 1 ? src.width - 1 : sx);
+		sy = sy < 0 ? 0 : (sy > src.height - 1 ? src.height - 1 : sy);
+		x0 = floorf(sx), y0 = floorf(sy);
+	}
+	vx_float32 wx = sx - x0, wy = sy - y0;
+	vx_int32 ix = (vx_int32)x0, iy = (vx_int32)y0;
+	vx_float32 value =
+		(1 - wx) * (1 - wy) * referenceTap(src, ix, iy, borderMode, border) + wx * (1 - wy) * referenceTap(src, ix + 1, iy, borderMode, border) +
+		(1 - wx) * wy * referenceTap(src, ix, iy + 1, borderMode, border) + wx * wy * referenceTap(src, ix + 1, iy + 1, borderMode, border);
+	return (int)(value + 0.5f);
+}
+
+int test_warp()
+{
+	const vx_uint32 sizeList[][4] = {		// srcWidth, srcHeight, dstWidth, dstHeight
+		{ 64, 48, 64, 48 }, { 37, 29, 50, 31 }, { 200, 120, 161, 97 }, { 5, 3, 13, 9 }, { 1, 1, 7, 3 }, { 1, 6, 9, 5 }, { 6, 1, 5, 2 },
+	};
+	const vx_float32 matrixList[][3][3] = {
+		{ { 1, 0, 0 }, { 0, 1, 0 }, { 0, 0, 1 } },
+		{ { 0.9f, 0.1f, 0 }, { -0.1f, 0.9f, 0 }, { 3.3f, -2.7f, 1 } },
+		{ { 1.7f, -0.3f, 0 }, { 0.4f, 1.3f, 0 }, { -10.2f, -5.5f, 1 } },
+		{ { 0.5f, 0, 0 }, { 0, 0.5f, 0 }, { 0.25f, 0.25f, 1 } },
+		{ { 0.95f, 0.05f, 0.0005f }, { -0.05f, 0.9f, 0.001f }, { 2.1f, 1.3f, 1 } },
+		{ { 1.1f, 0.02f, 0 }, { 0.03f, 1.05f, -0.001f }, { -4.0f, 3.0f, 1.02f } },
+		{ { 1.1f, 0.02f, -0.001f }, { 0.03f, 1.05f, 0 }, { -4.0f, 3.0f, 1.02f } },
+	};
+	const vx_enum interpolationList[] = { VX_INTERPOLATION_TYPE_NEAREST_NEIGHBOR, VX_INTERPOLATION_TYPE_BILINEAR };
+	const vx_enum borderModeList[] = { VX_BORDER_MODE_UNDEFINED, VX_BORDER_MODE_REPLICATE, VX_BORDER_MODE_CONSTANT };
+	const vx_uint32 bandCountList[] = { 1, 3, AGO_MAX_CPU_THREADS };
+	const vx_uint8 border = 77;
+	for (size_t s = 0; s < sizeof(sizeList) / sizeof(sizeList[0]); s++) {
+		vx_uint32 srcWidth = sizeList[s][0], srcHeight = sizeList[s][1], dstWidth = sizeList[s][2], dstHeight = sizeList[s][3];
+		TestImage src(srcWidth, srcHeight, 1);
+		src.randomize(srcWidth * 7 + dstWidth);
+		for (size_t m = 0; m < sizeof(matrixList) / sizeof(matrixList[0]); m++) {
+			const vx_float32 (&mat)[3][3] = matrixList[m];
+			bool affine = (mat[0][2] == 0 && mat[1][2] == 0 && mat[2][2] == 1);
+			ago_affine_matrix_t affineMatrix;
+			ago_perspective_matrix_t perspectiveMatrix;
+			for (int i = 0; i < 3; i++) {
+				for (int j = 0; j < 3; j++) {
+					if (j < 2) affineMatrix.matrix[i][j] = mat[i][j];
+					perspectiveMatrix.matrix[i][j] = mat[i][j];
+				}
+			}
+			for (int perspective = affine ? 0 : 1; perspective < 2; perspective++) {
+				for (size_t i = 0; i < sizeof(interpolationList) / sizeof(interpolationList[0]); i++) {
+					for (size_t b = 0; b < sizeof(borderModeList) / sizeof(borderModeList[0]); b++) {
+						for (size_t n = 0; n < sizeof(bandCountList) / sizeof(bandCountList[0]); n++) {
+							TestImage dst(dstWidth, dstHeight, 1);
+							int status = perspective ?
+								HafCpu_WarpPerspective_U8_U8_Parallel(dstWidth, dstHeight, dst.row(0), dst.stride, srcWidth, srcHeight, src.row(0), src.stride,
+									&perspectiveMatrix, interpolationList[i], borderModeList[b], border, bandCountList[n]) :
+								HafCpu_WarpAffine_U8_U8_Parallel(dstWidth, dstHeight, dst.row(0), dst.stride, srcWidth, srcHeight, src.row(0), src.stride,
+									&affineMatrix, interpolationList[i], borderModeList[b], border, bandCountList[n]);
+							TEST_CHECK(!status, "%s %ux%u->%ux%u failed", perspective ? "perspective" : "affine", srcWidth, srcHeight, dstWidth, dstHeight);
+							for (vx_uint32 y = 0; y < dstHeight; y++) {
+								for (vx_uint32 x = 0; x < dstWidth; x++) {
+									int value = referenceWarp(src, mat, x, y, interpolationList[i], borderModeList[b], border);
+									int result = dst.row(y)[x];
+									if (value < 0)
+										continue;
+									TEST_CHECK(abs(result - value) <= (interpolationList[i] == VX_INTERPOLATION_TYPE_BILINEAR ? 1 : 0),
+										"%s %s border:%d matrix#%d %ux%u->%ux%u bands:%u mismatch at (%u,%u): %d instead of %d",
+										perspective ? "perspective" : "affine", interpolationList[i] == VX_INTERPOLATION_TYPE_BILINEAR ? "bilinear" : "nearest",
+										borderModeList[b], (int)m, srcWidth, srcHeight, dstWidth, dstHeight, bandCountList[n], x, y, result, value);
+								}
+							}
+						}
+					}
+				}
+			}
+		}
+	}
+	return 0;
+}
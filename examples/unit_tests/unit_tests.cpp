@@ -0,0 +1,84 @@
+/* 
+Copyright (c) 2015 Advanced Micro Devices, Inc. All rights reserved.
+ 
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+ 
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+ 
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+
+// unit tests of optimized CPU code paths
+//   usage: unit_tests [<test-name> ...]
+//   runs all tests when no test names are given
+
+#include "unit_tests.h"
+
+static const struct {
+	const char * name;
+	int (*func)();
+} s_testList[] = {
+	{ "convolve", test_convolve },
+	{ "integral", test_integral },
+	{ "warp", test_warp },
+	{ "placement", test_placement },
+	{ "rebind", test_rebind },
+	{ "fold", test_fold },
+	{ "region", test_region },
+};
+
+TestImage::TestImage(vx_uint32 width_, vx_uint32 height_, vx_uint32 bytesPerPixel_, vx_uint32 margin_)
+	: width{ width_ }, height{ height_ }, bytesPerPixel{ bytesPerPixel_ }, margin{ margin_ }
+{
+	stride = ((width + 2 * margin) * bytesPerPixel + 15) & ~15;
+	allocated = new vx_uint8[stride * (height + 2 * margin) + 16];
+	buffer = (vx_uint8 *)(((size_t)allocated + 15) & ~(size_t)15);
+	memset(buffer, 0, stride * (height + 2 * margin));
+}
+
+TestImage::~TestImage()
+{
+	delete[] allocated;
+}
+
+void TestImage::randomize(unsigned int seed)
+{
+	srand(seed);
+	for (vx_uint32 i = 0; i < stride * (height + 2 * margin); i++)
+		buffer[i] = (vx_uint8)(rand() & 255);
+}
+
+int main(int argc, char * argv[])
+{
+	int failed = 0, count = 0;
+	for (size_t i = 0; i < sizeof(s_testList) / sizeof(s_testList[0]); i++) {
+		bool selected = (argc < 2);
+		for (int arg = 1; arg < argc; arg++) {
+			if (!strcmp(argv[arg], s_testList[i].name))
+				selected = true;
+		}
+		if (selected) {
+			int status = s_testList[i].func();
+			printf("%s: %s\n", s_testList[i].name, status ? "FAILED" : "passed");
+			failed += status ? 1 : 0;
+			count++;
+		}
+	}
+	if (!count) {
+		printf("ERROR: no matching tests\n");
+		return 1;
+	}
+	return failed ? 1 : 0;
+}
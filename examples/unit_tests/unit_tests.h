@@ -0,0 +1,60 @@
+/* 
+Copyright (c) 2015 Advanced Micro Devices, Inc. All rights reserved.
+ 
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+ 
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+ 
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+
+#ifndef __unit_tests_h__
+#define __unit_tests_h__
+
+#include <VX/vx.h>
+#include <vx_ext_amd.h>
+#include <ago_internal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <vector>
+
+// test failures are reported with the source location and make the test return a non-zero value
+#define TEST_CHECK(cond, ...) { if (!(cond)) { printf("ERROR: " __FILE__ "#%d: ", __LINE__); printf(__VA_ARGS__); printf("\n"); return -1; } }
+#define TEST_CHECK_STATUS(call) { vx_status status = (call); if (status != VX_SUCCESS) { printf("ERROR: failed with status = (%d) at " __FILE__ "#%d\n", status, __LINE__); return -1; } }
+#define TEST_CHECK_OBJECT(obj)  { vx_status status = vxGetStatus((vx_reference)(obj)); if (status != VX_SUCCESS) { printf("ERROR: failed with status = (%d) at " __FILE__ "#%d\n", status, __LINE__); return -1; } }
+
+// 16-byte aligned image buffer with a margin of pixels on all sides, so that kernels can read past the edges
+class TestImage {
+public:
+	TestImage(vx_uint32 width, vx_uint32 height, vx_uint32 bytesPerPixel, vx_uint32 margin = 16);
+	~TestImage();
+	vx_uint8 * row(vx_int32 y) { return buffer + (margin + y) * stride + margin * bytesPerPixel; }
+	void randomize(unsigned int seed);
+	vx_uint32 width, height, bytesPerPixel, margin, stride;
+	vx_uint8 * buffer;
+	vx_uint8 * allocated;
+};
+
+// tests: return 0 on success
+int test_convolve();
+int test_integral();
+int test_warp();
+int test_placement();
+int test_rebind();
+int test_fold();
+int test_region();
+
+#endif
@@ -0,0 +1,134 @@
+/* 
+Copyright (c) 2015 Advanced Micro Devices, Inc. All rights reserved.
+ 
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+ 
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+ 
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+
+// verify-time benchmark for graph optimizer on large synthetic graphs
+//   usage: verify_benchmark [<numStages>] [<numCustomRules>] [<numIterations>]
+//   each stage adds AND+NOT+NOT+NOT+SOBEL+MAGNITUDE+CONVERT_DEPTH nodes that are
+//   reduced by node merge rules; custom merge rules are registered with
+//   VX_CONTEXT_ATTRIBUTE_AMD_SET_MERGE_RULE and never match (worst case for matcher)
+
+#include <VX/vx.h>
+#include <vx_ext_amd.h>
+#include <ago_kernels.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <chrono>
+
+#define ERROR_CHECK_STATUS(call) { vx_status status = (call); if (status != VX_SUCCESS) { printf("ERROR: failed with status = (%d) at " __FILE__ "#%d\n", status, __LINE__); exit(1); } }
+#define ERROR_CHECK_OBJECT(obj)  { vx_status status = vxGetStatus((vx_reference)(obj)); if (status != VX_SUCCESS) { printf("ERROR: failed with status = (%d) at " __FILE__ "#%d\n", status, __LINE__); exit(1); } }
+
+static vx_graph createSyntheticGraph(vx_context context, vx_uint32 numStages, vx_uint32 width, vx_uint32 height)
+{
+	vx_graph graph = vxCreateGraph(context);
+	ERROR_CHECK_OBJECT(graph);
+	vx_image input = vxCreateImage(context, width, height, VX_DF_IMAGE_U8);
+	vx_image mask = vxCreateImage(context, width, height, VX_DF_IMAGE_U8);
+	vx_image output = vxCreateImage(context, width, height, VX_DF_IMAGE_U8);
+	vx_int32 shift_value = 0;
+	vx_scalar shift = vxCreateScalar(context, VX_TYPE_INT32, &shift_value);
+	ERROR_CHECK_OBJECT(input);
+	ERROR_CHECK_OBJECT(mask);
+	ERROR_CHECK_OBJECT(output);
+	ERROR_CHECK_OBJECT(shift);
+	vx_image cur = input;
+	for (vx_uint32 stage = 0; stage < numStages; stage++) {
+		vx_image tmp[7];
+		for (int i = 0; i < 7; i++) {
+			vx_df_image format = (i == 4 || i == 5 || i == 6) ? VX_DF_IMAGE_S16 : VX_DF_IMAGE_U8;
+			tmp[i] = vxCreateVirtualImage(graph, width, height, format);
+			ERROR_CHECK_OBJECT(tmp[i]);
+		}
+		vx_image next = (stage == numStages - 1) ? output : vxCreateVirtualImage(graph, width, height, VX_DF_IMAGE_U8);
+		ERROR_CHECK_OBJECT(next);
+		vx_node nodes[] = {
+			vxAndNode(graph, cur, mask, tmp[0]),
+			vxNotNode(graph, tmp[0], tmp[1]),
+			vxNotNode(graph, tmp[1], tmp[2]),
+			vxNotNode(graph, tmp[2], tmp[3]),
+			vxSobel3x3Node(graph, tmp[3], tmp[4], tmp[5]),
+			vxMagnitudeNode(graph, tmp[4], tmp[5], tmp[6]),
+			vxConvertDepthNode(graph, tmp[6], next, VX_CONVERT_POLICY_SATURATE, shift),
+		};
+		for (size_t i = 0; i < sizeof(nodes) / sizeof(nodes[0]); i++) {
+			ERROR_CHECK_OBJECT(nodes[i]);
+			ERROR_CHECK_STATUS(vxReleaseNode(&nodes[i]));
+		}
+		for (int i = 0; i < 7; i++) {
+			ERROR_CHECK_STATUS(vxReleaseImage(&tmp[i]));
+		}
+		if (cur != input) {
+			ERROR_CHECK_STATUS(vxReleaseImage(&cur));
+		}
+		cur = next;
+	}
+	ERROR_CHECK_STATUS(vxReleaseImage(&input));
+	ERROR_CHECK_STATUS(vxReleaseImage(&mask));
+	ERROR_CHECK_STATUS(vxReleaseImage(&output));
+	ERROR_CHECK_STATUS(vxReleaseScalar(&shift));
+	return graph;
+}
+
+int main(int argc, char * argv[])
+{
+	vx_uint32 numStages = (argc > 1) ? (vx_uint32)atoi(argv[1]) : 256;
+	vx_uint32 numCustomRules = (argc > 2) ? (vx_uint32)atoi(argv[2]) : 0;
+	vx_uint32 numIterations = (argc > 3) ? (vx_uint32)atoi(argv[3]) : 3;
+	if (numStages < 1 || numIterations < 1) {
+		printf("Usage: verify_benchmark [<numStages>] [<numCustomRules>] [<numIterations>]\n");
+		return 1;
+	}
+
+	vx_context context = vxCreateContext();
+	ERROR_CHECK_OBJECT(context);
+
+	// register custom rules: NOT_U8_U8 followed by MEDIAN_U8_U8_3x3 is never present in the graph
+	for (vx_uint32 i = 0; i < numCustomRules; i++) {
+		AgoNodeMergeRule rule = {
+			{
+				{ VX_KERNEL_AMD_NOT_U8_U8, { 2, 1 } },
+				{ VX_KERNEL_AMD_MEDIAN_U8_U8_3x3, { 3, 2 } },
+			},
+			{
+				{ VX_KERNEL_AMD_MEDIAN_U8_U8_3x3, { 3, 1 } },
+			}
+		};
+		ERROR_CHECK_STATUS(vxSetContextAttribute(context, VX_CONTEXT_ATTRIBUTE_AMD_SET_MERGE_RULE, &rule, sizeof(rule)));
+	}
+
+	// measure verify time of the synthetic graph
+	double msecMin = 0, msecSum = 0;
+	for (vx_uint32 iter = 0; iter < numIterations; iter++) {
+		vx_graph graph = createSyntheticGraph(context, numStages, 64, 48);
+		auto t0 = std::chrono::high_resolution_clock::now();
+		ERROR_CHECK_STATUS(vxVerifyGraph(graph));
+		auto t1 = std::chrono::high_resolution_clock::now();
+		double msec = std::chrono::duration<double, std::milli>(t1 - t0).count();
+		msecMin = (iter == 0 || msec < msecMin) ? msec : msecMin;
+		msecSum += msec;
+		ERROR_CHECK_STATUS(vxReleaseGraph(&graph));
+	}
+	printf("verify_benchmark: stages %d (%d nodes), custom rules %d: vxVerifyGraph min %.3f msec avg %.3f msec\n",
+		numStages, numStages * 7, numCustomRules, msecMin, msecSum / numIterations);
+
+	ERROR_CHECK_STATUS(vxReleaseContext(&context));
+	return 0;
+}
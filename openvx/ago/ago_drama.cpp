@@ -58,53 +58,65 @@ static bool DetectRectOverlap(vx_rectangle_t& a, vx_rectangle_t& b)
 	return (c.start_x < c.end_x) && (c.start_y < c.end_y) ? true : false;
 }
 
-void agoOptimizeDramaGetDataUsageOfROI(AgoGraph * agraph, AgoData * roiMasterImage, vx_uint32& inputUsageCount, vx_uint32& outputUsageCount, vx_uint32& inoutUsageCount)
+void agoOptimizeDramaGetDataUsageOfROI(std::vector<AgoData *>& roiList, vx_uint32& inputUsageCount, vx_uint32& outputUsageCount, vx_uint32& inoutUsageCount)
 {
 	std::list<vx_rectangle_t> rectList;
 	vx_uint32 outputUsageCount_ = 0;
-	for (int isVirtual = 0; isVirtual <= 1; isVirtual++) {
-		for (AgoData * data = isVirtual ? agraph->ref.context->dataList.head : agraph->dataList.head; data; data = data->next) {
-			if (data->ref.type == VX_TYPE_IMAGE && data->u.img.isROI && data->u.img.roiMasterImage == roiMasterImage) {
-				inputUsageCount += data->inputUsageCount;
-				inoutUsageCount += data->inoutUsageCount;
-				if (data->outputUsageCount > 0) {
-					if (outputUsageCount == 0) {
-						bool detectedOverlap = false;
-						for (auto it = rectList.begin(); it != rectList.end(); it++) {
-							if (DetectRectOverlap(*it, data->u.img.rect_roi)) {
-								detectedOverlap = true;
-								break;
-							}
-						}
-						rectList.push_back(data->u.img.rect_roi);
-						if (detectedOverlap) {
-							outputUsageCount_ += data->outputUsageCount;
-						}
-						else {
-							outputUsageCount_ = max(outputUsageCount_, data->outputUsageCount);
-						}
-					}
-					else {
-						outputUsageCount_ += data->outputUsageCount;
+	for (auto it = roiList.begin(); it != roiList.end(); it++) {
+		AgoData * data = *it;
+		inputUsageCount += data->inputUsageCount;
+		inoutUsageCount += data->inoutUsageCount;
+		if (data->outputUsageCount > 0) {
+			if (outputUsageCount == 0) {
+				bool detectedOverlap = false;
+				for (auto it = rectList.begin(); it != rectList.end(); it++) {
+					if (DetectRectOverlap(*it, data->u.img.rect_roi)) {
+						detectedOverlap = true;
+						break;
 					}
 				}
+				rectList.push_back(data->u.img.rect_roi);
+				if (detectedOverlap) {
+					outputUsageCount_ += data->outputUsageCount;
+				}
+				else {
+					outputUsageCount_ = max(outputUsageCount_, data->outputUsageCount);
+				}
+			}
+			else {
+				outputUsageCount_ += data->outputUsageCount;
 			}
 		}
 	}
 	outputUsageCount += outputUsageCount_;
 }
 
-void agoOptimizeDramaMarkDataUsageOfROI(AgoGraph * agraph, AgoData * roiMasterImage, vx_uint32 inputUsageCount, vx_uint32 outputUsageCount, vx_uint32 inoutUsageCount)
+void agoOptimizeDramaMarkDataUsageOfROI(std::vector<AgoData *>& roiList, vx_uint32 inputUsageCount, vx_uint32 outputUsageCount, vx_uint32 inoutUsageCount)
 {
-	for (int isVirtual = 0; isVirtual <= 1; isVirtual++) {
-		for (AgoData * data = isVirtual ? agraph->ref.context->dataList.head : agraph->dataList.head; data; data = data->next) {
-			if (data->ref.type == VX_TYPE_IMAGE && data->u.img.isROI && data->u.img.roiMasterImage == roiMasterImage) {
-				data->inputUsageCount = inputUsageCount;
-				data->outputUsageCount = outputUsageCount;
-				data->inoutUsageCount = inoutUsageCount;
-			}
+	for (auto it = roiList.begin(); it != roiList.end(); it++) {
+		AgoData * data = *it;
+		data->inputUsageCount = inputUsageCount;
+		data->outputUsageCount = outputUsageCount;
+		data->inoutUsageCount = inoutUsageCount;
+	}
+}
+
+bool agoOptimizeDramaGetDefaultTarget(vx_uint32& default_target)
+{
+	// AGO_DEFAULT_TARGET=CPU|GPU overrides the default target: returns true when it is given
+	default_target = AGO_KERNEL_TARGET_DEFAULT;
+	char textBuffer[1024];
+	if (agoGetEnvironmentVariable("AGO_DEFAULT_TARGET", textBuffer, sizeof(textBuffer))) {
+		if (!strcmp(textBuffer, "GPU")) {
+			default_target = AGO_KERNEL_FLAG_DEVICE_GPU;
+			return true;
+		}
+		else if (!strcmp(textBuffer, "CPU")) {
+			default_target = AGO_KERNEL_FLAG_DEVICE_CPU;
+			return true;
 		}
 	}
+	return false;
 }
 
 void agoOptimizeDramaMarkDataUsage(AgoGraph * agraph)
@@ -218,12 +230,24 @@ void agoOptimizeDramaMarkDataUsage(AgoGraph * agraph)
 			}
 		}
 	}
-	// add up ROI data usage
+	// add up ROI data usage: group ROI images by their master image in a single pass
+	// to keep the cost linear in number of data objects
+	std::map<AgoData *, std::vector<AgoData *>> roiListOfMaster;
 	for (int isVirtual = 0; isVirtual <= 1; isVirtual++) {
+		for (AgoData * data = isVirtual ? agraph->ref.context->dataList.head : agraph->dataList.head; data; data = data->next) {
+			if (data->ref.type == VX_TYPE_IMAGE && data->u.img.isROI) {
+				roiListOfMaster[data->u.img.roiMasterImage].push_back(data);
+			}
+		}
+	}
+	for (int isVirtual = 0; isVirtual <= 1 && roiListOfMaster.size() > 0; isVirtual++) {
 		for (AgoData * data = isVirtual ? agraph->ref.context->dataList.head : agraph->dataList.head; data; data = data->next) {
 			if (data->ref.type == VX_TYPE_IMAGE && !data->u.img.isROI) {
-				agoOptimizeDramaGetDataUsageOfROI(agraph, data, data->inputUsageCount, data->outputUsageCount, data->inoutUsageCount);
-				agoOptimizeDramaMarkDataUsageOfROI(agraph, data, data->inputUsageCount, data->outputUsageCount, data->inoutUsageCount);
+				auto it = roiListOfMaster.find(data);
+				if (it != roiListOfMaster.end()) {
+					agoOptimizeDramaGetDataUsageOfROI(it->second, data->inputUsageCount, data->outputUsageCount, data->inoutUsageCount);
+					agoOptimizeDramaMarkDataUsageOfROI(it->second, data->inputUsageCount, data->outputUsageCount, data->inoutUsageCount);
+				}
 			}
 		}
 	}
@@ -515,6 +539,34 @@ int agoOptimizeDrama(AgoGraph * agraph)
 #if ENABLE_DEBUG_MESSAGES
 	agoWriteGraph(agraph, NULL, 0, stdout, "input-to-drama");
 #endif
+	// reuse the result of divide, remove, and merge from the optimized graph cache, if available
+	int64_t clockCounter = agoGetClockCounter();
+	AgoDramaCacheEntry cacheEntry;
+	int cacheStatus = agoOptimizeDramaCacheLookup(agraph, cacheEntry);
+	if (cacheStatus < 0)
+		return -1;
+	else if (!cacheEntry.fileName.empty())
+		agoOptimizerLogEntry(agraph, "cache", cacheStatus ? "hit" : "miss", "%s", cacheEntry.fileName.c_str());
+	if (cacheStatus > 0) {
+		if (agoOptimizeDramaComputeGraphHierarchy(agraph))
+			return -1;
+		agoOptimizeDramaSortGraphHierarchy(agraph);
+		agoOptimizerLogTime(agraph, "cache", clockCounter);
+		if (agoOptimizeDramaCheckArgs(agraph))
+			return -1;
+		if (agoOptimizeDramaAnalyze(agraph))
+			return -1;
+		agoOptimizerLogTime(agraph, "analyze", clockCounter);
+		if (agoOptimizeDramaAlloc(agraph))
+			return -1;
+		agoOptimizerLogTime(agraph, "alloc", clockCounter);
+#if ENABLE_DEBUG_MESSAGES
+		agoWriteGraph(agraph, NULL, 0, stdout, "after-alloc");
+#endif
+		return 0;
+	}
+	agoOptimizerLogTime(agraph, "cache", clockCounter);
+
 	// perform divide
 	if (agoOptimizeDramaCheckArgs(agraph))
 		return -1;
@@ -528,6 +580,7 @@ int agoOptimizeDrama(AgoGraph * agraph)
 	if (agoOptimizeDramaComputeGraphHierarchy(agraph))
 		return -1;
 	agoOptimizeDramaSortGraphHierarchy(agraph);
+	agoOptimizerLogTime(agraph, "divide", clockCounter);
 
 	// perform remove
 	if (agoOptimizeDramaCheckArgs(agraph))
@@ -540,6 +593,27 @@ int agoOptimizeDrama(AgoGraph * agraph)
 	if (agoOptimizeDramaComputeGraphHierarchy(agraph))
 		return -1;
 	agoOptimizeDramaSortGraphHierarchy(agraph);
+	agoOptimizerLogTime(agraph, "remove", clockCounter);
+
+	// perform fold
+	if (!(agraph->optimizer_flags & AGO_GRAPH_OPTIMIZER_FLAG_NO_CONSTANT_FOLDING)) {
+		if (agoOptimizeDramaCheckArgs(agraph))
+			return -1;
+		int graphGotModified = agoOptimizeDramaFold(agraph);
+		if (graphGotModified < 0)
+			return -1;
+#if ENABLE_DEBUG_MESSAGES
+		agoWriteGraph(agraph, NULL, 0, stdout, "after-fold");
+#endif
+		if (graphGotModified) {
+			// folded data contents can't be saved in the cache file
+			cacheEntry.fileName.clear();
+			if (agoOptimizeDramaComputeGraphHierarchy(agraph))
+				return -1;
+			agoOptimizeDramaSortGraphHierarchy(agraph);
+		}
+		agoOptimizerLogTime(agraph, "fold", clockCounter);
+	}
 
 	// perform analyze
 	if (agoOptimizeDramaCheckArgs(agraph))
@@ -549,6 +623,7 @@ int agoOptimizeDrama(AgoGraph * agraph)
 #if ENABLE_DEBUG_MESSAGES
 	agoWriteGraph(agraph, NULL, 0, stdout, "after-analyze");
 #endif
+	agoOptimizerLogTime(agraph, "analyze", clockCounter);
 
 	// perform merge
 	if (agoOptimizeDramaCheckArgs(agraph))
@@ -558,6 +633,12 @@ int agoOptimizeDrama(AgoGraph * agraph)
 #if ENABLE_DEBUG_MESSAGES
 	agoWriteGraph(agraph, NULL, 0, stdout, "after-merge");
 #endif
+	if (agoOptimizeDramaComputeGraphHierarchy(agraph))
+		return -1;
+	agoOptimizeDramaSortGraphHierarchy(agraph);
+	agoOptimizerLogTime(agraph, "merge", clockCounter);
+	agoOptimizeDramaCacheSave(agraph, cacheEntry);
+	agoOptimizerLogTime(agraph, "cache-save", clockCounter);
 
 	// perform alloc
 	if (agoOptimizeDramaCheckArgs(agraph))
@@ -567,6 +648,7 @@ int agoOptimizeDrama(AgoGraph * agraph)
 #if ENABLE_DEBUG_MESSAGES
 	agoWriteGraph(agraph, NULL, 0, stdout, "after-alloc");
 #endif
+	agoOptimizerLogTime(agraph, "alloc", clockCounter);
 
 	return 0;
 }
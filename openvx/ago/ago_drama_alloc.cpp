@@ -272,6 +272,12 @@ int agoGpuOclAllocBuffers(AgoGraph * graph)
 					Gd[j][i]->opencl_buffer = Gd[j][k]->opencl_buffer;
 				}
 				Gd[j][i]->opencl_buffer_offset = Gd[j][k]->opencl_buffer_offset;
+				if (graph->enable_optimizer_log) {
+					char name[1024], nameShared[1024];
+					agoGetDataName(name, Gd[j][i]);
+					agoGetDataName(nameShared, Gd[j][k]);
+					agoOptimizerLogEntry(graph, "alloc", "alias", "%s shares GPU buffer of %s", name[0] ? name : "?", nameShared[0] ? nameShared : "?");
+				}
 			}
 		}
 	}
@@ -471,6 +477,221 @@ static int agoOptimizeDramaAllocGpuResources(AgoGraph * graph)
 }
 #endif
 
+struct AgoTargetCutEdge {
+	int to;
+	double cap;
+};
+struct AgoTargetCut {
+	std::vector<AgoTargetCutEdge> edges; // edge i and its reverse edge i^1
+	std::vector<std::vector<int>> adj;
+	std::vector<int> level, iter;
+};
+
+static int agoTargetCutAddVertex(AgoTargetCut& cut)
+{
+	cut.adj.push_back(std::vector<int>());
+	return (int)cut.adj.size() - 1;
+}
+
+static void agoTargetCutAddEdge(AgoTargetCut& cut, int from, int to, double cap)
+{
+	AgoTargetCutEdge e = { to, cap }, r = { from, 0 };
+	cut.adj[from].push_back((int)cut.edges.size()); cut.edges.push_back(e);
+	cut.adj[to].push_back((int)cut.edges.size()); cut.edges.push_back(r);
+}
+
+static bool agoTargetCutLevels(AgoTargetCut& cut, int s, int t)
+{
+	// breadth-first levels of vertices reachable from s in residual graph
+	cut.level.assign(cut.adj.size(), -1);
+	std::vector<int> queue(1, s);
+	cut.level[s] = 0;
+	for (size_t i = 0; i < queue.size(); i++) {
+		int v = queue[i];
+		for (int id : cut.adj[v]) {
+			AgoTargetCutEdge& e = cut.edges[id];
+			if (e.cap > 1e-9 && cut.level[e.to] < 0) {
+				cut.level[e.to] = cut.level[v] + 1;
+				queue.push_back(e.to);
+			}
+		}
+	}
+	return cut.level[t] >= 0;
+}
+
+static double agoTargetCutAugment(AgoTargetCut& cut, int v, int t, double flow)
+{
+	if (v == t)
+		return flow;
+	for (int& i = cut.iter[v]; i < (int)cut.adj[v].size(); i++) {
+		int id = cut.adj[v][i];
+		AgoTargetCutEdge& e = cut.edges[id];
+		if (e.cap > 1e-9 && cut.level[e.to] == cut.level[v] + 1) {
+			double f = agoTargetCutAugment(cut, e.to, t, min(flow, e.cap));
+			if (f > 0) {
+				e.cap -= f;
+				cut.edges[id ^ 1].cap += f;
+				return f;
+			}
+		}
+	}
+	return 0;
+}
+
+static void agoTargetCutSolve(AgoTargetCut& cut, int s, int t)
+{
+	// max-flow (Dinic): vertices still reachable from s in the residual graph are on s side of min-cut
+	while (agoTargetCutLevels(cut, s, t)) {
+		cut.iter.assign(cut.adj.size(), 0);
+		while (agoTargetCutAugment(cut, s, t, DBL_MAX) > 0)
+			;
+	}
+	agoTargetCutLevels(cut, s, t);
+}
+
+static void agoOptimizeDramaAllocGetNodeCost(AgoTargetCostModel& model, AgoNode * node, double& cpu, double& gpu)
+{
+	// cost of a node is the time to access its data, scaled by the amount of compute per pixel of
+	// the kernel, unless the cost model has per-pixel costs measured for the kernel
+	AgoKernel * kernel = node->akernel;
+	double pixels = 1, bytesPerPixel = 0, bytes = 0;
+	for (vx_uint32 arg = 0; arg < node->paramCount; arg++) {
+		AgoData * data = node->paramList[arg];
+		if (data && data->ref.type == VX_TYPE_IMAGE) {
+			pixels = max(pixels, (double)data->u.img.width * data->u.img.height);
+			bytesPerPixel += (double)data->u.img.pixel_size_in_bits_num / (8.0 * data->u.img.pixel_size_in_bits_denom);
+		}
+		else if (data) {
+			bytes += (double)data->size;
+		}
+	}
+	auto it = model.kernel_cost.find(kernel->name);
+	if (it != model.kernel_cost.end()) {
+		cpu = it->second.cpu * pixels;
+		gpu = it->second.gpu * pixels;
+	}
+	else {
+		double factor = 4;
+		if (kernel->kernOpType == AGO_KERNEL_OP_TYPE_ELEMENT_WISE)
+			factor = 1;
+		else if (kernel->kernOpType == AGO_KERNEL_OP_TYPE_FIXED_NEIGHBORS)
+			factor = max(1.0, kernel->kernOpInfo * kernel->kernOpInfo / 4.0);
+		bytes += bytesPerPixel * pixels;
+		cpu = bytes * model.cpu_nsec_per_byte * factor;
+		gpu = bytes * model.gpu_nsec_per_byte * factor;
+	}
+}
+
+static double agoOptimizeDramaAllocGetTransferCost(AgoTargetCostModel& model, AgoData * data)
+{
+	vx_size size = data->size;
+	if (data->numChildren > 0) {
+		size = 0;
+		for (vx_uint32 child = 0; child < data->numChildren; child++)
+			if (data->children[child])
+				size += data->children[child]->size;
+	}
+	return model.transfer_nsec_latency + model.transfer_nsec_per_byte * size;
+}
+
+int agoOptimizeDramaAllocPlaceTargets(AgoGraph * agraph, std::map<AgoNode *, vx_uint32>& nodeTarget)
+{
+	// pick CPU or GPU for nodes that support both and don't have affinity, so that the sum of the estimated
+	// execution time of nodes and data sync between CPU and GPU is minimum: with CPU as source and GPU as sink,
+	// the min-cut of a graph of nodes gives the best placement, where
+	//   - the edge from source to a node has its GPU cost, the edge from a node to sink has its CPU cost
+	//   - a data sync costs once for all consumers on the other device than its producer, which needs two
+	//     extra vertices for each data and producer: p -> a -> c catches producer on CPU, and c -> b -> p
+	//     catches producer on GPU, with infinite capacity for a -> c and c -> b
+	//   - host is the producer of graph inputs and a consumer of graph outputs, and it is on CPU
+	bool found = false;
+	for (AgoNode * node = agraph->nodeList.head; node; node = node->next) {
+		if (!node->attr_affinity.device_type && (node->target_support_flags & AGO_KERNEL_FLAG_DEVICE_CPU) && (node->target_support_flags & AGO_KERNEL_FLAG_DEVICE_GPU)) {
+			found = true;
+			break;
+		}
+	}
+	if (!found)
+		return 0;
+	AgoContext * context = agraph->ref.context;
+#if ENABLE_OPENCL
+	// get calibrated cost model with the OpenCL context, unless the cost model is loaded from file
+	if (!context->target_cost_model.calibrated && !context->opencl_context) {
+		if (agoGpuOclCreateContext(context, nullptr) < 0) {
+			return -1;
+		}
+	}
+#endif
+	AgoTargetCostModel& model = context->target_cost_model;
+	const double infinity = 1e30;
+	AgoTargetCut cut;
+	int source = agoTargetCutAddVertex(cut), sink = agoTargetCutAddVertex(cut);
+	std::map<AgoNode *, int> nodeVertex;
+	std::map<AgoData *, std::pair<std::vector<int>, std::vector<int>>> dataAccess; // producers and consumers
+	for (AgoNode * node = agraph->nodeList.head; node; node = node->next) {
+		int v = agoTargetCutAddVertex(cut);
+		nodeVertex[node] = v;
+		bool cpu = (node->target_support_flags & AGO_KERNEL_FLAG_DEVICE_CPU) ? true : false;
+		bool gpu = (node->target_support_flags & AGO_KERNEL_FLAG_DEVICE_GPU) ? true : false;
+		if (node->attr_affinity.device_type == AGO_KERNEL_FLAG_DEVICE_CPU) gpu = !cpu;
+		else if (node->attr_affinity.device_type == AGO_KERNEL_FLAG_DEVICE_GPU) cpu = !gpu;
+		if (cpu && gpu) {
+			double cpuCost, gpuCost;
+			agoOptimizeDramaAllocGetNodeCost(model, node, cpuCost, gpuCost);
+			agoTargetCutAddEdge(cut, source, v, gpuCost);
+			agoTargetCutAddEdge(cut, v, sink, cpuCost);
+		}
+		else if (cpu) agoTargetCutAddEdge(cut, source, v, infinity);
+		else agoTargetCutAddEdge(cut, v, sink, infinity);
+		for (vx_uint32 arg = 0; arg < node->paramCount; arg++) {
+			AgoData * data = node->paramList[arg];
+			if (data) {
+				if (node->akernel->argConfig[arg] & AGO_KERNEL_ARG_OUTPUT_FLAG)
+					dataAccess[data].first.push_back(v);
+				if (node->akernel->argConfig[arg] & AGO_KERNEL_ARG_INPUT_FLAG)
+					dataAccess[data].second.push_back(v);
+			}
+		}
+	}
+	for (auto& it : dataAccess) {
+		AgoData * data = it.first;
+		std::vector<int>& producers = it.second.first;
+		std::vector<int>& consumers = it.second.second;
+		if (!data->isVirtual) {
+			if (producers.empty()) producers.push_back(source);
+			else consumers.push_back(source);
+		}
+		double cost = agoOptimizeDramaAllocGetTransferCost(model, data);
+		for (int p : producers) {
+			int a = -1, b = -1;
+			for (int c : consumers) {
+				if (c != p) {
+					if (a < 0) {
+						a = agoTargetCutAddVertex(cut);
+						b = agoTargetCutAddVertex(cut);
+						agoTargetCutAddEdge(cut, p, a, cost);
+						agoTargetCutAddEdge(cut, b, p, cost);
+					}
+					agoTargetCutAddEdge(cut, a, c, infinity);
+					agoTargetCutAddEdge(cut, c, b, infinity);
+				}
+			}
+		}
+	}
+	agoTargetCutSolve(cut, source, sink);
+	for (AgoNode * node = agraph->nodeList.head; node; node = node->next) {
+		if (!node->attr_affinity.device_type) {
+			nodeTarget[node] = (cut.level[nodeVertex[node]] >= 0) ? AGO_KERNEL_FLAG_DEVICE_CPU : AGO_KERNEL_FLAG_DEVICE_GPU;
+			if (agraph->enable_optimizer_log && (node->target_support_flags & AGO_KERNEL_FLAG_DEVICE_CPU) && (node->target_support_flags & AGO_KERNEL_FLAG_DEVICE_GPU)) {
+				double cpuCost, gpuCost;
+				agoOptimizeDramaAllocGetNodeCost(model, node, cpuCost, gpuCost);
+				agoOptimizerLogEntry(agraph, "alloc", "cost", "%s cpu:%.3fms gpu:%.3fms", agoGetNodeLogName(node).c_str(), cpuCost * 1e-6, gpuCost * 1e-6);
+			}
+		}
+	}
+	return 0;
+}
+
 static int agoOptimizeDramaAllocSetDefaultTargets(AgoGraph * agraph)
 {
 	// get unused GPU group ID
@@ -483,16 +704,11 @@ static int agoOptimizeDramaAllocSetDefaultTargets(AgoGraph * agraph)
 		}
 	}
 
-	// get default target
-	vx_uint32 default_target = AGO_KERNEL_TARGET_DEFAULT;
-	char textBuffer[1024];
-	if (agoGetEnvironmentVariable("AGO_DEFAULT_TARGET", textBuffer, sizeof(textBuffer))) {
-		if (!strcmp(textBuffer, "GPU")) {
-			default_target = AGO_KERNEL_FLAG_DEVICE_GPU;
-		}
-		else if (!strcmp(textBuffer, "CPU")) {
-			default_target = AGO_KERNEL_FLAG_DEVICE_CPU;
-		}
+	// get default target: cost model is used unless default target is given by environment
+	vx_uint32 default_target;
+	bool use_cost_model = !(agraph->optimizer_flags & AGO_GRAPH_OPTIMIZER_FLAG_NO_TARGET_COST_MODEL);
+	if (agoOptimizeDramaGetDefaultTarget(default_target)) {
+		use_cost_model = false;
 	}
 
 	for (AgoNode * node = agraph->nodeList.head; node; node = node->next) {
@@ -544,8 +760,20 @@ static int agoOptimizeDramaAllocSetDefaultTargets(AgoGraph * agraph)
 			agoAddLogEntry(&node->akernel->ref, VX_FAILURE, "ERROR: kernel %s not supported yet\n", node->akernel->name);
 			return -1;
 		}
+	}
+
+	// pick targets of nodes without affinity using cost model
+	std::map<AgoNode *, vx_uint32> nodeTarget;
+	if (use_cost_model) {
+		if (agoOptimizeDramaAllocPlaceTargets(agraph, nodeTarget) < 0) {
+			return -1;
+		}
+	}
 
+	for (AgoNode * node = agraph->nodeList.head; node; node = node->next) {
 		// set default targets
+		vx_uint32 node_default_target = nodeTarget.count(node) ? nodeTarget[node] : default_target;
+		vx_uint32 node_affinity = node->attr_affinity.device_type;
 		if (node->attr_affinity.device_type == AGO_KERNEL_FLAG_DEVICE_CPU) {
 			if (node->target_support_flags & AGO_KERNEL_FLAG_DEVICE_CPU) {
 				// reset group
@@ -593,7 +821,7 @@ static int agoOptimizeDramaAllocSetDefaultTargets(AgoGraph * agraph)
 			}
 		}
 		else {
-			if (default_target == AGO_KERNEL_FLAG_DEVICE_GPU) {
+			if (node_default_target == AGO_KERNEL_FLAG_DEVICE_GPU) {
 				// choose GPU as default if supported
 				if (node->target_support_flags & AGO_KERNEL_FLAG_DEVICE_GPU) {
 					// set default target as GPU
@@ -632,6 +860,12 @@ static int agoOptimizeDramaAllocSetDefaultTargets(AgoGraph * agraph)
 				}
 			}
 		}
+		if (agraph->enable_optimizer_log) {
+			const char * reason = node_affinity ? ((node_affinity == node->attr_affinity.device_type) ? "affinity" : "fallback") :
+				(nodeTarget.count(node) ? "cost-model" : "default");
+			agoOptimizerLogEntry(agraph, "alloc", "target", "%s on %s (%s)", agoGetNodeLogName(node).c_str(),
+				(node->attr_affinity.device_type == AGO_KERNEL_FLAG_DEVICE_GPU) ? "GPU" : "CPU", reason);
+		}
 	}
 	return 0;
 }
@@ -766,6 +1000,150 @@ static int agoOptimizeDramaAllocMergeSuperNodes(AgoGraph * graph)
 }
 #endif
 
+static bool agoOptimizeDramaAllocIsRegionNode(AgoNode * node)
+{
+	// only CPU element-wise and fixed neighborhood nodes with images of same size, single plane, and
+	// whole bytes per pixel can compute a region of their outputs using views of their images: view
+	// borders aren't image borders, so neighborhood nodes must use undefined border mode
+	AgoKernel * kernel = node->akernel;
+	AgoData * odata = node->paramList[0];
+	if (!kernel->func || node->callback || node->attr_affinity.device_type != AGO_KERNEL_FLAG_DEVICE_CPU || kernel->opencl_buffer_access_enable ||
+		(kernel->kernOpType != AGO_KERNEL_OP_TYPE_ELEMENT_WISE && kernel->kernOpType != AGO_KERNEL_OP_TYPE_FIXED_NEIGHBORS) ||
+		(kernel->kernOpType == AGO_KERNEL_OP_TYPE_FIXED_NEIGHBORS && node->attr_border_mode.mode != VX_BORDER_MODE_UNDEFINED) ||
+		!(kernel->argConfig[0] & AGO_KERNEL_ARG_OUTPUT_FLAG) || !odata || odata->ref.type != VX_TYPE_IMAGE)
+	{
+		return false;
+	}
+	for (vx_uint32 arg = 0; arg < node->paramCount; arg++) {
+		AgoData * data = node->paramList[arg];
+		if (data) {
+			vx_uint32 argConfig = kernel->argConfig[arg] & (AGO_KERNEL_ARG_INPUT_FLAG | AGO_KERNEL_ARG_OUTPUT_FLAG);
+			if (argConfig == (AGO_KERNEL_ARG_INPUT_FLAG | AGO_KERNEL_ARG_OUTPUT_FLAG) || agoIsPartOfDelay(data))
+				return false;
+			if ((argConfig & AGO_KERNEL_ARG_OUTPUT_FLAG) && (data->ref.type != VX_TYPE_IMAGE || data->u.img.isROI || data->parent))
+				return false;
+			if (data->ref.type == VX_TYPE_IMAGE && (data->u.img.planes != 1 || data->numChildren > 0 ||
+				data->u.img.width != odata->u.img.width || data->u.img.height != odata->u.img.height ||
+				(data->u.img.pixel_size_in_bits_num % (8 * data->u.img.pixel_size_in_bits_denom)) != 0))
+			{
+				return false;
+			}
+		}
+	}
+	return true;
+}
+
+static void agoOptimizeDramaAllocAddRegion(vx_rectangle_t& rect, const vx_rectangle_t& region)
+{
+	// union of rectangles, where an empty rectangle has start >= end
+	if (region.start_x >= region.end_x || region.start_y >= region.end_y)
+		return;
+	if (rect.start_x >= rect.end_x || rect.start_y >= rect.end_y) {
+		rect = region;
+		return;
+	}
+	rect.start_x = min(rect.start_x, region.start_x);
+	rect.start_y = min(rect.start_y, region.start_y);
+	rect.end_x = max(rect.end_x, region.end_x);
+	rect.end_y = max(rect.end_y, region.end_y);
+}
+
+static int agoOptimizeDramaAllocRequiredRegions(AgoGraph * agraph)
+{
+	// visit nodes from last to first: the region of a virtual image needed by its readers is known
+	// before its writer is visited, which then needs that region plus its halo from its input images
+	std::vector<AgoNode *> nodeList;
+	for (AgoNode * node = agraph->nodeList.head; node; node = node->next) {
+		node->rect_exec_partial = false;
+		nodeList.push_back(node);
+	}
+	std::map<AgoData *, vx_rectangle_t> requiredRegion;
+	for (auto it = nodeList.rbegin(); it != nodeList.rend(); it++) {
+		AgoNode * node = *it;
+		AgoKernel * kernel = node->akernel;
+		if (agoOptimizeDramaAllocIsRegionNode(node)) {
+			vx_uint32 width = node->paramList[0]->u.img.width, height = node->paramList[0]->u.img.height;
+			vx_rectangle_t full = { 0, 0, width, height };
+			vx_rectangle_t rect = { 0, 0, 0, 0 };
+			for (vx_uint32 arg = 0; arg < node->paramCount; arg++) {
+				AgoData * data = node->paramList[arg];
+				if (data && (kernel->argConfig[arg] & AGO_KERNEL_ARG_OUTPUT_FLAG)) {
+					auto region = requiredRegion.find(data);
+					if (!data->isVirtual || region == requiredRegion.end()) {
+						rect = full;
+						break;
+					}
+					agoOptimizeDramaAllocAddRegion(rect, region->second);
+				}
+			}
+			if (rect.start_x < rect.end_x && rect.start_y < rect.end_y) {
+				// neighborhood kernels don't compute the border pixels of the view: add the halo, and
+				// SIMD code processes 16 pixels at a time from the start of each row
+				vx_uint32 halo = (kernel->kernOpType == AGO_KERNEL_OP_TYPE_FIXED_NEIGHBORS) ? kernel->kernOpInfo / 2 : 0;
+				rect.start_x = (rect.start_x > halo) ? ((rect.start_x - halo) & ~15) : 0;
+				rect.start_y = (rect.start_y > halo) ? (rect.start_y - halo) : 0;
+				rect.end_x = min((rect.end_x + halo + 15) & ~15, width);
+				rect.end_y = min(rect.end_y + halo, height);
+				if (!node->fusedNodeList.empty()) {
+					// fused element-wise nodes compute row ranges
+					rect.start_x = 0;
+					rect.end_x = width;
+				}
+			}
+			node->rect_exec = rect;
+			node->rect_exec_partial = memcmp(&rect, &full, sizeof(rect)) ? true : false;
+			if (node->rect_exec_partial && agraph->enable_optimizer_log) {
+				agoOptimizerLogEntry(agraph, "alloc", "region", "%s computes rect{%u;%u;%u;%u} of %ux%u", agoGetNodeLogName(node).c_str(),
+					rect.start_x, rect.start_y, rect.end_x, rect.end_y, width, height);
+			}
+		}
+		// mark the regions needed from input images, which include the halo of the node:
+		// reads of ROI images are reads of master images, which can go beyond the ROI
+		vx_int32 halo = (kernel->kernOpType == AGO_KERNEL_OP_TYPE_FIXED_NEIGHBORS) ? (vx_int32)kernel->kernOpInfo / 2 : 0;
+		for (vx_uint32 arg = 0; arg < node->paramCount; arg++) {
+			AgoData * data = node->paramList[arg];
+			if (data && data->ref.type == VX_TYPE_IMAGE && (kernel->argConfig[arg] & AGO_KERNEL_ARG_INPUT_FLAG)) {
+				vx_rectangle_t rect = { 0, 0, data->u.img.width, data->u.img.height };
+				if (node->rect_exec_partial)
+					rect = node->rect_exec;
+				vx_int32 x0 = (vx_int32)rect.start_x - halo, y0 = (vx_int32)rect.start_y - halo;
+				vx_int32 x1 = (vx_int32)rect.end_x + halo, y1 = (vx_int32)rect.end_y + halo;
+				if (data->u.img.isROI && data->u.img.roiMasterImage) {
+					x0 += data->u.img.rect_roi.start_x; x1 += data->u.img.rect_roi.start_x;
+					y0 += data->u.img.rect_roi.start_y; y1 += data->u.img.rect_roi.start_y;
+					data = data->u.img.roiMasterImage;
+				}
+				rect.start_x = (vx_uint32)max(x0, 0) & ~15;
+				rect.start_y = (vx_uint32)max(y0, 0);
+				rect.end_x = min(((vx_uint32)max(x1, 0) + 15) & ~15, data->u.img.width);
+				rect.end_y = min((vx_uint32)max(y1, 0), data->u.img.height);
+				auto region = requiredRegion.find(data);
+				if (region == requiredRegion.end())
+					requiredRegion[data] = rect;
+				else
+					agoOptimizeDramaAllocAddRegion(region->second, rect);
+			}
+		}
+	}
+
+	// create image views needed to execute nodes on partial regions
+	for (AgoNode * node : nodeList) {
+		for (AgoData * data : node->regionViewList)
+			delete data;
+		node->regionViewList.clear();
+		if (node->rect_exec_partial && node->fusedNodeList.empty()) {
+			for (vx_uint32 arg = 0; arg < node->paramCount; arg++) {
+				if (node->paramList[arg] && node->paramList[arg]->ref.type == VX_TYPE_IMAGE) {
+					AgoData * dataView = new AgoData;
+					dataView->ref.type = VX_TYPE_IMAGE;
+					node->regionViewList.push_back(dataView);
+				}
+			}
+		}
+	}
+	return 0;
+}
+
 int agoOptimizeDramaAlloc(AgoGraph * agraph)
 {
 	// return success if there is nothing to do
@@ -811,6 +1189,13 @@ int agoOptimizeDramaAlloc(AgoGraph * agraph)
 	}
 #endif
 
+	// limit CPU nodes to the regions of their outputs read by other nodes
+	if (!(agraph->optimizer_flags & AGO_GRAPH_OPTIMIZER_FLAG_NO_REQUIRED_REGIONS)) {
+		if (agoOptimizeDramaAllocRequiredRegions(agraph) < 0) {
+			return -1;
+		}
+	}
+
 	// remove unused data
 	if (agoOptimizeDramaAllocRemoveUnusedData(agraph)) return -1;
 
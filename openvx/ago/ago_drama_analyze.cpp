@@ -23,7 +23,63 @@ THE SOFTWARE.
 
 #include "ago_internal.h"
 
+static bool agoOptimizeDramaAnalyzeIsCpuTarget(AgoNode * anode, vx_uint32 default_target)
+{
+#if ENABLE_OPENCL
+	// nodes without affinity run on default target, when supported by the kernel
+	if (anode->attr_affinity.device_type == AGO_KERNEL_FLAG_DEVICE_CPU)
+		return true;
+	else if (anode->attr_affinity.device_type == AGO_KERNEL_FLAG_DEVICE_GPU)
+		return false;
+	return (default_target == AGO_KERNEL_FLAG_DEVICE_CPU) || !(anode->akernel->flags & AGO_KERNEL_FLAG_DEVICE_GPU);
+#else
+	// all nodes run on CPU
+	return true;
+#endif
+}
+
 int agoOptimizeDramaAnalyze(AgoGraph * agraph)
 {
+	AgoDramaAnalysis& analysis = agraph->drama_analysis;
+	analysis.data.clear();
+	analysis.node.clear();
+
+	// get default target: the target cost model isn't used here, because it places the nodes of the
+	// graph after merge. A node that can run on GPU is expected to run on GPU by default and won't be
+	// fused even if the cost model later picks CPU for it; fused nodes get CPU affinity, so alloc
+	// can't move them to GPU.
+	vx_uint32 default_target;
+	agoOptimizeDramaGetDefaultTarget(default_target);
+
+	for (AgoNode * anode = agraph->nodeList.head; anode; anode = anode->next) {
+		AgoKernel * akernel = anode->akernel;
+		// get op class of the node from kernel operation type
+		AgoDramaNodeInfo& info = analysis.node[anode];
+		info.op_class = AGO_DRAMA_OP_CLASS_UNKNOWN;
+		info.neighbors = 0;
+		if (akernel->kernOpType == AGO_KERNEL_OP_TYPE_ELEMENT_WISE) {
+			info.op_class = AGO_DRAMA_OP_CLASS_ELEMENT_WISE;
+		}
+		else if (akernel->kernOpType == AGO_KERNEL_OP_TYPE_FIXED_NEIGHBORS) {
+			info.op_class = AGO_DRAMA_OP_CLASS_FIXED_NEIGHBORS;
+			info.neighbors = akernel->kernOpInfo;
+		}
+		info.cpu_target = agoOptimizeDramaAnalyzeIsCpuTarget(anode, default_target);
+		// build def/use chains: a bidirectional argument is both a use and a def
+		for (vx_uint32 arg = 0; arg < anode->paramCount; arg++) {
+			AgoData * adata = anode->paramList[arg];
+			if (adata) {
+				AgoDramaDataInfo& dinfo = analysis.data[adata];
+				if (akernel->argConfig[arg] & AGO_KERNEL_ARG_INPUT_FLAG) {
+					if (std::find(dinfo.use.begin(), dinfo.use.end(), anode) == dinfo.use.end())
+						dinfo.use.push_back(anode);
+				}
+				if (akernel->argConfig[arg] & AGO_KERNEL_ARG_OUTPUT_FLAG) {
+					dinfo.def = anode;
+				}
+			}
+		}
+	}
+
 	return 0;
 }
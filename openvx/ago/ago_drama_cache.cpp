@@ -0,0 +1,478 @@
+/* 
+Copyright (c) 2015 Advanced Micro Devices, Inc. All rights reserved.
+ 
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+ 
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+ 
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+
+
+#include "ago_internal.h"
+
+// The optimized graph cache keeps the result of drama divide, remove, and merge in the folder
+// specified by AGO_GRAPH_CACHE_DIR, so that a graph seen before skips these passes during verify.
+// A cache file has the description of the graph before optimization in "#key" lines, formats of
+// virtual images in "#format $<index> <format>" lines, scalars whose values the optimizer used in
+// "#valueused $<index>" lines, element-wise nodes fused into one node in "#fuse <first-node> <node-count>"
+// lines, followed by the data and node statements of the optimized graph in GDF syntax, where $1..$N
+// refer to objects of the original graph.
+
+// the number after the version changes with the syntax of cache files, so that older files aren't used
+#define AGO_DRAMA_CACHE_HEADER "#key ago-graph-cache " AGO_VERSION " 2\n"
+
+static vx_uint64 agoDramaCacheHash(const void * ptr, size_t size)
+{
+	// FNV-1a hash
+	vx_uint64 hash = 0xcbf29ce484222325ull;
+	for (size_t i = 0; i < size; i++) {
+		hash ^= ((const vx_uint8 *)ptr)[i];
+		hash *= 0x100000001b3ull;
+	}
+	return hash;
+}
+
+static bool agoDramaCacheIsSupportedNode(AgoNode * node)
+{
+	// only built-in kernels without callbacks, since the cache creates new node objects
+	AgoKernel * kernel = node->akernel;
+	return (kernel->func && !kernel->external_kernel && !(kernel->flags & AGO_KERNEL_FLAG_SUBGRAPH) && !node->callback) ? true : false;
+}
+
+static void agoDramaCacheAddRef(AgoDramaCacheEntry& entry, std::map<AgoData *, int>& refIndex, AgoData * data)
+{
+	if (refIndex.find(data) == refIndex.end()) {
+		refIndex[data] = (int)entry.refList.size();
+		entry.refList.push_back(data);
+		// children are referenced directly by optimized nodes
+		for (vx_uint32 i = 0; i < data->numChildren; i++) {
+			if (data->children[i])
+				agoDramaCacheAddRef(entry, refIndex, data->children[i]);
+		}
+	}
+}
+
+static std::string agoDramaCacheGetNodeAttributes(AgoNode * node)
+{
+	char text[256];
+	sprintf(text, " border:%d,0x%08x affinity:%d,%d,%d", node->attr_border_mode.mode, node->attr_border_mode.constant_value.U32,
+		node->attr_affinity.device_type, node->attr_affinity.device_info, node->attr_affinity.group);
+	return text;
+}
+
+static void agoDramaCacheRemoveNodes(AgoGraph * agraph, std::vector<AgoNode *>& fusedNodeList, std::vector<AgoNode *>& nodeList)
+{
+	for (AgoNode * anode : fusedNodeList) {
+		anode->akernel->ref.internal_count--;
+		agoRemoveNode(&agraph->nodeList, anode, false);
+	}
+	for (AgoNode * anode : nodeList) {
+		anode->akernel->ref.internal_count--;
+		agoRemoveNode(&agraph->nodeList, anode, false);
+	}
+	fusedNodeList.clear();
+	nodeList.clear();
+}
+
+static bool agoDramaCacheParseNode(AgoGraph * agraph, AgoDramaCacheEntry& entry, std::map<std::string, AgoData *>& dataMap, std::vector<std::string>& argv, std::vector<AgoNode *>& nodeList)
+{
+	AgoKernel * akernel = agoFindKernelByName(agraph->ref.context, argv[1].c_str());
+	if (!akernel)
+		return false;
+	AgoNode * node = agoCreateNode(agraph, akernel);
+	nodeList.push_back(node);
+	vx_uint32 arg = 0;
+	for (size_t i = 2; i < argv.size(); i++) {
+		const char * s = argv[i].c_str();
+		int mode = 0, type = 0, info = 0, group = 0;
+		vx_uint32 value = 0;
+		if (sscanf(s, "border:%d,%i", &mode, &value) == 2) {
+			node->attr_border_mode.mode = mode;
+			node->attr_border_mode.constant_value.U32 = value;
+		}
+		else if (sscanf(s, "affinity:%d,%d,%d", &type, &info, &group) == 3) {
+			node->attr_affinity.device_type = type;
+			node->attr_affinity.device_info = info;
+			node->attr_affinity.group = group;
+		}
+		else {
+			AgoData * data = NULL;
+			if (s[0] == '$') {
+				size_t index = (size_t)atoi(&s[1]);
+				if (index < 1 || index > entry.refList.size())
+					return false;
+				data = entry.refList[index - 1];
+			}
+			else if (strcmp(s, "null") != 0) {
+				// <name> or <name>[<child-index>] of virtual data declared in cache file
+				std::string name = argv[i];
+				int child = -1;
+				size_t pos = name.find('[');
+				if (pos != std::string::npos) {
+					child = atoi(&s[pos + 1]);
+					name = name.substr(0, pos);
+				}
+				auto it = dataMap.find(name);
+				if (it == dataMap.end())
+					return false;
+				data = it->second;
+				if (child >= 0) {
+					if ((vx_uint32)child >= data->numChildren || !data->children[child])
+						return false;
+					data = data->children[child];
+				}
+			}
+			if (arg >= akernel->argCount || (data && akernel->argType[arg] && akernel->argType[arg] != data->ref.type))
+				return false;
+			node->paramList[arg++] = data;
+		}
+	}
+	return true;
+}
+
+static int agoDramaCacheLoad(AgoGraph * agraph, AgoDramaCacheEntry& entry)
+{
+	// read cache file and check that it is for the same graph
+	FILE * fp = fopen(entry.fileName.c_str(), "rb");
+	if (!fp)
+		return 0;
+	std::string text;
+	char buffer[4096];
+	for (size_t size; (size = fread(buffer, 1, sizeof(buffer), fp)) > 0;)
+		text.append(buffer, size);
+	fclose(fp);
+	if (text.compare(0, entry.key.size(), entry.key) != 0)
+		return 0;
+
+	// create virtual data and nodes of the optimized graph after the nodes of the original graph
+	vx_uint32 userNodeCount = agraph->nodeList.count;
+	std::vector<AgoNode *> nodeList, fusedNodeList;
+	std::vector< std::pair<size_t, size_t> > fuseList;
+	std::map<std::string, AgoData *> dataMap;
+	std::vector< std::pair<AgoData *, vx_df_image> > formatList;
+	std::vector<AgoData *> valueUsedList;
+	bool valid = true;
+	for (size_t pos = entry.key.size(); valid && pos < text.size();) {
+		size_t end = text.find('\n', pos);
+		if (end == std::string::npos) end = text.size();
+		std::vector<std::string> argv;
+		for (size_t i = pos; i < end;) {
+			while (i < end && isspace((unsigned char)text[i])) i++;
+			size_t j = i;
+			while (j < end && !isspace((unsigned char)text[j])) j++;
+			if (j > i) argv.push_back(text.substr(i, j - i));
+			i = j;
+		}
+		pos = end + 1;
+		if (argv.size() == 3 && argv[0] == "#fuse") {
+			fuseList.push_back(std::pair<size_t, size_t>((size_t)atoi(argv[1].c_str()), (size_t)atoi(argv[2].c_str())));
+		}
+		else if (argv.size() == 3 && argv[0] == "#format" && argv[1][0] == '$') {
+			// optimizer can change the format of virtual images, such as U8 to U1
+			size_t index = (size_t)atoi(&argv[1][1]);
+			if (index < 1 || index > entry.refList.size() || entry.refList[index - 1]->ref.type != VX_TYPE_IMAGE || !entry.refList[index - 1]->isVirtual) {
+				valid = false;
+				break;
+			}
+			AgoData * data = entry.refList[index - 1];
+			formatList.push_back(std::pair<AgoData *, vx_df_image>(data, data->u.img.format));
+			data->u.img.format = (vx_df_image)strtoul(argv[2].c_str(), NULL, 0);
+		}
+		else if (argv.size() == 2 && argv[0] == "#valueused" && argv[1][0] == '$') {
+			// scalar values used by divide and remove can't change with rebind, same as without cache
+			size_t index = (size_t)atoi(&argv[1][1]);
+			if (index < 1 || index > entry.refList.size() || entry.refList[index - 1]->ref.type != VX_TYPE_SCALAR) {
+				valid = false;
+				break;
+			}
+			valueUsedList.push_back(entry.refList[index - 1]);
+		}
+		else if (argv.size() == 4 && argv[0] == "data" && argv[2] == "=") {
+			AgoData * data = agoCreateDataFromDescription(agraph->ref.context, agraph, argv[3].c_str(), false);
+			if (!data || !data->isVirtual || dataMap.find(argv[1]) != dataMap.end()) {
+				if (data) delete data;
+				valid = false;
+				break;
+			}
+			data->name = argv[1];
+			agoAddData(&agraph->dataList, data);
+			for (vx_uint32 i = 0; i < data->numChildren; i++) {
+				if (data->children[i]) {
+					for (vx_uint32 j = 0; j < data->children[i]->numChildren; j++) {
+						if (data->children[i]->children[j])
+							agoAddData(&agraph->dataList, data->children[i]->children[j]);
+					}
+					agoAddData(&agraph->dataList, data->children[i]);
+				}
+			}
+			dataMap[argv[1]] = data;
+		}
+		else if (argv.size() >= 2 && argv[0] == "node") {
+			valid = agoDramaCacheParseNode(agraph, entry, dataMap, argv, nodeList);
+		}
+		else if (argv.size() > 0) {
+			valid = false;
+		}
+	}
+
+	// replace element-wise nodes with fused nodes, same as agoOptimizeDramaMerge
+	AgoKernel * fkernel = agoFindKernelByEnum(agraph->ref.context, VX_KERNEL_AMD_FUSED_ELEMWISE_ANY_ANY);
+	std::vector<bool> nodeIsFused(nodeList.size(), false);
+	for (size_t k = 0; valid && k < fuseList.size(); k++) {
+		size_t first = fuseList[k].first, count = fuseList[k].second;
+		if (!fkernel || count < 2 || first + count > nodeList.size() || std::find(nodeIsFused.begin() + first, nodeIsFused.begin() + first + count, true) != nodeIsFused.begin() + first + count) {
+			valid = false;
+			break;
+		}
+		std::vector<AgoNode *> fnodeList(nodeList.begin() + first, nodeList.begin() + first + count);
+		std::vector<AgoData *> inputList;
+		for (AgoNode * anode : fnodeList) {
+			for (vx_uint32 arg = 1; arg < anode->paramCount; arg++) {
+				AgoData * adata = anode->paramList[arg];
+				bool isIntermediate = false;
+				for (AgoNode * bnode : fnodeList)
+					isIntermediate = isIntermediate || (adata == bnode->paramList[0]);
+				if (adata && !isIntermediate && std::find(inputList.begin(), inputList.end(), adata) == inputList.end())
+					inputList.push_back(adata);
+			}
+		}
+		if (1 + inputList.size() > fkernel->argCount) {
+			valid = false;
+			break;
+		}
+		AgoNode * fnode = agoCreateNode(agraph, fkernel);
+		fusedNodeList.push_back(fnode);
+		fnode->paramList[0] = fnodeList.back()->paramList[0];
+		for (size_t i = 0; i < inputList.size(); i++)
+			fnode->paramList[1 + i] = inputList[i];
+		fnode->fusedNodeList = fnodeList;
+		fnode->attr_affinity.device_type = AGO_KERNEL_FLAG_DEVICE_CPU;
+		fnode->attr_affinity.device_info = 0;
+		fnode->attr_affinity.group = 0;
+		for (size_t i = first; i < first + count; i++)
+			nodeIsFused[i] = true;
+	}
+
+	// verify new nodes: fused nodes verify the nodes inside them
+	for (size_t i = 0; valid && i < nodeList.size(); i++) {
+		if (!nodeIsFused[i] && agoVerifyNode(nodeList[i]))
+			valid = false;
+	}
+	for (size_t i = 0; valid && i < fusedNodeList.size(); i++) {
+		if (agoVerifyNode(fusedNodeList[i]))
+			valid = false;
+	}
+	if (!valid) {
+		agoAddLogEntry(&agraph->ref, VX_SUCCESS, "WARNING: agoOptimizeDramaCacheLookup: ignored invalid cache file %s\n", entry.fileName.c_str());
+		agoDramaCacheRemoveNodes(agraph, fusedNodeList, nodeList);
+		for (auto it = formatList.rbegin(); it != formatList.rend(); ++it)
+			it->first->u.img.format = it->second;
+		return 0;
+	}
+
+	// move the nodes of the original graph and the nodes inside fused nodes to trash, same as agoOptimizeDramaDivide
+	for (vx_uint32 i = 0; i < userNodeCount; i++) {
+		if (agoRemoveNode(&agraph->nodeList, agraph->nodeList.head, true)) {
+			agoAddLogEntry(&agraph->ref, VX_FAILURE, "ERROR: agoOptimizeDramaCacheLookup: agoRemoveNode failed\n");
+			return -1;
+		}
+	}
+	for (size_t i = 0; i < nodeList.size(); i++) {
+		if (nodeIsFused[i] && agoRemoveNode(&agraph->nodeList, nodeList[i], true)) {
+			agoAddLogEntry(&agraph->ref, VX_FAILURE, "ERROR: agoOptimizeDramaCacheLookup: agoRemoveNode failed\n");
+			return -1;
+		}
+	}
+	for (AgoData * data : valueUsedList)
+		data->isValueUsedByOptimizer = vx_true_e;
+	return 1;
+}
+
+int agoOptimizeDramaCacheLookup(AgoGraph * agraph, AgoDramaCacheEntry& entry)
+{
+	entry.fileName.clear();
+	entry.key.clear();
+	entry.refList.clear();
+	char cacheDir[1024] = "";
+	if ((agraph->optimizer_flags & AGO_GRAPH_OPTIMIZER_FLAG_NO_GRAPH_CACHE) || !agraph->nodeList.head ||
+		!agoGetEnvironmentVariable("AGO_GRAPH_CACHE_DIR", cacheDir, sizeof(cacheDir)) || !cacheDir[0])
+		return 0;
+
+	// describe the graph before optimization: target, kernels, node attributes, and objects
+	AgoContext * context = agraph->ref.context;
+	char line[1280];
+	vx_uint32 defaultTarget;
+	bool defaultTargetGiven = agoOptimizeDramaGetDefaultTarget(defaultTarget);
+	sprintf(line, "#key graph 0x%08x %s %d,%d,%d %d,%d,%d\n", agraph->optimizer_flags,
+		!defaultTargetGiven ? "-" : (defaultTarget == AGO_KERNEL_FLAG_DEVICE_GPU ? "GPU" : "CPU"),
+		agraph->attr_affinity.device_type, agraph->attr_affinity.device_info, agraph->attr_affinity.group,
+		context->attr_affinity.device_type, context->attr_affinity.device_info, context->attr_affinity.group);
+	std::string key = AGO_DRAMA_CACHE_HEADER;
+	key += line;
+	std::map<AgoData *, int> refIndex;
+	for (AgoNode * node = agraph->nodeList.head; node; node = node->next) {
+		if (!agoDramaCacheIsSupportedNode(node))
+			return 0;
+		sprintf(line, "#key node %s 0x%08x 0x%08x", node->akernel->name, node->akernel->id, node->akernel->flags);
+		key += line;
+		for (vx_uint32 arg = 0; arg < node->paramCount; arg++) {
+			AgoData * data = node->paramList[arg];
+			if (data) {
+				agoDramaCacheAddRef(entry, refIndex, data);
+				sprintf(line, " $%d", refIndex[data] + 1);
+				key += line;
+			}
+			else key += " null";
+		}
+		key += agoDramaCacheGetNodeAttributes(node) + "\n";
+	}
+	for (size_t i = 0; i < entry.refList.size(); i++) {
+		AgoData * data = entry.refList[i];
+		if (agoIsPartOfDelay(data)) {
+			entry.refList.clear();
+			return 0;
+		}
+		// contents of small objects can affect the optimizer, image contents can't: values of scalars
+		// and thresholds are hashed too, since descriptions print floating-point values with %g
+		vx_uint64 hash = 0;
+		if ((data->ref.type == VX_TYPE_MATRIX || data->ref.type == VX_TYPE_CONVOLUTION || data->ref.type == VX_TYPE_LUT) && data->buffer)
+			hash = agoDramaCacheHash(data->buffer, data->size);
+		else if (data->ref.type == VX_TYPE_SCALAR && data->u.scalar.type != VX_TYPE_STRING_AMD)
+			hash = agoDramaCacheHash(&data->u.scalar.u, min(data->u.scalar.itemsize, sizeof(data->u.scalar.u)));
+		else if (data->ref.type == VX_TYPE_THRESHOLD)
+			hash = agoDramaCacheHash(&data->u.thr, sizeof(data->u.thr));
+		char desc[1024];
+		agoGetDescriptionFromData(context, desc, data);
+		sprintf(line, "#key data $%d %s %d %016llx\n", (int)i + 1, desc, data->ref.read_only ? 1 : 0, (unsigned long long)hash);
+		key += line;
+	}
+	sprintf(line, "/ago-graph-%016llx.gdf", (unsigned long long)agoDramaCacheHash(key.c_str(), key.size()));
+	entry.key = key;
+	entry.fileName = std::string(cacheDir) + line;
+
+	return agoDramaCacheLoad(agraph, entry);
+}
+
+void agoOptimizeDramaCacheSave(AgoGraph * agraph, AgoDramaCacheEntry& entry)
+{
+	if (entry.fileName.empty())
+		return;
+	std::map<AgoData *, int> refIndex;
+	for (size_t i = 0; i < entry.refList.size(); i++)
+		refIndex[entry.refList[i]] = (int)i;
+
+	// list formats of virtual images, scalars whose values were used, nodes with the nodes inside fused nodes,
+	// and the data written by them
+	std::string text = entry.key;
+	std::vector<AgoNode *> nodeList;
+	std::map<AgoData *, bool> writtenData;
+	char line[1280];
+	for (size_t i = 0; i < entry.refList.size(); i++) {
+		AgoData * data = entry.refList[i];
+		if (data->ref.type == VX_TYPE_IMAGE && data->isVirtual) {
+			sprintf(line, "#format $%d 0x%08x\n", (int)i + 1, data->u.img.format);
+			text += line;
+		}
+		else if (data->ref.type == VX_TYPE_SCALAR && data->isValueUsedByOptimizer) {
+			sprintf(line, "#valueused $%d\n", (int)i + 1);
+			text += line;
+		}
+	}
+	for (AgoNode * node = agraph->nodeList.head; node; node = node->next) {
+		if (!node->fusedNodeList.empty()) {
+			sprintf(line, "#fuse %d %d\n", (int)nodeList.size(), (int)node->fusedNodeList.size());
+			text += line;
+			nodeList.insert(nodeList.end(), node->fusedNodeList.begin(), node->fusedNodeList.end());
+		}
+		else nodeList.push_back(node);
+	}
+	for (AgoNode * node : nodeList) {
+		if (!agoDramaCacheIsSupportedNode(node))
+			return;
+		for (vx_uint32 arg = 0; arg < node->paramCount; arg++) {
+			AgoData * data = node->paramList[arg];
+			if (data && (node->akernel->argConfig[arg] & AGO_KERNEL_ARG_OUTPUT_FLAG)) {
+				writtenData[data] = true;
+				if (data->parent) writtenData[data->parent] = true;
+			}
+		}
+	}
+
+	// declare virtual data created by the optimizer: it shall be written by a node or described by its value
+	std::string nodeText;
+	std::map<AgoData *, std::string> dataName;
+	for (AgoNode * node : nodeList) {
+		nodeText += "node ";
+		nodeText += node->akernel->name;
+		vx_uint32 paramCount = node->paramCount;
+		while (paramCount > 0 && !node->paramList[paramCount - 1])
+			paramCount--;
+		for (vx_uint32 arg = 0; arg < paramCount; arg++) {
+			AgoData * data = node->paramList[arg];
+			if (!data) {
+				nodeText += " null";
+				continue;
+			}
+			auto itRef = refIndex.find(data);
+			if (itRef != refIndex.end()) {
+				sprintf(line, " $%d", itRef->second + 1);
+				nodeText += line;
+				continue;
+			}
+			AgoData * adata = data->parent ? data->parent : data;
+			if (adata->parent || refIndex.find(adata) != refIndex.end())
+				return;
+			if (dataName.find(adata) == dataName.end()) {
+				bool hasValue = (adata->ref.type == VX_TYPE_SCALAR || adata->ref.type == VX_TYPE_THRESHOLD || adata->ref.type == AGO_TYPE_SCALE_MATRIX ||
+					(adata->ref.type == VX_TYPE_IMAGE && adata->u.img.isUniform)) ? true : false;
+				char desc[1024];
+				agoGetDescriptionFromData(agraph->ref.context, desc, adata);
+				if (!adata->isVirtual || (adata->ref.type == VX_TYPE_IMAGE && adata->u.img.isROI) || (!hasValue && writtenData.find(adata) == writtenData.end()) || strpbrk(desc, " \t#$"))
+					return;
+				char name[64];
+				sprintf(name, "CACHE!%04d", (int)dataName.size());
+				dataName[adata] = name;
+				sprintf(line, "data %s = %s\n", name, desc);
+				text += line;
+			}
+			nodeText += " " + dataName[adata];
+			if (data != adata) {
+				sprintf(line, "[%d]", data->siblingIndex);
+				nodeText += line;
+			}
+		}
+		nodeText += agoDramaCacheGetNodeAttributes(node) + "\n";
+	}
+	text += nodeText;
+
+	// write to a temporary file first, so that other processes never read a partial cache file
+	std::string fileNameTmp = entry.fileName + ".tmp";
+	FILE * fp = fopen(fileNameTmp.c_str(), "wb");
+	if (!fp) {
+		agoAddLogEntry(&agraph->ref, VX_SUCCESS, "WARNING: agoOptimizeDramaCacheSave: unable to create %s\n", fileNameTmp.c_str());
+		return;
+	}
+	bool written = (fwrite(text.c_str(), 1, text.size(), fp) == text.size()) ? true : false;
+	fclose(fp);
+	if (written && rename(fileNameTmp.c_str(), entry.fileName.c_str()) != 0) {
+		remove(entry.fileName.c_str());
+		written = (rename(fileNameTmp.c_str(), entry.fileName.c_str()) == 0) ? true : false;
+	}
+	if (!written)
+		remove(fileNameTmp.c_str());
+	else
+		agoOptimizerLogEntry(agraph, "cache", "save", "%s", entry.fileName.c_str());
+}
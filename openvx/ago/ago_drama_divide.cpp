@@ -26,6 +26,13 @@ THE SOFTWARE.
 #define SANITY_CHECK_DATA_TYPE(data,data_type)          if(!data || data->ref.type != data_type) return -1
 #define SANITY_CHECK_DATA_TYPE_OPTIONAL(data,data_type) if( data && data->ref.type != data_type) return -1
 
+static inline AgoData * agoDramaDivideUseScalarValue(AgoData * data)
+{
+	// scalar values that pick kernels can't be changed by agoRebindDataInGraph after graph optimization
+	data->isValueUsedByOptimizer = vx_true_e;
+	return data;
+}
+
 int agoDramaDivideAppend(AgoNodeList * nodeList, AgoNode * anode, vx_enum new_kernel_id, vx_reference * paramList, vx_uint32 paramCount)
 {
 	if (new_kernel_id == VX_KERNEL_AMD_INVALID) {
@@ -347,7 +354,7 @@ int agoDramaDivideChannelExtractNode(AgoNodeList * nodeList, AgoNode * anode)
 	AgoData * channelParam = anode->paramList[1];
 	AgoData * dstParam = anode->paramList[2];
 	vx_df_image itype = srcParam->u.img.format;
-	vx_enum channel_e = channelParam->u.scalar.u.e;
+	vx_enum channel_e = agoDramaDivideUseScalarValue(channelParam)->u.scalar.u.e;
 	// divide the node
 	if (itype == VX_DF_IMAGE_RGB) {
 		anode->paramList[0] = dstParam;
@@ -576,7 +583,7 @@ int agoDramaDivideScaleImageNode(AgoNodeList * nodeList, AgoNode * anode)
 		new_kernel_id = VX_KERNEL_AMD_CHANNEL_COPY_U8_U8;
 	}
 	else {
-		vx_enum interpolation = paramList[2]->u.scalar.u.e;
+		vx_enum interpolation = agoDramaDivideUseScalarValue(paramList[2])->u.scalar.u.e;
 		// identify scale kernel
 		anode->paramList[0] = paramList[1];
 		anode->paramList[1] = paramList[0];
@@ -843,7 +850,13 @@ int agoDramaDivideCustomConvolutionNode(AgoNodeList * nodeList, AgoNode * anode)
 	anode->paramCount = 3;
 	vx_df_image dst_image_format = paramList[2]->u.img.format;
 	vx_enum new_kernel_id = VX_KERNEL_AMD_INVALID;
-	if ((paramList[1]->u.conv.rows & 1) && (paramList[1]->u.conv.columns & 1)) new_kernel_id = (dst_image_format == VX_DF_IMAGE_U8) ? VX_KERNEL_AMD_CONVOLVE_U8_U8 : VX_KERNEL_AMD_CONVOLVE_S16_U8;
+	if ((paramList[1]->u.conv.rows & 1) && (paramList[1]->u.conv.columns & 1)) {
+		// rank-1 coefficients: use horizontal + vertical 1D passes instead of the full 2D convolution
+		if (paramList[1]->u.conv.is_separable && paramList[1]->u.conv.rows > 1 && paramList[1]->u.conv.columns > 1)
+			new_kernel_id = (dst_image_format == VX_DF_IMAGE_U8) ? VX_KERNEL_AMD_CONVOLVE_U8_U8_SEPARABLE : VX_KERNEL_AMD_CONVOLVE_S16_U8_SEPARABLE;
+		else
+			new_kernel_id = (dst_image_format == VX_DF_IMAGE_U8) ? VX_KERNEL_AMD_CONVOLVE_U8_U8 : VX_KERNEL_AMD_CONVOLVE_S16_U8;
+	}
 	else {
 		agoAddLogEntry(&paramList[1]->ref, VX_FAILURE, "ERROR: agoDramaDivideCustomConvolutionNode: convolution size " VX_FMT_SIZE "x" VX_FMT_SIZE " not supported\n", paramList[1]->u.conv.rows, paramList[1]->u.conv.columns);
 		return -1;
@@ -1136,8 +1149,8 @@ int agoDramaDivideConvertDepthNode(AgoNodeList * nodeList, AgoNode * anode)
 		new_kernel_id = VX_KERNEL_AMD_COLOR_DEPTH_S16_U8;
 	}
 	else if (paramList[1]->u.img.format == VX_DF_IMAGE_U8 || paramList[0]->u.img.format == VX_DF_IMAGE_S16) {
-		if (paramList[2]->u.scalar.u.e == VX_CONVERT_POLICY_WRAP) new_kernel_id = VX_KERNEL_AMD_COLOR_DEPTH_U8_S16_WRAP;
-		else if (paramList[2]->u.scalar.u.e == VX_CONVERT_POLICY_SATURATE) new_kernel_id = VX_KERNEL_AMD_COLOR_DEPTH_U8_S16_SAT;
+		if (agoDramaDivideUseScalarValue(paramList[2])->u.scalar.u.e == VX_CONVERT_POLICY_WRAP) new_kernel_id = VX_KERNEL_AMD_COLOR_DEPTH_U8_S16_WRAP;
+		else if (agoDramaDivideUseScalarValue(paramList[2])->u.scalar.u.e == VX_CONVERT_POLICY_SATURATE) new_kernel_id = VX_KERNEL_AMD_COLOR_DEPTH_U8_S16_SAT;
 	}
 	return agoDramaDivideAppend(nodeList, anode, new_kernel_id);
 }
@@ -1220,8 +1233,8 @@ int agoDramaDivideMultiplyNode(AgoNodeList * nodeList, AgoNode * anode)
 	vx_df_image otype = paramList[5]->u.img.format;
 	vx_df_image itypeA = paramList[0]->u.img.format;
 	vx_df_image itypeB = paramList[1]->u.img.format;
-	vx_enum overflow_policy = paramList[3]->u.scalar.u.e;
-	vx_enum rounding_policy = paramList[4]->u.scalar.u.e;
+	vx_enum overflow_policy = agoDramaDivideUseScalarValue(paramList[3])->u.scalar.u.e;
+	vx_enum rounding_policy = agoDramaDivideUseScalarValue(paramList[4])->u.scalar.u.e;
 	anode->paramList[0] = paramList[5];
 	anode->paramList[1] = paramList[0];
 	anode->paramList[2] = paramList[1];
@@ -1287,7 +1300,7 @@ int agoDramaDivideAddNode(AgoNodeList * nodeList, AgoNode * anode)
 	vx_df_image otype = paramList[3]->u.img.format;
 	vx_df_image itypeA = paramList[0]->u.img.format;
 	vx_df_image itypeB = paramList[1]->u.img.format;
-	vx_enum convert_policy = paramList[2]->u.scalar.u.e;
+	vx_enum convert_policy = agoDramaDivideUseScalarValue(paramList[2])->u.scalar.u.e;
 	anode->paramList[0] = paramList[3];
 	anode->paramList[1] = paramList[0];
 	anode->paramList[2] = paramList[1];
@@ -1329,7 +1342,7 @@ int agoDramaDivideSubtractNode(AgoNodeList * nodeList, AgoNode * anode)
 	vx_df_image otype = paramList[3]->u.img.format;
 	vx_df_image itypeA = paramList[0]->u.img.format;
 	vx_df_image itypeB = paramList[1]->u.img.format;
-	vx_enum convert_policy = paramList[2]->u.scalar.u.e;
+	vx_enum convert_policy = agoDramaDivideUseScalarValue(paramList[2])->u.scalar.u.e;
 	anode->paramList[0] = paramList[3];
 	anode->paramList[1] = paramList[0];
 	anode->paramList[2] = paramList[1];
@@ -1371,8 +1384,8 @@ int agoDramaDivideHalfscaleGaussianNode(AgoNodeList * nodeList, AgoNode * anode)
 	anode->paramList[1] = paramList[0];
 	anode->paramCount = 2;
 	vx_enum new_kernel_id = VX_KERNEL_AMD_INVALID;
-	if (paramList[2]->u.scalar.u.i == 3) new_kernel_id = VX_KERNEL_AMD_SCALE_GAUSSIAN_HALF_U8_U8_3x3;
-	else if (paramList[2]->u.scalar.u.i == 5) new_kernel_id = VX_KERNEL_AMD_SCALE_GAUSSIAN_HALF_U8_U8_5x5;
+	if (agoDramaDivideUseScalarValue(paramList[2])->u.scalar.u.i == 3) new_kernel_id = VX_KERNEL_AMD_SCALE_GAUSSIAN_HALF_U8_U8_3x3;
+	else if (agoDramaDivideUseScalarValue(paramList[2])->u.scalar.u.i == 5) new_kernel_id = VX_KERNEL_AMD_SCALE_GAUSSIAN_HALF_U8_U8_5x5;
 	return agoDramaDivideAppend(nodeList, anode, new_kernel_id);
 }
 
@@ -1390,7 +1403,7 @@ int agoDramaDivideRemapNode(AgoNodeList * nodeList, AgoNode * anode)
 	anode->paramList[1] = paramList[0];
 	anode->paramList[2] = paramList[1];
 	anode->paramCount = 3;
-	vx_enum interpolation = paramList[2]->u.scalar.u.e;
+	vx_enum interpolation = agoDramaDivideUseScalarValue(paramList[2])->u.scalar.u.e;
 	vx_enum new_kernel_id = VX_KERNEL_AMD_INVALID;
 	if (anode->paramList[0]->u.img.format == VX_DF_IMAGE_U8 && anode->paramList[1]->u.img.format == VX_DF_IMAGE_U8) {
 		if (anode->attr_border_mode.mode == VX_BORDER_MODE_UNDEFINED) {
@@ -1442,12 +1455,16 @@ int agoDramaDivideWarpAffineNode(AgoNodeList * nodeList, AgoNode * anode)
 	anode->paramList[1] = paramList[0];
 	anode->paramList[2] = paramList[1];
 	anode->paramCount = 3;
-	vx_enum interpolation = paramList[2]->u.scalar.u.e;
+	vx_enum interpolation = agoDramaDivideUseScalarValue(paramList[2])->u.scalar.u.e;
 	vx_enum new_kernel_id = VX_KERNEL_AMD_INVALID;
 	if (anode->attr_border_mode.mode == VX_BORDER_MODE_UNDEFINED) {
 		if (interpolation == VX_INTERPOLATION_TYPE_NEAREST_NEIGHBOR) new_kernel_id = VX_KERNEL_AMD_WARP_AFFINE_U8_U8_NEAREST;
 		else if (interpolation == VX_INTERPOLATION_TYPE_BILINEAR) new_kernel_id = VX_KERNEL_AMD_WARP_AFFINE_U8_U8_BILINEAR;
 	}
+	else if (anode->attr_border_mode.mode == VX_BORDER_MODE_REPLICATE) {
+		if (interpolation == VX_INTERPOLATION_TYPE_NEAREST_NEIGHBOR) new_kernel_id = VX_KERNEL_AMD_WARP_AFFINE_U8_U8_NEAREST_REPLICATE;
+		else if (interpolation == VX_INTERPOLATION_TYPE_BILINEAR) new_kernel_id = VX_KERNEL_AMD_WARP_AFFINE_U8_U8_BILINEAR_REPLICATE;
+	}
 	else if (anode->attr_border_mode.mode == VX_BORDER_MODE_CONSTANT) {
 		if (interpolation == VX_INTERPOLATION_TYPE_NEAREST_NEIGHBOR) new_kernel_id = VX_KERNEL_AMD_WARP_AFFINE_U8_U8_NEAREST_CONSTANT;
 		else if (interpolation == VX_INTERPOLATION_TYPE_BILINEAR) new_kernel_id = VX_KERNEL_AMD_WARP_AFFINE_U8_U8_BILINEAR_CONSTANT;
@@ -1480,12 +1497,16 @@ int agoDramaDivideWarpPerspectiveNode(AgoNodeList * nodeList, AgoNode * anode)
 	anode->paramList[1] = paramList[0];
 	anode->paramList[2] = paramList[1];
 	anode->paramCount = 3;
-	vx_enum interpolation = paramList[2]->u.scalar.u.e;
+	vx_enum interpolation = agoDramaDivideUseScalarValue(paramList[2])->u.scalar.u.e;
 	vx_enum new_kernel_id = VX_KERNEL_AMD_INVALID;
 	if (anode->attr_border_mode.mode == VX_BORDER_MODE_UNDEFINED) {
 		if (interpolation == VX_INTERPOLATION_TYPE_NEAREST_NEIGHBOR) new_kernel_id = VX_KERNEL_AMD_WARP_PERSPECTIVE_U8_U8_NEAREST;
 		else if (interpolation == VX_INTERPOLATION_TYPE_BILINEAR) new_kernel_id = VX_KERNEL_AMD_WARP_PERSPECTIVE_U8_U8_BILINEAR;
 	}
+	else if (anode->attr_border_mode.mode == VX_BORDER_MODE_REPLICATE) {
+		if (interpolation == VX_INTERPOLATION_TYPE_NEAREST_NEIGHBOR) new_kernel_id = VX_KERNEL_AMD_WARP_PERSPECTIVE_U8_U8_NEAREST_REPLICATE;
+		else if (interpolation == VX_INTERPOLATION_TYPE_BILINEAR) new_kernel_id = VX_KERNEL_AMD_WARP_PERSPECTIVE_U8_U8_BILINEAR_REPLICATE;
+	}
 	else if (anode->attr_border_mode.mode == VX_BORDER_MODE_CONSTANT) {
 		if (interpolation == VX_INTERPOLATION_TYPE_NEAREST_NEIGHBOR) new_kernel_id = VX_KERNEL_AMD_WARP_PERSPECTIVE_U8_U8_NEAREST_CONSTANT;
 		else if (interpolation == VX_INTERPOLATION_TYPE_BILINEAR) new_kernel_id = VX_KERNEL_AMD_WARP_PERSPECTIVE_U8_U8_BILINEAR_CONSTANT;
@@ -1515,17 +1536,27 @@ int agoDramaDivideCannyEdgeDetectorNode(AgoNodeList * nodeList, AgoNode * anode)
 	SANITY_CHECK_DATA_TYPE(anode->paramList[4], VX_TYPE_IMAGE);
 	// save parameters
 	AgoData * paramList[AGO_MAX_PARAMS]; memcpy(paramList, anode->paramList, sizeof(paramList));
-	vx_int32 gradient_size = paramList[2]->u.scalar.u.i;
-	vx_enum norm_type = paramList[3]->u.scalar.u.e;
-	// create virtual stack data for canny edges
-	//   stack size: TBD (currently set the size of the image)
-	vx_uint32 canny_stack_size = paramList[0]->u.img.width * paramList[0]->u.img.height;
-	char desc[256]; sprintf(desc, "ago-canny-stack-virtual:%u", canny_stack_size);
+	vx_int32 gradient_size = agoDramaDivideUseScalarValue(paramList[2])->u.scalar.u.i;
+	vx_enum norm_type = agoDramaDivideUseScalarValue(paramList[3])->u.scalar.u.e;
 	AgoGraph * agraph = (AgoGraph *)anode->ref.scope;
-	AgoData * data = agoCreateDataFromDescription(anode->ref.context, agraph, desc, false);
-	if (!data) return -1;
-	agoGenerateVirtualDataName(agraph, "canny-stack", data->name);
-	agoAddData(&agraph->dataList, data);
+#if USE_AGO_CANNY_SOBEL_SUPP_THRESHOLD
+	bool bandTrace = false;
+#else
+	// with multiple CPU threads, trace in parallel bands that find the strong edges by scanning the image,
+	// so that the stack of strong edges is needed only by the serial trace
+	bool bandTrace = (HafCpu_GetThreadCount() > 1);
+#endif
+	AgoData * data = nullptr;
+	if (!bandTrace) {
+		// create virtual stack data for canny edges
+		//   stack size: TBD (currently set the size of the image)
+		vx_uint32 canny_stack_size = paramList[0]->u.img.width * paramList[0]->u.img.height;
+		char desc[256]; sprintf(desc, "ago-canny-stack-virtual:%u", canny_stack_size);
+		data = agoCreateDataFromDescription(anode->ref.context, agraph, desc, false);
+		if (!data) return -1;
+		agoGenerateVirtualDataName(agraph, "canny-stack", data->name);
+		agoAddData(&agraph->dataList, data);
+	}
 #if USE_AGO_CANNY_SOBEL_SUPP_THRESHOLD
 	// compute sobel, nonmax-supression, and threshold
 	anode->paramList[0] = paramList[4];
@@ -1569,19 +1600,36 @@ int agoDramaDivideCannyEdgeDetectorNode(AgoNodeList * nodeList, AgoNode * anode)
 	}
 	int status = agoDramaDivideAppend(nodeList, anode, new_kernel_id);
 	// compute nonmax-supression and threshold
-	anode->paramList[0] = paramList[4];
-	anode->paramList[1] = data;
-	anode->paramList[2] = dataSobel;
-	anode->paramList[3] = paramList[1];
-	anode->paramList[4] = paramList[2];
-	anode->paramCount = 5;
-	status |= agoDramaDivideAppend(nodeList, anode, VX_KERNEL_AMD_CANNY_SUPP_THRESHOLD_U8XY_U16_3x3);
+	if (bandTrace) {
+		anode->paramList[0] = paramList[4];
+		anode->paramList[1] = dataSobel;
+		anode->paramList[2] = paramList[1];
+		anode->paramList[3] = paramList[2];
+		anode->paramCount = 4;
+		status |= agoDramaDivideAppend(nodeList, anode, VX_KERNEL_AMD_CANNY_SUPP_THRESHOLD_U8_U16_3x3);
+	}
+	else {
+		anode->paramList[0] = paramList[4];
+		anode->paramList[1] = data;
+		anode->paramList[2] = dataSobel;
+		anode->paramList[3] = paramList[1];
+		anode->paramList[4] = paramList[2];
+		anode->paramCount = 5;
+		status |= agoDramaDivideAppend(nodeList, anode, VX_KERNEL_AMD_CANNY_SUPP_THRESHOLD_U8XY_U16_3x3);
+	}
 #endif
 	// run edge trace
-	anode->paramList[0] = paramList[4];
-	anode->paramList[1] = data;
-	anode->paramCount = 2;
-	status |= agoDramaDivideAppend(nodeList, anode, VX_KERNEL_AMD_CANNY_EDGE_TRACE_U8_U8XY);
+	if (bandTrace) {
+		anode->paramList[0] = paramList[4];
+		anode->paramCount = 1;
+		status |= agoDramaDivideAppend(nodeList, anode, VX_KERNEL_AMD_CANNY_EDGE_TRACE_U8_U8);
+	}
+	else {
+		anode->paramList[0] = paramList[4];
+		anode->paramList[1] = data;
+		anode->paramCount = 2;
+		status |= agoDramaDivideAppend(nodeList, anode, VX_KERNEL_AMD_CANNY_EDGE_TRACE_U8_U8XY);
+	}
 	return status;
 }
 
@@ -1599,8 +1647,8 @@ int agoDramaDivideHarrisCornersNode(AgoNodeList * nodeList, AgoNode * anode)
 	SANITY_CHECK_DATA_TYPE_OPTIONAL(anode->paramList[7], VX_TYPE_SCALAR);
 	// save parameters
 	AgoData * paramList[AGO_MAX_PARAMS]; memcpy(paramList, anode->paramList, sizeof(paramList));
-	vx_int32 window_size = paramList[4]->u.scalar.u.i;
-	vx_int32 block_size = paramList[5]->u.scalar.u.i;
+	vx_int32 window_size = agoDramaDivideUseScalarValue(paramList[4])->u.scalar.u.i;
+	vx_int32 block_size = agoDramaDivideUseScalarValue(paramList[5])->u.scalar.u.i;
 	// create virtual images for HG3, HVC, and XYS
 	AgoGraph * agraph = (AgoGraph *)anode->ref.scope;
 	char desc[64];
@@ -1688,7 +1736,7 @@ int agoDramaDivideFastCornersNode(AgoNodeList * nodeList, AgoNode * anode)
 	anode->paramList[3] = paramList[1];
 	anode->paramCount = 4;
 	vx_enum new_kernel_id = VX_KERNEL_AMD_FAST_CORNERS_XY_U8_SUPRESSION;
-	if (paramList[2]->u.scalar.u.i == 0) new_kernel_id = VX_KERNEL_AMD_FAST_CORNERS_XY_U8_NOSUPRESSION;
+	if (agoDramaDivideUseScalarValue(paramList[2])->u.scalar.u.i == 0) new_kernel_id = VX_KERNEL_AMD_FAST_CORNERS_XY_U8_NOSUPRESSION;
 	return agoDramaDivideAppend(nodeList, anode, new_kernel_id);
 }
 
@@ -1708,58 +1756,79 @@ int agoDramaDivideOpticalFlowPyrLkNode(AgoNodeList * nodeList, AgoNode * anode)
 	SANITY_CHECK_DATA_TYPE(anode->paramList[9], VX_TYPE_SCALAR);
 	// save parameters
 	AgoData * paramList[AGO_MAX_PARAMS]; memcpy(paramList, anode->paramList, sizeof(paramList));
-#if 0 // TBD -- enable this when low-level primitives are ready
 	AgoGraph * agraph = (AgoGraph *)anode->ref.scope;
-	vx_status status;
-	char desc[256];
-	// add VX_KERNEL_AMD_OPTICAL_FLOW_PREPARE_LK_XY_XY node
-	sprintf(desc, "array-virtual:INT32,%d", paramList[1]->u.arr.capacity);
-	AgoData * dataXYmap = agoCreateDataFromDescription(anode->ref.context, agraph, desc, false); if (!dataXYmap) return -1; 
-	dataXYmap->name = agoGenerateVirtualDataName(agraph, "XYmap"); agoAddData(&agraph->dataList, dataXYmap);
-	sprintf(desc, "array-virtual:COORDINATES2D,%d", paramList[1]->u.arr.capacity);
-	AgoData * dataXY0 = agoCreateDataFromDescription(anode->ref.context, agraph, desc, false); if (!dataXY0) return -1;
-	dataXY0->name = agoGenerateVirtualDataName(agraph, "XY"); agoAddData(&agraph->dataList, dataXY0);
-	anode->paramList[0] = dataXY0;      // tmpXY
-	anode->paramList[1] = dataXYmap;    // XYmap
-	anode->paramList[2] = paramList[2]; // old_points
-	anode->paramList[3] = paramList[3]; // new_points_estimates
-	anode->paramList[4] = paramList[8]; // use_initial_estimate
-	anode->paramCount = 5;
-	status = agoDramaDivideAppend(nodeList, anode, VX_KERNEL_AMD_OPTICAL_FLOW_PREPARE_LK_XY_XY); if (status) return status;
-	// add VX_KERNEL_AMD_OPTICAL_FLOW_IMAGE_LK_XY_XY node per each image in reverse order from the pyramids
-	float scale = anode->paramList[0]->u.pyr.scale * anode->paramList[0]->u.pyr.levels;
-	for (vx_int32 child = (vx_int32)anode->paramList[0]->u.pyr.levels - 1; child >= 0; child--) {
-		AgoData * imgOld = paramList[0]->children[child]; if (!imgOld) return VX_ERROR_INVALID_REFERENCE;
-		AgoData * imgNew = paramList[1]->children[child]; if (!imgNew) return VX_ERROR_INVALID_REFERENCE;
-		sprintf(desc, "array-virtual:COORDINATES2D,%d", paramList[1]->u.arr.capacity);
-		AgoData * dataXY1 = agoCreateDataFromDescription(anode->ref.context, agraph, desc, false); if (!dataXY1) return -1;
-		dataXY1->name = agoGenerateVirtualDataName(agraph, "XY"); agoAddData(&agraph->dataList, dataXY1);
-		sprintf(desc, "scalar-virtual:FLOAT,%g", scale);
-		AgoData * dataScale = agoCreateDataFromDescription(anode->ref.context, agraph, desc, false); if (!dataScale) return -1;
-		dataScale->name = agoGenerateVirtualDataName(agraph, "scale"); agoAddData(&agraph->dataList, dataScale);
-		anode->paramList[0] = dataXY1;      // new points
-		anode->paramList[1] = dataXY0;      // old points
-		anode->paramList[2] = imgOld;       // old image
-		anode->paramList[3] = imgNew;       // new image
-		anode->paramList[4] = paramList[5]; // termination
-		anode->paramList[5] = paramList[6]; // epsilon
-		anode->paramList[6] = paramList[7]; // num_iterations
-		anode->paramList[7] = paramList[9]; // window_dimension 
-		anode->paramList[8] = dataScale;    // scale factor
-		anode->paramCount = 9;
-		status = agoDramaDivideAppend(nodeList, anode, VX_KERNEL_AMD_OPTICAL_FLOW_IMAGE_LK_XY_XY); if (status) return status;
-		// save dataXY1 for future reference and set scale factor to inverse of pyramid scale
-		dataXY0 = dataXY1;
-		scale = 1.0f / anode->paramList[0]->u.pyr.scale;
-	}
-	// add VX_KERNEL_AMD_OPTICAL_FLOW_FINAL_LK_XY_XY node
-	anode->paramList[0] = paramList[4]; // new_points
-	anode->paramList[1] = dataXY0;      // tmpXY
-	anode->paramList[2] = dataXYmap;    // XYmap
-	anode->paramCount = 3;
-	status = agoDramaDivideAppend(nodeList, anode, VX_KERNEL_AMD_OPTICAL_FLOW_FINAL_LK_XY_XY); if (status) return status;
-	return status;
-#else
+	if (agraph->optimizer_flags & AGO_GRAPH_OPTIMIZER_FLAG_SPLIT_OPTICAL_FLOW) {
+		// track in stages: prepare initial estimates, track with one node per pyramid level from top, and output the keypoints
+		vx_size capacity = paramList[2]->u.arr.capacity;
+		vx_uint32 levels = (vx_uint32)paramList[0]->u.pyr.levels;
+		char desc[64];
+		sprintf(desc, "scalar-virtual:UINT32,%d", levels);
+		AgoData * dataLevels = agoCreateDataFromDescription(anode->ref.context, agraph, desc, false);
+		AgoData * dataScale = agoCreateDataFromDescription(anode->ref.context, agraph, "scalar-virtual:FLOAT32,0", false);
+		if (!dataLevels || !dataScale) return -1;
+		dataScale->u.scalar.u.f = paramList[0]->u.pyr.scale;
+		agoGenerateVirtualDataName(agraph, "levels", dataLevels->name);
+		agoGenerateVirtualDataName(agraph, "scale", dataScale->name);
+		agoAddData(&agraph->dataList, dataLevels);
+		agoAddData(&agraph->dataList, dataScale);
+		AgoData * dataXY = nullptr, * dataNextXY = nullptr;
+		for (vx_int32 level = (vx_int32)levels; level >= 0; level--) {
+			// tracking state after each stage: keypoints and estimates for next level
+			sprintf(desc, "array-virtual:KEYPOINT,%d", (vx_uint32)capacity);
+			AgoData * dataXYout = agoCreateDataFromDescription(anode->ref.context, agraph, desc, false);
+			sprintf(desc, "array-virtual:COORDINATES2DF,%d", (vx_uint32)capacity);
+			AgoData * dataNextXYout = agoCreateDataFromDescription(anode->ref.context, agraph, desc, false);
+			if (!dataXYout || !dataNextXYout) return -1;
+			agoGenerateVirtualDataName(agraph, "XY", dataXYout->name);
+			agoGenerateVirtualDataName(agraph, "nextXY", dataNextXYout->name);
+			agoAddData(&agraph->dataList, dataXYout);
+			agoAddData(&agraph->dataList, dataNextXYout);
+			int status;
+			if (level == (vx_int32)levels) {
+				anode->paramList[0] = dataXYout;
+				anode->paramList[1] = dataNextXYout;
+				anode->paramList[2] = paramList[2]; // old_points
+				anode->paramList[3] = paramList[3]; // new_points_estimates
+				anode->paramList[4] = paramList[8]; // use_initial_estimate
+				anode->paramList[5] = dataLevels;
+				anode->paramList[6] = dataScale;
+				anode->paramCount = 7;
+				status = agoDramaDivideAppend(nodeList, anode, VX_KERNEL_AMD_OPTICAL_FLOW_PREPARE_LK_XY_XY);
+			}
+			else {
+				AgoData * imgOld = paramList[0]->children[level]; if (!imgOld) return VX_ERROR_INVALID_REFERENCE;
+				AgoData * imgNew = paramList[1]->children[level]; if (!imgNew) return VX_ERROR_INVALID_REFERENCE;
+				sprintf(desc, "scalar-virtual:UINT32,%d", level);
+				AgoData * dataLevel = agoCreateDataFromDescription(anode->ref.context, agraph, desc, false);
+				if (!dataLevel) return -1;
+				agoGenerateVirtualDataName(agraph, "level", dataLevel->name);
+				agoAddData(&agraph->dataList, dataLevel);
+				anode->paramList[0] = dataXYout;
+				anode->paramList[1] = dataNextXYout;
+				anode->paramList[2] = dataXY;
+				anode->paramList[3] = dataNextXY;
+				anode->paramList[4] = paramList[2]; // old_points
+				anode->paramList[5] = imgOld;
+				anode->paramList[6] = imgNew;
+				anode->paramList[7] = paramList[5]; // termination
+				anode->paramList[8] = paramList[6]; // epsilon
+				anode->paramList[9] = paramList[7]; // num_iterations
+				anode->paramList[10] = paramList[9]; // window_dimension
+				anode->paramList[11] = dataLevel;
+				anode->paramList[12] = dataLevels;
+				anode->paramList[13] = dataScale;
+				anode->paramCount = 14;
+				status = agoDramaDivideAppend(nodeList, anode, VX_KERNEL_AMD_OPTICAL_FLOW_IMAGE_LK_XY_XY);
+			}
+			if (status) return status;
+			dataXY = dataXYout;
+			dataNextXY = dataNextXYout;
+		}
+		anode->paramList[0] = paramList[4]; // new_points
+		anode->paramList[1] = dataXY;
+		anode->paramCount = 2;
+		return agoDramaDivideAppend(nodeList, anode, VX_KERNEL_AMD_OPTICAL_FLOW_FINAL_LK_XY_XY);
+	}
 	anode->paramList[0] = paramList[4];
 	anode->paramList[1] = paramList[0];
 	anode->paramList[2] = paramList[1];
@@ -1772,7 +1841,6 @@ int agoDramaDivideOpticalFlowPyrLkNode(AgoNodeList * nodeList, AgoNode * anode)
 	anode->paramList[9] = paramList[9];
 	anode->paramCount = 10;
 	return agoDramaDivideAppend(nodeList, anode, VX_KERNEL_AMD_OPTICAL_FLOW_PYR_LK_XY_XY);
-#endif
 }
 
 int agoDramaDivideCopyNode(AgoNodeList * nodeList, AgoNode * anode)
@@ -1959,7 +2027,11 @@ int agoOptimizeDramaDivide(AgoGraph * agraph)
 		// check if current node is a general VX node, that needs division
 		if ((anode->akernel->flags & AGO_KERNEL_FLAG_GROUP_MASK) == AGO_KERNEL_FLAG_GROUP_OVX10) {
 			// divide the current node
+			vx_uint32 count = agraph->nodeList.count;
 			if (!agoDramaDivideNode(&agraph->nodeList, anode)) {
+				if (agraph->enable_optimizer_log) {
+					agoOptimizerLogEntry(agraph, "divide", "divide", "%s into %u nodes", agoGetNodeLogName(anode).c_str(), agraph->nodeList.count - count);
+				}
 				// remove and release the current node
 				if (aprev) aprev->next = anode->next;
 				else agraph->nodeList.head = anode->next;
@@ -1988,9 +2060,13 @@ int agoOptimizeDramaDivide(AgoGraph * agraph)
 			// try regenerating the node
 			anode->drama_divide_invoked = false;
 			vx_bool replace_original = vx_true_e;
+			vx_uint32 count = agraph->nodeList.count;
 			vx_status status = anode->akernel->regen_callback_f(anode, agoDramaDivideAddNodeCallback, replace_original);
 			if (status == VX_SUCCESS) {
 				if (anode->drama_divide_invoked && replace_original) {
+					if (agraph->enable_optimizer_log) {
+						agoOptimizerLogEntry(agraph, "divide", "regen", "%s into %u nodes", agoGetNodeLogName(anode).c_str(), agraph->nodeList.count - count);
+					}
 					// remove and release the current node
 					if (aprev) aprev->next = anode->next;
 					else agraph->nodeList.head = anode->next;
@@ -0,0 +1,169 @@
+/* 
+Copyright (c) 2015 Advanced Micro Devices, Inc. All rights reserved.
+ 
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+ 
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+ 
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+
+
+#include "ago_internal.h"
+
+static bool agoIsConstantData(AgoData * data, std::map<AgoData *, bool>& writtenData, std::map<AgoData *, bool>& foldedData)
+{
+	// data that can't change after verify: uniform images, read-only objects, scalars that
+	// can't be accessed by the application, and outputs of nodes that got pre-computed
+	if (foldedData.find(data) != foldedData.end())
+		return true;
+	if (agoIsPartOfDelay(data) || writtenData.find(data) != writtenData.end())
+		return false;
+	if (data->ref.type == VX_TYPE_IMAGE) {
+		AgoData * master = data->u.img.isROI ? data->u.img.roiMasterImage : data;
+		if (master && master->parent && master->parent->ref.type == VX_TYPE_IMAGE)
+			master = master->parent;
+		return (master && master->u.img.isUniform) ? true : false;
+	}
+	if (data->ref.read_only)
+		return true;
+	if (data->ref.type == VX_TYPE_SCALAR && !data->isVirtual && !data->ref.external_count)
+		return true;
+	return false;
+}
+
+static bool agoIsConstantNode(AgoNode * node, std::map<AgoData *, bool>& writtenData, std::map<AgoData *, bool>& foldedData)
+{
+	// only built-in CPU kernels without side effects
+	AgoKernel * kernel = node->akernel;
+	if (!kernel->func || kernel->external_kernel || (kernel->flags & AGO_KERNEL_FLAG_SUBGRAPH) || node->callback)
+		return false;
+	if (node->attr_affinity.device_type == AGO_KERNEL_FLAG_DEVICE_GPU)
+		return false;
+	node->target_support_flags = 0;
+	if (kernel->func(node, ago_kernel_cmd_query_target_support) || !(node->target_support_flags & AGO_KERNEL_FLAG_DEVICE_CPU))
+		return false;
+	// all inputs shall be constant and all outputs shall be stand-alone virtual objects
+	vx_uint32 inputCount = 0, outputCount = 0;
+	for (vx_uint32 arg = 0; arg < node->paramCount; arg++) {
+		AgoData * data = node->paramList[arg];
+		if (!data)
+			continue;
+		vx_uint32 argConfig = kernel->argConfig[arg] & (AGO_KERNEL_ARG_INPUT_FLAG | AGO_KERNEL_ARG_OUTPUT_FLAG);
+		if (argConfig == AGO_KERNEL_ARG_INPUT_FLAG) {
+			if (!agoIsConstantData(data, writtenData, foldedData))
+				return false;
+			inputCount++;
+		}
+		else if (argConfig == AGO_KERNEL_ARG_OUTPUT_FLAG) {
+			if (!data->isVirtual || data->parent || data->numChildren > 0 || agoIsPartOfDelay(data))
+				return false;
+			if (data->ref.type == VX_TYPE_IMAGE && (data->u.img.isROI || !data->roiDepList.empty()))
+				return false;
+			outputCount++;
+		}
+		else {
+			return false;
+		}
+	}
+	return (inputCount > 0 && outputCount > 0) ? true : false;
+}
+
+int agoOptimizeDramaFold(AgoGraph * agraph)
+{
+	// nodes get executed before alloc, so get their buffers ready and valid rectangles computed
+	for (AgoNode * node = agraph->nodeList.head; node; node = node->next) {
+		for (vx_uint32 arg = 0; arg < node->paramCount; arg++) {
+			AgoData * data = node->paramList[arg];
+			if (data && !data->buffer && agoDataSanityCheckAndUpdate(data)) {
+				return -1;
+			}
+		}
+	}
+	if (agoPrepareImageValidRectangleBuffers(agraph) || agoComputeImageValidRectangleOutputs(agraph)) {
+		return -1;
+	}
+
+	// get data objects written by nodes in the graph
+	std::map<AgoData *, bool> writtenData;
+	for (AgoNode * node = agraph->nodeList.head; node; node = node->next) {
+		for (vx_uint32 arg = 0; arg < node->paramCount; arg++) {
+			if (node->paramList[arg] && (node->akernel->argConfig[arg] & AGO_KERNEL_ARG_OUTPUT_FLAG)) {
+				writtenData[node->paramList[arg]] = true;
+			}
+		}
+	}
+
+	// execute nodes with constant inputs once, in hierarchical order, and remove them from graph
+	std::map<AgoData *, bool> foldedData;
+	for (AgoNode * node = agraph->nodeList.head; node;) {
+		AgoNode * next = node->next;
+		if (agoIsConstantNode(node, writtenData, foldedData)) {
+			for (vx_uint32 arg = 0; arg < node->paramCount; arg++) {
+				AgoData * data = node->paramList[arg];
+				if (data && agoAllocData(data)) {
+					vx_char name[256]; agoGetDataName(name, data);
+					agoAddLogEntry(&data->ref, VX_FAILURE, "ERROR: agoOptimizeDramaFold: data allocation failed for %s\n", name);
+					return -1;
+				}
+			}
+			vx_status status = agoInitializeNode(node);
+			if (!status) {
+				status = node->akernel->func(node, ago_kernel_cmd_execute);
+			}
+			if (status) {
+				agoAddLogEntry(&node->akernel->ref, status, "ERROR: agoOptimizeDramaFold: kernel %s failed (%d)\n", node->akernel->name, status);
+				return -1;
+			}
+			for (vx_uint32 arg = 0; arg < node->paramCount; arg++) {
+				AgoData * data = node->paramList[arg];
+				if (data && (node->akernel->argConfig[arg] & AGO_KERNEL_ARG_OUTPUT_FLAG)) {
+					foldedData[data] = true;
+					writtenData.erase(data);
+				}
+			}
+			if (agraph->enable_optimizer_log) {
+				agoOptimizerLogEntry(agraph, "fold", "constant", "%s", agoGetNodeLogName(node).c_str());
+			}
+			agoShutdownNode(node);
+			if (agoRemoveNode(&agraph->nodeList, node, true)) {
+				agoAddLogEntry(&agraph->ref, VX_FAILURE, "ERROR: agoOptimizeDramaFold: agoRemoveNode failed\n");
+				return -1;
+			}
+		}
+		node = next;
+	}
+	if (foldedData.empty())
+		return 0;
+
+	// pre-computed outputs still used by the graph become initialized non-virtual objects,
+	// so that their buffers are neither shared nor released; the others get removed as unused
+	agoOptimizeDramaMarkDataUsage(agraph);
+	for (auto it = foldedData.begin(); it != foldedData.end(); it++) {
+		AgoData * data = it->first;
+		if (data->inputUsageCount > 0) {
+			data->isVirtual = vx_false_e;
+			if (data->ref.type == VX_TYPE_IMAGE)
+				data->u.img.isVirtual = vx_false_e;
+			data->isInitialized = vx_true_e;
+#if ENABLE_OPENCL
+			data->buffer_sync_flags &= ~AGO_BUFFER_SYNC_FLAG_DIRTY_MASK;
+			data->buffer_sync_flags |= AGO_BUFFER_SYNC_FLAG_DIRTY_BY_COMMIT;
+#endif
+		}
+	}
+
+	return 1;
+}
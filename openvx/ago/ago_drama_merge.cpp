@@ -23,15 +23,194 @@ THE SOFTWARE.
 
 #include "ago_internal.h"
 
-int agoOptimizeDramaMerge(AgoGraph * agraph)
+static bool agoOptimizeDramaMergeIsFusibleNode(AgoGraph * agraph, AgoNode * anode)
 {
-	for (int graphGotModified = !0; graphGotModified;)
+	// only CPU element-wise nodes with one output image in argument#0 and without callback can be fused
+	// note: nodes that got fused already have been removed from the analysis
+	auto it = agraph->drama_analysis.node.find(anode);
+	if (it == agraph->drama_analysis.node.end())
+		return false;
+	AgoDramaNodeInfo& info = it->second;
+	AgoKernel * akernel = anode->akernel;
+	AgoData * odata = anode->paramList[0];
+	if (info.op_class != AGO_DRAMA_OP_CLASS_ELEMENT_WISE || !info.cpu_target || anode->callback || !akernel->func ||
+		akernel->argConfig[0] != AGO_KERNEL_ARG_OUTPUT_FLAG || !odata || odata->ref.type != VX_TYPE_IMAGE)
 	{
+		return false;
+	}
+	// all images need to be single plane images of same size and no data can be part of a delay
+	for (vx_uint32 arg = 0; arg < anode->paramCount; arg++) {
+		AgoData * adata = anode->paramList[arg];
+		if (arg > 0 && (akernel->argConfig[arg] & AGO_KERNEL_ARG_OUTPUT_FLAG))
+			return false;
+		if (adata) {
+			if (agoIsPartOfDelay(adata))
+				return false;
+			if (adata->ref.type == VX_TYPE_IMAGE && (adata->u.img.planes != 1 || adata->numChildren > 0 ||
+				adata->u.img.width != odata->u.img.width || adata->u.img.height != odata->u.img.height))
+			{
+				return false;
+			}
+		}
+	}
+	return true;
+}
+
+static bool agoOptimizeDramaMergeIsFusibleIntermediate(AgoGraph * agraph, AgoData * adata, AgoNode * consumer)
+{
+	// only virtual images without ROIs that are written once and read only by the consumer can be replaced with strip buffers
+	if (!adata || adata->ref.type != VX_TYPE_IMAGE || !adata->isVirtual || adata->parent || adata->u.img.isROI || !adata->roiDepList.empty() ||
+		adata->u.img.enableUserBufferOpenCL || adata->ownerOfUserBufferOpenCL || adata->outputUsageCount != 1 || adata->inoutUsageCount != 0)
+	{
+		return false;
+	}
+	auto it = agraph->drama_analysis.data.find(adata);
+	return (it != agraph->drama_analysis.data.end()) && it->second.def && (it->second.use.size() == 1) && (it->second.use[0] == consumer);
+}
+
+static void agoOptimizeDramaMergeAddInputs(std::vector<AgoData *>& inputList, AgoNode * anode, AgoData * idata)
+{
+	// add inputs of a node to external inputs of the fused node, except for the intermediate image
+	for (vx_uint32 arg = 1; arg < anode->paramCount; arg++) {
+		AgoData * adata = anode->paramList[arg];
+		if (adata && adata != idata && std::find(inputList.begin(), inputList.end(), adata) == inputList.end())
+			inputList.push_back(adata);
+	}
+}
+
+static int agoOptimizeDramaMergeElementwiseChain(AgoGraph * agraph, AgoKernel * akernel, AgoNode * cnode)
+{
+	// grow the tree of fusible producers of cnode through intermediate images read only by the tree:
+	// a producer is added after its consumer, so the reverse of groupList is a valid execution order
+	AgoDramaAnalysis& analysis = agraph->drama_analysis;
+	AgoData * odata = cnode->paramList[0];
+	std::vector<AgoNode *> groupList(1, cnode);
+	std::vector<AgoData *> inputList, intermediateList;
+	agoOptimizeDramaMergeAddInputs(inputList, cnode, nullptr);
+	for (size_t g = 0; g < groupList.size(); g++) {
+		AgoNode * gnode = groupList[g];
+		for (vx_uint32 arg = 1; arg < gnode->paramCount; arg++) {
+			// look for an intermediate image written by another fusible node
+			AgoData * idata = gnode->paramList[arg];
+			if (!agoOptimizeDramaMergeIsFusibleIntermediate(agraph, idata, gnode) ||
+				std::find(intermediateList.begin(), intermediateList.end(), idata) != intermediateList.end())
+			{
+				continue;
+			}
+			AgoNode * pnode = analysis.data[idata].def;
+			if (pnode == gnode || pnode->paramList[0] != idata || !agoOptimizeDramaMergeIsFusibleNode(agraph, pnode) ||
+				idata->u.img.width != odata->u.img.width || idata->u.img.height != odata->u.img.height)
+			{
+				continue;
+			}
+			// the fused node needs to have enough arguments for all external inputs
+			std::vector<AgoData *> newInputList;
+			for (AgoData * adata : inputList) {
+				if (adata != idata)
+					newInputList.push_back(adata);
+			}
+			agoOptimizeDramaMergeAddInputs(newInputList, pnode, idata);
+			if (1 + newInputList.size() > akernel->argCount)
+				continue;
+			inputList = newInputList;
+			intermediateList.push_back(idata);
+			groupList.push_back(pnode);
+		}
+	}
+	if (groupList.size() < 2)
+		return 0;
+
+	// create the fused node that computes the output of cnode
+	std::vector<AgoNode *> fusedNodeList;
+	for (auto it = groupList.rbegin(); it != groupList.rend(); it++) {
+		AgoNode * anode = *it;
+		if (anode->fusedNodeList.size() > 0)
+			fusedNodeList.insert(fusedNodeList.end(), anode->fusedNodeList.begin(), anode->fusedNodeList.end());
+		else
+			fusedNodeList.push_back(anode);
+	}
+	AgoNode * fnode = agoCreateNode(agraph, akernel);
+	fnode->paramList[0] = odata;
+	for (size_t i = 0; i < inputList.size(); i++)
+		fnode->paramList[1 + i] = inputList[i];
+	fnode->fusedNodeList = fusedNodeList;
+	fnode->attr_affinity.device_type = AGO_KERNEL_FLAG_DEVICE_CPU;
+	fnode->attr_affinity.device_info = 0;
+	fnode->attr_affinity.group = 0;
+	debug_printf("INFO: agoOptimizeDramaMergeElementwiseNodes: fused %d nodes into %s\n", (int)fusedNodeList.size(), cnode->akernel->name);
+	if (agraph->enable_optimizer_log) {
+		agoOptimizerLogEntry(agraph, "merge", "fuse", "%s with %d producers (%d nodes)", agoGetNodeLogName(cnode).c_str(), (int)groupList.size() - 1, (int)fusedNodeList.size());
+	}
+
+	// update the analysis for the fused node and remove the nodes that got fused:
+	// the original nodes are kept in trash for the fused node
+	AgoDramaNodeInfo& info = analysis.node[fnode];
+	info.op_class = AGO_DRAMA_OP_CLASS_ELEMENT_WISE;
+	info.neighbors = 0;
+	info.cpu_target = true;
+	analysis.data[odata].def = fnode;
+	for (AgoData * idata : intermediateList) {
+		analysis.data.erase(idata);
+	}
+	for (AgoData * adata : inputList) {
+		std::vector<AgoNode *>& use = analysis.data[adata].use;
+		for (AgoNode * anode : groupList)
+			use.erase(std::remove(use.begin(), use.end(), anode), use.end());
+		use.push_back(fnode);
+	}
+	for (AgoNode * anode : groupList) {
+		analysis.node.erase(anode);
+		if (agoRemoveNode(&agraph->nodeList, anode, true)) {
+			agoAddLogEntry(&anode->ref, VX_FAILURE, "ERROR: agoOptimizeDramaMergeElementwiseNodes: agoRemoveNode(*,%s) failed\n", anode->akernel->name);
+			return -1;
+		}
+	}
+	// verify the node
+	if (agoVerifyNode(fnode)) {
+		return -1;
+	}
+	return 1;
+}
+
+static int agoOptimizeDramaMergeElementwiseNodes(AgoGraph * agraph)
+{
+	AgoKernel * akernel = agoFindKernelByEnum(agraph->ref.context, VX_KERNEL_AMD_FUSED_ELEMWISE_ANY_ANY);
+	if (!akernel) {
+		agoAddLogEntry(&agraph->ref, VX_FAILURE, "ERROR: agoOptimizeDramaMergeElementwiseNodes: agoFindKernelByEnum(VX_KERNEL_AMD_FUSED_ELEMWISE_ANY_ANY) failed\n");
+		return -1;
+	}
+	// fuse the whole chain of each consumer in one step: nodes are in execution order, so visiting them
+	// in reverse picks last consumers first, and nodes that got fused into a chain are skipped
+	std::vector<AgoNode *> nodeList;
+	for (AgoNode * anode = agraph->nodeList.head; anode; anode = anode->next)
+		nodeList.push_back(anode);
+	int graphGotModified = 0;
+	for (auto it = nodeList.rbegin(); it != nodeList.rend(); it++) {
+		AgoNode * cnode = *it;
+		if (!agoOptimizeDramaMergeIsFusibleNode(agraph, cnode))
+			continue;
+		int status = agoOptimizeDramaMergeElementwiseChain(agraph, akernel, cnode);
+		if (status < 0)
+			return -1;
+		graphGotModified |= status;
+	}
+	return graphGotModified;
+}
+
+int agoOptimizeDramaMerge(AgoGraph * agraph)
+{
+	if (!(agraph->optimizer_flags & AGO_GRAPH_OPTIMIZER_FLAG_NO_ELEMWISE_FUSION)) {
 		// check and mark data usage
 		agoOptimizeDramaMarkDataUsage(agraph);
-
-		// TBD
-		graphGotModified = 0;
+		// get def/use chains and op classes of the current graph
+		if (agoOptimizeDramaAnalyze(agraph))
+			return -1;
+		// fuse element-wise CPU nodes that communicate through virtual images
+		int graphGotModified = agoOptimizeDramaMergeElementwiseNodes(agraph);
+		if (graphGotModified < 0)
+			return -1;
+		else if (graphGotModified)
+			agoOptimizeDramaMarkDataUsage(agraph);
 	}
 	return 0;
 }
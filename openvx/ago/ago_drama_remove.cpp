@@ -948,6 +948,9 @@ int agoOptimizeDramaRemoveCopyNodes(AgoGraph * agraph)
 					replaceDst = false;
 				}
 			}
+			if ((replaceDst || replaceSrc) && agraph->enable_optimizer_log) {
+				agoOptimizerLogEntry(agraph, "remove", "copy", "%s", agoGetNodeLogName(anode).c_str());
+			}
 			if (replaceDst) {
 #if ENABLE_DEBUG_MESSAGES
 				vx_char srcName[256], dstName[256];
@@ -1012,6 +1015,9 @@ int agoOptimizeDramaRemoveNodesWithUnusedOutputs(AgoGraph * agraph)
 		}
 		if (nodeCanBeRemoved) {
 			debug_printf("INFO: agoOptimizeDramaRemoveNodesWithUnusedOutputs: removing node %s\n", anode->akernel->name);
+			if (agraph->enable_optimizer_log) {
+				agoOptimizerLogEntry(agraph, "remove", "unused", "%s", agoGetNodeLogName(anode).c_str());
+			}
 			// remove the node
 			if (agoRemoveNode(&agraph->nodeList, anode, true)) {
 				agoAddLogEntry(&anode->akernel->ref, -1, "ERROR: agoOptimizeDramaRemoveNodesWithUnusedOutputs: agoRemoveNode(*,%s) failed\n", anode->akernel->name);
@@ -1025,9 +1031,295 @@ int agoOptimizeDramaRemoveNodesWithUnusedOutputs(AgoGraph * agraph)
 	return 0;
 }
 
-int agoOptimizeDramaRemoveNodeMerge(AgoGraph * agraph)
+static bool agoIsDuplicateNodeCandidate(AgoNode * anode)
+{
+	// only built-in kernels without side effects and with at least one output
+	AgoKernel * akernel = anode->akernel;
+	if (!akernel->func || akernel->external_kernel || (akernel->flags & AGO_KERNEL_FLAG_SUBGRAPH) || anode->callback)
+		return false;
+	bool hasOutput = false;
+	for (vx_uint32 arg = 0; arg < anode->paramCount; arg++) {
+		if (anode->paramList[arg]) {
+			if ((akernel->argConfig[arg] & (AGO_KERNEL_ARG_INPUT_FLAG | AGO_KERNEL_ARG_OUTPUT_FLAG)) == (AGO_KERNEL_ARG_INPUT_FLAG | AGO_KERNEL_ARG_OUTPUT_FLAG))
+				return false;
+			if (akernel->argConfig[arg] & AGO_KERNEL_ARG_OUTPUT_FLAG) {
+				if (agoIsPartOfDelay(anode->paramList[arg]))
+					return false;
+				hasOutput = true;
+			}
+		}
+	}
+	return hasOutput;
+}
+
+static bool agoIsDuplicateNodeRemovable(AgoNode * anode)
+{
+	// all outputs need to be stand-alone virtual images, so that they can be replaced
+	for (vx_uint32 arg = 0; arg < anode->paramCount; arg++) {
+		AgoData * data = anode->paramList[arg];
+		if (data && (anode->akernel->argConfig[arg] & AGO_KERNEL_ARG_OUTPUT_FLAG)) {
+			if (!data->isVirtual || data->ref.type != VX_TYPE_IMAGE || data->parent || data->numChildren > 0 ||
+				data->u.img.isROI || !data->roiDepList.empty())
+				return false;
+		}
+	}
+	return true;
+}
+
+static void agoGetDuplicateNodeSignature(AgoNode * anode, std::map<AgoData *, bool>& writtenData, std::vector<vx_uint64>& signature)
 {
-	// apply node merge rules
+	// signature: kernel, node attributes, and inputs -- scalar inputs that can't be changed by
+	// the application or by the graph are represented by their values instead of the object
+	signature.clear();
+	signature.push_back((vx_uint64)anode->akernel->id);
+	signature.push_back((vx_uint64)anode->attr_border_mode.mode);
+	signature.push_back((vx_uint64)(anode->attr_border_mode.mode == VX_BORDER_MODE_CONSTANT ? anode->attr_border_mode.constant_value.U32 : 0));
+	signature.push_back((vx_uint64)anode->valid_rect_reset);
+	signature.push_back((vx_uint64)anode->attr_affinity.device_type);
+	signature.push_back((vx_uint64)anode->attr_affinity.device_info);
+	signature.push_back((vx_uint64)anode->paramCount);
+	for (vx_uint32 arg = 0; arg < anode->paramCount; arg++) {
+		AgoData * data = anode->paramList[arg];
+		if (!data || (anode->akernel->argConfig[arg] & AGO_KERNEL_ARG_OUTPUT_FLAG)) {
+			signature.push_back(data ? 1 : 0);
+		}
+		else if (data->ref.type == VX_TYPE_SCALAR && !data->ref.external_count && !agoIsPartOfDelay(data) && writtenData.find(data) == writtenData.end()) {
+			// merged nodes share the scalar, so its value can't be rebound later
+			data->isValueUsedByOptimizer = vx_true_e;
+			signature.push_back(2);
+			signature.push_back((vx_uint64)data->u.scalar.type);
+			signature.push_back(data->u.scalar.u.u64);
+		}
+		else {
+			signature.push_back(3);
+			signature.push_back((vx_uint64)(size_t)data);
+		}
+	}
+}
+
+static bool agoAreDuplicateNodeOutputsCompatible(AgoNode * anode, AgoNode * bnode)
+{
+	for (vx_uint32 arg = 0; arg < anode->paramCount; arg++) {
+		if (anode->akernel->argConfig[arg] & AGO_KERNEL_ARG_OUTPUT_FLAG) {
+			AgoData * adata = anode->paramList[arg];
+			AgoData * bdata = bnode->paramList[arg];
+			if (adata && bdata) {
+				if (adata == bdata || adata->ref.type != bdata->ref.type)
+					return false;
+				if (adata->ref.type == VX_TYPE_IMAGE && (adata->u.img.format != bdata->u.img.format ||
+					adata->u.img.width != bdata->u.img.width || adata->u.img.height != bdata->u.img.height))
+					return false;
+			}
+		}
+	}
+	return true;
+}
+
+int agoOptimizeDramaRemoveDuplicateNodes(AgoGraph * agraph)
+{
+	// get data objects written by nodes in the graph
+	std::map<AgoData *, bool> writtenData;
+	for (AgoNode * anode = agraph->nodeList.head; anode; anode = anode->next) {
+		for (vx_uint32 arg = 0; arg < anode->paramCount; arg++) {
+			if (anode->paramList[arg] && (anode->akernel->argConfig[arg] & AGO_KERNEL_ARG_OUTPUT_FLAG)) {
+				writtenData[anode->paramList[arg]] = true;
+			}
+		}
+	}
+	// find nodes with same signature and remove the duplicates by replacing
+	// their outputs with the outputs of the node that is kept
+	int graphGotModified = 0;
+	std::map<std::vector<vx_uint64>, AgoNode *> nodeOfSignature;
+	std::vector<vx_uint64> signature;
+	for (AgoNode * anode = agraph->nodeList.head; anode;) {
+		AgoNode * anodeNext = anode->next;
+		if (agoIsDuplicateNodeCandidate(anode)) {
+			agoGetDuplicateNodeSignature(anode, writtenData, signature);
+			auto it = nodeOfSignature.find(signature);
+			if (it == nodeOfSignature.end()) {
+				nodeOfSignature[signature] = anode;
+			}
+			else if (agoAreDuplicateNodeOutputsCompatible(it->second, anode)) {
+				// remove the later node, unless only the earlier node has replaceable outputs
+				AgoNode * keepNode = it->second;
+				AgoNode * dropNode = anode;
+				if (!agoIsDuplicateNodeRemovable(dropNode) && agoIsDuplicateNodeRemovable(keepNode)) {
+					keepNode = anode;
+					dropNode = it->second;
+					it->second = keepNode;
+				}
+				if (agoIsDuplicateNodeRemovable(dropNode)) {
+					debug_printf("INFO: agoOptimizeDramaRemoveDuplicateNodes: removing node %s\n", dropNode->akernel->name);
+					if (agraph->enable_optimizer_log) {
+						agoOptimizerLogEntry(agraph, "remove", "duplicate", "%s same as %s", agoGetNodeLogName(dropNode).c_str(), agoGetNodeLogName(keepNode).c_str());
+					}
+					for (vx_uint32 arg = 0; arg < dropNode->paramCount; arg++) {
+						AgoData * data = dropNode->paramList[arg];
+						if (data && (dropNode->akernel->argConfig[arg] & AGO_KERNEL_ARG_OUTPUT_FLAG) && keepNode->paramList[arg]) {
+							// replace all occurances of the output with the output of the node that is kept
+							agoReplaceDataInGraph(agraph, data, keepNode->paramList[arg]);
+						}
+					}
+					if (agoRemoveNode(&agraph->nodeList, dropNode, true)) {
+						agoAddLogEntry(&dropNode->akernel->ref, VX_FAILURE, "ERROR: agoOptimizeDramaRemoveDuplicateNodes: agoRemoveNode(*,%s) failed\n", dropNode->akernel->name);
+						return -1;
+					}
+					graphGotModified = 1;
+				}
+			}
+		}
+		anode = anodeNext;
+	}
+	return graphGotModified;
+}
+
+// index of graph nodes used by node merge: nodes are listed in node list order.
+// The index is kept up-to-date across node merges and rebuilt after other changes to the graph.
+// Nodes removed by node merge are dropped from nodesOfKernel and from the graph at the end of a pass.
+struct AgoNodeMergeIndex {
+	bool valid;
+	std::map<vx_enum, std::vector<AgoNode *>> nodesOfKernel; // nodes that use a kernel
+	std::map<AgoData *, std::vector<AgoNode *>> nodesOfData; // nodes that have data as an argument
+	std::map<AgoNode *, bool> removedNodes;                   // nodes removed in the current pass
+	AgoNodeMergeIndex() : valid(false) { }
+};
+
+static void agoAddNodeToMergeIndex(AgoNodeMergeIndex& index, AgoNode * anode)
+{
+	index.nodesOfKernel[anode->akernel->id].push_back(anode);
+	for (vx_uint32 arg = 0; arg < anode->paramCount; arg++) {
+		AgoData * data = anode->paramList[arg];
+		if (data) {
+			std::vector<AgoNode *>& nodes = index.nodesOfData[data];
+			if (nodes.empty() || nodes.back() != anode)
+				nodes.push_back(anode);
+		}
+	}
+}
+
+static void agoRemoveNodeFromMergeIndex(AgoNodeMergeIndex& index, AgoNode * anode)
+{
+	index.removedNodes[anode] = true;
+	for (vx_uint32 arg = 0; arg < anode->paramCount; arg++) {
+		auto itData = anode->paramList[arg] ? index.nodesOfData.find(anode->paramList[arg]) : index.nodesOfData.end();
+		if (itData != index.nodesOfData.end()) {
+			itData->second.erase(std::remove(itData->second.begin(), itData->second.end(), anode), itData->second.end());
+			if (itData->second.empty())
+				index.nodesOfData.erase(itData);
+		}
+	}
+}
+
+static int agoRemoveNodesOfMergeIndex(AgoGraph * agraph, AgoNodeMergeIndex& index)
+{
+	// drop removed nodes from nodesOfKernel and from the graph with one pass over each
+	if (index.removedNodes.empty())
+		return 0;
+	for (auto it = index.nodesOfKernel.begin(); it != index.nodesOfKernel.end();) {
+		std::vector<AgoNode *>& nodes = it->second;
+		nodes.erase(std::remove_if(nodes.begin(), nodes.end(), [&index](AgoNode * anode) { return index.removedNodes.find(anode) != index.removedNodes.end(); }), nodes.end());
+		if (nodes.empty())
+			it = index.nodesOfKernel.erase(it);
+		else
+			it++;
+	}
+	int status = agoRemoveNodes(&agraph->nodeList, index.removedNodes, true);
+	if (status) {
+		agoAddLogEntry(&agraph->ref, VX_FAILURE, "ERROR: agoOptimizeDramaRemoveNodeMerge: agoRemoveNodes(*,%d) failed\n", (int)index.removedNodes.size());
+	}
+	index.removedNodes.clear();
+	return status;
+}
+
+static void agoBuildNodeMergeIndex(AgoGraph * agraph, AgoNodeMergeIndex& index)
+{
+	index.nodesOfKernel.clear();
+	index.nodesOfData.clear();
+	index.removedNodes.clear();
+	for (AgoNode * anode = agraph->nodeList.head; anode; anode = anode->next) {
+		agoAddNodeToMergeIndex(index, anode);
+	}
+	index.valid = true;
+}
+
+static std::vector<AgoNode *> * agoGetNodeMergeCandidates(AgoNodeMergeIndex& index, AgoNodeMergeRule * rule, vx_int32 iNode, AgoData * mdata[])
+{
+	// when rule's find[iNode] shares data with earlier nodes in the rule, only the nodes
+	// that use that data can match: pick the shortest such list of nodes
+	std::vector<AgoNode *> * candidates = nullptr;
+	bool sharesData = false;
+	for (vx_uint32 arg = 0; arg < AGO_MAX_PARAMS; arg++) {
+		vx_uint32 arg_spec = rule->find[iNode].arg_spec[arg];
+		if (arg_spec && mdata[ARG_INDEX(arg_spec)]) {
+			AgoData * data = mdata[ARG_INDEX(arg_spec)];
+			if (ARG_HAS_CHILD(arg_spec)) {
+				vx_uint32 arg_child = ARG_GET_CHILD(arg_spec);
+				data = (arg_child < data->numChildren) ? data->children[arg_child] : nullptr;
+			}
+			auto it = data ? index.nodesOfData.find(data) : index.nodesOfData.end();
+			if (it == index.nodesOfData.end()) {
+				// no node can match
+				return nullptr;
+			}
+			if (!sharesData || it->second.size() < candidates->size()) {
+				candidates = &it->second;
+			}
+			sharesData = true;
+		}
+	}
+	if (!sharesData) {
+		// otherwise, all nodes with matching kernel are candidates
+		auto it = index.nodesOfKernel.find(rule->find[iNode].kernel_id);
+		if (it != index.nodesOfKernel.end()) {
+			candidates = &it->second;
+		}
+	}
+	return (candidates && !candidates->empty()) ? candidates : nullptr;
+}
+
+static bool agoUpdateNodeMergeDataUsage(AgoNode * anode, bool added)
+{
+	// update usage counts of data used by a node that got added or removed by node merge: returns false
+	// when counts of other data depend on it (children, parent, or ROIs), so data usage needs to be marked again
+	bool updated = true;
+	AgoKernel * akernel = anode->akernel;
+	for (vx_uint32 arg = 0; arg < anode->paramCount; arg++) {
+		AgoData * adata = anode->paramList[arg];
+		if (!adata)
+			continue;
+		if (adata->parent || adata->numChildren > 0 || (adata->ref.type == VX_TYPE_IMAGE && (adata->u.img.isROI || !adata->roiDepList.empty()))) {
+			updated = false;
+			continue;
+		}
+		vx_uint32 * usageCount = nullptr;
+		if ((akernel->argConfig[arg] & (AGO_KERNEL_ARG_INPUT_FLAG | AGO_KERNEL_ARG_OUTPUT_FLAG)) == (AGO_KERNEL_ARG_INPUT_FLAG | AGO_KERNEL_ARG_OUTPUT_FLAG))
+			usageCount = &adata->inoutUsageCount;
+		else if (akernel->argConfig[arg] & AGO_KERNEL_ARG_OUTPUT_FLAG)
+			usageCount = &adata->outputUsageCount;
+		else if (akernel->argConfig[arg] & AGO_KERNEL_ARG_INPUT_FLAG)
+			usageCount = &adata->inputUsageCount;
+		if (usageCount) {
+			if (added)
+				(*usageCount)++;
+			else if (*usageCount > 0)
+				(*usageCount)--;
+		}
+	}
+	return updated;
+}
+
+int agoOptimizeDramaRemoveNodeMerge(AgoGraph * agraph, AgoNodeMergeIndex& index)
+{
+	// index the graph nodes by kernel and by data so that rules are only matched
+	// against nodes that use the kernel in rule's first find[] and their neighbors
+	if (!index.valid) {
+		agoBuildNodeMergeIndex(agraph, index);
+	}
+
+	// apply node merge rules: all matches are applied in one pass and data usage is updated
+	// for the nodes that got added and removed, unless it has to be marked again for the whole graph
+	int graphGotModified = 0;
+	bool dataUsageUpdated = true;
 	int ruleSet = 0;
 	vx_uint32 rule_count = s_merge_rule_count;
 	for (vx_uint32 iRule = 0; iRule <= rule_count; iRule++) {
@@ -1052,224 +1344,270 @@ int agoOptimizeDramaRemoveNodeMerge(AgoGraph * agraph)
 			numMatchNodes++;
 		}
 		AgoData * mdata[AGO_MAX_PARAMS] = { 0 };
-		AgoNode * stack[AGO_MERGE_RULE_MAX_FIND] { agraph->nodeList.head };
-		vx_int32 stackTop = 0;
-		for (;;) {
-			bool foundMatch = false;
-			if (stack[stackTop]->akernel->id == rule->find[stackTop].kernel_id) {
-				foundMatch = true;
-				memset(mdata, 0, sizeof(mdata));
-				for (vx_int32 iNode = 0; iNode <= stackTop; iNode++) {
-					for (vx_uint32 arg = 0; arg < AGO_MAX_PARAMS; arg++) {
-						// get argument specificaiton from the rule of current node
-						vx_uint32 arg_spec = rule->find[iNode].arg_spec[arg];
-						if (arg_spec) {
-							if (!(arg < stack[iNode]->paramCount && stack[iNode]->paramList[arg])) {
-								// node doesn't have required argument
+		std::vector<AgoNode *> * firstCandidates = agoGetNodeMergeCandidates(index, rule, 0, mdata);
+		if (!firstCandidates) {
+			// kernel in rule's first find[] is not used in the graph
+			continue;
+		}
+		// search for a match from each node of rule's first find[]: the list is copied, since
+		// matches change the index, and nodes removed by earlier matches are skipped
+		std::vector<AgoNode *> firstCandidateList = *firstCandidates;
+		for (AgoNode * firstNode : firstCandidateList) {
+			if (index.removedNodes.find(firstNode) != index.removedNodes.end())
+				continue;
+			std::vector<AgoNode *> firstList(1, firstNode);
+			AgoNode * stack[AGO_MERGE_RULE_MAX_FIND] = { 0 };
+			std::vector<AgoNode *> * candidates[AGO_MERGE_RULE_MAX_FIND] = { 0 };
+			size_t candidateIndex[AGO_MERGE_RULE_MAX_FIND] = { 0 };
+			vx_int32 stackTop = 0;
+			candidates[0] = &firstList;
+			stack[0] = firstNode;
+			for (;;) {
+				bool foundMatch = false;
+				if (stack[stackTop]->akernel->id == rule->find[stackTop].kernel_id && index.removedNodes.find(stack[stackTop]) == index.removedNodes.end()) {
+					foundMatch = true;
+					memset(mdata, 0, sizeof(mdata));
+					for (vx_int32 iNode = 0; iNode <= stackTop; iNode++) {
+						for (vx_uint32 arg = 0; arg < AGO_MAX_PARAMS; arg++) {
+							// get argument specificaiton from the rule of current node
+							vx_uint32 arg_spec = rule->find[iNode].arg_spec[arg];
+							if (arg_spec) {
+								if (!(arg < stack[iNode]->paramCount && stack[iNode]->paramList[arg])) {
+									// node doesn't have required argument
+									foundMatch = false;
+									break;
+								}
+							}
+							else {
+								if (arg < stack[iNode]->paramCount && stack[iNode]->paramList[arg]) {
+									// node has argument that is missing in the rule
+									foundMatch = false;
+									break;
+								}
+								// this matches the rule
+								continue;
+							}
+							AgoData * data = stack[iNode]->paramList[arg];
+
+							// get argument info and sanity checks
+							vx_int32 arg_index = ARG_INDEX(arg_spec);
+							vx_int32 arg_child = ARG_HAS_CHILD(arg_spec) ? ARG_GET_CHILD(arg_spec) : -1;
+							if (arg_child >= 0) {
+								if (!data->parent || !(arg_child < (vx_int32)data->parent->numChildren) || !(data->parent->children[arg_child] == data)) {
+									// node doesn't have required argument as a child
+									foundMatch = false;
+									break;
+								}
+								data = data->parent;
+							}
+							if (!mdata[arg_index]) {
+								// save the data object for comparison with other parameter comparision
+								mdata[arg_index] = data;
+							}
+							if (mdata[arg_index] != data) {
+								// data doesn't match with previously saved parameter as dectated by the rule
 								foundMatch = false;
 								break;
 							}
-						}
-						else {
-							if (arg < stack[iNode]->paramCount && stack[iNode]->paramList[arg]) {
-								// node has argument that is missing in the rule
+							if ((ARG_IS_SOLITARY(arg_spec) || ARG_IS_WRITEONLY(arg_spec)) && !data->isVirtual) {
+								// data virtual properties doesn't match with the rule requirements
 								foundMatch = false;
 								break;
 							}
-							// this matches the rule
-							continue;
-						}
-						AgoData * data = stack[iNode]->paramList[arg];
-
-						// get argument info and sanity checks
-						vx_int32 arg_index = ARG_INDEX(arg_spec);
-						vx_int32 arg_child = ARG_HAS_CHILD(arg_spec) ? ARG_GET_CHILD(arg_spec) : -1;
-						if (arg_child >= 0) {
-							if (!data->parent || !(arg_child < (vx_int32)data->parent->numChildren) || !(data->parent->children[arg_child] == data)) {
-								// node doesn't have required argument as a child
+							if (ARG_IS_WRITEONLY(arg_spec) && data->inputUsageCount > 0) {
+								// data write-only properties doesn't match with the rule requirements
 								foundMatch = false;
 								break;
 							}
-							data = data->parent;
-						}
-						if (!mdata[arg_index]) {
-							// save the data object for comparison with other parameter comparision
-							mdata[arg_index] = data;
-						}
-						if (mdata[arg_index] != data) {
-							// data doesn't match with previously saved parameter as dectated by the rule
-							foundMatch = false;
-							break;
-						}
-						if ((ARG_IS_SOLITARY(arg_spec) || ARG_IS_WRITEONLY(arg_spec)) && !data->isVirtual) {
-							// data virtual properties doesn't match with the rule requirements
-							foundMatch = false;
-							break;
-						}
-						if (ARG_IS_WRITEONLY(arg_spec) && data->inputUsageCount > 0) {
-							// data write-only properties doesn't match with the rule requirements
-							foundMatch = false;
-							break;
 						}
 					}
 				}
-			}
-			// check if a match is found, proceed to next step in the search
-			if (foundMatch) {
-				if ((stackTop + 1) == numMatchNodes) {
-					// check for virtual node removal criteria
-					for (vx_int32 arg_index = 0; arg_index < AGO_MAX_PARAMS; arg_index++) {
-						if (mdata[arg_index]) {
-							// check if data in find rule spec is missing in the replace rule spec, or
-							// solitary check is requested
-							bool data_missing_in_replace = true;
-							bool solitary_requested = false;
-							for (vx_uint32 iNode = 0; iNode < AGO_MERGE_RULE_MAX_REPLACE && rule->replace[iNode].kernel_id; iNode++) {
-								for (vx_uint32 arg = 0; arg < AGO_MAX_PARAMS; arg++) {
-									vx_int32 arg_spec = rule->replace[iNode].arg_spec[arg];
-									if (arg_spec) {
-										if (arg_index == ARG_INDEX(arg_spec)) {
-											data_missing_in_replace = false;
-											if (ARG_IS_SOLITARY(arg_spec)) {
-												solitary_requested = true;
+				// check if a match is found, proceed to next step in the search
+				if (foundMatch) {
+					if ((stackTop + 1) == numMatchNodes) {
+						// check for virtual node removal criteria
+						for (vx_int32 arg_index = 0; arg_index < AGO_MAX_PARAMS; arg_index++) {
+							if (mdata[arg_index]) {
+								// check if data in find rule spec is missing in the replace rule spec, or
+								// solitary check is requested
+								bool data_missing_in_replace = true;
+								bool solitary_requested = false;
+								for (vx_uint32 iNode = 0; iNode < AGO_MERGE_RULE_MAX_REPLACE && rule->replace[iNode].kernel_id; iNode++) {
+									for (vx_uint32 arg = 0; arg < AGO_MAX_PARAMS; arg++) {
+										vx_int32 arg_spec = rule->replace[iNode].arg_spec[arg];
+										if (arg_spec) {
+											if (arg_index == ARG_INDEX(arg_spec)) {
+												data_missing_in_replace = false;
+												if (ARG_IS_SOLITARY(arg_spec)) {
+													solitary_requested = true;
+												}
 											}
 										}
 									}
 								}
-							}
-							if (data_missing_in_replace || solitary_requested) {
-								// make sure that the data is virtual and no other nodes except nodes in the stack[] use this data
-								if (!mdata[arg_index]->isVirtual)
-									foundMatch = false;
-								else {
-									for (AgoNode * anode = agraph->nodeList.head; anode; anode = anode->next) {
-										bool node_on_stack = false;
-										for (vx_int32 i = 0; i <= stackTop; i++) {
-											if (stack[i] == anode) {
-												node_on_stack = true;
-												break;
-											}
-										}
-										if (!node_on_stack) {
-											// check if data used by the node
-											bool data_used_outside_rule = false;
-											for (vx_uint32 i = 0; i < anode->paramCount; i++) {
-												if (anode->paramList[i] == mdata[arg_index]) {
-													data_used_outside_rule = true;
+								if (data_missing_in_replace || solitary_requested) {
+									// make sure that the data is virtual and no other nodes except nodes in the stack[] use this data
+									if (!mdata[arg_index]->isVirtual)
+										foundMatch = false;
+									else {
+										std::vector<AgoNode *>& nodes = index.nodesOfData[mdata[arg_index]];
+										for (auto it = nodes.begin(); it != nodes.end(); it++) {
+											AgoNode * anode = *it;
+											bool node_on_stack = false;
+											for (vx_int32 i = 0; i <= stackTop; i++) {
+												if (stack[i] == anode) {
+													node_on_stack = true;
 													break;
 												}
 											}
-											if (data_used_outside_rule) {
-												// the data can't be discarded by this rule
-												foundMatch = false;
-												break;
+											if (!node_on_stack) {
+												// check if data used by the node
+												bool data_used_outside_rule = false;
+												for (vx_uint32 i = 0; i < anode->paramCount; i++) {
+													if (anode->paramList[i] == mdata[arg_index]) {
+														data_used_outside_rule = true;
+														break;
+													}
+												}
+												if (data_used_outside_rule) {
+													// the data can't be discarded by this rule
+													foundMatch = false;
+													break;
+												}
 											}
 										}
 									}
 								}
 							}
 						}
+						if (foundMatch) {
+							// found a match to the complete rule
+							stackTop++;
+							break;
+						}
 					}
 					if (foundMatch) {
-						// found a match to the complete rule
+						// skip to next-node in the rule and start searching its candidates
 						stackTop++;
-						break;
+						candidates[stackTop] = agoGetNodeMergeCandidates(index, rule, stackTop, mdata);
+						candidateIndex[stackTop] = 0;
+						stack[stackTop] = candidates[stackTop] ? (*candidates[stackTop])[0] : nullptr;
+						foundMatch = stack[stackTop] ? true : false;
 					}
 				}
-				if (foundMatch) {
-					// skip to next-node in the rule and start searching
-					stack[++stackTop] = agraph->nodeList.head;
-				}
-			}
-			if(!foundMatch) {
-				// skip to next node, since no match has been found at stackTop-node in the rule
-				stack[stackTop] = stack[stackTop]->next;
-				// when end-of-node-list is reached, go back one node in the rule and try next node
-				while (!stack[stackTop]) {
-					stackTop--;
+				if(!foundMatch) {
+					// skip to next candidate, since no match has been found at stackTop-node in the rule
+					if (stack[stackTop]) {
+						stack[stackTop] = (++candidateIndex[stackTop] < candidates[stackTop]->size()) ? (*candidates[stackTop])[candidateIndex[stackTop]] : nullptr;
+					}
+					// when end-of-candidates is reached, go back one node in the rule and try next candidate
+					while (!stack[stackTop]) {
+						stackTop--;
+						if (stackTop < 0) {
+							break;
+						}
+						stack[stackTop] = (++candidateIndex[stackTop] < candidates[stackTop]->size()) ? (*candidates[stackTop])[candidateIndex[stackTop]] : nullptr;
+					}
 					if (stackTop < 0) {
+						// reached end of search and no matched were found
 						break;
 					}
-					stack[stackTop] = stack[stackTop]->next;
-				}
-				if (stackTop < 0) {
-					// reached end of search and no matched were found
-					break;
 				}
 			}
-		}
 
-		if (stackTop == numMatchNodes) {
-			// get affinity, border_mode, and callback attributes
-			AgoTargetAffinityInfo_ attr_affinity = { 0 };
-			vx_border_mode_t attr_border_mode = { 0 };
-			vx_nodecomplete_f callback = NULL;
-			for (vx_int32 iNode = 0; iNode < stackTop; iNode++) {
-				if (stack[iNode]->callback) {
-					callback = stack[iNode]->callback;
-				}
-				if (stack[iNode]->attr_affinity.device_type) {
-					attr_affinity.device_type = stack[iNode]->attr_affinity.device_type;
+			if (stackTop == numMatchNodes) {
+				// get affinity, border_mode, and callback attributes
+				AgoTargetAffinityInfo_ attr_affinity = { 0 };
+				vx_border_mode_t attr_border_mode = { 0 };
+				vx_nodecomplete_f callback = NULL;
+				for (vx_int32 iNode = 0; iNode < stackTop; iNode++) {
+					if (stack[iNode]->callback) {
+						callback = stack[iNode]->callback;
+					}
+					if (stack[iNode]->attr_affinity.device_type) {
+						attr_affinity.device_type = stack[iNode]->attr_affinity.device_type;
+					}
+					if (stack[iNode]->attr_border_mode.mode) {
+						// TBD: check whether to progate border mode
+						// attr_border_mode = stack[iNode]->attr_border_mode;
+					}
 				}
-				if (stack[iNode]->attr_border_mode.mode) {
-					// TBD: check whether to progate border mode
-					// attr_border_mode = stack[iNode]->attr_border_mode;
+				std::string replaced;
+				if (agraph->enable_optimizer_log) {
+					for (vx_int32 iNode = 0; iNode < stackTop; iNode++) {
+						replaced += (iNode > 0) ? " " : "";
+						replaced += agoGetNodeLogName(stack[iNode]);
+					}
 				}
-			}
-			// add new nodes per rule's replace[] specification
-			for (vx_uint32 iNode = 0; iNode < AGO_MERGE_RULE_MAX_REPLACE && rule->replace[iNode].kernel_id; iNode++) {
-				// create a new AgoNode and add it to the nodeList
-				AgoNode * childnode = agoCreateNode(agraph, rule->replace[iNode].kernel_id);
-				for (vx_uint32 arg = 0; arg < AGO_MAX_PARAMS; arg++) {
-					vx_int32 arg_spec = rule->replace[iNode].arg_spec[arg];
-					if (arg_spec) {
-						vx_int32 arg_index = ARG_INDEX(arg_spec);
-						vx_int32 arg_child = ARG_HAS_CHILD(arg_spec) ? ARG_GET_CHILD(arg_spec) : -1;
-						AgoData * data = mdata[arg_index];
-						if (arg_child >= 0) {
-							if (!(arg_child < (vx_int32)data->numChildren) || !data->children[arg_child]) {
-								// TBD: error handling
-								agoAddLogEntry(&data->ref, VX_FAILURE, "ERROR: agoOptimizeDramaRemoveNodeMerge: invalid child(%d) in arg:%d of replace-node:%d of rule:%d\n", arg_child, arg, iNode, iRule);
-								return -1;
+				// add new nodes per rule's replace[] specification
+				for (vx_uint32 iNode = 0; iNode < AGO_MERGE_RULE_MAX_REPLACE && rule->replace[iNode].kernel_id; iNode++) {
+					// create a new AgoNode and add it to the nodeList
+					AgoNode * childnode = agoCreateNode(agraph, rule->replace[iNode].kernel_id);
+					for (vx_uint32 arg = 0; arg < AGO_MAX_PARAMS; arg++) {
+						vx_int32 arg_spec = rule->replace[iNode].arg_spec[arg];
+						if (arg_spec) {
+							vx_int32 arg_index = ARG_INDEX(arg_spec);
+							vx_int32 arg_child = ARG_HAS_CHILD(arg_spec) ? ARG_GET_CHILD(arg_spec) : -1;
+							AgoData * data = mdata[arg_index];
+							if (arg_child >= 0) {
+								if (!(arg_child < (vx_int32)data->numChildren) || !data->children[arg_child]) {
+									// TBD: error handling
+									agoAddLogEntry(&data->ref, VX_FAILURE, "ERROR: agoOptimizeDramaRemoveNodeMerge: invalid child(%d) in arg:%d of replace-node:%d of rule:%d\n", arg_child, arg, iNode, iRule);
+									return -1;
+								}
+								data = data->children[arg_child];
 							}
-							data = data->children[arg_child];
-						}
-						if (ARG_IS_BYTE2U1(arg_spec)) {
-							// process the request to convert U8 image to U1 image
-							if (data->ref.type == VX_TYPE_IMAGE && data->u.img.format == VX_DF_IMAGE_U8) {
-								data->u.img.format = VX_DF_IMAGE_U1_AMD;
+							if (ARG_IS_BYTE2U1(arg_spec)) {
+								// process the request to convert U8 image to U1 image
+								if (data->ref.type == VX_TYPE_IMAGE && data->u.img.format == VX_DF_IMAGE_U8) {
+									data->u.img.format = VX_DF_IMAGE_U1_AMD;
+								}
 							}
+							childnode->paramList[arg] = data;
 						}
-						childnode->paramList[arg] = data;
+					}
+					// transfer configuration from rule to childnode
+					childnode->attr_affinity = attr_affinity;
+					//childnode->attr_border_mode = attr_border_mode;
+					//childnode->callback = callback;
+					debug_printf("INFO: agoOptimizeDramaRemoveNodeMerge: added node %s\n", childnode->akernel->name);
+					// verify the node
+					if (agoVerifyNode(childnode)) {
+						return -1;
+					}
+					agoAddNodeToMergeIndex(index, childnode);
+					if (!agoUpdateNodeMergeDataUsage(childnode, true))
+						dataUsageUpdated = false;
+					if (agraph->enable_optimizer_log) {
+						replaced += (iNode > 0) ? " " : " => ";
+						replaced += agoGetNodeLogName(childnode);
 					}
 				}
-				// transfer configuration from rule to childnode
-				childnode->attr_affinity = attr_affinity;
-				//childnode->attr_border_mode = attr_border_mode;
-				//childnode->callback = callback;
-				debug_printf("INFO: agoOptimizeDramaRemoveNodeMerge: added node %s\n", childnode->akernel->name);
-				// verify the node
-				if (agoVerifyNode(childnode)) {
-					return -1;
+				agoOptimizerLogEntry(agraph, "remove", "rule", "%s#%u %s", ruleSet ? "user" : "builtin", iRule, replaced.c_str());
+				// remove the nodes that matched with rule's find[]
+				for (vx_int32 iNode = 0; iNode < stackTop; iNode++) {
+					debug_printf("INFO: agoOptimizeDramaRemoveNodeMerge: removing node %s\n", stack[iNode]->akernel->name);
+					agoRemoveNodeFromMergeIndex(index, stack[iNode]);
+					if (!agoUpdateNodeMergeDataUsage(stack[iNode], false))
+						dataUsageUpdated = false;
+					stack[iNode] = 0;
 				}
-			}
-			// remove the nodes that matched with rule's find[]
-			for (vx_int32 iNode = 0; iNode < stackTop; iNode++) {
-				debug_printf("INFO: agoOptimizeDramaRemoveNodeMerge: removing node %s\n", stack[iNode]->akernel->name);
-				if (agoRemoveNode(&agraph->nodeList, stack[iNode], true)) {
-					agoAddLogEntry(&agraph->ref, VX_FAILURE, "ERROR: agoOptimizeDramaRemoveNodeMerge: agoRemoveNode(*,%s) failed\n", stack[iNode]->akernel->name);
-					return -1;
+				graphGotModified = 1;
+				if (!dataUsageUpdated) {
+					// data usage needs to be marked again before looking for more matches
+					return agoRemoveNodesOfMergeIndex(agraph, index) ? -1 : graphGotModified;
 				}
-				stack[iNode] = 0;
 			}
-			// make only one change at a time
-			return 1;
 		}
 	}
 
+	if (agoRemoveNodesOfMergeIndex(agraph, index))
+		return -1;
+
 	// try special case node mapping
-	for (AgoNode * node = agraph->nodeList.head; node; node = node->next)
+	for (AgoNode * node = agraph->nodeList.head, * nodeNext; node; node = nodeNext)
 	{
+		nodeNext = node->next;
 		AgoKernel * kernel = node->akernel;
 		if (kernel->id == VX_KERNEL_AMD_SCALE_IMAGE_U8_U8_NEAREST || kernel->id == VX_KERNEL_AMD_SCALE_IMAGE_U8_U8_BILINEAR ||
 			kernel->id == VX_KERNEL_AMD_SCALE_IMAGE_U8_U8_BILINEAR_REPLICATE || kernel->id == VX_KERNEL_AMD_SCALE_IMAGE_U8_U8_BILINEAR_CONSTANT ||
@@ -1298,24 +1636,25 @@ int agoOptimizeDramaRemoveNodeMerge(AgoGraph * agraph)
 				childnode->attr_affinity = node->attr_affinity;
 				agoImportNodeConfig(childnode, node);
 				debug_printf("INFO: agoOptimizeDramaRemoveNodeMerge: added node %s\n", childnode->akernel->name);
+				if (agraph->enable_optimizer_log) {
+					agoOptimizerLogEntry(agraph, "remove", "scale", "%s => %s", agoGetNodeLogName(node).c_str(), agoGetNodeLogName(childnode).c_str());
+				}
 				// remove the original node
 				debug_printf("INFO: agoOptimizeDramaRemoveNodeMerge: removing node %s\n", node->akernel->name);
-				if (agoRemoveNode(&agraph->nodeList, node, true)) {
-					agoAddLogEntry(&node->ref, VX_FAILURE, "ERROR: agoOptimizeDramaRemoveNodeMerge: agoRemoveNode(*,%s) failed\n", node->akernel->name);
-					return -1;
-				}
+				agoRemoveNodeFromMergeIndex(index, node);
 				// verify the node
 				if (agoVerifyNode(childnode)) {
 					return -1;
 				}
-				// make only one change at a time
-				return 1;
+				agoAddNodeToMergeIndex(index, childnode);
+				graphGotModified = 1;
 			}
 		}
 	}
+	if (agoRemoveNodesOfMergeIndex(agraph, index))
+		return -1;
 
-	// no changes happened to the graph
-	return 0;
+	return graphGotModified;
 }
 
 int agoOptimizeDramaRemoveImageU8toU1(AgoGraph * agraph)
@@ -1413,6 +1752,11 @@ int agoOptimizeDramaRemoveImageU8toU1(AgoGraph * agraph)
 						}
 					}
 				}
+				if (agraph->enable_optimizer_log) {
+					char name[1024];
+					agoGetDataName(name, adata);
+					agoOptimizerLogEntry(agraph, "remove", "u8-to-u1", "%s", name[0] ? name : "?");
+				}
 				// mark that graph has been modified
 				status = 1;
 			}
@@ -1426,6 +1770,12 @@ int agoOptimizeDramaRemove(AgoGraph * agraph)
 #if ENABLE_DEBUG_MESSAGES > 1
 	int iteration = 0;
 #endif
+	AgoNodeMergeIndex mergeIndex;
+	// duplicate nodes are checked on entry and then only after other passes have no more
+	// changes to make, since each check visits the whole graph
+	bool removeDuplicateNodes = !(agraph->optimizer_flags & AGO_GRAPH_OPTIMIZER_FLAG_NO_REMOVE_DUPLICATE_NODES);
+	bool checkDuplicateNodes = removeDuplicateNodes;
+	bool graphModifiedAfterDuplicateCheck = false;
 	for (int graphGotModified = !0; agraph->nodeList.head && graphGotModified;)
 	{
 		// check and mark data usage
@@ -1436,39 +1786,64 @@ int agoOptimizeDramaRemove(AgoGraph * agraph)
 		agoWriteGraph(agraph, NULL, 0, stdout, "[agoOptimizeDramaRemove]");
 #endif
 
+		if (checkDuplicateNodes) {
+			// try removing nodes that repeat computation of other nodes
+			checkDuplicateNodes = false;
+			graphModifiedAfterDuplicateCheck = false;
+			if ((graphGotModified = agoOptimizeDramaRemoveDuplicateNodes(agraph)) < 0)
+				return -1;
+			if (graphGotModified) {
+				mergeIndex.valid = false;
+				continue;
+			}
+		}
+
 		if (!(agraph->optimizer_flags & AGO_GRAPH_OPTIMIZER_FLAG_NO_REMOVE_COPY_NODES)) {
 			// try removing COPY nodes with virtual buffers
 			if ((graphGotModified = agoOptimizeDramaRemoveCopyNodes(agraph)) < 0)
 				return -1;
-			if (graphGotModified)
+			if (graphGotModified) {
+				mergeIndex.valid = false;
+				graphModifiedAfterDuplicateCheck = true;
 				continue;
+			}
 		}
 
 		if (!(agraph->optimizer_flags & AGO_GRAPH_OPTIMIZER_FLAG_NO_REMOVE_UNUSED_OUTPUTS)) {
 			// try remove nodes who's outputs are not used
 			if ((graphGotModified = agoOptimizeDramaRemoveNodesWithUnusedOutputs(agraph)) < 0)
 				return -1;
-			if (graphGotModified)
+			if (graphGotModified) {
+				mergeIndex.valid = false;
+				graphModifiedAfterDuplicateCheck = true;
 				continue;
+			}
 		}
 
 		if (!(agraph->optimizer_flags & AGO_GRAPH_OPTIMIZER_FLAG_NO_NODE_MERGE)) {
 			// try merging nodes that will further result in removal of redundancies
-			if ((graphGotModified = agoOptimizeDramaRemoveNodeMerge(agraph)) < 0)
+			if ((graphGotModified = agoOptimizeDramaRemoveNodeMerge(agraph, mergeIndex)) < 0)
 				return -1;
-			if (graphGotModified)
+			if (graphGotModified) {
+				graphModifiedAfterDuplicateCheck = true;
 				continue;
+			}
 		}
 
 		if (!(agraph->optimizer_flags & AGO_GRAPH_OPTIMIZER_FLAG_NO_CONVERT_8BIT_TO_1BIT)) {
 			// try converting VX_DF_IMAGE_U8 images to VX_DF_IMAGE_U1_AMD images
 			if ((graphGotModified = agoOptimizeDramaRemoveImageU8toU1(agraph)) < 0)
 				return -1;
-			if (graphGotModified)
+			if (graphGotModified) {
+				mergeIndex.valid = false;
+				graphModifiedAfterDuplicateCheck = true;
 				continue;
+			}
 		}
 
-		graphGotModified = 0;
+		// check for duplicate nodes again when other passes have modified the graph
+		graphGotModified = (removeDuplicateNodes && graphModifiedAfterDuplicateCheck) ? 1 : 0;
+		checkDuplicateNodes = graphGotModified ? true : false;
 	}
 	return 0;
 }
@@ -185,50 +185,148 @@ int HafCpu_CannySobelSuppThreshold_U8XY_U8_7x7_L2NORM
 	return AGO_ERROR_HAFCPU_NOT_IMPLEMENTED;
 }
 
-int HafCpu_CannyEdgeTrace_U8_U8
-	(
-		vx_uint32              dstWidth,
-		vx_uint32              dstHeight,
-		vx_uint8             * pDstImage,
-		vx_uint32              dstImageStrideInBytes,
-		vx_uint32              capacityOfXY,
-		ago_coord2d_ushort_t   xyStack[]
-	)
+//////////////////////////////////////////////////////////////////////
+// band-parallel execution of CPU kernels
+//   - worker threads are created on first use and shared by all nodes
+//   - AGO_CPU_THREADS environment variable overrides the thread count
+//   - nested or concurrent calls run their bands on the calling thread
+class CHafCpuThreadPool {
+public:
+	CHafCpuThreadPool() : threadCount{ 1 }, stop{ false }, generation{ 0 }, func{ nullptr }, arg{ nullptr }, bandCount{ 0 }, activeWorkers{ 0 }, nextBand{ 0 }, doneBands{ 0 } {
+		threadCount = std::thread::hardware_concurrency();
+		char textBuffer[64];
+		if (agoGetEnvironmentVariable("AGO_CPU_THREADS", textBuffer, sizeof(textBuffer))) {
+			threadCount = (vx_uint32)atoi(textBuffer);
+		}
+		threadCount = max(1u, min(threadCount, (vx_uint32)AGO_MAX_CPU_THREADS));
+		for (vx_uint32 i = 1; i < threadCount; i++) {
+			workers.push_back(std::thread(&CHafCpuThreadPool::WorkerLoop, this));
+		}
+	}
+	~CHafCpuThreadPool() {
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			stop = true;
+		}
+		jobAvailable.notify_all();
+		for (auto& worker : workers) {
+			worker.join();
+		}
+	}
+	vx_uint32 GetThreadCount() {
+		return threadCount;
+	}
+	void Run(vx_uint32 count, HafCpu_BandFunc f, void * a) {
+		std::unique_lock<std::mutex> jobLock(jobMutex, std::try_to_lock);
+		if (!jobLock.owns_lock() || workers.empty() || count < 2) {
+			for (vx_uint32 band = 0; band < count; band++) {
+				f(band, count, a);
+			}
+			return;
+		}
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			func = f;
+			arg = a;
+			bandCount = count;
+			nextBand = 0;
+			doneBands = 0;
+			generation++;
+		}
+		jobAvailable.notify_all();
+		RunBands(f, count, a);
+		// wait until all bands are done and no worker is still attached to this job
+		std::unique_lock<std::mutex> lock(mutex);
+		jobDone.wait(lock, [this] { return doneBands == bandCount && activeWorkers == 0; });
+		func = nullptr;
+	}
+private:
+	void RunBands(HafCpu_BandFunc f, vx_uint32 count, void * a) {
+		for (vx_uint32 band; (band = nextBand++) < count;) {
+			f(band, count, a);
+			if (++doneBands == count) {
+				std::lock_guard<std::mutex> lock(mutex);
+				jobDone.notify_all();
+			}
+		}
+	}
+	void WorkerLoop() {
+		vx_uint64 lastGeneration = 0;
+		for (;;) {
+			HafCpu_BandFunc f; void * a; vx_uint32 count;
+			{
+				std::unique_lock<std::mutex> lock(mutex);
+				jobAvailable.wait(lock, [&] { return stop || (func && generation != lastGeneration); });
+				if (stop)
+					break;
+				lastGeneration = generation;
+				f = func; a = arg; count = bandCount;
+				activeWorkers++;
+			}
+			RunBands(f, count, a);
+			{
+				std::lock_guard<std::mutex> lock(mutex);
+				activeWorkers--;
+			}
+			jobDone.notify_all();
+		}
+	}
+	vx_uint32 threadCount;
+	std::vector<std::thread> workers;
+	std::mutex jobMutex;
+	std::mutex mutex;
+	std::condition_variable jobAvailable;
+	std::condition_variable jobDone;
+	bool stop;
+	vx_uint64 generation;
+	HafCpu_BandFunc func;
+	void * arg;
+	vx_uint32 bandCount;
+	vx_uint32 activeWorkers;
+	std::atomic<vx_uint32> nextBand;
+	std::atomic<vx_uint32> doneBands;
+};
+
+static CHafCpuThreadPool& HafCpu_GetThreadPool()
 {
-	return AGO_ERROR_HAFCPU_NOT_IMPLEMENTED;
+	static CHafCpuThreadPool pool;
+	return pool;
 }
 
-int HafCpu_Convolve_U8_U8_MxN
-	(
-		vx_uint32     dstWidth,
-		vx_uint32     dstHeight,
-		vx_uint8    * pDstImage,
-		vx_uint32     dstImageStrideInBytes,
-		vx_uint8    * pSrcImage,
-		vx_uint32     srcImageStrideInBytes,
-		vx_int16    * convMatrix,
-		vx_uint32     convolutionWidth,
-		vx_uint32     convolutionHeight,
-		vx_int32      shift
-	)
+static thread_local vx_uint32 hafCpuThreadLimit = 0;
+static thread_local vx_uint32 hafCpuParallelForCount = 0;
+
+vx_uint32 HafCpu_GetThreadCount
+(
+)
 {
-	return AGO_ERROR_HAFCPU_NOT_IMPLEMENTED;
+	vx_uint32 threadCount = HafCpu_GetThreadPool().GetThreadCount();
+	return hafCpuThreadLimit ? min(threadCount, hafCpuThreadLimit) : threadCount;
 }
 
-int HafCpu_Convolve_S16_U8_MxN
-	(
-		vx_uint32     dstWidth,
-		vx_uint32     dstHeight,
-		vx_int16    * pDstImage,
-		vx_uint32     dstImageStrideInBytes,
-		vx_uint8    * pSrcImage,
-		vx_uint32     srcImageStrideInBytes,
-		vx_int16    * convMatrix,
-		vx_uint32     convolutionWidth,
-		vx_uint32     convolutionHeight,
-		vx_int32      shift
-	)
+void HafCpu_SetThreadLimit
+(
+	vx_uint32 threadLimit
+)
 {
-	return AGO_ERROR_HAFCPU_NOT_IMPLEMENTED;
+	hafCpuThreadLimit = threadLimit;
+}
+
+void HafCpu_ParallelFor
+(
+	vx_uint32       bandCount,
+	HafCpu_BandFunc func,
+	void          * arg
+)
+{
+	if (bandCount > 1)
+		hafCpuParallelForCount++;
+	HafCpu_GetThreadPool().Run(bandCount, func, arg);
 }
 
+vx_uint32 HafCpu_GetParallelForCount
+(
+)
+{
+	return hafCpuParallelForCount;
+}
@@ -355,6 +355,30 @@ int HafCpu_Mul_U8_U8U8_Sat_Round
 		vx_uint32     srcImage2StrideInBytes,
 		vx_float32    scale
 	);
+int HafCpu_Mul_U24_U24U8_Sat_Round
+	(
+		vx_uint32     dstWidth,
+		vx_uint32     dstHeight,
+		vx_uint8    * pDstImage,
+		vx_uint32     dstImageStrideInBytes,
+		vx_uint8    * pSrcImage1,
+		vx_uint32     srcImage1StrideInBytes,
+		vx_uint8    * pSrcImage2,
+		vx_uint32     srcImage2StrideInBytes,
+		vx_float32    scale
+	);
+int HafCpu_Mul_U32_U32U8_Sat_Round
+	(
+		vx_uint32     dstWidth,
+		vx_uint32     dstHeight,
+		vx_uint8    * pDstImage,
+		vx_uint32     dstImageStrideInBytes,
+		vx_uint8    * pSrcImage1,
+		vx_uint32     srcImage1StrideInBytes,
+		vx_uint8    * pSrcImage2,
+		vx_uint32     srcImage2StrideInBytes,
+		vx_float32    scale
+	);
 int HafCpu_And_U8_U8U8
 	(
 		vx_uint32     dstWidth,
@@ -1989,6 +2013,67 @@ int HafCpu_Convolve_S16_U8_MxN
 		vx_uint32     convolutionHeight,
 		vx_int32      shift
 	);
+int HafCpu_ConvolveSeparable_U8_U8
+	(
+		vx_uint32     dstWidth,
+		vx_uint32     dstHeight,
+		vx_uint8    * pDstImage,
+		vx_uint32     dstImageStrideInBytes,
+		vx_uint8    * pSrcImage,
+		vx_uint32     srcImageStrideInBytes,
+		vx_int16    * hCoeff,
+		vx_int16    * vCoeff,
+		vx_uint32     convolutionWidth,
+		vx_uint32     convolutionHeight,
+		vx_int32      shift,
+		vx_uint8    * pLocalData
+	);
+int HafCpu_ConvolveSeparable_S16_U8
+	(
+		vx_uint32     dstWidth,
+		vx_uint32     dstHeight,
+		vx_int16    * pDstImage,
+		vx_uint32     dstImageStrideInBytes,
+		vx_uint8    * pSrcImage,
+		vx_uint32     srcImageStrideInBytes,
+		vx_int16    * hCoeff,
+		vx_int16    * vCoeff,
+		vx_uint32     convolutionWidth,
+		vx_uint32     convolutionHeight,
+		vx_int32      shift,
+		vx_uint8    * pLocalData
+	);
+int HafCpu_LinearFilter_ANY_ANY
+	(
+		vx_uint32     dstWidth,
+		vx_uint32     dstHeight,
+		vx_df_image   dstFormat,
+		vx_uint8    * pDstImage,
+		vx_uint32     dstImageStrideInBytes,
+		vx_df_image   srcFormat,
+		vx_uint8    * pSrcImage,
+		vx_uint32     srcImageStrideInBytes,
+		vx_float32  * filterCoef,
+		vx_uint32     filterWidth,
+		vx_uint32     filterHeight
+	);
+int HafCpu_LinearFilter_ANYx2_ANY
+	(
+		vx_uint32     dstWidth,
+		vx_uint32     dstHeight,
+		vx_df_image   dstFormat,
+		vx_uint8    * pDstImage1,
+		vx_uint32     dstImage1StrideInBytes,
+		vx_uint8    * pDstImage2,
+		vx_uint32     dstImage2StrideInBytes,
+		vx_df_image   srcFormat,
+		vx_uint8    * pSrcImage,
+		vx_uint32     srcImageStrideInBytes,
+		vx_float32  * filterCoef1,
+		vx_float32  * filterCoef2,
+		vx_uint32     filterWidth,
+		vx_uint32     filterHeight
+	);
 int HafCpu_SobelMagnitude_S16_U8_3x3
 	(
 		vx_uint32     dstWidth,
@@ -2128,6 +2213,32 @@ int HafCpu_FastCorners_XY_U8_NoSupression
 		vx_uint32       srcImageStrideInBytes,
 		vx_float32      strength_threshold
 	);
+int HafCpu_FastCorners_XY_U8_Supression_Parallel
+	(
+		vx_uint32       capacityOfDstCorner,
+		vx_keypoint_t   dstCorner[],
+		vx_uint32     * pDstCornerCount,
+		vx_uint32       srcWidth,
+		vx_uint32       srcHeight,
+		vx_uint8      * pSrcImage,
+		vx_uint32       srcImageStrideInBytes,
+		vx_float32      strength_threshold,
+		vx_uint8	  * pScratch,
+		vx_uint32       bandCount
+	);
+int HafCpu_FastCorners_XY_U8_NoSupression_Parallel
+	(
+		vx_uint32       capacityOfDstCorner,
+		vx_keypoint_t   dstCorner[],
+		vx_uint32     * pDstCornerCount,
+		vx_uint32       srcWidth,
+		vx_uint32       srcHeight,
+		vx_uint8      * pSrcImage,
+		vx_uint32       srcImageStrideInBytes,
+		vx_float32      strength_threshold,
+		vx_uint8	  * pScratch,
+		vx_uint32       bandCount
+	);
 int HafCpu_HarrisSobel_HG3_U8_3x3
 	(
 		vx_uint32          dstWidth,
@@ -2213,7 +2324,9 @@ int HafCpu_HarrisMergeSortAndPick_XY_XYS
 		vx_uint32                  srcListCount,
 		vx_float32                 min_distance,
 		ago_harris_grid_header_t * gridInfo,
-		ago_coord2d_short_t      * gridBuf
+		ago_coord2d_short_t      * gridBuf,
+		vx_bool                    countAllCorners,
+		vx_uint32                  bandCount
 	);
 int HafCpu_CannySobelSuppThreshold_U8XY_U8_3x3_L1NORM
 	(
@@ -2360,6 +2473,17 @@ int HafCpu_CannySobel_U16_U8_7x7_L2NORM
 		vx_uint32     srcImageStrideInBytes,
 		vx_uint8    * pLocalData
 	);
+int HafCpu_CannySuppThreshold_U8_U16_3x3
+	(
+		vx_uint32              dstWidth,
+		vx_uint32              dstHeight,
+		vx_uint8             * pDst,
+		vx_uint32              dstStrideInBytes,
+		vx_uint16            * pSrc,
+		vx_uint32              srcStrideInBytes,
+		vx_uint16               hyst_lower,
+		vx_uint16               hyst_upper
+	);
 int HafCpu_CannySuppThreshold_U8XY_U16_3x3
 	(
 		vx_uint32              capacityOfXY,
@@ -2428,47 +2552,49 @@ int HafCpu_Remap_U8_U8_Bilinear_Constant
 		vx_uint32              mapStrideInBytes,
 		vx_uint8               border
 	);
-int HafCpu_WarpAffine_U8_U8_Nearest
+int HafCpu_Remap_U24_U24_Bilinear
 	(
-		vx_uint32             dstWidth,
-		vx_uint32             dstHeight,
-		vx_uint8            * pDstImage,
-		vx_uint32             dstImageStrideInBytes,
-		vx_uint32             srcWidth,
-		vx_uint32             srcHeight,
-		vx_uint8            * pSrcImage,
-		vx_uint32             srcImageStrideInBytes,
-		ago_affine_matrix_t * matrix,
-		vx_uint8			* pLocalData
+		vx_uint32              dstWidth,
+		vx_uint32              dstHeight,
+		vx_uint8             * pDstImage,
+		vx_uint32              dstImageStrideInBytes,
+		vx_uint32              srcWidth,
+		vx_uint32              srcHeight,
+		vx_uint8             * pSrcImage,
+		vx_uint32              srcImageStrideInBytes,
+		ago_coord2d_ushort_t * pMap,
+		vx_uint32              mapStrideInBytes,
+		vx_uint32              remapFractionalBits
 	);
-int HafCpu_WarpAffine_U8_U8_Nearest_Constant
+int HafCpu_Remap_U24_U32_Bilinear
 	(
-		vx_uint32             dstWidth,
-		vx_uint32             dstHeight,
-		vx_uint8            * pDstImage,
-		vx_uint32             dstImageStrideInBytes,
-		vx_uint32             srcWidth,
-		vx_uint32             srcHeight,
-		vx_uint8            * pSrcImage,
-		vx_uint32             srcImageStrideInBytes,
-		ago_affine_matrix_t * matrix,
-		vx_uint8              border,
-		vx_uint8			* pLocalData
+		vx_uint32              dstWidth,
+		vx_uint32              dstHeight,
+		vx_uint8             * pDstImage,
+		vx_uint32              dstImageStrideInBytes,
+		vx_uint32              srcWidth,
+		vx_uint32              srcHeight,
+		vx_uint8             * pSrcImage,
+		vx_uint32              srcImageStrideInBytes,
+		ago_coord2d_ushort_t * pMap,
+		vx_uint32              mapStrideInBytes,
+		vx_uint32              remapFractionalBits
 	);
-int HafCpu_WarpAffine_U8_U8_Bilinear
+int HafCpu_Remap_U32_U32_Bilinear
 	(
-		vx_uint32             dstWidth,
-		vx_uint32             dstHeight,
-		vx_uint8            * pDstImage,
-		vx_uint32             dstImageStrideInBytes,
-		vx_uint32             srcWidth,
-		vx_uint32             srcHeight,
-		vx_uint8            * pSrcImage,
-		vx_uint32             srcImageStrideInBytes,
-		ago_affine_matrix_t * matrix,
-		vx_uint8			* pLocalData
+		vx_uint32              dstWidth,
+		vx_uint32              dstHeight,
+		vx_uint8             * pDstImage,
+		vx_uint32              dstImageStrideInBytes,
+		vx_uint32              srcWidth,
+		vx_uint32              srcHeight,
+		vx_uint8             * pSrcImage,
+		vx_uint32              srcImageStrideInBytes,
+		ago_coord2d_ushort_t * pMap,
+		vx_uint32              mapStrideInBytes,
+		vx_uint32              remapFractionalBits
 	);
-int HafCpu_WarpAffine_U8_U8_Bilinear_Constant
+int HafCpu_WarpAffine_U8_U8_Parallel
 	(
 		vx_uint32             dstWidth,
 		vx_uint32             dstHeight,
@@ -2479,23 +2605,12 @@ int HafCpu_WarpAffine_U8_U8_Bilinear_Constant
 		vx_uint8            * pSrcImage,
 		vx_uint32             srcImageStrideInBytes,
 		ago_affine_matrix_t * matrix,
+		vx_enum               interpolation,
+		vx_enum               borderMode,
 		vx_uint8              border,
-		vx_uint8			* pLocalData
-	);
-int HafCpu_WarpPerspective_U8_U8_Nearest
-	(
-		vx_uint32                  dstWidth,
-		vx_uint32                  dstHeight,
-		vx_uint8                 * pDstImage,
-		vx_uint32                  dstImageStrideInBytes,
-		vx_uint32                  srcWidth,
-		vx_uint32                  srcHeight,
-		vx_uint8                 * pSrcImage,
-		vx_uint32                  srcImageStrideInBytes,
-		ago_perspective_matrix_t * matrix,
-		vx_uint8				 * pLocalData
+		vx_uint32             bandCount
 	);
-int HafCpu_WarpPerspective_U8_U8_Nearest_Constant
+int HafCpu_WarpPerspective_U8_U8_Parallel
 	(
 		vx_uint32                  dstWidth,
 		vx_uint32                  dstHeight,
@@ -2506,35 +2621,10 @@ int HafCpu_WarpPerspective_U8_U8_Nearest_Constant
 		vx_uint8                 * pSrcImage,
 		vx_uint32                  srcImageStrideInBytes,
 		ago_perspective_matrix_t * matrix,
+		vx_enum                    interpolation,
+		vx_enum                    borderMode,
 		vx_uint8                   border,
-		vx_uint8				 * pLocalData
-	);
-int HafCpu_WarpPerspective_U8_U8_Bilinear
-	(
-		vx_uint32                  dstWidth,
-		vx_uint32                  dstHeight,
-		vx_uint8                 * pDstImage,
-		vx_uint32                  dstImageStrideInBytes,
-		vx_uint32                  srcWidth,
-		vx_uint32                  srcHeight,
-		vx_uint8                 * pSrcImage,
-		vx_uint32                  srcImageStrideInBytes,
-		ago_perspective_matrix_t * matrix,
-		vx_uint8				 * pLocalData
-	);
-int HafCpu_WarpPerspective_U8_U8_Bilinear_Constant
-	(
-		vx_uint32                  dstWidth,
-		vx_uint32                  dstHeight,
-		vx_uint8                 * pDstImage,
-		vx_uint32                  dstImageStrideInBytes,
-		vx_uint32                  srcWidth,
-		vx_uint32                  srcHeight,
-		vx_uint8                 * pSrcImage,
-		vx_uint32                  srcImageStrideInBytes,
-		ago_perspective_matrix_t * matrix,
-		vx_uint8                   border,
-		vx_uint8				 * pLocalData
+		vx_uint32                  bandCount
 	);
 int HafCpu_ScaleImage_U8_U8_Nearest
 	(
@@ -2628,6 +2718,81 @@ int HafCpu_OpticalFlowPyrLK_XY_XY_Generic
 	vx_uint8		 * DataPtr,
 	vx_int32		   window_dimension
 );
+int HafCpu_OpticalFlowPyrLK_XY_XY_Parallel
+(
+	vx_keypoint_t      newKeyPoint[],
+	vx_float32         pyramidScale,
+	vx_uint32          pyramidLevelCount,
+	ago_pyramid_u8_t * oldPyramid,
+	ago_pyramid_u8_t * newPyramid,
+	vx_uint32          keyPointCount,
+	vx_keypoint_t      oldKeyPoint[],
+	vx_keypoint_t      newKeyPointEstimate[],
+	vx_enum            termination,
+	vx_float32         epsilon,
+	vx_uint32          num_iterations,
+	vx_bool            use_initial_estimate,
+	vx_uint32		   dataStrideInBytes,
+	vx_uint8		 * DataPtr,
+	vx_int32		   window_dimension,
+	vx_uint32          bandCount
+);
+int HafCpu_OpticalFlowPyrLK_XY_XY_Sparse
+(
+	vx_keypoint_t      newKeyPoint[],
+	vx_float32         pyramidScale,
+	vx_uint32          pyramidLevelCount,
+	ago_pyramid_u8_t * oldPyramid,
+	ago_pyramid_u8_t * newPyramid,
+	vx_uint32          keyPointCount,
+	vx_keypoint_t      oldKeyPoint[],
+	vx_keypoint_t      newKeyPointEstimate[],
+	vx_enum            termination,
+	vx_float32         epsilon,
+	vx_uint32          num_iterations,
+	vx_bool            use_initial_estimate,
+	vx_uint8		 * DataPtr,
+	vx_int32		   window_dimension,
+	vx_uint32          bandCount
+);
+vx_size HafCpu_OpticalFlowPyrLK_XY_XY_SparseScratchSize
+(
+	vx_uint32          width,
+	vx_uint32          height,
+	vx_uint32          keyPointCount
+);
+int HafCpu_OpticalFlowPrepareLK_XY_XY
+(
+	vx_keypoint_t      newKeyPoint[],
+	ago_keypoint_t     nextPt[],
+	vx_uint32          keyPointCount,
+	vx_keypoint_t      oldKeyPoint[],
+	vx_keypoint_t      newKeyPointEstimate[],
+	vx_bool            use_initial_estimate,
+	vx_float32         pyramidScale,
+	vx_uint32          pyramidLevelCount
+);
+int HafCpu_OpticalFlowImageLK_XY_XY
+(
+	vx_keypoint_t      newKeyPoint[],
+	ago_keypoint_t     nextPt[],
+	vx_keypoint_t      keyPoint[],
+	ago_keypoint_t     prevNextPt[],
+	vx_uint32          keyPointCount,
+	vx_keypoint_t      oldKeyPoint[],
+	ago_pyramid_u8_t * oldImage,
+	ago_pyramid_u8_t * newImage,
+	vx_enum            termination,
+	vx_float32         epsilon,
+	vx_uint32          num_iterations,
+	vx_int32           window_dimension,
+	vx_float32         pyramidScale,
+	vx_uint32          level,
+	vx_uint32          pyramidLevelCount,
+	vx_uint8         * DataPtr,
+	vx_bool            sparse,
+	vx_uint32          bandCount
+);
 
 int HafCpu_HarrisMergeSortAndPick_XY_HVC
 	(
@@ -2655,8 +2820,8 @@ int HafCpu_CannyEdgeTrace_U8_U8
 		vx_uint32              dstHeight,
 		vx_uint8             * pDstImage,
 		vx_uint32              dstImageStrideInBytes,
-		vx_uint32              capacityOfXY,
-		ago_coord2d_ushort_t   xyStack[]
+		ago_coord2d_ushort_t   xyStack[],
+		vx_uint32              bandCount
 	);
 int HafCpu_CannyEdgeTrace_U8_U8XY
 	(
@@ -2677,6 +2842,16 @@ int HafCpu_IntegralImage_U32_U8
 		vx_uint8    * pSrcImage,
 		vx_uint32     srcImageStrideInBytes
 	);
+int HafCpu_IntegralImage_U32_U8_Parallel
+	(
+		vx_uint32     dstWidth,
+		vx_uint32     dstHeight,
+		vx_uint32   * pDstImage,
+		vx_uint32     dstImageStrideInBytes,
+		vx_uint8    * pSrcImage,
+		vx_uint32     srcImageStrideInBytes,
+		vx_uint32     bandCount
+	);
 int HafCpu_Histogram_DATA_U8
 	(
 		vx_uint32     dstHist[],
@@ -2695,7 +2870,8 @@ int HafCpu_HistogramFixedBins_DATA_U8
 		vx_uint32     srcWidth,
 		vx_uint32     srcHeight,
 		vx_uint8    * pSrcImage,
-		vx_uint32     srcImageStrideInBytes
+		vx_uint32     srcImageStrideInBytes,
+		vx_uint32     bandCount
 	);
 int HafCpu_MeanStdDev_DATA_U8
 	(
@@ -2706,6 +2882,16 @@ int HafCpu_MeanStdDev_DATA_U8
 		vx_uint8    * pSrcImage,
 		vx_uint32     srcImageStrideInBytes
 	);
+int HafCpu_MeanStdDev_DATA_U8_Parallel
+	(
+		vx_float32  * pSum,
+		vx_float32  * pSumOfSquared,
+		vx_uint32     srcWidth,
+		vx_uint32     srcHeight,
+		vx_uint8    * pSrcImage,
+		vx_uint32     srcImageStrideInBytes,
+		vx_uint32     bandCount
+	);
 int HafCpu_Equalize_DATA_DATA
 	(
 		vx_uint8    * pLut,
@@ -2745,6 +2931,26 @@ int HafCpu_MinMax_DATA_S16
 		vx_int16    * pSrcImage,
 		vx_uint32     srcImageStrideInBytes
 	);
+int HafCpu_MinMax_DATA_U8_Parallel
+	(
+		vx_int32    * pDstMinValue,
+		vx_int32    * pDstMaxValue,
+		vx_uint32     srcWidth,
+		vx_uint32     srcHeight,
+		vx_uint8    * pSrcImage,
+		vx_uint32     srcImageStrideInBytes,
+		vx_uint32     bandCount
+	);
+int HafCpu_MinMax_DATA_S16_Parallel
+	(
+		vx_int32    * pDstMinValue,
+		vx_int32    * pDstMaxValue,
+		vx_uint32     srcWidth,
+		vx_uint32     srcHeight,
+		vx_int16    * pSrcImage,
+		vx_uint32     srcImageStrideInBytes,
+		vx_uint32     bandCount
+	);
 int HafCpu_MinMaxMerge_DATA_DATA
 	(
 		vx_int32    * pDstMinValue,
@@ -2873,6 +3079,26 @@ int HafCpu_MinMaxLoc_DATA_U8DATA_Loc_MinMax_Count_MinMax
 		vx_uint8           * pSrcImage,
 		vx_uint32            srcImageStrideInBytes
 	);
+int HafCpu_MinMaxLoc_DATA_U8DATA_Parallel
+	(
+		vx_uint32          * pMinLocCount,
+		vx_uint32          * pMaxLocCount,
+		vx_uint32            capacityOfMinLocList,
+		vx_coordinates2d_t   minLocList[],
+		vx_uint32            capacityOfMaxLocList,
+		vx_coordinates2d_t   maxLocList[],
+		vx_int32           * pDstMinValue,
+		vx_int32           * pDstMaxValue,
+		vx_uint32            numDataPartitions,
+		vx_int32             srcMinValue[],
+		vx_int32             srcMaxValue[],
+		vx_uint32            srcWidth,
+		vx_uint32            srcHeight,
+		vx_uint8           * pSrcImage,
+		vx_uint32            srcImageStrideInBytes,
+		vx_coordinates2d_t * pScratchLocList,
+		vx_uint32            bandCount
+	);
 int HafCpu_MinMaxLoc_DATA_S16DATA_Loc_None_Count_Min
 	(
 		vx_uint32          * pMinLocCount,
@@ -2993,6 +3219,26 @@ int HafCpu_MinMaxLoc_DATA_S16DATA_Loc_MinMax_Count_MinMax
 		vx_int16           * pSrcImage,
 		vx_uint32            srcImageStrideInBytes
 	);
+int HafCpu_MinMaxLoc_DATA_S16DATA_Parallel
+	(
+		vx_uint32          * pMinLocCount,
+		vx_uint32          * pMaxLocCount,
+		vx_uint32            capacityOfMinLocList,
+		vx_coordinates2d_t   minLocList[],
+		vx_uint32            capacityOfMaxLocList,
+		vx_coordinates2d_t   maxLocList[],
+		vx_int32           * pDstMinValue,
+		vx_int32           * pDstMaxValue,
+		vx_uint32            numDataPartitions,
+		vx_int32             srcMinValue[],
+		vx_int32             srcMaxValue[],
+		vx_uint32            srcWidth,
+		vx_uint32            srcHeight,
+		vx_int16           * pSrcImage,
+		vx_uint32            srcImageStrideInBytes,
+		vx_coordinates2d_t * pScratchLocList,
+		vx_uint32            bandCount
+	);
 int HafCpu_MinMaxLocMerge_DATA_DATA
 	(
 		vx_uint32          * pDstLocCount,
@@ -3022,4 +3268,35 @@ int HafCpu_FastAtan2_Canny
 	vx_int16      Gy
 );
 
+// band-parallel execution of CPU kernels: func is called once for each band in [0, bandCount)
+// from a pool of worker threads; returns after all bands are processed
+typedef void (*HafCpu_BandFunc)
+(
+	vx_uint32     band,
+	vx_uint32     bandCount,
+	void        * arg
+);
+
+vx_uint32 HafCpu_GetThreadCount
+(
+);
+
+// limit the number of threads used by band-parallel kernels called from the current thread (0: no limit)
+void HafCpu_SetThreadLimit
+(
+	vx_uint32 threadLimit
+);
+
+void HafCpu_ParallelFor
+(
+	vx_uint32       bandCount,
+	HafCpu_BandFunc func,
+	void          * arg
+);
+
+// number of HafCpu_ParallelFor calls with more than one band from the current thread
+vx_uint32 HafCpu_GetParallelForCount
+(
+);
+
 #endif // __ago_haf_cpu_h__
@@ -5182,6 +5182,118 @@ int HafCpu_Mul_U8_U8U8_Sat_Round
 	return AGO_SUCCESS;
 }
 
+static inline __m128i Mul_U8x16_Sat_Round(__m128i pixels1, __m128i pixels2, __m128 fscale)
+{
+	const __m128i zeros = _mm_setzero_si128();
+	const __m128i mask = _mm_set1_epi16((short)0x7FFF);
+	__m128i pixels3, pixels4;
+	pixels3 = _mm_mullo_epi16(_mm_unpackhi_epi8(pixels1, zeros), _mm_unpackhi_epi8(pixels2, zeros));	// src1*src2 for (8-15)
+	pixels1 = _mm_mullo_epi16(_mm_cvtepu8_epi16(pixels1), _mm_cvtepu8_epi16(pixels2));				// src1*src2 for (0-7)
+	pixels2 = _mm_cvtps_epi32(_mm_mul_ps(_mm_cvtepi32_ps(_mm_unpackhi_epi16(pixels1, zeros)), fscale));
+	pixels1 = _mm_cvtps_epi32(_mm_mul_ps(_mm_cvtepi32_ps(_mm_cvtepu16_epi32(pixels1)), fscale));
+	pixels4 = _mm_cvtps_epi32(_mm_mul_ps(_mm_cvtepi32_ps(_mm_unpackhi_epi16(pixels3, zeros)), fscale));
+	pixels3 = _mm_cvtps_epi32(_mm_mul_ps(_mm_cvtepi32_ps(_mm_cvtepu16_epi32(pixels3)), fscale));
+	pixels1 = _mm_min_epu16(_mm_packus_epi32(pixels1, pixels2), mask);
+	pixels3 = _mm_min_epu16(_mm_packus_epi32(pixels3, pixels4), mask);
+	return _mm_packus_epi16(pixels1, pixels3);
+}
+
+int HafCpu_Mul_U24_U24U8_Sat_Round
+(
+	vx_uint32     dstWidth,
+	vx_uint32     dstHeight,
+	vx_uint8    * pDstImage,
+	vx_uint32     dstImageStrideInBytes,
+	vx_uint8    * pSrcImage1,
+	vx_uint32     srcImage1StrideInBytes,
+	vx_uint8    * pSrcImage2,
+	vx_uint32     srcImage2StrideInBytes,
+	vx_float32    scale
+)
+{
+	// the U8 factor of each pixel is broadcast to its 3 channels with byte shuffles
+	const __m128i shuffle0 = _mm_setr_epi8(0, 0, 0, 1, 1, 1, 2, 2, 2, 3, 3, 3, 4, 4, 4, 5);
+	const __m128i shuffle1 = _mm_setr_epi8(5, 5, 6, 6, 6, 7, 7, 7, 8, 8, 8, 9, 9, 9, 10, 10);
+	const __m128i shuffle2 = _mm_setr_epi8(10, 11, 11, 11, 12, 12, 12, 13, 13, 13, 14, 14, 14, 15, 15, 15);
+	const __m128 fscale = _mm_set1_ps(scale);
+	int alignedWidth = (int)dstWidth & ~15;
+	for (vx_uint32 height = 0; height < dstHeight; height++)
+	{
+		vx_uint8 * src1 = pSrcImage1;
+		vx_uint8 * src2 = pSrcImage2;
+		vx_uint8 * dst = pDstImage;
+		int x = 0;
+		for (; x < alignedWidth; x += 16, src1 += 48, src2 += 16, dst += 48)
+		{
+			__m128i factor = _mm_loadu_si128((__m128i *)src2);
+			_mm_storeu_si128((__m128i *)(dst +  0), Mul_U8x16_Sat_Round(_mm_loadu_si128((__m128i *)(src1 +  0)), _mm_shuffle_epi8(factor, shuffle0), fscale));
+			_mm_storeu_si128((__m128i *)(dst + 16), Mul_U8x16_Sat_Round(_mm_loadu_si128((__m128i *)(src1 + 16)), _mm_shuffle_epi8(factor, shuffle1), fscale));
+			_mm_storeu_si128((__m128i *)(dst + 32), Mul_U8x16_Sat_Round(_mm_loadu_si128((__m128i *)(src1 + 32)), _mm_shuffle_epi8(factor, shuffle2), fscale));
+		}
+		for (; x < (int)dstWidth; x++, src2++)
+		{
+			for (int c = 0; c < 3; c++, src1++, dst++)
+			{
+				int value = (int)nearbyintf((float)(*src1 * *src2) * scale);
+				*dst = (vx_uint8)max(min(value, 255), 0);
+			}
+		}
+		pSrcImage1 += srcImage1StrideInBytes;
+		pSrcImage2 += srcImage2StrideInBytes;
+		pDstImage += dstImageStrideInBytes;
+	}
+	return AGO_SUCCESS;
+}
+
+int HafCpu_Mul_U32_U32U8_Sat_Round
+(
+	vx_uint32     dstWidth,
+	vx_uint32     dstHeight,
+	vx_uint8    * pDstImage,
+	vx_uint32     dstImageStrideInBytes,
+	vx_uint8    * pSrcImage1,
+	vx_uint32     srcImage1StrideInBytes,
+	vx_uint8    * pSrcImage2,
+	vx_uint32     srcImage2StrideInBytes,
+	vx_float32    scale
+)
+{
+	// the U8 factor of each pixel is broadcast to its 4 channels with byte shuffles
+	const __m128i shuffle0 = _mm_setr_epi8(0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2, 3, 3, 3, 3);
+	const __m128i shuffle1 = _mm_setr_epi8(4, 4, 4, 4, 5, 5, 5, 5, 6, 6, 6, 6, 7, 7, 7, 7);
+	const __m128i shuffle2 = _mm_setr_epi8(8, 8, 8, 8, 9, 9, 9, 9, 10, 10, 10, 10, 11, 11, 11, 11);
+	const __m128i shuffle3 = _mm_setr_epi8(12, 12, 12, 12, 13, 13, 13, 13, 14, 14, 14, 14, 15, 15, 15, 15);
+	const __m128 fscale = _mm_set1_ps(scale);
+	int alignedWidth = (int)dstWidth & ~15;
+	for (vx_uint32 height = 0; height < dstHeight; height++)
+	{
+		vx_uint8 * src1 = pSrcImage1;
+		vx_uint8 * src2 = pSrcImage2;
+		vx_uint8 * dst = pDstImage;
+		int x = 0;
+		for (; x < alignedWidth; x += 16, src1 += 64, src2 += 16, dst += 64)
+		{
+			__m128i factor = _mm_loadu_si128((__m128i *)src2);
+			_mm_storeu_si128((__m128i *)(dst +  0), Mul_U8x16_Sat_Round(_mm_loadu_si128((__m128i *)(src1 +  0)), _mm_shuffle_epi8(factor, shuffle0), fscale));
+			_mm_storeu_si128((__m128i *)(dst + 16), Mul_U8x16_Sat_Round(_mm_loadu_si128((__m128i *)(src1 + 16)), _mm_shuffle_epi8(factor, shuffle1), fscale));
+			_mm_storeu_si128((__m128i *)(dst + 32), Mul_U8x16_Sat_Round(_mm_loadu_si128((__m128i *)(src1 + 32)), _mm_shuffle_epi8(factor, shuffle2), fscale));
+			_mm_storeu_si128((__m128i *)(dst + 48), Mul_U8x16_Sat_Round(_mm_loadu_si128((__m128i *)(src1 + 48)), _mm_shuffle_epi8(factor, shuffle3), fscale));
+		}
+		for (; x < (int)dstWidth; x++, src2++)
+		{
+			for (int c = 0; c < 4; c++, src1++, dst++)
+			{
+				int value = (int)nearbyintf((float)(*src1 * *src2) * scale);
+				*dst = (vx_uint8)max(min(value, 255), 0);
+			}
+		}
+		pSrcImage1 += srcImage1StrideInBytes;
+		pSrcImage2 += srcImage2StrideInBytes;
+		pDstImage += dstImageStrideInBytes;
+	}
+	return AGO_SUCCESS;
+}
+
 int HafCpu_Mul_S16_U8U8_Wrap_Trunc
 (
 	vx_uint32     dstWidth,
@@ -6378,105 +6490,109 @@ int HafCpu_Mul_S16_S16S16_Sat_Round
 	return AGO_SUCCESS;
 }
 
-int HafCpu_MeanStdDev_DATA_U8
+// accumulates the sum and the sum of squares of the pixels in 64-bit: the per-row vector accumulators
+// hold at most four squares per lane per 16 pixels, so they cannot overflow for any realistic width
+static void MeanStdDev_Rows
 	(
-		vx_float32  * pSum,
-		vx_float32  * pSumOfSquared,
+		vx_uint64   * pSum,
+		vx_uint64   * pSumOfSquared,
 		vx_uint32     srcWidth,
 		vx_uint32     srcHeight,
 		vx_uint8    * pSrcImage,
 		vx_uint32     srcImageStrideInBytes
 	)
 {
-	unsigned char * pLocalSrc;
-	__m128i pixels, pixels_16, pixels_32, pixels_64;
 	__m128i zeromask = _mm_setzero_si128();
-	__m128i sum = _mm_setzero_si128();
-	__m128i sum_squared = _mm_setzero_si128();
-	
-	int prefixWidth = intptr_t(pSrcImage) & 15;
-	prefixWidth = (prefixWidth == 0) ? 0 : (16 - prefixWidth);
-	int postfixWidth = ((int)srcWidth - prefixWidth) & 15;
-	int alignedWidth = (int)srcWidth - prefixWidth - postfixWidth;
-	unsigned int prefixSum = 0, postfixSum = 0;
-	unsigned long long prefixSumSquared = 0, postfixSumSquared = 0;
-
-	int height = (int) srcHeight;
-	while (height)
+	vx_uint64 sum = 0, sumSquared = 0;
+	for (vx_uint32 y = 0; y < srcHeight; y++, pSrcImage += srcImageStrideInBytes)
 	{
-		pLocalSrc = (unsigned char *) pSrcImage;
-
-		for (int x = 0; x < prefixWidth; x++, pLocalSrc++)
+		__m128i rowSum = _mm_setzero_si128();							// two 64-bit sums
+		__m128i rowSumSquared = _mm_setzero_si128();					// four 32-bit sums
+		vx_uint32 x = 0;
+		for (; x + 16 <= srcWidth; x += 16)
 		{
-			prefixSum += (unsigned int) *pLocalSrc;
-			prefixSumSquared += (unsigned long long)*pLocalSrc * (unsigned long long)*pLocalSrc;
+			__m128i pixels = _mm_loadu_si128((__m128i *) &pSrcImage[x]);
+			rowSum = _mm_add_epi64(rowSum, _mm_sad_epu8(pixels, zeromask));
+			__m128i pixelsL = _mm_unpacklo_epi8(pixels, zeromask);
+			__m128i pixelsH = _mm_unpackhi_epi8(pixels, zeromask);
+			rowSumSquared = _mm_add_epi32(rowSumSquared, _mm_madd_epi16(pixelsL, pixelsL));
+			rowSumSquared = _mm_add_epi32(rowSumSquared, _mm_madd_epi16(pixelsH, pixelsH));
 		}
-		int width = (int) (alignedWidth >> 4);								// 16 pixels processed at a time
-		while (width)
-		{
-			pixels = _mm_load_si128((__m128i *) pLocalSrc);
-			pixels_16 = _mm_unpackhi_epi8(pixels, zeromask);				// 15, 14, 13, 12, 11, 10, 9, 8
-			pixels_32 = _mm_unpackhi_epi16(pixels_16, zeromask);			// 15, 14, 13, 12
-
-			sum = _mm_add_epi32(sum, pixels_32);							// Pixels 15, 14, 13, 12
-			pixels_64 = _mm_unpackhi_epi32(pixels_32, zeromask);			// 15, 14
-			pixels_32 = _mm_cvtepi32_epi64(pixels_32);						// 13, 12
-			pixels_64 = _mm_mul_epu32(pixels_64, pixels_64);				// square
-			pixels_32 = _mm_mul_epu32(pixels_32, pixels_32);
-			sum_squared = _mm_add_epi64(sum_squared, pixels_64);
-			sum_squared = _mm_add_epi64(sum_squared, pixels_32);
-
-			pixels_32 = _mm_cvtepi16_epi32(pixels_16);
-			sum = _mm_add_epi32(sum, pixels_32);							// Pixels 11, 10, 9, 8
-			pixels_64 = _mm_unpackhi_epi32(pixels_32, zeromask);			// 11, 10
-			pixels_32 = _mm_cvtepi32_epi64(pixels_32);						// 9, 8
-			pixels_64 = _mm_mul_epu32(pixels_64, pixels_64);				// square
-			pixels_32 = _mm_mul_epu32(pixels_32, pixels_32);
-			sum_squared = _mm_add_epi64(sum_squared, pixels_64);
-			sum_squared = _mm_add_epi64(sum_squared, pixels_32);
-
-			pixels_16 = _mm_cvtepu8_epi16(pixels);							// 7, 6, 5, 4, 3, 2, 1, 0
-			pixels_32 = _mm_unpackhi_epi16(pixels_16, zeromask);			// 7, 6, 5, 4
-
-			sum = _mm_add_epi32(sum, pixels_32);							// Pixels 7, 6, 5, 4
-			pixels_64 = _mm_unpackhi_epi32(pixels_32, zeromask);			// 7, 6
-			pixels_32 = _mm_cvtepi32_epi64(pixels_32);						// 5, 4
-			pixels_64 = _mm_mul_epu32(pixels_64, pixels_64);				// square
-			pixels_32 = _mm_mul_epu32(pixels_32, pixels_32);
-			sum_squared = _mm_add_epi64(sum_squared, pixels_64);
-			sum_squared = _mm_add_epi64(sum_squared, pixels_32);
-
-			pixels_32 = _mm_cvtepi16_epi32(pixels_16);
-			sum = _mm_add_epi32(sum, pixels_32);							// Pixels 3, 2, 1, 0
-			pixels_64 = _mm_unpackhi_epi32(pixels_32, zeromask);			// 3, 2
-			pixels_32 = _mm_cvtepi32_epi64(pixels_32);						// 1, 0
-			pixels_64 = _mm_mul_epu32(pixels_64, pixels_64);				// square
-			pixels_32 = _mm_mul_epu32(pixels_32, pixels_32);
-			sum_squared = _mm_add_epi64(sum_squared, pixels_64);
-			sum_squared = _mm_add_epi64(sum_squared, pixels_32);
-
-			pLocalSrc += 16;
-			width--;
-		}
-
-		for (int x = 0; x < postfixWidth; x++, pLocalSrc++)
+		sum += M128I(rowSum).m128i_u64[0] + M128I(rowSum).m128i_u64[1];
+		sumSquared += (vx_uint64)M128I(rowSumSquared).m128i_u32[0] + M128I(rowSumSquared).m128i_u32[1] +
+					  (vx_uint64)M128I(rowSumSquared).m128i_u32[2] + M128I(rowSumSquared).m128i_u32[3];
+		for (; x < srcWidth; x++)
 		{
-			postfixSum += (unsigned int)*pLocalSrc;
-			postfixSumSquared += (unsigned long long)*pLocalSrc * (unsigned long long)*pLocalSrc;
+			sum += pSrcImage[x];
+			sumSquared += (vx_uint32)pSrcImage[x] * pSrcImage[x];
 		}
-
-		pSrcImage += srcImageStrideInBytes;
-		height--;
 	}
-	
-	sum = _mm_hadd_epi32(sum, sum);											// Lowest int of sum has sum of last two ints of sum
-	sum = _mm_hadd_epi32(sum, sum);											// Lowest int of sum has the sum of all four ints
-	pixels = _mm_srli_si128(sum_squared, 8);
-	sum_squared = _mm_add_epi64(sum_squared, pixels);
+	*pSum = sum;
+	*pSumOfSquared = sumSquared;
+}
 
-	*pSum = (vx_float32)(M128I(sum).m128i_u32[0] + prefixSum + postfixSum);
-	*pSumOfSquared = (vx_float32)(M128I(sum_squared).m128i_u64[0] + prefixSumSquared + postfixSumSquared);
+int HafCpu_MeanStdDev_DATA_U8
+	(
+		vx_float32  * pSum,
+		vx_float32  * pSumOfSquared,
+		vx_uint32     srcWidth,
+		vx_uint32     srcHeight,
+		vx_uint8    * pSrcImage,
+		vx_uint32     srcImageStrideInBytes
+	)
+{
+	vx_uint64 sum, sumSquared;
+	MeanStdDev_Rows(&sum, &sumSquared, srcWidth, srcHeight, pSrcImage, srcImageStrideInBytes);
+	*pSum = (vx_float32)sum;
+	*pSumOfSquared = (vx_float32)sumSquared;
+	return AGO_SUCCESS;
+}
 
+// Band-parallel sum and sum of squares: each band of rows produces an exact 64-bit partial
+// and the partials are added before the conversion to the partial record's float fields
+typedef struct {
+	vx_uint32     srcWidth;
+	vx_uint32     srcHeight;
+	vx_uint8    * pSrcImage;
+	vx_uint32     srcImageStrideInBytes;
+	vx_uint64     sum[AGO_MAX_CPU_THREADS];
+	vx_uint64     sumSquared[AGO_MAX_CPU_THREADS];
+} MeanStdDevBandData;
+
+static void MeanStdDev_Band(vx_uint32 band, vx_uint32 bandCount, void * arg)
+{
+	MeanStdDevBandData * data = (MeanStdDevBandData *)arg;
+	vx_uint32 rowStart = data->srcHeight * band / bandCount, rowEnd = data->srcHeight * (band + 1) / bandCount;
+	MeanStdDev_Rows(&data->sum[band], &data->sumSquared[band], data->srcWidth, rowEnd - rowStart,
+		data->pSrcImage + rowStart * data->srcImageStrideInBytes, data->srcImageStrideInBytes);
+}
+
+int HafCpu_MeanStdDev_DATA_U8_Parallel
+	(
+		vx_float32  * pSum,
+		vx_float32  * pSumOfSquared,
+		vx_uint32     srcWidth,
+		vx_uint32     srcHeight,
+		vx_uint8    * pSrcImage,
+		vx_uint32     srcImageStrideInBytes,
+		vx_uint32     bandCount
+	)
+{
+	MeanStdDevBandData data;
+	data.srcWidth = srcWidth;
+	data.srcHeight = srcHeight;
+	data.pSrcImage = pSrcImage;
+	data.srcImageStrideInBytes = srcImageStrideInBytes;
+	bandCount = max(1u, min(bandCount, min(srcHeight, (vx_uint32)AGO_MAX_CPU_THREADS)));
+	HafCpu_ParallelFor(bandCount, MeanStdDev_Band, &data);
+	vx_uint64 sum = 0, sumSquared = 0;
+	for (vx_uint32 band = 0; band < bandCount; band++)
+	{
+		sum += data.sum[band];
+		sumSquared += data.sumSquared[band];
+	}
+	*pSum = (vx_float32)sum;
+	*pSumOfSquared = (vx_float32)sumSquared;
 	return AGO_SUCCESS;
 }
 
@@ -6528,7 +6644,7 @@ int HafCpu_IntegralImage_U32_U8
 	{
 		__m128i * src = (__m128i*)pSrcImage1;
 		__m128i * dst = (__m128i*)pchDst;
-		__m128i * dstlast = dst + (dstWidth >> 2);
+		__m128i * dstlast = dst + ((dstWidth >> 4) << 2);			// SSE loops process 16 pixels at a time
 		__m128i prevsum = _mm_setzero_si128();
 		if (pSrcImage1 == pSrcImage){
 			while (dst < dstlast)
@@ -6670,12 +6786,123 @@ int HafCpu_IntegralImage_U32_U8
 				prevsum = _mm_shuffle_epi32(pixels4, 0xff);
 			}
 		}
+		// remaining pixels: continue the row sum from the last SSE pixel
+		vx_uint32 * pDstRow = (vx_uint32 *)pchDst;
+		vx_uint32 * pPrevRow = (pSrcImage1 == pSrcImage) ? nullptr : (vx_uint32 *)(pchDst - dstImageStrideInBytes);
+		vx_uint32 x = dstWidth & ~15;
+		vx_uint32 rowSum = x ? (pDstRow[x - 1] - (pPrevRow ? pPrevRow[x - 1] : 0)) : 0;
+		for (; x < dstWidth; x++)
+		{
+			rowSum += pSrcImage1[x];
+			pDstRow[x] = rowSum + (pPrevRow ? pPrevRow[x] : 0);
+		}
 		pSrcImage1 += srcImageStrideInBytes;
 		pchDst += dstImageStrideInBytes;
 	}
 	return AGO_SUCCESS;
 }
 
+// dst[x] = sum(src[0..x]) + prev[x], where prev is the integral row above (or nullptr for the first row)
+static void IntegralImage_AccumulateRow
+(
+	vx_uint32       * dst,
+	const vx_uint32 * prev,
+	const vx_uint8  * src,
+	vx_uint32         width
+)
+{
+	vx_uint32 x = 0;
+	__m128i carry = _mm_setzero_si128();
+	for (; x + 4 <= width; x += 4)
+	{
+		__m128i sum = _mm_cvtepu8_epi32(_mm_cvtsi32_si128(*(const int *)&src[x]));
+		sum = _mm_add_epi32(sum, _mm_slli_si128(sum, 4));
+		sum = _mm_add_epi32(sum, _mm_slli_si128(sum, 8));
+		sum = _mm_add_epi32(sum, carry);
+		carry = _mm_shuffle_epi32(sum, 0xff);
+		if (prev)
+			sum = _mm_add_epi32(sum, _mm_loadu_si128((const __m128i *)&prev[x]));
+		_mm_storeu_si128((__m128i *)&dst[x], sum);
+	}
+	vx_uint32 rowSum = (vx_uint32)_mm_cvtsi128_si32(carry);
+	for (; x < width; x++)
+	{
+		rowSum += src[x];
+		dst[x] = rowSum + (prev ? prev[x] : 0);
+	}
+}
+
+// Band-parallel integral image: each band of rows first computes the integral of its own rows, then the
+// last rows of the bands are chained from the top and each band adds the last row of the band above
+// it to its remaining rows
+typedef struct {
+	vx_uint32     dstWidth;
+	vx_uint32     dstHeight;
+	vx_uint32   * pDstImage;
+	vx_uint32     dstImageStrideInBytes;
+	vx_uint8    * pSrcImage;
+	vx_uint32     srcImageStrideInBytes;
+} IntegralImageBandData;
+
+static inline vx_uint32 * IntegralImage_Row(IntegralImageBandData * data, vx_uint32 y)
+{
+	return (vx_uint32 *)((vx_uint8 *)data->pDstImage + y * data->dstImageStrideInBytes);
+}
+
+static void IntegralImage_AddRow(IntegralImageBandData * data, vx_uint32 y, vx_uint32 yCarry)
+{
+	vx_uint32 * dst = IntegralImage_Row(data, y);
+	const vx_uint32 * carry = IntegralImage_Row(data, yCarry);
+	vx_uint32 x = 0;
+	for (; x + 4 <= data->dstWidth; x += 4)
+		_mm_storeu_si128((__m128i *)&dst[x], _mm_add_epi32(_mm_loadu_si128((__m128i *)&dst[x]), _mm_loadu_si128((const __m128i *)&carry[x])));
+	for (; x < data->dstWidth; x++)
+		dst[x] += carry[x];
+}
+
+static void IntegralImage_BandSum(vx_uint32 band, vx_uint32 bandCount, void * arg)
+{
+	IntegralImageBandData * data = (IntegralImageBandData *)arg;
+	vx_uint32 rowStart = data->dstHeight * band / bandCount, rowEnd = data->dstHeight * (band + 1) / bandCount;
+	for (vx_uint32 y = rowStart; y < rowEnd; y++)
+	{
+		const vx_uint8 * src = data->pSrcImage + y * data->srcImageStrideInBytes;
+		IntegralImage_AccumulateRow(IntegralImage_Row(data, y), (y > rowStart) ? IntegralImage_Row(data, y - 1) : nullptr, src, data->dstWidth);
+	}
+}
+
+static void IntegralImage_BandCarry(vx_uint32 band, vx_uint32 bandCount, void * arg)
+{
+	IntegralImageBandData * data = (IntegralImageBandData *)arg;
+	vx_uint32 rowStart = data->dstHeight * band / bandCount, rowEnd = data->dstHeight * (band + 1) / bandCount;
+	// the last row of each band is already complete
+	for (vx_uint32 y = rowStart; band > 0 && y < rowEnd - 1; y++)
+		IntegralImage_AddRow(data, y, rowStart - 1);
+}
+
+int HafCpu_IntegralImage_U32_U8_Parallel
+(
+	vx_uint32     dstWidth,
+	vx_uint32     dstHeight,
+	vx_uint32   * pDstImage,
+	vx_uint32     dstImageStrideInBytes,
+	vx_uint8    * pSrcImage,
+	vx_uint32     srcImageStrideInBytes,
+	vx_uint32     bandCount
+)
+{
+	IntegralImageBandData data = { dstWidth, dstHeight, pDstImage, dstImageStrideInBytes, pSrcImage, srcImageStrideInBytes };
+	bandCount = max(1u, min(bandCount, min(dstHeight, (vx_uint32)AGO_MAX_CPU_THREADS)));
+	HafCpu_ParallelFor(bandCount, IntegralImage_BandSum, &data);
+	if (bandCount > 1)
+	{
+		for (vx_uint32 band = 1; band < bandCount; band++)
+			IntegralImage_AddRow(&data, dstHeight * (band + 1) / bandCount - 1, dstHeight * band / bandCount - 1);
+		HafCpu_ParallelFor(bandCount, IntegralImage_BandCarry, &data);
+	}
+	return AGO_SUCCESS;
+}
+
 #if 0
 // keeping the implementation in case we need it in future
 int HafCpu_Histogram_DATA_U8
@@ -6748,7 +6975,10 @@ int HafCpu_Histogram_DATA_U8
 #endif
 
 #define NUM_BINS	256
+#define NUM_SUB_HISTOGRAMS	4
 // special case histogram primitive : range - 255, offset: 0, NumBins: 255
+// the four pixels of each 32-bit word are counted into separate sub-histograms, so that runs of equal pixels
+// don't stall on the increment of the same bin (store-to-load forwarding), and the sub-histograms are summed at the end
 int HafCpu_Histogram_DATA_U8
 (
 	vx_uint32     dstHist[],
@@ -6758,41 +6988,31 @@ int HafCpu_Histogram_DATA_U8
 	vx_uint32     srcImageStrideInBytes
 )
 {
-	unsigned int *pdst = dstHist;
-	memset(pdst, 0x0, NUM_BINS * sizeof(unsigned int));
+	vx_uint32 subHist[NUM_SUB_HISTOGRAMS][NUM_BINS];
+	memset(subHist, 0x0, sizeof(subHist));
 	for (unsigned int y = 0; y < srcHeight; y++)
 	{
 		unsigned int * src = (unsigned int *)(pSrcImage + y*srcImageStrideInBytes);
 		unsigned int * srclast = src + (srcWidth >> 2);
 		while (src < srclast)
 		{
-			// do for 16 pixels..
 			unsigned int pixel4;
 			pixel4 = *src++;
-			pdst[(pixel4 & 0xFF)]++;
-			pdst[(pixel4 >> 8) & 0xFF]++;
-			pdst[(pixel4 >> 16) & 0xFF]++;
-			pdst[(pixel4 >> 24) & 0xFF]++;
-
-			pixel4 = *src++;
-			pdst[(pixel4 & 0xFF)]++;
-			pdst[(pixel4 >> 8) & 0xFF]++;
-			pdst[(pixel4 >> 16) & 0xFF]++;
-			pdst[(pixel4 >> 24) & 0xFF]++;
-
-			pixel4 = *src++;
-			pdst[(pixel4 & 0xFF)]++;
-			pdst[(pixel4 >> 8) & 0xFF]++;
-			pdst[(pixel4 >> 16) & 0xFF]++;
-			pdst[(pixel4 >> 24) & 0xFF]++;
-
-			pixel4 = *src++;
-			pdst[(pixel4 & 0xFF)]++;
-			pdst[(pixel4 >> 8) & 0xFF]++;
-			pdst[(pixel4 >> 16) & 0xFF]++;
-			pdst[(pixel4 >> 24) & 0xFF]++;
+			subHist[0][(pixel4 & 0xFF)]++;
+			subHist[1][(pixel4 >> 8) & 0xFF]++;
+			subHist[2][(pixel4 >> 16) & 0xFF]++;
+			subHist[3][(pixel4 >> 24) & 0xFF]++;
+		}
+		// remaining pixels in the row
+		for (vx_uint8 * pixel = (vx_uint8 *)src; pixel < pSrcImage + y*srcImageStrideInBytes + srcWidth; pixel++)
+		{
+			subHist[0][*pixel]++;
 		}
 	}
+	for (unsigned int n = 0; n < NUM_BINS; n++)
+	{
+		dstHist[n] = subHist[0][n] + subHist[1][n] + subHist[2][n] + subHist[3][n];
+	}
 	return AGO_SUCCESS;
 }
 
@@ -6812,15 +7032,15 @@ int HafCpu_HistogramMerge_DATA_DATA
 		__m128i sum1 = _mm_setzero_si128();
 		__m128i sum2 = _mm_setzero_si128();
 		for (unsigned int i = 0; i < numPartitions; i++){
-			__m128i *phist = (__m128i *)&pPartSrcHist[i];
-			pixels1 = _mm_load_si128(&phist[(n >> 2)]);
-			pixels2 = _mm_load_si128(&phist[(n >> 2)+1]);
+			__m128i *phist = (__m128i *)pPartSrcHist[i];
+			pixels1 = _mm_loadu_si128(&phist[(n >> 2)]);
+			pixels2 = _mm_loadu_si128(&phist[(n >> 2)+1]);
 			sum1 = _mm_add_epi32(sum1, pixels1);
 			sum2 = _mm_add_epi32(sum2, pixels2);
 		}
 		// copy merged
-		_mm_store_si128(&dst[(n >> 2)], sum1);
-		_mm_store_si128(&dst[(n >> 2) + 1], sum2);
+		_mm_storeu_si128(&dst[(n >> 2)], sum1);
+		_mm_storeu_si128(&dst[(n >> 2) + 1], sum2);
 	}
 	return AGO_SUCCESS;
 }
@@ -6912,6 +7132,7 @@ int HafCpu_MinMax_DATA_U8
 
 	int prefixWidth = intptr_t(pSrcImage) & 15;
 	prefixWidth = (prefixWidth == 0) ? 0 : (16 - prefixWidth);
+	prefixWidth = min(prefixWidth, (int)srcWidth);
 	int postfixWidth = ((int)srcWidth - prefixWidth) & 15;
 	int alignedWidth = (int)srcWidth - prefixWidth - postfixWidth;
 	unsigned char maxVal = 0, minVal = 255;
@@ -6992,6 +7213,7 @@ int HafCpu_MinMaxLoc_DATA_U8DATA_Loc_None_Count_Min
 
 	int prefixWidth = intptr_t(pSrcImage) & 15;
 	prefixWidth = (prefixWidth == 0) ? 0 : (16 - prefixWidth);
+	prefixWidth = min(prefixWidth, (int)srcWidth);
 	int postfixWidth = ((int)srcWidth - prefixWidth) & 15;
 	int alignedWidth = (int)srcWidth - postfixWidth;
 
@@ -7072,6 +7294,7 @@ int HafCpu_MinMaxLoc_DATA_U8DATA_Loc_None_Count_Max
 
 	int prefixWidth = intptr_t(pSrcImage) & 15;
 	prefixWidth = (prefixWidth == 0) ? 0 : (16 - prefixWidth);
+	prefixWidth = min(prefixWidth, (int)srcWidth);
 	int postfixWidth = ((int)srcWidth - prefixWidth) & 15;
 	int alignedWidth = (int)srcWidth - postfixWidth;
 
@@ -7081,7 +7304,7 @@ int HafCpu_MinMaxLoc_DATA_U8DATA_Loc_None_Count_Max
 		int width = 0;
 		while (width < prefixWidth)
 		{
-			if (*pLocalSrc == globalMin)
+			if (*pLocalSrc == globalMax)
 				maxCount++;
 			width++;
 			pLocalSrc++;
@@ -7110,7 +7333,7 @@ int HafCpu_MinMaxLoc_DATA_U8DATA_Loc_None_Count_Max
 
 		while (width < (int)srcWidth)
 		{
-			if (*pLocalSrc == globalMin)
+			if (*pLocalSrc == globalMax)
 				maxCount++;
 			width++;
 			pLocalSrc++;
@@ -7154,6 +7377,7 @@ int HafCpu_MinMaxLoc_DATA_U8DATA_Loc_None_Count_MinMax
 
 	int prefixWidth = intptr_t(pSrcImage) & 15;
 	prefixWidth = (prefixWidth == 0) ? 0 : (16 - prefixWidth);
+	prefixWidth = min(prefixWidth, (int)srcWidth);
 	int postfixWidth = ((int)srcWidth - prefixWidth) & 15;
 	int alignedWidth = (int)srcWidth - postfixWidth;
 
@@ -7255,6 +7479,7 @@ int HafCpu_MinMaxLoc_DATA_U8DATA_Loc_Min_Count_Min
 
 	int prefixWidth = intptr_t(pSrcImage) & 15;
 	prefixWidth = (prefixWidth == 0) ? 0 : (16 - prefixWidth);
+	prefixWidth = min(prefixWidth, (int)srcWidth);
 	int postfixWidth = ((int)srcWidth - prefixWidth) & 15;
 	int alignedWidth = (int)srcWidth - postfixWidth;
 
@@ -7372,6 +7597,7 @@ int HafCpu_MinMaxLoc_DATA_U8DATA_Loc_Min_Count_MinMax
 
 	int prefixWidth = intptr_t(pSrcImage) & 15;
 	prefixWidth = (prefixWidth == 0) ? 0 : (16 - prefixWidth);
+	prefixWidth = min(prefixWidth, (int)srcWidth);
 	int postfixWidth = ((int)srcWidth - prefixWidth) & 15;
 	int alignedWidth = (int)srcWidth - postfixWidth;
 
@@ -7504,6 +7730,7 @@ int HafCpu_MinMaxLoc_DATA_U8DATA_Loc_Max_Count_Max
 
 	int prefixWidth = intptr_t(pSrcImage) & 15;
 	prefixWidth = (prefixWidth == 0) ? 0 : (16 - prefixWidth);
+	prefixWidth = min(prefixWidth, (int)srcWidth);
 	int postfixWidth = ((int)srcWidth - prefixWidth) & 15;
 	int alignedWidth = (int)srcWidth - postfixWidth;
 
@@ -7622,6 +7849,7 @@ int HafCpu_MinMaxLoc_DATA_U8DATA_Loc_Max_Count_MinMax
 
 	int prefixWidth = intptr_t(pSrcImage) & 15;
 	prefixWidth = (prefixWidth == 0) ? 0 : (16 - prefixWidth);
+	prefixWidth = min(prefixWidth, (int)srcWidth);
 	int postfixWidth = ((int)srcWidth - prefixWidth) & 15;
 	int alignedWidth = (int)srcWidth - postfixWidth;
 
@@ -7758,6 +7986,7 @@ int HafCpu_MinMaxLoc_DATA_U8DATA_Loc_MinMax_Count_MinMax
 
 	int prefixWidth = intptr_t(pSrcImage) & 15;
 	prefixWidth = (prefixWidth == 0) ? 0 : (16 - prefixWidth);
+	prefixWidth = min(prefixWidth, (int)srcWidth);
 	int postfixWidth = ((int)srcWidth - prefixWidth) & 15;
 	int alignedWidth = (int)srcWidth - postfixWidth;
 
@@ -7903,6 +8132,7 @@ int HafCpu_MinMax_DATA_S16
 	int prefixWidth = intptr_t(pSrcImage) & 15;
 	prefixWidth = (prefixWidth == 0) ? 0 : (16 - prefixWidth);
 	prefixWidth >>= 1;														// 2 bytes = 1 pixel
+	prefixWidth = min(prefixWidth, (int)srcWidth);
 	int postfixWidth = ((int)srcWidth - prefixWidth) & 15;
 	int alignedWidth = (int)srcWidth - prefixWidth - postfixWidth;
 	short maxVal = SHRT_MIN, minVal = SHRT_MAX;
@@ -7986,6 +8216,7 @@ int HafCpu_MinMaxLoc_DATA_S16DATA_Loc_None_Count_Min
 	int prefixWidth = intptr_t(pSrcImage) & 15;
 	prefixWidth = (prefixWidth == 0) ? 0 : (16 - prefixWidth);
 	prefixWidth >>= 1;														// 2 bytes = 1 pixel
+	prefixWidth = min(prefixWidth, (int)srcWidth);
 	int postfixWidth = ((int)srcWidth - prefixWidth) & 15;
 	int alignedWidth = (int)srcWidth - postfixWidth;
 
@@ -8071,6 +8302,7 @@ int HafCpu_MinMaxLoc_DATA_S16DATA_Loc_None_Count_Max
 	int prefixWidth = intptr_t(pSrcImage) & 15;
 	prefixWidth = (prefixWidth == 0) ? 0 : (16 - prefixWidth);
 	prefixWidth >>= 1;														// 2 bytes = 1 pixel
+	prefixWidth = min(prefixWidth, (int)srcWidth);
 	int postfixWidth = ((int)srcWidth - prefixWidth) & 15;
 	int alignedWidth = (int)srcWidth - postfixWidth;
 
@@ -8080,7 +8312,7 @@ int HafCpu_MinMaxLoc_DATA_S16DATA_Loc_None_Count_Max
 		int width = 0;
 		while (width < prefixWidth)
 		{
-			if (*pLocalSrc == globalMin)
+			if (*pLocalSrc == globalMax)
 				maxCount++;
 			width++;
 			pLocalSrc++;
@@ -8113,7 +8345,7 @@ int HafCpu_MinMaxLoc_DATA_S16DATA_Loc_None_Count_Max
 
 		while (width < (int)srcWidth)
 		{
-			if (*pLocalSrc == globalMin)
+			if (*pLocalSrc == globalMax)
 				maxCount++;
 			width++;
 			pLocalSrc++;
@@ -8158,6 +8390,7 @@ int HafCpu_MinMaxLoc_DATA_S16DATA_Loc_None_Count_MinMax
 	int prefixWidth = intptr_t(pSrcImage) & 15;
 	prefixWidth = (prefixWidth == 0) ? 0 : (16 - prefixWidth);
 	prefixWidth >>= 1;														// 2 bytes = 1 pixel
+	prefixWidth = min(prefixWidth, (int)srcWidth);
 	int postfixWidth = ((int)srcWidth - prefixWidth) & 15;
 	int alignedWidth = (int)srcWidth - postfixWidth;
 
@@ -8266,6 +8499,7 @@ int HafCpu_MinMaxLoc_DATA_S16DATA_Loc_Min_Count_Min
 	int prefixWidth = intptr_t(pSrcImage) & 15;
 	prefixWidth = (prefixWidth == 0) ? 0 : (16 - prefixWidth);
 	prefixWidth >>= 1;														// 2 bytes = 1 pixel
+	prefixWidth = min(prefixWidth, (int)srcWidth);
 	int postfixWidth = ((int)srcWidth - prefixWidth) & 15;
 	int alignedWidth = (int)srcWidth - postfixWidth;
 
@@ -8386,6 +8620,7 @@ int HafCpu_MinMaxLoc_DATA_S16DATA_Loc_Min_Count_MinMax
 	int prefixWidth = intptr_t(pSrcImage) & 15;
 	prefixWidth = (prefixWidth == 0) ? 0 : (16 - prefixWidth);
 	prefixWidth >>= 1;														// 2 bytes = 1 pixel
+	prefixWidth = min(prefixWidth, (int)srcWidth);
 	int postfixWidth = ((int)srcWidth - prefixWidth) & 15;
 	int alignedWidth = (int)srcWidth - postfixWidth;
 
@@ -8526,6 +8761,7 @@ int HafCpu_MinMaxLoc_DATA_S16DATA_Loc_Max_Count_Max
 	int prefixWidth = intptr_t(pSrcImage) & 15;
 	prefixWidth = (prefixWidth == 0) ? 0 : (16 - prefixWidth);
 	prefixWidth >>= 1;														// 2 bytes = 1 pixel
+	prefixWidth = min(prefixWidth, (int)srcWidth);
 	int postfixWidth = ((int)srcWidth - prefixWidth) & 15;
 	int alignedWidth = (int)srcWidth - postfixWidth;
 
@@ -8648,6 +8884,7 @@ int HafCpu_MinMaxLoc_DATA_S16DATA_Loc_Max_Count_MinMax
 	int prefixWidth = intptr_t(pSrcImage) & 15;
 	prefixWidth = (prefixWidth == 0) ? 0 : (16 - prefixWidth);
 	prefixWidth >>= 1;														// 2 bytes = 1 pixel
+	prefixWidth = min(prefixWidth, (int)srcWidth);
 	int postfixWidth = ((int)srcWidth - prefixWidth) & 15;
 	int alignedWidth = (int)srcWidth - postfixWidth;
 
@@ -8791,6 +9028,7 @@ int HafCpu_MinMaxLoc_DATA_S16DATA_Loc_MinMax_Count_MinMax
 	int prefixWidth = intptr_t(pSrcImage) & 15;
 	prefixWidth = (prefixWidth == 0) ? 0 : (16 - prefixWidth);
 	prefixWidth >>= 1;														// 2 bytes = 1 pixel
+	prefixWidth = min(prefixWidth, (int)srcWidth);
 	int postfixWidth = ((int)srcWidth - prefixWidth) & 15;
 	int alignedWidth = (int)srcWidth - postfixWidth;
 
@@ -8943,7 +9181,7 @@ int HafCpu_MinMaxMerge_DATA_DATA
 	for (int i = 1; i < (int) numDataPartitions; i++)
 	{
 		minVal = min(minVal, srcMinValue[i]);
-		maxVal = min(minVal, srcMaxValue[i]);
+		maxVal = max(maxVal, srcMaxValue[i]);
 	}
 
 	*pDstMinValue = minVal;
@@ -8963,30 +9201,283 @@ int HafCpu_MinMaxLocMerge_DATA_DATA
 		vx_coordinates2d_t * partLocList[]
 	)
 {
-	int dstCount = 0;
-	int srcCount;
-	vx_coordinates2d_t * srcList;
-	
-	for (int i = 0; i < (int)numDataPartitions; i++)
+	// concatenate the partial lists up to the capacity of the destination, but count all locations
+	vx_uint32 dstCount = 0;
+	for (vx_uint32 i = 0; i < numDataPartitions; i++)
 	{
-		srcList = partLocList[i];
-		srcCount = partLocCount[i];
+		if (dstCount < capacityOfDstLocList)
+			memcpy(&dstLocList[dstCount], partLocList[i], min(partLocCount[i], capacityOfDstLocList - dstCount) * sizeof(vx_coordinates2d_t));
+		dstCount += partLocCount[i];
+	}
+	*pDstLocCount = dstCount;
+	return AGO_SUCCESS;
+}
 
-		while (srcCount)
-		{
-			*dstLocList++ = *srcList++;
-			dstCount++;
-			srcCount--;
-			if (dstCount > (int) capacityOfDstLocList)
-			{
-				*pDstLocCount = (vx_uint32)(dstCount - 1);
-				return AGO_SUCCESS;
-			}
-		}
+// Band-parallel min/max: each band of rows produces a partial min/max that is combined with
+// HafCpu_MinMaxMerge_DATA_DATA
+typedef struct {
+	vx_bool       isS16;
+	vx_uint32     srcWidth;
+	vx_uint32     srcHeight;
+	vx_uint8    * pSrcImage;
+	vx_uint32     srcImageStrideInBytes;
+	vx_int32      minValue[AGO_MAX_CPU_THREADS];
+	vx_int32      maxValue[AGO_MAX_CPU_THREADS];
+} MinMaxBandData;
+
+static void MinMax_Band(vx_uint32 band, vx_uint32 bandCount, void * arg)
+{
+	MinMaxBandData * data = (MinMaxBandData *)arg;
+	vx_uint32 rowStart = data->srcHeight * band / bandCount, rowEnd = data->srcHeight * (band + 1) / bandCount;
+	vx_uint8 * pSrc = data->pSrcImage + rowStart * data->srcImageStrideInBytes;
+	if (data->isS16)
+		HafCpu_MinMax_DATA_S16(&data->minValue[band], &data->maxValue[band], data->srcWidth, rowEnd - rowStart, (vx_int16 *)pSrc, data->srcImageStrideInBytes);
+	else
+		HafCpu_MinMax_DATA_U8(&data->minValue[band], &data->maxValue[band], data->srcWidth, rowEnd - rowStart, pSrc, data->srcImageStrideInBytes);
+}
+
+static int MinMax_Parallel
+	(
+		vx_int32    * pDstMinValue,
+		vx_int32    * pDstMaxValue,
+		vx_bool       isS16,
+		vx_uint32     srcWidth,
+		vx_uint32     srcHeight,
+		vx_uint8    * pSrcImage,
+		vx_uint32     srcImageStrideInBytes,
+		vx_uint32     bandCount
+	)
+{
+	MinMaxBandData data;
+	data.isS16 = isS16;
+	data.srcWidth = srcWidth;
+	data.srcHeight = srcHeight;
+	data.pSrcImage = pSrcImage;
+	data.srcImageStrideInBytes = srcImageStrideInBytes;
+	bandCount = max(1u, min(bandCount, min(srcHeight, (vx_uint32)AGO_MAX_CPU_THREADS)));
+	HafCpu_ParallelFor(bandCount, MinMax_Band, &data);
+	return HafCpu_MinMaxMerge_DATA_DATA(pDstMinValue, pDstMaxValue, bandCount, data.minValue, data.maxValue);
+}
+
+int HafCpu_MinMax_DATA_U8_Parallel
+	(
+		vx_int32    * pDstMinValue,
+		vx_int32    * pDstMaxValue,
+		vx_uint32     srcWidth,
+		vx_uint32     srcHeight,
+		vx_uint8    * pSrcImage,
+		vx_uint32     srcImageStrideInBytes,
+		vx_uint32     bandCount
+	)
+{
+	return MinMax_Parallel(pDstMinValue, pDstMaxValue, vx_false_e, srcWidth, srcHeight, pSrcImage, srcImageStrideInBytes, bandCount);
+}
+
+int HafCpu_MinMax_DATA_S16_Parallel
+	(
+		vx_int32    * pDstMinValue,
+		vx_int32    * pDstMaxValue,
+		vx_uint32     srcWidth,
+		vx_uint32     srcHeight,
+		vx_int16    * pSrcImage,
+		vx_uint32     srcImageStrideInBytes,
+		vx_uint32     bandCount
+	)
+{
+	return MinMax_Parallel(pDstMinValue, pDstMaxValue, vx_true_e, srcWidth, srcHeight, (vx_uint8 *)pSrcImage, srcImageStrideInBytes, bandCount);
+}
+
+// Band-parallel min/max locations: each band of rows runs the matching serial variant into its own
+// location lists (band 0 directly into the output lists, the others into scratch), then the band lists
+// are appended in raster order with HafCpu_MinMaxLocMerge_DATA_DATA
+typedef struct {
+	vx_bool              isS16;
+	vx_bool              countMin;
+	vx_bool              countMax;
+	vx_int32             minValue;
+	vx_int32             maxValue;
+	vx_uint32            srcWidth;
+	vx_uint32            srcHeight;
+	vx_uint8           * pSrcImage;
+	vx_uint32            srcImageStrideInBytes;
+	vx_uint32            capacityOfMinLocList;
+	vx_uint32            capacityOfMaxLocList;
+	vx_coordinates2d_t * minLocList[AGO_MAX_CPU_THREADS];
+	vx_coordinates2d_t * maxLocList[AGO_MAX_CPU_THREADS];
+	vx_uint32            minLocCount[AGO_MAX_CPU_THREADS];
+	vx_uint32            maxLocCount[AGO_MAX_CPU_THREADS];
+} MinMaxLocBandData;
+
+#define MINMAXLOC_ROWS_CALL(type, T) \
+	if (minLocList && maxLocList) \
+		return HafCpu_MinMaxLoc_DATA_##type##DATA_Loc_MinMax_Count_MinMax(pMinLocCount, pMaxLocCount, capMin, minLocList, capMax, maxLocList, &minVal, &maxVal, 1, &minVal, &maxVal, w, h, (T *)pSrc, stride); \
+	else if (minLocList && data->countMax) \
+		return HafCpu_MinMaxLoc_DATA_##type##DATA_Loc_Min_Count_MinMax(pMinLocCount, pMaxLocCount, capMin, minLocList, &minVal, &maxVal, 1, &minVal, &maxVal, w, h, (T *)pSrc, stride); \
+	else if (minLocList) \
+		return HafCpu_MinMaxLoc_DATA_##type##DATA_Loc_Min_Count_Min(pMinLocCount, capMin, minLocList, &minVal, &maxVal, 1, &minVal, &maxVal, w, h, (T *)pSrc, stride); \
+	else if (maxLocList && data->countMin) \
+		return HafCpu_MinMaxLoc_DATA_##type##DATA_Loc_Max_Count_MinMax(pMinLocCount, pMaxLocCount, capMax, maxLocList, &minVal, &maxVal, 1, &minVal, &maxVal, w, h, (T *)pSrc, stride); \
+	else if (maxLocList) \
+		return HafCpu_MinMaxLoc_DATA_##type##DATA_Loc_Max_Count_Max(pMaxLocCount, capMax, maxLocList, &minVal, &maxVal, 1, &minVal, &maxVal, w, h, (T *)pSrc, stride); \
+	else if (data->countMin && data->countMax) \
+		return HafCpu_MinMaxLoc_DATA_##type##DATA_Loc_None_Count_MinMax(pMinLocCount, pMaxLocCount, &minVal, &maxVal, 1, &minVal, &maxVal, w, h, (T *)pSrc, stride); \
+	else if (data->countMin) \
+		return HafCpu_MinMaxLoc_DATA_##type##DATA_Loc_None_Count_Min(pMinLocCount, &minVal, &maxVal, 1, &minVal, &maxVal, w, h, (T *)pSrc, stride); \
+	else \
+		return HafCpu_MinMaxLoc_DATA_##type##DATA_Loc_None_Count_Max(pMaxLocCount, &minVal, &maxVal, 1, &minVal, &maxVal, w, h, (T *)pSrc, stride);
+
+static int MinMaxLoc_Rows(MinMaxLocBandData * data, vx_uint32 band, vx_uint32 rowStart, vx_uint32 rowEnd)
+{
+	vx_int32 minVal = data->minValue, maxVal = data->maxValue;
+	vx_uint32 * pMinLocCount = &data->minLocCount[band], * pMaxLocCount = &data->maxLocCount[band];
+	vx_coordinates2d_t * minLocList = data->minLocList[band], * maxLocList = data->maxLocList[band];
+	vx_uint32 capMin = data->capacityOfMinLocList, capMax = data->capacityOfMaxLocList;
+	vx_uint32 w = data->srcWidth, h = rowEnd - rowStart, stride = data->srcImageStrideInBytes;
+	vx_uint8 * pSrc = data->pSrcImage + rowStart * stride;
+	if (data->isS16) {
+		MINMAXLOC_ROWS_CALL(S16, vx_int16)
+	}
+	else {
+		MINMAXLOC_ROWS_CALL(U8, vx_uint8)
+	}
+}
+
+static void MinMaxLoc_Band(vx_uint32 band, vx_uint32 bandCount, void * arg)
+{
+	MinMaxLocBandData * data = (MinMaxLocBandData *)arg;
+	vx_uint32 rowStart = data->srcHeight * band / bandCount, rowEnd = data->srcHeight * (band + 1) / bandCount;
+	data->minLocCount[band] = data->maxLocCount[band] = 0;
+	MinMaxLoc_Rows(data, band, rowStart, rowEnd);
+	// band locations are relative to the first row of the band
+	if (data->minLocList[band]) {
+		for (vx_uint32 i = 0; i < min(data->minLocCount[band], data->capacityOfMinLocList); i++)
+			data->minLocList[band][i].y += rowStart;
+	}
+	if (data->maxLocList[band]) {
+		for (vx_uint32 i = 0; i < min(data->maxLocCount[band], data->capacityOfMaxLocList); i++)
+			data->maxLocList[band][i].y += rowStart;
 	}
+}
+
+static void MinMaxLoc_MergeBands(vx_uint32 * pLocCount, vx_uint32 capacityOfLocList, vx_coordinates2d_t locList[], vx_uint32 bandCount, vx_uint32 bandLocCount[], vx_coordinates2d_t * bandLocList[])
+{
+	vx_uint32 partLocCount[AGO_MAX_CPU_THREADS];
+	vx_uint32 count0 = min(bandLocCount[0], capacityOfLocList);
+	for (vx_uint32 band = 1; band < bandCount; band++)
+		partLocCount[band] = min(bandLocCount[band], capacityOfLocList);
+	if (locList) {
+		// band 0 is already in place
+		vx_uint32 mergedCount = 0;
+		HafCpu_MinMaxLocMerge_DATA_DATA(&mergedCount, capacityOfLocList - count0, locList + count0, bandCount - 1, partLocCount + 1, bandLocList + 1);
+	}
+	vx_uint32 count = 0;
+	for (vx_uint32 band = 0; band < bandCount; band++)
+		count += bandLocCount[band];
+	*pLocCount = count;
+}
+
+static int MinMaxLoc_Parallel
+	(
+		vx_bool              isS16,
+		vx_uint32          * pMinLocCount,
+		vx_uint32          * pMaxLocCount,
+		vx_uint32            capacityOfMinLocList,
+		vx_coordinates2d_t   minLocList[],
+		vx_uint32            capacityOfMaxLocList,
+		vx_coordinates2d_t   maxLocList[],
+		vx_int32           * pDstMinValue,
+		vx_int32           * pDstMaxValue,
+		vx_uint32            numDataPartitions,
+		vx_int32             srcMinValue[],
+		vx_int32             srcMaxValue[],
+		vx_uint32            srcWidth,
+		vx_uint32            srcHeight,
+		vx_uint8           * pSrcImage,
+		vx_uint32            srcImageStrideInBytes,
+		vx_coordinates2d_t * pScratchLocList,
+		vx_uint32            bandCount
+	)
+{
+	MinMaxLocBandData data;
+	HafCpu_MinMaxMerge_DATA_DATA(&data.minValue, &data.maxValue, numDataPartitions, srcMinValue, srcMaxValue);
+	*pDstMinValue = data.minValue;
+	*pDstMaxValue = data.maxValue;
+	data.isS16 = isS16;
+	data.countMin = pMinLocCount ? vx_true_e : vx_false_e;
+	data.countMax = pMaxLocCount ? vx_true_e : vx_false_e;
+	data.srcWidth = srcWidth;
+	data.srcHeight = srcHeight;
+	data.pSrcImage = pSrcImage;
+	data.srcImageStrideInBytes = srcImageStrideInBytes;
+	data.capacityOfMinLocList = minLocList ? capacityOfMinLocList : 0;
+	data.capacityOfMaxLocList = maxLocList ? capacityOfMaxLocList : 0;
+	bandCount = max(1u, min(bandCount, min(srcHeight, (vx_uint32)AGO_MAX_CPU_THREADS)));
+	for (vx_uint32 band = 0; band < bandCount; band++) {
+		data.minLocList[band] = !minLocList ? nullptr : (band ? pScratchLocList : minLocList);
+		pScratchLocList += band ? data.capacityOfMinLocList : 0;
+		data.maxLocList[band] = !maxLocList ? nullptr : (band ? pScratchLocList : maxLocList);
+		pScratchLocList += band ? data.capacityOfMaxLocList : 0;
+	}
+	HafCpu_ParallelFor(bandCount, MinMaxLoc_Band, &data);
+	if (pMinLocCount)
+		MinMaxLoc_MergeBands(pMinLocCount, data.capacityOfMinLocList, minLocList, bandCount, data.minLocCount, data.minLocList);
+	if (pMaxLocCount)
+		MinMaxLoc_MergeBands(pMaxLocCount, data.capacityOfMaxLocList, maxLocList, bandCount, data.maxLocCount, data.maxLocList);
 	return AGO_SUCCESS;
 }
 
+int HafCpu_MinMaxLoc_DATA_U8DATA_Parallel
+	(
+		vx_uint32          * pMinLocCount,
+		vx_uint32          * pMaxLocCount,
+		vx_uint32            capacityOfMinLocList,
+		vx_coordinates2d_t   minLocList[],
+		vx_uint32            capacityOfMaxLocList,
+		vx_coordinates2d_t   maxLocList[],
+		vx_int32           * pDstMinValue,
+		vx_int32           * pDstMaxValue,
+		vx_uint32            numDataPartitions,
+		vx_int32             srcMinValue[],
+		vx_int32             srcMaxValue[],
+		vx_uint32            srcWidth,
+		vx_uint32            srcHeight,
+		vx_uint8           * pSrcImage,
+		vx_uint32            srcImageStrideInBytes,
+		vx_coordinates2d_t * pScratchLocList,
+		vx_uint32            bandCount
+	)
+{
+	return MinMaxLoc_Parallel(vx_false_e, pMinLocCount, pMaxLocCount, capacityOfMinLocList, minLocList, capacityOfMaxLocList, maxLocList,
+		pDstMinValue, pDstMaxValue, numDataPartitions, srcMinValue, srcMaxValue, srcWidth, srcHeight, pSrcImage, srcImageStrideInBytes,
+		pScratchLocList, bandCount);
+}
+
+int HafCpu_MinMaxLoc_DATA_S16DATA_Parallel
+	(
+		vx_uint32          * pMinLocCount,
+		vx_uint32          * pMaxLocCount,
+		vx_uint32            capacityOfMinLocList,
+		vx_coordinates2d_t   minLocList[],
+		vx_uint32            capacityOfMaxLocList,
+		vx_coordinates2d_t   maxLocList[],
+		vx_int32           * pDstMinValue,
+		vx_int32           * pDstMaxValue,
+		vx_uint32            numDataPartitions,
+		vx_int32             srcMinValue[],
+		vx_int32             srcMaxValue[],
+		vx_uint32            srcWidth,
+		vx_uint32            srcHeight,
+		vx_int16           * pSrcImage,
+		vx_uint32            srcImageStrideInBytes,
+		vx_coordinates2d_t * pScratchLocList,
+		vx_uint32            bandCount
+	)
+{
+	return MinMaxLoc_Parallel(vx_true_e, pMinLocCount, pMaxLocCount, capacityOfMinLocList, minLocList, capacityOfMaxLocList, maxLocList,
+		pDstMinValue, pDstMaxValue, numDataPartitions, srcMinValue, srcMaxValue, srcWidth, srcHeight, (vx_uint8 *)pSrcImage, srcImageStrideInBytes,
+		pScratchLocList, bandCount);
+}
+
 float HafCpu_FastAtan2_rad
 (
 	vx_int16	  Gx,
@@ -592,6 +592,44 @@ int HafCpu_CannySuppThreshold_U8XY_U16_3x3
 	return AGO_SUCCESS;
 }
 
+int HafCpu_CannySuppThreshold_U8_U16_3x3
+	(
+		vx_uint32              dstWidth,
+		vx_uint32              dstHeight,
+		vx_uint8             * pDst,
+		vx_uint32              dstStrideInBytes,
+		vx_uint16            * pSrc,
+		vx_uint32              srcStrideInBytes,
+		vx_uint16               hyst_lower,
+		vx_uint16               hyst_upper
+	)
+{
+	// same as HafCpu_CannySuppThreshold_U8XY_U16_3x3, without the stack of strong edges
+	vx_uint32 sstride = srcStrideInBytes>>1;
+	for (unsigned int y = 1; y < dstHeight - 1; y++)
+	{
+		vx_uint8* pOut = pDst + y*dstStrideInBytes;
+		vx_uint16 *pLocSrc = pSrc + y * sstride + 1;	// we are processing from 2nd row
+		for (unsigned int x = 1; x < dstWidth - 1; x++, pLocSrc++)
+		{
+			vx_int32 edge;
+			// get the Mag and angle
+			int mag = (pLocSrc[0] >> 2);
+			int ang = pLocSrc[0] & 3;
+			int offset0 = n_offset[ang][0][1] * sstride + n_offset[ang][0][0];
+			int offset1 = n_offset[ang][1][1] * sstride + n_offset[ang][1][0];
+			edge = ((mag >(pLocSrc[offset0] >> 2)) && (mag >(pLocSrc[offset1] >> 2))) ? mag : 0;
+			if (edge > hyst_upper)
+				pOut[x] = (vx_int8)255;
+			else if (edge <= hyst_lower)
+				pOut[x] = 0;
+			else
+				pOut[x] = 127;
+		}
+	}
+	return AGO_SUCCESS;
+}
+
 int HafCpu_CannyEdgeTrace_U8_U8XY
 	(
 		vx_uint32              dstWidth,
@@ -640,6 +678,176 @@ int HafCpu_CannyEdgeTrace_U8_U8XY
 	return AGO_SUCCESS;
 }
 
+// Band-parallel hysteresis: the image is split into bands of rows and each band traces the weak edges (127)
+// connected to strong edges (255) within its own rows, using the part of the xyStack scratch (dstWidth * dstHeight
+// entries) that matches its pixels (a pixel is pushed only when it turns strong, so a band never needs more
+// entries than it has pixels).
+// Edges that cross band seams are then resolved in rounds: even and odd bands take turns so that a band
+// reads the rows next to it only while their bands are idle, seeding its first and last rows from strong
+// pixels across the seams and tracing again, until a round changes nothing.
+typedef struct {
+	vx_uint32              dstWidth;
+	vx_uint32              dstHeight;
+	vx_uint8             * pDstImage;
+	vx_uint32              dstImageStrideInBytes;
+	ago_coord2d_ushort_t * xyStack;
+	vx_uint32              parity;
+	bool                   bandChanged[AGO_MAX_CPU_THREADS];
+} CannyEdgeTraceBandData;
+
+static inline void CannyEdgeTrace_BandRows(CannyEdgeTraceBandData * data, vx_uint32 band, vx_uint32 bandCount, vx_int32 * rowStart, vx_int32 * rowEnd)
+{
+	*rowStart = (vx_int32)(data->dstHeight * band / bandCount);
+	*rowEnd = (vx_int32)(data->dstHeight * (band + 1) / bandCount);
+}
+
+// trace from the pixels on stack and pop them all: only pixels in rows [rowStart, rowEnd) are visited
+static void CannyEdgeTrace_TraceRows(CannyEdgeTraceBandData * data, ago_coord2d_ushort_t * xyStack, ago_coord2d_ushort_t * pxyStack, vx_int32 rowStart, vx_int32 rowEnd)
+{
+	vx_int32 width = (vx_int32)data->dstWidth;
+	vx_int32 stride = (vx_int32)data->dstImageStrideInBytes;
+	vx_int32 offsets[8];
+	for (int i = 0; i < 8; i++) {
+		offsets[i] = dir_offsets[i].y * stride + dir_offsets[i].x;
+	}
+	while (pxyStack != xyStack) {
+		pxyStack--;
+		vx_int32 x = pxyStack->x;
+		vx_int32 y = pxyStack->y;
+		vx_uint8 * pSrc = data->pDstImage + y * stride + x;
+		// look at all the neighbors for weak edge value: check the bounds only at the band edges
+		if (x > 0 && x < width - 1 && y > rowStart && y < rowEnd - 1) {
+			for (int i = 0; i < 8; i++) {
+				if (pSrc[offsets[i]] == 127) {
+					pSrc[offsets[i]] = 255;
+					*((unsigned *)pxyStack) = ((y + dir_offsets[i].y) << 16) | (x + dir_offsets[i].x);
+					pxyStack++;
+				}
+			}
+		}
+		else {
+			for (int i = 0; i < 8; i++) {
+				vx_int32 x1 = x + dir_offsets[i].x;
+				vx_int32 y1 = y + dir_offsets[i].y;
+				if (x1 >= 0 && x1 < width && y1 >= rowStart && y1 < rowEnd && pSrc[offsets[i]] == 127) {
+					pSrc[offsets[i]] = 255;
+					*((unsigned *)pxyStack) = (y1 << 16) | x1;
+					pxyStack++;
+				}
+			}
+		}
+	}
+}
+
+static void CannyEdgeTrace_TraceBand(vx_uint32 band, vx_uint32 bandCount, void * arg)
+{
+	CannyEdgeTraceBandData * data = (CannyEdgeTraceBandData *)arg;
+	vx_int32 rowStart, rowEnd;
+	CannyEdgeTrace_BandRows(data, band, bandCount, &rowStart, &rowEnd);
+	// push all strong edge pixels of the band and trace from them
+	ago_coord2d_ushort_t * xyStack = data->xyStack + rowStart * data->dstWidth;
+	ago_coord2d_ushort_t * pxyStack = xyStack;
+	const __m128i mm255 = _mm_set1_epi8((char)255);
+	for (vx_int32 y = rowStart; y < rowEnd; y++) {
+		vx_uint8 * pDst = data->pDstImage + y * data->dstImageStrideInBytes;
+		for (vx_uint32 x = 0; x < data->dstWidth; x += 16) {
+			vx_uint32 count = min(data->dstWidth - x, 16u);
+			int mask = _mm_movemask_epi8(_mm_cmpeq_epi8(_mm_loadu_si128((__m128i *)&pDst[x]), mm255));
+			for (vx_uint32 i = 0; mask && i < count; i++, mask >>= 1) {
+				if (mask & 1) {
+					pxyStack->x = (vx_uint16)(x + i);
+					pxyStack->y = (vx_uint16)y;
+					pxyStack++;
+				}
+			}
+		}
+	}
+	CannyEdgeTrace_TraceRows(data, xyStack, pxyStack, rowStart, rowEnd);
+}
+
+// turn weak edge pixels of a row into strong edges when they touch a strong edge pixel of the adjacent row
+static ago_coord2d_ushort_t * CannyEdgeTrace_SeedRow(CannyEdgeTraceBandData * data, ago_coord2d_ushort_t * pxyStack, vx_int32 y, vx_int32 yAdjacent)
+{
+	vx_uint8 * pDst = data->pDstImage + y * data->dstImageStrideInBytes;
+	vx_uint8 * pAdj = data->pDstImage + yAdjacent * data->dstImageStrideInBytes;
+	vx_int32 width = (vx_int32)data->dstWidth;
+	for (vx_int32 x = 0; x < width; x++) {
+		if (pDst[x] == 127 && ((x > 0 && pAdj[x - 1] == 255) || pAdj[x] == 255 || (x < width - 1 && pAdj[x + 1] == 255))) {
+			pDst[x] = 255;
+			pxyStack->x = (vx_uint16)x;
+			pxyStack->y = (vx_uint16)y;
+			pxyStack++;
+		}
+	}
+	return pxyStack;
+}
+
+static void CannyEdgeTrace_SeamBand(vx_uint32 band, vx_uint32 bandCount, void * arg)
+{
+	CannyEdgeTraceBandData * data = (CannyEdgeTraceBandData *)arg;
+	if ((band & 1) != data->parity)
+		return;
+	vx_int32 rowStart, rowEnd;
+	CannyEdgeTrace_BandRows(data, band, bandCount, &rowStart, &rowEnd);
+	ago_coord2d_ushort_t * xyStack = data->xyStack + rowStart * data->dstWidth;
+	ago_coord2d_ushort_t * pxyStack = xyStack;
+	if (rowStart > 0)
+		pxyStack = CannyEdgeTrace_SeedRow(data, pxyStack, rowStart, rowStart - 1);
+	if (rowEnd < (vx_int32)data->dstHeight)
+		pxyStack = CannyEdgeTrace_SeedRow(data, pxyStack, rowEnd - 1, rowEnd);
+	data->bandChanged[band] = data->bandChanged[band] || (pxyStack != xyStack);
+	CannyEdgeTrace_TraceRows(data, xyStack, pxyStack, rowStart, rowEnd);
+}
+
+static void CannyEdgeTrace_ClearBand(vx_uint32 band, vx_uint32 bandCount, void * arg)
+{
+	// convert all remaining weak edge pixels (127) to 0
+	CannyEdgeTraceBandData * data = (CannyEdgeTraceBandData *)arg;
+	vx_int32 rowStart, rowEnd;
+	CannyEdgeTrace_BandRows(data, band, bandCount, &rowStart, &rowEnd);
+	const __m128i mm127 = _mm_set1_epi8((char)127);
+	vx_uint32 alignedWidth = data->dstWidth & ~15;
+	for (vx_int32 y = rowStart; y < rowEnd; y++) {
+		vx_uint8 * pDst = data->pDstImage + y * data->dstImageStrideInBytes;
+		vx_uint32 x = 0;
+		for (; x < alignedWidth; x += 16) {
+			__m128i pixels = _mm_loadu_si128((__m128i *)&pDst[x]);
+			pixels = _mm_andnot_si128(_mm_cmpeq_epi8(pixels, mm127), pixels);
+			_mm_storeu_si128((__m128i *)&pDst[x], pixels);
+		}
+		for (; x < data->dstWidth; x++) {
+			if (pDst[x] == 127) pDst[x] = 0;
+		}
+	}
+}
+
+int HafCpu_CannyEdgeTrace_U8_U8
+	(
+		vx_uint32              dstWidth,
+		vx_uint32              dstHeight,
+		vx_uint8             * pDstImage,
+		vx_uint32              dstImageStrideInBytes,
+		ago_coord2d_ushort_t   xyStack[],
+		vx_uint32              bandCount
+	)
+{
+	CannyEdgeTraceBandData data = { dstWidth, dstHeight, pDstImage, dstImageStrideInBytes, xyStack, 0, { false } };
+	bandCount = max(1u, min(bandCount, min(dstHeight, (vx_uint32)AGO_MAX_CPU_THREADS)));
+	HafCpu_ParallelFor(bandCount, CannyEdgeTrace_TraceBand, &data);
+	for (bool changed = (bandCount > 1); changed;) {
+		for (data.parity = 0; data.parity < 2; data.parity++) {
+			HafCpu_ParallelFor(bandCount, CannyEdgeTrace_SeamBand, &data);
+		}
+		changed = false;
+		for (vx_uint32 band = 0; band < bandCount; band++) {
+			changed = changed || data.bandChanged[band];
+			data.bandChanged[band] = false;
+		}
+	}
+	HafCpu_ParallelFor(bandCount, CannyEdgeTrace_ClearBand, &data);
+	return AGO_SUCCESS;
+}
+
 int HafCpu_CannySobel_U16_U8_3x3_L2NORM
 (
 	vx_uint32     dstWidth,
@@ -411,24 +411,27 @@ static inline bool checkForCornerAndGetStrength_SSE(unsigned char pixel, __m128i
 	return false;
 }
 
-int HafCpu_FastCorners_XY_U8_NoSupression
+// Detect corners in rows [rowStart, rowEnd) without non-max supression: corners are appended to dstCorner
+// at cornerCount onwards, or only marked in pCornerMap (srcWidth bytes per row) and counted when it is given
+static vx_uint32 FastCorners_DetectRows_NoSupression
 	(
 		vx_uint32       capacityOfDstCorner,
 		vx_keypoint_t   dstCorner[],
-		vx_uint32     * pDstCornerCount,
+		vx_uint32       cornerCount,
+		vx_uint8      * pCornerMap,
 		vx_uint32       srcWidth,
-		vx_uint32       srcHeight,
 		vx_uint8      * pSrcImage,
 		vx_uint32       srcImageStrideInBytes,
-		vx_float32      strength_threshold
+		vx_float32      strength_threshold,
+		int             rowStart,
+		int             rowEnd
 	)
 {
 	unsigned char * pLocalSrc;
 	int srcStride = (int)srcImageStrideInBytes;
-	vx_uint32 cornerCount = 0;
 	short t = (short)floorf(strength_threshold);
 	
-	pSrcImage += (srcStride * 3);														// Leave first three rows
+	pSrcImage += (srcStride * rowStart);
 
 	int alignedWidth = (int)srcWidth & ~7;
 	int postfixWidth = (int)srcWidth & 7;
@@ -440,7 +443,7 @@ int HafCpu_FastCorners_XY_U8_NoSupression
 
 	__m128i zeromask = _mm_setzero_si128();
 
-	for (int height = 0; height < (int)(srcHeight - 6); height++)
+	for (int height = rowStart; height < rowEnd; height++)
 	{
 		pLocalSrc = (unsigned char *) pSrcImage;
 		int width = 0;
@@ -538,9 +541,14 @@ int HafCpu_FastCorners_XY_U8_NoSupression
 
 						if (isCorner_SSE(M128I(row).m128i_u8[3], boundary, thresh))
 						{
-							if (cornerCount < capacityOfDstCorner)
+							if (pCornerMap)
+							{
+								pCornerMap[height * srcWidth + width + i] = 1;
+								cornerCount++;
+							}
+							else if (cornerCount < capacityOfDstCorner)
 							{
-								dstCorner[cornerCount].y = height + 3;
+								dstCorner[cornerCount].y = height;
 								dstCorner[cornerCount].x = width + i;
 								dstCorner[cornerCount].strength = strength_threshold;			// Undefined as per the 1.0.1 spec
 								dstCorner[cornerCount].scale = 0;
@@ -573,9 +581,14 @@ int HafCpu_FastCorners_XY_U8_NoSupression
 			generateMasks_C(pLocalSrc, srcStride, neighbor_offset, t, masks);
 			if (isCorner(masks))
 			{
-				if (cornerCount < capacityOfDstCorner)
+				if (pCornerMap)
 				{
-					dstCorner[cornerCount].y = height + 3;
+					pCornerMap[height * srcWidth + width] = 1;
+					cornerCount++;
+				}
+				else if (cornerCount < capacityOfDstCorner)
+				{
+					dstCorner[cornerCount].y = height;
 					dstCorner[cornerCount].x = width;
 					dstCorner[cornerCount].strength = strength_threshold;			// Undefined as per the 1.0.1 spec
 					dstCorner[cornerCount].scale = 0;
@@ -592,29 +605,27 @@ int HafCpu_FastCorners_XY_U8_NoSupression
 		pSrcImage += srcStride;
 	}
 
-	*pDstCornerCount = cornerCount;
-	return AGO_SUCCESS;
+	return cornerCount;
 }
 
-int HafCpu_FastCorners_XY_U8_Supression
+// Compute corner strengths of rows [rowStart, rowEnd) into pScratch (srcWidth bytes per row): the caller
+// clears pScratch, which must stay zero at the three pixel image border for the non-max supression
+static void FastCorners_DetectRows_Supression
 	(
-		vx_uint32       capacityOfDstCorner,
-		vx_keypoint_t   dstCorner[],
-		vx_uint32     * pDstCornerCount,
 		vx_uint32       srcWidth,
-		vx_uint32       srcHeight,
 		vx_uint8      * pSrcImage,
 		vx_uint32       srcImageStrideInBytes,
 		vx_float32      strength_threshold,
-		vx_uint8	  * pScratch
+		vx_uint8	  * pScratch,
+		int             rowStart,
+		int             rowEnd
 	)
 {
 	unsigned char * pLocalSrc;
 	int srcStride = (int)srcImageStrideInBytes;
-	vx_uint32 cornerCount = 0;
 	short t = (short)floorf(strength_threshold);
 
-	pSrcImage += (srcStride * 3) + 3;														// Leave first three rows and start from the third pixel
+	pSrcImage += (srcStride * rowStart) + 3;												// Start from the third pixel
 
 	int alignedWidth = (int)(srcWidth - 6) & ~7;
 	int postfixWidth = (int)(srcWidth - 6) & 7;
@@ -624,9 +635,7 @@ int HafCpu_FastCorners_XY_U8_Supression
 	if (postfixWidth)
 		generateOffset(srcStride, neighbor_offset);
 
-	memset(pScratch, 0, sizeof(vx_uint8) * srcWidth * srcHeight);
-
-	for (int height = 0; height < (int)(srcHeight - 6); height++)
+	for (int height = rowStart; height < rowEnd; height++)
 	{
 		pLocalSrc = (unsigned char *)pSrcImage;
 		int width = 3;
@@ -724,7 +733,7 @@ int HafCpu_FastCorners_XY_U8_Supression
 
 						short strength = 0;
 						if (checkForCornerAndGetStrength_SSE(M128I(row).m128i_u8[3], boundary, t, &strength))
-							pScratch[(height + 3) * srcWidth + width + i] = (vx_uint8)strength;
+							pScratch[height * srcWidth + width + i] = (vx_uint8)strength;
 					}
 					maskSkip >>= 2;
 					rowMinus3 = _mm_srli_si128(rowMinus3, 1);
@@ -745,18 +754,30 @@ int HafCpu_FastCorners_XY_U8_Supression
 		{
 			short strength = 0;
 			if (checkForCornerAndGetStrength(pLocalSrc, neighbor_offset, t, &strength))
-				pScratch[(height + 3) * srcWidth + width] = (vx_uint8)strength;
+				pScratch[height * srcWidth + width] = (vx_uint8)strength;
 
 			width++;
 			pLocalSrc++;
 		}
 		pSrcImage += srcStride;
 	}
+}
 
-	// Non-max supression
-	pScratch += (3 * srcWidth + 3);
-	cornerCount = 0;
-	for (int height = 0; height < int(srcHeight - 6); height++)
+// Non-max supression of corner strengths in rows [rowStart, rowEnd): survivors are appended to dstCorner
+// at cornerCount onwards while there is capacity and counted beyond it
+static vx_uint32 FastCorners_NonMaxRows
+	(
+		vx_uint32       capacityOfDstCorner,
+		vx_keypoint_t   dstCorner[],
+		vx_uint32       cornerCount,
+		vx_uint32       srcWidth,
+		vx_uint8	  * pScratch,
+		int             rowStart,
+		int             rowEnd
+	)
+{
+	pScratch += (rowStart * srcWidth + 3);
+	for (int height = rowStart; height < rowEnd; height++)
 	{
 		for (int width = 0; width < int(srcWidth - 6); width++)
 		{
@@ -770,7 +791,7 @@ int HafCpu_FastCorners_XY_U8_Supression
 				if (cornerCount < capacityOfDstCorner)
 				{
 					dstCorner[cornerCount].x = (vx_int32)(width + 3);
-					dstCorner[cornerCount].y = (vx_int32)(height + 3);
+					dstCorner[cornerCount].y = (vx_int32)height;
 					dstCorner[cornerCount].strength = (vx_float32)cand;
 					dstCorner[cornerCount].scale = 0;
 					dstCorner[cornerCount].orientation = 0;
@@ -784,10 +805,212 @@ int HafCpu_FastCorners_XY_U8_Supression
 		}
 		pScratch += 6;
 	}
-	*pDstCornerCount = cornerCount;
+	return cornerCount;
+}
+
+// Emit the corners marked in pCornerMap for rows [rowStart, rowEnd): corners are appended to dstCorner
+// at cornerCount onwards until the capacity is reached
+static vx_uint32 FastCorners_EmitRows
+	(
+		vx_uint32       capacityOfDstCorner,
+		vx_keypoint_t   dstCorner[],
+		vx_uint32       cornerCount,
+		vx_uint8      * pCornerMap,
+		vx_uint32       srcWidth,
+		vx_float32      strength_threshold,
+		int             rowStart,
+		int             rowEnd
+	)
+{
+	__m128i zeromask = _mm_setzero_si128();
+	for (int height = rowStart; height < rowEnd; height++)
+	{
+		vx_uint8 * pLocalMap = pCornerMap + height * srcWidth;
+		for (int width = 0; width < (int)srcWidth; width += 16)
+		{
+			int count = min((int)srcWidth - width, 16);
+			if (count == 16 && _mm_movemask_epi8(_mm_cmpeq_epi8(_mm_loadu_si128((__m128i *)(pLocalMap + width)), zeromask)) == 0xFFFF)
+				continue;																// No corners in the sixteen pixels
+			for (int i = 0; i < count; i++)
+			{
+				if (pLocalMap[width + i])
+				{
+					if (cornerCount >= capacityOfDstCorner)
+						return cornerCount;
+					dstCorner[cornerCount].y = height;
+					dstCorner[cornerCount].x = width + i;
+					dstCorner[cornerCount].strength = strength_threshold;			// Undefined as per the 1.0.1 spec
+					dstCorner[cornerCount].scale = 0;
+					dstCorner[cornerCount].orientation = 0;
+					dstCorner[cornerCount].error = 0;
+					dstCorner[cornerCount++].tracking_status = 1;
+				}
+			}
+		}
+	}
+	return cornerCount;
+}
+
+int HafCpu_FastCorners_XY_U8_NoSupression
+	(
+		vx_uint32       capacityOfDstCorner,
+		vx_keypoint_t   dstCorner[],
+		vx_uint32     * pDstCornerCount,
+		vx_uint32       srcWidth,
+		vx_uint32       srcHeight,
+		vx_uint8      * pSrcImage,
+		vx_uint32       srcImageStrideInBytes,
+		vx_float32      strength_threshold
+	)
+{
+	// Leave first three and last three rows
+	*pDstCornerCount = FastCorners_DetectRows_NoSupression(capacityOfDstCorner, dstCorner, 0, nullptr, srcWidth,
+		pSrcImage, srcImageStrideInBytes, strength_threshold, 3, (int)srcHeight - 3);
 	return AGO_SUCCESS;
 }
 
+int HafCpu_FastCorners_XY_U8_Supression
+	(
+		vx_uint32       capacityOfDstCorner,
+		vx_keypoint_t   dstCorner[],
+		vx_uint32     * pDstCornerCount,
+		vx_uint32       srcWidth,
+		vx_uint32       srcHeight,
+		vx_uint8      * pSrcImage,
+		vx_uint32       srcImageStrideInBytes,
+		vx_float32      strength_threshold,
+		vx_uint8	  * pScratch
+	)
+{
+	memset(pScratch, 0, sizeof(vx_uint8) * srcWidth * srcHeight);
+	FastCorners_DetectRows_Supression(srcWidth, pSrcImage, srcImageStrideInBytes, strength_threshold, pScratch, 3, (int)srcHeight - 3);
+	*pDstCornerCount = FastCorners_NonMaxRows(capacityOfDstCorner, dstCorner, 0, srcWidth, pScratch, 3, (int)srcHeight - 3);
+	return AGO_SUCCESS;
+}
+
+// Band-parallel fast corners: each band of rows runs the segment test into its rows of the scratch map
+// (strengths with supression, corner marks without) reading the three pixel halo of the source image
+// across band seams; the band corner counts are then turned into output offsets with a prefix sum and
+// every band writes its corners at its offset, giving the same order as the serial raster scan
+typedef struct {
+	vx_uint32       capacityOfDstCorner;
+	vx_keypoint_t * dstCorner;
+	vx_uint32       srcWidth;
+	vx_uint32       srcHeight;
+	vx_uint8      * pSrcImage;
+	vx_uint32       srcImageStrideInBytes;
+	vx_float32      strength_threshold;
+	vx_uint8      * pScratch;
+	bool            supression;
+	vx_uint32       bandCornerCount[AGO_MAX_CPU_THREADS];					// corners in each band and then the output offset of each band
+} FastCornersBandData;
+
+static inline void FastCorners_BandRows(FastCornersBandData * data, vx_uint32 band, vx_uint32 bandCount, int * rowStart, int * rowEnd)
+{
+	vx_uint32 rowCount = data->srcHeight - 6;
+	*rowStart = 3 + (int)(rowCount * band / bandCount);
+	*rowEnd = 3 + (int)(rowCount * (band + 1) / bandCount);
+}
+
+static void FastCorners_DetectBand(vx_uint32 band, vx_uint32 bandCount, void * arg)
+{
+	FastCornersBandData * data = (FastCornersBandData *)arg;
+	int rowStart, rowEnd;
+	FastCorners_BandRows(data, band, bandCount, &rowStart, &rowEnd);
+	// clear the band rows of the scratch map: the first and last bands also clear the three border rows
+	int clearStart = band ? rowStart : 0;
+	int clearEnd = (band == bandCount - 1) ? (int)data->srcHeight : rowEnd;
+	memset(data->pScratch + clearStart * data->srcWidth, 0, sizeof(vx_uint8) * (clearEnd - clearStart) * data->srcWidth);
+	if (data->supression) {
+		FastCorners_DetectRows_Supression(data->srcWidth, data->pSrcImage, data->srcImageStrideInBytes, data->strength_threshold, data->pScratch, rowStart, rowEnd);
+	}
+	else {
+		data->bandCornerCount[band] = FastCorners_DetectRows_NoSupression(0, nullptr, 0, data->pScratch, data->srcWidth,
+			data->pSrcImage, data->srcImageStrideInBytes, data->strength_threshold, rowStart, rowEnd);
+	}
+}
+
+static void FastCorners_CountBand(vx_uint32 band, vx_uint32 bandCount, void * arg)
+{
+	// non-max supression reads strengths of the neighbor bands, so it runs only after all bands are detected
+	FastCornersBandData * data = (FastCornersBandData *)arg;
+	int rowStart, rowEnd;
+	FastCorners_BandRows(data, band, bandCount, &rowStart, &rowEnd);
+	data->bandCornerCount[band] = FastCorners_NonMaxRows(0, nullptr, 0, data->srcWidth, data->pScratch, rowStart, rowEnd);
+}
+
+static void FastCorners_EmitBand(vx_uint32 band, vx_uint32 bandCount, void * arg)
+{
+	FastCornersBandData * data = (FastCornersBandData *)arg;
+	vx_uint32 offset = data->bandCornerCount[band];
+	if (offset < data->capacityOfDstCorner) {
+		int rowStart, rowEnd;
+		FastCorners_BandRows(data, band, bandCount, &rowStart, &rowEnd);
+		if (data->supression) {
+			FastCorners_NonMaxRows(data->capacityOfDstCorner, data->dstCorner, offset, data->srcWidth, data->pScratch, rowStart, rowEnd);
+		}
+		else {
+			FastCorners_EmitRows(data->capacityOfDstCorner, data->dstCorner, offset, data->pScratch, data->srcWidth, data->strength_threshold, rowStart, rowEnd);
+		}
+	}
+}
+
+static vx_uint32 FastCorners_Parallel(FastCornersBandData * data, vx_uint32 bandCount)
+{
+	if (data->srcHeight <= 6)
+		return 0;
+	bandCount = max(1u, min(bandCount, min(data->srcHeight - 6, (vx_uint32)AGO_MAX_CPU_THREADS)));
+	HafCpu_ParallelFor(bandCount, FastCorners_DetectBand, data);
+	if (data->supression) {
+		HafCpu_ParallelFor(bandCount, FastCorners_CountBand, data);
+	}
+	vx_uint32 cornerCount = 0;
+	for (vx_uint32 band = 0; band < bandCount; band++) {
+		vx_uint32 count = data->bandCornerCount[band];
+		data->bandCornerCount[band] = cornerCount;
+		cornerCount += count;
+	}
+	HafCpu_ParallelFor(bandCount, FastCorners_EmitBand, data);
+	return cornerCount;
+}
+
+int HafCpu_FastCorners_XY_U8_NoSupression_Parallel
+	(
+		vx_uint32       capacityOfDstCorner,
+		vx_keypoint_t   dstCorner[],
+		vx_uint32     * pDstCornerCount,
+		vx_uint32       srcWidth,
+		vx_uint32       srcHeight,
+		vx_uint8      * pSrcImage,
+		vx_uint32       srcImageStrideInBytes,
+		vx_float32      strength_threshold,
+		vx_uint8	  * pScratch,
+		vx_uint32       bandCount
+	)
+{
+	FastCornersBandData data = { capacityOfDstCorner, dstCorner, srcWidth, srcHeight, pSrcImage, srcImageStrideInBytes, strength_threshold, pScratch, false, { 0 } };
+	*pDstCornerCount = FastCorners_Parallel(&data, bandCount);
+	return AGO_SUCCESS;
+}
+
+int HafCpu_FastCorners_XY_U8_Supression_Parallel
+	(
+		vx_uint32       capacityOfDstCorner,
+		vx_keypoint_t   dstCorner[],
+		vx_uint32     * pDstCornerCount,
+		vx_uint32       srcWidth,
+		vx_uint32       srcHeight,
+		vx_uint8      * pSrcImage,
+		vx_uint32       srcImageStrideInBytes,
+		vx_float32      strength_threshold,
+		vx_uint8	  * pScratch,
+		vx_uint32       bandCount
+	)
+{
+	FastCornersBandData data = { capacityOfDstCorner, dstCorner, srcWidth, srcHeight, pSrcImage, srcImageStrideInBytes, strength_threshold, pScratch, true, { 0 } };
+	*pDstCornerCount = FastCorners_Parallel(&data, bandCount);
+	return AGO_SUCCESS;
+}
 
 int HafCpu_FastCornerMerge_XY_XY
 	(
@@ -799,28 +1022,15 @@ int HafCpu_FastCornerMerge_XY_XY
 		vx_uint32       numSrcCorners[]
 	)
 {
-	int dstCount = 0;
-	int srcCount;
-	vx_keypoint_t * srcList;
-
-	for (int i = 0; i < (int)numSrcCornerBuffers; i++)
+	// copy the source lists back to back at the running sum of their counts, up to the capacity
+	vx_uint32 dstCount = 0;
+	for (vx_uint32 i = 0; i < numSrcCornerBuffers; i++)
 	{
-		srcCount = numSrcCorners[i];
-		srcList = pSrcCorners[i];
-
-		while (srcCount)
-		{
-			*dstCorner++ = *srcList++;
-			dstCount++;
-			srcCount--;
-			if (dstCount >(int) capacityOfDstCorner)
-			{
-				*pDstCornerCount = (vx_uint32)(dstCount - 1);
-				return AGO_SUCCESS;
-			}
-		}
+		if (dstCount < capacityOfDstCorner)
+			memcpy(dstCorner + dstCount, pSrcCorners[i], min(numSrcCorners[i], capacityOfDstCorner - dstCount) * sizeof(vx_keypoint_t));
+		dstCount += numSrcCorners[i];
 	}
 
-	*pDstCornerCount = (vx_uint32)(dstCount - 1);
+	*pDstCornerCount = dstCount;
 	return AGO_SUCCESS;
-}
\ No newline at end of file
+}
@@ -2673,6 +2673,20 @@ int HafCpu_SobelMagnitude_S16_U8_3x3
 	return AGO_SUCCESS;
 }
 
+// divide convolution sums by scale (1 << shift) with truncation towards zero
+static inline int Convolve_Scale_C(int sum, int shift)
+{
+	return (sum < 0) ? -((-sum) >> shift) : (sum >> shift);
+}
+
+static inline __m128i Convolve_Scale_SSE(__m128i sum, __m128i bias, int shift)
+{
+	// add (scale-1) to negative sums before shift
+	__m128i sign = _mm_srai_epi32(sum, 31);
+	sum = _mm_add_epi32(sum, _mm_and_si128(sign, bias));
+	return _mm_srai_epi32(sum, shift);
+}
+
 int HafCpu_Convolve_S16_U8_3xN
 	(
 		vx_uint32     dstWidth,
@@ -2693,6 +2707,7 @@ int HafCpu_Convolve_S16_U8_3xN
 
 	__m128i result0, result1, result2, result3, row, mul, temp0, temp1;
 	__m128i zeromask = _mm_setzero_si128();
+	__m128i bias = _mm_set1_epi32((1 << shift) - 1);
 
 	int prefixWidth = intptr_t(pDstImage) & 15;
 	prefixWidth = (prefixWidth == 0) ? 0 : (16 - prefixWidth);
@@ -2721,6 +2736,7 @@ int HafCpu_Convolve_S16_U8_3xN
 					temp += ((int)pLocalSrc[i*srcStride + j] * (int)convMatrix[idx--]);
 				}
 			}
+			temp = Convolve_Scale_C(temp, shift);
 			temp = min(temp, SHRT_MAX);
 			temp = max(temp, SHRT_MIN);
 			*pLocalDst++ = (short)temp;
@@ -2816,10 +2832,10 @@ int HafCpu_Convolve_S16_U8_3xN
 				result0 = _mm_add_epi32(result0, temp0);
 			}
 
-			result0 = _mm_srli_epi32(result0, shift);
-			result1 = _mm_srli_epi32(result1, shift);
-			result2 = _mm_srli_epi32(result2, shift);
-			result3 = _mm_srli_epi32(result3, shift);
+			result0 = Convolve_Scale_SSE(result0, bias, shift);
+			result1 = Convolve_Scale_SSE(result1, bias, shift);
+			result2 = Convolve_Scale_SSE(result2, bias, shift);
+			result3 = Convolve_Scale_SSE(result3, bias, shift);
 
 			row = _mm_packs_epi32(result2, result3);
 			temp0 = _mm_packs_epi32(result0, result1);
@@ -2842,6 +2858,7 @@ int HafCpu_Convolve_S16_U8_3xN
 					temp += ((int)pLocalSrc[i*srcStride + j] * (int)convMatrix[idx--]);
 				}
 			}
+			temp = Convolve_Scale_C(temp, shift);
 			temp = min(temp, SHRT_MAX);
 			temp = max(temp, SHRT_MIN);
 			*pLocalDst++ = (short)temp;
@@ -2874,6 +2891,7 @@ int HafCpu_Convolve_U8_U8_3xN
 
 	__m128i result0, result1, result2, result3, row, mul, temp0, temp1;
 	__m128i zeromask = _mm_setzero_si128();
+	__m128i bias = _mm_set1_epi32((1 << shift) - 1);
 
 	int prefixWidth = intptr_t(pDstImage) & 15;
 	prefixWidth = (prefixWidth == 0) ? 0 : (16 - prefixWidth);
@@ -2901,6 +2919,7 @@ int HafCpu_Convolve_U8_U8_3xN
 					temp += ((int)pLocalSrc[i*srcStride + j] * (int)convMatrix[idx--]);
 				}
 			}
+			temp = Convolve_Scale_C(temp, shift);
 			temp = min(temp, 255);
 			temp = max(temp, 0);
 			*pLocalDst++ = (unsigned char)temp;
@@ -2995,10 +3014,10 @@ int HafCpu_Convolve_U8_U8_3xN
 				result0 = _mm_add_epi32(result0, temp0);
 			}
 
-			result0 = _mm_srli_epi32(result0, shift);
-			result1 = _mm_srli_epi32(result1, shift);
-			result2 = _mm_srli_epi32(result2, shift);
-			result3 = _mm_srli_epi32(result3, shift);
+			result0 = Convolve_Scale_SSE(result0, bias, shift);
+			result1 = Convolve_Scale_SSE(result1, bias, shift);
+			result2 = Convolve_Scale_SSE(result2, bias, shift);
+			result3 = Convolve_Scale_SSE(result3, bias, shift);
 
 			row = _mm_packs_epi32(result2, result3);
 			temp0 = _mm_packs_epi32(result0, result1);
@@ -3021,6 +3040,7 @@ int HafCpu_Convolve_U8_U8_3xN
 					temp += ((int)pLocalSrc[i*srcStride + j] * (int)convMatrix[idx--]);
 				}
 			}
+			temp = Convolve_Scale_C(temp, shift);
 			temp = min(temp, 255);
 			temp = max(temp, 0);
 			*pLocalDst++ = (unsigned char)temp;
@@ -3054,6 +3074,7 @@ int HafCpu_Convolve_S16_U8_5xN
 
 	__m128i result0, result1, result2, result3, row, mul, temp0, temp1;
 	__m128i zeromask = _mm_setzero_si128();
+	__m128i bias = _mm_set1_epi32((1 << shift) - 1);
 
 	int prefixWidth = intptr_t(pDstImage) & 15;
 	prefixWidth = (prefixWidth == 0) ? 0 : (16 - prefixWidth);
@@ -3082,6 +3103,7 @@ int HafCpu_Convolve_S16_U8_5xN
 					temp += ((int)pLocalSrc[i*srcStride + j] * (int)convMatrix[idx--]);
 				}
 			}
+			temp = Convolve_Scale_C(temp, shift);
 			temp = min(temp, SHRT_MAX);
 			temp = max(temp, SHRT_MIN);
 			*pLocalDst++ = (short)temp;
@@ -3128,10 +3150,10 @@ int HafCpu_Convolve_S16_U8_5xN
 				}
 			}
 
-			result0 = _mm_srli_epi32(result0, shift);
-			result1 = _mm_srli_epi32(result1, shift);
-			result2 = _mm_srli_epi32(result2, shift);
-			result3 = _mm_srli_epi32(result3, shift);
+			result0 = Convolve_Scale_SSE(result0, bias, shift);
+			result1 = Convolve_Scale_SSE(result1, bias, shift);
+			result2 = Convolve_Scale_SSE(result2, bias, shift);
+			result3 = Convolve_Scale_SSE(result3, bias, shift);
 
 			row = _mm_packs_epi32(result2, result3);
 			temp0 = _mm_packs_epi32(result0, result1);
@@ -3154,6 +3176,7 @@ int HafCpu_Convolve_S16_U8_5xN
 					temp += ((int)pLocalSrc[i*srcStride + j] * (int)convMatrix[idx--]);
 				}
 			}
+			temp = Convolve_Scale_C(temp, shift);
 			temp = min(temp, SHRT_MAX);
 			temp = max(temp, SHRT_MIN);
 			*pLocalDst++ = (short)temp;
@@ -3186,6 +3209,7 @@ int HafCpu_Convolve_U8_U8_5xN
 
 	__m128i result0, result1, result2, result3, row, mul, temp0, temp1;
 	__m128i zeromask = _mm_setzero_si128();
+	__m128i bias = _mm_set1_epi32((1 << shift) - 1);
 
 	int prefixWidth = intptr_t(pDstImage) & 15;
 	prefixWidth = (prefixWidth == 0) ? 0 : (16 - prefixWidth);
@@ -3213,6 +3237,7 @@ int HafCpu_Convolve_U8_U8_5xN
 					temp += ((int)pLocalSrc[i*srcStride + j] * (int)convMatrix[idx--]);
 				}
 			}
+			temp = Convolve_Scale_C(temp, shift);
 			temp = min(temp, 255);
 			temp = max(temp, 0);
 			*pLocalDst++ = (unsigned char)temp;
@@ -3259,10 +3284,10 @@ int HafCpu_Convolve_U8_U8_5xN
 				}
 			}
 
-			result0 = _mm_srli_epi32(result0, shift);
-			result1 = _mm_srli_epi32(result1, shift);
-			result2 = _mm_srli_epi32(result2, shift);
-			result3 = _mm_srli_epi32(result3, shift);
+			result0 = Convolve_Scale_SSE(result0, bias, shift);
+			result1 = Convolve_Scale_SSE(result1, bias, shift);
+			result2 = Convolve_Scale_SSE(result2, bias, shift);
+			result3 = Convolve_Scale_SSE(result3, bias, shift);
 
 			row = _mm_packs_epi32(result2, result3);
 			temp0 = _mm_packs_epi32(result0, result1);
@@ -3285,6 +3310,7 @@ int HafCpu_Convolve_U8_U8_5xN
 					temp += ((int)pLocalSrc[i*srcStride + j] * (int)convMatrix[idx--]);
 				}
 			}
+			temp = Convolve_Scale_C(temp, shift);
 			temp = min(temp, 255);
 			temp = max(temp, 0);
 			*pLocalDst++ = (unsigned char)temp;
@@ -3318,6 +3344,7 @@ int HafCpu_Convolve_S16_U8_7xN
 
 	__m128i result0, result1, result2, result3, row, mul, temp0, temp1;
 	__m128i zeromask = _mm_setzero_si128();
+	__m128i bias = _mm_set1_epi32((1 << shift) - 1);
 
 	int prefixWidth = intptr_t(pDstImage) & 15;
 	prefixWidth = (prefixWidth == 0) ? 0 : (16 - prefixWidth);
@@ -3343,9 +3370,10 @@ int HafCpu_Convolve_S16_U8_7xN
 			{
 				for (int j = -3; j <= 3; j++)
 				{
-					temp += ((int)pLocalSrc[i*srcStride - j] * (int)convMatrix[idx--]);
+					temp += ((int)pLocalSrc[i*srcStride + j] * (int)convMatrix[idx--]);
 				}
 			}
+			temp = Convolve_Scale_C(temp, shift);
 			temp = min(temp, SHRT_MAX);
 			temp = max(temp, SHRT_MIN);
 			*pLocalDst++ = (short)temp;
@@ -3392,10 +3420,10 @@ int HafCpu_Convolve_S16_U8_7xN
 				}
 			}
 
-			result0 = _mm_srli_epi32(result0, shift);
-			result1 = _mm_srli_epi32(result1, shift);
-			result2 = _mm_srli_epi32(result2, shift);
-			result3 = _mm_srli_epi32(result3, shift);
+			result0 = Convolve_Scale_SSE(result0, bias, shift);
+			result1 = Convolve_Scale_SSE(result1, bias, shift);
+			result2 = Convolve_Scale_SSE(result2, bias, shift);
+			result3 = Convolve_Scale_SSE(result3, bias, shift);
 
 			row = _mm_packs_epi32(result2, result3);
 			temp0 = _mm_packs_epi32(result0, result1);
@@ -3418,6 +3446,7 @@ int HafCpu_Convolve_S16_U8_7xN
 					temp += ((int)pLocalSrc[i*srcStride + j] * (int)convMatrix[idx--]);
 				}
 			}
+			temp = Convolve_Scale_C(temp, shift);
 			temp = min(temp, SHRT_MAX);
 			temp = max(temp, SHRT_MIN);
 			*pLocalDst++ = (short)temp;
@@ -3450,6 +3479,7 @@ int HafCpu_Convolve_U8_U8_7xN
 
 	__m128i result0, result1, result2, result3, row, mul, temp0, temp1;
 	__m128i zeromask = _mm_setzero_si128();
+	__m128i bias = _mm_set1_epi32((1 << shift) - 1);
 
 	int prefixWidth = intptr_t(pDstImage) & 15;
 	prefixWidth = (prefixWidth == 0) ? 0 : (16 - prefixWidth);
@@ -3477,6 +3507,7 @@ int HafCpu_Convolve_U8_U8_7xN
 					temp += ((int)pLocalSrc[i*srcStride + j] * (int)convMatrix[idx--]);
 				}
 			}
+			temp = Convolve_Scale_C(temp, shift);
 			temp = min(temp, 255);
 			temp = max(temp, 0);
 			*pLocalDst++ = (unsigned char)temp;
@@ -3523,10 +3554,10 @@ int HafCpu_Convolve_U8_U8_7xN
 				}
 			}
 
-			result0 = _mm_srli_epi32(result0, shift);
-			result1 = _mm_srli_epi32(result1, shift);
-			result2 = _mm_srli_epi32(result2, shift);
-			result3 = _mm_srli_epi32(result3, shift);
+			result0 = Convolve_Scale_SSE(result0, bias, shift);
+			result1 = Convolve_Scale_SSE(result1, bias, shift);
+			result2 = Convolve_Scale_SSE(result2, bias, shift);
+			result3 = Convolve_Scale_SSE(result3, bias, shift);
 
 			row = _mm_packs_epi32(result2, result3);
 			temp0 = _mm_packs_epi32(result0, result1);
@@ -3549,6 +3580,7 @@ int HafCpu_Convolve_U8_U8_7xN
 					temp += ((int)pLocalSrc[i*srcStride + j] * (int)convMatrix[idx--]);
 				}
 			}
+			temp = Convolve_Scale_C(temp, shift);
 			temp = min(temp, 255);
 			temp = max(temp, 0);
 			*pLocalDst++ = (unsigned char)temp;
@@ -3582,6 +3614,7 @@ int HafCpu_Convolve_S16_U8_9xN
 
 	__m128i result0, result1, result2, result3, row, mul, temp0, temp1;
 	__m128i zeromask = _mm_setzero_si128();
+	__m128i bias = _mm_set1_epi32((1 << shift) - 1);
 
 	int prefixWidth = intptr_t(pDstImage) & 15;
 	prefixWidth = (prefixWidth == 0) ? 0 : (16 - prefixWidth);
@@ -3610,6 +3643,7 @@ int HafCpu_Convolve_S16_U8_9xN
 					temp += ((int)pLocalSrc[i*srcStride + j] * (int)convMatrix[idx--]);
 				}
 			}
+			temp = Convolve_Scale_C(temp, shift);
 			temp = min(temp, SHRT_MAX);
 			temp = max(temp, SHRT_MIN);
 			*pLocalDst++ = (short)temp;
@@ -3656,10 +3690,10 @@ int HafCpu_Convolve_S16_U8_9xN
 				}
 			}
 
-			result0 = _mm_srli_epi32(result0, shift);
-			result1 = _mm_srli_epi32(result1, shift);
-			result2 = _mm_srli_epi32(result2, shift);
-			result3 = _mm_srli_epi32(result3, shift);
+			result0 = Convolve_Scale_SSE(result0, bias, shift);
+			result1 = Convolve_Scale_SSE(result1, bias, shift);
+			result2 = Convolve_Scale_SSE(result2, bias, shift);
+			result3 = Convolve_Scale_SSE(result3, bias, shift);
 
 			row = _mm_packs_epi32(result2, result3);
 			temp0 = _mm_packs_epi32(result0, result1);
@@ -3682,6 +3716,7 @@ int HafCpu_Convolve_S16_U8_9xN
 					temp += ((int)pLocalSrc[i*srcStride + j] * (int)convMatrix[idx--]);
 				}
 			}
+			temp = Convolve_Scale_C(temp, shift);
 			temp = min(temp, SHRT_MAX);
 			temp = max(temp, SHRT_MIN);
 			*pLocalDst++ = (short)temp;
@@ -3714,6 +3749,7 @@ int HafCpu_Convolve_U8_U8_9xN
 
 	__m128i result0, result1, result2, result3, row, mul, temp0, temp1;
 	__m128i zeromask = _mm_setzero_si128();
+	__m128i bias = _mm_set1_epi32((1 << shift) - 1);
 
 	int prefixWidth = intptr_t(pDstImage) & 15;
 	prefixWidth = (prefixWidth == 0) ? 0 : (16 - prefixWidth);
@@ -3741,6 +3777,7 @@ int HafCpu_Convolve_U8_U8_9xN
 					temp += ((int)pLocalSrc[i*srcStride + j] * (int)convMatrix[idx--]);
 				}
 			}
+			temp = Convolve_Scale_C(temp, shift);
 			temp = min(temp, 255);
 			temp = max(temp, 0);
 			*pLocalDst++ = (unsigned char)temp;
@@ -3787,10 +3824,10 @@ int HafCpu_Convolve_U8_U8_9xN
 				}
 			}
 
-			result0 = _mm_srli_epi32(result0, shift);
-			result1 = _mm_srli_epi32(result1, shift);
-			result2 = _mm_srli_epi32(result2, shift);
-			result3 = _mm_srli_epi32(result3, shift);
+			result0 = Convolve_Scale_SSE(result0, bias, shift);
+			result1 = Convolve_Scale_SSE(result1, bias, shift);
+			result2 = Convolve_Scale_SSE(result2, bias, shift);
+			result3 = Convolve_Scale_SSE(result3, bias, shift);
 
 			row = _mm_packs_epi32(result2, result3);
 			temp0 = _mm_packs_epi32(result0, result1);
@@ -3813,6 +3850,7 @@ int HafCpu_Convolve_U8_U8_9xN
 					temp += ((int)pLocalSrc[i*srcStride + j] * (int)convMatrix[idx--]);
 				}
 			}
+			temp = Convolve_Scale_C(temp, shift);
 			temp = min(temp, 255);
 			temp = max(temp, 0);
 			*pLocalDst++ = (unsigned char)temp;
@@ -3826,6 +3864,535 @@ int HafCpu_Convolve_U8_U8_9xN
 	return AGO_SUCCESS;
 }
 
+/* Generic MxN convolution: the coefficients of each kernel row are paired up column-wise and
+   applied with _mm_madd_epi16 on interleaved pixels from adjacent columns, so that every
+   accumulator (4 x 32-bit) collects two taps per multiply. An odd column count is padded
+   with a zero coefficient. The coefficient matrix is stored flipped as in the 3xN..9xN cases.
+*/
+static inline void Convolve_MxN_InitCoeffPairs
+	(
+		__m128i     * coeffPairs,
+		vx_int16    * convMatrix,
+		vx_uint32     convolutionWidth,
+		vx_uint32     convolutionHeight
+	)
+{
+	int numPairs = (int)(convolutionWidth + 1) >> 1;
+	for (int y = 0; y < (int)convolutionHeight; y++)
+	{
+		vx_int16 * pRow = convMatrix + (convolutionHeight - 1 - y) * convolutionWidth;
+		for (int p = 0; p < numPairs; p++)
+		{
+			int x = p << 1;
+			vx_uint16 c0 = (vx_uint16)pRow[convolutionWidth - 1 - x];
+			vx_uint16 c1 = ((x + 1) < (int)convolutionWidth) ? (vx_uint16)pRow[convolutionWidth - 2 - x] : 0;
+			*coeffPairs++ = _mm_set1_epi32((int)(((vx_uint32)c1 << 16) | c0));
+		}
+	}
+}
+
+static inline void Convolve_MxN_Accumulate_SSE
+	(
+		__m128i       result[4],
+		vx_uint8    * pLocalSrc,
+		int           srcStride,
+		__m128i     * coeffPairs,
+		int           convolutionWidth,
+		int           convolutionHeight
+	)
+{
+	__m128i row0, row1, pix0, pix1, temp0, temp1;
+	__m128i zeromask = _mm_setzero_si128();
+	int colLimit = convolutionWidth >> 1;
+	int rowLimit = convolutionHeight >> 1;
+
+	result[0] = _mm_setzero_si128();
+	result[1] = _mm_setzero_si128();
+	result[2] = _mm_setzero_si128();
+	result[3] = _mm_setzero_si128();
+
+	for (int y = -rowLimit; y <= rowLimit; y++)
+	{
+		vx_uint8 * pRow = pLocalSrc + y * srcStride - colLimit;
+		for (int x = 0; x < convolutionWidth; x += 2)
+		{
+			row0 = _mm_loadu_si128((__m128i *)(pRow + x));
+			row1 = ((x + 1) < convolutionWidth) ? _mm_loadu_si128((__m128i *)(pRow + x + 1)) : row0;	// coefficient for the odd column is zero
+			__m128i mul = *coeffPairs++;
+
+			// Lower 8 pixels
+			pix0 = _mm_cvtepu8_epi16(row0);
+			pix1 = _mm_cvtepu8_epi16(row1);
+			temp0 = _mm_unpacklo_epi16(pix0, pix1);
+			temp1 = _mm_unpackhi_epi16(pix0, pix1);
+			result[0] = _mm_add_epi32(result[0], _mm_madd_epi16(temp0, mul));
+			result[1] = _mm_add_epi32(result[1], _mm_madd_epi16(temp1, mul));
+
+			// Upper 8 pixels
+			pix0 = _mm_unpackhi_epi8(row0, zeromask);
+			pix1 = _mm_unpackhi_epi8(row1, zeromask);
+			temp0 = _mm_unpacklo_epi16(pix0, pix1);
+			temp1 = _mm_unpackhi_epi16(pix0, pix1);
+			result[2] = _mm_add_epi32(result[2], _mm_madd_epi16(temp0, mul));
+			result[3] = _mm_add_epi32(result[3], _mm_madd_epi16(temp1, mul));
+		}
+	}
+}
+
+static inline int Convolve_MxN_Pixel_C
+	(
+		vx_uint8    * pLocalSrc,
+		int           srcStride,
+		vx_int16    * convMatrix,
+		int           convolutionWidth,
+		int           convolutionHeight,
+		vx_int32      shift
+	)
+{
+	int colLimit = convolutionWidth >> 1;
+	int rowLimit = convolutionHeight >> 1;
+	int temp = 0;
+	int idx = convolutionWidth * convolutionHeight - 1;
+	for (int i = -rowLimit; i <= rowLimit; i++)
+	{
+		for (int j = -colLimit; j <= colLimit; j++)
+		{
+			temp += ((int)pLocalSrc[i*srcStride + j] * (int)convMatrix[idx--]);
+		}
+	}
+	return Convolve_Scale_C(temp, shift);
+}
+
+int HafCpu_Convolve_U8_U8_MxN
+	(
+		vx_uint32     dstWidth,
+		vx_uint32     dstHeight,
+		vx_uint8    * pDstImage,
+		vx_uint32     dstImageStrideInBytes,
+		vx_uint8    * pSrcImage,
+		vx_uint32     srcImageStrideInBytes,
+		vx_int16    * convMatrix,
+		vx_uint32     convolutionWidth,
+		vx_uint32     convolutionHeight,
+		vx_int32      shift
+	)
+{
+	if (!(convolutionWidth & 1) || !(convolutionHeight & 1) || convolutionWidth > AGO_MAX_CONVOLUTION_DIM || convolutionHeight > AGO_MAX_CONVOLUTION_DIM)
+		return AGO_ERROR_HAFCPU_NOT_IMPLEMENTED;
+
+	__m128i coeffPairs[AGO_MAX_CONVOLUTION_DIM * ((AGO_MAX_CONVOLUTION_DIM + 1) >> 1)];
+	Convolve_MxN_InitCoeffPairs(coeffPairs, convMatrix, convolutionWidth, convolutionHeight);
+
+	__m128i *pLocalDst_xmm;
+	unsigned char *pLocalSrc, *pLocalDst;
+	__m128i result[4], row, temp0;
+	__m128i bias = _mm_set1_epi32((1 << shift) - 1);
+
+	int prefixWidth = intptr_t(pDstImage) & 15;
+	prefixWidth = (prefixWidth == 0) ? 0 : (16 - prefixWidth);
+	prefixWidth = min(prefixWidth, (int)dstWidth);
+	int postfixWidth = ((int)dstWidth - prefixWidth) & 15;					// 16 pixels processed at a time in SSE loop
+	int alignedWidth = (int)dstWidth - prefixWidth - postfixWidth;
+
+	int height = (int)dstHeight;
+	int srcStride = (int)srcImageStrideInBytes;
+
+	while (height)
+	{
+		pLocalSrc = (unsigned char *)pSrcImage;
+		pLocalDst = (unsigned char *)pDstImage;
+
+		for (int w = 0; w < prefixWidth; w++, pLocalSrc++)
+		{
+			int temp = Convolve_MxN_Pixel_C(pLocalSrc, srcStride, convMatrix, (int)convolutionWidth, (int)convolutionHeight, shift);
+			temp = min(temp, 255);
+			temp = max(temp, 0);
+			*pLocalDst++ = (unsigned char)temp;
+		}
+
+		pLocalDst_xmm = (__m128i *) pLocalDst;
+		int width = (int)(alignedWidth >> 4);							// Each loop processess 16 pixels
+		while (width)
+		{
+			Convolve_MxN_Accumulate_SSE(result, pLocalSrc, srcStride, coeffPairs, (int)convolutionWidth, (int)convolutionHeight);
+
+			result[0] = Convolve_Scale_SSE(result[0], bias, shift);
+			result[1] = Convolve_Scale_SSE(result[1], bias, shift);
+			result[2] = Convolve_Scale_SSE(result[2], bias, shift);
+			result[3] = Convolve_Scale_SSE(result[3], bias, shift);
+
+			row = _mm_packs_epi32(result[2], result[3]);
+			temp0 = _mm_packs_epi32(result[0], result[1]);
+			row = _mm_packus_epi16(temp0, row);
+			_mm_store_si128(pLocalDst_xmm++, row);
+
+			pLocalSrc += 16;
+			width--;
+		}
+
+		pLocalDst = (unsigned char *)pLocalDst_xmm;
+		for (int w = 0; w < postfixWidth; w++, pLocalSrc++)
+		{
+			int temp = Convolve_MxN_Pixel_C(pLocalSrc, srcStride, convMatrix, (int)convolutionWidth, (int)convolutionHeight, shift);
+			temp = min(temp, 255);
+			temp = max(temp, 0);
+			*pLocalDst++ = (unsigned char)temp;
+		}
+
+		pSrcImage += srcImageStrideInBytes;
+		pDstImage += dstImageStrideInBytes;
+
+		height--;
+	}
+	return AGO_SUCCESS;
+}
+
+int HafCpu_Convolve_S16_U8_MxN
+	(
+		vx_uint32     dstWidth,
+		vx_uint32     dstHeight,
+		vx_int16    * pDstImage,
+		vx_uint32     dstImageStrideInBytes,
+		vx_uint8    * pSrcImage,
+		vx_uint32     srcImageStrideInBytes,
+		vx_int16    * convMatrix,
+		vx_uint32     convolutionWidth,
+		vx_uint32     convolutionHeight,
+		vx_int32      shift
+	)
+{
+	if (!(convolutionWidth & 1) || !(convolutionHeight & 1) || convolutionWidth > AGO_MAX_CONVOLUTION_DIM || convolutionHeight > AGO_MAX_CONVOLUTION_DIM)
+		return AGO_ERROR_HAFCPU_NOT_IMPLEMENTED;
+
+	__m128i coeffPairs[AGO_MAX_CONVOLUTION_DIM * ((AGO_MAX_CONVOLUTION_DIM + 1) >> 1)];
+	Convolve_MxN_InitCoeffPairs(coeffPairs, convMatrix, convolutionWidth, convolutionHeight);
+
+	__m128i *pLocalDst_xmm;
+	unsigned char *pLocalSrc;
+	short * pLocalDst;
+	__m128i result[4], row, temp0;
+	__m128i bias = _mm_set1_epi32((1 << shift) - 1);
+
+	int prefixWidth = intptr_t(pDstImage) & 15;
+	prefixWidth = (prefixWidth == 0) ? 0 : (16 - prefixWidth);
+	prefixWidth >>= 1;														// 2 bytes = 1 pixel
+	prefixWidth = min(prefixWidth, (int)dstWidth);
+	int postfixWidth = ((int)dstWidth - prefixWidth) & 15;					// 16 pixels processed at a time in SSE loop
+	int alignedWidth = (int)dstWidth - prefixWidth - postfixWidth;
+
+	int height = (int)dstHeight;
+	int srcStride = (int)srcImageStrideInBytes;
+
+	while (height)
+	{
+		pLocalSrc = (unsigned char *)pSrcImage;
+		pLocalDst = (short *)pDstImage;
+
+		for (int w = 0; w < prefixWidth; w++, pLocalSrc++)
+		{
+			int temp = Convolve_MxN_Pixel_C(pLocalSrc, srcStride, convMatrix, (int)convolutionWidth, (int)convolutionHeight, shift);
+			temp = min(temp, SHRT_MAX);
+			temp = max(temp, SHRT_MIN);
+			*pLocalDst++ = (short)temp;
+		}
+
+		pLocalDst_xmm = (__m128i *) pLocalDst;
+		int width = (int)(alignedWidth >> 4);							// Each loop processess 16 pixels
+		while (width)
+		{
+			Convolve_MxN_Accumulate_SSE(result, pLocalSrc, srcStride, coeffPairs, (int)convolutionWidth, (int)convolutionHeight);
+
+			result[0] = Convolve_Scale_SSE(result[0], bias, shift);
+			result[1] = Convolve_Scale_SSE(result[1], bias, shift);
+			result[2] = Convolve_Scale_SSE(result[2], bias, shift);
+			result[3] = Convolve_Scale_SSE(result[3], bias, shift);
+
+			row = _mm_packs_epi32(result[2], result[3]);
+			temp0 = _mm_packs_epi32(result[0], result[1]);
+			_mm_store_si128(pLocalDst_xmm++, temp0);
+			_mm_store_si128(pLocalDst_xmm++, row);
+
+			pLocalSrc += 16;
+			width--;
+		}
+
+		pLocalDst = (short *)pLocalDst_xmm;
+		for (int w = 0; w < postfixWidth; w++, pLocalSrc++)
+		{
+			int temp = Convolve_MxN_Pixel_C(pLocalSrc, srcStride, convMatrix, (int)convolutionWidth, (int)convolutionHeight, shift);
+			temp = min(temp, SHRT_MAX);
+			temp = max(temp, SHRT_MIN);
+			*pLocalDst++ = (short)temp;
+		}
+
+		pSrcImage += srcImageStrideInBytes;
+		pDstImage += (dstImageStrideInBytes >> 1);
+
+		height--;
+	}
+	return AGO_SUCCESS;
+}
+
+/* Separable convolution: coefficient matrix is rank-1, i.e., conv[r][c] = vCoeff[r] * hCoeff[c]
+   Horizontal pass filters each source row once into a ring of convolutionHeight rows (32-bit),
+   vertical pass combines the ring rows into the destination row.
+   pLocalData shall have space for convolutionHeight rows of ((dstWidth + 15) & ~15) vx_int32 values.
+*/
+static inline void ConvolveSeparable_HorizontalPass
+	(
+		vx_uint32     dstWidth,
+		vx_int32    * pDstRow,
+		vx_uint8    * pSrcRow,
+		__m128i     * coeffPairs,
+		vx_int16    * hTap,
+		int           convolutionWidth
+	)
+{
+	__m128i zeromask = _mm_setzero_si128();
+	__m128i row0, row1, pix0, pix1, temp0, temp1, result0, result1, result2, result3;
+	int colLimit = convolutionWidth >> 1;
+	int alignedWidth = (int)dstWidth & ~15;
+	vx_uint8 * pLocalSrc = pSrcRow - colLimit;
+	int x = 0;
+	for (; x < alignedWidth; x += 16, pLocalSrc += 16)
+	{
+		result0 = _mm_setzero_si128();
+		result1 = _mm_setzero_si128();
+		result2 = _mm_setzero_si128();
+		result3 = _mm_setzero_si128();
+		for (int k = 0; k < convolutionWidth; k += 2)
+		{
+			row0 = _mm_loadu_si128((__m128i *)(pLocalSrc + k));
+			row1 = ((k + 1) < convolutionWidth) ? _mm_loadu_si128((__m128i *)(pLocalSrc + k + 1)) : row0;
+			__m128i mul = coeffPairs[k >> 1];
+
+			pix0 = _mm_cvtepu8_epi16(row0);
+			pix1 = _mm_cvtepu8_epi16(row1);
+			temp0 = _mm_unpacklo_epi16(pix0, pix1);
+			temp1 = _mm_unpackhi_epi16(pix0, pix1);
+			result0 = _mm_add_epi32(result0, _mm_madd_epi16(temp0, mul));
+			result1 = _mm_add_epi32(result1, _mm_madd_epi16(temp1, mul));
+
+			pix0 = _mm_unpackhi_epi8(row0, zeromask);
+			pix1 = _mm_unpackhi_epi8(row1, zeromask);
+			temp0 = _mm_unpacklo_epi16(pix0, pix1);
+			temp1 = _mm_unpackhi_epi16(pix0, pix1);
+			result2 = _mm_add_epi32(result2, _mm_madd_epi16(temp0, mul));
+			result3 = _mm_add_epi32(result3, _mm_madd_epi16(temp1, mul));
+		}
+		_mm_store_si128((__m128i *)(pDstRow + x), result0);
+		_mm_store_si128((__m128i *)(pDstRow + x + 4), result1);
+		_mm_store_si128((__m128i *)(pDstRow + x + 8), result2);
+		_mm_store_si128((__m128i *)(pDstRow + x + 12), result3);
+	}
+	for (; x < (int)dstWidth; x++, pLocalSrc++)
+	{
+		int sum = 0;
+		for (int k = 0; k < convolutionWidth; k++)
+			sum += (int)pLocalSrc[k] * (int)hTap[k];
+		pDstRow[x] = sum;
+	}
+}
+
+static inline void ConvolveSeparable_InitTaps
+	(
+		__m128i     * coeffPairs,
+		vx_int16    * hTap,
+		vx_int16    * vTap,
+		vx_int16    * hCoeff,
+		vx_int16    * vCoeff,
+		int           convolutionWidth,
+		int           convolutionHeight
+	)
+{
+	// the coefficients are applied in reverse order (see the MxN case)
+	for (int k = 0; k < convolutionWidth; k++)
+		hTap[k] = hCoeff[convolutionWidth - 1 - k];
+	for (int k = 0; k < convolutionHeight; k++)
+		vTap[k] = vCoeff[convolutionHeight - 1 - k];
+	for (int k = 0; k < convolutionWidth; k += 2)
+	{
+		vx_uint16 c0 = (vx_uint16)hTap[k];
+		vx_uint16 c1 = ((k + 1) < convolutionWidth) ? (vx_uint16)hTap[k + 1] : 0;
+		coeffPairs[k >> 1] = _mm_set1_epi32((int)(((vx_uint32)c1 << 16) | c0));
+	}
+}
+
+static inline void ConvolveSeparable_VerticalPass
+	(
+		__m128i       result[4],
+		vx_int32   ** pRingRows,
+		int           x,
+		__m128i     * vMul,
+		int           convolutionHeight
+	)
+{
+	result[0] = _mm_setzero_si128();
+	result[1] = _mm_setzero_si128();
+	result[2] = _mm_setzero_si128();
+	result[3] = _mm_setzero_si128();
+	for (int k = 0; k < convolutionHeight; k++)
+	{
+		vx_int32 * pRow = pRingRows[k] + x;
+		result[0] = _mm_add_epi32(result[0], _mm_mullo_epi32(_mm_load_si128((__m128i *)(pRow + 0)), vMul[k]));
+		result[1] = _mm_add_epi32(result[1], _mm_mullo_epi32(_mm_load_si128((__m128i *)(pRow + 4)), vMul[k]));
+		result[2] = _mm_add_epi32(result[2], _mm_mullo_epi32(_mm_load_si128((__m128i *)(pRow + 8)), vMul[k]));
+		result[3] = _mm_add_epi32(result[3], _mm_mullo_epi32(_mm_load_si128((__m128i *)(pRow + 12)), vMul[k]));
+	}
+}
+
+int HafCpu_ConvolveSeparable_U8_U8
+	(
+		vx_uint32     dstWidth,
+		vx_uint32     dstHeight,
+		vx_uint8    * pDstImage,
+		vx_uint32     dstImageStrideInBytes,
+		vx_uint8    * pSrcImage,
+		vx_uint32     srcImageStrideInBytes,
+		vx_int16    * hCoeff,
+		vx_int16    * vCoeff,
+		vx_uint32     convolutionWidth,
+		vx_uint32     convolutionHeight,
+		vx_int32      shift,
+		vx_uint8    * pLocalData
+	)
+{
+	if (!(convolutionWidth & 1) || !(convolutionHeight & 1) || convolutionWidth > AGO_MAX_CONVOLUTION_DIM || convolutionHeight > AGO_MAX_CONVOLUTION_DIM)
+		return AGO_ERROR_HAFCPU_NOT_IMPLEMENTED;
+
+	__m128i coeffPairs[(AGO_MAX_CONVOLUTION_DIM + 1) >> 1], vMul[AGO_MAX_CONVOLUTION_DIM], result[4], row, temp0;
+	vx_int16 hTap[AGO_MAX_CONVOLUTION_DIM], vTap[AGO_MAX_CONVOLUTION_DIM];
+	vx_int32 * pRingRows[AGO_MAX_CONVOLUTION_DIM];
+	ConvolveSeparable_InitTaps(coeffPairs, hTap, vTap, hCoeff, vCoeff, (int)convolutionWidth, (int)convolutionHeight);
+	for (int k = 0; k < (int)convolutionHeight; k++)
+		vMul[k] = _mm_set1_epi32((int)vTap[k]);
+	__m128i bias = _mm_set1_epi32((1 << shift) - 1);
+
+	int rowLimit = (int)convolutionHeight >> 1;
+	int alignedWidth = ((int)dstWidth + 15) & ~15;
+	int ssePixels = (int)dstWidth & ~15;
+	vx_int32 * pRingBuffer = (vx_int32 *)ALIGN16(pLocalData);
+
+	// horizontal pass of the first (convolutionHeight - 1) rows
+	for (int k = 0; k < (int)convolutionHeight - 1; k++)
+	{
+		ConvolveSeparable_HorizontalPass(dstWidth, pRingBuffer + k * alignedWidth, pSrcImage + (k - rowLimit) * (int)srcImageStrideInBytes, coeffPairs, hTap, (int)convolutionWidth);
+	}
+
+	for (int y = 0; y < (int)dstHeight; y++)
+	{
+		// horizontal pass of the incoming row and vertical pass of the ring
+		int slotNew = (y + (int)convolutionHeight - 1) % (int)convolutionHeight;
+		ConvolveSeparable_HorizontalPass(dstWidth, pRingBuffer + slotNew * alignedWidth, pSrcImage + rowLimit * (int)srcImageStrideInBytes, coeffPairs, hTap, (int)convolutionWidth);
+		for (int k = 0; k < (int)convolutionHeight; k++)
+			pRingRows[k] = pRingBuffer + ((y + k) % (int)convolutionHeight) * alignedWidth;
+
+		int x = 0;
+		for (; x < ssePixels; x += 16)
+		{
+			ConvolveSeparable_VerticalPass(result, pRingRows, x, vMul, (int)convolutionHeight);
+			result[0] = Convolve_Scale_SSE(result[0], bias, shift);
+			result[1] = Convolve_Scale_SSE(result[1], bias, shift);
+			result[2] = Convolve_Scale_SSE(result[2], bias, shift);
+			result[3] = Convolve_Scale_SSE(result[3], bias, shift);
+			row = _mm_packs_epi32(result[2], result[3]);
+			temp0 = _mm_packs_epi32(result[0], result[1]);
+			row = _mm_packus_epi16(temp0, row);
+			_mm_storeu_si128((__m128i *)(pDstImage + x), row);
+		}
+		for (; x < (int)dstWidth; x++)
+		{
+			int sum = 0;
+			for (int k = 0; k < (int)convolutionHeight; k++)
+				sum += pRingRows[k][x] * (int)vTap[k];
+			sum = (sum < 0) ? -((-sum) >> shift) : (sum >> shift);
+			sum = min(sum, 255);
+			sum = max(sum, 0);
+			pDstImage[x] = (vx_uint8)sum;
+		}
+
+		pSrcImage += srcImageStrideInBytes;
+		pDstImage += dstImageStrideInBytes;
+	}
+	return AGO_SUCCESS;
+}
+
+int HafCpu_ConvolveSeparable_S16_U8
+	(
+		vx_uint32     dstWidth,
+		vx_uint32     dstHeight,
+		vx_int16    * pDstImage,
+		vx_uint32     dstImageStrideInBytes,
+		vx_uint8    * pSrcImage,
+		vx_uint32     srcImageStrideInBytes,
+		vx_int16    * hCoeff,
+		vx_int16    * vCoeff,
+		vx_uint32     convolutionWidth,
+		vx_uint32     convolutionHeight,
+		vx_int32      shift,
+		vx_uint8    * pLocalData
+	)
+{
+	if (!(convolutionWidth & 1) || !(convolutionHeight & 1) || convolutionWidth > AGO_MAX_CONVOLUTION_DIM || convolutionHeight > AGO_MAX_CONVOLUTION_DIM)
+		return AGO_ERROR_HAFCPU_NOT_IMPLEMENTED;
+
+	__m128i coeffPairs[(AGO_MAX_CONVOLUTION_DIM + 1) >> 1], vMul[AGO_MAX_CONVOLUTION_DIM], result[4], row, temp0;
+	vx_int16 hTap[AGO_MAX_CONVOLUTION_DIM], vTap[AGO_MAX_CONVOLUTION_DIM];
+	vx_int32 * pRingRows[AGO_MAX_CONVOLUTION_DIM];
+	ConvolveSeparable_InitTaps(coeffPairs, hTap, vTap, hCoeff, vCoeff, (int)convolutionWidth, (int)convolutionHeight);
+	for (int k = 0; k < (int)convolutionHeight; k++)
+		vMul[k] = _mm_set1_epi32((int)vTap[k]);
+	__m128i bias = _mm_set1_epi32((1 << shift) - 1);
+
+	int rowLimit = (int)convolutionHeight >> 1;
+	int alignedWidth = ((int)dstWidth + 15) & ~15;
+	int ssePixels = (int)dstWidth & ~15;
+	vx_int32 * pRingBuffer = (vx_int32 *)ALIGN16(pLocalData);
+
+	// horizontal pass of the first (convolutionHeight - 1) rows
+	for (int k = 0; k < (int)convolutionHeight - 1; k++)
+	{
+		ConvolveSeparable_HorizontalPass(dstWidth, pRingBuffer + k * alignedWidth, pSrcImage + (k - rowLimit) * (int)srcImageStrideInBytes, coeffPairs, hTap, (int)convolutionWidth);
+	}
+
+	for (int y = 0; y < (int)dstHeight; y++)
+	{
+		// horizontal pass of the incoming row and vertical pass of the ring
+		int slotNew = (y + (int)convolutionHeight - 1) % (int)convolutionHeight;
+		ConvolveSeparable_HorizontalPass(dstWidth, pRingBuffer + slotNew * alignedWidth, pSrcImage + rowLimit * (int)srcImageStrideInBytes, coeffPairs, hTap, (int)convolutionWidth);
+		for (int k = 0; k < (int)convolutionHeight; k++)
+			pRingRows[k] = pRingBuffer + ((y + k) % (int)convolutionHeight) * alignedWidth;
+
+		int x = 0;
+		for (; x < ssePixels; x += 16)
+		{
+			ConvolveSeparable_VerticalPass(result, pRingRows, x, vMul, (int)convolutionHeight);
+			result[0] = Convolve_Scale_SSE(result[0], bias, shift);
+			result[1] = Convolve_Scale_SSE(result[1], bias, shift);
+			result[2] = Convolve_Scale_SSE(result[2], bias, shift);
+			result[3] = Convolve_Scale_SSE(result[3], bias, shift);
+			row = _mm_packs_epi32(result[2], result[3]);
+			temp0 = _mm_packs_epi32(result[0], result[1]);
+			_mm_storeu_si128((__m128i *)(pDstImage + x), temp0);
+			_mm_storeu_si128((__m128i *)(pDstImage + x + 8), row);
+		}
+		for (; x < (int)dstWidth; x++)
+		{
+			int sum = 0;
+			for (int k = 0; k < (int)convolutionHeight; k++)
+				sum += pRingRows[k][x] * (int)vTap[k];
+			sum = (sum < 0) ? -((-sum) >> shift) : (sum >> shift);
+			sum = min(sum, SHRT_MAX);
+			sum = max(sum, SHRT_MIN);
+			pDstImage[x] = (vx_int16)sum;
+		}
+
+		pSrcImage += srcImageStrideInBytes;
+		pDstImage += (dstImageStrideInBytes >> 1);
+	}
+	return AGO_SUCCESS;
+}
+
 static inline void CompareAndSwap(__m128i& p1, __m128i& p2)
 {
 	__m128i First = _mm_min_epu8(p1, p2);
@@ -4200,4 +4767,191 @@ int HafCpu_SobelMagnitudePhase_S16U8_U8_3x3
 		height--;
 	}
 	return AGO_SUCCESS;
-}
\ No newline at end of file
+}
+/* Linear filter with floating-point coefficients (vx_matrix) on U8/S16/F32 images.
+   The filter is applied as correlation: dst(x,y) = sum(coef[i][j] * src(x + j - filterWidth/2, y + i - filterHeight/2)).
+   U8 and S16 results are rounded to nearest and saturated.
+*/
+static inline void LinearFilter_LoadF32x8(__m128 & pix0, __m128 & pix1, vx_df_image srcFormat, vx_uint8 * pSrc)
+{
+	if (srcFormat == VX_DF_IMAGE_U8) {
+		__m128i row = _mm_loadl_epi64((__m128i *)pSrc);
+		pix0 = _mm_cvtepi32_ps(_mm_cvtepu8_epi32(row));
+		pix1 = _mm_cvtepi32_ps(_mm_cvtepu8_epi32(_mm_srli_si128(row, 4)));
+	}
+	else if (srcFormat == VX_DF_IMAGE_S16) {
+		__m128i row = _mm_loadu_si128((__m128i *)pSrc);
+		pix0 = _mm_cvtepi32_ps(_mm_cvtepi16_epi32(row));
+		pix1 = _mm_cvtepi32_ps(_mm_cvtepi16_epi32(_mm_srli_si128(row, 8)));
+	}
+	else {
+		pix0 = _mm_loadu_ps((float *)pSrc);
+		pix1 = _mm_loadu_ps((float *)pSrc + 4);
+	}
+}
+
+static inline void LinearFilter_StoreF32x8(__m128 sum0, __m128 sum1, vx_df_image dstFormat, vx_uint8 * pDst)
+{
+	if (dstFormat == VX_DF_IMAGE_U8) {
+		__m128i row = _mm_packs_epi32(_mm_cvtps_epi32(sum0), _mm_cvtps_epi32(sum1));
+		_mm_storel_epi64((__m128i *)pDst, _mm_packus_epi16(row, row));
+	}
+	else if (dstFormat == VX_DF_IMAGE_S16) {
+		_mm_storeu_si128((__m128i *)pDst, _mm_packs_epi32(_mm_cvtps_epi32(sum0), _mm_cvtps_epi32(sum1)));
+	}
+	else {
+		_mm_storeu_ps((float *)pDst, sum0);
+		_mm_storeu_ps((float *)pDst + 4, sum1);
+	}
+}
+
+static inline float LinearFilter_LoadF32(vx_df_image srcFormat, vx_uint8 * pSrc)
+{
+	if (srcFormat == VX_DF_IMAGE_U8)
+		return (float)*pSrc;
+	else if (srcFormat == VX_DF_IMAGE_S16)
+		return (float)*(vx_int16 *)pSrc;
+	return *(float *)pSrc;
+}
+
+static inline void LinearFilter_StoreF32(float sum, vx_df_image dstFormat, vx_uint8 * pDst)
+{
+	if (dstFormat == VX_DF_IMAGE_U8) {
+		int value = (int)nearbyintf(sum);
+		*pDst = (vx_uint8)max(min(value, 255), 0);
+	}
+	else if (dstFormat == VX_DF_IMAGE_S16) {
+		float value = min(max(sum, -32768.0f), 32767.0f);
+		*(vx_int16 *)pDst = (vx_int16)nearbyintf(value);
+	}
+	else {
+		*(float *)pDst = sum;
+	}
+}
+
+static int LinearFilter_ANY_ANY
+	(
+		vx_uint32     dstWidth,
+		vx_uint32     dstHeight,
+		vx_df_image   dstFormat,
+		vx_uint8    * pDstImage1,
+		vx_uint32     dstImage1StrideInBytes,
+		vx_uint8    * pDstImage2,
+		vx_uint32     dstImage2StrideInBytes,
+		vx_df_image   srcFormat,
+		vx_uint8    * pSrcImage,
+		vx_uint32     srcImageStrideInBytes,
+		vx_float32  * filterCoef1,
+		vx_float32  * filterCoef2,
+		vx_uint32     filterWidth,
+		vx_uint32     filterHeight
+	)
+{
+	// pixel sizes in bytes
+	int srcPixelSize = (srcFormat == VX_DF_IMAGE_U8) ? 1 : ((srcFormat == VX_DF_IMAGE_S16) ? 2 : 4);
+	int dstPixelSize = (dstFormat == VX_DF_IMAGE_U8) ? 1 : ((dstFormat == VX_DF_IMAGE_S16) ? 2 : 4);
+	if ((srcFormat != VX_DF_IMAGE_U8 && srcFormat != VX_DF_IMAGE_S16 && srcFormat != VX_DF_IMAGE_F32_AMD) ||
+		(dstFormat != VX_DF_IMAGE_U8 && dstFormat != VX_DF_IMAGE_S16 && dstFormat != VX_DF_IMAGE_F32_AMD) ||
+		!(filterWidth & 1) || !(filterHeight & 1))
+		return AGO_ERROR_HAFCPU_NOT_IMPLEMENTED;
+
+	int colLimit = (int)filterWidth >> 1;
+	int rowLimit = (int)filterHeight >> 1;
+	int alignedWidth = (int)dstWidth & ~7;
+	for (vx_uint32 y = 0; y < dstHeight; y++)
+	{
+		vx_uint8 * pLocalSrc = pSrcImage - rowLimit * (int)srcImageStrideInBytes - colLimit * srcPixelSize;
+		int x = 0;
+		for (; x < alignedWidth; x += 8, pLocalSrc += 8 * srcPixelSize)
+		{
+			__m128 sum0 = _mm_setzero_ps(), sum1 = _mm_setzero_ps();
+			__m128 sum2 = _mm_setzero_ps(), sum3 = _mm_setzero_ps();
+			__m128 pix0, pix1, coef;
+			vx_uint8 * pRow = pLocalSrc;
+			int k = 0;
+			for (vx_uint32 i = 0; i < filterHeight; i++, pRow += srcImageStrideInBytes)
+			{
+				for (vx_uint32 j = 0; j < filterWidth; j++, k++)
+				{
+					LinearFilter_LoadF32x8(pix0, pix1, srcFormat, pRow + j * srcPixelSize);
+					coef = _mm_set1_ps(filterCoef1[k]);
+					sum0 = _mm_add_ps(sum0, _mm_mul_ps(pix0, coef));
+					sum1 = _mm_add_ps(sum1, _mm_mul_ps(pix1, coef));
+					if (filterCoef2) {
+						coef = _mm_set1_ps(filterCoef2[k]);
+						sum2 = _mm_add_ps(sum2, _mm_mul_ps(pix0, coef));
+						sum3 = _mm_add_ps(sum3, _mm_mul_ps(pix1, coef));
+					}
+				}
+			}
+			LinearFilter_StoreF32x8(sum0, sum1, dstFormat, pDstImage1 + x * dstPixelSize);
+			if (filterCoef2)
+				LinearFilter_StoreF32x8(sum2, sum3, dstFormat, pDstImage2 + x * dstPixelSize);
+		}
+		for (; x < (int)dstWidth; x++, pLocalSrc += srcPixelSize)
+		{
+			float sum1 = 0.0f, sum2 = 0.0f;
+			vx_uint8 * pRow = pLocalSrc;
+			int k = 0;
+			for (vx_uint32 i = 0; i < filterHeight; i++, pRow += srcImageStrideInBytes)
+			{
+				for (vx_uint32 j = 0; j < filterWidth; j++, k++)
+				{
+					float pix = LinearFilter_LoadF32(srcFormat, pRow + j * srcPixelSize);
+					sum1 += pix * filterCoef1[k];
+					if (filterCoef2)
+						sum2 += pix * filterCoef2[k];
+				}
+			}
+			LinearFilter_StoreF32(sum1, dstFormat, pDstImage1 + x * dstPixelSize);
+			if (filterCoef2)
+				LinearFilter_StoreF32(sum2, dstFormat, pDstImage2 + x * dstPixelSize);
+		}
+		pSrcImage += srcImageStrideInBytes;
+		pDstImage1 += dstImage1StrideInBytes;
+		if (filterCoef2)
+			pDstImage2 += dstImage2StrideInBytes;
+	}
+	return AGO_SUCCESS;
+}
+
+int HafCpu_LinearFilter_ANY_ANY
+	(
+		vx_uint32     dstWidth,
+		vx_uint32     dstHeight,
+		vx_df_image   dstFormat,
+		vx_uint8    * pDstImage,
+		vx_uint32     dstImageStrideInBytes,
+		vx_df_image   srcFormat,
+		vx_uint8    * pSrcImage,
+		vx_uint32     srcImageStrideInBytes,
+		vx_float32  * filterCoef,
+		vx_uint32     filterWidth,
+		vx_uint32     filterHeight
+	)
+{
+	return LinearFilter_ANY_ANY(dstWidth, dstHeight, dstFormat, pDstImage, dstImageStrideInBytes, nullptr, 0,
+		srcFormat, pSrcImage, srcImageStrideInBytes, filterCoef, nullptr, filterWidth, filterHeight);
+}
+
+int HafCpu_LinearFilter_ANYx2_ANY
+	(
+		vx_uint32     dstWidth,
+		vx_uint32     dstHeight,
+		vx_df_image   dstFormat,
+		vx_uint8    * pDstImage1,
+		vx_uint32     dstImage1StrideInBytes,
+		vx_uint8    * pDstImage2,
+		vx_uint32     dstImage2StrideInBytes,
+		vx_df_image   srcFormat,
+		vx_uint8    * pSrcImage,
+		vx_uint32     srcImageStrideInBytes,
+		vx_float32  * filterCoef1,
+		vx_float32  * filterCoef2,
+		vx_uint32     filterWidth,
+		vx_uint32     filterHeight
+	)
+{
+	return LinearFilter_ANY_ANY(dstWidth, dstHeight, dstFormat, pDstImage1, dstImage1StrideInBytes, pDstImage2, dstImage2StrideInBytes,
+		srcFormat, pSrcImage, srcImageStrideInBytes, filterCoef1, filterCoef2, filterWidth, filterHeight);
+}
@@ -503,1357 +503,468 @@ int HafCpu_Remap_U8_U8_Bilinear_Constant
 	return AGO_SUCCESS;
 }
 
-// The dst pixels are nearest affine transformed (truncate towards zero rounding). Bounday_mode is not specified. 
-// If the transformed location is out of bounds: 0 or max pixel will be used as substitution.
-int HafCpu_WarpAffine_U8_U8_Nearest
+// Bilinear remap of RGB/RGBX images: all channels of a source location are fetched and
+// interpolated together with fixed-point weights (remapFractionalBits per coordinate).
+// Locations marked invalid (0xffff, 0xffff) produce zero pixels.
+static inline __m128i Remap_Bilinear_RGBX
 (
-vx_uint32             dstWidth,
-vx_uint32             dstHeight,
-vx_uint8            * pDstImage,
-vx_uint32             dstImageStrideInBytes,
-vx_uint32             srcWidth,
-vx_uint32             srcHeight,
-vx_uint8            * pSrcImage,
-vx_uint32             srcImageStrideInBytes,
-ago_affine_matrix_t * matrix,
-vx_uint8			* pLocalData
+	vx_uint8             * pSrcImage,
+	vx_uint32              srcImageStrideInBytes,
+	vx_uint32              srcBytesPerPixel,
+	vx_uint32              srcWidth,
+	vx_uint32              srcHeight,
+	vx_uint32              mapX,
+	vx_uint32              mapY,
+	vx_uint32              remapFractionalBits,
+	__m128i                bias,
+	__m128i                shift
 )
 {
-	__m128  ymap, xmap, ydest, xdest;
-	__m128i srcb, src_s;
-	__m128i zeromask = _mm_setzero_si128();
-
-	const float r00 = matrix->matrix[0][0];
-	const float r10 = matrix->matrix[0][1];
-	const float r01 = matrix->matrix[1][0];
-	const float r11 = matrix->matrix[1][1];
-	const float const1 = matrix->matrix[2][0];
-	const float const2 = matrix->matrix[2][1];
-
-	const __m128 srcbx = _mm_set1_ps((float)srcWidth);
-	const __m128 srcby = _mm_set1_ps((float)srcHeight);
-	const __m128 zero = _mm_set1_ps(0);
-	srcb = _mm_set1_epi32((srcHeight*srcImageStrideInBytes) - 1);
-	src_s = _mm_set1_epi32(srcImageStrideInBytes);
-
-	// check if all mapped pixels are valid or not
-	bool bBoder = (const1 < 0) | (const2 < 0) | (const1 >= srcWidth) | (const2 >= srcHeight);
-	// check for (dstWidth, 0)
-	float x1 = (r00*dstWidth + const1);
-	float y1 = (r10*dstWidth + const2);
-	bBoder |= (x1 < 0) | (y1 < 0) | (x1 >= srcWidth) | (y1 >= srcHeight);
-	// check for (0, dstHeight)
-	x1 = (r01*dstHeight + const1);
-	y1 = (r11*dstHeight + const2);
-	bBoder |= (x1 < 0) | (y1 < 0) | (x1 >= srcWidth) | (y1 >= srcHeight);
-	// check for (dstWidth, dstHeight)
-	x1 = (r00*dstWidth + r01*dstHeight + const1);
-	y1 = (r10*dstWidth + r11*dstHeight + const2);
-	bBoder |= (x1 < 0) | (y1 < 0) | (x1 >= srcWidth) | (y1 >= srcHeight);
-
-	XMM128 mask;
-	unsigned int x, y;
-	float *r00_x, *r10_x;
-	r00_x = (float*)pLocalData;
-	r10_x = r00_x + dstWidth;
-	for (x = 0; x<dstWidth; x++){
-		r00_x[x] = r00 * x;
-		r10_x[x] = r10 * x;
-	}
-	y = 0;
-
-	if (bBoder){
-		while (y < dstHeight)
-		{
-			// calculate (y*m[0][1] + m[0][2]) for x and y
-			xdest = _mm_set1_ps(y*r01 + const1);
-			ydest = _mm_set1_ps(y*r11 + const2);
-
-			unsigned int x = 0;
-			unsigned int *dst = (unsigned int *)pDstImage;
-			while (x < dstWidth)
-			{
-				__m128i xpels, ypels;
-				// read x into xpel
-				xmap = _mm_load_ps(&r00_x[x]);
-				xmap = _mm_add_ps(xmap, xdest);				// xf = dst[x3, x2, x1, x0]
-				ymap = _mm_load_ps(&r10_x[x]);
-				ymap = _mm_add_ps(ymap, ydest);				// ymap <- r10*x + ty
-
-				mask.f = _mm_cmpge_ps(xmap, zero);
-				mask.f = _mm_and_ps(mask.f, _mm_cmplt_ps(xmap, srcbx));
-				mask.f = _mm_and_ps(mask.f, _mm_cmpge_ps(ymap, zero));
-				mask.f = _mm_and_ps(mask.f, _mm_cmplt_ps(ymap, srcby));
-
-				// convert to integer with rounding towards zero
-				xpels = _mm_cvttps_epi32(xmap);
-				ypels = _mm_cvttps_epi32(ymap);
-
-				// multiply ydest*srcImageStrideInBytes
-				ypels = _mm_mullo_epi32(ypels, src_s);
-				ypels = _mm_add_epi32(ypels, xpels);			// pixel location at src for dst image.
-
-				// check if the values exceed boundary and clamp it to boundary :: need to do this to avoid memory access violations
-				ypels = _mm_min_epi32(ypels, srcb);
-				ypels = _mm_max_epi32(ypels, zeromask);
-
-				// check if the values exceed boundary and clamp it to boundary
-				xpels = _mm_set_epi32(pSrcImage[M128I(ypels).m128i_i32[3]], pSrcImage[M128I(ypels).m128i_i32[2]], pSrcImage[M128I(ypels).m128i_i32[1]], pSrcImage[M128I(ypels).m128i_i32[0]]);
-				// mask for boundary: boundary pixels  will substituted with xero
-				xpels = _mm_and_si128(xpels, mask.i);
-
-				// convert to unsigned char and write to dst
-				xpels = _mm_packus_epi32(xpels, zeromask);
-				xpels = _mm_packus_epi16(xpels, zeromask);
-				*dst++ = M128I(xpels).m128i_i32[0];
-				x += 4;
-			}
-			y++;
-			pDstImage += dstImageStrideInBytes;
-		}
+	vx_uint32 fracMask = (1 << remapFractionalBits) - 1;
+	vx_uint32 one = 1 << remapFractionalBits;
+	vx_uint32 x = mapX >> remapFractionalBits, y = mapY >> remapFractionalBits;
+	vx_int32 fx = (vx_int32)(mapX & fracMask), fy = (vx_int32)(mapY & fracMask);
+	// stay within the source image for the right and bottom neighbors
+	vx_uint32 xStep = (x + 1 < srcWidth) ? srcBytesPerPixel : 0;
+	vx_uint32 yStep = (y + 1 < srcHeight) ? srcImageStrideInBytes : 0;
+	vx_uint8 * p0 = pSrcImage + y * srcImageStrideInBytes + x * srcBytesPerPixel;
+	vx_uint8 * p1 = p0 + yStep;
+	__m128i top, bot;
+	if (srcBytesPerPixel == 4) {
+		top = _mm_unpacklo_epi8(_mm_cvtsi32_si128(*(int *)p0), _mm_cvtsi32_si128(*(int *)(p0 + xStep)));
+		bot = _mm_unpacklo_epi8(_mm_cvtsi32_si128(*(int *)p1), _mm_cvtsi32_si128(*(int *)(p1 + xStep)));
 	}
-	else
-	{
-		while (y < dstHeight)
-		{
-			unsigned int x = 0;
-			unsigned int *dst = (unsigned int *)pDstImage;
-			// calculate (y*m[0][1] + m[0][2]) for x and y
-			xdest = _mm_set1_ps(y*r01 + const1);
-			ydest = _mm_set1_ps(y*r11 + const2);
-			while (x < dstWidth)
-			{
-				__m128i xpels, ypels;
-				// read x into xpel
-				xmap = _mm_load_ps(&r00_x[x]);
-				xmap = _mm_add_ps(xmap, xdest);				// xf = dst[x3, x2, x1, x0]
-				ymap = _mm_load_ps(&r10_x[x]);
-				ymap = _mm_add_ps(ymap, ydest);				// ymap <- r10*x + ty
-
-				// convert to integer with rounding towards zero
-				xpels = _mm_cvttps_epi32(xmap);
-				ypels = _mm_cvttps_epi32(ymap);
-				// multiply ydest*srcImageStrideInBytes
-				ypels = _mm_mullo_epi32(ypels, src_s);
-				ypels = _mm_add_epi32(ypels, xpels);			// pixel location at src for dst image.
-
-				// check if the values exceed boundary and clamp it to boundary
-				xpels = _mm_set_epi32(pSrcImage[M128I(ypels).m128i_i32[3]], pSrcImage[M128I(ypels).m128i_i32[2]], pSrcImage[M128I(ypels).m128i_i32[1]], pSrcImage[M128I(ypels).m128i_i32[0]]);
-				// convert to unsigned char and write to dst
-				xpels = _mm_packus_epi32(xpels, zeromask);
-				xpels = _mm_packus_epi16(xpels, zeromask);
-				*dst++ = M128I(xpels).m128i_i32[0];
-				x += 4;
-			}
-			y++;
-			pDstImage += dstImageStrideInBytes;
-		}
+	else {
+		// 3-byte pixels: gather bytes individually so that reads stay within the row
+		top = _mm_unpacklo_epi8(_mm_cvtsi32_si128(p0[0] | (p0[1] << 8) | (p0[2] << 16)), _mm_cvtsi32_si128(p0[xStep] | (p0[xStep + 1] << 8) | (p0[xStep + 2] << 16)));
+		bot = _mm_unpacklo_epi8(_mm_cvtsi32_si128(p1[0] | (p1[1] << 8) | (p1[2] << 16)), _mm_cvtsi32_si128(p1[xStep] | (p1[xStep + 1] << 8) | (p1[xStep + 2] << 16)));
 	}
-	return AGO_SUCCESS;
+	// top, bot: [c0 c0' c1 c1' c2 c2' c3 c3'] where ' is the right neighbor
+	top = _mm_cvtepu8_epi16(top);
+	bot = _mm_cvtepu8_epi16(bot);
+	vx_int32 wTop = (vx_int32)(one - fy), wBot = fy;
+	__m128i wt = _mm_set1_epi32(((wTop * fx) << 16) | (wTop * ((vx_int32)one - fx)));
+	__m128i wb = _mm_set1_epi32(((wBot * fx) << 16) | (wBot * ((vx_int32)one - fx)));
+	__m128i sum = _mm_add_epi32(_mm_madd_epi16(top, wt), _mm_madd_epi16(bot, wb));
+	sum = _mm_srl_epi32(_mm_add_epi32(sum, bias), shift);
+	sum = _mm_packus_epi32(sum, sum);
+	return _mm_packus_epi16(sum, sum);
 }
 
-
-// The dst pixels are nearest affine transformed (truncate towards zero rounding). Bounday_mode is not specified. 
-// If the transformed location is out of bounds: border has to be substituted.
-int HafCpu_WarpAffine_U8_U8_Nearest_Constant
+static int Remap_RGBX_RGBX_Bilinear
 (
-	vx_uint32             dstWidth,
-	vx_uint32             dstHeight,
-	vx_uint8            * pDstImage,
-	vx_uint32             dstImageStrideInBytes,
-	vx_uint32             srcWidth,
-	vx_uint32             srcHeight,
-	vx_uint8            * pSrcImage,
-	vx_uint32             srcImageStrideInBytes,
-	ago_affine_matrix_t * matrix,
-	vx_uint8              border,
-	vx_uint8			* pLocalData
+	vx_uint32              dstWidth,
+	vx_uint32              dstHeight,
+	vx_uint8             * pDstImage,
+	vx_uint32              dstImageStrideInBytes,
+	vx_uint32              dstBytesPerPixel,
+	vx_uint32              srcWidth,
+	vx_uint32              srcHeight,
+	vx_uint8             * pSrcImage,
+	vx_uint32              srcImageStrideInBytes,
+	vx_uint32              srcBytesPerPixel,
+	ago_coord2d_ushort_t * pMap,
+	vx_uint32              mapStrideInBytes,
+	vx_uint32              remapFractionalBits
 )
 {
-	__m128  ymap, xmap, ydest, xdest;
-	__m128i pborder, srcb, src_s;
-	__m128i zeromask = _mm_setzero_si128();
-	const unsigned int u32_border = border | (border << 8) | (border << 16) | (border << 24);
-
-	const float r00 = matrix->matrix[0][0];
-	const float r10 = matrix->matrix[0][1];
-	const float r01 = matrix->matrix[1][0];
-	const float r11 = matrix->matrix[1][1];
-	const float const1 = matrix->matrix[2][0];
-	const float const2 = matrix->matrix[2][1];
-
-	const __m128 srcbx = _mm_set1_ps((float)srcWidth);
-	const __m128 srcby = _mm_set1_ps((float)srcHeight);
-	const __m128 zero = _mm_set1_ps(0);
-	srcb = _mm_set1_epi32((srcHeight*srcImageStrideInBytes) - 1);
-	src_s = _mm_set1_epi32(srcImageStrideInBytes);
-	pborder = _mm_cvtsi32_si128((int)border);
-	pborder = _mm_shuffle_epi32(pborder, 0);
-	// check if all mapped pixels are valid or not
-	bool bBoder = (const1 < 0) | (const2 < 0) | (const1 >= srcWidth) | (const2 >= srcHeight);
-	// check for (dstWidth, 0)
-	float x1 = (r00*dstWidth + const1);
-	float y1 = (r10*dstWidth + const2);
-	bBoder |= (x1 < 0) | (y1 < 0) | (x1 >= srcWidth) | (y1 >= srcHeight);
-	// check for (0, dstHeight)
-	x1 = (r01*dstHeight + const1);
-	y1 = (r11*dstHeight + const2);
-	bBoder |= (x1 < 0) | (y1 < 0) | (x1 >= srcWidth) | (y1 >= srcHeight);
-	// check for (dstWidth, dstHeight)
-	x1 = (r00*dstWidth + r01*dstHeight + const1);
-	y1 = (r10*dstWidth + r11*dstHeight + const2);
-	bBoder |= (x1 < 0) | (y1 < 0) | (x1 >= srcWidth) | (y1 >= srcHeight);
-
-	XMM128 mask;
-	unsigned int x, y;
-	float *r00_x = (float*)pLocalData;
-	float *r10_x = r00_x + dstWidth;
-	for (x = 0; x<dstWidth; x++){
-		r00_x[x] = r00 * x;
-		r10_x[x] = r10 * x;
-	}
-	y = 0;
-
-	if (bBoder){
-		while (y < dstHeight)
-		{
-			// calculate (y*m[0][1] + m[0][2]) for x and y
-			xdest = _mm_set1_ps(y*r01 + const1);
-			ydest = _mm_set1_ps(y*r11 + const2);
-
-			unsigned int x = 0;
-			unsigned int *dst = (unsigned int *)pDstImage;
-			while (x < dstWidth)
-			{
-				__m128i xpels, ypels;
-				// read x into xpel
-				xmap = _mm_load_ps(&r00_x[x]);
-				xmap = _mm_add_ps(xmap, xdest);				// xf = dst[x3, x2, x1, x0]
-				ymap = _mm_load_ps(&r10_x[x]);
-				ymap = _mm_add_ps(ymap, ydest);				// ymap <- r10*x + ty
-
-				mask.f = _mm_cmpge_ps(xmap, zero);
-				mask.f = _mm_and_ps(mask.f, _mm_cmplt_ps(xmap, srcbx));
-				mask.f = _mm_and_ps(mask.f, _mm_cmpge_ps(ymap, zero));
-				mask.f = _mm_and_ps(mask.f, _mm_cmplt_ps(ymap, srcby));
-				//int m = _mm_movemask_ps(mask.f);
-				//if (m){
-					// convert to integer with rounding towards zero
-					xpels = _mm_cvttps_epi32(xmap);
-					ypels = _mm_cvttps_epi32(ymap);
-					// multiply ydest*srcImageStrideInBytes
-					ypels = _mm_mullo_epi32(ypels, src_s);
-					ypels = _mm_add_epi32(ypels, xpels);			// pixel location at src for dst image.
-
-					// check if the values exceed boundary and clamp it to boundary :: need to do this to avoid memory access violations
-					ypels = _mm_min_epi32(ypels, srcb);
-					ypels = _mm_max_epi32(ypels, zeromask);
-
-					// check if the values exceed boundary and clamp it to boundary
-					xpels = _mm_set_epi32(pSrcImage[M128I(ypels).m128i_i32[3]], pSrcImage[M128I(ypels).m128i_i32[2]], pSrcImage[M128I(ypels).m128i_i32[1]], pSrcImage[M128I(ypels).m128i_i32[0]]);
-					// mask for boundary
-					xpels = _mm_and_si128(xpels, mask.i);
-					xpels = _mm_or_si128(xpels, _mm_andnot_si128(mask.i, pborder));			// combined result
-
-					// convert to unsigned char and write to dst
-					xpels = _mm_packus_epi32(xpels, zeromask);
-					xpels = _mm_packus_epi16(xpels, zeromask);
-					*dst++ = M128I(xpels).m128i_i32[0];
-				//}
-				//else
-				//{
-				//	*dst++ = u32_border;
-				//}
-				x += 4;
-			}
-			y++;
-			pDstImage += dstImageStrideInBytes;
-		}
-	}
-	else
+	__m128i bias = _mm_set1_epi32((1 << (2 * remapFractionalBits)) >> 1);
+	__m128i shift = _mm_cvtsi32_si128(2 * remapFractionalBits);
+	for (vx_uint32 y = 0; y < dstHeight; y++)
 	{
-		while (y < dstHeight)
+		ago_coord2d_ushort_t * pLocalMap = pMap;
+		vx_uint8 * pLocalDst = pDstImage;
+		for (vx_uint32 x = 0; x < dstWidth; x++, pLocalMap++, pLocalDst += dstBytesPerPixel)
 		{
-			// calculate (y*m[0][1] + m[0][2]) for x and y
-			xdest = _mm_set1_ps(y*r01 + const1);
-			ydest = _mm_set1_ps(y*r11 + const2);
-
-			unsigned int x = 0;
-			unsigned int *dst = (unsigned int *)pDstImage;
-			while (x < dstWidth)
-			{
-				__m128i xpels, ypels;
-				// read x into xpel
-				xmap = _mm_load_ps(&r00_x[x]);
-				xmap = _mm_add_ps(xmap, xdest);				// xf = dst[x3, x2, x1, x0]
-				ymap = _mm_load_ps(&r10_x[x]);
-				ymap = _mm_add_ps(ymap, ydest);				// ymap <- r10*x + ty
-				// convert to integer with rounding towards zero
-				xpels = _mm_cvttps_epi32(xmap);
-				ypels = _mm_cvttps_epi32(ymap);
-				// multiply ydest*srcImageStrideInBytes
-				ypels = _mm_mullo_epi32(ypels, src_s);
-				ypels = _mm_add_epi32(ypels, xpels);			// pixel location at src for dst image.
-				xpels = _mm_set_epi32(pSrcImage[M128I(ypels).m128i_i32[3]], pSrcImage[M128I(ypels).m128i_i32[2]], pSrcImage[M128I(ypels).m128i_i32[1]], pSrcImage[M128I(ypels).m128i_i32[0]]);
-				// convert to unsigned char and write to dst
-				xpels = _mm_packus_epi32(xpels, zeromask);
-				xpels = _mm_packus_epi16(xpels, zeromask);
-				*dst++ = M128I(xpels).m128i_i32[0];
-				x += 4;
+			vx_uint32 pixel = 0;
+			if (pLocalMap->x != 0xffff || pLocalMap->y != 0xffff) {
+				pixel = (vx_uint32)_mm_cvtsi128_si32(Remap_Bilinear_RGBX(pSrcImage, srcImageStrideInBytes, srcBytesPerPixel, srcWidth, srcHeight,
+					pLocalMap->x, pLocalMap->y, remapFractionalBits, bias, shift));
+			}
+			if (dstBytesPerPixel == 4) {
+				*(vx_uint32 *)pLocalDst = pixel;
+			}
+			else {
+				pLocalDst[0] = (vx_uint8)pixel;
+				pLocalDst[1] = (vx_uint8)(pixel >> 8);
+				pLocalDst[2] = (vx_uint8)(pixel >> 16);
 			}
-			y++;
-			pDstImage += dstImageStrideInBytes;
 		}
+		pDstImage += dstImageStrideInBytes;
+		pMap = (ago_coord2d_ushort_t *)((vx_uint8 *)pMap + mapStrideInBytes);
 	}
 	return AGO_SUCCESS;
 }
 
-int HafCpu_WarpAffine_U8_U8_Bilinear
+int HafCpu_Remap_U24_U24_Bilinear
 (
-	vx_uint32             dstWidth,
-	vx_uint32             dstHeight,
-	vx_uint8            * pDstImage,
-	vx_uint32             dstImageStrideInBytes,
-	vx_uint32             srcWidth,
-	vx_uint32             srcHeight,
-	vx_uint8            * pSrcImage,
-	vx_uint32             srcImageStrideInBytes,
-	ago_affine_matrix_t * matrix,
-	vx_uint8			* pLocalData
+	vx_uint32              dstWidth,
+	vx_uint32              dstHeight,
+	vx_uint8             * pDstImage,
+	vx_uint32              dstImageStrideInBytes,
+	vx_uint32              srcWidth,
+	vx_uint32              srcHeight,
+	vx_uint8             * pSrcImage,
+	vx_uint32              srcImageStrideInBytes,
+	ago_coord2d_ushort_t * pMap,
+	vx_uint32              mapStrideInBytes,
+	vx_uint32              remapFractionalBits
 )
 {
-	// call the HafCpu_WarpAffine_U8_U8_Bilinear_Constant with border value 128
-	__m128  ymap, xmap, ydest, xdest;
-	__m128i srcb, src_s;
-	const __m128i zeromask = _mm_setzero_si128();
-	const __m128i one = _mm_set1_epi32(1);
+	return Remap_RGBX_RGBX_Bilinear(dstWidth, dstHeight, pDstImage, dstImageStrideInBytes, 3,
+		srcWidth, srcHeight, pSrcImage, srcImageStrideInBytes, 3, pMap, mapStrideInBytes, remapFractionalBits);
+}
 
-	// do backward mapping to find the (x, y) locations in source corresponding to (x', y') from dest by doing inverse matrix
-	const float r00 = matrix->matrix[0][0];
-	const float r10 = matrix->matrix[0][1];
-	const float r01 = matrix->matrix[1][0];
-	const float r11 = matrix->matrix[1][1];
-	const float const1 = matrix->matrix[2][0];
-	const float const2 = matrix->matrix[2][1];
-
-	const __m128 zero = _mm_set1_ps(0);
-	const __m128i srcbx_i = _mm_set1_epi32(srcWidth);
-	const __m128i srcby_i = _mm_set1_epi32(srcHeight);
-	const __m128 srcbx = _mm_cvtepi32_ps(srcbx_i);
-	const __m128 srcby = _mm_cvtepi32_ps(srcby_i);
-
-	const __m128i p0mask = _mm_set1_epi32((int)0xFF);
-	const __m128 oneFloat = _mm_set1_ps(1.0);
-	srcb = _mm_set1_epi32((srcHeight*srcImageStrideInBytes) - 1);
-	src_s = _mm_set1_epi32(srcImageStrideInBytes);
-
-	XMM128 mask;
-	unsigned int x, y;
-	float *r00_x = (float*)pLocalData;
-	float *r10_x = (float *)ALIGN16(r00_x + dstWidth);
-	for (x = 0; x<dstWidth; x++){
-		r00_x[x] = r00 * x;
-		r10_x[x] = r10 * x;
-	}
-	bool bBoder = (const1 < 0) | (const2 < 0) | (const1 >= srcWidth) | (const2 >= srcHeight);
-	// check for (dstWidth, 0)
-	float x1 = (r00*dstWidth  + const1);
-	float y1 = (r10*dstWidth  + const2);
-	bBoder |= (x1 < 0) | (y1 < 0) | (x1 >= srcWidth) | (y1 >= srcHeight);
-	// check for (0, dstHeight)
-	x1 = (r01*dstHeight + const1);
-	y1 = (r11*dstHeight + const2);
-	bBoder |= (x1 < 0) | (y1 < 0) | (x1 >= srcWidth) | (y1 >= srcHeight);
-	// check for (dstWidth, dstHeight)
-	x1 = (r00*dstWidth + r01*dstHeight + const1);
-	y1 = (r10*dstWidth + r11*dstHeight + const2);
-	bBoder |= (x1 < 0) | (y1 < 0) | (x1 >= srcWidth) | (y1 >= srcHeight);
-
-	y = 0;
-	if (bBoder){
-		__m128i srcb = _mm_set1_epi32((srcHeight-1)*srcImageStrideInBytes - 1);
-		__m128i src_s = _mm_set1_epi32(srcImageStrideInBytes);
-
-		while (y < dstHeight)
-		{
-			// calculate (y*m[0][1] + m[0][2]) for x and y
-			xdest = _mm_set1_ps(y*r01 + const1);
-			ydest = _mm_set1_ps(y*r11 + const2);
+int HafCpu_Remap_U24_U32_Bilinear
+(
+	vx_uint32              dstWidth,
+	vx_uint32              dstHeight,
+	vx_uint8             * pDstImage,
+	vx_uint32              dstImageStrideInBytes,
+	vx_uint32              srcWidth,
+	vx_uint32              srcHeight,
+	vx_uint8             * pSrcImage,
+	vx_uint32              srcImageStrideInBytes,
+	ago_coord2d_ushort_t * pMap,
+	vx_uint32              mapStrideInBytes,
+	vx_uint32              remapFractionalBits
+)
+{
+	return Remap_RGBX_RGBX_Bilinear(dstWidth, dstHeight, pDstImage, dstImageStrideInBytes, 3,
+		srcWidth, srcHeight, pSrcImage, srcImageStrideInBytes, 4, pMap, mapStrideInBytes, remapFractionalBits);
+}
 
-			x = 0;
-			unsigned int *dst = (unsigned int *)pDstImage;
-			while (x < dstWidth)
-			{
-				__m128 xFraction, yFraction, one_minus_xFraction, one_minus_yFraction;
-				__m128 p0_f, p1_f, p2_f, p3_f;
-				__m128i p0, p1, p2, p3, xint, yint;			// pixels in src 
-				unsigned char *psrc;
-
-				// read x into xpel
-				xmap = _mm_load_ps(&r00_x[x]);
-				xmap = _mm_add_ps(xmap, xdest);				// xf = dst[x3, x2, x1, x0]
-				ymap = _mm_load_ps(&r10_x[x]);
-				ymap = _mm_add_ps(ymap, ydest);				// ymap <- r10*x + ty
-
-				mask.f = _mm_cmpge_ps(xmap, zero);
-				mask.f = _mm_and_ps(mask.f, _mm_cmplt_ps(xmap, srcbx));
-				mask.f = _mm_and_ps(mask.f, _mm_cmpge_ps(ymap, zero));
-				mask.f = _mm_and_ps(mask.f, _mm_cmplt_ps(ymap, srcby));
-				int m = _mm_movemask_ps(mask.f);
-				if (m){
-					// convert to integer with rounding towards zero
-					xint = _mm_cvttps_epi32(xmap);
-					yint = _mm_cvttps_epi32(ymap);
-
-					//xFraction = xmap-xint;
-					//yFraction = ymap-yint;
-					xFraction = _mm_cvtepi32_ps(xint);
-					yFraction = _mm_cvtepi32_ps(yint);
-					xFraction = _mm_sub_ps(xmap, xFraction);
-					yFraction = _mm_sub_ps(ymap, yFraction);
-
-					// clip for boundary
-					yint = _mm_mullo_epi32(yint, src_s);
-					yint = _mm_add_epi32(yint, xint);
-					//(1-xFraction)
-					//(1-yFraction)
-					one_minus_xFraction = _mm_sub_ps(oneFloat, xFraction);
-					one_minus_yFraction = _mm_sub_ps(oneFloat, yFraction);
-					yint = _mm_min_epi32(yint, srcb);
-					yint = _mm_max_epi32(yint, zeromask);
-
-					// read pixels from src and re-arrange
-					psrc = pSrcImage + M128I(yint).m128i_u32[0];
-					M128I(p0).m128i_u32[0] = ((unsigned int *)psrc)[0];
-					M128I(p2).m128i_u32[0] = ((unsigned int *)(psrc + srcImageStrideInBytes))[0];
-
-					psrc = pSrcImage + M128I(yint).m128i_u32[1];
-					M128I(p0).m128i_u32[1] = ((unsigned int *)psrc)[0];
-					M128I(p2).m128i_u32[1] = ((unsigned int *)(psrc + srcImageStrideInBytes))[0];
-
-					psrc = pSrcImage + M128I(yint).m128i_u32[2];
-					M128I(p0).m128i_u32[2] = ((unsigned int *)psrc)[0];
-					M128I(p2).m128i_u32[2] = ((unsigned int *)(psrc + srcImageStrideInBytes))[0];
-
-					psrc = pSrcImage + M128I(yint).m128i_u32[3];
-					M128I(p0).m128i_u32[3] = ((unsigned int *)psrc)[0];
-					M128I(p2).m128i_u32[3] = ((unsigned int *)(psrc + srcImageStrideInBytes))[0];
-
-					// get p0, p1, p2, p3 by masking and shifting
-					p1 = p0;
-					p0 = _mm_and_si128(p0, p0mask);
-					p1 = _mm_srli_epi32(p1, 8);
-					p3 = p2;
-					p2 = _mm_and_si128(p2, p0mask);
-					p3 = _mm_srli_epi32(p3, 8);
-					p1 = _mm_and_si128(p1, p0mask);
-					p3 = _mm_and_si128(p3, p0mask);
-
-					p0_f = _mm_cvtepi32_ps(p0);
-					p1_f = _mm_cvtepi32_ps(p1);
-					p2_f = _mm_cvtepi32_ps(p2);
-					p3_f = _mm_cvtepi32_ps(p3);
-
-					p0_f = _mm_mul_ps(p0_f, one_minus_xFraction);
-					p0_f = _mm_mul_ps(p0_f, one_minus_yFraction);
-					p1_f = _mm_mul_ps(p1_f, xFraction);
-					p1_f = _mm_mul_ps(p1_f, one_minus_yFraction);
-					p2_f = _mm_mul_ps(p2_f, one_minus_xFraction);
-					p2_f = _mm_mul_ps(p2_f, yFraction);
-					p3_f = _mm_mul_ps(p3_f, xFraction);
-					p3_f = _mm_mul_ps(p3_f, yFraction);
-
-					p0_f = _mm_add_ps(p0_f, p1_f);
-					p2_f = _mm_add_ps(p2_f, p3_f);
-					p0_f = _mm_add_ps(p0_f, p2_f);
-					p0 = _mm_cvtps_epi32(p0_f);
-					// mask for boundary
-					p0 = _mm_and_si128(mask.i, p0);
-
-					// convert to unsigned char and write to dst
-					p0 = _mm_packus_epi32(p0, zeromask);
-					p0 = _mm_packus_epi16(p0, zeromask);
-					*dst++ = M128I(p0).m128i_i32[0];
-				}
-				else
-				{
-					*dst++ = 0;
-				}
-				x += 4;
-			}
-			y++;
-			pDstImage += dstImageStrideInBytes;
-		}
-	}
-	else{
-		XMM128 xint = { 0 }, yint = { 0 };
-		while (y < dstHeight)
-		{
-			// calculate (y*m[0][1] + m[0][2]) for x and y
-			xdest = _mm_set1_ps(y*r01 + const1);
-			ydest = _mm_set1_ps(y*r11 + const2);
+int HafCpu_Remap_U32_U32_Bilinear
+(
+	vx_uint32              dstWidth,
+	vx_uint32              dstHeight,
+	vx_uint8             * pDstImage,
+	vx_uint32              dstImageStrideInBytes,
+	vx_uint32              srcWidth,
+	vx_uint32              srcHeight,
+	vx_uint8             * pSrcImage,
+	vx_uint32              srcImageStrideInBytes,
+	ago_coord2d_ushort_t * pMap,
+	vx_uint32              mapStrideInBytes,
+	vx_uint32              remapFractionalBits
+)
+{
+	return Remap_RGBX_RGBX_Bilinear(dstWidth, dstHeight, pDstImage, dstImageStrideInBytes, 4,
+		srcWidth, srcHeight, pSrcImage, srcImageStrideInBytes, 4, pMap, mapStrideInBytes, remapFractionalBits);
+}
 
-			x = 0;
-			unsigned int *dst = (unsigned int *)pDstImage;
-			while (x < dstWidth)
-			{
-				__m128 xFraction, yFraction, one_minus_xFraction, one_minus_yFraction;
-				__m128 p0_f, p1_f, p2_f, p3_f;
-				__m128i p0, p1, p2, p3;			// pixels in src 
-				unsigned char *psrc;
-				// read x into xpel
-				xmap = _mm_load_ps(&r00_x[x]);
-				xmap = _mm_add_ps(xmap, xdest);				// xf = dst[x3, x2, x1, x0]
-				ymap = _mm_load_ps(&r10_x[x]);
-				ymap = _mm_add_ps(ymap, ydest);				// ymap <- r10*x + ty
-				// convert to integer with rounding towards zero
-				xint.i = _mm_cvttps_epi32(xmap);
-				yint.i = _mm_cvttps_epi32(ymap);
-
-				//xFraction = xmap-xint;
-				//yFraction = ymap-yint;
-				xFraction = _mm_cvtepi32_ps(xint.i);
-				yFraction = _mm_cvtepi32_ps(yint.i);
-				xFraction = _mm_sub_ps(xmap, xFraction);
-				yFraction = _mm_sub_ps(ymap, yFraction);
-
-				//(1-xFraction)
-				//(1-yFraction)
-				one_minus_xFraction = _mm_sub_ps(oneFloat, xFraction);
-				one_minus_yFraction = _mm_sub_ps(oneFloat, yFraction);
-
-				// read pixels from src and re-arrange
-				psrc = pSrcImage + (yint.s32[0] * srcImageStrideInBytes + xint.s32[0]);
-				M128I(p0).m128i_u32[0] = ((unsigned int *)psrc)[0];
-				M128I(p2).m128i_u32[0] = ((unsigned int *)(psrc + srcImageStrideInBytes))[0];
-
-				psrc = pSrcImage + (yint.s32[1] * srcImageStrideInBytes + xint.s32[1]);
-				M128I(p0).m128i_u32[1] = ((unsigned int *)psrc)[0];
-				M128I(p2).m128i_u32[1] = ((unsigned int *)(psrc + srcImageStrideInBytes))[0];
-
-				psrc = pSrcImage + (yint.s32[2] * srcImageStrideInBytes + xint.s32[2]);
-				M128I(p0).m128i_u32[2] = ((unsigned int *)psrc)[0];
-				M128I(p2).m128i_u32[2] = ((unsigned int *)(psrc + srcImageStrideInBytes))[0];
-
-				psrc = pSrcImage + (yint.s32[3] * srcImageStrideInBytes + xint.s32[3]);
-				M128I(p0).m128i_u32[3] = ((unsigned int *)psrc)[0];
-				M128I(p2).m128i_u32[3] = ((unsigned int *)(psrc + srcImageStrideInBytes))[0];
-
-				// get p0, p1, p2, p3 by masking and shifting
-				p1 = p0;
-				p0 = _mm_and_si128(p0, p0mask);
-				p1 = _mm_srli_epi32(p1, 8);
-				p3 = p2;
-				p2 = _mm_and_si128(p2, p0mask);
-				p3 = _mm_srli_epi32(p3, 8);
-				p1 = _mm_and_si128(p1, p0mask);
-				p3 = _mm_and_si128(p3, p0mask);
-
-				p0_f = _mm_cvtepi32_ps(p0);
-				p1_f = _mm_cvtepi32_ps(p1);
-				p2_f = _mm_cvtepi32_ps(p2);
-				p3_f = _mm_cvtepi32_ps(p3);
-
-				p0_f = _mm_mul_ps(p0_f, one_minus_xFraction);
-				p0_f = _mm_mul_ps(p0_f, one_minus_yFraction);
-				p1_f = _mm_mul_ps(p1_f, xFraction);
-				p1_f = _mm_mul_ps(p1_f, one_minus_yFraction);
-				p2_f = _mm_mul_ps(p2_f, one_minus_xFraction);
-				p2_f = _mm_mul_ps(p2_f, yFraction);
-				p3_f = _mm_mul_ps(p3_f, xFraction);
-				p3_f = _mm_mul_ps(p3_f, yFraction);
-
-				p0_f = _mm_add_ps(p0_f, p1_f);
-				p2_f = _mm_add_ps(p2_f, p3_f);
-				p0_f = _mm_add_ps(p0_f, p2_f);
-				p0 = _mm_cvtps_epi32(p0_f);
-
-				// convert to unsigned char and write to dst
-				p0 = _mm_packus_epi32(p0, zeromask);
-				p0 = _mm_packus_epi16(p0, zeromask);
-				*dst++ = M128I(p0).m128i_i32[0];
-				x += 4;
-			}
-			y++;
-			pDstImage += dstImageStrideInBytes;
+// Band-parallel warp engine shared by the affine and perspective kernels.
+// Source coordinates are generated per row from the row constant plus the column term
+// (m00 * x, m01 * x) with an exactly incremented float column vector, so there is no
+// coordinate drift across the row and no per-node coordinate tables are needed.
+// For perspective matrices with m02 == 0 the denominator is constant along each row,
+// so one reciprocal per row is used instead of a division per pixel.
+//   sx = (m00 x + m10 y + m20) / (m02 x + m12 y + m22)
+//   sy = (m01 x + m11 y + m21) / (m02 x + m12 y + m22)
+// Nearest and bilinear both use floor of the source coordinate, bilinear with four taps.
+// Replicate (and undefined) border clamps the source coordinate to the image, which is
+// identical to clamping each tap. Constant border substitutes the border value for taps outside.
+typedef struct {
+	vx_uint32     dstWidth;
+	vx_uint32     dstHeight;
+	vx_uint8    * pDstImage;
+	vx_uint32     dstImageStrideInBytes;
+	vx_uint32     srcWidth;
+	vx_uint32     srcHeight;
+	vx_uint8    * pSrcImage;
+	vx_uint32     srcImageStrideInBytes;
+	vx_float32    m[3][3];
+	bool          perspective;
+	bool          bilinear;
+	bool          constantBorder;
+	vx_uint8      border;
+} WarpBandData;
+
+typedef struct {
+	vx_float32    nx, ax;		// sx numerator = nx + ax * x
+	vx_float32    ny, ay;		// sy numerator = ny + ay * x
+	vx_float32    nz, az;		// denominator  = nz + az * x
+	bool          divide;		// false when the denominator is constant along the row (already applied)
+} WarpRowCoeffs;
+
+static inline void Warp_RowCoeffs(const WarpBandData * data, vx_uint32 y, WarpRowCoeffs * row)
+{
+	vx_float32 fy = (vx_float32)y;
+	row->nx = data->m[1][0] * fy + data->m[2][0];
+	row->ny = data->m[1][1] * fy + data->m[2][1];
+	row->ax = data->m[0][0];
+	row->ay = data->m[0][1];
+	row->nz = 1.0f;
+	row->az = 0.0f;
+	row->divide = false;
+	if (data->perspective) {
+		row->nz = data->m[1][2] * fy + data->m[2][2];
+		row->az = data->m[0][2];
+		if (row->az == 0.0f) {
+			// constant denominator along the row
+			vx_float32 rcp = 1.0f / row->nz;
+			row->nx *= rcp; row->ax *= rcp;
+			row->ny *= rcp; row->ay *= rcp;
 		}
+		else row->divide = true;
 	}
-	return AGO_SUCCESS;
 }
 
-// the implementation currently uses floating point.
-// TODO:: used fixed point for bilinear interpolation. We can do 8 pixels in the innel loop.
-int HafCpu_WarpAffine_U8_U8_Bilinear_Constant
-(
-vx_uint32             dstWidth,
-vx_uint32             dstHeight,
-vx_uint8            * pDstImage,
-vx_uint32             dstImageStrideInBytes,
-vx_uint32             srcWidth,
-vx_uint32             srcHeight,
-vx_uint8            * pSrcImage,
-vx_uint32             srcImageStrideInBytes,
-ago_affine_matrix_t * matrix,
-vx_uint8              border,
-vx_uint8			* pLocalData
-)
+static inline vx_uint8 Warp_Tap(const WarpBandData * data, vx_int32 x, vx_int32 y)
 {
-	__m128  ymap, xmap, ydest, xdest;
-	__m128i srcb, src_s;
-	const unsigned int u32_border = border | (border << 8) | (border << 16) | (border << 24);
-	const __m128i zeromask = _mm_setzero_si128();
-	const __m128i one = _mm_set1_epi32(1);
-	const __m128i pborder = _mm_set1_epi32((int)border);	
-
-	// do backward mapping to find the (x, y) locations in source corresponding to (x', y') from dest by doing inverse matrix
-	const float r00 = matrix->matrix[0][0];
-	const float r10 = matrix->matrix[0][1];
-	const float r01 = matrix->matrix[1][0];
-	const float r11 = matrix->matrix[1][1];
-	const float const1 = matrix->matrix[2][0];
-	const float const2 = matrix->matrix[2][1];
-
-	const __m128 zero = _mm_set1_ps(0);
-	const __m128i srcbx_i = _mm_set1_epi32(srcWidth);
-	const __m128i srcby_i = _mm_set1_epi32(srcHeight);
-	const __m128 srcbx = _mm_cvtepi32_ps(srcbx_i);
-	const __m128 srcby = _mm_cvtepi32_ps(srcby_i);
-
-	const __m128i p0mask = _mm_set1_epi32((int)0xFF);
-	const __m128 oneFloat = _mm_set1_ps(1.0);
-	srcb = _mm_set1_epi32((srcHeight-1)*srcImageStrideInBytes - 1);
-	src_s = _mm_set1_epi32(srcImageStrideInBytes);
-
-	XMM128 xint = { 0 }, yint = { 0 }, mask;
-	unsigned int x, y;
-	float *r00_x = (float*)pLocalData;
-	float *r10_x = (float *)ALIGN16(r00_x + dstWidth);
-	for (x = 0; x<dstWidth; x++){
-		r00_x[x] = r00 * x;
-		r10_x[x] = r10 * x;
+	if (data->constantBorder) {
+		if (x < 0 || y < 0 || x >= (vx_int32)data->srcWidth || y >= (vx_int32)data->srcHeight)
+			return data->border;
 	}
-	bool bBoder = (const1 < 0) | (const2 < 0) | (const1 >= srcWidth) | (const2 >= srcHeight);
-	// check for (dstWidth, 0)
-	float x1 = (r00*dstWidth + const1);
-	float y1 = (r10*dstWidth + const2);
-	bBoder |= (x1 < 0) | (y1 < 0) | (x1 >= srcWidth) | (y1 >= srcHeight);
-	// check for (0, dstHeight)
-	x1 = (r01*dstHeight + const1);
-	y1 = (r11*dstHeight + const2);
-	bBoder |= (x1 < 0) | (y1 < 0) | (x1 >= srcWidth) | (y1 >= srcHeight);
-	// check for (dstWidth, dstHeight)
-	x1 = (r00*dstWidth + r01*dstHeight + const1);
-	y1 = (r10*dstWidth + r11*dstHeight + const2);
-	bBoder |= (x1 < 0) | (y1 < 0) | (x1 >= srcWidth) | (y1 >= srcHeight);
-
-	y = 0;
-	if (bBoder){
-		while (y < dstHeight)
-		{
-			// calculate (y*m[0][1] + m[0][2]) for x and y
-			xdest = _mm_set1_ps(y*r01 + const1);
-			ydest = _mm_set1_ps(y*r11 + const2);
-
-			unsigned int x = 0;
-			unsigned int *dst = (unsigned int *)pDstImage;
-			while (x < dstWidth)
-			{
-				__m128 xFraction, yFraction, one_minus_xFraction, one_minus_yFraction;
-				__m128 p0_f, p1_f, p2_f, p3_f;
-				__m128i p0, p1, p2, p3;			// pixels in src 
-				unsigned char *psrc;
-
-				// read x into xpel
-				xmap = _mm_load_ps(&r00_x[x]);
-				xmap = _mm_add_ps(xmap, xdest);				// xf = dst[x3, x2, x1, x0]
-				ymap = _mm_load_ps(&r10_x[x]);
-				ymap = _mm_add_ps(ymap, ydest);				// ymap <- r10*x + ty
-
-				mask.f = _mm_cmpge_ps(xmap, zero);
-				mask.f = _mm_and_ps(mask.f, _mm_cmplt_ps(xmap, srcbx));
-				mask.f = _mm_and_ps(mask.f, _mm_cmpge_ps(ymap, zero));
-				mask.f = _mm_and_ps(mask.f, _mm_cmplt_ps(ymap, srcby));
-				int m = _mm_movemask_ps(mask.f);
-				if (m){
-					// convert to integer with rounding towards zero
-					xint.i = _mm_cvttps_epi32(xmap);
-					yint.i = _mm_cvttps_epi32(ymap);
-
-					//xFraction = xmap-xint;
-					//yFraction = ymap-yint;
-					xFraction = _mm_cvtepi32_ps(xint.i);
-					yFraction = _mm_cvtepi32_ps(yint.i);
-					xFraction = _mm_sub_ps(xmap, xFraction);
-					yFraction = _mm_sub_ps(ymap, yFraction);
-					
-					yint.i = _mm_mullo_epi32(yint.i, src_s);
-					yint.i = _mm_add_epi32(yint.i, xint.i);
-					//(1-xFraction)
-					//(1-yFraction)
-					one_minus_xFraction = _mm_sub_ps(oneFloat, xFraction);
-					one_minus_yFraction = _mm_sub_ps(oneFloat, yFraction);
-					yint.i = _mm_min_epi32(yint.i, srcb);
-					yint.i = _mm_max_epi32(yint.i, zeromask);
-
-					// read pixels from src and re-arrange
-					psrc = pSrcImage + yint.s32[0];
-					M128I(p0).m128i_u32[0] = ((unsigned int *)psrc)[0];
-					M128I(p2).m128i_u32[0] = ((unsigned int *)(psrc + srcImageStrideInBytes))[0];
-
-					psrc = pSrcImage + yint.s32[1];
-					M128I(p0).m128i_u32[1] = ((unsigned int *)psrc)[0];
-					M128I(p2).m128i_u32[1] = ((unsigned int *)(psrc + srcImageStrideInBytes))[0];
-
-					psrc = pSrcImage + yint.s32[2];
-					M128I(p0).m128i_u32[2] = ((unsigned int *)psrc)[0];
-					M128I(p2).m128i_u32[2] = ((unsigned int *)(psrc + srcImageStrideInBytes))[0];
-
-					psrc = pSrcImage + yint.s32[3];
-					M128I(p0).m128i_u32[3] = ((unsigned int *)psrc)[0];
-					M128I(p2).m128i_u32[3] = ((unsigned int *)(psrc + srcImageStrideInBytes))[0];
-
-					// get p0, p1, p2, p3 by masking and shifting
-					p1 = p0;
-					p0 = _mm_and_si128(p0, p0mask);
-					p1 = _mm_srli_epi32(p1, 8);
-					p3 = p2;
-					p2 = _mm_and_si128(p2, p0mask);
-					p3 = _mm_srli_epi32(p3, 8);
-					p1 = _mm_and_si128(p1, p0mask);
-					p3 = _mm_and_si128(p3, p0mask);
-
-					p0_f = _mm_cvtepi32_ps(p0);
-					p1_f = _mm_cvtepi32_ps(p1);
-					p2_f = _mm_cvtepi32_ps(p2);
-					p3_f = _mm_cvtepi32_ps(p3);
-
-					p0_f = _mm_mul_ps(p0_f, one_minus_xFraction);
-					p0_f = _mm_mul_ps(p0_f, one_minus_yFraction);
-					p1_f = _mm_mul_ps(p1_f, xFraction);
-					p1_f = _mm_mul_ps(p1_f, one_minus_yFraction);
-					p2_f = _mm_mul_ps(p2_f, one_minus_xFraction);
-					p2_f = _mm_mul_ps(p2_f, yFraction);
-					p3_f = _mm_mul_ps(p3_f, xFraction);
-					p3_f = _mm_mul_ps(p3_f, yFraction);
-
-					p0_f = _mm_add_ps(p0_f, p1_f);
-					p2_f = _mm_add_ps(p2_f, p3_f);
-					p0_f = _mm_add_ps(p0_f, p2_f);
-					p0 = _mm_cvtps_epi32(p0_f);
-					// mask for boundary
-					p0 = _mm_and_si128(mask.i, p0);
-					p0 = _mm_or_si128(p0, _mm_andnot_si128(mask.i, pborder));			// combined result
-
-					// convert to unsigned char and write to dst
-					p0 = _mm_packus_epi32(p0, zeromask);
-					p0 = _mm_packus_epi16(p0, zeromask);
-					*dst++ = M128I(p0).m128i_i32[0];
-				}
-				else
-				{
-					*dst++ = u32_border;
-				}
-				x += 4;
-			}
-			y++;
-			pDstImage += dstImageStrideInBytes;
-		}
+	else {
+		x = min(max(x, 0), (vx_int32)data->srcWidth - 1);
+		y = min(max(y, 0), (vx_int32)data->srcHeight - 1);
 	}
-	else{
-		while (y < dstHeight)
-		{
-			// calculate (y*m[0][1] + m[0][2]) for x and y
-			xdest = _mm_set1_ps(y*r01 + const1);
-			ydest = _mm_set1_ps(y*r11 + const2);
+	return data->pSrcImage[y * data->srcImageStrideInBytes + x];
+}
 
-			unsigned int x = 0;
-			unsigned int *dst = (unsigned int *)pDstImage;
-			while (x < dstWidth)
-			{
-				__m128 xFraction, yFraction, one_minus_xFraction, one_minus_yFraction;
-				__m128 p0_f, p1_f, p2_f, p3_f;
-				__m128i p0, p1, p2, p3;			// pixels in src 
-				unsigned char *psrc;
-				// read x into xpel
-				xmap = _mm_load_ps(&r00_x[x]);
-				xmap = _mm_add_ps(xmap, xdest);				// xf = dst[x3, x2, x1, x0]
-				ymap = _mm_load_ps(&r10_x[x]);
-				ymap = _mm_add_ps(ymap, ydest);				// ymap <- r10*x + ty
-				// convert to integer with rounding towards zero
-				xint.i = _mm_cvttps_epi32(xmap);
-				yint.i = _mm_cvttps_epi32(ymap);
-
-				//xFraction = xmap-xint;
-				//yFraction = ymap-yint;
-				xFraction = _mm_cvtepi32_ps(xint.i);
-				yFraction = _mm_cvtepi32_ps(yint.i);
-				xFraction = _mm_sub_ps(xmap, xFraction);
-				yFraction = _mm_sub_ps(ymap, yFraction);
-
-				//(1-xFraction)
-				//(1-yFraction)
-				one_minus_xFraction = _mm_sub_ps(oneFloat, xFraction);
-				one_minus_yFraction = _mm_sub_ps(oneFloat, yFraction);
-
-				// read pixels from src and re-arrange
-				psrc = pSrcImage + (yint.s32[0] * srcImageStrideInBytes + xint.s32[0]);
-				M128I(p0).m128i_u32[0] = ((unsigned int *)psrc)[0];
-				M128I(p2).m128i_u32[0] = ((unsigned int *)(psrc + srcImageStrideInBytes))[0];
-
-				psrc = pSrcImage + (yint.s32[1] * srcImageStrideInBytes + xint.s32[1]);
-				M128I(p0).m128i_u32[1] = ((unsigned int *)psrc)[0];
-				M128I(p2).m128i_u32[1] = ((unsigned int *)(psrc + srcImageStrideInBytes))[0];
-
-				psrc = pSrcImage + (yint.s32[2] * srcImageStrideInBytes + xint.s32[2]);
-				M128I(p0).m128i_u32[2] = ((unsigned int *)psrc)[0];
-				M128I(p2).m128i_u32[2] = ((unsigned int *)(psrc + srcImageStrideInBytes))[0];
-
-				psrc = pSrcImage + (yint.s32[3] * srcImageStrideInBytes + xint.s32[3]);
-				M128I(p0).m128i_u32[3] = ((unsigned int *)psrc)[0];
-				M128I(p2).m128i_u32[3] = ((unsigned int *)(psrc + srcImageStrideInBytes))[0];
-
-				// get p0, p1, p2, p3 by masking and shifting
-				p1 = p0;
-				p0 = _mm_and_si128(p0, p0mask);
-				p1 = _mm_srli_epi32(p1, 8);
-				p3 = p2;
-				p2 = _mm_and_si128(p2, p0mask);
-				p3 = _mm_srli_epi32(p3, 8);
-				p1 = _mm_and_si128(p1, p0mask);
-				p3 = _mm_and_si128(p3, p0mask);
-
-				p0_f = _mm_cvtepi32_ps(p0);
-				p1_f = _mm_cvtepi32_ps(p1);
-				p2_f = _mm_cvtepi32_ps(p2);
-				p3_f = _mm_cvtepi32_ps(p3);
-
-				p0_f = _mm_mul_ps(p0_f, one_minus_xFraction);
-				p0_f = _mm_mul_ps(p0_f, one_minus_yFraction);
-				p1_f = _mm_mul_ps(p1_f, xFraction);
-				p1_f = _mm_mul_ps(p1_f, one_minus_yFraction);
-				p2_f = _mm_mul_ps(p2_f, one_minus_xFraction);
-				p2_f = _mm_mul_ps(p2_f, yFraction);
-				p3_f = _mm_mul_ps(p3_f, xFraction);
-				p3_f = _mm_mul_ps(p3_f, yFraction);
-
-				p0_f = _mm_add_ps(p0_f, p1_f);
-				p2_f = _mm_add_ps(p2_f, p3_f);
-				p0_f = _mm_add_ps(p0_f, p2_f);
-				p0 = _mm_cvtps_epi32(p0_f);
-
-				// convert to unsigned char and write to dst
-				p0 = _mm_packus_epi32(p0, zeromask);
-				p0 = _mm_packus_epi16(p0, zeromask);
-				*dst++ = M128I(p0).m128i_i32[0];
-				x += 4;
-			}
-			y++;
-			pDstImage += dstImageStrideInBytes;
+// per pixel path for sources too small for the vector gathers
+static void Warp_Row_Scalar(const WarpBandData * data, const WarpRowCoeffs * row, vx_uint8 * pDst)
+{
+	const vx_float32 xMax = (vx_float32)data->srcWidth, yMax = (vx_float32)data->srcHeight;
+	for (vx_uint32 x = 0; x < data->dstWidth; x++) {
+		vx_float32 fx = row->nx + row->ax * (vx_float32)x;
+		vx_float32 fy = row->ny + row->ay * (vx_float32)x;
+		if (row->divide) {
+			vx_float32 z = row->nz + row->az * (vx_float32)x;
+			fx /= z; fy /= z;
+		}
+		// keep the coordinates within a range that converts to integers safely (NaN goes to the lower bound)
+		fx = min(_mm_cvtss_f32(_mm_max_ss(_mm_set_ss(fx), _mm_set_ss(-2.0f))), xMax);
+		fy = min(_mm_cvtss_f32(_mm_max_ss(_mm_set_ss(fy), _mm_set_ss(-2.0f))), yMax);
+		if (!data->bilinear) {
+			pDst[x] = Warp_Tap(data, (vx_int32)floorf(fx), (vx_int32)floorf(fy));
+		}
+		else {
+			vx_float32 fx0 = floorf(fx), fy0 = floorf(fy);
+			vx_float32 wx = fx - fx0, wy = fy - fy0;
+			vx_int32 x0 = (vx_int32)fx0, y0 = (vx_int32)fy0;
+			vx_float32 p00 = Warp_Tap(data, x0, y0), p01 = Warp_Tap(data, x0 + 1, y0);
+			vx_float32 p10 = Warp_Tap(data, x0, y0 + 1), p11 = Warp_Tap(data, x0 + 1, y0 + 1);
+			vx_float32 top = p00 + wx * (p01 - p00);
+			vx_float32 bot = p10 + wx * (p11 - p10);
+			pDst[x] = (vx_uint8)_mm_cvtss_si32(_mm_set_ss(top + wy * (bot - top)));
 		}
 	}
-
-	return AGO_SUCCESS;
 }
 
-int HafCpu_WarpPerspective_U8_U8_Nearest
-(
-vx_uint32                  dstWidth,
-vx_uint32                  dstHeight,
-vx_uint8                 * pDstImage,
-vx_uint32                  dstImageStrideInBytes,
-vx_uint32                  srcWidth,
-vx_uint32                  srcHeight,
-vx_uint8                 * pSrcImage,
-vx_uint32                  srcImageStrideInBytes,
-ago_perspective_matrix_t * matrix,
-vx_uint8				 * pLocalData
-)
+static inline __m128i Warp_Gather_SSE(const vx_uint8 * pSrc, __m128i offset, bool pair)
 {
-	return HafCpu_WarpPerspective_U8_U8_Nearest_Constant(dstWidth, dstHeight, pDstImage, dstImageStrideInBytes, srcWidth,
-		srcHeight, pSrcImage, srcImageStrideInBytes, matrix, (unsigned char)0, pLocalData);
+	XMM128 o; o.i = offset;
+	if (pair) {
+		return _mm_setr_epi32(pSrc[o.s32[0]] | (pSrc[o.s32[0] + 1] << 8), pSrc[o.s32[1]] | (pSrc[o.s32[1] + 1] << 8),
+			pSrc[o.s32[2]] | (pSrc[o.s32[2] + 1] << 8), pSrc[o.s32[3]] | (pSrc[o.s32[3] + 1] << 8));
+	}
+	return _mm_setr_epi32(pSrc[o.s32[0]], pSrc[o.s32[1]], pSrc[o.s32[2]], pSrc[o.s32[3]]);
 }
 
+static inline __m128i Warp_Taps_SSE(__m128i pair, __m128i selLo, __m128i selHi, __m128i border)
+{
+	const __m128i mask = _mm_set1_epi32(0xff);
+	__m128i lo = _mm_and_si128(pair, mask);
+	__m128i hi = _mm_srli_epi32(pair, 8);
+	return _mm_blendv_epi8(_mm_blendv_epi8(border, hi, selHi), lo, selLo);
+}
 
-// This alogorithm implements Constant Denominator method described in 
-// " A Novel Architechture for real time sprite decoding".
-// The idea is to do perpective warping along the lines of constant divisor..
-// The number of floating point divisions are reduced from O(Nsqared) to O(N)
-/*
-	forward mapping: 
-		x' = (ax+by+c)/(gx+hy+1)
-		y' = (dx+ey+f)/(gx+hy+1)
-	backward mapping:
-		x  = ((hf-e)x'+(b-hc)y'+(ec-bf))/(eg-dh)x'+(ah-bg)y'+(db-ae))
-		y  = ((d-fg)x'+(cg-a)y'+(af-dc))/(eg-dh)x'+(ah-bg)y'+(db-ae))
-
-*/
-
+static inline __m128i Warp_Interpolate_SSE(__m128i p00, __m128i p01, __m128i p10, __m128i p11, __m128 wx, __m128 wy)
+{
+	__m128 f00 = _mm_cvtepi32_ps(p00), f01 = _mm_cvtepi32_ps(p01);
+	__m128 f10 = _mm_cvtepi32_ps(p10), f11 = _mm_cvtepi32_ps(p11);
+	__m128 top = _mm_add_ps(f00, _mm_mul_ps(wx, _mm_sub_ps(f01, f00)));
+	__m128 bot = _mm_add_ps(f10, _mm_mul_ps(wx, _mm_sub_ps(f11, f10)));
+	return _mm_cvtps_epi32(_mm_add_ps(top, _mm_mul_ps(wy, _mm_sub_ps(bot, top))));
+}
 
-int HafCpu_WarpPerspective_U8_U8_Nearest_Constant
-(
-vx_uint32                  dstWidth,
-vx_uint32                  dstHeight,
-vx_uint8                 * pDstImage,
-vx_uint32                  dstImageStrideInBytes,
-vx_uint32                  srcWidth,
-vx_uint32                  srcHeight,
-vx_uint8                 * pSrcImage,
-vx_uint32                  srcImageStrideInBytes,
-ago_perspective_matrix_t * matrix,
-vx_uint8                   border,
-vx_uint8				 * pLocalData
-)
+static void Warp_Row_SSE(const WarpBandData * data, const WarpRowCoeffs * row, vx_uint8 * pDst)
 {
-	// calculate inverse mapping coefficients for x and y
-	const float a = matrix->matrix[0][0];				
-	const float d = matrix->matrix[0][1];
-	const float g = matrix->matrix[0][2];
-	const float b = matrix->matrix[1][0];
-	const float e = matrix->matrix[1][1];
-	const float h = matrix->matrix[1][2];
-	const float c = matrix->matrix[2][0];		
-	const float f = matrix->matrix[2][1];		
-	const float i = matrix->matrix[2][2];
-
-	// can't assume if end points in the warped image is within boundary, all the warped image is within boundary
-	bool bBoder = 1;
-
-	XMM128 mask;
-	__m128 xdest, ydest, zdest;
-	const __m128i zeromask = _mm_setzero_si128();
+	const vx_uint8 * pSrc = data->pSrcImage;
+	const __m128i stride = _mm_set1_epi32((int)data->srcImageStrideInBytes);
+	const __m128i border = _mm_set1_epi32((int)data->border);
+	const __m128i mask = _mm_set1_epi32(0xff);
 	const __m128i one = _mm_set1_epi32(1);
-	const __m128i pborder = _mm_set1_epi32((int)border);	
-	const __m128i srcb = _mm_set1_epi32((srcHeight*srcImageStrideInBytes) - 1);
-	const __m128i src_s = _mm_set1_epi32(srcImageStrideInBytes);
-	const __m128 zero = _mm_set1_ps(0);
-	const __m128 srcbx = _mm_set1_ps((float)srcWidth);
-	const __m128 srcby = _mm_set1_ps((float)srcHeight);
-	const __m128 oneFloat = _mm_set1_ps(1.0);
-
-	unsigned int x;
-	float *A_x = (float*)pLocalData;
-	float *D_x = (float *)ALIGN16(A_x + dstWidth);
-	float *G_x = (float *)ALIGN16(D_x + dstWidth);
-	for (x = 0; x<dstWidth; x++){
-		A_x[x] = a * x;
-		D_x[x] = d * x;
-		G_x[x] = g * x;			// (eg - dh)
-	}
-
-	unsigned int y = 0;
-	// do the plain vanilla version with floating point division in inner_loop
-	if (bBoder){
-		while (y < dstHeight)
-		{
-			xdest = _mm_set1_ps(y*b + c);
-			ydest = _mm_set1_ps(y*e + f);
-			zdest = _mm_set1_ps(y*h + i);
-			x = 0;
-			unsigned int *dst = (unsigned int *)pDstImage;
-			while (x < dstWidth)
-			{
-				__m128 xmap, ymap, zmap;
-				__m128i xpels, ypels;
-
-				zmap = _mm_load_ps(&G_x[x]);
-				xmap = _mm_load_ps(&A_x[x]);
-				zmap = _mm_add_ps(zmap, zdest);
-				ymap = _mm_load_ps(&D_x[x]);
-				zmap = _mm_div_ps(oneFloat, zmap);
-				xmap = _mm_add_ps(xmap, xdest);				
-				ymap = _mm_add_ps(ymap, ydest);				
-				xmap = _mm_mul_ps(xmap, zmap);
-				ymap = _mm_mul_ps(ymap, zmap);
-
-				mask.f = _mm_cmpge_ps(xmap, zero);
-				mask.f = _mm_and_ps(mask.f, _mm_cmplt_ps(xmap, srcbx));
-				mask.f = _mm_and_ps(mask.f, _mm_cmpge_ps(ymap, zero));
-				mask.f = _mm_and_ps(mask.f, _mm_cmplt_ps(ymap, srcby));
-
-				// convert to integer with rounding towards zero
-				xpels = _mm_cvttps_epi32(xmap);
-				ypels = _mm_cvttps_epi32(ymap);
-				// multiply ydest*srcImageStrideInBytes
-				ypels = _mm_mullo_epi32(ypels, src_s);
-				ypels = _mm_add_epi32(ypels, xpels);			// pixel location at src for dst image.
-
-				// check if the values exceed boundary and clamp it to boundary :: need to do this to avoid memory access violations
-				ypels = _mm_min_epi32(ypels, srcb);
-				ypels = _mm_max_epi32(ypels, zeromask);
-
-				// check if the values exceed boundary and clamp it to boundary
-				xpels = _mm_set_epi32(pSrcImage[M128I(ypels).m128i_i32[3]], pSrcImage[M128I(ypels).m128i_i32[2]], pSrcImage[M128I(ypels).m128i_i32[1]], pSrcImage[M128I(ypels).m128i_i32[0]]);
-				// mask for boundary
-				xpels = _mm_and_si128(xpels, mask.i);
-				xpels = _mm_or_si128(xpels, _mm_andnot_si128(mask.i, pborder));			// combined result
-
-				// convert to unsigned char and write to dst
-				xpels = _mm_packus_epi32(xpels, zeromask);
-				xpels = _mm_packus_epi16(xpels, zeromask);
-				*dst++ = M128I(xpels).m128i_i32[0];
-				x += 4;
-			}
-			y++;
-			pDstImage += dstImageStrideInBytes;
+	const __m128i izero = _mm_setzero_si128();
+	const __m128i yLast = _mm_set1_epi32((int)data->srcHeight - 1);
+	const __m128i xLast2 = _mm_set1_epi32((int)data->srcWidth - 2), yLast2 = _mm_set1_epi32((int)data->srcHeight - 2);
+	const __m128 zero = _mm_setzero_ps(), lowLimit = _mm_set1_ps(-2.0f);
+	const __m128 xMax = _mm_set1_ps((float)data->srcWidth), yMax = _mm_set1_ps((float)data->srcHeight);
+	const __m128 xMax1 = _mm_set1_ps((float)(data->srcWidth - 1)), yMax1 = _mm_set1_ps((float)(data->srcHeight - 1));
+	const __m128 nx = _mm_set1_ps(row->nx), ax = _mm_set1_ps(row->ax);
+	const __m128 ny = _mm_set1_ps(row->ny), ay = _mm_set1_ps(row->ay);
+	const __m128 nz = _mm_set1_ps(row->nz), az = _mm_set1_ps(row->az);
+	const __m128 four = _mm_set1_ps(4.0f);
+	__m128 xf = _mm_setr_ps(0.0f, 1.0f, 2.0f, 3.0f);
+	for (vx_uint32 x = 0; x < data->dstWidth; x += 4, xf = _mm_add_ps(xf, four)) {
+		__m128 fx = _mm_add_ps(nx, _mm_mul_ps(ax, xf));
+		__m128 fy = _mm_add_ps(ny, _mm_mul_ps(ay, xf));
+		if (row->divide) {
+			__m128 z = _mm_add_ps(nz, _mm_mul_ps(az, xf));
+			fx = _mm_div_ps(fx, z);
+			fy = _mm_div_ps(fy, z);
 		}
-	}
-	else{
-		while (y < dstHeight)
-		{
-			xdest = _mm_set1_ps(y*b + c);
-			ydest = _mm_set1_ps(y*e + f);
-			zdest = _mm_set1_ps(y*h + i);
-			unsigned int *dst = (unsigned int *)pDstImage;
-			x = 0;
-			while (x < dstWidth)
-			{
-				__m128 xmap, ymap, zmap;
-				__m128i xpels, ypels;
-
-				zmap = _mm_load_ps(&G_x[x]);
-				xmap = _mm_load_ps(&A_x[x]);
-				zmap = _mm_add_ps(zmap, zdest);
-				ymap = _mm_load_ps(&D_x[x]);
-				zmap = _mm_div_ps(oneFloat, zmap);
-				xmap = _mm_add_ps(xmap, xdest);				
-				ymap = _mm_add_ps(ymap, ydest);				
-				xmap = _mm_mul_ps(xmap, zmap);
-				ymap = _mm_mul_ps(ymap, zmap);
-
-				// convert to integer with rounding towards zero
-				xpels = _mm_cvttps_epi32(xmap);
-				ypels = _mm_cvttps_epi32(ymap);
-				// multiply ydest*srcImageStrideInBytes
-				ypels = _mm_mullo_epi32(ypels, src_s);
-				ypels = _mm_add_epi32(ypels, xpels);			// pixel location at src for dst image.
-
-				// check if the values exceed boundary and clamp it to boundary
-				xpels = _mm_set_epi32(pSrcImage[M128I(ypels).m128i_i32[3]], pSrcImage[M128I(ypels).m128i_i32[2]], pSrcImage[M128I(ypels).m128i_i32[1]], pSrcImage[M128I(ypels).m128i_i32[0]]);
-				// convert to unsigned char and write to dst
-				xpels = _mm_packus_epi32(xpels, zeromask);
-				xpels = _mm_packus_epi16(xpels, zeromask);
-				*dst++ = M128I(xpels).m128i_i32[0];
-				x += 4;
-			}
-			y++;
-			pDstImage += dstImageStrideInBytes;
+		__m128i v;
+		if (!data->bilinear) {
+			__m128 valid = _mm_and_ps(_mm_and_ps(_mm_cmpge_ps(fx, zero), _mm_cmplt_ps(fx, xMax)),
+				_mm_and_ps(_mm_cmpge_ps(fy, zero), _mm_cmplt_ps(fy, yMax)));
+			fx = _mm_min_ps(_mm_max_ps(fx, zero), xMax1);
+			fy = _mm_min_ps(_mm_max_ps(fy, zero), yMax1);
+			__m128i offset = _mm_add_epi32(_mm_mullo_epi32(_mm_cvttps_epi32(fy), stride), _mm_cvttps_epi32(fx));
+			v = Warp_Gather_SSE(pSrc, offset, false);
+			if (data->constantBorder)
+				v = _mm_blendv_epi8(border, v, _mm_castps_si128(valid));
+		}
+		else if (!data->constantBorder) {
+			fx = _mm_min_ps(_mm_max_ps(fx, zero), xMax1);
+			fy = _mm_min_ps(_mm_max_ps(fy, zero), yMax1);
+			__m128i x0 = _mm_min_epi32(_mm_cvttps_epi32(fx), xLast2);
+			__m128i y0 = _mm_min_epi32(_mm_cvttps_epi32(fy), yLast2);
+			__m128 wx = _mm_sub_ps(fx, _mm_cvtepi32_ps(x0));
+			__m128 wy = _mm_sub_ps(fy, _mm_cvtepi32_ps(y0));
+			__m128i offset = _mm_add_epi32(_mm_mullo_epi32(y0, stride), x0);
+			__m128i pa = Warp_Gather_SSE(pSrc, offset, true);
+			__m128i pb = Warp_Gather_SSE(pSrc, _mm_add_epi32(offset, stride), true);
+			v = Warp_Interpolate_SSE(_mm_and_si128(pa, mask), _mm_srli_epi32(pa, 8), _mm_and_si128(pb, mask), _mm_srli_epi32(pb, 8), wx, wy);
+		}
+		else {
+			fx = _mm_min_ps(_mm_max_ps(fx, lowLimit), xMax);
+			fy = _mm_min_ps(_mm_max_ps(fy, lowLimit), yMax);
+			__m128 fx0 = _mm_floor_ps(fx), fy0 = _mm_floor_ps(fy);
+			__m128 wx = _mm_sub_ps(fx, fx0), wy = _mm_sub_ps(fy, fy0);
+			__m128i x0 = _mm_cvttps_epi32(fx0), y0 = _mm_cvttps_epi32(fy0);
+			__m128i x1 = _mm_add_epi32(x0, one), y1 = _mm_add_epi32(y0, one);
+			__m128i bx = _mm_min_epi32(_mm_max_epi32(x0, izero), xLast2);
+			__m128i bx1 = _mm_add_epi32(bx, one);
+			__m128i ya = _mm_min_epi32(_mm_max_epi32(y0, izero), yLast);
+			__m128i yb = _mm_min_epi32(_mm_max_epi32(y1, izero), yLast);
+			__m128i rowA = _mm_cmpeq_epi32(y0, ya), rowB = _mm_cmpeq_epi32(y1, yb);
+			__m128i l0 = _mm_cmpeq_epi32(x0, bx), l1 = _mm_cmpeq_epi32(x0, bx1);
+			__m128i r0 = _mm_cmpeq_epi32(x1, bx), r1 = _mm_cmpeq_epi32(x1, bx1);
+			__m128i pa = Warp_Gather_SSE(pSrc, _mm_add_epi32(_mm_mullo_epi32(ya, stride), bx), true);
+			__m128i pb = Warp_Gather_SSE(pSrc, _mm_add_epi32(_mm_mullo_epi32(yb, stride), bx), true);
+			v = Warp_Interpolate_SSE(
+				Warp_Taps_SSE(pa, _mm_and_si128(l0, rowA), _mm_and_si128(l1, rowA), border),
+				Warp_Taps_SSE(pa, _mm_and_si128(r0, rowA), _mm_and_si128(r1, rowA), border),
+				Warp_Taps_SSE(pb, _mm_and_si128(l0, rowB), _mm_and_si128(l1, rowB), border),
+				Warp_Taps_SSE(pb, _mm_and_si128(r0, rowB), _mm_and_si128(r1, rowB), border),
+				wx, wy);
+		}
+		v = _mm_packus_epi32(v, v);
+		v = _mm_packus_epi16(v, v);
+		if (x + 4 <= data->dstWidth) {
+			*(vx_int32 *)&pDst[x] = _mm_cvtsi128_si32(v);
+		}
+		else {
+			XMM128 t; t.i = v;
+			for (vx_uint32 i = 0; x + i < data->dstWidth; i++)
+				pDst[x + i] = t.u8[i];
 		}
 	}
-
-	return AGO_SUCCESS;
 }
 
-int HafCpu_WarpPerspective_U8_U8_Bilinear
-(
-vx_uint32                  dstWidth,
-vx_uint32                  dstHeight,
-vx_uint8                 * pDstImage,
-vx_uint32                  dstImageStrideInBytes,
-vx_uint32                  srcWidth,
-vx_uint32                  srcHeight,
-vx_uint8                 * pSrcImage,
-vx_uint32                  srcImageStrideInBytes,
-ago_perspective_matrix_t * matrix,
-vx_uint8				 * pLocalData
-)
+static void Warp_Band(vx_uint32 band, vx_uint32 bandCount, void * arg)
 {
-	return HafCpu_WarpPerspective_U8_U8_Bilinear_Constant(dstWidth, dstHeight, pDstImage, dstImageStrideInBytes, srcWidth,
-		srcHeight, pSrcImage, srcImageStrideInBytes, matrix, (unsigned char)0, pLocalData);
+	const WarpBandData * data = (const WarpBandData *)arg;
+	vx_uint32 rowStart = data->dstHeight * band / bandCount, rowEnd = data->dstHeight * (band + 1) / bandCount;
+	bool vectorPath = (data->srcWidth >= 2) && (data->srcHeight >= 2);
+	vx_uint8 * pDst = data->pDstImage + rowStart * data->dstImageStrideInBytes;
+	for (vx_uint32 y = rowStart; y < rowEnd; y++, pDst += data->dstImageStrideInBytes) {
+		WarpRowCoeffs row;
+		Warp_RowCoeffs(data, y, &row);
+		if (!vectorPath)
+			Warp_Row_Scalar(data, &row, pDst);
+		else
+			Warp_Row_SSE(data, &row, pDst);
+	}
 }
 
+static int Warp_Parallel(WarpBandData * data, vx_enum interpolation, vx_enum borderMode, vx_uint32 bandCount)
+{
+	if (interpolation != VX_INTERPOLATION_TYPE_NEAREST_NEIGHBOR && interpolation != VX_INTERPOLATION_TYPE_BILINEAR)
+		return -1;
+	if (borderMode != VX_BORDER_MODE_UNDEFINED && borderMode != VX_BORDER_MODE_CONSTANT && borderMode != VX_BORDER_MODE_REPLICATE)
+		return -1;
+	if (!data->srcWidth || !data->srcHeight)
+		return -1;
+	data->bilinear = (interpolation == VX_INTERPOLATION_TYPE_BILINEAR);
+	data->constantBorder = (borderMode == VX_BORDER_MODE_CONSTANT);
+	bandCount = max(1u, min(bandCount, min(data->dstHeight, (vx_uint32)AGO_MAX_CPU_THREADS)));
+	if (bandCount > 1)
+		HafCpu_ParallelFor(bandCount, Warp_Band, data);
+	else
+		Warp_Band(0, 1, data);
+	return AGO_SUCCESS;
+}
 
-int HafCpu_WarpPerspective_U8_U8_Bilinear_Constant
-(
-vx_uint32                  dstWidth,
-vx_uint32                  dstHeight,
-vx_uint8                 * pDstImage,
-vx_uint32                  dstImageStrideInBytes,
-vx_uint32                  srcWidth,
-vx_uint32                  srcHeight,
-vx_uint8                 * pSrcImage,
-vx_uint32                  srcImageStrideInBytes,
-ago_perspective_matrix_t * matrix,
-vx_uint8                   border,
-vx_uint8				 * pLocalData
-)
+int HafCpu_WarpAffine_U8_U8_Parallel
+	(
+		vx_uint32             dstWidth,
+		vx_uint32             dstHeight,
+		vx_uint8            * pDstImage,
+		vx_uint32             dstImageStrideInBytes,
+		vx_uint32             srcWidth,
+		vx_uint32             srcHeight,
+		vx_uint8            * pSrcImage,
+		vx_uint32             srcImageStrideInBytes,
+		ago_affine_matrix_t * matrix,
+		vx_enum               interpolation,
+		vx_enum               borderMode,
+		vx_uint8              border,
+		vx_uint32             bandCount
+	)
 {
-	// calculate inverse mapping coefficients for x and y
-	const float a = matrix->matrix[0][0];
-	const float d = matrix->matrix[0][1];
-	const float g = matrix->matrix[0][2];
-	const float b = matrix->matrix[1][0];
-	const float e = matrix->matrix[1][1];
-	const float h = matrix->matrix[1][2];
-	const float c = matrix->matrix[2][0];
-	const float f = matrix->matrix[2][1];
-	const float i = matrix->matrix[2][2];
-
-	XMM128 xint, yint, xmask, ymask;
-	__m128 xdest, ydest, zdest;
-	const __m128i zeromask = _mm_setzero_si128();
-	const __m128i one = _mm_set1_epi32(1);
-	const __m128i pborder = _mm_set1_epi32((int)border);	
-	const __m128 zero = _mm_set1_ps(0);
-	const __m128 oneFloat = _mm_set1_ps(1.0);
-	const __m128i srcbx = _mm_set1_epi32((int)srcWidth);
-	const __m128i srcby = _mm_set1_epi32((int)srcHeight);
-	const __m128i p0mask = _mm_set1_epi32((int)0xFF);
-	const __m128i srcb = _mm_set1_epi32((srcHeight-1)*srcImageStrideInBytes - 1);
-	const __m128i src_s = _mm_set1_epi32(srcImageStrideInBytes);
-	const __m128i srcbx1 = _mm_set1_epi32((int)(srcWidth-1));
-	const __m128i srcby1 = _mm_set1_epi32((int)(srcHeight - 1));
-	const __m128i negone = _mm_set1_epi32((int)-1);
-
-	unsigned int x;
-	float *A_x = (float*)pLocalData;
-	float *D_x = (float *)ALIGN16(A_x + dstWidth);
-	float *G_x = (float *)ALIGN16(D_x + dstWidth);
-	for (x = 0; x<dstWidth; x++){
-		A_x[x] = a * x;
-		D_x[x] = d * x;
-		G_x[x] = g * x;			// (eg - dh)
+	WarpBandData data;
+	data.dstWidth = dstWidth;
+	data.dstHeight = dstHeight;
+	data.pDstImage = pDstImage;
+	data.dstImageStrideInBytes = dstImageStrideInBytes;
+	data.srcWidth = srcWidth;
+	data.srcHeight = srcHeight;
+	data.pSrcImage = pSrcImage;
+	data.srcImageStrideInBytes = srcImageStrideInBytes;
+	for (int i = 0; i < 3; i++) {
+		data.m[i][0] = matrix->matrix[i][0];
+		data.m[i][1] = matrix->matrix[i][1];
+		data.m[i][2] = (i == 2) ? 1.0f : 0.0f;
 	}
+	data.perspective = false;
+	data.border = border;
+	return Warp_Parallel(&data, interpolation, borderMode, bandCount);
+}
 
-#if 0
-	// find out if all the mapped pixels are within valid range or not
-	// find out if all the mapped pixels are within valid range or not
-	float z, x0, y0, x1, y1;
-	z = (float)(1.0 / i);
-	x0 = c * z;
-	y0 = f * z;
-	z = (float)(1.0 / (h * dstHeight + g*dstWidth + i));
-	x1 = (a*dstWidth + b * dstHeight + c) * z;
-	y1 = (d*dstWidth + e * dstHeight + f) * z;
-	bool bBoder = (x0 < 0) | (y0 < 0) | (x0 >= srcWidth) | (y0 >= srcHeight);
-	bBoder |= (x1 < 0) | (y1 < 0) | (x1 >= srcWidth) | (y1 >= srcHeight);
-#endif
-	bool bBoder = 1;
-
-	unsigned int y = 0;
-	if (bBoder){
-		// do the plain vanilla version with floating point division in inner_loop
-		while (y < dstHeight)
-		{
-			xdest = _mm_set1_ps(y*b + c);
-			ydest = _mm_set1_ps(y*e + f);
-			zdest = _mm_set1_ps(y*h + i);
-			x = 0;
-			unsigned int *dst = (unsigned int *)pDstImage;
-			while (x < dstWidth)
-			{
-				__m128 xmap, ymap, zmap;
-				__m128 xFraction, yFraction, one_minus_xFraction, one_minus_yFraction;
-				__m128 p0_f, p1_f, p2_f, p3_f;
-				__m128i p0 = _mm_set1_epi8(border), p1, p2 = _mm_set1_epi8(border), p3;	
-				__m128i mask, mask1; // mask for boundary checking 
-				unsigned char *psrc;
-				zmap = _mm_load_ps(&G_x[x]);
-				xmap = _mm_load_ps(&A_x[x]);
-				zmap = _mm_add_ps(zmap, zdest);
-				ymap = _mm_load_ps(&D_x[x]);
-				zmap = _mm_div_ps(oneFloat, zmap);
-				xmap = _mm_add_ps(xmap, xdest);
-				ymap = _mm_add_ps(ymap, ydest);
-				xmap = _mm_mul_ps(xmap, zmap);
-				ymap = _mm_mul_ps(ymap, zmap);
-				xmask.f = _mm_cmplt_ps(xmap, zero);
-				ymask.f = _mm_cmplt_ps(ymap, zero);
-				// convert to integer with rounding towards zero
-				xint.i = _mm_cvttps_epi32(xmap);
-				xint.i = _mm_sub_epi32(xint.i, _mm_srli_epi32(xmask.i, 31));
-				yint.i = _mm_cvttps_epi32(ymap);
-				yint.i = _mm_sub_epi32(yint.i, _mm_srli_epi32(ymask.i, 31));
-				mask = _mm_cmplt_epi32(xint.i, srcbx);
-				mask = _mm_andnot_si128(_mm_cmplt_epi32(xint.i, zeromask), mask);
-				mask = _mm_and_si128(mask, _mm_cmplt_epi32(yint.i, srcby));
-				mask = _mm_andnot_si128(_mm_cmplt_epi32(yint.i, zeromask), mask);
-				mask1 = _mm_cmplt_epi32(xint.i, srcbx1);	// xmap+1 < srcWidth;
-				mask1 = _mm_andnot_si128(_mm_cmplt_epi32(xint.i, negone), mask1);
-				mask1 = _mm_and_si128(mask1, _mm_cmplt_epi32(yint.i, srcby1));
-				mask1 = _mm_andnot_si128(_mm_cmplt_epi32(yint.i, negone), mask1);
-
-				//xFraction = xmap-xint;
-				//yFraction = ymap-yint;
-				xFraction = _mm_cvtepi32_ps(xint.i);
-				yFraction = _mm_cvtepi32_ps(yint.i);
-				xFraction = _mm_sub_ps(xmap, xFraction);
-				yFraction = _mm_sub_ps(ymap, yFraction);
-
-				// clip for boundary
-				yint.i = _mm_mullo_epi32(yint.i, src_s);
-				yint.i = _mm_add_epi32(yint.i, xint.i);
-				//(1-xFraction)
-				//(1-yFraction)
-				one_minus_xFraction = _mm_sub_ps(oneFloat, xFraction);
-				one_minus_yFraction = _mm_sub_ps(oneFloat, yFraction);
-				yint.i = _mm_min_epi32(yint.i, srcb);
-				yint.i = _mm_max_epi32(yint.i, zeromask);
-
-				// read pixels from src and re-arrange
-				psrc = pSrcImage + yint.s32[0];
-				M128I(p0).m128i_u32[0] = ((unsigned int *)psrc)[0];
-				M128I(p2).m128i_u32[0] = ((unsigned int *)(psrc + srcImageStrideInBytes))[0];
-
-				psrc = pSrcImage + yint.s32[1];
-				M128I(p0).m128i_u32[1] = ((unsigned int *)psrc)[0];
-				M128I(p2).m128i_u32[1] = ((unsigned int *)(psrc + srcImageStrideInBytes))[0];
-
-				psrc = pSrcImage + yint.s32[2];
-				M128I(p0).m128i_u32[2] = ((unsigned int *)psrc)[0];
-				M128I(p2).m128i_u32[2] = ((unsigned int *)(psrc + srcImageStrideInBytes))[0];
-
-				psrc = pSrcImage + yint.s32[3];
-				M128I(p0).m128i_u32[3] = ((unsigned int *)psrc)[0];
-				M128I(p2).m128i_u32[3] = ((unsigned int *)(psrc + srcImageStrideInBytes))[0];
-
-				// get p0, p1, p2, p3 by masking and shifting
-				p1 = p0;
-				p0 = _mm_and_si128(p0, p0mask);
-				p1 = _mm_srli_epi32(p1, 8);
-				p3 = p2;
-				p2 = _mm_and_si128(p2, p0mask);
-				p3 = _mm_srli_epi32(p3, 8);
-				p1 = _mm_and_si128(p1, p0mask);
-				p3 = _mm_and_si128(p3, p0mask);
-				// mask p0, p2 with border
-				p0 = _mm_and_si128(p0, mask);
-				p0 = _mm_or_si128(p0, _mm_andnot_si128(mask, pborder));			// combined result
-				p2 = _mm_and_si128(p2, mask);
-				p2 = _mm_or_si128(p2, _mm_andnot_si128(mask, pborder));			// combined result
-				// mask p1 and p3 with border
-				p1 = _mm_and_si128(p1, mask1);
-				p1 = _mm_or_si128(p1, _mm_andnot_si128(mask1, pborder));			// combined result
-				p3 = _mm_and_si128(p3, mask1);
-				p3 = _mm_or_si128(p3, _mm_andnot_si128(mask1, pborder));			// combined result
-
-				p0_f = _mm_cvtepi32_ps(p0);
-				p1_f = _mm_cvtepi32_ps(p1);
-				p2_f = _mm_cvtepi32_ps(p2);
-				p3_f = _mm_cvtepi32_ps(p3);
-
-				p0_f = _mm_mul_ps(p0_f, one_minus_xFraction);
-				p0_f = _mm_mul_ps(p0_f, one_minus_yFraction);
-				p1_f = _mm_mul_ps(p1_f, xFraction);
-				p1_f = _mm_mul_ps(p1_f, one_minus_yFraction);
-				p2_f = _mm_mul_ps(p2_f, one_minus_xFraction);
-				p2_f = _mm_mul_ps(p2_f, yFraction);
-				p3_f = _mm_mul_ps(p3_f, xFraction);
-				p3_f = _mm_mul_ps(p3_f, yFraction);
-
-				p0_f = _mm_add_ps(p0_f, p1_f);
-				p0_f = _mm_add_ps(p0_f, p2_f);
-				p0_f = _mm_add_ps(p0_f, p3_f);
-				p0 = _mm_cvttps_epi32(p0_f);
-
-				// convert to unsigned char and write to dst
-				p0 = _mm_packus_epi32(p0, zeromask);
-				p0 = _mm_packus_epi16(p0, zeromask);
-				*dst++ = M128I(p0).m128i_i32[0];
-				x += 4;
-			}
-			y++;
-			pDstImage += dstImageStrideInBytes;
-		}
-	}else{ 
-		// do the plain vanilla version with floating point division in inner_loop
-		while (y < dstHeight)
-		{
-			xdest = _mm_set1_ps(y*b + c);
-			ydest = _mm_set1_ps(y*e + f);
-			zdest = _mm_set1_ps(y*h + i);
-			x = 0;
-			unsigned int *dst = (unsigned int *)pDstImage;
-			while (x < dstWidth)
-			{
-				__m128 xmap, ymap, zmap;
-				__m128 xFraction, yFraction, one_minus_xFraction, one_minus_yFraction;
-				__m128 p0_f, p1_f, p2_f, p3_f;
-				__m128i p0, p1, p2, p3;			// pixels in src 
-				unsigned char *psrc;
-
-				zmap = _mm_load_ps(&G_x[x]);
-				xmap = _mm_load_ps(&A_x[x]);
-				zmap = _mm_add_ps(zmap, zdest);
-				ymap = _mm_load_ps(&D_x[x]);
-				zmap = _mm_div_ps(oneFloat, zmap);
-				xmap = _mm_add_ps(xmap, xdest);
-				ymap = _mm_add_ps(ymap, ydest);
-				xmap = _mm_mul_ps(xmap, zmap);
-				ymap = _mm_mul_ps(ymap, zmap);
-
-				// convert to integer with rounding towards zero
-				xint.i = _mm_cvttps_epi32(xmap);
-				yint.i = _mm_cvttps_epi32(ymap);
-
-				//xFraction = xmap-xint;
-				//yFraction = ymap-yint;
-				xFraction = _mm_cvtepi32_ps(xint.i);
-				yFraction = _mm_cvtepi32_ps(yint.i);
-				xFraction = _mm_sub_ps(xmap, xFraction);
-				yFraction = _mm_sub_ps(ymap, yFraction);
-
-				//(1-xFraction)
-				//(1-yFraction)
-				one_minus_xFraction = _mm_sub_ps(oneFloat, xFraction);
-				one_minus_yFraction = _mm_sub_ps(oneFloat, yFraction);
-
-				// read pixels from src and re-arrange
-				psrc = pSrcImage + (yint.s32[0] * srcImageStrideInBytes + xint.s32[0]);
-				M128I(p0).m128i_u32[0] = ((unsigned int *)psrc)[0];
-				M128I(p2).m128i_u32[0] = ((unsigned int *)(psrc + srcImageStrideInBytes))[0];
-
-				psrc = pSrcImage + (yint.s32[1] * srcImageStrideInBytes + xint.s32[1]);
-				M128I(p0).m128i_u32[1] = ((unsigned int *)psrc)[0];
-				M128I(p2).m128i_u32[1] = ((unsigned int *)(psrc + srcImageStrideInBytes))[0];
-
-				psrc = pSrcImage + (yint.s32[2] * srcImageStrideInBytes + xint.s32[2]);
-				M128I(p0).m128i_u32[2] = ((unsigned int *)psrc)[0];
-				M128I(p2).m128i_u32[2] = ((unsigned int *)(psrc + srcImageStrideInBytes))[0];
-
-				psrc = pSrcImage + (yint.s32[3] * srcImageStrideInBytes + xint.s32[3]);
-				M128I(p0).m128i_u32[3] = ((unsigned int *)psrc)[0];
-				M128I(p2).m128i_u32[3] = ((unsigned int *)(psrc + srcImageStrideInBytes))[0];
-
-				// get p0, p1, p2, p3 by masking and shifting
-				p1 = p0;
-				p0 = _mm_and_si128(p0, p0mask);
-				p1 = _mm_srli_epi32(p1, 8);
-				p3 = p2;
-				p2 = _mm_and_si128(p2, p0mask);
-				p3 = _mm_srli_epi32(p3, 8);
-				p1 = _mm_and_si128(p1, p0mask);
-				p3 = _mm_and_si128(p3, p0mask);
-
-				p0_f = _mm_cvtepi32_ps(p0);
-				p1_f = _mm_cvtepi32_ps(p1);
-				p2_f = _mm_cvtepi32_ps(p2);
-				p3_f = _mm_cvtepi32_ps(p3);
-
-				p0_f = _mm_mul_ps(p0_f, one_minus_xFraction);
-				p0_f = _mm_mul_ps(p0_f, one_minus_yFraction);
-				p1_f = _mm_mul_ps(p1_f, xFraction);
-				p1_f = _mm_mul_ps(p1_f, one_minus_yFraction);
-				p2_f = _mm_mul_ps(p2_f, one_minus_xFraction);
-				p2_f = _mm_mul_ps(p2_f, yFraction);
-				p3_f = _mm_mul_ps(p3_f, xFraction);
-				p3_f = _mm_mul_ps(p3_f, yFraction);
-
-				p0_f = _mm_add_ps(p0_f, p1_f);
-				p2_f = _mm_add_ps(p2_f, p3_f);
-				p0_f = _mm_add_ps(p0_f, p2_f);
-				p0 = _mm_cvttps_epi32(p0_f);
-
-				// convert to unsigned char and write to dst
-				p0 = _mm_packus_epi32(p0, zeromask);
-				p0 = _mm_packus_epi16(p0, zeromask);
-				*dst++ = M128I(p0).m128i_i32[0];
-				x += 4;
-			}
-			y++;
-			pDstImage += dstImageStrideInBytes;
-		}
-	}
-	return AGO_SUCCESS;
+int HafCpu_WarpPerspective_U8_U8_Parallel
+	(
+		vx_uint32                  dstWidth,
+		vx_uint32                  dstHeight,
+		vx_uint8                 * pDstImage,
+		vx_uint32                  dstImageStrideInBytes,
+		vx_uint32                  srcWidth,
+		vx_uint32                  srcHeight,
+		vx_uint8                 * pSrcImage,
+		vx_uint32                  srcImageStrideInBytes,
+		ago_perspective_matrix_t * matrix,
+		vx_enum                    interpolation,
+		vx_enum                    borderMode,
+		vx_uint8                   border,
+		vx_uint32                  bandCount
+	)
+{
+	WarpBandData data;
+	data.dstWidth = dstWidth;
+	data.dstHeight = dstHeight;
+	data.pDstImage = pDstImage;
+	data.dstImageStrideInBytes = dstImageStrideInBytes;
+	data.srcWidth = srcWidth;
+	data.srcHeight = srcHeight;
+	data.pSrcImage = pSrcImage;
+	data.srcImageStrideInBytes = srcImageStrideInBytes;
+	memcpy(data.m, matrix->matrix, sizeof(data.m));
+	data.perspective = true;
+	data.border = border;
+	return Warp_Parallel(&data, interpolation, borderMode, bandCount);
 }
 
 
@@ -921,6 +921,53 @@ int HafCpu_NonMaxSupp_XY_ANY_3x3
 	return AGO_SUCCESS;
 }
 
+// A band of the keypoint XYS list (viewed as 64-bit keys with strength in the upper bits) that is sorted
+// in descending order on demand: [next, sorted) holds the largest remaining keys of the band in order
+// and [sorted, end) holds the rest unsorted; each extension selects the next chunk with nth_element
+typedef struct {
+	vx_int64 * next;
+	vx_int64 * sorted;
+	vx_int64 * end;
+	size_t     chunk;
+} HarrisCandidateBand;
+
+static void HarrisCandidateBand_Extend(HarrisCandidateBand * band)
+{
+	vx_int64 * mid = band->sorted + min(band->chunk, (size_t)(band->end - band->sorted));
+	if (mid < band->end) {
+		std::nth_element(band->sorted, mid, band->end, std::greater<vx_int64>());
+	}
+	std::sort(band->sorted, mid, std::greater<vx_int64>());
+	band->sorted = mid;
+	band->chunk *= 2;
+}
+
+static void HarrisCandidateBand_ExtendBand(vx_uint32 band, vx_uint32 bandCount, void * arg)
+{
+	HarrisCandidateBand_Extend(&((HarrisCandidateBand *)arg)[band]);
+}
+
+// heap order of bands on their next (largest remaining) key: std heap functions keep the maximum at front
+static inline bool HarrisCandidateBand_Less(const HarrisCandidateBand * a, const HarrisCandidateBand * b)
+{
+	return *a->next < *b->next;
+}
+
+// remove the largest remaining key from the heap of bands, extending its band when the sorted part runs dry
+static inline ago_keypoint_xys_t * HarrisCandidateBand_PopNext(HarrisCandidateBand ** heap, vx_uint32& heapSize)
+{
+	if (!heapSize) return nullptr;
+	std::pop_heap(heap, heap + heapSize, HarrisCandidateBand_Less);
+	HarrisCandidateBand * band = heap[heapSize - 1];
+	ago_keypoint_xys_t * item = (ago_keypoint_xys_t *)band->next++;
+	if (band->next == band->sorted && band->sorted < band->end) {
+		HarrisCandidateBand_Extend(band);
+	}
+	if (band->next < band->end) std::push_heap(heap, heap + heapSize, HarrisCandidateBand_Less);
+	else heapSize--;
+	return item;
+}
+
 int HafCpu_HarrisMergeSortAndPick_XY_XYS
 	(
 		vx_uint32                  capacityOfDstCorner,
@@ -930,13 +977,39 @@ int HafCpu_HarrisMergeSortAndPick_XY_XYS
 		vx_uint32                  srcListCount,
 		vx_float32                 min_distance,
 		ago_harris_grid_header_t * gridInfo,
-		ago_coord2d_short_t      * gridBuf
+		ago_coord2d_short_t      * gridBuf,
+		vx_bool                    countAllCorners,
+		vx_uint32                  bandCount
 	)
 {
-	// sort the keypoint XYS list
-	std::sort((vx_int64 *)&srcList[0], (vx_int64 *)&srcList[srcListCount], std::greater<vx_int64>());
+	// visit the keypoint XYS list in descending order without sorting all of it: split the list into bands,
+	// select and sort the largest keys of each band in parallel, and merge the bands through a heap.
+	// only the min_distance filter with a total corner count needs the whole list in order; otherwise
+	// the walk stops after capacityOfDstCorner corners and a band is extended only when it runs dry.
+	bool visitAll = gridInfo && countAllCorners;
+	bandCount = max(min(bandCount, (vx_uint32)AGO_HARRIS_MAX_MERGE_BANDS), 1u);
+	bandCount = max(min(bandCount, srcListCount / AGO_HARRIS_MIN_KEYPOINTS_PER_BAND), 1u);
+	HarrisCandidateBand bands[AGO_HARRIS_MAX_MERGE_BANDS], * heap[AGO_HARRIS_MAX_MERGE_BANDS];
+	size_t chunk = visitAll ? srcListCount : (2 * (size_t)capacityOfDstCorner + bandCount - 1) / bandCount;
+	vx_int64 * keys = (vx_int64 *)srcList;
+	for (vx_uint32 band = 0; band < bandCount; band++) {
+		bands[band].next = bands[band].sorted = keys + (size_t)srcListCount * band / bandCount;
+		bands[band].end = keys + (size_t)srcListCount * (band + 1) / bandCount;
+		bands[band].chunk = max(chunk, (size_t)AGO_HARRIS_MIN_KEYPOINTS_PER_BAND);
+	}
+	if (bandCount > 1) HafCpu_ParallelFor(bandCount, HarrisCandidateBand_ExtendBand, bands);
+	else HarrisCandidateBand_Extend(&bands[0]);
+	vx_uint32 heapSize = 0;
+	for (vx_uint32 band = 0; band < bandCount; band++) {
+		if (bands[band].next < bands[band].end) {
+			heap[heapSize++] = &bands[band];
+		}
+	}
+	std::make_heap(heap, heap + heapSize, HarrisCandidateBand_Less);
 	// extract useful keypoints from XYS list into corners array
 	vx_uint32 count = 0;
+	vx_uint32 pickCount = gridInfo ? (visitAll ? srcListCount : capacityOfDstCorner) : min(srcListCount, capacityOfDstCorner);
+	ago_keypoint_xys_t * pickList = nullptr;
 	if (gridInfo) {
 		// get grid info and initialize grid buffer if (-1,-1) coordinate values indicating no presence of values
 		vx_uint32 gridWidth = gridInfo->width;
@@ -946,8 +1019,8 @@ int HafCpu_HarrisMergeSortAndPick_XY_XYS
 		// filter the keypoints with min_distance
 		vx_int32 min_dist2 = (vx_int32)ceilf(min_distance * min_distance);
 		vx_keypoint_t * corner = dstCorner;
-		for (vx_uint32 i = 0; i < srcListCount; i++) {
-			vx_uint32 x = srcList[i].x, y = srcList[i].y;
+		while (count < pickCount && (pickList = HarrisCandidateBand_PopNext(heap, heapSize)) != nullptr) {
+			vx_uint32 x = pickList->x, y = pickList->y;
 			bool found = true;
 			vx_int32 cx = (vx_int32)x / cellSize, cy = (vx_int32)y / cellSize;
 			ago_coord2d_short_t * cgrid = gridBuf + cy * gridWidth + cx;
@@ -975,7 +1048,7 @@ int HafCpu_HarrisMergeSortAndPick_XY_XYS
 				if (count < capacityOfDstCorner) {
 					corner->x = x;
 					corner->y = y;
-					corner->strength = srcList[i].s;
+					corner->strength = pickList->s;
 					corner->tracking_status = 1;
 					corner->error = 0;
 					corner->scale = 0.0f;
@@ -990,11 +1063,11 @@ int HafCpu_HarrisMergeSortAndPick_XY_XYS
 	}
 	else {
 		// copy all points into output array
-		count = (srcListCount < capacityOfDstCorner) ? srcListCount : capacityOfDstCorner;
-		for (vx_uint32 i = 0; i < count; i++, dstCorner++, srcList++) {
-			dstCorner->x = srcList->x;
-			dstCorner->y = srcList->y;
-			dstCorner->strength = srcList->s;
+		for (count = 0; count < pickCount; count++, dstCorner++) {
+			pickList = HarrisCandidateBand_PopNext(heap, heapSize);
+			dstCorner->x = pickList->x;
+			dstCorner->y = pickList->y;
+			dstCorner->strength = pickList->s;
 			dstCorner->tracking_status = 1;
 			dstCorner->error = 0;
 			dstCorner->scale = 0.0f;
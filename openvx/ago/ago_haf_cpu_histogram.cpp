@@ -513,6 +513,23 @@ static int HafCpu_Histogram16Bins_DATA_U8
 	return AGO_SUCCESS;
 }
 
+// Band-parallel 256-bin histogram: each band of rows counts into its own histogram
+typedef struct {
+	vx_uint32     srcWidth;
+	vx_uint32     srcHeight;
+	vx_uint8    * pSrcImage;
+	vx_uint32     srcImageStrideInBytes;
+	vx_uint32     bandHist[AGO_MAX_CPU_THREADS][256];
+} HistogramBandData;
+
+static void Histogram_Band(vx_uint32 band, vx_uint32 bandCount, void * arg)
+{
+	HistogramBandData * data = (HistogramBandData *)arg;
+	vx_uint32 rowStart = data->srcHeight * band / bandCount;
+	vx_uint32 rowEnd = data->srcHeight * (band + 1) / bandCount;
+	HafCpu_Histogram_DATA_U8(data->bandHist[band], data->srcWidth, rowEnd - rowStart, data->pSrcImage + rowStart * data->srcImageStrideInBytes, data->srcImageStrideInBytes);
+}
+
 int HafCpu_HistogramFixedBins_DATA_U8
 	(
 		vx_uint32     dstHist[],
@@ -523,7 +540,8 @@ int HafCpu_HistogramFixedBins_DATA_U8
 		vx_uint32     srcWidth,
 		vx_uint32     srcHeight,
 		vx_uint8    * pSrcImage,
-		vx_uint32     srcImageStrideInBytes
+		vx_uint32     srcImageStrideInBytes,
+		vx_uint32     bandCount
 	)
 {
 	int status = AGO_ERROR_HAFCPU_NOT_IMPLEMENTED;
@@ -531,6 +549,7 @@ int HafCpu_HistogramFixedBins_DATA_U8
 	// compute number of split points in [0..255] range to compute the histogram
 	vx_int32 numSplits = (distBinCount - 1) + ((distOffset > 0) ? 1 : 0) + (((distOffset + distRange) < 256) ? 1 : 0);
 	bool useGeneral = (srcWidth & 7) || (((intptr_t)pSrcImage) & 15);			// Use general code if width is not multiple of 8 or the buffer is unaligned
+	useGeneral = useGeneral || (distWindow * distBinCount != distRange);		// or if the last bin is narrower than the window (split-points assume full windows)
 	if ((numSplits < 1 && distBinCount > 1) || (distBinCount == 0)) return status;
 
 	if (numSplits <= 3 && !useGeneral) {
@@ -582,22 +601,29 @@ int HafCpu_HistogramFixedBins_DATA_U8
 		status = HafCpu_Histogram16Bins_DATA_U8(dstHist, distOffset, distWindow, srcWidth, srcHeight, pSrcImage, srcImageStrideInBytes);
 	}
 	else {
-		// use general 256-bin histogram
+		// use general 256-bin histogram: in parallel bands merged at the end when requested
 		vx_uint32 histTmp[256];
-		status = HafCpu_Histogram_DATA_U8(histTmp, srcWidth, srcHeight, pSrcImage, srcImageStrideInBytes);
+		bandCount = max(1u, min(bandCount, min(srcHeight, (vx_uint32)AGO_MAX_CPU_THREADS)));
+		if (bandCount > 1) {
+			HistogramBandData data = { srcWidth, srcHeight, pSrcImage, srcImageStrideInBytes, { { 0 } } };
+			vx_uint32 * bandHist[AGO_MAX_CPU_THREADS];
+			HafCpu_ParallelFor(bandCount, Histogram_Band, &data);
+			for (vx_uint32 band = 0; band < bandCount; band++)
+				bandHist[band] = data.bandHist[band];
+			status = HafCpu_HistogramMerge_DATA_DATA(histTmp, bandCount, bandHist);
+		}
+		else {
+			status = HafCpu_Histogram_DATA_U8(histTmp, srcWidth, srcHeight, pSrcImage, srcImageStrideInBytes);
+		}
 		if (!status) {
-			// convert [256] histogram into [numbins]
-			if (distWindow == 1) {
-				memcpy(dstHist, &histTmp[distOffset], distBinCount * sizeof(vx_uint32));
-			}
-			else {
-				for (vx_uint32 i = 0, j = distOffset; i < distBinCount; i++) {
-					vx_uint32 count = 0, end = distOffset + distRange;
-					for (vx_uint32 jend = ((j + distWindow) < end) ? (j + distWindow) : end; j < jend; j++) {
-						count += histTmp[j];
-					}
-					dstHist[i] = count;
+			// convert [256] histogram into [numbins]: pixels at or beyond offset+range (or 255) don't contribute
+			vx_uint32 end = min(distOffset + distRange, 256u);
+			for (vx_uint32 i = 0, j = distOffset; i < distBinCount; i++) {
+				vx_uint32 count = 0;
+				for (vx_uint32 jend = ((j + distWindow) < end) ? (j + distWindow) : end; j < jend; j++) {
+					count += histTmp[j];
 				}
+				dstHist[i] = count;
 			}
 		}
 	}
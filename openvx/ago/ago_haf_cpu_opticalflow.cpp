@@ -56,6 +56,13 @@ static const float Epsilon = 1.0e-07F;
 
 #define DESCALE(x, n) (((x) + (1 << ((n)-1))) >> (n))
 
+// sparse derivatives: 8x8 tiles of interleaved Ix,Iy computed only around tracked windows
+#define AGO_OPTICALFLOW_TILE_SHIFT      3
+#define AGO_OPTICALFLOW_TILE_SIZE       (1 << AGO_OPTICALFLOW_TILE_SHIFT)
+#define AGO_OPTICALFLOW_TILE_ELEMENTS   (AGO_OPTICALFLOW_TILE_SIZE * AGO_OPTICALFLOW_TILE_SIZE * 2)
+#define AGO_OPTICALFLOW_TILES_PER_POINT 9		// a window of up to 16 pixels spans at most 3 tiles in each direction
+#define AGO_OPTICALFLOW_PATCH_STRIDE    32		// row stride (in #of elements) of gathered window derivatives
+
 // helper functions
 static inline void pt_copy(pt2f &pt1, pt2f &pt2) { pt1.x = pt2.x; pt1.y = pt2.y; }
 static inline void pt_copy_scale(pt2f &pt1, pt2f &pt2, float &s) { pt1.x = pt2.x*s; pt1.y = pt2.y*s; }
@@ -112,7 +119,7 @@ static void ComputeSharr(
 
 		// do vertical convolution
 		x = 0;
-		for (; x <= srcWidth - 8; x += 8)
+		for (; x + 8 <= srcWidth; x += 8)
 		{
 			__m128i s0 = _mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i*)(srow0 + x)), z);
 			__m128i s1 = _mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i*)(srow1 + x)), z);
@@ -122,13 +129,18 @@ static void ComputeSharr(
 			_mm_store_si128((__m128i*)(trow0 + x), t0);
 			_mm_store_si128((__m128i*)(trow1 + x), t1);
 		}
+		for (; x < srcWidth; x++)
+		{
+			trow0[x] = (vx_uint16)((srow0[x] + srow2[x]) * 3 + srow1[x] * 10);
+			trow1[x] = (vx_uint16)(srow2[x] - srow0[x]);
+		}
 		// make border: is this really needed.
 		//trow0[-1] = trow0[0]; trow0[srcWidth] = trow0[srcWidth-1];
 		//trow1[-1] = trow1[0]; trow1[srcWidth] = trow1[srcWidth - 1];
 
 		// do horizontal convolution, interleave the results and store them to dst
 		x = 0;
-		for (; x <= srcWidth - 8; x += 8)
+		for (; x + 8 <= srcWidth; x += 8)
 		{
 			__m128i s0 = _mm_loadu_si128((const __m128i*)(trow0 + x - 1));
 			__m128i s1 = _mm_loadu_si128((const __m128i*)(trow0 + x + 1));
@@ -144,31 +156,247 @@ static void ComputeSharr(
 			_mm_storeu_si128((__m128i*)(drow + x * 2), t2);
 			_mm_storeu_si128((__m128i*)(drow + x * 2 + 8), t0);
 		}
+		for (; x < srcWidth - 1; x++)
+		{
+			drow[x * 2] = (vx_uint16)(trow0[x + 1] - trow0[x - 1]);
+			drow[x * 2 + 1] = (vx_uint16)((trow1[x - 1] + trow1[x + 1]) * 3 + trow1[x] * 10);
+		}
+		// first and last columns have no derivative
+		drow[0] = drow[1] = 0;
+		drow[(srcWidth - 1) * 2] = drow[(srcWidth - 1) * 2 + 1] = 0;
 		src += srcImageStrideInBytes;
 		dst += dstImageStrideInBytes;
 	}
+	// first and last rows have no derivative
+	memset(dst - (srcHeight - 1) * dstImageStrideInBytes, 0, srcWidth * 4);
+	memset(dst, 0, srcWidth * 4);
 #endif
 }
 
-int HafCpu_OpticalFlowPyrLK_XY_XY_Generic
+// computes one 8x8 tile of interleaved Ix,Iy: same results as ComputeSharr inside the image, zero on the border
+static void ComputeSharrTile(
+	vx_int16	*dst,
+	vx_uint32	tileX,
+	vx_uint32	tileY,
+	vx_uint32	srcWidth,
+	vx_uint32   srcHeight,
+	vx_uint32   srcImageStrideInBytes,
+	vx_uint8	*src
+)
+{
+	vx_int32 x0 = tileX << AGO_OPTICALFLOW_TILE_SHIFT, y0 = tileY << AGO_OPTICALFLOW_TILE_SHIFT;
+	if (x0 >= 1 && x0 + AGO_OPTICALFLOW_TILE_SIZE <= (vx_int32)srcWidth - 1 && y0 >= 1 && y0 + AGO_OPTICALFLOW_TILE_SIZE <= (vx_int32)srcHeight - 1) {
+		__m128i z = _mm_setzero_si128(), c3 = _mm_set1_epi16(3), c10 = _mm_set1_epi16(10);
+		for (vx_int32 y = 0; y < AGO_OPTICALFLOW_TILE_SIZE; y++, dst += AGO_OPTICALFLOW_TILE_SIZE * 2) {
+			const vx_uint8 * srow1 = src + (y0 + y) * srcImageStrideInBytes + x0;
+			const vx_uint8 * srow0 = srow1 - srcImageStrideInBytes;
+			const vx_uint8 * srow2 = srow1 + srcImageStrideInBytes;
+			// vertical convolution at columns x-1, x, and x+1
+			__m128i s0 = _mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i*)(srow0 - 1)), z);
+			__m128i s1 = _mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i*)(srow1 - 1)), z);
+			__m128i s2 = _mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i*)(srow2 - 1)), z);
+			__m128i t0l = _mm_add_epi16(_mm_mullo_epi16(_mm_add_epi16(s0, s2), c3), _mm_mullo_epi16(s1, c10));
+			__m128i t1l = _mm_sub_epi16(s2, s0);
+			s0 = _mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i*)(srow0 + 1)), z);
+			s1 = _mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i*)(srow1 + 1)), z);
+			s2 = _mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i*)(srow2 + 1)), z);
+			__m128i t0r = _mm_add_epi16(_mm_mullo_epi16(_mm_add_epi16(s0, s2), c3), _mm_mullo_epi16(s1, c10));
+			__m128i t1r = _mm_sub_epi16(s2, s0);
+			s0 = _mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i*)srow0), z);
+			s2 = _mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i*)srow2), z);
+			__m128i t1c = _mm_sub_epi16(s2, s0);
+			// horizontal convolution and interleave
+			__m128i ix = _mm_sub_epi16(t0r, t0l);
+			__m128i iy = _mm_add_epi16(_mm_mullo_epi16(_mm_add_epi16(t1l, t1r), c3), _mm_mullo_epi16(t1c, c10));
+			_mm_store_si128((__m128i*)dst, _mm_unpacklo_epi16(ix, iy));
+			_mm_store_si128((__m128i*)(dst + 8), _mm_unpackhi_epi16(ix, iy));
+		}
+	}
+	else {
+		for (vx_int32 y = y0; y < y0 + AGO_OPTICALFLOW_TILE_SIZE; y++) {
+			for (vx_int32 x = x0; x < x0 + AGO_OPTICALFLOW_TILE_SIZE; x++, dst += 2) {
+				if (x < 1 || x >= (vx_int32)srcWidth - 1 || y < 1 || y >= (vx_int32)srcHeight - 1) {
+					dst[0] = dst[1] = 0;
+				}
+				else {
+					const vx_uint8 * srow1 = src + y * srcImageStrideInBytes + x;
+					const vx_uint8 * srow0 = srow1 - srcImageStrideInBytes;
+					const vx_uint8 * srow2 = srow1 + srcImageStrideInBytes;
+					dst[0] = (vx_int16)(((srow0[1] + srow2[1]) * 3 + srow1[1] * 10) - ((srow0[-1] + srow2[-1]) * 3 + srow1[-1] * 10));
+					dst[1] = (vx_int16)(((srow2[-1] - srow0[-1]) + (srow2[1] - srow0[1])) * 3 + (srow2[0] - srow0[0]) * 10);
+				}
+			}
+		}
+	}
+}
+
+// per-level state shared by all the keypoints of one pyramid level
+typedef struct {
+	vx_keypoint_t    * newKeyPoint;
+	vx_keypoint_t    * oldKeyPoint;
+	vx_keypoint_t    * newKeyPointEstimate;
+	ago_keypoint_t   * pNextPtArray;
+	vx_uint32          keyPointCount;
+	vx_uint32          pyramidLevelCount;
+	int                level;
+	float              ptScale;
+	vx_bool            use_initial_estimate;
+	vx_enum            termination;
+	vx_float32         epsilon;
+	vx_uint32          num_iterations;
+	vx_int32           winsz;
+	vx_uint32          dWidth;
+	vx_uint32          dHeight;
+	vx_uint32          JWidth;
+	vx_uint32          JHeight;
+	vx_uint32          IStride;
+	vx_uint32          JStride;
+	vx_uint32          dStride;
+	vx_uint8         * SrcBase;
+	vx_uint8         * JBase;
+	vx_int16         * DIBase;			// full derivative image: NULL when tile cache is used
+	vx_int32         * tileMap;			// derivative tile cache: pool index per tile or -1
+	vx_int16         * tilePool;
+	vx_uint32        * tileList;
+	vx_uint32          tileCount;
+	vx_uint32          tilesX;
+	vx_uint32          width;
+	vx_uint32          height;
+	vx_uint8         * pScharrScratch;
+	vx_bool            prepared;		// top level initial estimates are already in pNextPtArray
+} OpticalFlowLevelData;
+
+// initial estimate of a trackable keypoint at top level
+static inline void OpticalFlowPyrLK_PrepareKeyPoint
 (
-vx_keypoint_t      newKeyPoint[],
-vx_float32         pyramidScale,
-vx_uint32          pyramidLevelCount,
-ago_pyramid_u8_t * oldPyramid,
-ago_pyramid_u8_t * newPyramid,
-vx_uint32          keyPointCount,
-vx_keypoint_t      oldKeyPoint[],
-vx_keypoint_t      newKeyPointEstimate[],
-vx_enum            termination,
-vx_float32         epsilon,
-vx_uint32          num_iterations,
-vx_bool            use_initial_estimate,
-vx_uint32		   dataStrideInBytes,
-vx_uint8		 * DataPtr,
-vx_int32		   winsz
+	vx_keypoint_t  * newKeyPoint,
+	ago_keypoint_t * nextPt,
+	vx_keypoint_t  * oldKeyPoint,
+	vx_keypoint_t  * newKeyPointEstimate,
+	vx_bool          use_initial_estimate,
+	float            ptScale
+)
+{
+	if (use_initial_estimate){
+		nextPt->x = newKeyPointEstimate->x*ptScale;
+		nextPt->y = newKeyPointEstimate->y*ptScale;
+		newKeyPoint->strength = newKeyPointEstimate->strength;
+		newKeyPoint->tracking_status = newKeyPointEstimate->tracking_status;
+		newKeyPoint->error = newKeyPointEstimate->error;
+	}
+	else
+	{
+		nextPt->x = oldKeyPoint->x*ptScale;
+		nextPt->y = oldKeyPoint->y*ptScale;
+		newKeyPoint->tracking_status = oldKeyPoint->tracking_status;
+		newKeyPoint->strength = oldKeyPoint->strength;
+	}
+}
+
+// copy interleaved Ix,Iy of a size x size window at (x0,y0) from the tile cache into patch
+static inline void OpticalFlowPyrLK_GatherDerivatives
+(
+	OpticalFlowLevelData * data,
+	vx_int32               x0,
+	vx_int32               y0,
+	vx_int32               size,
+	vx_int16             * patch
+)
+{
+	for (vx_int32 y = y0; y < y0 + size; y++, patch += AGO_OPTICALFLOW_PATCH_STRIDE) {
+		const vx_int32 * mapRow = data->tileMap + (y >> AGO_OPTICALFLOW_TILE_SHIFT) * data->tilesX;
+		vx_int32 tileRowOffset = (y & (AGO_OPTICALFLOW_TILE_SIZE - 1)) * AGO_OPTICALFLOW_TILE_SIZE * 2;
+		for (vx_int32 x = x0; x < x0 + size;) {
+			vx_int32 count = min(AGO_OPTICALFLOW_TILE_SIZE - (x & (AGO_OPTICALFLOW_TILE_SIZE - 1)), x0 + size - x);
+			const vx_int16 * tile = data->tilePool + mapRow[x >> AGO_OPTICALFLOW_TILE_SHIFT] * AGO_OPTICALFLOW_TILE_ELEMENTS;
+			memcpy(patch + (x - x0) * 2, tile + tileRowOffset + (x & (AGO_OPTICALFLOW_TILE_SIZE - 1)) * 2, count * 2 * sizeof(vx_int16));
+			x += count;
+		}
+	}
+}
+
+// mark the tiles covered by the windows of all trackable keypoints of the level and list the ones not yet cached
+static void OpticalFlowPyrLK_CollectTiles
+(
+	OpticalFlowLevelData * data
+)
+{
+	vx_size halfWin = (vx_size)(data->winsz >> 1);
+	vx_uint32 tilesY = (data->height + AGO_OPTICALFLOW_TILE_SIZE - 1) >> AGO_OPTICALFLOW_TILE_SHIFT;
+	memset(data->tileMap, 0xff, data->tilesX * tilesY * sizeof(vx_int32));
+	data->tileCount = 0;
+	for (vx_uint32 pt = 0; pt < data->keyPointCount; pt++) {
+		if (!data->oldKeyPoint[pt].tracking_status)
+			continue;
+		// same window position and bound check as the tracker
+		pt2f PrevPt;
+		PrevPt.x = data->oldKeyPoint[pt].x*data->ptScale;
+		PrevPt.y = data->oldKeyPoint[pt].y*data->ptScale;
+		PrevPt.x = PrevPt.x - halfWin;
+		PrevPt.y = PrevPt.y - halfWin;
+		pt2i iprevPt;
+		iprevPt.x = (vx_int32)floor(PrevPt.x);
+		iprevPt.y = (vx_int32)floor(PrevPt.y);
+		if ((iprevPt.x >> 31) | (iprevPt.x >= (vx_int32)(data->dWidth - data->winsz)) | (iprevPt.y >> 31) | (iprevPt.y >= (vx_int32)(data->dHeight - data->winsz)))
+			continue;
+		for (vx_int32 ty = iprevPt.y >> AGO_OPTICALFLOW_TILE_SHIFT; ty <= (iprevPt.y + data->winsz) >> AGO_OPTICALFLOW_TILE_SHIFT; ty++) {
+			for (vx_int32 tx = iprevPt.x >> AGO_OPTICALFLOW_TILE_SHIFT; tx <= (iprevPt.x + data->winsz) >> AGO_OPTICALFLOW_TILE_SHIFT; tx++) {
+				vx_uint32 tile = ty * data->tilesX + tx;
+				if (data->tileMap[tile] < 0) {
+					data->tileMap[tile] = (vx_int32)data->tileCount;
+					data->tileList[data->tileCount++] = tile;
+				}
+			}
+		}
+	}
+}
+
+static void OpticalFlowPyrLK_ComputeTileBand
+(
+	vx_uint32     band,
+	vx_uint32     bandCount,
+	void        * arg
+)
+{
+	OpticalFlowLevelData * data = (OpticalFlowLevelData *)arg;
+	vx_uint32 start = (vx_uint32)(((vx_uint64)data->tileCount * band) / bandCount);
+	vx_uint32 end = (vx_uint32)(((vx_uint64)data->tileCount * (band + 1)) / bandCount);
+	for (vx_uint32 i = start; i < end; i++) {
+		vx_uint32 tile = data->tileList[i];
+		ComputeSharrTile(data->tilePool + i * AGO_OPTICALFLOW_TILE_ELEMENTS, tile % data->tilesX, tile / data->tilesX,
+			data->width, data->height, data->IStride, data->SrcBase);
+	}
+}
+
+// Lukas Kanade tracking of keypoints [ptStart, ptEnd) at one pyramid level:
+// keypoints are independent, so disjoint ranges can be tracked concurrently
+static void OpticalFlowPyrLK_TrackKeyPoints
+(
+	OpticalFlowLevelData * data,
+	vx_uint32              ptStart,
+	vx_uint32              ptEnd
 )
 {
+	vx_keypoint_t * newKeyPoint = data->newKeyPoint;
+	vx_keypoint_t * oldKeyPoint = data->oldKeyPoint;
+	vx_keypoint_t * newKeyPointEstimate = data->newKeyPointEstimate;
+	ago_keypoint_t * pNextPtArray = data->pNextPtArray;
+	vx_uint32 pyramidLevelCount = data->pyramidLevelCount;
+	int level = data->level;
+	float ptScale = data->ptScale;
+	vx_bool use_initial_estimate = data->use_initial_estimate;
+	vx_enum termination = data->termination;
+	vx_float32 epsilon = data->epsilon;
+	vx_uint32 num_iterations = data->num_iterations;
+	vx_int32 winsz = data->winsz;
+	vx_uint32 dWidth = data->dWidth, dHeight = data->dHeight;
+	vx_uint32 JWidth = data->JWidth, JHeight = data->JHeight;
+	vx_uint32 IStride = data->IStride, JStride = data->JStride, dStride = data->dStride;
+	vx_uint8 *SrcBase = data->SrcBase;
+	vx_uint8 *JBase = data->JBase;
+	vx_int16 *DIBase = data->DIBase;
+	vx_int32 *tileMap = data->tileMap;
+
 	vx_size halfWin = (vx_size)(winsz>>1);  //(winsz *0.5f);
 	__m128i z = _mm_setzero_si128();
 	__m128i qdelta_d = _mm_set1_epi32(1 << (W_BITS - 1));
@@ -176,371 +404,639 @@ vx_int32		   winsz
 	// allocate matrix for I and dI 
 	vx_int16 Imat[256];				// enough to accomodate max win size of 15
 	vx_int16 dIMat[256*2];
-	vx_uint8 * pScharrScratch = DataPtr;
-	vx_uint8 * pScratch = DataPtr + (oldPyramid[0].width + 2) * 4 + 64;
-	ago_keypoint_t *pNextPtArray = (ago_keypoint_t *)(pScratch + (oldPyramid[0].width*oldPyramid[0].height * 4));
+	vx_int16 dIPatch[AGO_OPTICALFLOW_PATCH_STRIDE * 16];
+	int bBound;
 
-	for (int level = pyramidLevelCount - 1; level >= 0; level--)
-	{
-		int bBound;
-		vx_uint32 dWidth = oldPyramid[level].width-2;
-		vx_uint32 dHeight = oldPyramid[level].height-2;			// first and last row is not accounted
-		vx_uint32 JWidth = newPyramid[level].width;
-		vx_uint32 JHeight = newPyramid[level].height;
-		vx_uint32 IStride = oldPyramid[level].strideInBytes, JStride = newPyramid[level].strideInBytes;
-		vx_uint32 dStride = dataStrideInBytes>>1;		//in #of elements
-		vx_uint8 *SrcBase = oldPyramid[level].pImage;
-		vx_uint8 *JBase = newPyramid[level].pImage;
-		vx_int16 *DIBase = (vx_int16 *)pScratch;
-
-		// calculate sharr derivatives Ix and Iy
-		ComputeSharr(dataStrideInBytes, pScratch, oldPyramid[level].width, oldPyramid[level].height, oldPyramid[level].strideInBytes, oldPyramid[level].pImage, pScharrScratch);
-		float ptScale = (float)(pow(pyramidScale, level));
-
-		// do the Lukas Kanade tracking for each feature point
-		for (unsigned int pt = 0; pt < keyPointCount; pt++){
-			if (!oldKeyPoint[pt].tracking_status)	{
-				newKeyPoint[pt].x = oldKeyPoint[pt].x;
-				newKeyPoint[pt].y = oldKeyPoint[pt].y;
-				newKeyPoint[pt].strength = oldKeyPoint[pt].strength;
-				newKeyPoint[pt].tracking_status = oldKeyPoint[pt].tracking_status;
-				newKeyPoint[pt].scale = oldKeyPoint[pt].scale;
-				newKeyPoint[pt].error = oldKeyPoint[pt].error;
-				continue;
-			}
-			
-			pt2f PrevPt, nextPt;
-			bool bUseIE = false;
-			PrevPt.x = oldKeyPoint[pt].x*ptScale;
-			PrevPt.y = oldKeyPoint[pt].y*ptScale;
-			if (level == pyramidLevelCount-1){
-				if (use_initial_estimate){
-					nextPt.x = newKeyPointEstimate[pt].x*ptScale;
-					nextPt.y = newKeyPointEstimate[pt].y*ptScale;
-					bUseIE = true;
-					newKeyPoint[pt].strength = newKeyPointEstimate[pt].strength;
-					newKeyPoint[pt].tracking_status = newKeyPointEstimate[pt].tracking_status;
-					newKeyPoint[pt].error = newKeyPointEstimate[pt].error;
-				}
-				else
-				{
-					pt_copy(nextPt, PrevPt);
-					newKeyPoint[pt].tracking_status = oldKeyPoint[pt].tracking_status;
-					newKeyPoint[pt].strength = oldKeyPoint[pt].strength;
-				}
-				pNextPtArray[pt].x = nextPt.x;
-				pNextPtArray[pt].y = nextPt.y;
-			}
-			else
-			{
-				pNextPtArray[pt].x *= 2.0f;
-				pNextPtArray[pt].y *= 2.0f;
-				nextPt.x = pNextPtArray[pt].x;
-				nextPt.y = pNextPtArray[pt].y;
+	for (vx_uint32 pt = ptStart; pt < ptEnd; pt++){
+		if (!oldKeyPoint[pt].tracking_status)	{
+			newKeyPoint[pt].x = oldKeyPoint[pt].x;
+			newKeyPoint[pt].y = oldKeyPoint[pt].y;
+			newKeyPoint[pt].strength = oldKeyPoint[pt].strength;
+			newKeyPoint[pt].tracking_status = oldKeyPoint[pt].tracking_status;
+			newKeyPoint[pt].scale = oldKeyPoint[pt].scale;
+			newKeyPoint[pt].error = oldKeyPoint[pt].error;
+			continue;
+		}
+		
+		pt2f PrevPt, nextPt;
+		PrevPt.x = oldKeyPoint[pt].x*ptScale;
+		PrevPt.y = oldKeyPoint[pt].y*ptScale;
+		if (level == pyramidLevelCount-1){
+			// initial estimate at top level: already done when tracking in stages
+			if (!data->prepared) {
+				OpticalFlowPyrLK_PrepareKeyPoint(&newKeyPoint[pt], &pNextPtArray[pt], &oldKeyPoint[pt], &newKeyPointEstimate[pt], use_initial_estimate, ptScale);
 			}
+		}
+		else
+		{
+			pNextPtArray[pt].x *= 2.0f;
+			pNextPtArray[pt].y *= 2.0f;
+		}
+		nextPt.x = pNextPtArray[pt].x;
+		nextPt.y = pNextPtArray[pt].y;
 
-			if (!newKeyPoint[pt].tracking_status){
-				continue;
-			}
+		if (!newKeyPoint[pt].tracking_status){
+			continue;
+		}
 
-			pt2i iprevPt, inextPt;
-			PrevPt.x = PrevPt.x - halfWin;
-			PrevPt.y = PrevPt.y - halfWin;
-			nextPt.x = nextPt.x - halfWin;
-			nextPt.y = nextPt.y - halfWin;
+		pt2i iprevPt, inextPt;
+		PrevPt.x = PrevPt.x - halfWin;
+		PrevPt.y = PrevPt.y - halfWin;
+		nextPt.x = nextPt.x - halfWin;
+		nextPt.y = nextPt.y - halfWin;
 
-			iprevPt.x = (vx_int32)floor(PrevPt.x);
-			iprevPt.y = (vx_int32)floor(PrevPt.y);
-			// check if the point is out of bounds in the derivative image
-			bBound = (iprevPt.x >> 31) | (iprevPt.x >= (vx_int32)(dWidth - winsz)) | (iprevPt.y >> 31) | (iprevPt.y >= (vx_int32)(dHeight - winsz));
-			if (bBound){
-				if (!level){
-					newKeyPoint[pt].x = (vx_int32)nextPt.x;
-					newKeyPoint[pt].y = (vx_int32)nextPt.y;
-					newKeyPoint[pt].tracking_status = 0;
-					newKeyPoint[pt].error = 0;
-				}
-				continue;	// go to next point.
+		iprevPt.x = (vx_int32)floor(PrevPt.x);
+		iprevPt.y = (vx_int32)floor(PrevPt.y);
+		// check if the point is out of bounds in the derivative image
+		bBound = (iprevPt.x >> 31) | (iprevPt.x >= (vx_int32)(dWidth - winsz)) | (iprevPt.y >> 31) | (iprevPt.y >= (vx_int32)(dHeight - winsz));
+		if (bBound){
+			if (!level){
+				newKeyPoint[pt].x = (vx_int32)nextPt.x;
+				newKeyPoint[pt].y = (vx_int32)nextPt.y;
+				newKeyPoint[pt].tracking_status = 0;
+				newKeyPoint[pt].error = 0;
 			}
-			// calulate weights for interpolation
-			float a = PrevPt.x - iprevPt.x;
-			float b = PrevPt.y - iprevPt.y;
-			float A11 = 0, A12 = 0, A22 = 0;
+			continue;	// go to next point.
+		}
+		// derivatives of the window come from the full derivative image or are gathered from the tile cache
+		const vx_int16 * dIWin;
+		vx_uint32 dIStride;
+		if (tileMap) {
+			OpticalFlowPyrLK_GatherDerivatives(data, iprevPt.x, iprevPt.y, winsz + 1, dIPatch);
+			dIWin = dIPatch;
+			dIStride = AGO_OPTICALFLOW_PATCH_STRIDE;
+		}
+		else {
+			dIWin = DIBase + iprevPt.y*dStride + iprevPt.x * 2;
+			dIStride = dStride;
+		}
+		// calulate weights for interpolation
+		float a = PrevPt.x - iprevPt.x;
+		float b = PrevPt.y - iprevPt.y;
+		float A11 = 0, A12 = 0, A22 = 0;
+		int x, y;
+		int iw00, iw01, iw10, iw11;
+		if ((a==0.0) && (b==0.0))
+		{
+			// no need to do interpolation for the source and derivatives
 			int x, y;
-			int iw00, iw01, iw10, iw11;
-			if ((a==0.0) && (b==0.0))
+			for (y = 0; y < winsz; y++)
 			{
-				// no need to do interpolation for the source and derivatives
-				int x, y;
-				for (y = 0; y < winsz; y++)
+				const unsigned char* src = SrcBase + (y + iprevPt.y)*IStride + iprevPt.x;
+				const vx_int16* dsrc = dIWin + y*dIStride;
+
+				vx_int16* Iptr = &Imat[y*winsz];
+				vx_int16* dIptr = &dIMat[y*winsz * 2];
+				x = 0;
+				for (; x < winsz - 4; x += 4, dsrc += 8, dIptr += 8)
+				{
+					__m128i v00, v01, v10, v11, v12;
+					v00 = _mm_unpacklo_epi8(_mm_cvtsi32_si128(*(const int*)(src + x)), z);
+					v01 = _mm_loadu_si128((const __m128i*)(dsrc));
+					v10 = _mm_shufflelo_epi16(v01, 0xd8);		// copy with shuffle
+					v10 = _mm_shufflehi_epi16(v10, 0xd8);		// iy3, iy2, ix3,ix2, iy1, iy0, ix1,ix0
+					v10 = _mm_shuffle_epi32(v10, 0xd8);			// iy3, iy2, iy1, iy0, ix3,ix2, ix1,ix0
+					v11 = _mm_shuffle_epi32(v10, 0xe4);			// copy
+					v12 = _mm_shuffle_epi32(v10, 0x4e);         // ix3,ix2, ix1,ix0, iy3, iy2, iy1, iy0
+					v00 = _mm_slli_epi16(v00, 5);
+					v12 = _mm_madd_epi16(v12, v10);			// A121, A120
+					v10 = _mm_madd_epi16(v10, v11);			// A221, A220, A111, A110
+					A11 += (float)(M128I(v10).m128i_i32[0] + M128I(v10).m128i_i32[1]);
+					A22 += (float)(M128I(v10).m128i_i32[2] + M128I(v10).m128i_i32[3]);
+					A12 += (float)(M128I(v12).m128i_i32[0] + M128I(v12).m128i_i32[1]);
+					_mm_storeu_si128((__m128i*)dIptr, v01);
+					_mm_storel_epi64((__m128i*)(Iptr + x), v00);
+				}
+				for (; x < winsz; x ++, dsrc += 2, dIptr += 2)
 				{
-					const unsigned char* src = SrcBase + (y + iprevPt.y)*IStride + iprevPt.x;
-					const vx_int16* dsrc = DIBase + (y + iprevPt.y)*dStride + iprevPt.x * 2;
-
-					vx_int16* Iptr = &Imat[y*winsz];
-					vx_int16* dIptr = &dIMat[y*winsz * 2];
-					x = 0;
-					for (; x < winsz - 4; x += 4, dsrc += 8, dIptr += 8)
-					{
-						__m128i v00, v01, v10, v11, v12;
-						v00 = _mm_unpacklo_epi8(_mm_cvtsi32_si128(*(const int*)(src + x)), z);
-						v01 = _mm_loadu_si128((const __m128i*)(dsrc));
-						v10 = _mm_shufflelo_epi16(v01, 0xd8);		// copy with shuffle
-						v10 = _mm_shufflehi_epi16(v10, 0xd8);		// iy3, iy2, ix3,ix2, iy1, iy0, ix1,ix0
-						v10 = _mm_shuffle_epi32(v10, 0xd8);			// iy3, iy2, iy1, iy0, ix3,ix2, ix1,ix0
-						v11 = _mm_shuffle_epi32(v10, 0xe4);			// copy
-						v12 = _mm_shuffle_epi32(v10, 0x4e);         // ix3,ix2, ix1,ix0, iy3, iy2, iy1, iy0
-						v00 = _mm_slli_epi16(v00, 5);
-						v12 = _mm_madd_epi16(v12, v10);			// A121, A120
-						v10 = _mm_madd_epi16(v10, v11);			// A221, A220, A111, A110
-						A11 += (float)(M128I(v10).m128i_i32[0] + M128I(v10).m128i_i32[1]);
-						A22 += (float)(M128I(v10).m128i_i32[2] + M128I(v10).m128i_i32[3]);
-						A12 += (float)(M128I(v12).m128i_i32[0] + M128I(v12).m128i_i32[1]);
-						_mm_storeu_si128((__m128i*)dIptr, v01);
-						_mm_storel_epi64((__m128i*)(Iptr + x), v00);
-					}
-					for (; x < winsz; x ++, dsrc += 2, dIptr += 2)
-					{
-
-						int ival = (src[x]<<5);
-						int ixval = dsrc[0];
-						int iyval = dsrc[1];
-
-						Iptr[x] = (short)ival;
-						dIptr[0] = (short)ixval;
-						dIptr[1] = (short)iyval;
-
-						A11 += (float)(ixval*ixval);
-						A12 += (float)(ixval*iyval);
-						A22 += (float)(iyval*iyval);
-					}
+
+					int ival = (src[x]<<5);
+					int ixval = dsrc[0];
+					int iyval = dsrc[1];
+
+					Iptr[x] = (short)ival;
+					dIptr[0] = (short)ixval;
+					dIptr[1] = (short)iyval;
+
+					A11 += (float)(ixval*ixval);
+					A12 += (float)(ixval*iyval);
+					A22 += (float)(iyval*iyval);
 				}
-				A11 *= FLT_SCALE;
-				A12 *= FLT_SCALE;
-				A22 *= FLT_SCALE;
 			}
-			else
+			A11 *= FLT_SCALE;
+			A12 *= FLT_SCALE;
+			A22 *= FLT_SCALE;
+		}
+		else
+		{
+			int iw00 = (int)(((1.f - a)*(1.f - b)*(1 << W_BITS)) + 0.5);
+			int iw01 = (int)((a*(1.f - b)*(1 << W_BITS)) + 0.5);
+			int iw10 = (int)(((1.f - a)*b*(1 << W_BITS)) + 0.5);
+			int iw11 = (1 << W_BITS) - iw00 - iw01 - iw10;
+			__m128i qw0 = _mm_set1_epi32(iw00 + (iw01 << 16));
+			__m128i qw1 = _mm_set1_epi32(iw10 + (iw11 << 16));
+			__m128 qA11 = _mm_setzero_ps(), qA12 = _mm_setzero_ps(), qA22 = _mm_setzero_ps();
+			// extract the patch from the old image, compute covariation matrix of derivatives
+			for (y = 0; y < winsz; y++)
 			{
-				int iw00 = (int)(((1.f - a)*(1.f - b)*(1 << W_BITS)) + 0.5);
-				int iw01 = (int)((a*(1.f - b)*(1 << W_BITS)) + 0.5);
-				int iw10 = (int)(((1.f - a)*b*(1 << W_BITS)) + 0.5);
-				int iw11 = (1 << W_BITS) - iw00 - iw01 - iw10;
-				__m128i qw0 = _mm_set1_epi32(iw00 + (iw01 << 16));
-				__m128i qw1 = _mm_set1_epi32(iw10 + (iw11 << 16));
-				__m128 qA11 = _mm_setzero_ps(), qA12 = _mm_setzero_ps(), qA22 = _mm_setzero_ps();
-				// extract the patch from the old image, compute covariation matrix of derivatives
-				for (y = 0; y < winsz; y++)
+				const unsigned char* src = SrcBase + (y + iprevPt.y)*IStride + iprevPt.x;
+				const vx_int16* dsrc = dIWin + y*dIStride;
+
+				vx_int16* Iptr = &Imat[y*winsz];
+				vx_int16* dIptr = &dIMat[y*winsz * 2];
+
+				x = 0;
+				for (; x <= winsz - 4; x += 4, dsrc += 4 * 2, dIptr += 4 * 2)
 				{
-					const unsigned char* src = SrcBase + (y + iprevPt.y)*IStride + iprevPt.x;
-					const vx_int16* dsrc = DIBase + (y + iprevPt.y)*dStride + iprevPt.x * 2;
-
-					vx_int16* Iptr = &Imat[y*winsz];
-					vx_int16* dIptr = &dIMat[y*winsz * 2];
-
-					x = 0;
-					for (; x <= winsz - 4; x += 4, dsrc += 4 * 2, dIptr += 4 * 2)
-					{
-						__m128i v00, v01, v10, v11, t0, t1;
-
-						v00 = _mm_unpacklo_epi8(_mm_cvtsi32_si128(*(const int*)(src + x)), z);
-						v01 = _mm_unpacklo_epi8(_mm_cvtsi32_si128(*(const int*)(src + x + 1)), z);
-						v10 = _mm_unpacklo_epi8(_mm_cvtsi32_si128(*(const int*)(src + x + IStride)), z);
-						v11 = _mm_unpacklo_epi8(_mm_cvtsi32_si128(*(const int*)(src + x + IStride + 1)), z);
-
-						t0 = _mm_add_epi32(_mm_madd_epi16(_mm_unpacklo_epi16(v00, v01), qw0),
-							_mm_madd_epi16(_mm_unpacklo_epi16(v10, v11), qw1));
-						t0 = _mm_srai_epi32(_mm_add_epi32(t0, qdelta), W_BITS - 5);
-						_mm_storel_epi64((__m128i*)(Iptr + x), _mm_packs_epi32(t0, t0));
-
-						v00 = _mm_loadu_si128((const __m128i*)(dsrc));
-						v01 = _mm_loadu_si128((const __m128i*)(dsrc + 2));
-						v10 = _mm_loadu_si128((const __m128i*)(dsrc + dStride));
-						v11 = _mm_loadu_si128((const __m128i*)(dsrc + dStride + 2));
-
-						t0 = _mm_add_epi32(_mm_madd_epi16(_mm_unpacklo_epi16(v00, v01), qw0),
-							_mm_madd_epi16(_mm_unpacklo_epi16(v10, v11), qw1));
-						t1 = _mm_add_epi32(_mm_madd_epi16(_mm_unpackhi_epi16(v00, v01), qw0),
-							_mm_madd_epi16(_mm_unpackhi_epi16(v10, v11), qw1));
-						t0 = _mm_srai_epi32(_mm_add_epi32(t0, qdelta_d), W_BITS);
-						t1 = _mm_srai_epi32(_mm_add_epi32(t1, qdelta_d), W_BITS);
-						v00 = _mm_packs_epi32(t0, t1); // Ix0 Iy0 Ix1 Iy1 ...
-
-						_mm_storeu_si128((__m128i*)dIptr, v00);
-						t0 = _mm_srai_epi32(v00, 16); // Iy0 Iy1 Iy2 Iy3
-						t1 = _mm_srai_epi32(_mm_slli_epi32(v00, 16), 16); // Ix0 Ix1 Ix2 Ix3
-
-						__m128 fy = _mm_cvtepi32_ps(t0);
-						__m128 fx = _mm_cvtepi32_ps(t1);
-
-						qA22 = _mm_add_ps(qA22, _mm_mul_ps(fy, fy));
-						qA12 = _mm_add_ps(qA12, _mm_mul_ps(fx, fy));
-						qA11 = _mm_add_ps(qA11, _mm_mul_ps(fx, fx));
-					}
-					// do computation for remaining x if any
-					for (; x < winsz; x++, dsrc += 2, dIptr += 2)
-					{
-						int ival = DESCALE(src[x] * iw00 + src[x + 1] * iw01 +
-							src[x + IStride] * iw10 + src[x + IStride + 1] * iw11, W_BITS - 5);
-						int ixval = DESCALE(dsrc[0] * iw00 + dsrc[2] * iw01 +
-							dsrc[dStride] * iw10 + dsrc[dStride + 2] * iw11, W_BITS);
-						int iyval = DESCALE(dsrc[1] * iw00 + dsrc[3] * iw01 + dsrc[dStride + 1] * iw10 +
-							dsrc[dStride + 3] * iw11, W_BITS);
-
-						Iptr[x] = (short)ival;
-						dIptr[0] = (short)ixval;
-						dIptr[1] = (short)iyval;
-
-						A11 += (float)(ixval*ixval);
-						A12 += (float)(ixval*iyval);
-						A22 += (float)(iyval*iyval);
-					}
+					__m128i v00, v01, v10, v11, t0, t1;
+
+					v00 = _mm_unpacklo_epi8(_mm_cvtsi32_si128(*(const int*)(src + x)), z);
+					v01 = _mm_unpacklo_epi8(_mm_cvtsi32_si128(*(const int*)(src + x + 1)), z);
+					v10 = _mm_unpacklo_epi8(_mm_cvtsi32_si128(*(const int*)(src + x + IStride)), z);
+					v11 = _mm_unpacklo_epi8(_mm_cvtsi32_si128(*(const int*)(src + x + IStride + 1)), z);
+
+					t0 = _mm_add_epi32(_mm_madd_epi16(_mm_unpacklo_epi16(v00, v01), qw0),
+						_mm_madd_epi16(_mm_unpacklo_epi16(v10, v11), qw1));
+					t0 = _mm_srai_epi32(_mm_add_epi32(t0, qdelta), W_BITS - 5);
+					_mm_storel_epi64((__m128i*)(Iptr + x), _mm_packs_epi32(t0, t0));
+
+					v00 = _mm_loadu_si128((const __m128i*)(dsrc));
+					v01 = _mm_loadu_si128((const __m128i*)(dsrc + 2));
+					v10 = _mm_loadu_si128((const __m128i*)(dsrc + dIStride));
+					v11 = _mm_loadu_si128((const __m128i*)(dsrc + dIStride + 2));
+
+					t0 = _mm_add_epi32(_mm_madd_epi16(_mm_unpacklo_epi16(v00, v01), qw0),
+						_mm_madd_epi16(_mm_unpacklo_epi16(v10, v11), qw1));
+					t1 = _mm_add_epi32(_mm_madd_epi16(_mm_unpackhi_epi16(v00, v01), qw0),
+						_mm_madd_epi16(_mm_unpackhi_epi16(v10, v11), qw1));
+					t0 = _mm_srai_epi32(_mm_add_epi32(t0, qdelta_d), W_BITS);
+					t1 = _mm_srai_epi32(_mm_add_epi32(t1, qdelta_d), W_BITS);
+					v00 = _mm_packs_epi32(t0, t1); // Ix0 Iy0 Ix1 Iy1 ...
+
+					_mm_storeu_si128((__m128i*)dIptr, v00);
+					t0 = _mm_srai_epi32(v00, 16); // Iy0 Iy1 Iy2 Iy3
+					t1 = _mm_srai_epi32(_mm_slli_epi32(v00, 16), 16); // Ix0 Ix1 Ix2 Ix3
+
+					__m128 fy = _mm_cvtepi32_ps(t0);
+					__m128 fx = _mm_cvtepi32_ps(t1);
+
+					qA22 = _mm_add_ps(qA22, _mm_mul_ps(fy, fy));
+					qA12 = _mm_add_ps(qA12, _mm_mul_ps(fx, fy));
+					qA11 = _mm_add_ps(qA11, _mm_mul_ps(fx, fx));
 				}
-				// add with SSE output
-				if (winsz >= 4){
-					float DECL_ALIGN(16) A11buf[4] ATTR_ALIGN(16), A12buf[4] ATTR_ALIGN(16), A22buf[4] ATTR_ALIGN(16);
-					_mm_store_ps(A11buf, qA11);
-					_mm_store_ps(A12buf, qA12);
-					_mm_store_ps(A22buf, qA22);
-					A11 += A11buf[0] + A11buf[1] + A11buf[2] + A11buf[3];
-					A12 += A12buf[0] + A12buf[1] + A12buf[2] + A12buf[3];
-					A22 += A22buf[0] + A22buf[1] + A22buf[2] + A22buf[3];
+				// do computation for remaining x if any
+				for (; x < winsz; x++, dsrc += 2, dIptr += 2)
+				{
+					int ival = DESCALE(src[x] * iw00 + src[x + 1] * iw01 +
+						src[x + IStride] * iw10 + src[x + IStride + 1] * iw11, W_BITS - 5);
+					int ixval = DESCALE(dsrc[0] * iw00 + dsrc[2] * iw01 +
+						dsrc[dIStride] * iw10 + dsrc[dIStride + 2] * iw11, W_BITS);
+					int iyval = DESCALE(dsrc[1] * iw00 + dsrc[3] * iw01 + dsrc[dIStride + 1] * iw10 +
+						dsrc[dIStride + 3] * iw11, W_BITS);
+
+					Iptr[x] = (short)ival;
+					dIptr[0] = (short)ixval;
+					dIptr[1] = (short)iyval;
+
+					A11 += (float)(ixval*ixval);
+					A12 += (float)(ixval*iyval);
+					A22 += (float)(iyval*iyval);
 				}
-				A11 *= FLT_SCALE;
-				A12 *= FLT_SCALE;
-				A22 *= FLT_SCALE;
 			}
+			// add with SSE output
+			if (winsz >= 4){
+				float DECL_ALIGN(16) A11buf[4] ATTR_ALIGN(16), A12buf[4] ATTR_ALIGN(16), A22buf[4] ATTR_ALIGN(16);
+				_mm_store_ps(A11buf, qA11);
+				_mm_store_ps(A12buf, qA12);
+				_mm_store_ps(A22buf, qA22);
+				A11 += A11buf[0] + A11buf[1] + A11buf[2] + A11buf[3];
+				A12 += A12buf[0] + A12buf[1] + A12buf[2] + A12buf[3];
+				A22 += A22buf[0] + A22buf[1] + A22buf[2] + A22buf[3];
+			}
+			A11 *= FLT_SCALE;
+			A12 *= FLT_SCALE;
+			A22 *= FLT_SCALE;
+		}
 
-			float D = A11*A22 - A12*A12;
-			float minEig = (A22 + A11 - std::sqrt((A11 - A22)*(A11 - A22) +
-				4.f*A12*A12)) / (2 * winsz*winsz);
+		float D = A11*A22 - A12*A12;
+		float minEig = (A22 + A11 - std::sqrt((A11 - A22)*(A11 - A22) +
+			4.f*A12*A12)) / (2 * winsz*winsz);
 
-			if (minEig < 1.0e-04F || D < 1.0e-07F)
-			{
+		if (minEig < 1.0e-04F || D < 1.0e-07F)
+		{
+			if (!level){
+				newKeyPoint[pt].x = (vx_int32)nextPt.x;
+				newKeyPoint[pt].y = (vx_int32)nextPt.y;
+				newKeyPoint[pt].tracking_status = 0;
+				newKeyPoint[pt].error = 0;
+			}
+			continue;
+		}
+		D = 1.f / D;
+		float prevDelta_x = 0.f, prevDelta_y = 0.f;
+		float delta_dx = 0.f, delta_dy = 0.f;
+		unsigned int j = 0;
+		while (j < num_iterations || termination == VX_TERM_CRITERIA_EPSILON)
+		{
+			__m128i qw0, qw1;
+			inextPt.x = (vx_int32)floor(nextPt.x);
+			inextPt.y = (vx_int32)floor(nextPt.y);
+			bBound = (inextPt.x >> 31) | (inextPt.x >=(vx_int32)(JWidth - winsz)) | (inextPt.y >> 31) | (inextPt.y >= (vx_int32)(JHeight - winsz));
+			if (bBound){
 				if (!level){
-					newKeyPoint[pt].x = (vx_int32)nextPt.x;
-					newKeyPoint[pt].y = (vx_int32)nextPt.y;
 					newKeyPoint[pt].tracking_status = 0;
 					newKeyPoint[pt].error = 0;
 				}
-				continue;
+				break;	// go to next point.
 			}
-			D = 1.f / D;
-			float prevDelta_x = 0.f, prevDelta_y = 0.f;
-			float delta_dx = 0.f, delta_dy = 0.f;
-			unsigned int j = 0;
-			while (j < num_iterations || termination == VX_TERM_CRITERIA_EPSILON)
+			a = nextPt.x - inextPt.x;
+			b = nextPt.y - inextPt.y;
+			iw00 = (int)(((1.f - a)*(1.f - b)*(1 << W_BITS)) +0.5);
+			iw01 = (int)((a*(1.f - b)*(1 << W_BITS)) + 0.5);
+			iw10 = (int)(((1.f - a)*b*(1 << W_BITS))+0.5);
+			iw11 = (1 << W_BITS) - iw00 - iw01 - iw10;
+			double ib1 = 0, ib2 = 0;
+			float b1, b2;
+			//double b1, b2;
+			qw0 = _mm_set1_epi32(iw00 + (iw01 << 16));
+			qw1 = _mm_set1_epi32(iw10 + (iw11 << 16));
+			__m128 qb0 = _mm_setzero_ps(), qb1 = _mm_setzero_ps();
+			for (y = 0; y < winsz; y++)
 			{
-				__m128i qw0, qw1;
-				inextPt.x = (vx_int32)floor(nextPt.x);
-				inextPt.y = (vx_int32)floor(nextPt.y);
-				bBound = (inextPt.x >> 31) | (inextPt.x >=(vx_int32)(JWidth - winsz)) | (inextPt.y >> 31) | (inextPt.y >= (vx_int32)(JHeight - winsz));
-				if (bBound){
-					if (!level){
-						newKeyPoint[pt].tracking_status = 0;
-						newKeyPoint[pt].error = 0;
-					}
-					break;	// go to next point.
-				}
-				a = nextPt.x - inextPt.x;
-				b = nextPt.y - inextPt.y;
-				iw00 = (int)(((1.f - a)*(1.f - b)*(1 << W_BITS)) +0.5);
-				iw01 = (int)((a*(1.f - b)*(1 << W_BITS)) + 0.5);
-				iw10 = (int)(((1.f - a)*b*(1 << W_BITS))+0.5);
-				iw11 = (1 << W_BITS) - iw00 - iw01 - iw10;
-				double ib1 = 0, ib2 = 0;
-				float b1, b2;
-				//double b1, b2;
-				qw0 = _mm_set1_epi32(iw00 + (iw01 << 16));
-				qw1 = _mm_set1_epi32(iw10 + (iw11 << 16));
-				__m128 qb0 = _mm_setzero_ps(), qb1 = _mm_setzero_ps();
-				for (y = 0; y < winsz; y++)
-				{
-					const unsigned char* Jptr = JBase + (y + inextPt.y)*JStride + inextPt.x;;
-					vx_int16* Iptr = &Imat[y*winsz];
-					vx_int16* dIptr = &dIMat[y*winsz*2];
-
-					x = 0;
-					for (; x <= winsz - 8; x += 8, dIptr += 8 * 2)
-					{
-						__m128i diff0 = _mm_loadu_si128((const __m128i*)(Iptr + x)), diff1;
-						__m128i v00 = _mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i*)(Jptr + x)), z);
-						__m128i v01 = _mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i*)(Jptr + x + 1)), z);
-						__m128i v10 = _mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i*)(Jptr + x + JStride)), z);
-						__m128i v11 = _mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i*)(Jptr + x + JStride + 1)), z);
-
-						__m128i t0 = _mm_add_epi32(_mm_madd_epi16(_mm_unpacklo_epi16(v00, v01), qw0),
-							_mm_madd_epi16(_mm_unpacklo_epi16(v10, v11), qw1));
-						__m128i t1 = _mm_add_epi32(_mm_madd_epi16(_mm_unpackhi_epi16(v00, v01), qw0),
-							_mm_madd_epi16(_mm_unpackhi_epi16(v10, v11), qw1));
-						t0 = _mm_srai_epi32(_mm_add_epi32(t0, qdelta), W_BITS - 5);
-						t1 = _mm_srai_epi32(_mm_add_epi32(t1, qdelta), W_BITS - 5);
-						diff0 = _mm_subs_epi16(_mm_packs_epi32(t0, t1), diff0);
-						diff1 = _mm_unpackhi_epi16(diff0, diff0);
-						diff0 = _mm_unpacklo_epi16(diff0, diff0); // It0 It0 It1 It1 ...
-						v00 = _mm_loadu_si128((const __m128i*)(dIptr)); // Ix0 Iy0 Ix1 Iy1 ...
-						v01 = _mm_loadu_si128((const __m128i*)(dIptr + 8));
-						v10 = _mm_mullo_epi16(v00, diff0);
-						v11 = _mm_mulhi_epi16(v00, diff0);
-						v00 = _mm_unpacklo_epi16(v10, v11);
-						v10 = _mm_unpackhi_epi16(v10, v11);
-						qb0 = _mm_add_ps(qb0, _mm_cvtepi32_ps(v00));
-						qb1 = _mm_add_ps(qb1, _mm_cvtepi32_ps(v10));
-						v10 = _mm_mullo_epi16(v01, diff1);
-						v11 = _mm_mulhi_epi16(v01, diff1);
-						v00 = _mm_unpacklo_epi16(v10, v11);
-						v10 = _mm_unpackhi_epi16(v10, v11);
-						qb0 = _mm_add_ps(qb0, _mm_cvtepi32_ps(v00));
-						qb1 = _mm_add_ps(qb1, _mm_cvtepi32_ps(v10));
-					}
-					for (; x < winsz; x++, dIptr += 2)
-					{
-						int diff = DESCALE(Jptr[x] * iw00 + Jptr[x + 1] * iw01 +
-							Jptr[x + JStride] * iw10 + Jptr[x + JStride + 1] * iw11,
-							W_BITS - 5);
-						diff -= Iptr[x];
-						ib1 += (float)(diff*dIptr[0]);
-						ib2 += (float)(diff*dIptr[1]);
-					}
-				}
-				if (winsz >= 8)
+				const unsigned char* Jptr = JBase + (y + inextPt.y)*JStride + inextPt.x;;
+				vx_int16* Iptr = &Imat[y*winsz];
+				vx_int16* dIptr = &dIMat[y*winsz*2];
+
+				x = 0;
+				for (; x <= winsz - 8; x += 8, dIptr += 8 * 2)
 				{
-					float DECL_ALIGN(16) bbuf[4] ATTR_ALIGN(16);
-					_mm_store_ps(bbuf, _mm_add_ps(qb0, qb1));
-					ib1 += bbuf[0] + bbuf[2];
-					ib2 += bbuf[1] + bbuf[3];
+					__m128i diff0 = _mm_loadu_si128((const __m128i*)(Iptr + x)), diff1;
+					__m128i v00 = _mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i*)(Jptr + x)), z);
+					__m128i v01 = _mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i*)(Jptr + x + 1)), z);
+					__m128i v10 = _mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i*)(Jptr + x + JStride)), z);
+					__m128i v11 = _mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i*)(Jptr + x + JStride + 1)), z);
 
+					__m128i t0 = _mm_add_epi32(_mm_madd_epi16(_mm_unpacklo_epi16(v00, v01), qw0),
+						_mm_madd_epi16(_mm_unpacklo_epi16(v10, v11), qw1));
+					__m128i t1 = _mm_add_epi32(_mm_madd_epi16(_mm_unpackhi_epi16(v00, v01), qw0),
+						_mm_madd_epi16(_mm_unpackhi_epi16(v10, v11), qw1));
+					t0 = _mm_srai_epi32(_mm_add_epi32(t0, qdelta), W_BITS - 5);
+					t1 = _mm_srai_epi32(_mm_add_epi32(t1, qdelta), W_BITS - 5);
+					diff0 = _mm_subs_epi16(_mm_packs_epi32(t0, t1), diff0);
+					diff1 = _mm_unpackhi_epi16(diff0, diff0);
+					diff0 = _mm_unpacklo_epi16(diff0, diff0); // It0 It0 It1 It1 ...
+					v00 = _mm_loadu_si128((const __m128i*)(dIptr)); // Ix0 Iy0 Ix1 Iy1 ...
+					v01 = _mm_loadu_si128((const __m128i*)(dIptr + 8));
+					v10 = _mm_mullo_epi16(v00, diff0);
+					v11 = _mm_mulhi_epi16(v00, diff0);
+					v00 = _mm_unpacklo_epi16(v10, v11);
+					v10 = _mm_unpackhi_epi16(v10, v11);
+					qb0 = _mm_add_ps(qb0, _mm_cvtepi32_ps(v00));
+					qb1 = _mm_add_ps(qb1, _mm_cvtepi32_ps(v10));
+					v10 = _mm_mullo_epi16(v01, diff1);
+					v11 = _mm_mulhi_epi16(v01, diff1);
+					v00 = _mm_unpacklo_epi16(v10, v11);
+					v10 = _mm_unpackhi_epi16(v10, v11);
+					qb0 = _mm_add_ps(qb0, _mm_cvtepi32_ps(v00));
+					qb1 = _mm_add_ps(qb1, _mm_cvtepi32_ps(v10));
 				}
-				b1 = (float)(ib1*FLT_SCALE);
-				b2 = (float)(ib2*FLT_SCALE);
-				// calculate delta
-				float delta_x = (float)((A12*b2 - A22*b1) * D);
-				float delta_y = (float)((A12*b1 - A11*b2) * D);
-				// add to nextPt
-				nextPt.x += delta_x;
-				nextPt.y += delta_y;
-				if ((delta_x*delta_x + delta_y*delta_y) <= epsilon && (termination == VX_TERM_CRITERIA_EPSILON || termination == VX_TERM_CRITERIA_BOTH)){
-					break;
-				}
-				if (j > 0 && abs(delta_x + prevDelta_x) < 0.01 && abs(delta_y + prevDelta_y) < 0.01)
+				for (; x < winsz; x++, dIptr += 2)
 				{
-					delta_dx = delta_x*0.5f;
-					delta_dy = delta_y*0.5f;
-					break;
+					int diff = DESCALE(Jptr[x] * iw00 + Jptr[x + 1] * iw01 +
+						Jptr[x + JStride] * iw10 + Jptr[x + JStride + 1] * iw11,
+						W_BITS - 5);
+					diff -= Iptr[x];
+					ib1 += (float)(diff*dIptr[0]);
+					ib2 += (float)(diff*dIptr[1]);
 				}
-				prevDelta_x = delta_x;
-				prevDelta_y = delta_y;
-				j++;
 			}
-			if (!level){
-				newKeyPoint[pt].x = (vx_int32)(nextPt.x + halfWin - delta_dx + 0.5f);
-				newKeyPoint[pt].y = (vx_int32)(nextPt.y + halfWin - delta_dy + 0.5f);
+			if (winsz >= 8)
+			{
+				float DECL_ALIGN(16) bbuf[4] ATTR_ALIGN(16);
+				_mm_store_ps(bbuf, _mm_add_ps(qb0, qb1));
+				ib1 += bbuf[0] + bbuf[2];
+				ib2 += bbuf[1] + bbuf[3];
+
+			}
+			b1 = (float)(ib1*FLT_SCALE);
+			b2 = (float)(ib2*FLT_SCALE);
+			// calculate delta
+			float delta_x = (float)((A12*b2 - A22*b1) * D);
+			float delta_y = (float)((A12*b1 - A11*b2) * D);
+			// add to nextPt
+			nextPt.x += delta_x;
+			nextPt.y += delta_y;
+			if ((delta_x*delta_x + delta_y*delta_y) <= epsilon && (termination == VX_TERM_CRITERIA_EPSILON || termination == VX_TERM_CRITERIA_BOTH)){
+				break;
 			}
-			else
+			if (j > 0 && abs(delta_x + prevDelta_x) < 0.01 && abs(delta_y + prevDelta_y) < 0.01)
 			{
-				pNextPtArray[pt].x = (nextPt.x + halfWin - delta_dx);
-				pNextPtArray[pt].y = (nextPt.y + halfWin - delta_dy);
+				delta_dx = delta_x*0.5f;
+				delta_dy = delta_y*0.5f;
+				break;
 			}
+			prevDelta_x = delta_x;
+			prevDelta_y = delta_y;
+			j++;
+		}
+		if (!level){
+			newKeyPoint[pt].x = (vx_int32)(nextPt.x + halfWin - delta_dx + 0.5f);
+			newKeyPoint[pt].y = (vx_int32)(nextPt.y + halfWin - delta_dy + 0.5f);
+		}
+		else
+		{
+			pNextPtArray[pt].x = (nextPt.x + halfWin - delta_dx);
+			pNextPtArray[pt].y = (nextPt.y + halfWin - delta_dy);
 		}
 	}
+}
+
+static void OpticalFlowPyrLK_TrackKeyPointBand
+(
+	vx_uint32     band,
+	vx_uint32     bandCount,
+	void        * arg
+)
+{
+	OpticalFlowLevelData * data = (OpticalFlowLevelData *)arg;
+	vx_uint32 ptStart = (vx_uint32)(((vx_uint64)data->keyPointCount * band) / bandCount);
+	vx_uint32 ptEnd = (vx_uint32)(((vx_uint64)data->keyPointCount * (band + 1)) / bandCount);
+	OpticalFlowPyrLK_TrackKeyPoints(data, ptStart, ptEnd);
+}
+
+// set up derivative storage in DataPtr for images up to width x height: returns the memory after it
+static vx_uint8 * OpticalFlowPyrLK_InitDerivativeStorage
+(
+	OpticalFlowLevelData * data,
+	vx_uint32              width,
+	vx_uint32              height,
+	vx_uint32              keyPointCount,
+	vx_uint32              dataStrideInBytes,
+	vx_uint8             * DataPtr,
+	vx_bool                sparse
+)
+{
+	data->dStride = dataStrideInBytes>>1;		//in #of elements
+	data->tileCount = 0;
+	if (sparse) {
+		// tile cache layout: tile map of the largest image, list of cached tiles, and tile pool
+		vx_uint32 tileCount = ((width + AGO_OPTICALFLOW_TILE_SIZE - 1) >> AGO_OPTICALFLOW_TILE_SHIFT) * ((height + AGO_OPTICALFLOW_TILE_SIZE - 1) >> AGO_OPTICALFLOW_TILE_SHIFT);
+		vx_uint32 poolCount = min(tileCount, keyPointCount * AGO_OPTICALFLOW_TILES_PER_POINT);
+		data->pScharrScratch = nullptr;
+		data->DIBase = nullptr;
+		data->tileMap = (vx_int32 *)DataPtr;
+		data->tileList = (vx_uint32 *)(data->tileMap + tileCount);
+		data->tilePool = (vx_int16 *)ALIGN16(data->tileList + poolCount);
+		return (vx_uint8 *)(data->tilePool + poolCount * AGO_OPTICALFLOW_TILE_ELEMENTS);
+	}
+	data->pScharrScratch = DataPtr;
+	data->DIBase = (vx_int16 *)(DataPtr + (width + 2) * 4 + 64);
+	data->tileMap = nullptr;
+	data->tileList = nullptr;
+	data->tilePool = nullptr;
+	return (vx_uint8 *)data->DIBase + width * height * 4;
+}
+
+// calculate derivatives of the old image and track all keypoints at one level
+static void OpticalFlowPyrLK_TrackLevel
+(
+	OpticalFlowLevelData * data,
+	ago_pyramid_u8_t     * oldImage,
+	ago_pyramid_u8_t     * newImage,
+	vx_float32             pyramidScale,
+	vx_uint32              bandCount
+)
+{
+	data->dWidth = oldImage->width-2;
+	data->dHeight = oldImage->height-2;			// first and last row is not accounted
+	data->JWidth = newImage->width;
+	data->JHeight = newImage->height;
+	data->IStride = oldImage->strideInBytes;
+	data->JStride = newImage->strideInBytes;
+	data->SrcBase = oldImage->pImage;
+	data->JBase = newImage->pImage;
+	data->tilesX = (oldImage->width + AGO_OPTICALFLOW_TILE_SIZE - 1) >> AGO_OPTICALFLOW_TILE_SHIFT;
+	data->width = oldImage->width;
+	data->height = oldImage->height;
+	data->ptScale = (float)(pow(pyramidScale, data->level));
+
+	// calculate sharr derivatives Ix and Iy: whole image or only the tiles under keypoint windows
+	if (data->tileMap) {
+		OpticalFlowPyrLK_CollectTiles(data);
+		vx_uint32 tileBandCount = min(bandCount, data->tileCount / AGO_OPTICALFLOW_TILE_SIZE);
+		if (tileBandCount > 1) {
+			HafCpu_ParallelFor(tileBandCount, OpticalFlowPyrLK_ComputeTileBand, data);
+		}
+		else {
+			OpticalFlowPyrLK_ComputeTileBand(0, 1, data);
+		}
+	}
+	else {
+		ComputeSharr(data->dStride * 2, (vx_uint8 *)data->DIBase, oldImage->width, oldImage->height, oldImage->strideInBytes, oldImage->pImage, data->pScharrScratch);
+	}
+
+	// do the Lukas Kanade tracking for each feature point
+	if (bandCount > 1) {
+		HafCpu_ParallelFor(bandCount, OpticalFlowPyrLK_TrackKeyPointBand, data);
+	}
+	else {
+		OpticalFlowPyrLK_TrackKeyPoints(data, 0, data->keyPointCount);
+	}
+}
+
+static int OpticalFlowPyrLK_XY_XY
+(
+	vx_keypoint_t      newKeyPoint[],
+	vx_float32         pyramidScale,
+	vx_uint32          pyramidLevelCount,
+	ago_pyramid_u8_t * oldPyramid,
+	ago_pyramid_u8_t * newPyramid,
+	vx_uint32          keyPointCount,
+	vx_keypoint_t      oldKeyPoint[],
+	vx_keypoint_t      newKeyPointEstimate[],
+	vx_enum            termination,
+	vx_float32         epsilon,
+	vx_uint32          num_iterations,
+	vx_bool            use_initial_estimate,
+	vx_uint32          dataStrideInBytes,
+	vx_uint8         * DataPtr,
+	vx_int32           winsz,
+	vx_uint32          bandCount,
+	vx_bool            sparse
+)
+{
+	OpticalFlowLevelData data;
+	data.newKeyPoint = newKeyPoint;
+	data.oldKeyPoint = oldKeyPoint;
+	data.newKeyPointEstimate = newKeyPointEstimate;
+	data.keyPointCount = keyPointCount;
+	data.pyramidLevelCount = pyramidLevelCount;
+	data.use_initial_estimate = use_initial_estimate;
+	data.termination = termination;
+	data.epsilon = epsilon;
+	data.num_iterations = num_iterations;
+	data.winsz = winsz;
+	data.prepared = vx_false_e;
+	// level 0 buffers will be reused for lower levels; keypoints of next level follow them
+	data.pNextPtArray = (ago_keypoint_t *)OpticalFlowPyrLK_InitDerivativeStorage(&data, oldPyramid[0].width, oldPyramid[0].height, keyPointCount, dataStrideInBytes, DataPtr, sparse);
+	bandCount = max(1u, min(bandCount, keyPointCount));
+
+	for (int level = pyramidLevelCount - 1; level >= 0; level--)
+	{
+		data.level = level;
+		OpticalFlowPyrLK_TrackLevel(&data, &oldPyramid[level], &newPyramid[level], pyramidScale, bandCount);
+	}
+	return AGO_SUCCESS;
+}
+
+int HafCpu_OpticalFlowPyrLK_XY_XY_Generic
+(
+vx_keypoint_t      newKeyPoint[],
+vx_float32         pyramidScale,
+vx_uint32          pyramidLevelCount,
+ago_pyramid_u8_t * oldPyramid,
+ago_pyramid_u8_t * newPyramid,
+vx_uint32          keyPointCount,
+vx_keypoint_t      oldKeyPoint[],
+vx_keypoint_t      newKeyPointEstimate[],
+vx_enum            termination,
+vx_float32         epsilon,
+vx_uint32          num_iterations,
+vx_bool            use_initial_estimate,
+vx_uint32		   dataStrideInBytes,
+vx_uint8		 * DataPtr,
+vx_int32		   winsz
+)
+{
+	return OpticalFlowPyrLK_XY_XY(newKeyPoint, pyramidScale, pyramidLevelCount, oldPyramid, newPyramid, keyPointCount, oldKeyPoint, newKeyPointEstimate,
+		termination, epsilon, num_iterations, use_initial_estimate, dataStrideInBytes, DataPtr, winsz, 1, vx_false_e);
+}
+
+int HafCpu_OpticalFlowPyrLK_XY_XY_Parallel
+(
+vx_keypoint_t      newKeyPoint[],
+vx_float32         pyramidScale,
+vx_uint32          pyramidLevelCount,
+ago_pyramid_u8_t * oldPyramid,
+ago_pyramid_u8_t * newPyramid,
+vx_uint32          keyPointCount,
+vx_keypoint_t      oldKeyPoint[],
+vx_keypoint_t      newKeyPointEstimate[],
+vx_enum            termination,
+vx_float32         epsilon,
+vx_uint32          num_iterations,
+vx_bool            use_initial_estimate,
+vx_uint32		   dataStrideInBytes,
+vx_uint8		 * DataPtr,
+vx_int32		   winsz,
+vx_uint32          bandCount
+)
+{
+	return OpticalFlowPyrLK_XY_XY(newKeyPoint, pyramidScale, pyramidLevelCount, oldPyramid, newPyramid, keyPointCount, oldKeyPoint, newKeyPointEstimate,
+		termination, epsilon, num_iterations, use_initial_estimate, dataStrideInBytes, DataPtr, winsz, bandCount, vx_false_e);
+}
+
+int HafCpu_OpticalFlowPyrLK_XY_XY_Sparse
+(
+vx_keypoint_t      newKeyPoint[],
+vx_float32         pyramidScale,
+vx_uint32          pyramidLevelCount,
+ago_pyramid_u8_t * oldPyramid,
+ago_pyramid_u8_t * newPyramid,
+vx_uint32          keyPointCount,
+vx_keypoint_t      oldKeyPoint[],
+vx_keypoint_t      newKeyPointEstimate[],
+vx_enum            termination,
+vx_float32         epsilon,
+vx_uint32          num_iterations,
+vx_bool            use_initial_estimate,
+vx_uint8		 * DataPtr,
+vx_int32		   winsz,
+vx_uint32          bandCount
+)
+{
+	return OpticalFlowPyrLK_XY_XY(newKeyPoint, pyramidScale, pyramidLevelCount, oldPyramid, newPyramid, keyPointCount, oldKeyPoint, newKeyPointEstimate,
+		termination, epsilon, num_iterations, use_initial_estimate, 0, DataPtr, winsz, bandCount, vx_true_e);
+}
+
+vx_size HafCpu_OpticalFlowPyrLK_XY_XY_SparseScratchSize
+(
+vx_uint32          width,
+vx_uint32          height,
+vx_uint32          keyPointCount
+)
+{
+	vx_size tileCount = ((width + AGO_OPTICALFLOW_TILE_SIZE - 1) >> AGO_OPTICALFLOW_TILE_SHIFT) * ((height + AGO_OPTICALFLOW_TILE_SIZE - 1) >> AGO_OPTICALFLOW_TILE_SHIFT);
+	vx_size poolCount = min(tileCount, (vx_size)keyPointCount * AGO_OPTICALFLOW_TILES_PER_POINT);
+	return tileCount * sizeof(vx_int32) + poolCount * (sizeof(vx_uint32) + AGO_OPTICALFLOW_TILE_ELEMENTS * sizeof(vx_int16)) + 16 + keyPointCount * sizeof(ago_keypoint_t);
+}
+
+int HafCpu_OpticalFlowPrepareLK_XY_XY
+(
+vx_keypoint_t      newKeyPoint[],
+ago_keypoint_t     nextPt[],
+vx_uint32          keyPointCount,
+vx_keypoint_t      oldKeyPoint[],
+vx_keypoint_t      newKeyPointEstimate[],
+vx_bool            use_initial_estimate,
+vx_float32         pyramidScale,
+vx_uint32          pyramidLevelCount
+)
+{
+	float ptScale = (float)(pow(pyramidScale, (int)pyramidLevelCount - 1));
+	for (vx_uint32 pt = 0; pt < keyPointCount; pt++) {
+		newKeyPoint[pt] = oldKeyPoint[pt];
+		if (oldKeyPoint[pt].tracking_status) {
+			OpticalFlowPyrLK_PrepareKeyPoint(&newKeyPoint[pt], &nextPt[pt], &oldKeyPoint[pt], &newKeyPointEstimate[pt], use_initial_estimate, ptScale);
+		}
+		else {
+			nextPt[pt].x = nextPt[pt].y = 0.0f;
+		}
+	}
+	return AGO_SUCCESS;
+}
+
+int HafCpu_OpticalFlowImageLK_XY_XY
+(
+vx_keypoint_t      newKeyPoint[],
+ago_keypoint_t     nextPt[],
+vx_keypoint_t      keyPoint[],
+ago_keypoint_t     prevNextPt[],
+vx_uint32          keyPointCount,
+vx_keypoint_t      oldKeyPoint[],
+ago_pyramid_u8_t * oldImage,
+ago_pyramid_u8_t * newImage,
+vx_enum            termination,
+vx_float32         epsilon,
+vx_uint32          num_iterations,
+vx_int32           winsz,
+vx_float32         pyramidScale,
+vx_uint32          level,
+vx_uint32          pyramidLevelCount,
+vx_uint8         * DataPtr,
+vx_bool            sparse,
+vx_uint32          bandCount
+)
+{
+	// tracking state of the previous level is updated in the outputs
+	memcpy(newKeyPoint, keyPoint, keyPointCount * sizeof(vx_keypoint_t));
+	memcpy(nextPt, prevNextPt, keyPointCount * sizeof(ago_keypoint_t));
+
+	OpticalFlowLevelData data;
+	data.newKeyPoint = newKeyPoint;
+	data.oldKeyPoint = oldKeyPoint;
+	data.newKeyPointEstimate = nullptr;
+	data.pNextPtArray = nextPt;
+	data.keyPointCount = keyPointCount;
+	data.pyramidLevelCount = pyramidLevelCount;
+	data.level = (int)level;
+	data.use_initial_estimate = vx_false_e;
+	data.termination = termination;
+	data.epsilon = epsilon;
+	data.num_iterations = num_iterations;
+	data.winsz = winsz;
+	data.prepared = vx_true_e;
+	OpticalFlowPyrLK_InitDerivativeStorage(&data, oldImage->width, oldImage->height, keyPointCount, oldImage->width * 4, DataPtr, sparse);
+	OpticalFlowPyrLK_TrackLevel(&data, oldImage, newImage, pyramidScale, max(1u, min(bandCount, keyPointCount)));
 	return AGO_SUCCESS;
 }
@@ -1547,6 +1547,22 @@ int agoVerifyGraph(AgoGraph * graph)
 	}
 	agoOptimizeDramaSortGraphHierarchy(graph);
 
+	// count node parameters using each non-virtual data before the graph gets optimized,
+	// so that data used by only one of them can be replaced later with agoRebindDataInGraph
+	if (!graph->userParamRefCountValid) {
+		graph->userParamRefCount.clear();
+		for (AgoNode * node = graph->nodeList.head; node; node = node->next) {
+			for (vx_uint32 i = 0; i < node->paramCount; i++) {
+				AgoData * data = node->paramList[i];
+				if (data && !data->isVirtual) {
+					graph->userParamRefCount[data]++;
+					if (data->parent)
+						graph->userParamRefCount[data->parent]++;
+				}
+			}
+		}
+	}
+
 	// initialize valid region every input image/pyramid to its full region
 	// and reset the user virtul buffer owner
 	for (AgoNode * node = graph->nodeList.head; node; node = node->next) {
@@ -1558,6 +1574,9 @@ int agoVerifyGraph(AgoGraph * graph)
 						data->ownerOfUserBufferOpenCL = nullptr;
 					}
 				}
+				else if (data->ref.type == VX_TYPE_CONVOLUTION) {
+					data->u.conv.is_separable = agoGetConvolutionSeparableFactors(data, nullptr, nullptr);
+				}
 			}
 		}
 	}
@@ -1749,37 +1768,163 @@ vx_status agoComputeImageValidRectangleOutputs(AgoGraph * graph)
 	return status;
 }
 
+vx_status agoInitializeNode(AgoNode * node)
+{
+	AgoKernel * kernel = node->akernel;
+	vx_status status = VX_SUCCESS;
+	if (kernel->func) {
+		status = kernel->func(node, ago_kernel_cmd_initialize);
+	}
+	else if (kernel->initialize_f) {
+		status = kernel->initialize_f(node, (vx_reference *)node->paramList, node->paramCount);
+	}
+	if (status) {
+		return status;
+	}
+	if (node->localDataSize > 0 && node->localDataPtr == nullptr) {
+		if (node->localDataPtr_allocated)
+			delete[] node->localDataPtr_allocated;
+		node->localDataPtr = node->localDataPtr_allocated = (vx_uint8 *)agoAllocMemory(node->localDataSize);
+		if (!node->localDataPtr) {
+			return VX_ERROR_NO_MEMORY;
+		}
+		memset(node->localDataPtr, 0, node->localDataSize);
+	}
+	node->initialized = true;
+	// keep a copy of paramList into paramListForAgeDelay
+	// TBD: needs to handle reverification path
+	memcpy(node->paramListForAgeDelay, node->paramList, sizeof(node->paramListForAgeDelay));
+	return VX_SUCCESS;
+}
+
 int agoInitializeGraph(AgoGraph * graph)
 {
+	int64_t clockCounter = agoGetClockCounter();
 	for (AgoNode * node = graph->nodeList.head; node; node = node->next)
 	{
-		AgoKernel * kernel = node->akernel;
-		vx_status status = VX_SUCCESS;
-		if (kernel->func) {
-			status = kernel->func(node, ago_kernel_cmd_initialize);
-		}
-		else if (kernel->initialize_f) {
-			status = kernel->initialize_f(node, (vx_reference *)node->paramList, node->paramCount);
-		}
+		vx_status status = agoInitializeNode(node);
 		if (status) {
 			return status;
 		}
-		else {
-			if (node->localDataSize > 0 && node->localDataPtr == nullptr) {
-				if (node->localDataPtr_allocated)
-					delete[] node->localDataPtr_allocated;
-				node->localDataPtr = node->localDataPtr_allocated = (vx_uint8 *)agoAllocMemory(node->localDataSize);
-				if (!node->localDataPtr) {
-					return VX_ERROR_NO_MEMORY;
+	}
+	graph->userParamRefCountValid = true;
+	agoOptimizerLogTime(graph, "initialize", clockCounter);
+	return VX_SUCCESS;
+}
+
+static vx_status agoReinitializeNode(AgoNode * node)
+{
+	// agoShutdownNode releases kernels and local data of the node and its fused nodes,
+	// which need to be reset before agoInitializeNode
+	std::vector<AgoNode *> nodeList(1, node);
+	nodeList.insert(nodeList.end(), node->fusedNodeList.begin(), node->fusedNodeList.end());
+	std::vector<AgoKernel *> kernelList;
+	for (AgoNode * anode : nodeList) {
+		kernelList.push_back(anode->akernel);
+		if (anode->localDataPtr == anode->localDataPtr_allocated)
+			anode->localDataPtr = nullptr;
+	}
+	vx_status status = agoShutdownNode(node);
+	if (status) {
+		return status;
+	}
+	for (size_t i = 0; i < nodeList.size(); i++) {
+		nodeList[i]->akernel = kernelList[i];
+	}
+	return agoInitializeNode(node);
+}
+
+vx_status agoRebindDataInGraph(AgoGraph * graph, AgoData * dataFind, AgoData * dataReplace)
+{
+	// replace non-virtual data in a verified graph with data of same meta format without running the
+	// graph optimizer again: the data must be used by only one node parameter of the graph created by
+	// user and by CPU nodes after optimization, and the nodes using it get initialized again
+	CAgoLock lock(graph->cs);
+	CAgoLock lock2(graph->ref.context->cs);
+	auto count = graph->userParamRefCount.find(dataFind);
+	if (count == graph->userParamRefCount.end() || count->second != 1 || graph->userParamRefCount.count(dataReplace) ||
+		dataFind->ref.type != dataReplace->ref.type || dataFind->isVirtual || dataReplace->isVirtual || dataFind->parent || dataReplace->parent ||
+		dataFind->ref.read_only || agoIsPartOfDelay(dataFind) || agoIsPartOfDelay(dataReplace))
+	{
+		return VX_ERROR_NOT_SUPPORTED;
+	}
+	if (dataFind->ref.type == VX_TYPE_IMAGE) {
+		if (dataFind->u.img.format != dataReplace->u.img.format || dataFind->u.img.width != dataReplace->u.img.width ||
+			dataFind->u.img.height != dataReplace->u.img.height || dataFind->numChildren != dataReplace->numChildren ||
+			dataFind->u.img.isROI || dataReplace->u.img.isROI || dataFind->u.img.isUniform || !dataFind->roiDepList.empty())
+		{
+			return VX_ERROR_NOT_SUPPORTED;
+		}
+	}
+	else if (dataFind->ref.type == VX_TYPE_SCALAR) {
+		// values read by graph optimizer (e.g., to pick kernels) can't change after verification
+		if (dataFind->u.scalar.type != dataReplace->u.scalar.type ||
+			(dataFind->isValueUsedByOptimizer && memcmp(&dataFind->u.scalar.u, &dataReplace->u.scalar.u, dataFind->u.scalar.itemsize) != 0))
+		{
+			return VX_ERROR_NOT_SUPPORTED;
+		}
+	}
+	else if (dataFind->ref.type == VX_TYPE_ARRAY) {
+		if (dataFind->u.arr.itemtype != dataReplace->u.arr.itemtype || dataFind->u.arr.capacity != dataReplace->u.arr.capacity) {
+			return VX_ERROR_NOT_SUPPORTED;
+		}
+	}
+	else {
+		return VX_ERROR_NOT_SUPPORTED;
+	}
+
+	// find nodes using the data or its children: data not used by any node has been consumed by graph optimizer
+	std::vector<AgoNode *> nodeList;
+	for (AgoNode * node = graph->nodeList.head; node; node = node->next) {
+		bool found = false;
+		std::vector<AgoNode *> anodeList(1, node);
+		anodeList.insert(anodeList.end(), node->fusedNodeList.begin(), node->fusedNodeList.end());
+		for (AgoNode * anode : anodeList) {
+			for (vx_uint32 arg = 0; arg < anode->paramCount; arg++) {
+				AgoData * data = anode->paramList[arg];
+				if (data && (data == dataFind || data->parent == dataFind))
+					found = true;
+			}
+		}
+		if (found) {
+			if (node->attr_affinity.device_type != AGO_KERNEL_FLAG_DEVICE_CPU || node->akernel->opencl_buffer_access_enable)
+				return VX_ERROR_NOT_SUPPORTED;
+			nodeList.push_back(node);
+		}
+	}
+	if (nodeList.empty()) {
+		return VX_ERROR_NOT_SUPPORTED;
+	}
+	if (agoAllocData(dataReplace)) {
+		return VX_ERROR_NO_MEMORY;
+	}
+
+	// replace data in the nodes and initialize them again
+	for (AgoNode * node : nodeList) {
+		std::vector<AgoNode *> anodeList(1, node);
+		anodeList.insert(anodeList.end(), node->fusedNodeList.begin(), node->fusedNodeList.end());
+		for (AgoNode * anode : anodeList) {
+			for (vx_uint32 arg = 0; arg < anode->paramCount; arg++) {
+				AgoData * data = anode->paramList[arg];
+				if (data == dataFind) {
+					anode->paramList[arg] = dataReplace;
+				}
+				else if (data && data->parent == dataFind) {
+					for (vx_uint32 child = 0; child < dataFind->numChildren; child++) {
+						if (dataFind->children[child] == data)
+							anode->paramList[arg] = dataReplace->children[child];
+					}
 				}
-				memset(node->localDataPtr, 0, node->localDataSize);
 			}
-			node->initialized = true;
-			// keep a copy of paramList into paramListForAgeDelay
-			// TBD: needs to handle reverification path
-			memcpy(node->paramListForAgeDelay, node->paramList, sizeof(node->paramListForAgeDelay));
+		}
+		vx_status status = agoReinitializeNode(node);
+		if (status) {
+			agoAddLogEntry(&node->ref, status, "ERROR: agoRebindDataInGraph: node initialization failed\n");
+			return status;
 		}
 	}
+	graph->userParamRefCount.erase(dataFind);
+	graph->userParamRefCount[dataReplace] = 1;
 	return VX_SUCCESS;
 }
 
@@ -1911,6 +2056,335 @@ static int agoDataSyncFromGpuToCpu(AgoGraph * graph, AgoNode * node, AgoData * d
 }
 #endif
 
+static vx_status agoExecuteNodeInRegion(AgoNode * node)
+{
+	// execute the node with its images replaced by views of node->rect_exec
+	vx_rectangle_t rect = node->rect_exec;
+	if (rect.start_x >= rect.end_x || rect.start_y >= rect.end_y)
+		return VX_SUCCESS;
+	AgoData * paramList[AGO_MAX_PARAMS];
+	memcpy(paramList, node->paramList, sizeof(paramList));
+	size_t view = 0;
+	for (vx_uint32 arg = 0; arg < node->paramCount; arg++) {
+		AgoData * data = paramList[arg];
+		if (data && data->ref.type == VX_TYPE_IMAGE) {
+			AgoData * dataView = node->regionViewList[view++];
+			dataView->u.img = data->u.img;
+			dataView->u.img.width = rect.end_x - rect.start_x;
+			dataView->u.img.height = rect.end_y - rect.start_y;
+			dataView->buffer = data->buffer + (size_t)rect.start_y * data->u.img.stride_in_bytes + ImageWidthInBytesFloor(rect.start_x, data);
+			node->paramList[arg] = dataView;
+		}
+	}
+	vx_status status = node->akernel->func(node, ago_kernel_cmd_execute);
+	memcpy(node->paramList, paramList, sizeof(paramList));
+	return status;
+}
+
+static vx_status agoExecuteNodeOnCpu(AgoNode * node)
+{
+	// execute the node on its required region with the thread limit picked by auto-tune
+	vx_status status;
+	HafCpu_SetThreadLimit(node->cpu_thread_limit);
+	if (node->rect_exec_partial && node->fusedNodeList.empty())
+		status = agoExecuteNodeInRegion(node);
+	else
+		status = node->akernel->func(node, ago_kernel_cmd_execute);
+	HafCpu_SetThreadLimit(0);
+	return status;
+}
+
+// kernels that are drop-in replacements of each other with identical results
+static const vx_enum s_tuneKernelVariants[][2] = {
+	{ VX_KERNEL_AMD_CONVOLVE_U8_U8_SEPARABLE, VX_KERNEL_AMD_CONVOLVE_U8_U8 },
+	{ VX_KERNEL_AMD_CONVOLVE_S16_U8_SEPARABLE, VX_KERNEL_AMD_CONVOLVE_S16_U8 },
+};
+
+struct AgoTuneVariant {
+	AgoKernel * akernel;
+	vx_uint32 cpu_thread_limit;
+	vx_uint32 strip_size;
+};
+
+static std::string agoTuneGetFileName()
+{
+	char textBuffer[1024];
+	if (agoGetEnvironmentVariable("AGO_TUNE_FILE", textBuffer, sizeof(textBuffer)) && textBuffer[0])
+		return textBuffer;
+	if (agoGetEnvironmentVariable("AGO_GRAPH_CACHE_DIR", textBuffer, sizeof(textBuffer)) && textBuffer[0])
+		return std::string(textBuffer) + "/ago-tune.txt";
+	return "";
+}
+
+static std::string agoTuneGetNodeSignature(AgoNode * node)
+{
+	// kernel, image sizes, other arguments, and the nodes inside fused nodes
+	char text[1024];
+	sprintf(text, "%s:%u", node->akernel->name, HafCpu_GetThreadCount());
+	std::string signature = text;
+	std::vector<AgoNode *> nodeList(1, node);
+	nodeList.insert(nodeList.end(), node->fusedNodeList.begin(), node->fusedNodeList.end());
+	for (AgoNode * anode : nodeList) {
+		if (anode != node) {
+			signature += ";";
+			signature += anode->akernel->name;
+		}
+		for (vx_uint32 arg = 0; arg < anode->paramCount; arg++) {
+			AgoData * data = anode->paramList[arg];
+			if (!data)
+				sprintf(text, ",null");
+			else if (data->ref.type == VX_TYPE_IMAGE)
+				sprintf(text, ",%4.4s:%ux%u", FORMAT_STR(data->u.img.format), data->u.img.width, data->u.img.height);
+			else {
+				text[0] = ',';
+				agoGetDescriptionFromData(node->ref.context, text + 1, data);
+				if ((data->ref.type == VX_TYPE_CONVOLUTION || data->ref.type == VX_TYPE_MATRIX) && data->buffer) {
+					// coefficients decide the speed of some kernels, e.g., separable convolution
+					vx_uint32 hash = 2166136261u;
+					for (vx_size i = 0; i < data->size; i++)
+						hash = (hash ^ data->buffer[i]) * 16777619u;
+					sprintf(text + strlen(text), ":%08x", hash);
+				}
+			}
+			signature += text;
+		}
+	}
+	if (node->rect_exec_partial) {
+		sprintf(text, ",exec:%ux%u", node->rect_exec.end_x - node->rect_exec.start_x, node->rect_exec.end_y - node->rect_exec.start_y);
+		signature += text;
+	}
+	for (char& c : signature) {
+		if (c == ' ' || c == '\t' || c == '\n')
+			c = '_';
+	}
+	return signature;
+}
+
+static vx_status agoTuneSetVariant(AgoNode * node, const AgoTuneVariant& variant)
+{
+	if (node->akernel != variant.akernel) {
+		node->akernel->ref.internal_count--;
+		node->akernel = variant.akernel;
+		node->akernel->ref.internal_count++;
+		node->localDataSize = node->akernel->localDataSize;
+	}
+	node->cpu_thread_limit = variant.cpu_thread_limit;
+	node->strip_size = variant.strip_size;
+	return agoReinitializeNode(node);
+}
+
+static vx_status agoTuneMeasureVariant(AgoNode * node, std::map<AgoData *, AgoData *>& syntheticData, float& msec)
+{
+	// run the node on synthetic images: one run to warm up and the fastest of three timed runs
+	std::vector<AgoNode *> nodeList(1, node);
+	nodeList.insert(nodeList.end(), node->fusedNodeList.begin(), node->fusedNodeList.end());
+	std::vector< std::vector<AgoData *> > paramList;
+	for (AgoNode * anode : nodeList) {
+		paramList.push_back(std::vector<AgoData *>(anode->paramList, anode->paramList + anode->paramCount));
+		for (vx_uint32 arg = 0; arg < anode->paramCount; arg++) {
+			auto it = syntheticData.find(anode->paramList[arg]);
+			if (it != syntheticData.end())
+				anode->paramList[arg] = it->second;
+		}
+	}
+	vx_status status = VX_SUCCESS;
+	vx_int64 best = 0;
+	for (int run = 0; run < 4 && status == VX_SUCCESS; run++) {
+		vx_int64 t0 = agoGetClockCounter();
+		status = agoExecuteNodeOnCpu(node);
+		vx_int64 t1 = agoGetClockCounter();
+		if (run == 1 || (run > 1 && t1 - t0 < best))
+			best = t1 - t0;
+	}
+	for (size_t i = 0; i < nodeList.size(); i++) {
+		for (vx_uint32 arg = 0; arg < nodeList[i]->paramCount; arg++)
+			nodeList[i]->paramList[arg] = paramList[i][arg];
+	}
+	msec = (float)best * 1000.0f / (float)agoGetClockFrequency();
+	return status;
+}
+
+int agoTuneGraph(AgoGraph * graph)
+{
+	AgoContext * context = graph->ref.context;
+	int64_t clockCounter = agoGetClockCounter();
+	char cpuName[64];
+	agoGetCpuModelName(cpuName, sizeof(cpuName));
+
+	// load results of earlier tuning on this CPU: "<cpu>\t<node-signature>\t<kernel>\t<thread-limit>\t<strip-size>"
+	std::string fileName = agoTuneGetFileName();
+	std::map<std::string, AgoTuneVariant> tuneCache;
+	FILE * fp = fileName.length() ? fopen(fileName.c_str(), "r") : NULL;
+	if (fp) {
+		char line[4096];
+		while (fgets(line, sizeof(line), fp)) {
+			char * field[5] = { 0 };
+			char * s = line;
+			int count = 0;
+			for (; count < 5 && s; count++) {
+				field[count] = s;
+				s = strpbrk(s, "\t\r\n");
+				if (s) *s++ = '\0';
+			}
+			AgoKernel * akernel = (count == 5) ? agoFindKernelByName(context, field[2]) : NULL;
+			if (akernel && !strcmp(field[0], cpuName)) {
+				AgoTuneVariant variant = { akernel, (vx_uint32)atoi(field[3]), (vx_uint32)atoi(field[4]) };
+				tuneCache[field[1]] = variant;
+			}
+		}
+		fclose(fp);
+	}
+
+	std::string tuneResults;
+	for (AgoNode * node = graph->nodeList.head; node; node = node->next) {
+		// only CPU nodes of built-in kernels that don't write to objects other than images
+		AgoKernel * kernel = node->akernel;
+		if (node->attr_affinity.device_type != AGO_KERNEL_FLAG_DEVICE_CPU || !kernel->func || kernel->opencl_buffer_access_enable)
+			continue;
+		std::vector<AgoNode *> nodeList(1, node);
+		nodeList.insert(nodeList.end(), node->fusedNodeList.begin(), node->fusedNodeList.end());
+		bool supported = true;
+		for (AgoNode * anode : nodeList) {
+			for (vx_uint32 arg = 0; arg < anode->paramCount; arg++) {
+				AgoData * data = anode->paramList[arg];
+				if (data && data->ref.type != VX_TYPE_IMAGE && (anode->akernel->argConfig[arg] & AGO_KERNEL_ARG_OUTPUT_FLAG))
+					supported = false;
+			}
+		}
+		if (!supported)
+			continue;
+
+		// use the variant picked earlier for the same node on this CPU
+		std::string signature = agoTuneGetNodeSignature(node);
+		auto itCache = tuneCache.find(signature);
+		if (itCache != tuneCache.end()) {
+			bool valid = (itCache->second.akernel == kernel);
+			for (size_t i = 0; i < sizeof(s_tuneKernelVariants) / sizeof(s_tuneKernelVariants[0]); i++) {
+				if ((kernel->id == s_tuneKernelVariants[i][0] || kernel->id == s_tuneKernelVariants[i][1]) &&
+					(itCache->second.akernel->id == s_tuneKernelVariants[i][0] || itCache->second.akernel->id == s_tuneKernelVariants[i][1]))
+					valid = true;
+			}
+			if (valid) {
+				vx_status status = agoTuneSetVariant(node, itCache->second);
+				if (status) {
+					agoAddLogEntry(&node->ref, status, "ERROR: agoTuneGraph: node initialization failed\n");
+					return status;
+				}
+				if (graph->enable_optimizer_log) {
+					agoOptimizerLogEntry(graph, "tune", "cached", "%s threads:%u strip:%u", agoGetNodeLogName(node).c_str(),
+						node->cpu_thread_limit, node->strip_size);
+				}
+			}
+			continue;
+		}
+
+		// synthetic images with the same layout as the node images
+		std::map<AgoData *, AgoData *> syntheticData;
+		std::vector<void *> syntheticMemory;
+		vx_uint32 seed = 12345;
+		for (AgoNode * anode : nodeList) {
+			for (vx_uint32 arg = 0; arg < anode->paramCount; arg++) {
+				AgoData * data = anode->paramList[arg];
+				if (data && data->ref.type == VX_TYPE_IMAGE && syntheticData.find(data) == syntheticData.end()) {
+					// a few extra rows around the image for kernels that read outside of it
+					vx_size stride = data->u.img.stride_in_bytes, size = stride * (data->u.img.height + 8);
+					vx_uint8 * mem = (vx_uint8 *)agoAllocMemory(size);
+					if (!mem) {
+						supported = false;
+						break;
+					}
+					for (vx_size i = 0; i < size; i++) {
+						seed = seed * 1103515245 + 12345;
+						mem[i] = (vx_uint8)(seed >> 16);
+					}
+					syntheticMemory.push_back(mem);
+					AgoData * sdata = new AgoData;
+					sdata->ref.type = VX_TYPE_IMAGE;
+					sdata->ref.context = context;
+					sdata->u.img = data->u.img;
+					sdata->buffer = mem + 4 * stride;
+					syntheticData[data] = sdata;
+				}
+			}
+		}
+
+		// candidates: kernel variants, serial execution of band-parallel kernels, and strip sizes of fused nodes
+		AgoTuneVariant current = { kernel, node->cpu_thread_limit, node->strip_size };
+		std::vector<AgoTuneVariant> variantList(1, current);
+		for (size_t i = 0; i < sizeof(s_tuneKernelVariants) / sizeof(s_tuneKernelVariants[0]); i++) {
+			for (int j = 0; j < 2; j++) {
+				AgoKernel * akernel = (kernel->id == s_tuneKernelVariants[i][j]) ? agoFindKernelByEnum(context, s_tuneKernelVariants[i][1 - j]) : NULL;
+				if (akernel) {
+					AgoTuneVariant variant = { akernel, current.cpu_thread_limit, current.strip_size };
+					variantList.push_back(variant);
+				}
+			}
+		}
+		if (!node->fusedNodeList.empty()) {
+			for (vx_uint32 stripSize = AGO_ELEMWISE_FUSION_STRIP_SIZE / 4; stripSize <= AGO_ELEMWISE_FUSION_STRIP_SIZE * 4; stripSize *= 2) {
+				if (stripSize != AGO_ELEMWISE_FUSION_STRIP_SIZE) {
+					AgoTuneVariant variant = { kernel, current.cpu_thread_limit, stripSize };
+					variantList.push_back(variant);
+				}
+			}
+		}
+		vx_status status = VX_SUCCESS;
+		float msecBest = 0;
+		size_t best = 0;
+		for (size_t i = 0; supported && status == VX_SUCCESS && i < variantList.size(); i++) {
+			float msec = 0;
+			vx_uint32 parallelForCount = HafCpu_GetParallelForCount();
+			if (i > 0)
+				status = agoTuneSetVariant(node, variantList[i]);
+			if (status == VX_SUCCESS)
+				status = agoTuneMeasureVariant(node, syntheticData, msec);
+			// pick another variant only when it is at least 5% faster
+			if (status == VX_SUCCESS && (i == 0 || msec < msecBest * 0.95f)) {
+				msecBest = msec;
+				best = i;
+			}
+			if (i == 0 && HafCpu_GetParallelForCount() != parallelForCount && HafCpu_GetThreadCount() > 1) {
+				AgoTuneVariant variant = { kernel, 1, current.strip_size };
+				variantList.push_back(variant);
+			}
+		}
+		for (auto it = syntheticData.begin(); it != syntheticData.end(); ++it)
+			delete it->second;
+		for (void * mem : syntheticMemory)
+			agoReleaseMemory(mem);
+		if (status == VX_SUCCESS && supported)
+			status = agoTuneSetVariant(node, variantList[best]);
+		if (status) {
+			agoAddLogEntry(&node->ref, status, "ERROR: agoTuneGraph: failed for node %s\n", node->akernel->name);
+			return status;
+		}
+		if (supported) {
+			if (graph->enable_optimizer_log) {
+				agoOptimizerLogEntry(graph, "tune", "variant", "%s threads:%u strip:%u (fastest of %d, %.3f ms)", agoGetNodeLogName(node).c_str(),
+					node->cpu_thread_limit, node->strip_size, (int)variantList.size(), msecBest);
+			}
+			char text[256];
+			snprintf(text, sizeof(text), "\t%s\t%u\t%u\n", variantList[best].akernel->name, variantList[best].cpu_thread_limit, variantList[best].strip_size);
+			tuneResults += std::string(cpuName) + "\t" + signature + text;
+			tuneCache[signature] = variantList[best];
+		}
+	}
+
+	// save results of this tuning for use by other graphs and processes
+	if (tuneResults.length() && fileName.length()) {
+		fp = fopen(fileName.c_str(), "a");
+		if (fp) {
+			fwrite(tuneResults.c_str(), 1, tuneResults.length(), fp);
+			fclose(fp);
+		}
+		else {
+			agoAddLogEntry(&graph->ref, VX_SUCCESS, "WARNING: agoTuneGraph: unable to update %s\n", fileName.c_str());
+		}
+	}
+	agoOptimizerLogTime(graph, "tune", clockCounter);
+	return VX_SUCCESS;
+}
+
 int agoUpdateDelaySlots(AgoNode * node)
 {
 	vx_graph graph = (vx_graph)node->ref.scope;
@@ -2121,7 +2595,7 @@ int agoExecuteGraph(AgoGraph * graph)
 				AgoKernel * kernel = node->akernel;
 				status = VX_SUCCESS;
 				if (kernel->func) {
-					status = kernel->func(node, ago_kernel_cmd_execute);
+					status = agoExecuteNodeOnCpu(node);
 					if (status == AGO_ERROR_KERNEL_NOT_IMPLEMENTED)
 						status = VX_ERROR_NOT_IMPLEMENTED;
 				}
@@ -2228,6 +2702,27 @@ vx_status agoDirective(vx_reference reference, vx_enum directive)
 				if (reference->type == VX_TYPE_CONVOLUTION || reference->type == VX_TYPE_MATRIX) {
 					if (((AgoData *)reference)->buffer) {
 						reference->read_only = true;
+						if (reference->type == VX_TYPE_CONVOLUTION) {
+							// coefficients can't change anymore: re-detect rank-1 factorization
+							AgoData * data = (AgoData *)reference;
+							data->u.conv.is_separable = agoGetConvolutionSeparableFactors(data, nullptr, nullptr);
+						}
+					}
+					else {
+						status = VX_ERROR_NOT_SUPPORTED;
+					}
+				}
+				else if (reference->type == VX_TYPE_LUT) {
+					if (((AgoData *)reference)->buffer && ((AgoData *)reference)->mapped.empty()) {
+						reference->read_only = true;
+					}
+					else {
+						status = VX_ERROR_NOT_SUPPORTED;
+					}
+				}
+				else if (reference->type == VX_TYPE_SCALAR || reference->type == VX_TYPE_THRESHOLD) {
+					if (!((AgoData *)reference)->isVirtual) {
+						reference->read_only = true;
 					}
 					else {
 						status = VX_ERROR_NOT_SUPPORTED;
@@ -2300,6 +2795,16 @@ vx_status agoDirective(vx_reference reference, vx_enum directive)
 				}
 				break;
 #endif
+			case VX_DIRECTIVE_AMD_ENABLE_OPTIMIZER_LOG:
+			case VX_DIRECTIVE_AMD_DISABLE_OPTIMIZER_LOG:
+				if (reference->type == VX_TYPE_GRAPH) {
+					((AgoGraph *)reference)->enable_optimizer_log =
+						(directive == VX_DIRECTIVE_AMD_ENABLE_OPTIMIZER_LOG) ? true : false;
+				}
+				else {
+					status = VX_ERROR_NOT_SUPPORTED;
+				}
+				break;
 			case VX_DIRECTIVE_AMD_ENABLE_PROFILE_CAPTURE:
 			case VX_DIRECTIVE_AMD_DISABLE_PROFILE_CAPTURE:
 				if (reference->type == VX_TYPE_GRAPH) {
@@ -2387,6 +2892,79 @@ vx_status agoGraphDumpPerformanceProfile(AgoGraph * graph, const char * fileName
 	return VX_SUCCESS;
 }
 
+static std::string agoOptimizerLogJsonString(const std::string& text)
+{
+	std::string str = "\"";
+	for (char c : text) {
+		if (c == '"' || c == '\\') {
+			str += '\\';
+			str += c;
+		}
+		else if ((unsigned char)c < ' ') {
+			char code[8];
+			sprintf(code, "\\u%04x", c);
+			str += code;
+		}
+		else
+			str += c;
+	}
+	return str + "\"";
+}
+
+vx_status agoGraphDumpOptimizerLog(AgoGraph * graph, const char * fileName, bool json)
+{
+	bool use_stdout = true;
+	FILE * fp = stdout;
+	if (fileName && strcmp(fileName, "stdout") != 0) {
+		use_stdout = false;
+		fp = fopen(fileName, "w");
+		if (!fp) {
+			agoAddLogEntry(NULL, VX_FAILURE, "ERROR: unable to create: %s\n", fileName);
+			return VX_FAILURE;
+		}
+	}
+	float factor = 1000.0f / (float)agoGetClockFrequency(); // to convert clock counter to ms
+	if (json) {
+		// { "passes": [ { "pass": ..., "msec": ... } ... ], "decisions": [ { "pass": ..., "action": ..., "detail": ... } ... ] }
+		const char * separator = "";
+		fprintf(fp, "{\n  \"passes\": [");
+		for (auto& entry : graph->optimizer_log) {
+			if (entry.action == "time") {
+				fprintf(fp, "%s\n    { \"pass\": %s, \"msec\": %.3f }", separator, agoOptimizerLogJsonString(entry.pass).c_str(), (float)entry.time * factor);
+				separator = ",";
+			}
+		}
+		separator = "";
+		fprintf(fp, "\n  ],\n  \"decisions\": [");
+		for (auto& entry : graph->optimizer_log) {
+			if (entry.action != "time") {
+				fprintf(fp, "%s\n    { \"pass\": %s, \"action\": %s, \"detail\": %s }", separator, agoOptimizerLogJsonString(entry.pass).c_str(),
+					agoOptimizerLogJsonString(entry.action).c_str(), agoOptimizerLogJsonString(entry.detail).c_str());
+				separator = ",";
+			}
+		}
+		fprintf(fp, "\n  ]\n}\n");
+	}
+	else {
+		fprintf(fp, "***OPTIMIZER-LOG***\n");
+		fprintf(fp, " pass      ,time(ms)\n");
+		for (auto& entry : graph->optimizer_log) {
+			if (entry.action == "time")
+				fprintf(fp, " %-10s,%8.3f\n", entry.pass.c_str(), (float)entry.time * factor);
+		}
+		fprintf(fp, " pass      ,action    ,detail\n");
+		for (auto& entry : graph->optimizer_log) {
+			if (entry.action != "time")
+				fprintf(fp, " %-10s,%-10s,%s\n", entry.pass.c_str(), entry.action.c_str(), entry.detail.c_str());
+		}
+	}
+	fflush(fp);
+	if (!use_stdout) {
+		fclose(fp);
+	}
+	return VX_SUCCESS;
+}
+
 int agoProcessGraph(AgoGraph * graph)
 {
 	vx_status status = VX_ERROR_INVALID_REFERENCE;
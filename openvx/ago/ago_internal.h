@@ -96,6 +96,11 @@ THE SOFTWARE.
 #define AGO_KERNEL_OP_TYPE_ELEMENT_WISE       1 // element wise operation
 #define AGO_KERNEL_OP_TYPE_FIXED_NEIGHBORS    2 // filtering operation with fixed neighborhood
 
+// AGO drama analyze op classes
+#define AGO_DRAMA_OP_CLASS_UNKNOWN            0 // node can't be fused with its neighbors
+#define AGO_DRAMA_OP_CLASS_ELEMENT_WISE       1 // element wise operation
+#define AGO_DRAMA_OP_CLASS_FIXED_NEIGHBORS    2 // filtering operation with fixed neighborhood
+
 // AGO magic code
 #define AGO_MAGIC_VALID              0xC001C0DE // magic code: reference is valid
 #define AGO_MAGIC_INVALID            0xC0FFC0DE // magic code: reference is invalid
@@ -103,7 +108,17 @@ THE SOFTWARE.
 // AGO limites
 #define AGO_MAX_CONVOLUTION_DIM               9 // maximum size of convolution matrix
 #define AGO_OPTICALFLOWPYRLK_MAX_DIM         15 // maximum size of opticalflow block size
+#define AGO_OPTICALFLOWPYRLK_MIN_KEYPOINTS_PER_BAND 64 // minimum keypoints per band for multi-threaded opticalflow
+#define AGO_HARRIS_MIN_KEYPOINTS_PER_BAND  4096 // minimum corner candidates per band for multi-threaded harris merge
+#define AGO_FASTCORNERS_MIN_ROWS_PER_BAND    16 // minimum image rows per band for multi-threaded fast corners
+#define AGO_HISTOGRAM_MIN_PIXELS_PER_BAND 65536 // minimum pixels per band for multi-threaded histogram
+#define AGO_INTEGRALIMAGE_MIN_PIXELS_PER_BAND 65536 // minimum pixels per band for multi-threaded integral image
+#define AGO_STATISTICS_MIN_PIXELS_PER_BAND 65536 // minimum pixels per band for multi-threaded mean/stddev and min/max
+#define AGO_WARP_MIN_ROWS_PER_BAND           16 // minimum destination rows per band for multi-threaded warp affine/perspective
+#define AGO_ELEMWISE_FUSION_STRIP_SIZE    32768 // bytes per image in each row strip of fused element-wise nodes
+#define AGO_HARRIS_MAX_MERGE_BANDS           64 // maximum number of bands merged by harris corner pick
 #define AGO_MAX_TENSOR_DIMENSIONS             4 // maximum dimensions supported by tensor
+#define AGO_MAX_CPU_THREADS                  64 // maximum number of threads in CPU thread pool
 
 // AGO remap data precision
 #define AGO_REMAP_FRACTIONAL_BITS             3 // number of fractional bits in re-map locations
@@ -123,6 +138,14 @@ THE SOFTWARE.
 #define AGO_GRAPH_OPTIMIZER_FLAG_NO_NODE_MERGE            0x00000008 // don't perform node merge
 #define AGO_GRAPH_OPTIMIZER_FLAG_NO_CONVERT_8BIT_TO_1BIT  0x00000010 // don't convert 8-bit images to 1-bit images
 #define AGO_GRAPH_OPTIMIZER_FLAG_NO_SUPERNODE_MERGE       0x00000020 // don't merge supernodes
+#define AGO_GRAPH_OPTIMIZER_FLAG_SPLIT_OPTICAL_FLOW      0x00000040 // track optical flow with a node per pyramid level
+#define AGO_GRAPH_OPTIMIZER_FLAG_NO_ELEMWISE_FUSION       0x00000080 // don't fuse element-wise CPU nodes
+#define AGO_GRAPH_OPTIMIZER_FLAG_NO_REMOVE_DUPLICATE_NODES 0x00000100 // don't remove nodes that repeat computation of other nodes
+#define AGO_GRAPH_OPTIMIZER_FLAG_NO_CONSTANT_FOLDING      0x00000200 // don't pre-compute nodes whose inputs never change
+#define AGO_GRAPH_OPTIMIZER_FLAG_NO_REQUIRED_REGIONS      0x00000400 // don't limit node execution to regions read by consumers
+#define AGO_GRAPH_OPTIMIZER_FLAG_NO_TARGET_COST_MODEL     0x00000800 // don't use cost model to pick CPU or GPU for nodes
+#define AGO_GRAPH_OPTIMIZER_FLAG_NO_GRAPH_CACHE           0x00001000 // don't use optimized graph cache in AGO_GRAPH_CACHE_DIR
+#define AGO_GRAPH_OPTIMIZER_FLAG_AUTO_TUNE                0x00002000 // time kernel variants of CPU nodes and pick the fastest
 #define AGO_GRAPH_OPTIMIZER_FLAGS_DEFAULT                 0x00000000 // default options
 
 #if ENABLE_OPENCL
@@ -216,6 +239,12 @@ struct AgoProfileEntry {
 	vx_reference        ref;
 	int64_t             time;
 };
+struct AgoOptimizerLogEntry {
+	std::string         pass;   // optimizer step, such as divide, remove, fold, merge, alloc
+	std::string         action; // "time" for duration of the step, otherwise the decision made by the step
+	std::string         detail; // objects involved in the decision
+	int64_t             time;   // clock counter ticks spent in the step, for "time" entries
+};
 struct AgoNode;
 struct AgoContext;
 struct AgoData;
@@ -410,6 +439,7 @@ struct AgoData {
 	vx_bool isDelayed;
 	vx_bool isNotFullyConfigured;
 	vx_bool isInitialized;
+	vx_bool isValueUsedByOptimizer; // scalar value picked kernels or merged nodes, so it can't change after verification
 	vx_int32 siblingIndex;
 	vx_uint32 numChildren;
 	AgoData ** children;
@@ -542,6 +572,13 @@ struct AgoNode {
 	vx_int32 funcExchange[AGO_MAX_PARAMS];
 	vx_nodecomplete_f callback;
 	AgoSuperNode * supernode;
+	std::vector<AgoNode *> fusedNodeList; // element-wise nodes fused into this node (kept in graph node trash)
+	std::vector<AgoData *> fusedViewList; // row strip views of images used by fusedNodeList nodes
+	vx_rectangle_t rect_exec;             // region of images computed by the node, when rect_exec_partial is set
+	bool rect_exec_partial;               // consumers of the node outputs only read a part of them
+	std::vector<AgoData *> regionViewList; // views of images used to execute the node on rect_exec
+	vx_uint32 cpu_thread_limit;           // max threads for band-parallel CPU kernels (0: no limit), picked by auto-tune
+	vx_uint32 strip_size;                 // bytes per image in row strips of fused nodes (0: default), picked by auto-tune
 	bool initialized;
 	bool drama_divide_invoked;
 	vx_uint32 valid_rect_num_inputs;
@@ -595,6 +632,19 @@ struct AgoNodeList {
 	AgoNode * tail;
 	AgoNode * trash;
 };
+struct AgoDramaDataInfo {
+	AgoNode * def;                // node that writes the data (nullptr when written outside the graph)
+	std::vector<AgoNode *> use;   // nodes that read the data
+};
+struct AgoDramaNodeInfo {
+	vx_uint32 op_class;           // AGO_DRAMA_OP_CLASS_*
+	vx_uint32 neighbors;          // neighborhood size for AGO_DRAMA_OP_CLASS_FIXED_NEIGHBORS
+	bool cpu_target;              // node is expected to run on CPU, from affinity and default target only (see agoOptimizeDramaAnalyze)
+};
+struct AgoDramaAnalysis {
+	std::map<AgoData *, AgoDramaDataInfo> data;
+	std::map<AgoNode *, AgoDramaNodeInfo> node;
+};
 struct AgoGraph {
 	AgoReference ref;
 	AgoGraph * next;
@@ -616,9 +666,12 @@ struct AgoGraph {
 	AgoGraphPerfInternalInfo_ opencl_perf, opencl_perf_total;
 	vx_uint32 virtualDataGenerationCount;
 	vx_uint32 optimizer_flags;
+	AgoDramaAnalysis drama_analysis;
 	bool verified;
 	std::vector<vx_parameter> parameters;
 	std::vector<AgoData *> autoAgeDelayList;
+	std::map<AgoData *, vx_uint32> userParamRefCount; // number of node parameters using non-virtual data, before optimization
+	bool userParamRefCountValid;
 #if ENABLE_OPENCL
 	std::vector<AgoNode *> opencl_nodeListQueued;
 	AgoSuperNode * supernodeList;
@@ -630,6 +683,8 @@ struct AgoGraph {
 	vx_uint32 execFrameCount;
 	bool enable_performance_profiling;
 	std::vector<AgoProfileEntry> performance_profile;
+	bool enable_optimizer_log;
+	std::vector<AgoOptimizerLogEntry> optimizer_log;
 	std::map<std::string,void *> moduleHandle;
 public:
 	AgoGraph();
@@ -656,6 +711,23 @@ struct MacroData {
 	char * text;
 	char * text_allocated;
 };
+struct AgoTargetCost {
+	float cpu; // nsec per pixel on CPU
+	float gpu; // nsec per pixel on GPU
+};
+struct AgoTargetCostModel {
+	bool calibrated;               // throughput values below are measured or loaded from file
+	float cpu_nsec_per_byte;       // CPU memory throughput
+	float gpu_nsec_per_byte;       // GPU memory throughput
+	float transfer_nsec_per_byte;  // data sync throughput between CPU and GPU
+	float transfer_nsec_latency;   // overhead of each data sync between CPU and GPU
+	std::map<std::string, AgoTargetCost> kernel_cost; // per-kernel costs that override estimates from throughput
+};
+struct AgoDramaCacheEntry {
+	std::string fileName;          // cache file of the graph: empty if the graph can't be cached
+	std::string key;               // description of the graph before optimization
+	std::vector<AgoData *> refList; // objects of the graph before optimization, referenced as $1..$N in cache file
+};
 struct AgoContext {
 	AgoReference ref;
 	vx_uint64 perfNormFactor;
@@ -683,6 +755,7 @@ struct AgoContext {
 	AgoData * graph_garbage_data;
 	AgoNode * graph_garbage_node;
 	AgoGraph * graph_garbage_list;
+	AgoTargetCostModel target_cost_model;
 #if ENABLE_OPENCL
 	bool opencl_context_imported;
 	cl_context   opencl_context;
@@ -741,6 +814,7 @@ void agoAddGraph(AgoGraphList * graphList, AgoGraph * graph);
 vx_enum agoAddUserStruct(AgoContext * acontext, vx_size size, vx_char * name);
 AgoGraph * agoRemoveGraph(AgoGraphList * list, AgoGraph * item);
 int agoRemoveNode(AgoNodeList * nodeList, AgoNode * node, bool moveToTrash);
+int agoRemoveNodes(AgoNodeList * nodeList, std::map<AgoNode *, bool>& nodes, bool moveToTrash);
 int agoShutdownNode(AgoNode * node);
 int agoRemoveData(AgoDataList * list, AgoData * item, AgoData ** trash);
 AgoKernel * agoRemoveKernel(AgoKernelList * list, AgoKernel * item);
@@ -773,6 +847,7 @@ int agoGetImageComponentsAndPlanes(AgoContext * acontext, vx_df_image format, vx
 int agoGetImagePlaneFormat(AgoContext * acontext, vx_df_image format, vx_uint32 width, vx_uint32 height, vx_uint32 plane, vx_df_image *pFormat, vx_uint32 * pWidth, vx_uint32 * pHeight);
 void agoGetDataName(vx_char * name, AgoData * data);
 int agoAllocData(AgoData * data);
+bool agoGetConvolutionSeparableFactors(AgoData * data, vx_int16 * hCoeff, vx_int16 * vCoeff);
 void agoRetainData(AgoGraph * graph, AgoData * data, bool isForExternalUse);
 int agoReleaseData(AgoData * data, bool isForExternalUse);
 int agoReleaseKernel(AgoKernel * kernel, bool isForExternalUse);
@@ -780,6 +855,8 @@ AgoNode * agoCreateNode(AgoGraph * graph, AgoKernel * kernel);
 AgoNode * agoCreateNode(AgoGraph * graph, vx_enum kernel_id);
 int agoReleaseNode(AgoNode * node);
 vx_status agoVerifyNode(AgoNode * node);
+vx_status agoInitializeNode(AgoNode * node);
+vx_status agoRebindDataInGraph(AgoGraph * graph, AgoData * dataFind, AgoData * dataReplace);
 // sanity checks
 int agoDataSanityCheckAndUpdate(AgoData * data);
 bool agoIsValidReference(AgoReference * ref);
@@ -794,14 +871,19 @@ int agoPublishKernels(AgoContext * acontext);
 // drama
 int agoOptimizeDrama(AgoGraph * agraph);
 void agoOptimizeDramaMarkDataUsage(AgoGraph * agraph);
+bool agoOptimizeDramaGetDefaultTarget(vx_uint32& default_target);
 int agoOptimizeDramaComputeGraphHierarchy(AgoGraph * graph);
 void agoOptimizeDramaSortGraphHierarchy(AgoGraph * graph);
 int agoOptimizeDramaCheckArgs(AgoGraph * agraph);
 int agoOptimizeDramaDivide(AgoGraph * agraph);
 int agoOptimizeDramaRemove(AgoGraph * agraph);
+int agoOptimizeDramaFold(AgoGraph * agraph);
 int agoOptimizeDramaAnalyze(AgoGraph * agraph);
 int agoOptimizeDramaMerge(AgoGraph * agraph);
 int agoOptimizeDramaAlloc(AgoGraph * agraph);
+int agoOptimizeDramaAllocPlaceTargets(AgoGraph * agraph, std::map<AgoNode *, vx_uint32>& nodeTarget);
+int agoOptimizeDramaCacheLookup(AgoGraph * agraph, AgoDramaCacheEntry& entry);
+void agoOptimizeDramaCacheSave(AgoGraph * agraph, AgoDramaCacheEntry& entry);
 // import
 void agoImportKernelConfig(AgoKernel * kernel, vx_kernel vxkernel);
 void agoImportNodeConfig(AgoNode * node, vx_node vxnode);
@@ -814,6 +896,13 @@ void agoPerfCaptureReset(vx_perf_t * perf);
 void agoPerfCaptureStart(vx_perf_t * perf);
 void agoPerfCaptureStop(vx_perf_t * perf);
 void agoPerfCopyNormalize(AgoContext * context, vx_perf_t * perfDst, vx_perf_t * perfSrc);
+// optimizer log
+void agoOptimizerLogEntry(AgoGraph * graph, const char * pass, const char * action, const char * detail, ...);
+void agoOptimizerLogTime(AgoGraph * graph, const char * pass, int64_t& clockCounter);
+std::string agoGetNodeLogName(AgoNode * node);
+// target cost model
+int agoLoadTargetCostModel(AgoContext * context, const char * fileName);
+void agoCalibrateTargetCostModel(AgoContext * context);
 // log
 void agoRegisterLogCallback(vx_context context, vx_log_callback_f callback, vx_bool reentrant);
 void agoAddLogEntry(AgoReference * ref, vx_status status, const char *message, ...);
@@ -825,6 +914,7 @@ int agoGpuOclReleaseGraph(AgoGraph * graph);
 int agoGpuOclReleaseSuperNode(AgoSuperNode * supernode);
 int agoGpuOclReleaseData(AgoData * data);
 int agoGpuOclCreateContext(AgoContext * context, cl_context opencl_context);
+int agoGpuOclCalibrateTargetCostModel(AgoContext * context);
 int agoGpuOclAllocBuffer(AgoData * data);
 int agoGpuOclAllocBuffers(AgoGraph * graph);
 int agoGpuOclSuperNodeMerge(AgoGraph * graph, AgoSuperNode * supernode, AgoNode * node);
@@ -850,6 +940,7 @@ vx_status agoPrepareImageValidRectangleBuffers(AgoGraph * graph);
 vx_status agoComputeImageValidRectangleOutputs(AgoGraph * graph);
 int agoOptimizeGraph(AgoGraph * agraph);
 int agoInitializeGraph(AgoGraph * agraph);
+int agoTuneGraph(AgoGraph * agraph);
 int agoShutdownGraph(AgoGraph * graph);
 int agoExecuteGraph(AgoGraph * agraph);
 int agoAgeDelay(AgoData * delay);
@@ -863,6 +954,7 @@ int agoReadGraphFromString(AgoGraph * agraph, AgoReference * * ref, int num_ref,
 int agoLoadModule(AgoContext * context, const char * module);
 int agoUnloadModule(AgoContext * context, const char * module);
 vx_status agoGraphDumpPerformanceProfile(AgoGraph * graph, const char * fileName);
+vx_status agoGraphDumpOptimizerLog(AgoGraph * graph, const char * fileName, bool json);
 vx_status agoDirective(vx_reference reference, vx_enum directive);
 
 ///////////////////////////////////////////////////////////
@@ -10063,7 +10063,14 @@ int agoKernel_Mul_U24_U24U8_Sat_Round(AgoNode * node, AgoKernelCommand cmd)
 {
 	vx_status status = AGO_ERROR_KERNEL_NOT_IMPLEMENTED;
 	if (cmd == ago_kernel_cmd_execute) {
-		// not implemented yet
+		status = VX_SUCCESS;
+		AgoData * oImg = node->paramList[0];
+		AgoData * iImg0 = node->paramList[1];
+		AgoData * iImg1 = node->paramList[2];
+		vx_float32 scale = node->paramList[3]->u.scalar.u.f;
+		if (HafCpu_Mul_U24_U24U8_Sat_Round(oImg->u.img.width, oImg->u.img.height, oImg->buffer, oImg->u.img.stride_in_bytes, iImg0->buffer, iImg0->u.img.stride_in_bytes, iImg1->buffer, iImg1->u.img.stride_in_bytes, scale)) {
+			status = VX_FAILURE;
+		}
 	}
 	else if (cmd == ago_kernel_cmd_validate) {
 		status = ValidateArguments_Img_1OUT_2IN_S(node, VX_DF_IMAGE_RGB, VX_DF_IMAGE_RGB, VX_DF_IMAGE_U8, VX_TYPE_FLOAT32);
@@ -10127,6 +10134,7 @@ int agoKernel_Mul_U24_U24U8_Sat_Round(AgoNode * node, AgoKernelCommand cmd)
 #endif
 	else if (cmd == ago_kernel_cmd_query_target_support) {
 		node->target_support_flags = 0
+			| AGO_KERNEL_FLAG_DEVICE_CPU
 #if ENABLE_OPENCL
 			| AGO_KERNEL_FLAG_DEVICE_GPU | AGO_KERNEL_FLAG_GPU_INTEG_R2R
 #endif			
@@ -10149,7 +10157,14 @@ int agoKernel_Mul_U32_U32U8_Sat_Round(AgoNode * node, AgoKernelCommand cmd)
 {
 	vx_status status = AGO_ERROR_KERNEL_NOT_IMPLEMENTED;
 	if (cmd == ago_kernel_cmd_execute) {
-		// not implemented yet
+		status = VX_SUCCESS;
+		AgoData * oImg = node->paramList[0];
+		AgoData * iImg0 = node->paramList[1];
+		AgoData * iImg1 = node->paramList[2];
+		vx_float32 scale = node->paramList[3]->u.scalar.u.f;
+		if (HafCpu_Mul_U32_U32U8_Sat_Round(oImg->u.img.width, oImg->u.img.height, oImg->buffer, oImg->u.img.stride_in_bytes, iImg0->buffer, iImg0->u.img.stride_in_bytes, iImg1->buffer, iImg1->u.img.stride_in_bytes, scale)) {
+			status = VX_FAILURE;
+		}
 	}
 	else if (cmd == ago_kernel_cmd_validate) {
 		status = ValidateArguments_Img_1OUT_2IN_S(node, VX_DF_IMAGE_RGBX, VX_DF_IMAGE_RGBX, VX_DF_IMAGE_U8, VX_TYPE_FLOAT32);
@@ -10223,6 +10238,7 @@ int agoKernel_Mul_U32_U32U8_Sat_Round(AgoNode * node, AgoKernelCommand cmd)
 #endif
 	else if (cmd == ago_kernel_cmd_query_target_support) {
 		node->target_support_flags = 0
+			| AGO_KERNEL_FLAG_DEVICE_CPU
 #if ENABLE_OPENCL		
 			| AGO_KERNEL_FLAG_DEVICE_GPU | AGO_KERNEL_FLAG_GPU_INTEG_R2R
 #endif			
@@ -13131,6 +13147,8 @@ int agoKernel_Convolve_U8_U8(AgoNode * node, AgoKernelCommand cmd)
 			return VX_ERROR_INVALID_DIMENSION;
 		else if (!(node->paramList[2]->u.conv.rows & 1) || !(node->paramList[2]->u.conv.columns & 1))
 			return VX_ERROR_INVALID_DIMENSION;
+		else if (node->paramList[2]->u.conv.rows > AGO_MAX_CONVOLUTION_DIM || node->paramList[2]->u.conv.columns > AGO_MAX_CONVOLUTION_DIM)
+			return VX_ERROR_INVALID_DIMENSION;
 		// set output image sizes and format
 		vx_meta_format meta;
 		meta = &node->metaList[0];
@@ -13219,6 +13237,8 @@ int agoKernel_Convolve_S16_U8(AgoNode * node, AgoKernelCommand cmd)
 			return VX_ERROR_INVALID_DIMENSION;
 		else if (!(node->paramList[2]->u.conv.rows & 1) || !(node->paramList[2]->u.conv.columns & 1))
 			return VX_ERROR_INVALID_DIMENSION;
+		else if (node->paramList[2]->u.conv.rows > AGO_MAX_CONVOLUTION_DIM || node->paramList[2]->u.conv.columns > AGO_MAX_CONVOLUTION_DIM)
+			return VX_ERROR_INVALID_DIMENSION;
 		// set output image sizes and format
 		vx_meta_format meta;
 		meta = &node->metaList[0];
@@ -13259,18 +13279,86 @@ int agoKernel_Convolve_S16_U8(AgoNode * node, AgoKernelCommand cmd)
 	return status;
 }
 
-int agoKernel_LinearFilter_ANY_ANY(AgoNode * node, AgoKernelCommand cmd)
+int agoKernel_Convolve_U8_U8_Separable(AgoNode * node, AgoKernelCommand cmd)
 {
 	vx_status status = AGO_ERROR_KERNEL_NOT_IMPLEMENTED;
 	if (cmd == ago_kernel_cmd_execute) {
-		if (node->paramList[0]->u.img.format == VX_DF_IMAGE_U8 && node->paramList[1]->u.img.format == VX_DF_IMAGE_U8) {
+		AgoData * oImg = node->paramList[0];
+		AgoData * iImg = node->paramList[1];
+		AgoData * iConv = node->paramList[2];
+		vx_uint32 convolutionWidth = (vx_uint32)iConv->u.conv.columns;
+		vx_uint32 convolutionHeight = (vx_uint32)iConv->u.conv.rows;
+		vx_int16 hCoeff[AGO_MAX_CONVOLUTION_DIM], vCoeff[AGO_MAX_CONVOLUTION_DIM];
+		// coefficients may have been modified after verify: fall back to 2D convolution if no longer separable
+		if (!agoGetConvolutionSeparableFactors(iConv, hCoeff, vCoeff)) {
 			status = agoKernel_Convolve_U8_U8(node, cmd);
 		}
-		else if (node->paramList[0]->u.img.format == VX_DF_IMAGE_S16 && node->paramList[1]->u.img.format == VX_DF_IMAGE_U8) {
+		else {
+			status = HafCpu_ConvolveSeparable_U8_U8(oImg->u.img.width, oImg->u.img.height - convolutionHeight + 1,
+				oImg->buffer + oImg->u.img.stride_in_bytes * (convolutionHeight >> 1), oImg->u.img.stride_in_bytes,
+				iImg->buffer + iImg->u.img.stride_in_bytes * (convolutionHeight >> 1), iImg->u.img.stride_in_bytes,
+				hCoeff, vCoeff, convolutionWidth, convolutionHeight, iConv->u.conv.shift, node->localDataPtr);
+		}
+	}
+	else if (cmd == ago_kernel_cmd_initialize) {
+		// row buffer for the horizontal pass: convolutionHeight rows of 32-bit intermediate results
+		vx_uint32 alignedWidth = (node->paramList[0]->u.img.width + 15) & ~15;
+		node->localDataSize = (vx_uint32)node->paramList[2]->u.conv.rows * alignedWidth * sizeof(vx_int32) + 16;
+		status = VX_SUCCESS;
+	}
+	else {
+		status = agoKernel_Convolve_U8_U8(node, cmd);
+	}
+	return status;
+}
+
+int agoKernel_Convolve_S16_U8_Separable(AgoNode * node, AgoKernelCommand cmd)
+{
+	vx_status status = AGO_ERROR_KERNEL_NOT_IMPLEMENTED;
+	if (cmd == ago_kernel_cmd_execute) {
+		AgoData * oImg = node->paramList[0];
+		AgoData * iImg = node->paramList[1];
+		AgoData * iConv = node->paramList[2];
+		vx_uint32 convolutionWidth = (vx_uint32)iConv->u.conv.columns;
+		vx_uint32 convolutionHeight = (vx_uint32)iConv->u.conv.rows;
+		vx_int16 hCoeff[AGO_MAX_CONVOLUTION_DIM], vCoeff[AGO_MAX_CONVOLUTION_DIM];
+		// coefficients may have been modified after verify: fall back to 2D convolution if no longer separable
+		if (!agoGetConvolutionSeparableFactors(iConv, hCoeff, vCoeff)) {
 			status = agoKernel_Convolve_S16_U8(node, cmd);
 		}
 		else {
-			// TBD: not implemented yet
+			status = HafCpu_ConvolveSeparable_S16_U8(oImg->u.img.width, oImg->u.img.height - convolutionHeight + 1,
+				(vx_int16 *)(oImg->buffer + oImg->u.img.stride_in_bytes * (convolutionHeight >> 1)), oImg->u.img.stride_in_bytes,
+				iImg->buffer + iImg->u.img.stride_in_bytes * (convolutionHeight >> 1), iImg->u.img.stride_in_bytes,
+				hCoeff, vCoeff, convolutionWidth, convolutionHeight, iConv->u.conv.shift, node->localDataPtr);
+		}
+	}
+	else if (cmd == ago_kernel_cmd_initialize) {
+		// row buffer for the horizontal pass: convolutionHeight rows of 32-bit intermediate results
+		vx_uint32 alignedWidth = (node->paramList[0]->u.img.width + 15) & ~15;
+		node->localDataSize = (vx_uint32)node->paramList[2]->u.conv.rows * alignedWidth * sizeof(vx_int32) + 16;
+		status = VX_SUCCESS;
+	}
+	else {
+		status = agoKernel_Convolve_S16_U8(node, cmd);
+	}
+	return status;
+}
+
+int agoKernel_LinearFilter_ANY_ANY(AgoNode * node, AgoKernelCommand cmd)
+{
+	vx_status status = AGO_ERROR_KERNEL_NOT_IMPLEMENTED;
+	if (cmd == ago_kernel_cmd_execute) {
+		status = VX_SUCCESS;
+		AgoData * oImg = node->paramList[0];
+		AgoData * iImg = node->paramList[1];
+		AgoData * iMat = node->paramList[2];
+		vx_uint32 filterWidth = (vx_uint32)iMat->u.mat.columns;
+		vx_uint32 filterHeight = (vx_uint32)iMat->u.mat.rows;
+		if (HafCpu_LinearFilter_ANY_ANY(oImg->u.img.width, oImg->u.img.height - filterHeight + 1, oImg->u.img.format,
+			oImg->buffer + oImg->u.img.stride_in_bytes * (filterHeight >> 1), oImg->u.img.stride_in_bytes, iImg->u.img.format,
+			iImg->buffer + iImg->u.img.stride_in_bytes * (filterHeight >> 1), iImg->u.img.stride_in_bytes, (vx_float32 *)iMat->buffer, filterWidth, filterHeight)) {
+			status = VX_FAILURE;
 		}
 	}
 	else if (cmd == ago_kernel_cmd_validate) {
@@ -13348,7 +13436,21 @@ int agoKernel_LinearFilter_ANYx2_ANY(AgoNode * node, AgoKernelCommand cmd)
 {
 	vx_status status = AGO_ERROR_KERNEL_NOT_IMPLEMENTED;
 	if (cmd == ago_kernel_cmd_execute) {
-		// TBD: not implemented yet
+		status = VX_SUCCESS;
+		AgoData * oImg1 = node->paramList[0];
+		AgoData * oImg2 = node->paramList[1];
+		AgoData * iImg = node->paramList[2];
+		AgoData * iMat1 = node->paramList[3];
+		AgoData * iMat2 = node->paramList[4];
+		vx_uint32 filterWidth = (vx_uint32)iMat1->u.mat.columns;
+		vx_uint32 filterHeight = (vx_uint32)iMat1->u.mat.rows;
+		if (HafCpu_LinearFilter_ANYx2_ANY(oImg1->u.img.width, oImg1->u.img.height - filterHeight + 1, oImg1->u.img.format,
+			oImg1->buffer + oImg1->u.img.stride_in_bytes * (filterHeight >> 1), oImg1->u.img.stride_in_bytes,
+			oImg2->buffer + oImg2->u.img.stride_in_bytes * (filterHeight >> 1), oImg2->u.img.stride_in_bytes, iImg->u.img.format,
+			iImg->buffer + iImg->u.img.stride_in_bytes * (filterHeight >> 1), iImg->u.img.stride_in_bytes,
+			(vx_float32 *)iMat1->buffer, (vx_float32 *)iMat2->buffer, filterWidth, filterHeight)) {
+			status = VX_FAILURE;
+		}
 	}
 	else if (cmd == ago_kernel_cmd_validate) {
 		// validate parameters
@@ -13398,6 +13500,7 @@ int agoKernel_LinearFilter_ANYx2_ANY(AgoNode * node, AgoKernelCommand cmd)
 #endif
     else if (cmd == ago_kernel_cmd_query_target_support) {
         node->target_support_flags = 0
+                    | AGO_KERNEL_FLAG_DEVICE_CPU
 #if ENABLE_OPENCL        
                     | AGO_KERNEL_FLAG_DEVICE_GPU | AGO_KERNEL_FLAG_GPU_INTEG_M2R
 #endif                 
@@ -14016,8 +14119,13 @@ int agoKernel_FastCorners_XY_U8_Supression(AgoNode * node, AgoKernelCommand cmd)
 		AgoData * iImg = node->paramList[2];
 		vx_float32 strength_threshold = node->paramList[3]->u.scalar.u.f;
 		vx_uint32 numXY = 0;
-		if (HafCpu_FastCorners_XY_U8_Supression((vx_uint32)oXY->u.arr.capacity, (vx_keypoint_t *)oXY->buffer, &numXY, 
-			iImg->u.img.width, iImg->u.img.height, iImg->buffer, iImg->u.img.stride_in_bytes, strength_threshold, node->localDataPtr)) {
+		vx_uint32 bandCount = min(HafCpu_GetThreadCount(), (iImg->u.img.height > 6 ? iImg->u.img.height - 6 : 0) / AGO_FASTCORNERS_MIN_ROWS_PER_BAND);
+		int err = (bandCount > 1) ?
+			HafCpu_FastCorners_XY_U8_Supression_Parallel((vx_uint32)oXY->u.arr.capacity, (vx_keypoint_t *)oXY->buffer, &numXY,
+				iImg->u.img.width, iImg->u.img.height, iImg->buffer, iImg->u.img.stride_in_bytes, strength_threshold, node->localDataPtr, bandCount) :
+			HafCpu_FastCorners_XY_U8_Supression((vx_uint32)oXY->u.arr.capacity, (vx_keypoint_t *)oXY->buffer, &numXY, 
+				iImg->u.img.width, iImg->u.img.height, iImg->buffer, iImg->u.img.stride_in_bytes, strength_threshold, node->localDataPtr);
+		if (err) {
 			status = VX_FAILURE;
 		}
 		else {
@@ -14077,8 +14185,14 @@ int agoKernel_FastCorners_XY_U8_NoSupression(AgoNode * node, AgoKernelCommand cm
 		AgoData * iImg = node->paramList[2];
 		vx_float32 strength_threshold = node->paramList[3]->u.scalar.u.f;
 		vx_uint32 numXY = 0;
-		if (HafCpu_FastCorners_XY_U8_NoSupression((vx_uint32)oXY->u.arr.capacity, (vx_keypoint_t *)oXY->buffer, &numXY,
-			iImg->u.img.width, iImg->u.img.height, iImg->buffer, iImg->u.img.stride_in_bytes, strength_threshold)) {
+		// detect in parallel bands only with the corner map scratch allocated at initialize
+		vx_uint32 bandCount = min(HafCpu_GetThreadCount(), (iImg->u.img.height > 6 ? iImg->u.img.height - 6 : 0) / AGO_FASTCORNERS_MIN_ROWS_PER_BAND);
+		int err = (bandCount > 1 && node->localDataPtr) ?
+			HafCpu_FastCorners_XY_U8_NoSupression_Parallel((vx_uint32)oXY->u.arr.capacity, (vx_keypoint_t *)oXY->buffer, &numXY,
+				iImg->u.img.width, iImg->u.img.height, iImg->buffer, iImg->u.img.stride_in_bytes, strength_threshold, node->localDataPtr, bandCount) :
+			HafCpu_FastCorners_XY_U8_NoSupression((vx_uint32)oXY->u.arr.capacity, (vx_keypoint_t *)oXY->buffer, &numXY,
+				iImg->u.img.width, iImg->u.img.height, iImg->buffer, iImg->u.img.stride_in_bytes, strength_threshold);
+		if (err) {
 			status = VX_FAILURE;
 		}
 		else {
@@ -14104,7 +14218,14 @@ int agoKernel_FastCorners_XY_U8_NoSupression(AgoNode * node, AgoKernelCommand cm
 		meta->data.u.scalar.type = VX_TYPE_SIZE;
 		status = VX_SUCCESS;
 	}
-	else if (cmd == ago_kernel_cmd_initialize || cmd == ago_kernel_cmd_shutdown) {
+	else if (cmd == ago_kernel_cmd_initialize) {
+		// corner map for multi-threaded detection
+		if (HafCpu_GetThreadCount() > 1) {
+			node->localDataSize = node->paramList[2]->u.img.width * node->paramList[2]->u.img.height;
+		}
+		status = VX_SUCCESS;
+	}
+	else if (cmd == ago_kernel_cmd_shutdown) {
 		status = VX_SUCCESS;
 	}
 #if ENABLE_OPENCL
@@ -15103,7 +15224,16 @@ int agoKernel_CannySuppThreshold_U8_U16_3x3(AgoNode * node, AgoKernelCommand cmd
 {
 	vx_status status = AGO_ERROR_KERNEL_NOT_IMPLEMENTED;
 	if (cmd == ago_kernel_cmd_execute) {
-		// TBD: not implemented yet
+		status = VX_SUCCESS;
+		AgoData * oImg = node->paramList[0];
+		AgoData * iImg = node->paramList[1];
+		AgoData * iThr = node->paramList[2];
+		if (HafCpu_CannySuppThreshold_U8_U16_3x3(oImg->u.img.width, oImg->u.img.height, oImg->buffer, oImg->u.img.stride_in_bytes,
+			(vx_uint16 *)iImg->buffer, iImg->u.img.stride_in_bytes,
+			iThr->u.thr.threshold_lower, iThr->u.thr.threshold_upper))
+		{
+			status = VX_FAILURE;
+		}
 	}
 	else if (cmd == ago_kernel_cmd_validate) {
 		status = ValidateArguments_CannySuppThreshold_U8(node, VX_DF_IMAGE_U16, 1, 1);
@@ -15118,6 +15248,7 @@ int agoKernel_CannySuppThreshold_U8_U16_3x3(AgoNode * node, AgoKernelCommand cmd
 #endif
     else if (cmd == ago_kernel_cmd_query_target_support) {
         node->target_support_flags = 0
+                    | AGO_KERNEL_FLAG_DEVICE_CPU
 #if ENABLE_OPENCL        
                     | AGO_KERNEL_FLAG_DEVICE_GPU | AGO_KERNEL_FLAG_GPU_INTEG_FULL
 #endif                 
@@ -15535,7 +15666,16 @@ int agoKernel_Remap_U24_U24_Bilinear(AgoNode * node, AgoKernelCommand cmd)
 {
 	vx_status status = AGO_ERROR_KERNEL_NOT_IMPLEMENTED;
 	if (cmd == ago_kernel_cmd_execute) {
-		// not implemented yet
+		status = VX_SUCCESS;
+		AgoData * oImg = node->paramList[0];
+		AgoData * iImg = node->paramList[1];
+		AgoData * iMap = node->paramList[2];
+		if (HafCpu_Remap_U24_U24_Bilinear(oImg->u.img.width, oImg->u.img.height, oImg->buffer, oImg->u.img.stride_in_bytes,
+			iImg->u.img.width, iImg->u.img.height, iImg->buffer, iImg->u.img.stride_in_bytes,
+			(ago_coord2d_ushort_t *)iMap->buffer, iMap->u.remap.dst_width * sizeof(ago_coord2d_ushort_t), iMap->u.remap.remap_fractional_bits))
+		{
+			status = VX_FAILURE;
+		}
 	}
 	else if (cmd == ago_kernel_cmd_validate) {
 		status = ValidateArguments_Img_1OUT_1IN(node, VX_DF_IMAGE_RGB, VX_DF_IMAGE_RGB);
@@ -15653,6 +15793,7 @@ int agoKernel_Remap_U24_U24_Bilinear(AgoNode * node, AgoKernelCommand cmd)
 #endif
 	else if (cmd == ago_kernel_cmd_query_target_support) {
 		node->target_support_flags = 0
+			| AGO_KERNEL_FLAG_DEVICE_CPU
 #if ENABLE_OPENCL		
 			| AGO_KERNEL_FLAG_DEVICE_GPU | AGO_KERNEL_FLAG_GPU_INTEG_M2R
 #endif			
@@ -15666,7 +15807,16 @@ int agoKernel_Remap_U24_U32_Bilinear(AgoNode * node, AgoKernelCommand cmd)
 {
 	vx_status status = AGO_ERROR_KERNEL_NOT_IMPLEMENTED;
 	if (cmd == ago_kernel_cmd_execute) {
-		// not implemented yet
+		status = VX_SUCCESS;
+		AgoData * oImg = node->paramList[0];
+		AgoData * iImg = node->paramList[1];
+		AgoData * iMap = node->paramList[2];
+		if (HafCpu_Remap_U24_U32_Bilinear(oImg->u.img.width, oImg->u.img.height, oImg->buffer, oImg->u.img.stride_in_bytes,
+			iImg->u.img.width, iImg->u.img.height, iImg->buffer, iImg->u.img.stride_in_bytes,
+			(ago_coord2d_ushort_t *)iMap->buffer, iMap->u.remap.dst_width * sizeof(ago_coord2d_ushort_t), iMap->u.remap.remap_fractional_bits))
+		{
+			status = VX_FAILURE;
+		}
 	}
 	else if (cmd == ago_kernel_cmd_validate) {
 		status = ValidateArguments_Img_1OUT_1IN(node, VX_DF_IMAGE_RGB, VX_DF_IMAGE_RGBX);
@@ -15784,6 +15934,7 @@ int agoKernel_Remap_U24_U32_Bilinear(AgoNode * node, AgoKernelCommand cmd)
 #endif
 	else if (cmd == ago_kernel_cmd_query_target_support) {
 		node->target_support_flags = 0
+			| AGO_KERNEL_FLAG_DEVICE_CPU
 #if ENABLE_OPENCL		
 			| AGO_KERNEL_FLAG_DEVICE_GPU | AGO_KERNEL_FLAG_GPU_INTEG_M2R
 #endif			
@@ -15797,7 +15948,16 @@ int agoKernel_Remap_U32_U32_Bilinear(AgoNode * node, AgoKernelCommand cmd)
 {
 	vx_status status = AGO_ERROR_KERNEL_NOT_IMPLEMENTED;
 	if (cmd == ago_kernel_cmd_execute) {
-		// not implemented yet
+		status = VX_SUCCESS;
+		AgoData * oImg = node->paramList[0];
+		AgoData * iImg = node->paramList[1];
+		AgoData * iMap = node->paramList[2];
+		if (HafCpu_Remap_U32_U32_Bilinear(oImg->u.img.width, oImg->u.img.height, oImg->buffer, oImg->u.img.stride_in_bytes,
+			iImg->u.img.width, iImg->u.img.height, iImg->buffer, iImg->u.img.stride_in_bytes,
+			(ago_coord2d_ushort_t *)iMap->buffer, iMap->u.remap.dst_width * sizeof(ago_coord2d_ushort_t), iMap->u.remap.remap_fractional_bits))
+		{
+			status = VX_FAILURE;
+		}
 	}
 	else if (cmd == ago_kernel_cmd_validate) {
 		status = ValidateArguments_Img_1OUT_1IN(node, VX_DF_IMAGE_RGBX, VX_DF_IMAGE_RGBX);
@@ -15913,6 +16073,7 @@ int agoKernel_Remap_U32_U32_Bilinear(AgoNode * node, AgoKernelCommand cmd)
 #endif
 	else if (cmd == ago_kernel_cmd_query_target_support) {
 		node->target_support_flags = 0
+			| AGO_KERNEL_FLAG_DEVICE_CPU
 #if ENABLE_OPENCL		
 			| AGO_KERNEL_FLAG_DEVICE_GPU | AGO_KERNEL_FLAG_GPU_INTEG_M2R
 #endif			
@@ -15930,8 +16091,10 @@ int agoKernel_WarpAffine_U8_U8_Nearest(AgoNode * node, AgoKernelCommand cmd)
 		AgoData * oImg = node->paramList[0];
 		AgoData * iImg = node->paramList[1];
 		AgoData * iMat = node->paramList[2];
-		if (HafCpu_WarpAffine_U8_U8_Nearest(oImg->u.img.width, oImg->u.img.height, oImg->buffer, oImg->u.img.stride_in_bytes,
-			iImg->u.img.width, iImg->u.img.height, iImg->buffer, iImg->u.img.stride_in_bytes, (ago_affine_matrix_t *)iMat->buffer, node->localDataPtr))
+		vx_uint32 bandCount = min(HafCpu_GetThreadCount(), oImg->u.img.height / AGO_WARP_MIN_ROWS_PER_BAND);
+		if (HafCpu_WarpAffine_U8_U8_Parallel(oImg->u.img.width, oImg->u.img.height, oImg->buffer, oImg->u.img.stride_in_bytes,
+			iImg->u.img.width, iImg->u.img.height, iImg->buffer, iImg->u.img.stride_in_bytes, (ago_affine_matrix_t *)iMat->buffer,
+			VX_INTERPOLATION_TYPE_NEAREST_NEIGHBOR, VX_BORDER_MODE_UNDEFINED, 0, bandCount))
 		{
 			status = VX_FAILURE;
 		}
@@ -15951,8 +16114,6 @@ int agoKernel_WarpAffine_U8_U8_Nearest(AgoNode * node, AgoKernelCommand cmd)
 		}
 	}
 	else if (cmd == ago_kernel_cmd_initialize) {
-		int alignedWidth = (node->paramList[0]->u.img.width + 15) & ~15;		// Next highest multiple of 16, so that the buffer is aligned for all three lines
-		node->localDataSize = 2 * alignedWidth*sizeof(float);				// 2 rows (+some extra) worth of scratch memory			
 		status = VX_SUCCESS;
 	}
 	else if (cmd == ago_kernel_cmd_shutdown) {
@@ -16006,8 +16167,10 @@ int agoKernel_WarpAffine_U8_U8_Nearest_Constant(AgoNode * node, AgoKernelCommand
 		AgoData * oImg = node->paramList[0];
 		AgoData * iImg = node->paramList[1];
 		AgoData * iMat = node->paramList[2];
-		if (HafCpu_WarpAffine_U8_U8_Nearest_Constant(oImg->u.img.width, oImg->u.img.height, oImg->buffer, oImg->u.img.stride_in_bytes,
-			iImg->u.img.width, iImg->u.img.height, iImg->buffer, iImg->u.img.stride_in_bytes, (ago_affine_matrix_t *)iMat->buffer, node->paramList[3]->u.scalar.u.u, node->localDataPtr))
+		vx_uint32 bandCount = min(HafCpu_GetThreadCount(), oImg->u.img.height / AGO_WARP_MIN_ROWS_PER_BAND);
+		if (HafCpu_WarpAffine_U8_U8_Parallel(oImg->u.img.width, oImg->u.img.height, oImg->buffer, oImg->u.img.stride_in_bytes,
+			iImg->u.img.width, iImg->u.img.height, iImg->buffer, iImg->u.img.stride_in_bytes, (ago_affine_matrix_t *)iMat->buffer,
+			VX_INTERPOLATION_TYPE_NEAREST_NEIGHBOR, VX_BORDER_MODE_CONSTANT, node->paramList[3]->u.scalar.u.u, bandCount))
 		{
 			status = VX_FAILURE;
 		}
@@ -16029,8 +16192,6 @@ int agoKernel_WarpAffine_U8_U8_Nearest_Constant(AgoNode * node, AgoKernelCommand
 		}
 	}
 	else if (cmd == ago_kernel_cmd_initialize) {
-		int alignedWidth = (node->paramList[0]->u.img.width + 15) & ~15;		// Next highest multiple of 16, so that the buffer is aligned for all three lines
-		node->localDataSize = 2 * alignedWidth*sizeof(float);				// Three rows (+some extra) worth of scratch memory			
 		status = VX_SUCCESS;
 	}
 	else if (cmd == ago_kernel_cmd_shutdown) {
@@ -16101,8 +16262,10 @@ int agoKernel_WarpAffine_U8_U8_Bilinear(AgoNode * node, AgoKernelCommand cmd)
 		AgoData * oImg = node->paramList[0];
 		AgoData * iImg = node->paramList[1];
 		AgoData * iMat = node->paramList[2];
-		if (HafCpu_WarpAffine_U8_U8_Bilinear(oImg->u.img.width, oImg->u.img.height, oImg->buffer, oImg->u.img.stride_in_bytes,
-			iImg->u.img.width, iImg->u.img.height, iImg->buffer, iImg->u.img.stride_in_bytes, (ago_affine_matrix_t *)iMat->buffer, node->localDataPtr))
+		vx_uint32 bandCount = min(HafCpu_GetThreadCount(), oImg->u.img.height / AGO_WARP_MIN_ROWS_PER_BAND);
+		if (HafCpu_WarpAffine_U8_U8_Parallel(oImg->u.img.width, oImg->u.img.height, oImg->buffer, oImg->u.img.stride_in_bytes,
+			iImg->u.img.width, iImg->u.img.height, iImg->buffer, iImg->u.img.stride_in_bytes, (ago_affine_matrix_t *)iMat->buffer,
+			VX_INTERPOLATION_TYPE_BILINEAR, VX_BORDER_MODE_UNDEFINED, 0, bandCount))
 		{
 			status = VX_FAILURE;
 		}
@@ -16122,8 +16285,6 @@ int agoKernel_WarpAffine_U8_U8_Bilinear(AgoNode * node, AgoKernelCommand cmd)
 		}
 	}
 	else if (cmd == ago_kernel_cmd_initialize) {
-		int alignedWidth = (node->paramList[0]->u.img.width + 15) & ~15;		// Next highest multiple of 16, so that the buffer is aligned for all three lines
-		node->localDataSize = 2 * alignedWidth*sizeof(float);				// Three rows (+some extra) worth of scratch memory			
 		status = VX_SUCCESS;
 	}
 	else if (cmd == ago_kernel_cmd_shutdown) {
@@ -16181,8 +16342,10 @@ int agoKernel_WarpAffine_U8_U8_Bilinear_Constant(AgoNode * node, AgoKernelComman
 		AgoData * oImg = node->paramList[0];
 		AgoData * iImg = node->paramList[1];
 		AgoData * iMat = node->paramList[2];
-		if (HafCpu_WarpAffine_U8_U8_Bilinear_Constant(oImg->u.img.width, oImg->u.img.height, oImg->buffer, oImg->u.img.stride_in_bytes,
-			iImg->u.img.width, iImg->u.img.height, iImg->buffer, iImg->u.img.stride_in_bytes, (ago_affine_matrix_t *)iMat->buffer, node->paramList[3]->u.scalar.u.u, node->localDataPtr))
+		vx_uint32 bandCount = min(HafCpu_GetThreadCount(), oImg->u.img.height / AGO_WARP_MIN_ROWS_PER_BAND);
+		if (HafCpu_WarpAffine_U8_U8_Parallel(oImg->u.img.width, oImg->u.img.height, oImg->buffer, oImg->u.img.stride_in_bytes,
+			iImg->u.img.width, iImg->u.img.height, iImg->buffer, iImg->u.img.stride_in_bytes, (ago_affine_matrix_t *)iMat->buffer,
+			VX_INTERPOLATION_TYPE_BILINEAR, VX_BORDER_MODE_CONSTANT, node->paramList[3]->u.scalar.u.u, bandCount))
 		{
 			status = VX_FAILURE;
 		}
@@ -16204,8 +16367,6 @@ int agoKernel_WarpAffine_U8_U8_Bilinear_Constant(AgoNode * node, AgoKernelComman
 		}
 	}
 	else if (cmd == ago_kernel_cmd_initialize) {
-		int alignedWidth = (node->paramList[0]->u.img.width + 15) & ~15;		// Next highest multiple of 16, so that the buffer is aligned for all three lines
-		node->localDataSize = 2 * alignedWidth*sizeof(float);				// Three rows (+some extra) worth of scratch memory			
 		status = VX_SUCCESS;
 	}
 	else if (cmd == ago_kernel_cmd_shutdown) {
@@ -16265,8 +16426,10 @@ int agoKernel_WarpPerspective_U8_U8_Nearest(AgoNode * node, AgoKernelCommand cmd
 		AgoData * oImg = node->paramList[0];
 		AgoData * iImg = node->paramList[1];
 		AgoData * iMat = node->paramList[2];
-		if (HafCpu_WarpPerspective_U8_U8_Nearest(oImg->u.img.width, oImg->u.img.height, oImg->buffer, oImg->u.img.stride_in_bytes,
-			iImg->u.img.width, iImg->u.img.height, iImg->buffer, iImg->u.img.stride_in_bytes, (ago_perspective_matrix_t *)iMat->buffer, node->localDataPtr))
+		vx_uint32 bandCount = min(HafCpu_GetThreadCount(), oImg->u.img.height / AGO_WARP_MIN_ROWS_PER_BAND);
+		if (HafCpu_WarpPerspective_U8_U8_Parallel(oImg->u.img.width, oImg->u.img.height, oImg->buffer, oImg->u.img.stride_in_bytes,
+			iImg->u.img.width, iImg->u.img.height, iImg->buffer, iImg->u.img.stride_in_bytes, (ago_perspective_matrix_t *)iMat->buffer,
+			VX_INTERPOLATION_TYPE_NEAREST_NEIGHBOR, VX_BORDER_MODE_UNDEFINED, 0, bandCount))
 		{
 			status = VX_FAILURE;
 		}
@@ -16286,8 +16449,6 @@ int agoKernel_WarpPerspective_U8_U8_Nearest(AgoNode * node, AgoKernelCommand cmd
 		}
 	}
 	else if (cmd == ago_kernel_cmd_initialize) {
-		int alignedWidth = (node->paramList[0]->u.img.width + 15) & ~15;		// Next highest multiple of 16, so that the buffer is aligned for all three lines
-		node->localDataSize = 3 * alignedWidth*sizeof(float);				// Three rows (+some extra) worth of scratch memory			
 		status = VX_SUCCESS;
 	}
 	else if (cmd == ago_kernel_cmd_shutdown) {
@@ -16342,8 +16503,10 @@ int agoKernel_WarpPerspective_U8_U8_Nearest_Constant(AgoNode * node, AgoKernelCo
 		AgoData * oImg = node->paramList[0];
 		AgoData * iImg = node->paramList[1];
 		AgoData * iMat = node->paramList[2];
-		if (HafCpu_WarpPerspective_U8_U8_Nearest_Constant(oImg->u.img.width, oImg->u.img.height, oImg->buffer, oImg->u.img.stride_in_bytes,
-			iImg->u.img.width, iImg->u.img.height, iImg->buffer, iImg->u.img.stride_in_bytes, (ago_perspective_matrix_t *)iMat->buffer, node->paramList[3]->u.scalar.u.u, node->localDataPtr))
+		vx_uint32 bandCount = min(HafCpu_GetThreadCount(), oImg->u.img.height / AGO_WARP_MIN_ROWS_PER_BAND);
+		if (HafCpu_WarpPerspective_U8_U8_Parallel(oImg->u.img.width, oImg->u.img.height, oImg->buffer, oImg->u.img.stride_in_bytes,
+			iImg->u.img.width, iImg->u.img.height, iImg->buffer, iImg->u.img.stride_in_bytes, (ago_perspective_matrix_t *)iMat->buffer,
+			VX_INTERPOLATION_TYPE_NEAREST_NEIGHBOR, VX_BORDER_MODE_CONSTANT, node->paramList[3]->u.scalar.u.u, bandCount))
 		{
 			status = VX_FAILURE;
 		}
@@ -16365,8 +16528,6 @@ int agoKernel_WarpPerspective_U8_U8_Nearest_Constant(AgoNode * node, AgoKernelCo
 		}
 	}
 	else if (cmd == ago_kernel_cmd_initialize) {
-		int alignedWidth = (node->paramList[0]->u.img.width + 15) & ~15;		// Next highest multiple of 16, so that the buffer is aligned for all three lines
-		node->localDataSize = 3 * alignedWidth*sizeof(float);				// Three rows (+some extra) worth of scratch memory			
 		status = VX_SUCCESS;
 	}
 	else if (cmd == ago_kernel_cmd_shutdown) {
@@ -16438,8 +16599,10 @@ int agoKernel_WarpPerspective_U8_U8_Bilinear(AgoNode * node, AgoKernelCommand cm
 		AgoData * oImg = node->paramList[0];
 		AgoData * iImg = node->paramList[1];
 		AgoData * iMat = node->paramList[2];
-		if (HafCpu_WarpPerspective_U8_U8_Bilinear(oImg->u.img.width, oImg->u.img.height, oImg->buffer, oImg->u.img.stride_in_bytes,
-			iImg->u.img.width, iImg->u.img.height, iImg->buffer, iImg->u.img.stride_in_bytes, (ago_perspective_matrix_t *)iMat->buffer, node->localDataPtr))
+		vx_uint32 bandCount = min(HafCpu_GetThreadCount(), oImg->u.img.height / AGO_WARP_MIN_ROWS_PER_BAND);
+		if (HafCpu_WarpPerspective_U8_U8_Parallel(oImg->u.img.width, oImg->u.img.height, oImg->buffer, oImg->u.img.stride_in_bytes,
+			iImg->u.img.width, iImg->u.img.height, iImg->buffer, iImg->u.img.stride_in_bytes, (ago_perspective_matrix_t *)iMat->buffer,
+			VX_INTERPOLATION_TYPE_BILINEAR, VX_BORDER_MODE_UNDEFINED, 0, bandCount))
 		{
 			status = VX_FAILURE;
 		}
@@ -16459,8 +16622,6 @@ int agoKernel_WarpPerspective_U8_U8_Bilinear(AgoNode * node, AgoKernelCommand cm
 		}
 	}
 	else if (cmd == ago_kernel_cmd_initialize) {
-		int alignedWidth = (node->paramList[0]->u.img.width + 15) & ~15;		// Next highest multiple of 16, so that the buffer is aligned for all three lines
-		node->localDataSize = 3 * alignedWidth*sizeof(float);				// Three rows (+some extra) worth of scratch memory			
 		status = VX_SUCCESS;
 	}
 	else if (cmd == ago_kernel_cmd_shutdown) {
@@ -16519,8 +16680,10 @@ int agoKernel_WarpPerspective_U8_U8_Bilinear_Constant(AgoNode * node, AgoKernelC
 		AgoData * oImg = node->paramList[0];
 		AgoData * iImg = node->paramList[1];
 		AgoData * iMat = node->paramList[2];
-		if (HafCpu_WarpPerspective_U8_U8_Bilinear_Constant(oImg->u.img.width, oImg->u.img.height, oImg->buffer, oImg->u.img.stride_in_bytes,
-			iImg->u.img.width, iImg->u.img.height, iImg->buffer, iImg->u.img.stride_in_bytes, (ago_perspective_matrix_t *)iMat->buffer, node->paramList[3]->u.scalar.u.u, node->localDataPtr))
+		vx_uint32 bandCount = min(HafCpu_GetThreadCount(), oImg->u.img.height / AGO_WARP_MIN_ROWS_PER_BAND);
+		if (HafCpu_WarpPerspective_U8_U8_Parallel(oImg->u.img.width, oImg->u.img.height, oImg->buffer, oImg->u.img.stride_in_bytes,
+			iImg->u.img.width, iImg->u.img.height, iImg->buffer, iImg->u.img.stride_in_bytes, (ago_perspective_matrix_t *)iMat->buffer,
+			VX_INTERPOLATION_TYPE_BILINEAR, VX_BORDER_MODE_CONSTANT, node->paramList[3]->u.scalar.u.u, bandCount))
 		{
 			status = VX_FAILURE;
 		}
@@ -16542,8 +16705,6 @@ int agoKernel_WarpPerspective_U8_U8_Bilinear_Constant(AgoNode * node, AgoKernelC
 		}
 	}
 	else if (cmd == ago_kernel_cmd_initialize) {
-		int alignedWidth = (node->paramList[0]->u.img.width + 15) & ~15;		// Next highest multiple of 16, so that the buffer is aligned for all three lines
-		node->localDataSize = 3 * alignedWidth*sizeof(float);				// Three rows (+some extra) worth of scratch memory			
 		status = VX_SUCCESS;
 	}
 	else if (cmd == ago_kernel_cmd_shutdown) {
@@ -16596,6 +16757,186 @@ int agoKernel_WarpPerspective_U8_U8_Bilinear_Constant(AgoNode * node, AgoKernelC
 	return status;
 }
 
+int agoKernel_WarpAffine_U8_U8_Nearest_Replicate(AgoNode * node, AgoKernelCommand cmd)
+{
+	vx_status status = AGO_ERROR_KERNEL_NOT_IMPLEMENTED;
+	if (cmd == ago_kernel_cmd_execute) {
+		status = VX_SUCCESS;
+		AgoData * oImg = node->paramList[0];
+		AgoData * iImg = node->paramList[1];
+		AgoData * iMat = node->paramList[2];
+		vx_uint32 bandCount = min(HafCpu_GetThreadCount(), oImg->u.img.height / AGO_WARP_MIN_ROWS_PER_BAND);
+		if (HafCpu_WarpAffine_U8_U8_Parallel(oImg->u.img.width, oImg->u.img.height, oImg->buffer, oImg->u.img.stride_in_bytes,
+			iImg->u.img.width, iImg->u.img.height, iImg->buffer, iImg->u.img.stride_in_bytes, (ago_affine_matrix_t *)iMat->buffer,
+			VX_INTERPOLATION_TYPE_NEAREST_NEIGHBOR, VX_BORDER_MODE_REPLICATE, 0, bandCount))
+		{
+			status = VX_FAILURE;
+		}
+	}
+	else if (cmd == ago_kernel_cmd_validate) {
+		status = ValidateArguments_Img_1OUT_1IN(node, VX_DF_IMAGE_U8, VX_DF_IMAGE_U8);
+		if (!status) {
+			if (node->paramList[2]->u.mat.type != VX_TYPE_FLOAT32)
+				return VX_ERROR_INVALID_TYPE;
+			if (node->paramList[2]->u.mat.columns != 2 || node->paramList[2]->u.mat.rows != 3)
+				return VX_ERROR_INVALID_DIMENSION;
+			// output image dimensions have no constraints
+			vx_meta_format meta;
+			meta = &node->metaList[0];
+			meta->data.u.img.width = node->paramList[0]->u.img.width;
+			meta->data.u.img.height = node->paramList[0]->u.img.height;
+		}
+	}
+	else if (cmd == ago_kernel_cmd_initialize) {
+		status = VX_SUCCESS;
+	}
+	else if (cmd == ago_kernel_cmd_shutdown) {
+		status = VX_SUCCESS;
+	}
+	else if (cmd == ago_kernel_cmd_query_target_support) {
+		node->target_support_flags = 0
+					| AGO_KERNEL_FLAG_DEVICE_CPU
+					;
+		status = VX_SUCCESS;
+	}
+	return status;
+}
+
+int agoKernel_WarpAffine_U8_U8_Bilinear_Replicate(AgoNode * node, AgoKernelCommand cmd)
+{
+	vx_status status = AGO_ERROR_KERNEL_NOT_IMPLEMENTED;
+	if (cmd == ago_kernel_cmd_execute) {
+		status = VX_SUCCESS;
+		AgoData * oImg = node->paramList[0];
+		AgoData * iImg = node->paramList[1];
+		AgoData * iMat = node->paramList[2];
+		vx_uint32 bandCount = min(HafCpu_GetThreadCount(), oImg->u.img.height / AGO_WARP_MIN_ROWS_PER_BAND);
+		if (HafCpu_WarpAffine_U8_U8_Parallel(oImg->u.img.width, oImg->u.img.height, oImg->buffer, oImg->u.img.stride_in_bytes,
+			iImg->u.img.width, iImg->u.img.height, iImg->buffer, iImg->u.img.stride_in_bytes, (ago_affine_matrix_t *)iMat->buffer,
+			VX_INTERPOLATION_TYPE_BILINEAR, VX_BORDER_MODE_REPLICATE, 0, bandCount))
+		{
+			status = VX_FAILURE;
+		}
+	}
+	else if (cmd == ago_kernel_cmd_validate) {
+		status = ValidateArguments_Img_1OUT_1IN(node, VX_DF_IMAGE_U8, VX_DF_IMAGE_U8);
+		if (!status) {
+			if (node->paramList[2]->u.mat.type != VX_TYPE_FLOAT32)
+				return VX_ERROR_INVALID_TYPE;
+			if (node->paramList[2]->u.mat.columns != 2 || node->paramList[2]->u.mat.rows != 3)
+				return VX_ERROR_INVALID_DIMENSION;
+			// output image dimensions have no constraints
+			vx_meta_format meta;
+			meta = &node->metaList[0];
+			meta->data.u.img.width = node->paramList[0]->u.img.width;
+			meta->data.u.img.height = node->paramList[0]->u.img.height;
+		}
+	}
+	else if (cmd == ago_kernel_cmd_initialize) {
+		status = VX_SUCCESS;
+	}
+	else if (cmd == ago_kernel_cmd_shutdown) {
+		status = VX_SUCCESS;
+	}
+	else if (cmd == ago_kernel_cmd_query_target_support) {
+		node->target_support_flags = 0
+					| AGO_KERNEL_FLAG_DEVICE_CPU
+					;
+		status = VX_SUCCESS;
+	}
+	return status;
+}
+
+int agoKernel_WarpPerspective_U8_U8_Nearest_Replicate(AgoNode * node, AgoKernelCommand cmd)
+{
+	vx_status status = AGO_ERROR_KERNEL_NOT_IMPLEMENTED;
+	if (cmd == ago_kernel_cmd_execute) {
+		status = VX_SUCCESS;
+		AgoData * oImg = node->paramList[0];
+		AgoData * iImg = node->paramList[1];
+		AgoData * iMat = node->paramList[2];
+		vx_uint32 bandCount = min(HafCpu_GetThreadCount(), oImg->u.img.height / AGO_WARP_MIN_ROWS_PER_BAND);
+		if (HafCpu_WarpPerspective_U8_U8_Parallel(oImg->u.img.width, oImg->u.img.height, oImg->buffer, oImg->u.img.stride_in_bytes,
+			iImg->u.img.width, iImg->u.img.height, iImg->buffer, iImg->u.img.stride_in_bytes, (ago_perspective_matrix_t *)iMat->buffer,
+			VX_INTERPOLATION_TYPE_NEAREST_NEIGHBOR, VX_BORDER_MODE_REPLICATE, 0, bandCount))
+		{
+			status = VX_FAILURE;
+		}
+	}
+	else if (cmd == ago_kernel_cmd_validate) {
+		status = ValidateArguments_Img_1OUT_1IN(node, VX_DF_IMAGE_U8, VX_DF_IMAGE_U8);
+		if (!status) {
+			if (node->paramList[2]->u.mat.type != VX_TYPE_FLOAT32)
+				return VX_ERROR_INVALID_TYPE;
+			if (node->paramList[2]->u.mat.columns != 3 || node->paramList[2]->u.mat.rows != 3)
+				return VX_ERROR_INVALID_DIMENSION;
+			// output image dimensions have no constraints
+			vx_meta_format meta;
+			meta = &node->metaList[0];
+			meta->data.u.img.width = node->paramList[0]->u.img.width;
+			meta->data.u.img.height = node->paramList[0]->u.img.height;
+		}
+	}
+	else if (cmd == ago_kernel_cmd_initialize) {
+		status = VX_SUCCESS;
+	}
+	else if (cmd == ago_kernel_cmd_shutdown) {
+		status = VX_SUCCESS;
+	}
+	else if (cmd == ago_kernel_cmd_query_target_support) {
+		node->target_support_flags = 0
+					| AGO_KERNEL_FLAG_DEVICE_CPU
+					;
+		status = VX_SUCCESS;
+	}
+	return status;
+}
+
+int agoKernel_WarpPerspective_U8_U8_Bilinear_Replicate(AgoNode * node, AgoKernelCommand cmd)
+{
+	vx_status status = AGO_ERROR_KERNEL_NOT_IMPLEMENTED;
+	if (cmd == ago_kernel_cmd_execute) {
+		status = VX_SUCCESS;
+		AgoData * oImg = node->paramList[0];
+		AgoData * iImg = node->paramList[1];
+		AgoData * iMat = node->paramList[2];
+		vx_uint32 bandCount = min(HafCpu_GetThreadCount(), oImg->u.img.height / AGO_WARP_MIN_ROWS_PER_BAND);
+		if (HafCpu_WarpPerspective_U8_U8_Parallel(oImg->u.img.width, oImg->u.img.height, oImg->buffer, oImg->u.img.stride_in_bytes,
+			iImg->u.img.width, iImg->u.img.height, iImg->buffer, iImg->u.img.stride_in_bytes, (ago_perspective_matrix_t *)iMat->buffer,
+			VX_INTERPOLATION_TYPE_BILINEAR, VX_BORDER_MODE_REPLICATE, 0, bandCount))
+		{
+			status = VX_FAILURE;
+		}
+	}
+	else if (cmd == ago_kernel_cmd_validate) {
+		status = ValidateArguments_Img_1OUT_1IN(node, VX_DF_IMAGE_U8, VX_DF_IMAGE_U8);
+		if (!status) {
+			if (node->paramList[2]->u.mat.type != VX_TYPE_FLOAT32)
+				return VX_ERROR_INVALID_TYPE;
+			if (node->paramList[2]->u.mat.columns != 3 || node->paramList[2]->u.mat.rows != 3)
+				return VX_ERROR_INVALID_DIMENSION;
+			// output image dimensions have no constraints
+			vx_meta_format meta;
+			meta = &node->metaList[0];
+			meta->data.u.img.width = node->paramList[0]->u.img.width;
+			meta->data.u.img.height = node->paramList[0]->u.img.height;
+		}
+	}
+	else if (cmd == ago_kernel_cmd_initialize) {
+		status = VX_SUCCESS;
+	}
+	else if (cmd == ago_kernel_cmd_shutdown) {
+		status = VX_SUCCESS;
+	}
+	else if (cmd == ago_kernel_cmd_query_target_support) {
+		node->target_support_flags = 0
+					| AGO_KERNEL_FLAG_DEVICE_CPU
+					;
+		status = VX_SUCCESS;
+	}
+	return status;
+}
+
 int agoKernel_ScaleImage_U8_U8_Nearest(AgoNode * node, AgoKernelCommand cmd)
 {
 	vx_status status = AGO_ERROR_KERNEL_NOT_IMPLEMENTED;
@@ -17344,6 +17685,14 @@ int agoKernel_ScaleImage_U8_U8_Area(AgoNode * node, AgoKernelCommand cmd)
 	return status;
 }
 
+static vx_size OpticalFlowPyrLK_DataSize(vx_uint32 width, vx_uint32 height, vx_size keyPointCount, bool sparse)
+{
+	// sparse: derivative tiles around keypoint windows only; otherwise: full derivative image of level 0 reused for lower levels and temp buffer for scharr
+	if (sparse)
+		return HafCpu_OpticalFlowPyrLK_XY_XY_SparseScratchSize(width, height, (vx_uint32)keyPointCount) + 256;
+	return (height * width * 4) + keyPointCount * sizeof(ago_keypoint_t) + 256 + ((width + 2) * 4 + 64);
+}
+
 int agoKernel_OpticalFlowPyrLK_XY_XY(AgoNode * node, AgoKernelCommand cmd)
 {
 	vx_status status = AGO_ERROR_KERNEL_NOT_IMPLEMENTED;
@@ -17363,13 +17712,36 @@ int agoKernel_OpticalFlowPyrLK_XY_XY(AgoNode * node, AgoKernelCommand cmd)
 		if (oldXY->u.arr.numitems != newXYest->u.arr.numitems || oldXY->u.arr.numitems > newXY->u.arr.capacity) {
 			status = VX_ERROR_INVALID_DIMENSION;
 		}
-		else if (HafCpu_OpticalFlowPyrLK_XY_XY_Generic((vx_keypoint_t *)newXY->buffer, oldPyr->u.pyr.scale, (vx_uint32)oldPyr->u.pyr.levels, (ago_pyramid_u8_t *)oldPyr->buffer,
-			(ago_pyramid_u8_t *)newPyr->buffer, (vx_uint32)newXYest->u.arr.numitems, (vx_keypoint_t *)oldXY->buffer, (vx_keypoint_t *)newXYest->buffer,
-			termination, epsilon, num_iterations, use_initial_estimate, pPyrBuff->width * 4, node->localDataPtr, window_dimension))
-		{
-			status = VX_FAILURE;
-		}
 		else {
+			// track keypoints in parallel bands only when each band gets enough keypoints to amortize the dispatch
+			vx_uint32 keyPointCount = (vx_uint32)newXYest->u.arr.numitems;
+			vx_uint32 bandCount = min(HafCpu_GetThreadCount(), keyPointCount / AGO_OPTICALFLOWPYRLK_MIN_KEYPOINTS_PER_BAND);
+			// compute derivatives only around keypoints when that is cheaper than the whole image (or is all the scratch allows)
+			vx_size fullDataSize = OpticalFlowPyrLK_DataSize(pPyrBuff->width, pPyrBuff->height, keyPointCount, false);
+			if (OpticalFlowPyrLK_DataSize(pPyrBuff->width, pPyrBuff->height, keyPointCount, true) < fullDataSize || fullDataSize > node->localDataSize) {
+				if (HafCpu_OpticalFlowPyrLK_XY_XY_Sparse((vx_keypoint_t *)newXY->buffer, oldPyr->u.pyr.scale, (vx_uint32)oldPyr->u.pyr.levels, (ago_pyramid_u8_t *)oldPyr->buffer,
+					(ago_pyramid_u8_t *)newPyr->buffer, keyPointCount, (vx_keypoint_t *)oldXY->buffer, (vx_keypoint_t *)newXYest->buffer,
+					termination, epsilon, num_iterations, use_initial_estimate, node->localDataPtr, window_dimension, max(bandCount, 1u)))
+				{
+					status = VX_FAILURE;
+				}
+			}
+			else if (bandCount > 1) {
+				if (HafCpu_OpticalFlowPyrLK_XY_XY_Parallel((vx_keypoint_t *)newXY->buffer, oldPyr->u.pyr.scale, (vx_uint32)oldPyr->u.pyr.levels, (ago_pyramid_u8_t *)oldPyr->buffer,
+					(ago_pyramid_u8_t *)newPyr->buffer, keyPointCount, (vx_keypoint_t *)oldXY->buffer, (vx_keypoint_t *)newXYest->buffer,
+					termination, epsilon, num_iterations, use_initial_estimate, pPyrBuff->width * 4, node->localDataPtr, window_dimension, bandCount))
+				{
+					status = VX_FAILURE;
+				}
+			}
+			else if (HafCpu_OpticalFlowPyrLK_XY_XY_Generic((vx_keypoint_t *)newXY->buffer, oldPyr->u.pyr.scale, (vx_uint32)oldPyr->u.pyr.levels, (ago_pyramid_u8_t *)oldPyr->buffer,
+				(ago_pyramid_u8_t *)newPyr->buffer, keyPointCount, (vx_keypoint_t *)oldXY->buffer, (vx_keypoint_t *)newXYest->buffer,
+				termination, epsilon, num_iterations, use_initial_estimate, pPyrBuff->width * 4, node->localDataPtr, window_dimension))
+			{
+				status = VX_FAILURE;
+			}
+		}
+		if (status == VX_SUCCESS) {
 			newXY->u.arr.numitems = oldXY->u.arr.numitems;
 		}
 	}
@@ -17388,12 +17760,12 @@ int agoKernel_OpticalFlowPyrLK_XY_XY(AgoNode * node, AgoKernelCommand cmd)
 		}
 	}
 	else if (cmd == ago_kernel_cmd_initialize){
-		// allocate pyramid images for storing scharr output
+		// allocate storage for scharr output: full derivative image or derivative tiles, whichever is smaller for the keypoint capacity
 		AgoData * oldPyr = node->paramList[1];
 		ago_pyramid_u8_t *pPyrBuff = (ago_pyramid_u8_t *)oldPyr->buffer;
 		AgoData * newXYest = node->paramList[3];
-		int pyrWidth = pPyrBuff[0].width;
-		node->localDataSize = ((pPyrBuff->height*pPyrBuff->width * 4) + newXYest->u.arr.capacity*sizeof(ago_keypoint_t) + 256) + ((pyrWidth + 2) * 4 + 64);		// same as level 0 buffer; will be reused for lower levels. The second term, temp buffer for scharr
+		node->localDataSize = min(OpticalFlowPyrLK_DataSize(pPyrBuff->width, pPyrBuff->height, newXYest->u.arr.capacity, false),
+								  OpticalFlowPyrLK_DataSize(pPyrBuff->width, pPyrBuff->height, newXYest->u.arr.capacity, true));
 		status = VX_SUCCESS;
 	}
 	else if (cmd == ago_kernel_cmd_shutdown) {
@@ -17412,19 +17784,55 @@ int agoKernel_OpticalFlowPrepareLK_XY_XY(AgoNode * node, AgoKernelCommand cmd)
 {
 	vx_status status = AGO_ERROR_KERNEL_NOT_IMPLEMENTED;
 	if (cmd == ago_kernel_cmd_execute) {
-		// TBD
+		status = VX_SUCCESS;
+		AgoData * oXY = node->paramList[0];
+		AgoData * oNextXY = node->paramList[1];
+		AgoData * iOldXY = node->paramList[2];
+		AgoData * iNewXYest = node->paramList[3];
+		vx_bool use_initial_estimate = node->paramList[4]->u.scalar.u.i ? vx_true_e : vx_false_e;
+		vx_uint32 levels = node->paramList[5]->u.scalar.u.u;
+		vx_float32 scale = node->paramList[6]->u.scalar.u.f;
+		if (iOldXY->u.arr.numitems != iNewXYest->u.arr.numitems || iOldXY->u.arr.numitems > oXY->u.arr.capacity || iOldXY->u.arr.numitems > oNextXY->u.arr.capacity) {
+			status = VX_ERROR_INVALID_DIMENSION;
+		}
+		else if (HafCpu_OpticalFlowPrepareLK_XY_XY((vx_keypoint_t *)oXY->buffer, (ago_keypoint_t *)oNextXY->buffer, (vx_uint32)iOldXY->u.arr.numitems,
+			(vx_keypoint_t *)iOldXY->buffer, (vx_keypoint_t *)iNewXYest->buffer, use_initial_estimate, scale, levels))
+		{
+			status = VX_FAILURE;
+		}
+		else {
+			oXY->u.arr.numitems = iOldXY->u.arr.numitems;
+			oNextXY->u.arr.numitems = iOldXY->u.arr.numitems;
+		}
 	}
 	else if (cmd == ago_kernel_cmd_validate) {
-		// TBD
-	}
-	else if (cmd == ago_kernel_cmd_initialize){
-		// TBD
+		AgoData * iOldXY = node->paramList[2];
+		AgoData * iNewXYest = node->paramList[3];
+		if (iOldXY->u.arr.itemtype != VX_TYPE_KEYPOINT || iNewXYest->u.arr.itemtype != VX_TYPE_KEYPOINT ||
+			node->paramList[4]->u.scalar.type != VX_TYPE_BOOL || node->paramList[5]->u.scalar.type != VX_TYPE_UINT32 || node->paramList[6]->u.scalar.type != VX_TYPE_FLOAT32)
+			return VX_ERROR_INVALID_TYPE;
+		else if (!iOldXY->u.arr.capacity || iOldXY->u.arr.capacity != iNewXYest->u.arr.capacity)
+			return VX_ERROR_INVALID_DIMENSION;
+		else if (!node->paramList[5]->u.scalar.u.u)
+			return VX_ERROR_INVALID_VALUE;
+		// set output info
+		vx_meta_format meta;
+		meta = &node->metaList[0];
+		meta->data.u.arr.itemtype = VX_TYPE_KEYPOINT;
+		meta->data.u.arr.capacity = iOldXY->u.arr.capacity;
+		meta = &node->metaList[1];
+		meta->data.u.arr.itemtype = VX_TYPE_COORDINATES2DF;
+		meta->data.u.arr.capacity = iOldXY->u.arr.capacity;
+		status = VX_SUCCESS;
 	}
-	else if (cmd == ago_kernel_cmd_shutdown) {
-		// TBD
+	else if (cmd == ago_kernel_cmd_initialize || cmd == ago_kernel_cmd_shutdown) {
+		status = VX_SUCCESS;
 	}
 	else if (cmd == ago_kernel_cmd_query_target_support) {
-		// TBD
+		node->target_support_flags = 0
+			| AGO_KERNEL_FLAG_DEVICE_CPU
+			;
+		status = VX_SUCCESS;
 	}
 	return status;
 }
@@ -17433,19 +17841,88 @@ int agoKernel_OpticalFlowImageLK_XY_XY(AgoNode * node, AgoKernelCommand cmd)
 {
 	vx_status status = AGO_ERROR_KERNEL_NOT_IMPLEMENTED;
 	if (cmd == ago_kernel_cmd_execute) {
-		// TBD
+		status = VX_SUCCESS;
+		AgoData * oXY = node->paramList[0];
+		AgoData * oNextXY = node->paramList[1];
+		AgoData * iXY = node->paramList[2];
+		AgoData * iNextXY = node->paramList[3];
+		AgoData * iOldXY = node->paramList[4];
+		AgoData * iImgOld = node->paramList[5];
+		AgoData * iImgNew = node->paramList[6];
+		vx_enum    termination = node->paramList[7]->u.scalar.u.e;
+		vx_float32 epsilon = node->paramList[8]->u.scalar.u.f;
+		vx_uint32  num_iterations = node->paramList[9]->u.scalar.u.u;
+		vx_int32   window_dimension = (vx_int32)node->paramList[10]->u.scalar.u.s;
+		vx_uint32  level = node->paramList[11]->u.scalar.u.u;
+		vx_uint32  levels = node->paramList[12]->u.scalar.u.u;
+		vx_float32 scale = node->paramList[13]->u.scalar.u.f;
+		vx_uint32 keyPointCount = (vx_uint32)iXY->u.arr.numitems;
+		if (iNextXY->u.arr.numitems != keyPointCount || iOldXY->u.arr.numitems != keyPointCount || keyPointCount > oXY->u.arr.capacity || keyPointCount > oNextXY->u.arr.capacity) {
+			status = VX_ERROR_INVALID_DIMENSION;
+		}
+		else {
+			ago_pyramid_u8_t imgOld = { iImgOld->u.img.width, iImgOld->u.img.height, iImgOld->u.img.stride_in_bytes, iImgOld->buffer, vx_true_e };
+			ago_pyramid_u8_t imgNew = { iImgNew->u.img.width, iImgNew->u.img.height, iImgNew->u.img.stride_in_bytes, iImgNew->buffer, vx_true_e };
+			vx_uint32 bandCount = min(HafCpu_GetThreadCount(), keyPointCount / AGO_OPTICALFLOWPYRLK_MIN_KEYPOINTS_PER_BAND);
+			vx_size fullDataSize = OpticalFlowPyrLK_DataSize(imgOld.width, imgOld.height, keyPointCount, false);
+			bool sparse = OpticalFlowPyrLK_DataSize(imgOld.width, imgOld.height, keyPointCount, true) < fullDataSize || fullDataSize > node->localDataSize;
+			if (HafCpu_OpticalFlowImageLK_XY_XY((vx_keypoint_t *)oXY->buffer, (ago_keypoint_t *)oNextXY->buffer, (vx_keypoint_t *)iXY->buffer, (ago_keypoint_t *)iNextXY->buffer,
+				keyPointCount, (vx_keypoint_t *)iOldXY->buffer, &imgOld, &imgNew, termination, epsilon, num_iterations, window_dimension,
+				scale, level, levels, node->localDataPtr, sparse ? vx_true_e : vx_false_e, max(bandCount, 1u)))
+			{
+				status = VX_FAILURE;
+			}
+			else {
+				oXY->u.arr.numitems = keyPointCount;
+				oNextXY->u.arr.numitems = keyPointCount;
+			}
+		}
 	}
 	else if (cmd == ago_kernel_cmd_validate) {
-		// TBD
+		AgoData * iXY = node->paramList[2];
+		AgoData * iNextXY = node->paramList[3];
+		AgoData * iOldXY = node->paramList[4];
+		AgoData * iImgOld = node->paramList[5];
+		AgoData * iImgNew = node->paramList[6];
+		if (iXY->u.arr.itemtype != VX_TYPE_KEYPOINT || iNextXY->u.arr.itemtype != VX_TYPE_COORDINATES2DF || iOldXY->u.arr.itemtype != VX_TYPE_KEYPOINT ||
+			node->paramList[7]->u.scalar.type != VX_TYPE_ENUM || node->paramList[8]->u.scalar.type != VX_TYPE_FLOAT32 ||
+			node->paramList[9]->u.scalar.type != VX_TYPE_UINT32 || node->paramList[10]->u.scalar.type != VX_TYPE_SIZE ||
+			node->paramList[11]->u.scalar.type != VX_TYPE_UINT32 || node->paramList[12]->u.scalar.type != VX_TYPE_UINT32 || node->paramList[13]->u.scalar.type != VX_TYPE_FLOAT32)
+			return VX_ERROR_INVALID_TYPE;
+		else if (iImgOld->u.img.format != VX_DF_IMAGE_U8 || iImgNew->u.img.format != VX_DF_IMAGE_U8)
+			return VX_ERROR_INVALID_FORMAT;
+		else if (!iImgOld->u.img.width || !iImgOld->u.img.height || iImgOld->u.img.width != iImgNew->u.img.width || iImgOld->u.img.height != iImgNew->u.img.height ||
+			!iXY->u.arr.capacity || iXY->u.arr.capacity != iNextXY->u.arr.capacity || iXY->u.arr.capacity != iOldXY->u.arr.capacity)
+			return VX_ERROR_INVALID_DIMENSION;
+		else if (node->paramList[11]->u.scalar.u.u >= node->paramList[12]->u.scalar.u.u ||
+			node->paramList[10]->u.scalar.u.s < 3 || node->paramList[10]->u.scalar.u.s > AGO_OPTICALFLOWPYRLK_MAX_DIM)
+			return VX_ERROR_INVALID_VALUE;
+		// set output info
+		vx_meta_format meta;
+		meta = &node->metaList[0];
+		meta->data.u.arr.itemtype = VX_TYPE_KEYPOINT;
+		meta->data.u.arr.capacity = iXY->u.arr.capacity;
+		meta = &node->metaList[1];
+		meta->data.u.arr.itemtype = VX_TYPE_COORDINATES2DF;
+		meta->data.u.arr.capacity = iXY->u.arr.capacity;
+		status = VX_SUCCESS;
 	}
-	else if (cmd == ago_kernel_cmd_initialize){
-		// TBD
+	else if (cmd == ago_kernel_cmd_initialize) {
+		// storage for scharr output of this level
+		AgoData * iImgOld = node->paramList[5];
+		vx_size capacity = node->paramList[2]->u.arr.capacity;
+		node->localDataSize = min(OpticalFlowPyrLK_DataSize(iImgOld->u.img.width, iImgOld->u.img.height, capacity, false),
+								  OpticalFlowPyrLK_DataSize(iImgOld->u.img.width, iImgOld->u.img.height, capacity, true));
+		status = VX_SUCCESS;
 	}
 	else if (cmd == ago_kernel_cmd_shutdown) {
-		// TBD
+		status = VX_SUCCESS;
 	}
 	else if (cmd == ago_kernel_cmd_query_target_support) {
-		// TBD
+		node->target_support_flags = 0
+			| AGO_KERNEL_FLAG_DEVICE_CPU
+			;
+		status = VX_SUCCESS;
 	}
 	return status;
 }
@@ -17454,19 +17931,36 @@ int agoKernel_OpticalFlowFinalLK_XY_XY(AgoNode * node, AgoKernelCommand cmd)
 {
 	vx_status status = AGO_ERROR_KERNEL_NOT_IMPLEMENTED;
 	if (cmd == ago_kernel_cmd_execute) {
-		// TBD
+		status = VX_SUCCESS;
+		AgoData * oXY = node->paramList[0];
+		AgoData * iXY = node->paramList[1];
+		if (iXY->u.arr.numitems > oXY->u.arr.capacity) {
+			status = VX_ERROR_INVALID_DIMENSION;
+		}
+		else {
+			memcpy(oXY->buffer, iXY->buffer, iXY->u.arr.numitems * sizeof(vx_keypoint_t));
+			oXY->u.arr.numitems = iXY->u.arr.numitems;
+		}
 	}
 	else if (cmd == ago_kernel_cmd_validate) {
-		// TBD
-	}
-	else if (cmd == ago_kernel_cmd_initialize){
-		// TBD
+		AgoData * iXY = node->paramList[1];
+		if (iXY->u.arr.itemtype != VX_TYPE_KEYPOINT)
+			return VX_ERROR_INVALID_TYPE;
+		// set output info
+		vx_meta_format meta;
+		meta = &node->metaList[0];
+		meta->data.u.arr.itemtype = VX_TYPE_KEYPOINT;
+		meta->data.u.arr.capacity = iXY->u.arr.capacity;
+		status = VX_SUCCESS;
 	}
-	else if (cmd == ago_kernel_cmd_shutdown) {
-		// TBD
+	else if (cmd == ago_kernel_cmd_initialize || cmd == ago_kernel_cmd_shutdown) {
+		status = VX_SUCCESS;
 	}
 	else if (cmd == ago_kernel_cmd_query_target_support) {
-		// TBD
+		node->target_support_flags = 0
+			| AGO_KERNEL_FLAG_DEVICE_CPU
+			;
+		status = VX_SUCCESS;
 	}
 	return status;
 }
@@ -17532,8 +18026,10 @@ int agoKernel_HarrisMergeSortAndPick_XY_XYS(AgoNode * node, AgoKernelCommand cmd
 		ago_harris_grid_header_t * gridInfo = (ago_harris_grid_header_t *)node->localDataPtr;
 		ago_coord2d_short_t * gridBuf = (ago_coord2d_short_t *)(node->localDataPtr ? &node->localDataPtr[sizeof(ago_harris_grid_header_t)] : nullptr);
 		vx_uint32 cornerCount = 0;
+		// the total corner count after min_distance filtering needs all candidates visited in order: skip that when it isn't requested
 		if (HafCpu_HarrisMergeSortAndPick_XY_XYS((vx_uint32)oXY->u.arr.capacity, (vx_keypoint_t *)oXY->buffer, &cornerCount,
-			(ago_keypoint_xys_t *)iXYS->buffer, (vx_uint32)iXYS->u.arr.numitems, min_distance, gridInfo, gridBuf)) {
+			(ago_keypoint_xys_t *)iXYS->buffer, (vx_uint32)iXYS->u.arr.numitems, min_distance, gridInfo, gridBuf,
+			oNum ? vx_true_e : vx_false_e, HafCpu_GetThreadCount())) {
 			status = VX_FAILURE;
 		}
 		else {
@@ -17653,9 +18149,8 @@ int agoKernel_CannyEdgeTrace_U8_U8(AgoNode * node, AgoKernelCommand cmd)
 	if (cmd == ago_kernel_cmd_execute) {
 		status = VX_SUCCESS;
 		AgoData * oImg = node->paramList[0];
-		AgoData * iStack = node->paramList[1];
 		if (HafCpu_CannyEdgeTrace_U8_U8(oImg->u.img.width, oImg->u.img.height, oImg->buffer, oImg->u.img.stride_in_bytes,
-										iStack->u.cannystack.count, (ago_coord2d_ushort_t *)iStack->buffer))
+										(ago_coord2d_ushort_t *)node->localDataPtr, HafCpu_GetThreadCount()))
 		{
 			status = VX_FAILURE;
 		}
@@ -17668,11 +18163,16 @@ int agoKernel_CannyEdgeTrace_U8_U8(AgoNode * node, AgoKernelCommand cmd)
 			return VX_ERROR_INVALID_DIMENSION;
 		status = VX_SUCCESS;
 	}
-	else if (cmd == ago_kernel_cmd_initialize || cmd == ago_kernel_cmd_shutdown) {
+	else if (cmd == ago_kernel_cmd_initialize) {
+		node->localDataSize = node->paramList[0]->u.img.width * node->paramList[0]->u.img.height * sizeof(ago_coord2d_ushort_t);	// trace stack of each band
+		status = VX_SUCCESS;
+	}
+	else if (cmd == ago_kernel_cmd_shutdown) {
 		status = VX_SUCCESS;
 	}
     else if (cmd == ago_kernel_cmd_query_target_support) {
         node->target_support_flags = 0
+                    | AGO_KERNEL_FLAG_DEVICE_CPU
                     ;
         status = VX_SUCCESS;
     }
@@ -17725,7 +18225,15 @@ int agoKernel_IntegralImage_U32_U8(AgoNode * node, AgoKernelCommand cmd)
 		status = VX_SUCCESS;
 		AgoData * oImg = node->paramList[0];
 		AgoData * iImg = node->paramList[1];
-		if (HafCpu_IntegralImage_U32_U8(oImg->u.img.width, oImg->u.img.height, (vx_uint32 *)oImg->buffer, oImg->u.img.stride_in_bytes,
+		vx_uint32 bandCount = min(HafCpu_GetThreadCount(), oImg->u.img.width * oImg->u.img.height / AGO_INTEGRALIMAGE_MIN_PIXELS_PER_BAND);
+		if (bandCount > 1) {
+			if (HafCpu_IntegralImage_U32_U8_Parallel(oImg->u.img.width, oImg->u.img.height, (vx_uint32 *)oImg->buffer, oImg->u.img.stride_in_bytes,
+													 iImg->buffer, iImg->u.img.stride_in_bytes, bandCount))
+			{
+				status = VX_FAILURE;
+			}
+		}
+		else if (HafCpu_IntegralImage_U32_U8(oImg->u.img.width, oImg->u.img.height, (vx_uint32 *)oImg->buffer, oImg->u.img.stride_in_bytes,
 										iImg->buffer, iImg->u.img.stride_in_bytes))
 		{
 			status = VX_FAILURE;
@@ -17766,7 +18274,8 @@ int agoKernel_Histogram_DATA_U8(AgoNode * node, AgoKernelCommand cmd)
 		vx_uint32 range = (vx_uint32)oDist->u.dist.range;
 		vx_uint32 window = oDist->u.dist.window;
 		vx_uint32 * histOut = (vx_uint32 *)oDist->buffer;
-		if (HafCpu_HistogramFixedBins_DATA_U8(histOut, numbins, offset, range, window, iImg->u.img.width, iImg->u.img.height, iImg->buffer, iImg->u.img.stride_in_bytes)) {
+		vx_uint32 bandCount = min(HafCpu_GetThreadCount(), iImg->u.img.width * iImg->u.img.height / AGO_HISTOGRAM_MIN_PIXELS_PER_BAND);
+		if (HafCpu_HistogramFixedBins_DATA_U8(histOut, numbins, offset, range, window, iImg->u.img.width, iImg->u.img.height, iImg->buffer, iImg->u.img.stride_in_bytes, bandCount)) {
 			status = VX_FAILURE;
 		}
 	}
@@ -17792,9 +18301,15 @@ int agoKernel_MeanStdDev_DATA_U8(AgoNode * node, AgoKernelCommand cmd)
 		status = VX_SUCCESS;
 		AgoData * oData = node->paramList[0];
 		AgoData * iImg = node->paramList[1];
-		if (HafCpu_MeanStdDev_DATA_U8(&((ago_meanstddev_data_t *)oData->buffer)->sum, &((ago_meanstddev_data_t *)oData->buffer)->sumSquared, 
-			iImg->u.img.rect_valid.end_x - iImg->u.img.rect_valid.start_x, iImg->u.img.rect_valid.end_y - iImg->u.img.rect_valid.start_y,
-			iImg->buffer + (iImg->u.img.rect_valid.start_y*iImg->u.img.stride_in_bytes) + iImg->u.img.rect_valid.start_x, iImg->u.img.stride_in_bytes)) {
+		vx_uint32 bandCount = min(HafCpu_GetThreadCount(), iImg->u.img.width * iImg->u.img.height / AGO_STATISTICS_MIN_PIXELS_PER_BAND);
+		int err = (bandCount > 1) ?
+			HafCpu_MeanStdDev_DATA_U8_Parallel(&((ago_meanstddev_data_t *)oData->buffer)->sum, &((ago_meanstddev_data_t *)oData->buffer)->sumSquared,
+				iImg->u.img.rect_valid.end_x - iImg->u.img.rect_valid.start_x, iImg->u.img.rect_valid.end_y - iImg->u.img.rect_valid.start_y,
+				iImg->buffer + (iImg->u.img.rect_valid.start_y*iImg->u.img.stride_in_bytes) + iImg->u.img.rect_valid.start_x, iImg->u.img.stride_in_bytes, bandCount) :
+			HafCpu_MeanStdDev_DATA_U8(&((ago_meanstddev_data_t *)oData->buffer)->sum, &((ago_meanstddev_data_t *)oData->buffer)->sumSquared, 
+				iImg->u.img.rect_valid.end_x - iImg->u.img.rect_valid.start_x, iImg->u.img.rect_valid.end_y - iImg->u.img.rect_valid.start_y,
+				iImg->buffer + (iImg->u.img.rect_valid.start_y*iImg->u.img.stride_in_bytes) + iImg->u.img.rect_valid.start_x, iImg->u.img.stride_in_bytes);
+		if (err) {
 			status = VX_FAILURE;
 		}
 		else {
@@ -17823,9 +18338,15 @@ int agoKernel_MinMax_DATA_U8(AgoNode * node, AgoKernelCommand cmd)
 		status = VX_SUCCESS;
 		AgoData * oData = node->paramList[0];
 		AgoData * iImg = node->paramList[1];
-		if (HafCpu_MinMax_DATA_U8(&((ago_minmaxloc_data_t *)oData->buffer)->min, &((ago_minmaxloc_data_t *)oData->buffer)->max,
-			iImg->u.img.rect_valid.end_x - iImg->u.img.rect_valid.start_x, iImg->u.img.rect_valid.end_y - iImg->u.img.rect_valid.start_y, 
-			iImg->buffer + (iImg->u.img.rect_valid.start_y*iImg->u.img.stride_in_bytes) + iImg->u.img.rect_valid.start_x, iImg->u.img.stride_in_bytes)) {
+		vx_uint32 bandCount = min(HafCpu_GetThreadCount(), iImg->u.img.width * iImg->u.img.height / AGO_STATISTICS_MIN_PIXELS_PER_BAND);
+		int err = (bandCount > 1) ?
+			HafCpu_MinMax_DATA_U8_Parallel(&((ago_minmaxloc_data_t *)oData->buffer)->min, &((ago_minmaxloc_data_t *)oData->buffer)->max,
+				iImg->u.img.rect_valid.end_x - iImg->u.img.rect_valid.start_x, iImg->u.img.rect_valid.end_y - iImg->u.img.rect_valid.start_y,
+				iImg->buffer + (iImg->u.img.rect_valid.start_y*iImg->u.img.stride_in_bytes) + iImg->u.img.rect_valid.start_x, iImg->u.img.stride_in_bytes, bandCount) :
+			HafCpu_MinMax_DATA_U8(&((ago_minmaxloc_data_t *)oData->buffer)->min, &((ago_minmaxloc_data_t *)oData->buffer)->max,
+				iImg->u.img.rect_valid.end_x - iImg->u.img.rect_valid.start_x, iImg->u.img.rect_valid.end_y - iImg->u.img.rect_valid.start_y,
+				iImg->buffer + (iImg->u.img.rect_valid.start_y*iImg->u.img.stride_in_bytes) + iImg->u.img.rect_valid.start_x, iImg->u.img.stride_in_bytes);
+		if (err) {
 			status = VX_FAILURE;
 		}
 	}
@@ -17851,9 +18372,15 @@ int agoKernel_MinMax_DATA_S16(AgoNode * node, AgoKernelCommand cmd)
 		status = VX_SUCCESS;
 		AgoData * oData = node->paramList[0];
 		AgoData * iImg = node->paramList[1];
-		if (HafCpu_MinMax_DATA_S16(&((ago_minmaxloc_data_t *)oData->buffer)->min, &((ago_minmaxloc_data_t *)oData->buffer)->max,
-			iImg->u.img.rect_valid.end_x - iImg->u.img.rect_valid.start_x, iImg->u.img.rect_valid.end_y - iImg->u.img.rect_valid.start_y, 
-			(vx_int16 *)(iImg->buffer + (iImg->u.img.rect_valid.start_y*iImg->u.img.stride_in_bytes)) + iImg->u.img.rect_valid.start_x, iImg->u.img.stride_in_bytes)) {
+		vx_uint32 bandCount = min(HafCpu_GetThreadCount(), iImg->u.img.width * iImg->u.img.height / AGO_STATISTICS_MIN_PIXELS_PER_BAND);
+		int err = (bandCount > 1) ?
+			HafCpu_MinMax_DATA_S16_Parallel(&((ago_minmaxloc_data_t *)oData->buffer)->min, &((ago_minmaxloc_data_t *)oData->buffer)->max,
+				iImg->u.img.rect_valid.end_x - iImg->u.img.rect_valid.start_x, iImg->u.img.rect_valid.end_y - iImg->u.img.rect_valid.start_y,
+				(vx_int16 *)(iImg->buffer + (iImg->u.img.rect_valid.start_y*iImg->u.img.stride_in_bytes)) + iImg->u.img.rect_valid.start_x, iImg->u.img.stride_in_bytes, bandCount) :
+			HafCpu_MinMax_DATA_S16(&((ago_minmaxloc_data_t *)oData->buffer)->min, &((ago_minmaxloc_data_t *)oData->buffer)->max,
+				iImg->u.img.rect_valid.end_x - iImg->u.img.rect_valid.start_x, iImg->u.img.rect_valid.end_y - iImg->u.img.rect_valid.start_y,
+				(vx_int16 *)(iImg->buffer + (iImg->u.img.rect_valid.start_y*iImg->u.img.stride_in_bytes)) + iImg->u.img.rect_valid.start_x, iImg->u.img.stride_in_bytes);
+		if (err) {
 			status = VX_FAILURE;
 		}
 	}
@@ -18047,9 +18574,15 @@ int agoKernel_MinMaxLoc_DATA_U8DATA_Loc_None_Count_Min(AgoNode * node, AgoKernel
 		}
 		AgoData * iImg = node->paramList[1];
 		vx_int32 finalMinValue, finalMaxValue;
-		if (HafCpu_MinMaxLoc_DATA_U8DATA_Loc_None_Count_Min(&node->paramList[0]->u.scalar.u.u, &finalMinValue, &finalMaxValue,
-			numDataPartitions, srcMinValue, srcMaxValue, iImg->u.img.rect_valid.end_x - iImg->u.img.rect_valid.start_x, iImg->u.img.rect_valid.end_y - iImg->u.img.rect_valid.start_y,
-			iImg->buffer + (iImg->u.img.rect_valid.start_y*iImg->u.img.stride_in_bytes) + iImg->u.img.rect_valid.start_x, iImg->u.img.stride_in_bytes))
+		vx_uint32 bandCount = min(HafCpu_GetThreadCount(), iImg->u.img.width * iImg->u.img.height / AGO_STATISTICS_MIN_PIXELS_PER_BAND);
+		int err = (bandCount > 1) ?
+			HafCpu_MinMaxLoc_DATA_U8DATA_Parallel(&node->paramList[0]->u.scalar.u.u, nullptr, 0, nullptr, 0, nullptr,
+				&finalMinValue, &finalMaxValue, numDataPartitions, srcMinValue, srcMaxValue, iImg->u.img.rect_valid.end_x - iImg->u.img.rect_valid.start_x, iImg->u.img.rect_valid.end_y - iImg->u.img.rect_valid.start_y,
+				iImg->buffer + (iImg->u.img.rect_valid.start_y*iImg->u.img.stride_in_bytes) + iImg->u.img.rect_valid.start_x, iImg->u.img.stride_in_bytes, (vx_coordinates2d_t *)node->localDataPtr, bandCount) :
+			HafCpu_MinMaxLoc_DATA_U8DATA_Loc_None_Count_Min(&node->paramList[0]->u.scalar.u.u, &finalMinValue, &finalMaxValue,
+				numDataPartitions, srcMinValue, srcMaxValue, iImg->u.img.rect_valid.end_x - iImg->u.img.rect_valid.start_x, iImg->u.img.rect_valid.end_y - iImg->u.img.rect_valid.start_y,
+				iImg->buffer + (iImg->u.img.rect_valid.start_y*iImg->u.img.stride_in_bytes) + iImg->u.img.rect_valid.start_x, iImg->u.img.stride_in_bytes);
+		if (err)
 		{
 			status = VX_FAILURE;
 		}
@@ -18094,9 +18627,15 @@ int agoKernel_MinMaxLoc_DATA_U8DATA_Loc_None_Count_Max(AgoNode * node, AgoKernel
 		}
 		AgoData * iImg = node->paramList[1];
 		vx_int32 finalMinValue, finalMaxValue;
-		if (HafCpu_MinMaxLoc_DATA_U8DATA_Loc_None_Count_Max(&node->paramList[0]->u.scalar.u.u, &finalMinValue, &finalMaxValue,
-			numDataPartitions, srcMinValue, srcMaxValue, iImg->u.img.rect_valid.end_x - iImg->u.img.rect_valid.start_x, iImg->u.img.rect_valid.end_y - iImg->u.img.rect_valid.start_y, 
-			iImg->buffer + (iImg->u.img.rect_valid.start_y*iImg->u.img.stride_in_bytes) + iImg->u.img.rect_valid.start_x, iImg->u.img.stride_in_bytes))
+		vx_uint32 bandCount = min(HafCpu_GetThreadCount(), iImg->u.img.width * iImg->u.img.height / AGO_STATISTICS_MIN_PIXELS_PER_BAND);
+		int err = (bandCount > 1) ?
+			HafCpu_MinMaxLoc_DATA_U8DATA_Parallel(nullptr, &node->paramList[0]->u.scalar.u.u, 0, nullptr, 0, nullptr,
+				&finalMinValue, &finalMaxValue, numDataPartitions, srcMinValue, srcMaxValue, iImg->u.img.rect_valid.end_x - iImg->u.img.rect_valid.start_x, iImg->u.img.rect_valid.end_y - iImg->u.img.rect_valid.start_y,
+				iImg->buffer + (iImg->u.img.rect_valid.start_y*iImg->u.img.stride_in_bytes) + iImg->u.img.rect_valid.start_x, iImg->u.img.stride_in_bytes, (vx_coordinates2d_t *)node->localDataPtr, bandCount) :
+			HafCpu_MinMaxLoc_DATA_U8DATA_Loc_None_Count_Max(&node->paramList[0]->u.scalar.u.u, &finalMinValue, &finalMaxValue,
+				numDataPartitions, srcMinValue, srcMaxValue, iImg->u.img.rect_valid.end_x - iImg->u.img.rect_valid.start_x, iImg->u.img.rect_valid.end_y - iImg->u.img.rect_valid.start_y, 
+				iImg->buffer + (iImg->u.img.rect_valid.start_y*iImg->u.img.stride_in_bytes) + iImg->u.img.rect_valid.start_x, iImg->u.img.stride_in_bytes);
+		if (err)
 		{
 			status = VX_FAILURE;
 		}
@@ -18141,9 +18680,15 @@ int agoKernel_MinMaxLoc_DATA_U8DATA_Loc_None_Count_MinMax(AgoNode * node, AgoKer
 		}
 		AgoData * iImg = node->paramList[2];
 		vx_int32 finalMinValue, finalMaxValue;
-		if (HafCpu_MinMaxLoc_DATA_U8DATA_Loc_None_Count_MinMax(&node->paramList[0]->u.scalar.u.u, &node->paramList[1]->u.scalar.u.u, &finalMinValue, &finalMaxValue,
-			numDataPartitions, srcMinValue, srcMaxValue, iImg->u.img.rect_valid.end_x - iImg->u.img.rect_valid.start_x, iImg->u.img.rect_valid.end_y - iImg->u.img.rect_valid.start_y, 
-			iImg->buffer + (iImg->u.img.rect_valid.start_y*iImg->u.img.stride_in_bytes) + iImg->u.img.rect_valid.start_x, iImg->u.img.stride_in_bytes))
+		vx_uint32 bandCount = min(HafCpu_GetThreadCount(), iImg->u.img.width * iImg->u.img.height / AGO_STATISTICS_MIN_PIXELS_PER_BAND);
+		int err = (bandCount > 1) ?
+			HafCpu_MinMaxLoc_DATA_U8DATA_Parallel(&node->paramList[0]->u.scalar.u.u, &node->paramList[1]->u.scalar.u.u, 0, nullptr, 0, nullptr,
+				&finalMinValue, &finalMaxValue, numDataPartitions, srcMinValue, srcMaxValue, iImg->u.img.rect_valid.end_x - iImg->u.img.rect_valid.start_x, iImg->u.img.rect_valid.end_y - iImg->u.img.rect_valid.start_y,
+				iImg->buffer + (iImg->u.img.rect_valid.start_y*iImg->u.img.stride_in_bytes) + iImg->u.img.rect_valid.start_x, iImg->u.img.stride_in_bytes, (vx_coordinates2d_t *)node->localDataPtr, bandCount) :
+			HafCpu_MinMaxLoc_DATA_U8DATA_Loc_None_Count_MinMax(&node->paramList[0]->u.scalar.u.u, &node->paramList[1]->u.scalar.u.u, &finalMinValue, &finalMaxValue,
+				numDataPartitions, srcMinValue, srcMaxValue, iImg->u.img.rect_valid.end_x - iImg->u.img.rect_valid.start_x, iImg->u.img.rect_valid.end_y - iImg->u.img.rect_valid.start_y, 
+				iImg->buffer + (iImg->u.img.rect_valid.start_y*iImg->u.img.stride_in_bytes) + iImg->u.img.rect_valid.start_x, iImg->u.img.stride_in_bytes);
+		if (err)
 		{
 			status = VX_FAILURE;
 		}
@@ -18193,9 +18738,15 @@ int agoKernel_MinMaxLoc_DATA_U8DATA_Loc_Min_Count_Min(AgoNode * node, AgoKernelC
 		AgoData * iImg = node->paramList[2];
 		vx_int32 finalMinValue, finalMaxValue;
 		vx_uint32 minCount = 0;
-		if (HafCpu_MinMaxLoc_DATA_U8DATA_Loc_Min_Count_Min(&minCount, (vx_uint32)iMinLoc->u.arr.capacity, (vx_coordinates2d_t *)iMinLoc->buffer, &finalMinValue, &finalMaxValue,
-			numDataPartitions, srcMinValue, srcMaxValue, iImg->u.img.rect_valid.end_x - iImg->u.img.rect_valid.start_x, iImg->u.img.rect_valid.end_y - iImg->u.img.rect_valid.start_y, 
-			iImg->buffer + (iImg->u.img.rect_valid.start_y*iImg->u.img.stride_in_bytes) + iImg->u.img.rect_valid.start_x, iImg->u.img.stride_in_bytes))
+		vx_uint32 bandCount = min(HafCpu_GetThreadCount(), iImg->u.img.width * iImg->u.img.height / AGO_STATISTICS_MIN_PIXELS_PER_BAND);
+		int err = (bandCount > 1 && node->localDataPtr) ?
+			HafCpu_MinMaxLoc_DATA_U8DATA_Parallel(&minCount, nullptr, (vx_uint32)iMinLoc->u.arr.capacity, (vx_coordinates2d_t *)iMinLoc->buffer, 0, nullptr,
+				&finalMinValue, &finalMaxValue, numDataPartitions, srcMinValue, srcMaxValue, iImg->u.img.rect_valid.end_x - iImg->u.img.rect_valid.start_x, iImg->u.img.rect_valid.end_y - iImg->u.img.rect_valid.start_y,
+				iImg->buffer + (iImg->u.img.rect_valid.start_y*iImg->u.img.stride_in_bytes) + iImg->u.img.rect_valid.start_x, iImg->u.img.stride_in_bytes, (vx_coordinates2d_t *)node->localDataPtr, bandCount) :
+			HafCpu_MinMaxLoc_DATA_U8DATA_Loc_Min_Count_Min(&minCount, (vx_uint32)iMinLoc->u.arr.capacity, (vx_coordinates2d_t *)iMinLoc->buffer, &finalMinValue, &finalMaxValue,
+				numDataPartitions, srcMinValue, srcMaxValue, iImg->u.img.rect_valid.end_x - iImg->u.img.rect_valid.start_x, iImg->u.img.rect_valid.end_y - iImg->u.img.rect_valid.start_y, 
+				iImg->buffer + (iImg->u.img.rect_valid.start_y*iImg->u.img.stride_in_bytes) + iImg->u.img.rect_valid.start_x, iImg->u.img.stride_in_bytes);
+		if (err)
 		{
 			status = VX_FAILURE;
 		}
@@ -18219,7 +18770,14 @@ int agoKernel_MinMaxLoc_DATA_U8DATA_Loc_Min_Count_Min(AgoNode * node, AgoKernelC
 		meta = &node->metaList[1];
 		meta->data.u.scalar.type = VX_TYPE_UINT32;
 	}
-	else if (cmd == ago_kernel_cmd_initialize || cmd == ago_kernel_cmd_shutdown) {
+	else if (cmd == ago_kernel_cmd_initialize) {
+		// location lists of all but the first band for multi-threaded execution
+		if (HafCpu_GetThreadCount() > 1) {
+			node->localDataSize = (HafCpu_GetThreadCount() - 1) * node->paramList[0]->u.arr.capacity * sizeof(vx_coordinates2d_t);
+		}
+		status = VX_SUCCESS;
+	}
+	else if (cmd == ago_kernel_cmd_shutdown) {
 		status = VX_SUCCESS;
 	}
     else if (cmd == ago_kernel_cmd_query_target_support) {
@@ -18251,9 +18809,15 @@ int agoKernel_MinMaxLoc_DATA_U8DATA_Loc_Min_Count_MinMax(AgoNode * node, AgoKern
 		AgoData * iImg = node->paramList[3];
 		vx_int32 finalMinValue, finalMaxValue;
 		vx_uint32 minCount = 0, maxCount = 0;
-		if (HafCpu_MinMaxLoc_DATA_U8DATA_Loc_Min_Count_MinMax(&minCount, &maxCount, (vx_uint32)iMinLoc->u.arr.capacity, (vx_coordinates2d_t *)iMinLoc->buffer, &finalMinValue, &finalMaxValue,
-			numDataPartitions, srcMinValue, srcMaxValue, iImg->u.img.rect_valid.end_x - iImg->u.img.rect_valid.start_x, iImg->u.img.rect_valid.end_y - iImg->u.img.rect_valid.start_y, 
-			iImg->buffer + (iImg->u.img.rect_valid.start_y*iImg->u.img.stride_in_bytes) + iImg->u.img.rect_valid.start_x, iImg->u.img.stride_in_bytes))
+		vx_uint32 bandCount = min(HafCpu_GetThreadCount(), iImg->u.img.width * iImg->u.img.height / AGO_STATISTICS_MIN_PIXELS_PER_BAND);
+		int err = (bandCount > 1 && node->localDataPtr) ?
+			HafCpu_MinMaxLoc_DATA_U8DATA_Parallel(&minCount, &maxCount, (vx_uint32)iMinLoc->u.arr.capacity, (vx_coordinates2d_t *)iMinLoc->buffer, 0, nullptr,
+				&finalMinValue, &finalMaxValue, numDataPartitions, srcMinValue, srcMaxValue, iImg->u.img.rect_valid.end_x - iImg->u.img.rect_valid.start_x, iImg->u.img.rect_valid.end_y - iImg->u.img.rect_valid.start_y,
+				iImg->buffer + (iImg->u.img.rect_valid.start_y*iImg->u.img.stride_in_bytes) + iImg->u.img.rect_valid.start_x, iImg->u.img.stride_in_bytes, (vx_coordinates2d_t *)node->localDataPtr, bandCount) :
+			HafCpu_MinMaxLoc_DATA_U8DATA_Loc_Min_Count_MinMax(&minCount, &maxCount, (vx_uint32)iMinLoc->u.arr.capacity, (vx_coordinates2d_t *)iMinLoc->buffer, &finalMinValue, &finalMaxValue,
+				numDataPartitions, srcMinValue, srcMaxValue, iImg->u.img.rect_valid.end_x - iImg->u.img.rect_valid.start_x, iImg->u.img.rect_valid.end_y - iImg->u.img.rect_valid.start_y, 
+				iImg->buffer + (iImg->u.img.rect_valid.start_y*iImg->u.img.stride_in_bytes) + iImg->u.img.rect_valid.start_x, iImg->u.img.stride_in_bytes);
+		if (err)
 		{
 			status = VX_FAILURE;
 		}
@@ -18280,7 +18844,14 @@ int agoKernel_MinMaxLoc_DATA_U8DATA_Loc_Min_Count_MinMax(AgoNode * node, AgoKern
 		meta = &node->metaList[2];
 		meta->data.u.scalar.type = VX_TYPE_UINT32;
 	}
-	else if (cmd == ago_kernel_cmd_initialize || cmd == ago_kernel_cmd_shutdown) {
+	else if (cmd == ago_kernel_cmd_initialize) {
+		// location lists of all but the first band for multi-threaded execution
+		if (HafCpu_GetThreadCount() > 1) {
+			node->localDataSize = (HafCpu_GetThreadCount() - 1) * node->paramList[0]->u.arr.capacity * sizeof(vx_coordinates2d_t);
+		}
+		status = VX_SUCCESS;
+	}
+	else if (cmd == ago_kernel_cmd_shutdown) {
 		status = VX_SUCCESS;
 	}
     else if (cmd == ago_kernel_cmd_query_target_support) {
@@ -18311,9 +18882,15 @@ int agoKernel_MinMaxLoc_DATA_U8DATA_Loc_Max_Count_Max(AgoNode * node, AgoKernelC
 		AgoData * iImg = node->paramList[2];
 		vx_int32 finalMinValue, finalMaxValue;
 		vx_uint32 maxCount = 0;
-		if (HafCpu_MinMaxLoc_DATA_U8DATA_Loc_Max_Count_Max(&maxCount, (vx_uint32)iMaxLoc->u.arr.capacity, (vx_coordinates2d_t *)iMaxLoc->buffer, &finalMinValue, &finalMaxValue,
-			numDataPartitions, srcMinValue, srcMaxValue, iImg->u.img.rect_valid.end_x - iImg->u.img.rect_valid.start_x, iImg->u.img.rect_valid.end_y - iImg->u.img.rect_valid.start_y,
-			iImg->buffer + (iImg->u.img.rect_valid.start_y*iImg->u.img.stride_in_bytes) + iImg->u.img.rect_valid.start_x, iImg->u.img.stride_in_bytes))
+		vx_uint32 bandCount = min(HafCpu_GetThreadCount(), iImg->u.img.width * iImg->u.img.height / AGO_STATISTICS_MIN_PIXELS_PER_BAND);
+		int err = (bandCount > 1 && node->localDataPtr) ?
+			HafCpu_MinMaxLoc_DATA_U8DATA_Parallel(nullptr, &maxCount, 0, nullptr, (vx_uint32)iMaxLoc->u.arr.capacity, (vx_coordinates2d_t *)iMaxLoc->buffer,
+				&finalMinValue, &finalMaxValue, numDataPartitions, srcMinValue, srcMaxValue, iImg->u.img.rect_valid.end_x - iImg->u.img.rect_valid.start_x, iImg->u.img.rect_valid.end_y - iImg->u.img.rect_valid.start_y,
+				iImg->buffer + (iImg->u.img.rect_valid.start_y*iImg->u.img.stride_in_bytes) + iImg->u.img.rect_valid.start_x, iImg->u.img.stride_in_bytes, (vx_coordinates2d_t *)node->localDataPtr, bandCount) :
+			HafCpu_MinMaxLoc_DATA_U8DATA_Loc_Max_Count_Max(&maxCount, (vx_uint32)iMaxLoc->u.arr.capacity, (vx_coordinates2d_t *)iMaxLoc->buffer, &finalMinValue, &finalMaxValue,
+				numDataPartitions, srcMinValue, srcMaxValue, iImg->u.img.rect_valid.end_x - iImg->u.img.rect_valid.start_x, iImg->u.img.rect_valid.end_y - iImg->u.img.rect_valid.start_y,
+				iImg->buffer + (iImg->u.img.rect_valid.start_y*iImg->u.img.stride_in_bytes) + iImg->u.img.rect_valid.start_x, iImg->u.img.stride_in_bytes);
+		if (err)
 		{
 			status = VX_FAILURE;
 		}
@@ -18337,7 +18914,14 @@ int agoKernel_MinMaxLoc_DATA_U8DATA_Loc_Max_Count_Max(AgoNode * node, AgoKernelC
 		meta = &node->metaList[1];
 		meta->data.u.scalar.type = VX_TYPE_UINT32;
 	}
-	else if (cmd == ago_kernel_cmd_initialize || cmd == ago_kernel_cmd_shutdown) {
+	else if (cmd == ago_kernel_cmd_initialize) {
+		// location lists of all but the first band for multi-threaded execution
+		if (HafCpu_GetThreadCount() > 1) {
+			node->localDataSize = (HafCpu_GetThreadCount() - 1) * node->paramList[0]->u.arr.capacity * sizeof(vx_coordinates2d_t);
+		}
+		status = VX_SUCCESS;
+	}
+	else if (cmd == ago_kernel_cmd_shutdown) {
 		status = VX_SUCCESS;
 	}
     else if (cmd == ago_kernel_cmd_query_target_support) {
@@ -18369,9 +18953,15 @@ int agoKernel_MinMaxLoc_DATA_U8DATA_Loc_Max_Count_MinMax(AgoNode * node, AgoKern
 		AgoData * iImg = node->paramList[3];
 		vx_int32 finalMinValue, finalMaxValue;
 		vx_uint32 minCount = 0, maxCount = 0;
-		if (HafCpu_MinMaxLoc_DATA_U8DATA_Loc_Max_Count_MinMax(&minCount, &maxCount, (vx_uint32)iMaxLoc->u.arr.capacity, (vx_coordinates2d_t *)iMaxLoc->buffer, &finalMinValue, &finalMaxValue,
-			numDataPartitions, srcMinValue, srcMaxValue, iImg->u.img.rect_valid.end_x - iImg->u.img.rect_valid.start_x, iImg->u.img.rect_valid.end_y - iImg->u.img.rect_valid.start_y,
-			iImg->buffer + (iImg->u.img.rect_valid.start_y*iImg->u.img.stride_in_bytes) + iImg->u.img.rect_valid.start_x, iImg->u.img.stride_in_bytes))
+		vx_uint32 bandCount = min(HafCpu_GetThreadCount(), iImg->u.img.width * iImg->u.img.height / AGO_STATISTICS_MIN_PIXELS_PER_BAND);
+		int err = (bandCount > 1 && node->localDataPtr) ?
+			HafCpu_MinMaxLoc_DATA_U8DATA_Parallel(&minCount, &maxCount, 0, nullptr, (vx_uint32)iMaxLoc->u.arr.capacity, (vx_coordinates2d_t *)iMaxLoc->buffer,
+				&finalMinValue, &finalMaxValue, numDataPartitions, srcMinValue, srcMaxValue, iImg->u.img.rect_valid.end_x - iImg->u.img.rect_valid.start_x, iImg->u.img.rect_valid.end_y - iImg->u.img.rect_valid.start_y,
+				iImg->buffer + (iImg->u.img.rect_valid.start_y*iImg->u.img.stride_in_bytes) + iImg->u.img.rect_valid.start_x, iImg->u.img.stride_in_bytes, (vx_coordinates2d_t *)node->localDataPtr, bandCount) :
+			HafCpu_MinMaxLoc_DATA_U8DATA_Loc_Max_Count_MinMax(&minCount, &maxCount, (vx_uint32)iMaxLoc->u.arr.capacity, (vx_coordinates2d_t *)iMaxLoc->buffer, &finalMinValue, &finalMaxValue,
+				numDataPartitions, srcMinValue, srcMaxValue, iImg->u.img.rect_valid.end_x - iImg->u.img.rect_valid.start_x, iImg->u.img.rect_valid.end_y - iImg->u.img.rect_valid.start_y,
+				iImg->buffer + (iImg->u.img.rect_valid.start_y*iImg->u.img.stride_in_bytes) + iImg->u.img.rect_valid.start_x, iImg->u.img.stride_in_bytes);
+		if (err)
 		{
 			status = VX_FAILURE;
 		}
@@ -18398,7 +18988,14 @@ int agoKernel_MinMaxLoc_DATA_U8DATA_Loc_Max_Count_MinMax(AgoNode * node, AgoKern
 		meta = &node->metaList[2];
 		meta->data.u.scalar.type = VX_TYPE_UINT32;
 	}
-	else if (cmd == ago_kernel_cmd_initialize || cmd == ago_kernel_cmd_shutdown) {
+	else if (cmd == ago_kernel_cmd_initialize) {
+		// location lists of all but the first band for multi-threaded execution
+		if (HafCpu_GetThreadCount() > 1) {
+			node->localDataSize = (HafCpu_GetThreadCount() - 1) * node->paramList[0]->u.arr.capacity * sizeof(vx_coordinates2d_t);
+		}
+		status = VX_SUCCESS;
+	}
+	else if (cmd == ago_kernel_cmd_shutdown) {
 		status = VX_SUCCESS;
 	}
     else if (cmd == ago_kernel_cmd_query_target_support) {
@@ -18431,10 +19028,16 @@ int agoKernel_MinMaxLoc_DATA_U8DATA_Loc_MinMax_Count_MinMax(AgoNode * node, AgoK
 		AgoData * iImg = node->paramList[4];
 		vx_int32 finalMinValue, finalMaxValue;
 		vx_uint32 minCount = 0, maxCount = 0;
-		if (HafCpu_MinMaxLoc_DATA_U8DATA_Loc_MinMax_Count_MinMax(&minCount, &maxCount, (vx_uint32)iMinLoc->u.arr.capacity, (vx_coordinates2d_t *)iMinLoc->buffer,
-			(vx_uint32)iMaxLoc->u.arr.capacity, (vx_coordinates2d_t *)iMaxLoc->buffer, &finalMinValue, &finalMaxValue,
-			numDataPartitions, srcMinValue, srcMaxValue, iImg->u.img.rect_valid.end_x - iImg->u.img.rect_valid.start_x, iImg->u.img.rect_valid.end_y - iImg->u.img.rect_valid.start_y,
-			iImg->buffer + (iImg->u.img.rect_valid.start_y*iImg->u.img.stride_in_bytes) + iImg->u.img.rect_valid.start_x, iImg->u.img.stride_in_bytes))
+		vx_uint32 bandCount = min(HafCpu_GetThreadCount(), iImg->u.img.width * iImg->u.img.height / AGO_STATISTICS_MIN_PIXELS_PER_BAND);
+		int err = (bandCount > 1 && node->localDataPtr) ?
+			HafCpu_MinMaxLoc_DATA_U8DATA_Parallel(&minCount, &maxCount, (vx_uint32)iMinLoc->u.arr.capacity, (vx_coordinates2d_t *)iMinLoc->buffer, (vx_uint32)iMaxLoc->u.arr.capacity, (vx_coordinates2d_t *)iMaxLoc->buffer,
+				&finalMinValue, &finalMaxValue, numDataPartitions, srcMinValue, srcMaxValue, iImg->u.img.rect_valid.end_x - iImg->u.img.rect_valid.start_x, iImg->u.img.rect_valid.end_y - iImg->u.img.rect_valid.start_y,
+				iImg->buffer + (iImg->u.img.rect_valid.start_y*iImg->u.img.stride_in_bytes) + iImg->u.img.rect_valid.start_x, iImg->u.img.stride_in_bytes, (vx_coordinates2d_t *)node->localDataPtr, bandCount) :
+			HafCpu_MinMaxLoc_DATA_U8DATA_Loc_MinMax_Count_MinMax(&minCount, &maxCount, (vx_uint32)iMinLoc->u.arr.capacity, (vx_coordinates2d_t *)iMinLoc->buffer,
+				(vx_uint32)iMaxLoc->u.arr.capacity, (vx_coordinates2d_t *)iMaxLoc->buffer, &finalMinValue, &finalMaxValue,
+				numDataPartitions, srcMinValue, srcMaxValue, iImg->u.img.rect_valid.end_x - iImg->u.img.rect_valid.start_x, iImg->u.img.rect_valid.end_y - iImg->u.img.rect_valid.start_y,
+				iImg->buffer + (iImg->u.img.rect_valid.start_y*iImg->u.img.stride_in_bytes) + iImg->u.img.rect_valid.start_x, iImg->u.img.stride_in_bytes);
+		if (err)
 		{
 			status = VX_FAILURE;
 		}
@@ -18464,7 +19067,14 @@ int agoKernel_MinMaxLoc_DATA_U8DATA_Loc_MinMax_Count_MinMax(AgoNode * node, AgoK
 		meta = &node->metaList[3];
 		meta->data.u.scalar.type = VX_TYPE_UINT32;
 	}
-	else if (cmd == ago_kernel_cmd_initialize || cmd == ago_kernel_cmd_shutdown) {
+	else if (cmd == ago_kernel_cmd_initialize) {
+		// location lists of all but the first band for multi-threaded execution
+		if (HafCpu_GetThreadCount() > 1) {
+			node->localDataSize = (HafCpu_GetThreadCount() - 1) * (node->paramList[0]->u.arr.capacity + node->paramList[1]->u.arr.capacity) * sizeof(vx_coordinates2d_t);
+		}
+		status = VX_SUCCESS;
+	}
+	else if (cmd == ago_kernel_cmd_shutdown) {
 		status = VX_SUCCESS;
 	}
     else if (cmd == ago_kernel_cmd_query_target_support) {
@@ -18492,9 +19102,15 @@ int agoKernel_MinMaxLoc_DATA_S16DATA_Loc_None_Count_Min(AgoNode * node, AgoKerne
 		}
 		AgoData * iImg = node->paramList[1];
 		vx_int32 finalMinValue, finalMaxValue;
-		if (HafCpu_MinMaxLoc_DATA_S16DATA_Loc_None_Count_Min(&node->paramList[0]->u.scalar.u.u, &finalMinValue, &finalMaxValue,
-			numDataPartitions, srcMinValue, srcMaxValue, iImg->u.img.rect_valid.end_x - iImg->u.img.rect_valid.start_x, iImg->u.img.rect_valid.end_y - iImg->u.img.rect_valid.start_y,
-			(vx_int16 *)(iImg->buffer + (iImg->u.img.rect_valid.start_y*iImg->u.img.stride_in_bytes)) + iImg->u.img.rect_valid.start_x, iImg->u.img.stride_in_bytes))
+		vx_uint32 bandCount = min(HafCpu_GetThreadCount(), iImg->u.img.width * iImg->u.img.height / AGO_STATISTICS_MIN_PIXELS_PER_BAND);
+		int err = (bandCount > 1) ?
+			HafCpu_MinMaxLoc_DATA_S16DATA_Parallel(&node->paramList[0]->u.scalar.u.u, nullptr, 0, nullptr, 0, nullptr,
+				&finalMinValue, &finalMaxValue, numDataPartitions, srcMinValue, srcMaxValue, iImg->u.img.rect_valid.end_x - iImg->u.img.rect_valid.start_x, iImg->u.img.rect_valid.end_y - iImg->u.img.rect_valid.start_y,
+				(vx_int16 *)(iImg->buffer + (iImg->u.img.rect_valid.start_y*iImg->u.img.stride_in_bytes)) + iImg->u.img.rect_valid.start_x, iImg->u.img.stride_in_bytes, (vx_coordinates2d_t *)node->localDataPtr, bandCount) :
+			HafCpu_MinMaxLoc_DATA_S16DATA_Loc_None_Count_Min(&node->paramList[0]->u.scalar.u.u, &finalMinValue, &finalMaxValue,
+				numDataPartitions, srcMinValue, srcMaxValue, iImg->u.img.rect_valid.end_x - iImg->u.img.rect_valid.start_x, iImg->u.img.rect_valid.end_y - iImg->u.img.rect_valid.start_y,
+				(vx_int16 *)(iImg->buffer + (iImg->u.img.rect_valid.start_y*iImg->u.img.stride_in_bytes)) + iImg->u.img.rect_valid.start_x, iImg->u.img.stride_in_bytes);
+		if (err)
 		{
 			status = VX_FAILURE;
 		}
@@ -18539,9 +19155,15 @@ int agoKernel_MinMaxLoc_DATA_S16DATA_Loc_None_Count_Max(AgoNode * node, AgoKerne
 		}
 		AgoData * iImg = node->paramList[1];
 		vx_int32 finalMinValue, finalMaxValue;
-		if (HafCpu_MinMaxLoc_DATA_S16DATA_Loc_None_Count_Max(&node->paramList[0]->u.scalar.u.u, &finalMinValue, &finalMaxValue,
-			numDataPartitions, srcMinValue, srcMaxValue, iImg->u.img.rect_valid.end_x - iImg->u.img.rect_valid.start_x, iImg->u.img.rect_valid.end_y - iImg->u.img.rect_valid.start_y,
-			(vx_int16 *)(iImg->buffer + (iImg->u.img.rect_valid.start_y*iImg->u.img.stride_in_bytes)) + iImg->u.img.rect_valid.start_x, iImg->u.img.stride_in_bytes))
+		vx_uint32 bandCount = min(HafCpu_GetThreadCount(), iImg->u.img.width * iImg->u.img.height / AGO_STATISTICS_MIN_PIXELS_PER_BAND);
+		int err = (bandCount > 1) ?
+			HafCpu_MinMaxLoc_DATA_S16DATA_Parallel(nullptr, &node->paramList[0]->u.scalar.u.u, 0, nullptr, 0, nullptr,
+				&finalMinValue, &finalMaxValue, numDataPartitions, srcMinValue, srcMaxValue, iImg->u.img.rect_valid.end_x - iImg->u.img.rect_valid.start_x, iImg->u.img.rect_valid.end_y - iImg->u.img.rect_valid.start_y,
+				(vx_int16 *)(iImg->buffer + (iImg->u.img.rect_valid.start_y*iImg->u.img.stride_in_bytes)) + iImg->u.img.rect_valid.start_x, iImg->u.img.stride_in_bytes, (vx_coordinates2d_t *)node->localDataPtr, bandCount) :
+			HafCpu_MinMaxLoc_DATA_S16DATA_Loc_None_Count_Max(&node->paramList[0]->u.scalar.u.u, &finalMinValue, &finalMaxValue,
+				numDataPartitions, srcMinValue, srcMaxValue, iImg->u.img.rect_valid.end_x - iImg->u.img.rect_valid.start_x, iImg->u.img.rect_valid.end_y - iImg->u.img.rect_valid.start_y,
+				(vx_int16 *)(iImg->buffer + (iImg->u.img.rect_valid.start_y*iImg->u.img.stride_in_bytes)) + iImg->u.img.rect_valid.start_x, iImg->u.img.stride_in_bytes);
+		if (err)
 		{
 			status = VX_FAILURE;
 		}
@@ -18586,9 +19208,15 @@ int agoKernel_MinMaxLoc_DATA_S16DATA_Loc_None_Count_MinMax(AgoNode * node, AgoKe
 		}
 		AgoData * iImg = node->paramList[2];
 		vx_int32 finalMinValue, finalMaxValue;
-		if (HafCpu_MinMaxLoc_DATA_S16DATA_Loc_None_Count_MinMax(&node->paramList[0]->u.scalar.u.u, &node->paramList[1]->u.scalar.u.u, &finalMinValue, &finalMaxValue,
-			numDataPartitions, srcMinValue, srcMaxValue, iImg->u.img.rect_valid.end_x - iImg->u.img.rect_valid.start_x, iImg->u.img.rect_valid.end_y - iImg->u.img.rect_valid.start_y,
-			(vx_int16 *)(iImg->buffer + (iImg->u.img.rect_valid.start_y*iImg->u.img.stride_in_bytes)) + iImg->u.img.rect_valid.start_x, iImg->u.img.stride_in_bytes))
+		vx_uint32 bandCount = min(HafCpu_GetThreadCount(), iImg->u.img.width * iImg->u.img.height / AGO_STATISTICS_MIN_PIXELS_PER_BAND);
+		int err = (bandCount > 1) ?
+			HafCpu_MinMaxLoc_DATA_S16DATA_Parallel(&node->paramList[0]->u.scalar.u.u, &node->paramList[1]->u.scalar.u.u, 0, nullptr, 0, nullptr,
+				&finalMinValue, &finalMaxValue, numDataPartitions, srcMinValue, srcMaxValue, iImg->u.img.rect_valid.end_x - iImg->u.img.rect_valid.start_x, iImg->u.img.rect_valid.end_y - iImg->u.img.rect_valid.start_y,
+				(vx_int16 *)(iImg->buffer + (iImg->u.img.rect_valid.start_y*iImg->u.img.stride_in_bytes)) + iImg->u.img.rect_valid.start_x, iImg->u.img.stride_in_bytes, (vx_coordinates2d_t *)node->localDataPtr, bandCount) :
+			HafCpu_MinMaxLoc_DATA_S16DATA_Loc_None_Count_MinMax(&node->paramList[0]->u.scalar.u.u, &node->paramList[1]->u.scalar.u.u, &finalMinValue, &finalMaxValue,
+				numDataPartitions, srcMinValue, srcMaxValue, iImg->u.img.rect_valid.end_x - iImg->u.img.rect_valid.start_x, iImg->u.img.rect_valid.end_y - iImg->u.img.rect_valid.start_y,
+				(vx_int16 *)(iImg->buffer + (iImg->u.img.rect_valid.start_y*iImg->u.img.stride_in_bytes)) + iImg->u.img.rect_valid.start_x, iImg->u.img.stride_in_bytes);
+		if (err)
 		{
 			status = VX_FAILURE;
 		}
@@ -18638,9 +19266,15 @@ int agoKernel_MinMaxLoc_DATA_S16DATA_Loc_Min_Count_Min(AgoNode * node, AgoKernel
 		AgoData * iImg = node->paramList[2];
 		vx_int32 finalMinValue, finalMaxValue;
 		vx_uint32 minCount = 0;
-		if (HafCpu_MinMaxLoc_DATA_S16DATA_Loc_Min_Count_Min(&minCount, (vx_uint32)iMinLoc->u.arr.capacity, (vx_coordinates2d_t *)iMinLoc->buffer, &finalMinValue, &finalMaxValue,
-			numDataPartitions, srcMinValue, srcMaxValue, iImg->u.img.rect_valid.end_x - iImg->u.img.rect_valid.start_x, iImg->u.img.rect_valid.end_y - iImg->u.img.rect_valid.start_y,
-			(vx_int16 *)(iImg->buffer + (iImg->u.img.rect_valid.start_y*iImg->u.img.stride_in_bytes)) + iImg->u.img.rect_valid.start_x, iImg->u.img.stride_in_bytes))
+		vx_uint32 bandCount = min(HafCpu_GetThreadCount(), iImg->u.img.width * iImg->u.img.height / AGO_STATISTICS_MIN_PIXELS_PER_BAND);
+		int err = (bandCount > 1 && node->localDataPtr) ?
+			HafCpu_MinMaxLoc_DATA_S16DATA_Parallel(&minCount, nullptr, (vx_uint32)iMinLoc->u.arr.capacity, (vx_coordinates2d_t *)iMinLoc->buffer, 0, nullptr,
+				&finalMinValue, &finalMaxValue, numDataPartitions, srcMinValue, srcMaxValue, iImg->u.img.rect_valid.end_x - iImg->u.img.rect_valid.start_x, iImg->u.img.rect_valid.end_y - iImg->u.img.rect_valid.start_y,
+				(vx_int16 *)(iImg->buffer + (iImg->u.img.rect_valid.start_y*iImg->u.img.stride_in_bytes)) + iImg->u.img.rect_valid.start_x, iImg->u.img.stride_in_bytes, (vx_coordinates2d_t *)node->localDataPtr, bandCount) :
+			HafCpu_MinMaxLoc_DATA_S16DATA_Loc_Min_Count_Min(&minCount, (vx_uint32)iMinLoc->u.arr.capacity, (vx_coordinates2d_t *)iMinLoc->buffer, &finalMinValue, &finalMaxValue,
+				numDataPartitions, srcMinValue, srcMaxValue, iImg->u.img.rect_valid.end_x - iImg->u.img.rect_valid.start_x, iImg->u.img.rect_valid.end_y - iImg->u.img.rect_valid.start_y,
+				(vx_int16 *)(iImg->buffer + (iImg->u.img.rect_valid.start_y*iImg->u.img.stride_in_bytes)) + iImg->u.img.rect_valid.start_x, iImg->u.img.stride_in_bytes);
+		if (err)
 		{
 			status = VX_FAILURE;
 		}
@@ -18664,7 +19298,14 @@ int agoKernel_MinMaxLoc_DATA_S16DATA_Loc_Min_Count_Min(AgoNode * node, AgoKernel
 		meta = &node->metaList[1];
 		meta->data.u.scalar.type = VX_TYPE_UINT32;
 	}
-	else if (cmd == ago_kernel_cmd_initialize || cmd == ago_kernel_cmd_shutdown) {
+	else if (cmd == ago_kernel_cmd_initialize) {
+		// location lists of all but the first band for multi-threaded execution
+		if (HafCpu_GetThreadCount() > 1) {
+			node->localDataSize = (HafCpu_GetThreadCount() - 1) * node->paramList[0]->u.arr.capacity * sizeof(vx_coordinates2d_t);
+		}
+		status = VX_SUCCESS;
+	}
+	else if (cmd == ago_kernel_cmd_shutdown) {
 		status = VX_SUCCESS;
 	}
     else if (cmd == ago_kernel_cmd_query_target_support) {
@@ -18696,9 +19337,15 @@ int agoKernel_MinMaxLoc_DATA_S16DATA_Loc_Min_Count_MinMax(AgoNode * node, AgoKer
 		AgoData * iImg = node->paramList[3];
 		vx_int32 finalMinValue, finalMaxValue;
 		vx_uint32 minCount = 0, maxCount = 0;
-		if (HafCpu_MinMaxLoc_DATA_S16DATA_Loc_Min_Count_MinMax(&minCount, &maxCount, (vx_uint32)iMinLoc->u.arr.capacity, (vx_coordinates2d_t *)iMinLoc->buffer, &finalMinValue, &finalMaxValue,
-			numDataPartitions, srcMinValue, srcMaxValue, iImg->u.img.rect_valid.end_x - iImg->u.img.rect_valid.start_x, iImg->u.img.rect_valid.end_y - iImg->u.img.rect_valid.start_y,
-			(vx_int16 *)(iImg->buffer + (iImg->u.img.rect_valid.start_y*iImg->u.img.stride_in_bytes)) + iImg->u.img.rect_valid.start_x, iImg->u.img.stride_in_bytes))
+		vx_uint32 bandCount = min(HafCpu_GetThreadCount(), iImg->u.img.width * iImg->u.img.height / AGO_STATISTICS_MIN_PIXELS_PER_BAND);
+		int err = (bandCount > 1 && node->localDataPtr) ?
+			HafCpu_MinMaxLoc_DATA_S16DATA_Parallel(&minCount, &maxCount, (vx_uint32)iMinLoc->u.arr.capacity, (vx_coordinates2d_t *)iMinLoc->buffer, 0, nullptr,
+				&finalMinValue, &finalMaxValue, numDataPartitions, srcMinValue, srcMaxValue, iImg->u.img.rect_valid.end_x - iImg->u.img.rect_valid.start_x, iImg->u.img.rect_valid.end_y - iImg->u.img.rect_valid.start_y,
+				(vx_int16 *)(iImg->buffer + (iImg->u.img.rect_valid.start_y*iImg->u.img.stride_in_bytes)) + iImg->u.img.rect_valid.start_x, iImg->u.img.stride_in_bytes, (vx_coordinates2d_t *)node->localDataPtr, bandCount) :
+			HafCpu_MinMaxLoc_DATA_S16DATA_Loc_Min_Count_MinMax(&minCount, &maxCount, (vx_uint32)iMinLoc->u.arr.capacity, (vx_coordinates2d_t *)iMinLoc->buffer, &finalMinValue, &finalMaxValue,
+				numDataPartitions, srcMinValue, srcMaxValue, iImg->u.img.rect_valid.end_x - iImg->u.img.rect_valid.start_x, iImg->u.img.rect_valid.end_y - iImg->u.img.rect_valid.start_y,
+				(vx_int16 *)(iImg->buffer + (iImg->u.img.rect_valid.start_y*iImg->u.img.stride_in_bytes)) + iImg->u.img.rect_valid.start_x, iImg->u.img.stride_in_bytes);
+		if (err)
 		{
 			status = VX_FAILURE;
 		}
@@ -18725,7 +19372,14 @@ int agoKernel_MinMaxLoc_DATA_S16DATA_Loc_Min_Count_MinMax(AgoNode * node, AgoKer
 		meta = &node->metaList[2];
 		meta->data.u.scalar.type = VX_TYPE_UINT32;
 	}
-	else if (cmd == ago_kernel_cmd_initialize || cmd == ago_kernel_cmd_shutdown) {
+	else if (cmd == ago_kernel_cmd_initialize) {
+		// location lists of all but the first band for multi-threaded execution
+		if (HafCpu_GetThreadCount() > 1) {
+			node->localDataSize = (HafCpu_GetThreadCount() - 1) * node->paramList[0]->u.arr.capacity * sizeof(vx_coordinates2d_t);
+		}
+		status = VX_SUCCESS;
+	}
+	else if (cmd == ago_kernel_cmd_shutdown) {
 		status = VX_SUCCESS;
 	}
     else if (cmd == ago_kernel_cmd_query_target_support) {
@@ -18756,9 +19410,15 @@ int agoKernel_MinMaxLoc_DATA_S16DATA_Loc_Max_Count_Max(AgoNode * node, AgoKernel
 		AgoData * iImg = node->paramList[2];
 		vx_int32 finalMinValue, finalMaxValue;
 		vx_uint32 maxCount = 0;
-		if (HafCpu_MinMaxLoc_DATA_S16DATA_Loc_Max_Count_Max(&maxCount, (vx_uint32)iMaxLoc->u.arr.capacity, (vx_coordinates2d_t *)iMaxLoc->buffer, &finalMinValue, &finalMaxValue,
-			numDataPartitions, srcMinValue, srcMaxValue, iImg->u.img.rect_valid.end_x - iImg->u.img.rect_valid.start_x, iImg->u.img.rect_valid.end_y - iImg->u.img.rect_valid.start_y,
-			(vx_int16 *)(iImg->buffer + (iImg->u.img.rect_valid.start_y*iImg->u.img.stride_in_bytes)) + iImg->u.img.rect_valid.start_x, iImg->u.img.stride_in_bytes))
+		vx_uint32 bandCount = min(HafCpu_GetThreadCount(), iImg->u.img.width * iImg->u.img.height / AGO_STATISTICS_MIN_PIXELS_PER_BAND);
+		int err = (bandCount > 1 && node->localDataPtr) ?
+			HafCpu_MinMaxLoc_DATA_S16DATA_Parallel(nullptr, &maxCount, 0, nullptr, (vx_uint32)iMaxLoc->u.arr.capacity, (vx_coordinates2d_t *)iMaxLoc->buffer,
+				&finalMinValue, &finalMaxValue, numDataPartitions, srcMinValue, srcMaxValue, iImg->u.img.rect_valid.end_x - iImg->u.img.rect_valid.start_x, iImg->u.img.rect_valid.end_y - iImg->u.img.rect_valid.start_y,
+				(vx_int16 *)(iImg->buffer + (iImg->u.img.rect_valid.start_y*iImg->u.img.stride_in_bytes)) + iImg->u.img.rect_valid.start_x, iImg->u.img.stride_in_bytes, (vx_coordinates2d_t *)node->localDataPtr, bandCount) :
+			HafCpu_MinMaxLoc_DATA_S16DATA_Loc_Max_Count_Max(&maxCount, (vx_uint32)iMaxLoc->u.arr.capacity, (vx_coordinates2d_t *)iMaxLoc->buffer, &finalMinValue, &finalMaxValue,
+				numDataPartitions, srcMinValue, srcMaxValue, iImg->u.img.rect_valid.end_x - iImg->u.img.rect_valid.start_x, iImg->u.img.rect_valid.end_y - iImg->u.img.rect_valid.start_y,
+				(vx_int16 *)(iImg->buffer + (iImg->u.img.rect_valid.start_y*iImg->u.img.stride_in_bytes)) + iImg->u.img.rect_valid.start_x, iImg->u.img.stride_in_bytes);
+		if (err)
 		{
 			status = VX_FAILURE;
 		}
@@ -18782,7 +19442,14 @@ int agoKernel_MinMaxLoc_DATA_S16DATA_Loc_Max_Count_Max(AgoNode * node, AgoKernel
 		meta = &node->metaList[1];
 		meta->data.u.scalar.type = VX_TYPE_UINT32;
 	}
-	else if (cmd == ago_kernel_cmd_initialize || cmd == ago_kernel_cmd_shutdown) {
+	else if (cmd == ago_kernel_cmd_initialize) {
+		// location lists of all but the first band for multi-threaded execution
+		if (HafCpu_GetThreadCount() > 1) {
+			node->localDataSize = (HafCpu_GetThreadCount() - 1) * node->paramList[0]->u.arr.capacity * sizeof(vx_coordinates2d_t);
+		}
+		status = VX_SUCCESS;
+	}
+	else if (cmd == ago_kernel_cmd_shutdown) {
 		status = VX_SUCCESS;
 	}
     else if (cmd == ago_kernel_cmd_query_target_support) {
@@ -18814,9 +19481,15 @@ int agoKernel_MinMaxLoc_DATA_S16DATA_Loc_Max_Count_MinMax(AgoNode * node, AgoKer
 		AgoData * iImg = node->paramList[3];
 		vx_int32 finalMinValue, finalMaxValue;
 		vx_uint32 minCount = 0, maxCount = 0;
-		if (HafCpu_MinMaxLoc_DATA_S16DATA_Loc_Max_Count_MinMax(&minCount, &maxCount, (vx_uint32)iMaxLoc->u.arr.capacity, (vx_coordinates2d_t *)iMaxLoc->buffer, &finalMinValue, &finalMaxValue,
-			numDataPartitions, srcMinValue, srcMaxValue, iImg->u.img.rect_valid.end_x - iImg->u.img.rect_valid.start_x, iImg->u.img.rect_valid.end_y - iImg->u.img.rect_valid.start_y,
-			(vx_int16 *)(iImg->buffer + (iImg->u.img.rect_valid.start_y*iImg->u.img.stride_in_bytes)) + iImg->u.img.rect_valid.start_x, iImg->u.img.stride_in_bytes))
+		vx_uint32 bandCount = min(HafCpu_GetThreadCount(), iImg->u.img.width * iImg->u.img.height / AGO_STATISTICS_MIN_PIXELS_PER_BAND);
+		int err = (bandCount > 1 && node->localDataPtr) ?
+			HafCpu_MinMaxLoc_DATA_S16DATA_Parallel(&minCount, &maxCount, 0, nullptr, (vx_uint32)iMaxLoc->u.arr.capacity, (vx_coordinates2d_t *)iMaxLoc->buffer,
+				&finalMinValue, &finalMaxValue, numDataPartitions, srcMinValue, srcMaxValue, iImg->u.img.rect_valid.end_x - iImg->u.img.rect_valid.start_x, iImg->u.img.rect_valid.end_y - iImg->u.img.rect_valid.start_y,
+				(vx_int16 *)(iImg->buffer + (iImg->u.img.rect_valid.start_y*iImg->u.img.stride_in_bytes)) + iImg->u.img.rect_valid.start_x, iImg->u.img.stride_in_bytes, (vx_coordinates2d_t *)node->localDataPtr, bandCount) :
+			HafCpu_MinMaxLoc_DATA_S16DATA_Loc_Max_Count_MinMax(&minCount, &maxCount, (vx_uint32)iMaxLoc->u.arr.capacity, (vx_coordinates2d_t *)iMaxLoc->buffer, &finalMinValue, &finalMaxValue,
+				numDataPartitions, srcMinValue, srcMaxValue, iImg->u.img.rect_valid.end_x - iImg->u.img.rect_valid.start_x, iImg->u.img.rect_valid.end_y - iImg->u.img.rect_valid.start_y,
+				(vx_int16 *)(iImg->buffer + (iImg->u.img.rect_valid.start_y*iImg->u.img.stride_in_bytes)) + iImg->u.img.rect_valid.start_x, iImg->u.img.stride_in_bytes);
+		if (err)
 		{
 			status = VX_FAILURE;
 		}
@@ -18843,7 +19516,14 @@ int agoKernel_MinMaxLoc_DATA_S16DATA_Loc_Max_Count_MinMax(AgoNode * node, AgoKer
 		meta = &node->metaList[2];
 		meta->data.u.scalar.type = VX_TYPE_UINT32;
 	}
-	else if (cmd == ago_kernel_cmd_initialize || cmd == ago_kernel_cmd_shutdown) {
+	else if (cmd == ago_kernel_cmd_initialize) {
+		// location lists of all but the first band for multi-threaded execution
+		if (HafCpu_GetThreadCount() > 1) {
+			node->localDataSize = (HafCpu_GetThreadCount() - 1) * node->paramList[0]->u.arr.capacity * sizeof(vx_coordinates2d_t);
+		}
+		status = VX_SUCCESS;
+	}
+	else if (cmd == ago_kernel_cmd_shutdown) {
 		status = VX_SUCCESS;
 	}
     else if (cmd == ago_kernel_cmd_query_target_support) {
@@ -18876,10 +19556,16 @@ int agoKernel_MinMaxLoc_DATA_S16DATA_Loc_MinMax_Count_MinMax(AgoNode * node, Ago
 		AgoData * iImg = node->paramList[4];
 		vx_int32 finalMinValue, finalMaxValue;
 		vx_uint32 minCount = 0, maxCount = 0;
-		if (HafCpu_MinMaxLoc_DATA_S16DATA_Loc_MinMax_Count_MinMax(&minCount, &maxCount, (vx_uint32)iMinLoc->u.arr.capacity, (vx_coordinates2d_t *)iMinLoc->buffer,
-			(vx_uint32)iMaxLoc->u.arr.capacity, (vx_coordinates2d_t *)iMaxLoc->buffer, &finalMinValue, &finalMaxValue,
-			numDataPartitions, srcMinValue, srcMaxValue, iImg->u.img.rect_valid.end_x - iImg->u.img.rect_valid.start_x, iImg->u.img.rect_valid.end_y - iImg->u.img.rect_valid.start_y,
-			(vx_int16 *)(iImg->buffer + (iImg->u.img.rect_valid.start_y*iImg->u.img.stride_in_bytes)) + iImg->u.img.rect_valid.start_x, iImg->u.img.stride_in_bytes))
+		vx_uint32 bandCount = min(HafCpu_GetThreadCount(), iImg->u.img.width * iImg->u.img.height / AGO_STATISTICS_MIN_PIXELS_PER_BAND);
+		int err = (bandCount > 1 && node->localDataPtr) ?
+			HafCpu_MinMaxLoc_DATA_S16DATA_Parallel(&minCount, &maxCount, (vx_uint32)iMinLoc->u.arr.capacity, (vx_coordinates2d_t *)iMinLoc->buffer, (vx_uint32)iMaxLoc->u.arr.capacity, (vx_coordinates2d_t *)iMaxLoc->buffer,
+				&finalMinValue, &finalMaxValue, numDataPartitions, srcMinValue, srcMaxValue, iImg->u.img.rect_valid.end_x - iImg->u.img.rect_valid.start_x, iImg->u.img.rect_valid.end_y - iImg->u.img.rect_valid.start_y,
+				(vx_int16 *)(iImg->buffer + (iImg->u.img.rect_valid.start_y*iImg->u.img.stride_in_bytes)) + iImg->u.img.rect_valid.start_x, iImg->u.img.stride_in_bytes, (vx_coordinates2d_t *)node->localDataPtr, bandCount) :
+			HafCpu_MinMaxLoc_DATA_S16DATA_Loc_MinMax_Count_MinMax(&minCount, &maxCount, (vx_uint32)iMinLoc->u.arr.capacity, (vx_coordinates2d_t *)iMinLoc->buffer,
+				(vx_uint32)iMaxLoc->u.arr.capacity, (vx_coordinates2d_t *)iMaxLoc->buffer, &finalMinValue, &finalMaxValue,
+				numDataPartitions, srcMinValue, srcMaxValue, iImg->u.img.rect_valid.end_x - iImg->u.img.rect_valid.start_x, iImg->u.img.rect_valid.end_y - iImg->u.img.rect_valid.start_y,
+				(vx_int16 *)(iImg->buffer + (iImg->u.img.rect_valid.start_y*iImg->u.img.stride_in_bytes)) + iImg->u.img.rect_valid.start_x, iImg->u.img.stride_in_bytes);
+		if (err)
 		{
 			status = VX_FAILURE;
 		}
@@ -18909,7 +19595,14 @@ int agoKernel_MinMaxLoc_DATA_S16DATA_Loc_MinMax_Count_MinMax(AgoNode * node, Ago
 		meta = &node->metaList[3];
 		meta->data.u.scalar.type = VX_TYPE_UINT32;
 	}
-	else if (cmd == ago_kernel_cmd_initialize || cmd == ago_kernel_cmd_shutdown) {
+	else if (cmd == ago_kernel_cmd_initialize) {
+		// location lists of all but the first band for multi-threaded execution
+		if (HafCpu_GetThreadCount() > 1) {
+			node->localDataSize = (HafCpu_GetThreadCount() - 1) * (node->paramList[0]->u.arr.capacity + node->paramList[1]->u.arr.capacity) * sizeof(vx_coordinates2d_t);
+		}
+		status = VX_SUCCESS;
+	}
+	else if (cmd == ago_kernel_cmd_shutdown) {
 		status = VX_SUCCESS;
 	}
     else if (cmd == ago_kernel_cmd_query_target_support) {
@@ -19072,3 +19765,150 @@ int agoKernel_Select_DATA_DATA_DATA(AgoNode * node, AgoKernelCommand cmd)
 	}
 	return status;
 }
+
+static vx_uint32 FusedElemwise_StripHeight(AgoNode * node)
+{
+	// pick strip height so that a strip of every image in the fused nodes stays in cache
+	vx_uint32 maxStride = 1;
+	for (AgoNode * anode : node->fusedNodeList) {
+		for (vx_uint32 arg = 0; arg < anode->paramCount; arg++) {
+			AgoData * data = anode->paramList[arg];
+			if (data && data->ref.type == VX_TYPE_IMAGE)
+				maxStride = max(maxStride, data->u.img.stride_in_bytes);
+		}
+	}
+	vx_uint32 stripSize = node->strip_size ? node->strip_size : (vx_uint32)AGO_ELEMWISE_FUSION_STRIP_SIZE;
+	return max(1u, stripSize / maxStride);
+}
+
+static vx_size FusedElemwise_StripBufferSize(AgoData * data, vx_uint32 stripHeight)
+{
+	return ALIGN32((vx_size)data->u.img.stride_in_bytes * stripHeight + AGO_MEMORY_ALLOC_EXTRA_PADDING);
+}
+
+static bool FusedElemwise_IsIntermediate(AgoNode * node, AgoData * data)
+{
+	for (size_t i = 0; i < node->fusedNodeList.size() - 1; i++) {
+		if (node->fusedNodeList[i]->paramList[0] == data)
+			return true;
+	}
+	return false;
+}
+
+int agoKernel_FusedElemwise_ANY_ANY(AgoNode * node, AgoKernelCommand cmd)
+{
+	// node->fusedNodeList[] has element-wise nodes in execution order: outputs of all but the last
+	// node are virtual images only used within this node, which get replaced with strip buffers
+	vx_status status = AGO_ERROR_KERNEL_NOT_IMPLEMENTED;
+	if (cmd == ago_kernel_cmd_execute) {
+		status = VX_SUCCESS;
+		AgoData * oImg = node->paramList[0];
+		// compute only the rows in node->rect_exec when consumers read a part of the output
+		vx_uint32 ystart = node->rect_exec_partial ? node->rect_exec.start_y : 0;
+		vx_uint32 height = node->rect_exec_partial ? node->rect_exec.end_y : oImg->u.img.height;
+		vx_uint32 stripHeight = FusedElemwise_StripHeight(node);
+		size_t count = node->fusedNodeList.size();
+		// point intermediate images to strip buffers
+		vx_uint8 * pStrip = node->localDataPtr;
+		for (size_t i = 0; i < count - 1; i++) {
+			AgoData * data = node->fusedNodeList[i]->paramList[0];
+			data->buffer = pStrip;
+			pStrip += FusedElemwise_StripBufferSize(data, stripHeight);
+		}
+		// run all the fused nodes on one strip of rows at a time using image views,
+		// so that images shared with other graphs never get modified
+		for (vx_uint32 y = ystart; y < height && status == VX_SUCCESS; y += stripHeight) {
+			vx_uint32 rows = min(stripHeight, height - y);
+			size_t view = 0;
+			for (size_t i = 0; i < count; i++) {
+				AgoNode * anode = node->fusedNodeList[i];
+				AgoData * paramList[AGO_MAX_PARAMS];
+				memcpy(paramList, anode->paramList, sizeof(paramList));
+				for (vx_uint32 arg = 0; arg < anode->paramCount; arg++) {
+					AgoData * data = paramList[arg];
+					if (data && data->ref.type == VX_TYPE_IMAGE) {
+						AgoData * dataView = node->fusedViewList[view++];
+						dataView->u.img = data->u.img;
+						dataView->u.img.height = rows;
+						// intermediate images always use the start of their strip buffers
+						dataView->buffer = data->buffer + (FusedElemwise_IsIntermediate(node, data) ? 0 : (size_t)y * data->u.img.stride_in_bytes);
+						anode->paramList[arg] = dataView;
+					}
+				}
+				if (anode->akernel->func(anode, ago_kernel_cmd_execute)) {
+					status = VX_FAILURE;
+				}
+				memcpy(anode->paramList, paramList, sizeof(paramList));
+				if (status != VX_SUCCESS)
+					break;
+			}
+		}
+		for (size_t i = 0; i < count - 1; i++) {
+			node->fusedNodeList[i]->paramList[0]->buffer = nullptr;
+		}
+	}
+	else if (cmd == ago_kernel_cmd_validate) {
+		// re-validate the fused nodes and use the output meta data of the last one
+		if (node->fusedNodeList.empty())
+			return VX_ERROR_INVALID_NODE;
+		for (AgoNode * anode : node->fusedNodeList) {
+			status = agoVerifyNode(anode);
+			if (status)
+				return status;
+		}
+		vx_meta_format meta = &node->metaList[0];
+		AgoMetaFormat * metaLast = &node->fusedNodeList.back()->metaList[0];
+		meta->data.u.img.format = metaLast->data.u.img.format;
+		meta->data.u.img.width = metaLast->data.u.img.width;
+		meta->data.u.img.height = metaLast->data.u.img.height;
+		meta->data.u.img.rect_valid = metaLast->data.u.img.rect_valid;
+	}
+	else if (cmd == ago_kernel_cmd_initialize) {
+		// initialize the fused nodes, create image views, and reserve strip buffers for intermediate images
+		for (AgoNode * anode : node->fusedNodeList) {
+			status = agoInitializeNode(anode);
+			if (status)
+				return status;
+		}
+		for (AgoData * data : node->fusedViewList)
+			delete data;
+		node->fusedViewList.clear();
+		for (AgoNode * anode : node->fusedNodeList) {
+			for (vx_uint32 arg = 0; arg < anode->paramCount; arg++) {
+				AgoData * data = anode->paramList[arg];
+				if (data && data->ref.type == VX_TYPE_IMAGE) {
+					AgoData * dataView = new AgoData;
+					dataView->ref.type = VX_TYPE_IMAGE;
+					node->fusedViewList.push_back(dataView);
+				}
+			}
+		}
+		for (size_t i = 0; i < node->fusedNodeList.size() - 1; i++) {
+			if (agoDataSanityCheckAndUpdate(node->fusedNodeList[i]->paramList[0]))
+				return VX_FAILURE;
+		}
+		vx_uint32 stripHeight = FusedElemwise_StripHeight(node);
+		node->localDataSize = 0;
+		for (size_t i = 0; i < node->fusedNodeList.size() - 1; i++) {
+			node->localDataSize += FusedElemwise_StripBufferSize(node->fusedNodeList[i]->paramList[0], stripHeight);
+		}
+		status = VX_SUCCESS;
+	}
+	else if (cmd == ago_kernel_cmd_shutdown) {
+		status = VX_SUCCESS;
+		for (AgoNode * anode : node->fusedNodeList) {
+			if (agoShutdownNode(anode))
+				status = VX_FAILURE;
+		}
+		for (AgoData * data : node->fusedViewList)
+			delete data;
+		node->fusedViewList.clear();
+	}
+	else if (cmd == ago_kernel_cmd_query_target_support) {
+		node->target_support_flags = 0
+					| AGO_KERNEL_FLAG_DEVICE_CPU
+					;
+		status = VX_SUCCESS;
+	}
+	return status;
+}
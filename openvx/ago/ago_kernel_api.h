@@ -254,6 +254,8 @@ int agoKernel_ScaleGaussianHalf_U8_U8_5x5(AgoNode * node, AgoKernelCommand cmd);
 int agoKernel_ScaleGaussianOrb_U8_U8_5x5(AgoNode * node, AgoKernelCommand cmd);
 int agoKernel_Convolve_U8_U8(AgoNode * node, AgoKernelCommand cmd);
 int agoKernel_Convolve_S16_U8(AgoNode * node, AgoKernelCommand cmd);
+int agoKernel_Convolve_U8_U8_Separable(AgoNode * node, AgoKernelCommand cmd);
+int agoKernel_Convolve_S16_U8_Separable(AgoNode * node, AgoKernelCommand cmd);
 int agoKernel_LinearFilter_ANY_ANY(AgoNode * node, AgoKernelCommand cmd);
 int agoKernel_LinearFilter_ANYx2_ANY(AgoNode * node, AgoKernelCommand cmd);
 int agoKernel_SobelMagnitude_S16_U8_3x3(AgoNode * node, AgoKernelCommand cmd);
@@ -312,6 +314,10 @@ int agoKernel_WarpPerspective_U8_U8_Nearest(AgoNode * node, AgoKernelCommand cmd
 int agoKernel_WarpPerspective_U8_U8_Nearest_Constant(AgoNode * node, AgoKernelCommand cmd);
 int agoKernel_WarpPerspective_U8_U8_Bilinear(AgoNode * node, AgoKernelCommand cmd);
 int agoKernel_WarpPerspective_U8_U8_Bilinear_Constant(AgoNode * node, AgoKernelCommand cmd);
+int agoKernel_WarpAffine_U8_U8_Nearest_Replicate(AgoNode * node, AgoKernelCommand cmd);
+int agoKernel_WarpAffine_U8_U8_Bilinear_Replicate(AgoNode * node, AgoKernelCommand cmd);
+int agoKernel_WarpPerspective_U8_U8_Nearest_Replicate(AgoNode * node, AgoKernelCommand cmd);
+int agoKernel_WarpPerspective_U8_U8_Bilinear_Replicate(AgoNode * node, AgoKernelCommand cmd);
 int agoKernel_ScaleImage_U8_U8_Nearest(AgoNode * node, AgoKernelCommand cmd);
 int agoKernel_ScaleImage_U8_U8_Bilinear(AgoNode * node, AgoKernelCommand cmd);
 int agoKernel_ScaleImage_U8_U8_Bilinear_Replicate(AgoNode * node, AgoKernelCommand cmd);
@@ -354,5 +360,6 @@ int agoKernel_MinMaxLoc_DATA_S16DATA_Loc_MinMax_Count_MinMax(AgoNode * node, Ago
 int agoKernel_MinMaxLocMerge_DATA_DATA(AgoNode * node, AgoKernelCommand cmd);
 int agoKernel_Copy_DATA_DATA(AgoNode * node, AgoKernelCommand cmd);
 int agoKernel_Select_DATA_DATA_DATA(AgoNode * node, AgoKernelCommand cmd);
+int agoKernel_FusedElemwise_ANY_ANY(AgoNode * node, AgoKernelCommand cmd);
 
 #endif // __ago_kernels_api_h__
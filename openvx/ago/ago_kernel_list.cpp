@@ -51,12 +51,13 @@ THE SOFTWARE.
 #define AOUT_AINx2_AOPTIN                      { AOUT, AIN, AIN, AOPTIN }
 #define AOUT_AINx3                             { AOUT, AIN, AIN, AIN }
 #define AOUT_AINx4                             { AOUT, AIN, AIN, AIN, AIN }
-#define AOUT_AINx8                             { AOUT, AIN, AIN, AIN, AIN, AIN, AIN, AIN, AIN }
 #define AOUT_AINx9                             { AOUT, AIN, AIN, AIN, AIN, AIN, AIN, AIN, AIN, AIN }
 #define AOUTx2_AIN                             { AOUT, AOUT, AIN }
 #define AOUTx2_AINx2                           { AOUT, AOUT, AIN, AIN }
 #define AOUTx2_AINx2_AOPTIN                    { AOUT, AOUT, AIN, AIN, AOPTIN }
 #define AOUTx2_AINx3                           { AOUT, AOUT, AIN, AIN, AIN }
+#define AOUTx2_AINx5                           { AOUT, AOUT, AIN, AIN, AIN, AIN, AIN }
+#define AOUTx2_AINx12                          { AOUT, AOUT, AIN, AIN, AIN, AIN, AIN, AIN, AIN, AIN, AIN, AIN, AIN, AIN }
 #define AOUTx3_AIN                             { AOUT, AOUT, AOUT, AIN }
 #define AOUTx3_AINx2                           { AOUT, AOUT, AOUT, AIN, AIN }
 #define AOUTx4_AIN                             { AOUT, AOUT, AOUT, AOUT, AIN }
@@ -76,6 +77,7 @@ THE SOFTWARE.
 #define AOUT_AOPTOUT_AINx4                     { AOUT, AOPTOUT, AIN, AIN, AIN, AIN }
 #define AOUT_AOPTOUTx2_AINx2                   { AOUT, AOPTOUT, AOPTOUT, AIN, AIN }
 #define AOUTx2_AOPTOUTx2_AINx2                 { AOUT, AOUT, AOPTOUT, AOPTOUT, AIN, AIN }
+#define AOUT_AOPTINx15                         { AOUT, AOPTIN, AOPTIN, AOPTIN, AOPTIN, AOPTIN, AOPTIN, AOPTIN, AOPTIN, AOPTIN, AOPTIN, AOPTIN, AOPTIN, AOPTIN, AOPTIN, AOPTIN }
 
 // for argType[]
 #define ATYPE_I                                { VX_TYPE_IMAGE }
@@ -121,9 +123,9 @@ THE SOFTWARE.
 #define ATYPE_IIRS                             { VX_TYPE_IMAGE, VX_TYPE_IMAGE, VX_TYPE_REMAP, VX_TYPE_SCALAR }
 #define ATYPE_IIMS                             { VX_TYPE_IMAGE, VX_TYPE_IMAGE, VX_TYPE_MATRIX, VX_TYPE_SCALAR }
 #define ATYPE_IIx                              { VX_TYPE_IMAGE, VX_TYPE_IMAGE, AGO_TYPE_SCALE_MATRIX }
-#define ATYPE_AAA                              { VX_TYPE_ARRAY, VX_TYPE_ARRAY, VX_TYPE_ARRAY }
-#define ATYPE_AAAAS                            { VX_TYPE_ARRAY, VX_TYPE_ARRAY, VX_TYPE_ARRAY, VX_TYPE_ARRAY, VX_TYPE_SCALAR }
-#define ATYPE_AAIISSSSS                        { VX_TYPE_ARRAY, VX_TYPE_ARRAY, VX_TYPE_IMAGE, VX_TYPE_IMAGE, VX_TYPE_SCALAR, VX_TYPE_SCALAR, VX_TYPE_SCALAR, VX_TYPE_SCALAR, VX_TYPE_SCALAR }
+#define ATYPE_AA                               { VX_TYPE_ARRAY, VX_TYPE_ARRAY }
+#define ATYPE_AAAASSS                          { VX_TYPE_ARRAY, VX_TYPE_ARRAY, VX_TYPE_ARRAY, VX_TYPE_ARRAY, VX_TYPE_SCALAR, VX_TYPE_SCALAR, VX_TYPE_SCALAR }
+#define ATYPE_AAAAAIISSSSSSS                   { VX_TYPE_ARRAY, VX_TYPE_ARRAY, VX_TYPE_ARRAY, VX_TYPE_ARRAY, VX_TYPE_ARRAY, VX_TYPE_IMAGE, VX_TYPE_IMAGE, VX_TYPE_SCALAR, VX_TYPE_SCALAR, VX_TYPE_SCALAR, VX_TYPE_SCALAR, VX_TYPE_SCALAR, VX_TYPE_SCALAR, VX_TYPE_SCALAR }
 #define ATYPE_APPAASSSSS                       { VX_TYPE_ARRAY, VX_TYPE_PYRAMID, VX_TYPE_PYRAMID, VX_TYPE_ARRAY, VX_TYPE_ARRAY, VX_TYPE_SCALAR, VX_TYPE_SCALAR, VX_TYPE_SCALAR, VX_TYPE_SCALAR, VX_TYPE_SCALAR }
 #define ATYPE_ASAAAAAAAA                       { VX_TYPE_ARRAY, VX_TYPE_SCALAR, VX_TYPE_ARRAY, VX_TYPE_ARRAY, VX_TYPE_ARRAY, VX_TYPE_ARRAY, VX_TYPE_ARRAY, VX_TYPE_ARRAY, VX_TYPE_ARRAY, VX_TYPE_ARRAY }
 #define ATYPE_Ic                               { VX_TYPE_IMAGE, AGO_TYPE_CANNY_STACK }
@@ -395,6 +397,8 @@ static struct {
 	AGO_KERNEL_ENTRY( VX_KERNEL_AMD_SCALE_GAUSSIAN_ORB_U8_U8_5x5                            , 1, 1, ScaleGaussianOrb_U8_U8_5x5, AOUT_AIN,                         ATYPE_II                , KOP_UNKNOWN   , false ),
 	AGO_KERNEL_ENTRY( VX_KERNEL_AMD_CONVOLVE_U8_U8                                          , 1, 1, Convolve_U8_U8, AOUT_AINx2,                                   ATYPE_IIC               , KOP_UNKNOWN   , false ),
 	AGO_KERNEL_ENTRY( VX_KERNEL_AMD_CONVOLVE_S16_U8                                         , 1, 1, Convolve_S16_U8, AOUT_AINx2,                                  ATYPE_IIC               , KOP_UNKNOWN   , false ),
+	AGO_KERNEL_ENTRY( VX_KERNEL_AMD_CONVOLVE_U8_U8_SEPARABLE                                , 1, 1, Convolve_U8_U8_Separable, AOUT_AINx2,                         ATYPE_IIC               , KOP_UNKNOWN   , false ),
+	AGO_KERNEL_ENTRY( VX_KERNEL_AMD_CONVOLVE_S16_U8_SEPARABLE                               , 1, 1, Convolve_S16_U8_Separable, AOUT_AINx2,                        ATYPE_IIC               , KOP_UNKNOWN   , false ),
 	AGO_KERNEL_ENTRY( VX_KERNEL_AMD_LINEAR_FILTER_ANY_ANY                                   , 1, 1, LinearFilter_ANY_ANY, AOUT_AINx2,                             ATYPE_IIM               , KOP_UNKNOWN   , false ),
 	AGO_KERNEL_ENTRY( VX_KERNEL_AMD_LINEAR_FILTER_ANYx2_ANY                                 , 1, 1, LinearFilter_ANYx2_ANY, AOUTx2_AINx3,                         ATYPE_IIIMM             , KOP_UNKNOWN   , false ),
 	AGO_KERNEL_ENTRY( VX_KERNEL_AMD_SOBEL_MAGNITUDE_S16_U8_3x3                              , 1, 1, SobelMagnitude_S16_U8_3x3, AOUT_AIN,                          ATYPE_II                , KOP_FIXED(3)  , false ),
@@ -435,7 +439,7 @@ static struct {
 	AGO_KERNEL_ENTRY( VX_KERNEL_AMD_CANNY_SOBEL_U16_U8_5x5_L2NORM                           , 1, 1, CannySobel_U16_U8_5x5_L2NORM, AOUT_AIN,                       ATYPE_II                , KOP_FIXED(5)  , false ),
 	AGO_KERNEL_ENTRY( VX_KERNEL_AMD_CANNY_SOBEL_U16_U8_7x7_L1NORM                           , 1, 1, CannySobel_U16_U8_7x7_L1NORM, AOUT_AIN,                       ATYPE_II                , KOP_FIXED(7)  , false ),
 	AGO_KERNEL_ENTRY( VX_KERNEL_AMD_CANNY_SOBEL_U16_U8_7x7_L2NORM                           , 1, 1, CannySobel_U16_U8_7x7_L2NORM, AOUT_AIN,                       ATYPE_II                , KOP_FIXED(7)  , false ),
-	AGO_KERNEL_ENTRY( VX_KERNEL_AMD_CANNY_SUPP_THRESHOLD_U8_U16_3x3                         , 0, 1, CannySuppThreshold_U8_U16_3x3, AOUT_AINx2_AOPTIN,             ATYPE_IITS              , KOP_FIXED(3)  , false ),
+	AGO_KERNEL_ENTRY( VX_KERNEL_AMD_CANNY_SUPP_THRESHOLD_U8_U16_3x3                         , 1, 1, CannySuppThreshold_U8_U16_3x3, AOUT_AINx2_AOPTIN,             ATYPE_IITS              , KOP_FIXED(3)  , false ),
 	AGO_KERNEL_ENTRY( VX_KERNEL_AMD_CANNY_SUPP_THRESHOLD_U8XY_U16_3x3                       , 1, 1, CannySuppThreshold_U8XY_U16_3x3, AOUTx2_AINx2_AOPTIN,         ATYPE_IcITS             , KOP_FIXED(3)  , false ),
 	AGO_KERNEL_ENTRY( VX_KERNEL_AMD_NON_MAX_SUPP_XY_ANY_3x3                                 , 0, 1, NonMaxSupp_XY_ANY_3x3, AOUT_AIN,                              ATYPE_AI                , KOP_FIXED(3)  , false ),
 	AGO_KERNEL_ENTRY( VX_KERNEL_AMD_REMAP_U8_U8_NEAREST                                     , 1, 1, Remap_U8_U8_Nearest, AOUT_AINx2,                              ATYPE_IIR               , KOP_UNKNOWN   , true  ),
@@ -453,19 +457,23 @@ static struct {
 	AGO_KERNEL_ENTRY( VX_KERNEL_AMD_WARP_PERSPECTIVE_U8_U8_NEAREST_CONSTANT                 , 1, 1, WarpPerspective_U8_U8_Nearest_Constant, AOUT_AINx3,           ATYPE_IIMS              , KOP_UNKNOWN   , true  ),
 	AGO_KERNEL_ENTRY( VX_KERNEL_AMD_WARP_PERSPECTIVE_U8_U8_BILINEAR                         , 1, 1, WarpPerspective_U8_U8_Bilinear, AOUT_AINx2,                   ATYPE_IIM               , KOP_UNKNOWN   , true  ),
 	AGO_KERNEL_ENTRY( VX_KERNEL_AMD_WARP_PERSPECTIVE_U8_U8_BILINEAR_CONSTANT                , 1, 1, WarpPerspective_U8_U8_Bilinear_Constant, AOUT_AINx3,          ATYPE_IIMS              , KOP_UNKNOWN   , true  ),
+	AGO_KERNEL_ENTRY( VX_KERNEL_AMD_WARP_AFFINE_U8_U8_NEAREST_REPLICATE                     , 1, 0, WarpAffine_U8_U8_Nearest_Replicate, AOUT_AINx2,               ATYPE_IIM               , KOP_UNKNOWN   , true  ),
+	AGO_KERNEL_ENTRY( VX_KERNEL_AMD_WARP_AFFINE_U8_U8_BILINEAR_REPLICATE                    , 1, 0, WarpAffine_U8_U8_Bilinear_Replicate, AOUT_AINx2,              ATYPE_IIM               , KOP_UNKNOWN   , true  ),
+	AGO_KERNEL_ENTRY( VX_KERNEL_AMD_WARP_PERSPECTIVE_U8_U8_NEAREST_REPLICATE                , 1, 0, WarpPerspective_U8_U8_Nearest_Replicate, AOUT_AINx2,          ATYPE_IIM               , KOP_UNKNOWN   , true  ),
+	AGO_KERNEL_ENTRY( VX_KERNEL_AMD_WARP_PERSPECTIVE_U8_U8_BILINEAR_REPLICATE               , 1, 0, WarpPerspective_U8_U8_Bilinear_Replicate, AOUT_AINx2,         ATYPE_IIM               , KOP_UNKNOWN   , true  ),
 	AGO_KERNEL_ENTRY( VX_KERNEL_AMD_SCALE_IMAGE_U8_U8_NEAREST                               , 1, 1, ScaleImage_U8_U8_Nearest, AOUT_AIN,                           ATYPE_II                , KOP_UNKNOWN   , false ),
 	AGO_KERNEL_ENTRY( VX_KERNEL_AMD_SCALE_IMAGE_U8_U8_BILINEAR                              , 1, 1, ScaleImage_U8_U8_Bilinear, AOUT_AIN,                          ATYPE_II                , KOP_UNKNOWN   , false ),
 	AGO_KERNEL_ENTRY( VX_KERNEL_AMD_SCALE_IMAGE_U8_U8_BILINEAR_REPLICATE                    , 1, 1, ScaleImage_U8_U8_Bilinear_Replicate, AOUT_AIN,                ATYPE_II                , KOP_UNKNOWN   , false ),
 	AGO_KERNEL_ENTRY( VX_KERNEL_AMD_SCALE_IMAGE_U8_U8_BILINEAR_CONSTANT                     , 1, 1, ScaleImage_U8_U8_Bilinear_Constant, AOUT_AINx2,               ATYPE_IIS               , KOP_UNKNOWN   , false ),
 	AGO_KERNEL_ENTRY( VX_KERNEL_AMD_SCALE_IMAGE_U8_U8_AREA                                  , 1, 1, ScaleImage_U8_U8_Area, AOUT_AIN,                              ATYPE_II                , KOP_UNKNOWN   , false ),
 	AGO_KERNEL_ENTRY( VX_KERNEL_AMD_OPTICAL_FLOW_PYR_LK_XY_XY                               , 1, 1, OpticalFlowPyrLK_XY_XY, AOUT_AINx9,                           ATYPE_APPAASSSSS        , KOP_UNKNOWN   , false ),
-	AGO_KERNEL_ENTRY( VX_KERNEL_AMD_OPTICAL_FLOW_PREPARE_LK_XY_XY                           , 1, 1, OpticalFlowPrepareLK_XY_XY, AOUT_AINx4,                       ATYPE_AAAAS             , KOP_UNKNOWN   , false ),
-	AGO_KERNEL_ENTRY( VX_KERNEL_AMD_OPTICAL_FLOW_IMAGE_LK_XY_XY                             , 1, 1, OpticalFlowImageLK_XY_XY, AOUT_AINx8,                         ATYPE_AAIISSSSS         , KOP_UNKNOWN   , false ),
-	AGO_KERNEL_ENTRY( VX_KERNEL_AMD_OPTICAL_FLOW_FINAL_LK_XY_XY                             , 1, 1, OpticalFlowFinalLK_XY_XY, AOUT_AINx2,                         ATYPE_AAA               , KOP_UNKNOWN   , false ),
+	AGO_KERNEL_ENTRY( VX_KERNEL_AMD_OPTICAL_FLOW_PREPARE_LK_XY_XY                           , 1, 1, OpticalFlowPrepareLK_XY_XY, AOUTx2_AINx5,                     ATYPE_AAAASSS           , KOP_UNKNOWN   , false ),
+	AGO_KERNEL_ENTRY( VX_KERNEL_AMD_OPTICAL_FLOW_IMAGE_LK_XY_XY                             , 1, 1, OpticalFlowImageLK_XY_XY, AOUTx2_AINx12,                      ATYPE_AAAAAIISSSSSSS    , KOP_UNKNOWN   , false ),
+	AGO_KERNEL_ENTRY( VX_KERNEL_AMD_OPTICAL_FLOW_FINAL_LK_XY_XY                             , 1, 1, OpticalFlowFinalLK_XY_XY, AOUT_AIN,                           ATYPE_AA                , KOP_UNKNOWN   , false ),
 	AGO_KERNEL_ENTRY( VX_KERNEL_AMD_HARRIS_MERGE_SORT_AND_PICK_XY_HVC                       , 1, 0, HarrisMergeSortAndPick_XY_HVC, AOUT_AOPTOUT_AINx2,            ATYPE_ASIS              , KOP_UNKNOWN   , false ),
 	AGO_KERNEL_ENTRY( VX_KERNEL_AMD_HARRIS_MERGE_SORT_AND_PICK_XY_XYS                       , 1, 0, HarrisMergeSortAndPick_XY_XYS, AOUT_AOPTOUT_AINx4,            ATYPE_ASASSS            , KOP_UNKNOWN   , false ),
 	AGO_KERNEL_ENTRY( VX_KERNEL_AMD_FAST_CORNER_MERGE_XY_XY                                 , 1, 0, FastCornerMerge_XY_XY, AOUTx2_AIN_AOPTINx7,                   ATYPE_ASAAAAAAAA        , KOP_UNKNOWN   , false ),
-	AGO_KERNEL_ENTRY( VX_KERNEL_AMD_CANNY_EDGE_TRACE_U8_U8                                  , 1, 0, CannyEdgeTrace_U8_U8, AINOUT_AIN,                             ATYPE_Ic                , KOP_UNKNOWN   , false ),
+	AGO_KERNEL_ENTRY( VX_KERNEL_AMD_CANNY_EDGE_TRACE_U8_U8                                  , 1, 0, CannyEdgeTrace_U8_U8, { AINOUT },                             ATYPE_I                 , KOP_UNKNOWN   , false ),
 	AGO_KERNEL_ENTRY( VX_KERNEL_AMD_CANNY_EDGE_TRACE_U8_U8XY                                , 1, 0, CannyEdgeTrace_U8_U8XY, AINOUT_AIN,                           ATYPE_Ic                , KOP_UNKNOWN   , false ),
 	AGO_KERNEL_ENTRY( VX_KERNEL_AMD_INTEGRAL_IMAGE_U32_U8                                   , 1, 0, IntegralImage_U32_U8, AOUT_AIN,                               ATYPE_II                , KOP_UNKNOWN   , false ),
 	AGO_KERNEL_ENTRY( VX_KERNEL_AMD_HISTOGRAM_DATA_U8                                       , 1, 0, Histogram_DATA_U8, AOUT_AIN,                                  ATYPE_DI                , KOP_UNKNOWN   , false ),
@@ -495,6 +503,7 @@ static struct {
 	AGO_KERNEL_ENTRY( VX_KERNEL_AMD_MIN_MAX_LOC_MERGE_DATA_DATA                             , 1, 0, MinMaxLocMerge_DATA_DATA, AOUTx2_AIN_AOPTINx7,                ATYPE_SAAAAAAAAA        , KOP_UNKNOWN   , false ),
 	AGO_KERNEL_ENTRY( VX_KERNEL_AMD_COPY_DATA_DATA                                          , 1, 1, Copy_DATA_DATA, AOUT_AIN,                                     ATYPE_RR                , KOP_UNKNOWN   , false ),
 	AGO_KERNEL_ENTRY( VX_KERNEL_AMD_SELECT_DATA_DATA_DATA                                   , 1, 1, Select_DATA_DATA_DATA, AOUT_AIN,                              ATYPE_RSRR              , KOP_UNKNOWN   , false ),
+	AGO_KERNEL_ENTRY( VX_KERNEL_AMD_FUSED_ELEMWISE_ANY_ANY                                  , 1, 0, FusedElemwise_ANY_ANY, AOUT_AOPTINx15,                        ATYPE_I                 , KOP_ELEMWISE  , false ),
 #undef AGO_KERNEL_ENTRY
 #undef OVX_KERNEL_ENTRY
 };
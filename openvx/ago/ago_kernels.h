@@ -272,7 +272,7 @@ enum vx_kernel_amd_e {
 	VX_KERNEL_AMD_COLOR_CONVERT_UV12_RGB,  // UV plane in NV12 4:2:0
 	VX_KERNEL_AMD_COLOR_CONVERT_UV12_RGBX, // UV plane in NV12 4:2:0
 
-	// Fixed Neighbors: U8 = op U8 (16)
+	// Fixed Neighbors: U8 = op U8 (17)
 	VX_KERNEL_AMD_BOX_U8_U8_3x3,
 	VX_KERNEL_AMD_DILATE_U8_U8_3x3,
 	VX_KERNEL_AMD_ERODE_U8_U8_3x3,
@@ -289,9 +289,11 @@ enum vx_kernel_amd_e {
 	VX_KERNEL_AMD_CANNY_SOBEL_SUPP_THRESHOLD_U8_U8_7x7_L1NORM,
 	VX_KERNEL_AMD_CANNY_SOBEL_SUPP_THRESHOLD_U8_U8_7x7_L2NORM,
 	VX_KERNEL_AMD_CONVOLVE_U8_U8,
+	VX_KERNEL_AMD_CONVOLVE_U8_U8_SEPARABLE,
 
-	// Fixed Neighbors: S16 = op U8 (2)
+	// Fixed Neighbors: S16 = op U8 (3)
 	VX_KERNEL_AMD_CONVOLVE_S16_U8,
+	VX_KERNEL_AMD_CONVOLVE_S16_U8_SEPARABLE,
 	VX_KERNEL_AMD_SOBEL_MAGNITUDE_S16_U8_3x3,
 
 	// Fixed Neighbors: S16U8 = op U8 (1)
@@ -357,7 +359,7 @@ enum vx_kernel_amd_e {
 	// Fixed Neighbors: xy = ANY (1)
 	VX_KERNEL_AMD_NON_MAX_SUPP_XY_ANY_3x3,
 
-	// Arbitrary Neighbors: U8 = op U8 (20)
+	// Arbitrary Neighbors: U8 = op U8 (24)
 	VX_KERNEL_AMD_REMAP_U8_U8_NEAREST,
 	VX_KERNEL_AMD_REMAP_U8_U8_NEAREST_CONSTANT,
 	VX_KERNEL_AMD_REMAP_U8_U8_BILINEAR,
@@ -370,6 +372,10 @@ enum vx_kernel_amd_e {
 	VX_KERNEL_AMD_WARP_PERSPECTIVE_U8_U8_NEAREST_CONSTANT,
 	VX_KERNEL_AMD_WARP_PERSPECTIVE_U8_U8_BILINEAR,
 	VX_KERNEL_AMD_WARP_PERSPECTIVE_U8_U8_BILINEAR_CONSTANT,
+	VX_KERNEL_AMD_WARP_AFFINE_U8_U8_NEAREST_REPLICATE,
+	VX_KERNEL_AMD_WARP_AFFINE_U8_U8_BILINEAR_REPLICATE,
+	VX_KERNEL_AMD_WARP_PERSPECTIVE_U8_U8_NEAREST_REPLICATE,
+	VX_KERNEL_AMD_WARP_PERSPECTIVE_U8_U8_BILINEAR_REPLICATE,
 	VX_KERNEL_AMD_SCALE_IMAGE_U8_U8_NEAREST,
 	VX_KERNEL_AMD_SCALE_IMAGE_U8_U8_BILINEAR,
 	VX_KERNEL_AMD_SCALE_IMAGE_U8_U8_BILINEAR_REPLICATE,
@@ -438,6 +444,9 @@ enum vx_kernel_amd_e {
 	VX_KERNEL_AMD_COPY_DATA_DATA,
 	VX_KERNEL_AMD_SELECT_DATA_DATA_DATA,
 
+	// kernels generated by graph optimizer
+	VX_KERNEL_AMD_FUSED_ELEMWISE_ANY_ANY,
+
 	VX_KERNEL_AMD_MAX_1_0, // Used for bounds checking in the internal conformance test
 };
 
@@ -46,6 +46,23 @@ bool agoIsCpuHardwareSupported()
 	return isHardwareSupported;
 }
 
+void agoGetCpuModelName(char * name, size_t size)
+{
+	// processor brand string from CPUID leaves 0x80000002..0x80000004
+	int CPUInfo[4] = { -1 };
+	char brand[49] = { 0 };
+	__cpuid(CPUInfo, 0x80000000);
+	if ((unsigned int)CPUInfo[0] >= 0x80000004) {
+		for (int i = 0; i < 3; i++) {
+			__cpuid(CPUInfo, 0x80000002 + i);
+			memcpy(brand + 16 * i, CPUInfo, 16);
+		}
+	}
+	const char * s = brand;
+	while (*s == ' ') s++;
+	snprintf(name, size, "%s", *s ? s : "unknown");
+}
+
 uint32_t agoControlFpSetRoundEven()
 {
 	uint32_t state;
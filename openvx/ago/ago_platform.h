@@ -49,6 +49,9 @@ THE SOFTWARE.
 #include <functional>
 #include <chrono>
 #include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
 using namespace std;
 
 #if _WIN32
@@ -56,8 +59,8 @@ using namespace std;
 #include <intrin.h>
 #else
 #include <dlfcn.h>
-#if __APPLE__
 #include <x86intrin.h>
+#if __APPLE__
 #include <cstdlib>
 #include <cmath>
 #endif
@@ -117,6 +120,7 @@ typedef struct _ago_module    * ago_module;
 
 // platform independent functions
 bool       agoIsCpuHardwareSupported();
+void       agoGetCpuModelName(char * name, size_t size);
 uint32_t   agoControlFpSetRoundEven();
 void       agoControlFpReset(uint32_t state);
 int64_t    agoGetClockCounter();
@@ -385,6 +385,39 @@ int agoRemoveNode(AgoNodeList * list, AgoNode * item, bool moveToTrash)
 	return status;
 }
 
+int agoRemoveNodes(AgoNodeList * list, std::map<AgoNode *, bool>& items, bool moveToTrash)
+{
+	// remove several nodes with one pass over the list: returns -1 if some of them are not in the list
+	size_t count = 0;
+	AgoNode * prev = NULL;
+	for (AgoNode * cur = list->head, * next; cur; cur = next) {
+		next = cur->next;
+		if (items.find(cur) == items.end()) {
+			prev = cur;
+			continue;
+		}
+		if (prev)
+			prev->next = next;
+		else
+			list->head = next;
+		if (list->tail == cur)
+			list->tail = prev;
+		list->count--;
+		count++;
+		if (moveToTrash) {
+			// still has external references, so keep into trash
+			cur->ref.internal_count = 0;
+			cur->next = list->trash;
+			list->trash = cur;
+		}
+		else {
+			// not needed anymore, just release it
+			delete cur;
+		}
+	}
+	return (count == items.size()) ? 0 : -1;
+}
+
 int agoRemoveData(AgoDataList * list, AgoData * item, AgoData ** trash)
 {
 	int status = -1;
@@ -2307,6 +2340,50 @@ int agoDataSanityCheckAndUpdate(AgoData * data)
 	return 0;
 }
 
+bool agoGetConvolutionSeparableFactors(AgoData * data, vx_int16 * hCoeff, vx_int16 * vCoeff)
+{
+	// check if the convolution coefficients can be factored as conv[r][c] = v[r] * h[c] using integers
+	if (!data || data->ref.type != VX_TYPE_CONVOLUTION || !data->buffer)
+		return false;
+	vx_int16 * conv = (vx_int16 *)data->buffer;
+	vx_int32 rows = (vx_int32)data->u.conv.rows, columns = (vx_int32)data->u.conv.columns;
+	if (rows < 1 || columns < 1 || rows > AGO_MAX_CONVOLUTION_DIM || columns > AGO_MAX_CONVOLUTION_DIM)
+		return false;
+	// pick a pivot element and use its row (divided by GCD) as the horizontal factor
+	vx_int32 r0 = -1, c0 = -1;
+	for (vx_int32 i = 0; i < rows * columns && r0 < 0; i++) {
+		if (conv[i]) {
+			r0 = i / columns;
+			c0 = i % columns;
+		}
+	}
+	if (r0 < 0)
+		return false;
+	vx_int32 gcd = 0;
+	for (vx_int32 c = 0; c < columns; c++) {
+		vx_int32 a = abs((vx_int32)conv[r0 * columns + c]), b = gcd;
+		while (b) { vx_int32 t = a % b; a = b; b = t; }
+		gcd = a;
+	}
+	vx_int16 h[AGO_MAX_CONVOLUTION_DIM], v[AGO_MAX_CONVOLUTION_DIM];
+	for (vx_int32 c = 0; c < columns; c++)
+		h[c] = (vx_int16)(conv[r0 * columns + c] / gcd);
+	for (vx_int32 r = 0; r < rows; r++) {
+		if (conv[r * columns + c0] % h[c0])
+			return false;
+		v[r] = (vx_int16)(conv[r * columns + c0] / h[c0]);
+	}
+	for (vx_int32 r = 0; r < rows; r++) {
+		for (vx_int32 c = 0; c < columns; c++) {
+			if ((vx_int32)v[r] * (vx_int32)h[c] != (vx_int32)conv[r * columns + c])
+				return false;
+		}
+	}
+	if (hCoeff) memcpy(hCoeff, h, columns * sizeof(vx_int16));
+	if (vCoeff) memcpy(vCoeff, v, rows * sizeof(vx_int16));
+	return true;
+}
+
 int agoAllocData(AgoData * data)
 {
 	if (data->buffer) {
@@ -2879,6 +2956,123 @@ void agoPerfCopyNormalize(AgoContext * context, vx_perf_t * perfDst, vx_perf_t *
 	perfDst->max = perfSrc->max * num / denom;
 }
 
+void agoOptimizerLogEntry(AgoGraph * graph, const char * pass, const char * action, const char * detail, ...)
+{
+	if (graph->enable_optimizer_log) {
+		char text[2048];
+		va_list ap;
+		va_start(ap, detail);
+		vsnprintf(text, sizeof(text) - 1, detail, ap);
+		va_end(ap);
+		text[sizeof(text) - 1] = 0;
+		AgoOptimizerLogEntry entry;
+		entry.pass = pass;
+		entry.action = action;
+		entry.detail = text;
+		entry.time = 0;
+		graph->optimizer_log.push_back(entry);
+	}
+}
+
+void agoOptimizerLogTime(AgoGraph * graph, const char * pass, int64_t& clockCounter)
+{
+	// record the time since clockCounter and restart it for the next step
+	int64_t time = agoGetClockCounter();
+	if (graph->enable_optimizer_log) {
+		AgoOptimizerLogEntry entry;
+		entry.pass = pass;
+		entry.action = "time";
+		entry.time = time - clockCounter;
+		graph->optimizer_log.push_back(entry);
+	}
+	clockCounter = time;
+}
+
+std::string agoGetNodeLogName(AgoNode * node)
+{
+	// kernel name followed by names of node arguments, "?" for unnamed data, without trailing null arguments
+	std::string name = node->akernel->name;
+	vx_uint32 paramCount = node->paramCount;
+	while (paramCount > 0 && !node->paramList[paramCount - 1])
+		paramCount--;
+	for (vx_uint32 arg = 0; arg < paramCount; arg++) {
+		char dataName[1024] = "null";
+		if (node->paramList[arg]) {
+			agoGetDataName(dataName, node->paramList[arg]);
+			if (!dataName[0]) strcpy(dataName, "?");
+		}
+		name += (arg == 0) ? "(" : ",";
+		name += dataName;
+	}
+	if (paramCount > 0)
+		name += ")";
+	return name;
+}
+
+int agoLoadTargetCostModel(AgoContext * context, const char * fileName)
+{
+	// file syntax, one entry per line:
+	//   cpu <nsec-per-byte>
+	//   gpu <nsec-per-byte>
+	//   transfer <nsec-per-byte> <nsec-latency>
+	//   kernel <kernel-name> <cpu-nsec-per-pixel> <gpu-nsec-per-pixel>
+	FILE * fp = fopen(fileName, "r");
+	if (!fp) {
+		agoAddLogEntry(&context->ref, VX_FAILURE, "ERROR: agoLoadTargetCostModel: unable to open: %s\n", fileName);
+		return -1;
+	}
+	AgoTargetCostModel& model = context->target_cost_model;
+	char line[1024];
+	for (int lineno = 1; fgets(line, sizeof(line), fp); lineno++) {
+		char word[256] = "", name[256] = "";
+		float cpu, gpu;
+		if (sscanf(line, "%255s", word) != 1 || word[0] == '#')
+			continue;
+		else if (!strcmp(word, "cpu") && sscanf(line, "%*s%f", &model.cpu_nsec_per_byte) == 1)
+			model.calibrated = true;
+		else if (!strcmp(word, "gpu") && sscanf(line, "%*s%f", &model.gpu_nsec_per_byte) == 1)
+			model.calibrated = true;
+		else if (!strcmp(word, "transfer") && sscanf(line, "%*s%f%f", &model.transfer_nsec_per_byte, &model.transfer_nsec_latency) == 2)
+			model.calibrated = true;
+		else if (!strcmp(word, "kernel") && sscanf(line, "%*s%255s%f%f", name, &cpu, &gpu) == 3) {
+			AgoTargetCost cost = { cpu, gpu };
+			model.kernel_cost[name] = cost;
+		}
+		else {
+			agoAddLogEntry(&context->ref, VX_FAILURE, "ERROR: agoLoadTargetCostModel: %s: line %d: invalid syntax: %s", fileName, lineno, line);
+			fclose(fp);
+			return -1;
+		}
+	}
+	fclose(fp);
+	return 0;
+}
+
+void agoCalibrateTargetCostModel(AgoContext * context)
+{
+	// measure memory throughput of CPU and GPU, and data sync between them, unless loaded from file
+	AgoTargetCostModel& model = context->target_cost_model;
+	if (model.calibrated)
+		return;
+	const size_t size = 8 << 20;
+	vx_uint8 * buf = new vx_uint8[2 * size]();
+	int64_t tcopy = INT64_MAX;
+	for (int i = 0; i < 4; i++) {
+		int64_t tstart = agoGetClockCounter();
+		memcpy(buf + size, buf, size);
+		tcopy = min(tcopy, agoGetClockCounter() - tstart);
+	}
+	delete[] buf;
+	model.cpu_nsec_per_byte = (float)(tcopy * 1.0e9 / agoGetClockFrequency() / (2 * size));
+#if ENABLE_OPENCL
+	if (context->opencl_context && agoGpuOclCalibrateTargetCostModel(context) < 0)
+		return;
+#endif
+	model.calibrated = true;
+	agoAddLogEntry(&context->ref, VX_SUCCESS, "OK: target cost model: cpu %.4f gpu %.4f transfer %.4f nsec/byte, transfer latency %.0f nsec\n",
+		model.cpu_nsec_per_byte, model.gpu_nsec_per_byte, model.transfer_nsec_per_byte, model.transfer_nsec_latency);
+}
+
 void agoRegisterLogCallback(vx_context context, vx_log_callback_f callback, vx_bool reentrant)
 {
 	if (agoIsValidContext(context)) {
@@ -2942,7 +3136,7 @@ AgoData::AgoData()
 #endif
 #endif
 	  opencl_buffer_offset{ 0 }, alias_data{ nullptr }, alias_offset{ 0 },
-	  isVirtual{ vx_false_e }, isDelayed{ vx_false_e }, isNotFullyConfigured{ vx_false_e }, isInitialized{ vx_false_e }, siblingIndex{ 0 },
+	  isVirtual{ vx_false_e }, isDelayed{ vx_false_e }, isNotFullyConfigured{ vx_false_e }, isInitialized{ vx_false_e }, isValueUsedByOptimizer{ vx_false_e }, siblingIndex{ 0 },
 	  numChildren{ 0 }, children{ nullptr }, parent{ nullptr }, inputUsageCount{ 0 }, outputUsageCount{ 0 }, inoutUsageCount{ 0 },
 	  initialization_flags{ 0 }, device_type_unused{ 0 },
 	  nextMapId{ 0 }, hierarchical_level{ 0 }, hierarchical_life_start{ 0 }, hierarchical_life_end{ 0 }, ownerOfUserBufferOpenCL{ nullptr }
@@ -3010,7 +3204,7 @@ AgoNode::AgoNode()
 	: next{ nullptr }, akernel{ nullptr }, flags{ 0 }, localDataSize{ 0 }, localDataPtr{ nullptr }, localDataPtr_allocated{ nullptr }, 
 	  valid_rect_reset{ vx_true_e }, valid_rect_num_inputs{ 0 }, valid_rect_num_outputs{ 0 }, valid_rect_inputs{ nullptr }, valid_rect_outputs{ nullptr },
 	  paramCount{ 0 }, callback{ nullptr }, supernode{ nullptr }, initialized{ false }, target_support_flags{ 0 }, hierarchical_level{ 0 }, status{ VX_SUCCESS }
-	, drama_divide_invoked{ false }
+	, drama_divide_invoked{ false }, rect_exec_partial{ false }, cpu_thread_limit{ 0 }, strip_size{ 0 }
 #if ENABLE_OPENCL
 	, opencl_type{ 0 }, opencl_param_mem2reg_mask{ 0 }, opencl_param_discard_mask{ 0 }, opencl_param_as_value_mask{ 0 },
 	  opencl_param_atomic_mask{ 0 }, opencl_local_buffer_usage_mask{ 0 }, opencl_local_buffer_size_in_bytes{ 0 }, opencl_work_dim{ 0 },
@@ -3020,6 +3214,7 @@ AgoNode::AgoNode()
 {
 	memset(&attr_border_mode, 0, sizeof(attr_border_mode));
 	memset(&attr_affinity, 0, sizeof(attr_affinity));
+	memset(&rect_exec, 0, sizeof(rect_exec));
 	memset(&paramList, 0, sizeof(paramList));
 	memset(&paramListForAgeDelay, 0, sizeof(paramListForAgeDelay));
 	memset(&funcExchange, 0, sizeof(funcExchange));
@@ -3034,6 +3229,9 @@ AgoNode::AgoNode()
 AgoNode::~AgoNode()
 {
 	agoShutdownNode(this);
+	for (AgoData * data : regionViewList)
+		delete data;
+	regionViewList.clear();
 	if (valid_rect_inputs) {
 		delete[] valid_rect_inputs;
 		valid_rect_inputs = nullptr;
@@ -3061,7 +3259,7 @@ AgoGraph::AgoGraph()
 	: next{ nullptr }, hThread{ nullptr }, hSemToThread{ nullptr }, hSemFromThread{ nullptr },
 	  threadScheduleCount{ 0 }, threadExecuteCount{ 0 }, threadWaitCount{ 0 }, threadThreadTerminationState{ 0 },
 	  isReadyToExecute{ vx_false_e }, detectedInvalidNode{ false }, status{ VX_SUCCESS },
-	  virtualDataGenerationCount{ 0 }, optimizer_flags{ AGO_GRAPH_OPTIMIZER_FLAGS_DEFAULT }, verified{ false }, enable_performance_profiling{ false }, execFrameCount{ 0 }
+	  virtualDataGenerationCount{ 0 }, optimizer_flags{ AGO_GRAPH_OPTIMIZER_FLAGS_DEFAULT }, verified{ false }, userParamRefCountValid{ false }, enable_performance_profiling{ false }, execFrameCount{ 0 }, enable_optimizer_log{ false }
 #if ENABLE_OPENCL
 	, supernodeList{ nullptr }, opencl_cmdq{ nullptr }, opencl_device{ nullptr }
 	, enable_node_level_opencl_flush{ true }
@@ -3126,6 +3324,18 @@ AgoContext::AgoContext()
 	memset(&opencl_build_options, 0, sizeof(opencl_build_options));
 #endif
 	memset(&attr_affinity, 0, sizeof(attr_affinity));
+	// default target cost model, until calibrated or loaded from file given by AGO_TARGET_COST_FILE
+	target_cost_model.calibrated = false;
+	target_cost_model.cpu_nsec_per_byte = 0.2f;
+	target_cost_model.gpu_nsec_per_byte = 0.05f;
+	target_cost_model.transfer_nsec_per_byte = 0.2f;
+	target_cost_model.transfer_nsec_latency = 50000.0f;
+	char textBuffer[1024];
+	if (agoGetEnvironmentVariable("AGO_TARGET_COST_FILE", textBuffer, sizeof(textBuffer))) {
+		if (agoLoadTargetCostModel(this, textBuffer) < 0) {
+			ref.status = VX_FAILURE;
+		}
+	}
 	// critical section
 	InitializeCriticalSection(&cs);
 	// initialize constants as enumerations with name "!<name>"
@@ -327,6 +327,47 @@ int agoGpuOclCreateContext(AgoContext * context, cl_context opencl_context)
 		return -1;
 	}
 
+	// measure throughput for CPU/GPU target cost model
+	agoCalibrateTargetCostModel(context);
+
+	return 0;
+}
+
+int agoGpuOclCalibrateTargetCostModel(AgoContext * context)
+{
+	// measure GPU memory throughput with buffer copies, and data sync with blocking buffer writes and reads
+	const size_t size = 8 << 20;
+	cl_int err = CL_SUCCESS, err2 = CL_SUCCESS;
+	cl_mem src = clCreateBuffer(context->opencl_context, CL_MEM_READ_WRITE, size, NULL, &err);
+	cl_mem dst = clCreateBuffer(context->opencl_context, CL_MEM_READ_WRITE, size, NULL, &err2);
+	vx_uint8 * host = new vx_uint8[size]();
+	if (!err) err = err2;
+	int64_t tsync = INT64_MAX, tcopy = INT64_MAX, tlatency = INT64_MAX;
+	for (int i = 0; i < 4 && !err; i++) {
+		int64_t t0 = agoGetClockCounter();
+		err = clEnqueueWriteBuffer(context->opencl_cmdq, src, CL_TRUE, 0, size, host, 0, NULL, NULL);
+		int64_t t1 = agoGetClockCounter();
+		if (!err) err = clEnqueueCopyBuffer(context->opencl_cmdq, src, dst, 0, 0, size, 0, NULL, NULL);
+		if (!err) err = clFinish(context->opencl_cmdq);
+		int64_t t2 = agoGetClockCounter();
+		if (!err) err = clEnqueueReadBuffer(context->opencl_cmdq, dst, CL_TRUE, 0, sizeof(cl_int), host, 0, NULL, NULL);
+		int64_t t3 = agoGetClockCounter();
+		tsync = min(tsync, t1 - t0);
+		tcopy = min(tcopy, t2 - t1);
+		tlatency = min(tlatency, t3 - t2);
+	}
+	delete[] host;
+	if (src) clReleaseMemObject(src);
+	if (dst) clReleaseMemObject(dst);
+	if (err) {
+		agoAddLogEntry(&context->ref, VX_FAILURE, "ERROR: agoGpuOclCalibrateTargetCostModel: OpenCL buffer write/copy/read => %d\n", err);
+		return -1;
+	}
+	AgoTargetCostModel& model = context->target_cost_model;
+	double nsec_per_clock = 1.0e9 / agoGetClockFrequency();
+	model.gpu_nsec_per_byte = (float)(tcopy * nsec_per_clock / (2 * size));
+	model.transfer_nsec_per_byte = (float)(tsync * nsec_per_clock / size);
+	model.transfer_nsec_latency = (float)(tlatency * nsec_per_clock);
 	return 0;
 }
 
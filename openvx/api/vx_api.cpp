@@ -626,15 +626,19 @@ VX_API_ENTRY vx_image VX_API_CALL vxCreateImageFromROI(vx_image img, const vx_re
 	if (agoIsValidData(master_img, VX_TYPE_IMAGE)) {
 		vx_context context = master_img->ref.context;
 		CAgoLock lock(context->cs);
+		// ROI of a virtual image belongs to the graph of its master image
+		AgoGraph * graph = master_img->isVirtual ? (AgoGraph *)master_img->ref.scope : NULL;
 		char desc[128]; sprintf(desc, "image-roi:%s,%d,%d,%d,%d", master_img->name.c_str(), rect->start_x, rect->start_y, rect->end_x, rect->end_y);
-		data = agoCreateDataFromDescription(context, NULL, desc, true);
+		data = agoCreateDataFromDescription(context, graph, desc, true);
 		if (data) {
-			agoGenerateDataName(context, "image-roi", data->name);
-			agoAddData(&context->dataList, data);
+			AgoDataList * dataList = graph ? &graph->dataList : &context->dataList;
+			if (graph) agoGenerateVirtualDataName(graph, "image-roi", data->name);
+			else agoGenerateDataName(context, "image-roi", data->name);
+			agoAddData(dataList, data);
 			// if data has children, add them too
 			if (data->children) {
 				for (vx_uint32 i = 0; i < data->numChildren; i++) {
-					agoAddData(&context->dataList, data->children[i]);
+					agoAddData(dataList, data->children[i]);
 				}
 			}
 		}
@@ -2442,8 +2446,13 @@ VX_API_ENTRY vx_status VX_API_CALL vxVerifyGraph(vx_graph graph)
 			agoWriteGraph(graph, NULL, 0, stdout, "*INPUT*");
 		}
 
+		// keep the optimizer log of this verification only
+		graph->optimizer_log.clear();
+		int64_t clockCounter = agoGetClockCounter();
+
 		// verify graph per OpenVX specification
 		status = agoVerifyGraph(graph);
+		agoOptimizerLogTime(graph, "verify", clockCounter);
 		if (status == VX_SUCCESS) {
 			graph->verified = vx_true_e;
 			// run graph optimizer
@@ -2454,6 +2463,10 @@ VX_API_ENTRY vx_status VX_API_CALL vxVerifyGraph(vx_graph graph)
 			else if (agoInitializeGraph(graph)) {
 				status = VX_FAILURE;
 			}
+			// pick the fastest kernel variants of CPU nodes
+			else if ((graph->optimizer_flags & AGO_GRAPH_OPTIMIZER_FLAG_AUTO_TUNE) && agoTuneGraph(graph)) {
+				status = VX_FAILURE;
+			}
 			// graph is ready to execute
 			else {
 				graph->isReadyToExecute = vx_true_e;
@@ -2609,6 +2622,10 @@ VX_API_ENTRY vx_status VX_API_CALL vxQueryGraph(vx_graph graph, vx_enum attribut
 			case VX_GRAPH_ATTRIBUTE_AMD_PERFORMANCE_INTERNAL_PROFILE:
 				status = agoGraphDumpPerformanceProfile(graph, (const char *)ptr);
 				break;
+			case VX_GRAPH_ATTRIBUTE_AMD_OPTIMIZER_LOG:
+			case VX_GRAPH_ATTRIBUTE_AMD_OPTIMIZER_LOG_JSON:
+				status = agoGraphDumpOptimizerLog(graph, (const char *)ptr, (attribute == VX_GRAPH_ATTRIBUTE_AMD_OPTIMIZER_LOG_JSON) ? true : false);
+				break;
 #if ENABLE_OPENCL
 			case VX_GRAPH_ATTRIBUTE_AMD_OPENCL_COMMAND_QUEUE:
 				if (size == sizeof(cl_command_queue)) {
@@ -2731,7 +2748,15 @@ VX_API_ENTRY vx_status VX_API_CALL vxAddParameterToGraph(vx_graph graph, vx_para
 VX_API_ENTRY vx_status VX_API_CALL vxSetGraphParameterByIndex(vx_graph graph, vx_uint32 index, vx_reference value)
 {
 	vx_status status = VX_ERROR_INVALID_REFERENCE;
-	if (agoIsValidGraph(graph) && !graph->verified) {
+	if (agoIsValidGraph(graph) && graph->verified) {
+		status = VX_ERROR_INVALID_PARAMETERS;
+		if ((index < graph->parameters.size()) && graph->parameters[index] && agoIsValidReference(value)) {
+			// replace data in the optimized graph, when possible, instead of verifying the graph again
+			vx_parameter parameter = graph->parameters[index];
+			status = vxSetParameterByIndex((vx_node)parameter->scope, parameter->index, value);
+		}
+	}
+	else if (agoIsValidGraph(graph)) {
 		status = VX_ERROR_INVALID_PARAMETERS;
 		if ((index < graph->parameters.size()) && graph->parameters[index] && (!value || agoIsValidReference(value))) {
 			vx_parameter parameter = graph->parameters[index];
@@ -3228,7 +3253,21 @@ VX_API_ENTRY vx_status VX_API_CALL vxSetParameterByIndex(vx_node node, vx_uint32
 		status = VX_ERROR_INVALID_PARAMETERS;
 		vx_graph graph = (AgoGraph *)node->ref.scope;
 		if (graph->verified) {
+			// replace data in the optimized graph, when it has same meta format: otherwise not supported
 			status = VX_ERROR_NOT_SUPPORTED;
+			AgoData * dataFind = (index < node->paramCount) ? node->paramList[index] : nullptr;
+			AgoData * dataReplace = (AgoData *)value;
+			if (dataFind && dataFind == dataReplace) {
+				status = VX_SUCCESS;
+			}
+			else if (dataFind && agoIsValidReference(value) && value->type == dataFind->ref.type) {
+				status = agoRebindDataInGraph(graph, dataFind, dataReplace);
+				if (status == VX_SUCCESS) {
+					agoReleaseData(dataFind, false);
+					node->paramList[index] = node->paramListForAgeDelay[index] = dataReplace;
+					agoRetainData(graph, dataReplace, false);
+				}
+			}
 		}
 		else if (node->parameters[index].state == VX_PARAMETER_STATE_REQUIRED && !value) {
 			status = VX_ERROR_INVALID_REFERENCE;
@@ -3637,7 +3676,10 @@ VX_API_ENTRY vx_status VX_API_CALL vxWriteScalarValue(vx_scalar ref, const void
 	AgoData * data = (AgoData *)ref;
 	if (agoIsValidData(data, VX_TYPE_SCALAR) && !data->isVirtual) {
 		status = VX_ERROR_INVALID_PARAMETERS;
-		if (ptr) {
+		if (data->ref.read_only) {
+			status = VX_ERROR_NOT_SUPPORTED;
+		}
+		else if (ptr) {
 			// TBD: need sem-lock for thread safety
 			status = VX_SUCCESS;
 			switch (data->u.scalar.type)
@@ -4307,6 +4349,9 @@ VX_API_ENTRY vx_status VX_API_CALL vxAccessLUT(vx_lut lut, void **ptr, vx_enum u
 		if (data->isVirtual && !data->buffer) {
 			status = VX_ERROR_OPTIMIZED_AWAY;
 		}
+		else if (data->ref.read_only && usage != VX_READ_ONLY) {
+			status = VX_ERROR_NOT_SUPPORTED;
+		}
 		else if (ptr) {
 			if (!data->buffer) {
 				CAgoLock lock(data->ref.context->cs);
@@ -4498,6 +4543,9 @@ VX_API_ENTRY vx_status VX_API_CALL vxMapLUT(vx_lut lut, vx_map_id *map_id, void
 		if (data->isVirtual && !data->buffer) {
 			status = VX_ERROR_OPTIMIZED_AWAY;
 		}
+		else if (data->ref.read_only && usage != VX_READ_ONLY) {
+			status = VX_ERROR_NOT_SUPPORTED;
+		}
 		else if (ptr) {
 			if (!data->buffer) {
 				CAgoLock lock(data->ref.context->cs);
@@ -5007,7 +5055,10 @@ VX_API_ENTRY vx_status VX_API_CALL vxSetThresholdAttribute(vx_threshold thresh,
 	AgoData * data = (AgoData *)thresh;
 	if (agoIsValidData(data, VX_TYPE_THRESHOLD)) {
 		status = VX_ERROR_INVALID_PARAMETERS;
-		if (ptr) {
+		if (data->ref.read_only) {
+			status = VX_ERROR_NOT_SUPPORTED;
+		}
+		else if (ptr) {
 			switch (attribute)
 			{
 			case VX_THRESHOLD_ATTRIBUTE_THRESHOLD_VALUE:
@@ -5657,6 +5708,7 @@ VX_API_ENTRY vx_status VX_API_CALL vxWriteConvolutionCoefficients(vx_convolution
 					for (vx_uint32 i = 0; i < N; i++)
 						pf[N - 1 - i] = scale * ps[i]; // NOTE: the reversing of coefficients order required to be able to re-use linear filter
 				}
+				data->u.conv.is_separable = agoGetConvolutionSeparableFactors(data, nullptr, nullptr);
 				// update sync flags
 				data->buffer_sync_flags &= ~AGO_BUFFER_SYNC_FLAG_DIRTY_MASK;
 				data->buffer_sync_flags |= AGO_BUFFER_SYNC_FLAG_DIRTY_BY_COMMIT;
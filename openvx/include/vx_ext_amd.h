@@ -131,6 +131,11 @@ enum vx_graph_attribute_amd_e {
 	VX_GRAPH_ATTRIBUTE_AMD_PERFORMANCE_INTERNAL_PROFILE = VX_ATTRIBUTE_BASE(VX_ID_AMD, VX_TYPE_GRAPH) + 0x07,
 	/*! \brief OpenCL command queue. Use a <tt>\ref cl_command_queue</tt> parameter.*/
 	VX_GRAPH_ATTRIBUTE_AMD_OPENCL_COMMAND_QUEUE         = VX_ATTRIBUTE_BASE(VX_ID_AMD, VX_TYPE_GRAPH) + 0x08,
+	/*! \brief graph optimizer log as text: time of each optimizer pass and its decisions, recorded at
+	* vxVerifyGraph when VX_DIRECTIVE_AMD_ENABLE_OPTIMIZER_LOG is given. Use a char * fileName parameter.*/
+	VX_GRAPH_ATTRIBUTE_AMD_OPTIMIZER_LOG                = VX_ATTRIBUTE_BASE(VX_ID_AMD, VX_TYPE_GRAPH) + 0x09,
+	/*! \brief graph optimizer log as JSON. Use a char * fileName parameter.*/
+	VX_GRAPH_ATTRIBUTE_AMD_OPTIMIZER_LOG_JSON           = VX_ATTRIBUTE_BASE(VX_ID_AMD, VX_TYPE_GRAPH) + 0x0A,
 };
 
 /*! \brief The AMD node attributes list.
@@ -189,6 +194,9 @@ enum vx_directive_amd_e {
 	VX_DIRECTIVE_AMD_DISABLE_PROFILE_CAPTURE = VX_ENUM_BASE(VX_ID_AMD, VX_ENUM_DIRECTIVE) + 0x04,
 	/*! \brief disable node level flush for a graph. */
 	VX_DIRECTIVE_AMD_DISABLE_OPENCL_FLUSH    = VX_ENUM_BASE(VX_ID_AMD, VX_ENUM_DIRECTIVE) + 0x05,
+	/*! \brief record optimizer pass times and decisions of a graph at vxVerifyGraph. */
+	VX_DIRECTIVE_AMD_ENABLE_OPTIMIZER_LOG    = VX_ENUM_BASE(VX_ID_AMD, VX_ENUM_DIRECTIVE) + 0x06,
+	VX_DIRECTIVE_AMD_DISABLE_OPTIMIZER_LOG   = VX_ENUM_BASE(VX_ID_AMD, VX_ENUM_DIRECTIVE) + 0x07,
 };
 
 /*! \brief An enumeration of additional memory type imports.
@@ -59,6 +59,9 @@ void show_usage(const char * program, bool detail)
 	printf("      Set context affinity to CPU or GPU.\n");
 	printf("  -dump-profile\n");
 	printf("      Print performance profiling information after graph launch.\n");
+	printf("  -dump-optimizer-log[:json]\n");
+	printf("      Print time of each graph optimizer pass and its decisions after graph\n");
+	printf("      verification, as text or JSON.\n");
 	printf("  -enable-profile\n");
 	printf("      use directive VX_DIRECTIVE_AMD_ENABLE_PROFILE_CAPTURE when graph is created\n");
 	printf("  -discard-compare-errors\n");
@@ -88,6 +91,7 @@ int main(int argc, char * argv[])
 	bool enableDumpGDF = false, enableScheduleGraph = false;
 	bool pauseBeforeExit = false, noPauseBeforeExit = false;
 	bool enableDumpProfile = false;
+	int dumpOptimizerLog = 0;
 	bool disableVirtual = false;
 	bool discardCompareErrors = false;
 	vx_uint32 defaultTargetAffinity = 0;
@@ -152,6 +156,12 @@ int main(int argc, char * argv[])
 			else if (!_stricmp(argv[arg], "-dump-profile")) {
 				enableDumpProfile = true;
 			}
+			else if (!_stricmp(argv[arg], "-dump-optimizer-log")) {
+				dumpOptimizerLog = 1;
+			}
+			else if (!_stricmp(argv[arg], "-dump-optimizer-log:json")) {
+				dumpOptimizerLog = 2;
+			}
 			else if (!_stricmp(argv[arg], "-enable-profile")) {
 				enableFullProfile = true;
 			}
@@ -215,6 +225,9 @@ int main(int argc, char * argv[])
 		if (dumpDataConfig.find(",") != std::string::npos) {
 			engine.SetDumpDataConfig(dumpDataConfig);
 		}
+		if (dumpOptimizerLog) {
+			engine.SetDumpOptimizerLog(dumpOptimizerLog);
+		}
 		engine.SetConfigOptions(verbose, discardCompareErrors, enableDumpProfile, enableDumpGDF, waitKeyDelayInMilliSeconds);
 		engine.SetFrameCountOptions(enableMultiFrameProcessing, framesEofRequested, frameCountSpecified, frameStart, frameEnd);
 		fflush(stdout);
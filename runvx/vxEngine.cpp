@@ -68,6 +68,7 @@ CVxEngine::CVxEngine()
 	m_enableScheduleGraph = false;
 	m_enableDumpProfile = false;
 	m_enableDumpGDF = false;
+	m_dumpOptimizerLog = 0;
 	m_enableMultiFrameProcessing = false;
 	m_framesEofRequested = false;
 	m_frameCountSpecified = false;
@@ -148,6 +149,13 @@ int CVxEngine::SetGraphOptimizerFlags(vx_uint32 graph_optimizer_flags)
 	return 0;
 }
 
+void CVxEngine::SetDumpOptimizerLog(int dumpOptimizerLog)
+{
+	// optimizer log is recorded by graphs verified after the directive
+	m_dumpOptimizerLog = dumpOptimizerLog;
+	vxDirective((vx_reference)m_graph, m_dumpOptimizerLog ? VX_DIRECTIVE_AMD_ENABLE_OPTIMIZER_LOG : VX_DIRECTIVE_AMD_DISABLE_OPTIMIZER_LOG);
+}
+
 void CVxEngine::SetDumpDataConfig(std::string dumpDataConfig)
 {
 	m_dumpDataEnabled = false;
@@ -248,6 +256,17 @@ int CVxEngine::DumpInternalGDF()
 	return 0;
 }
 
+int CVxEngine::DumpOptimizerLog()
+{
+	char fileName[] = "stdout";
+	vx_enum attribute = (m_dumpOptimizerLog == 2) ? VX_GRAPH_ATTRIBUTE_AMD_OPTIMIZER_LOG_JSON : VX_GRAPH_ATTRIBUTE_AMD_OPTIMIZER_LOG;
+	vx_status status = vxQueryGraph(m_graph, attribute, fileName, 0);
+	if (status != VX_SUCCESS)
+		ReportError("ERROR: vxQueryGraph(...,VX_GRAPH_ATTRIBUTE_AMD_OPTIMIZER_LOG,...) failed (%d)\n", status);
+	fflush(stdout);
+	return 0;
+}
+
 int CVxEngine::DumpGraphInfo(const char * graphName)
 {
 	vx_graph graph = m_graph;
@@ -311,6 +330,9 @@ int CVxEngine::ProcessGraph(std::vector<const char *> * graphNameList, size_t be
 		if (m_enableDumpGDF) {
 			DumpInternalGDF();
 		}
+		if (m_dumpOptimizerLog) {
+			DumpOptimizerLog();
+		}
 	}
 
 	// Finalize() on all objects in graph and check if multi-frame capture is enabled
@@ -711,6 +733,8 @@ int CVxEngine::BuildAndProcessGraphFromLine(int level, char * line)
 				vx_status status = vxGetStatus((vx_reference)m_graph);
 				if (status != VX_SUCCESS)
 					ReportError("ERROR: vxCreateGraph(context) failed (%d:%s)\n", status, ovxEnum2Name(status));
+				if (m_dumpOptimizerLog)
+					vxDirective((vx_reference)m_graph, VX_DIRECTIVE_AMD_ENABLE_OPTIMIZER_LOG);
 				if (m_verbose) printf("> reset current graph to empty\n");
 			}
 		}
@@ -725,6 +749,9 @@ int CVxEngine::BuildAndProcessGraphFromLine(int level, char * line)
 			if (m_enableDumpGDF) {
 				DumpInternalGDF();
 			}
+			if (m_dumpOptimizerLog) {
+				DumpOptimizerLog();
+			}
 			m_graphNameListForObj.insert(pair<string, vx_graph>(wordList[2], m_graph));
 			m_graphNameListForAge.insert(pair<string, std::vector<std::string> >(wordList[2], m_graphAutoAgeList));
 			// open a new graph with empty virtual object list and delay age-list
@@ -735,6 +762,8 @@ int CVxEngine::BuildAndProcessGraphFromLine(int level, char * line)
 			status = vxGetStatus((vx_reference)m_graph);
 			if (status != VX_SUCCESS)
 				ReportError("ERROR: vxCreateGraph(context) failed (%d:%s)\n", status, ovxEnum2Name(status));
+			if (m_dumpOptimizerLog)
+				vxDirective((vx_reference)m_graph, VX_DIRECTIVE_AMD_ENABLE_OPTIMIZER_LOG);
 			if (m_verbose) printf("> verified current graph as %s and created a new empty graph\n", wordList[2]);
 		}
 		else if (!_stricmp(wordList[1], "auto-age"))
@@ -1534,7 +1563,8 @@ void PrintHelpGDF(const char * command)
 		"        Supported for array, image, lut, and remap data objects only.\n"
 		"      - Use readonly directive to issue VX_DIRECTIVE_AMD_READ_ONLY directive\n"
 		"        that informs the OpenVX framework that object won't be updated after\n"
-		"        init command. Supported for convolution and matrix data objects only.\n"
+		"        init command. Supported for convolution, matrix, lut, scalar, and\n"
+		"        threshold data objects only.\n"
 		"\n"
 		);
 	if (strstr("pause", command)) printf(
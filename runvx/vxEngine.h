@@ -35,6 +35,7 @@ public:
 	void SetFrameCountOptions(bool enableMultiFrameProcessing, bool framesEofRequested, bool frameCountSpecified, int frameStart, int frameEnd);
 	int SetGraphOptimizerFlags(vx_uint32 graph_optimizer_flags);
 	void SetDumpDataConfig(std::string dumpDataConfig);
+	void SetDumpOptimizerLog(int dumpOptimizerLog);
 	int SetParameter(int index, const char * param);
 	int Shell(int level, FILE * fp = nullptr);
 	int BuildAndProcessGraph(int level, char * graphScript, bool importMode);
@@ -48,6 +49,7 @@ protected:
 	int BuildAndProcessGraphFromLine(int level, char * line);
 	int ProcessGraph(std::vector<const char *> * graphNameList = nullptr, size_t beginIndex = 0);
 	int DumpInternalGDF();
+	int DumpOptimizerLog();
 	int DumpGraphInfo(const char * graphName = nullptr);
 	int SyncFrame(int frameNumber);
 	int ReadFrame(int frameNumber);
@@ -81,6 +83,7 @@ private:
 	bool m_discardCompareErrors;
 	bool m_enableDumpProfile;
 	bool m_enableDumpGDF;
+	int m_dumpOptimizerLog; // 0: none, 1: text, 2: JSON
 	bool m_enableMultiFrameProcessing;
 	bool m_framesEofRequested;
 	bool m_frameCountSpecified;
@@ -151,6 +151,9 @@ int CVxParamLUT::InitializeIO(vx_context context, vx_graph graph, vx_reference r
 		else if (!_stricmp(ioType, "directive") && (!_stricmp(fileName, "VX_DIRECTIVE_AMD_COPY_TO_OPENCL") || !_stricmp(fileName, "sync-cl-write"))) {
 			m_useSyncOpenCLWriteDirective = true;
 		}
+		else if (!_stricmp(ioType, "directive") && !_stricmp(fileName, "readonly")) {
+			ERROR_CHECK(vxDirective((vx_reference)m_lut, VX_DIRECTIVE_AMD_READ_ONLY));
+		}
 		else ReportError("ERROR: invalid lut operation: %s\n", ioType);
 		if (*io_params == ':') io_params++;
 		else if (*io_params) ReportError("ERROR: unexpected character sequence in parameter specification: %s\n", io_params);
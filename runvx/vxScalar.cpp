@@ -178,6 +178,9 @@ int CVxParamScalar::InitializeIO(vx_context context, vx_graph graph, vx_referenc
 			ScanParameters(fileName, "{<id>;<min>;<max>;<inc>}", "{d;f;f;f}", &id, &valueMin, &valueMax, &valueInc);
 			GuiTrackBarInitializeScalar((vx_reference)m_scalar, id-1, valueMin, valueMax, valueInc);
 		}
+		else if (!_stricmp(ioType, "directive") && !_stricmp(fileName, "readonly")) {
+			ERROR_CHECK(vxDirective((vx_reference)m_scalar, VX_DIRECTIVE_AMD_READ_ONLY));
+		}
 		else ReportError("ERROR: invalid scalar operation: %s\n", ioType);
 		if (*io_params == ':') io_params++;
 		else if (*io_params) ReportError("ERROR: unexpected character sequence in parameter specification: %s\n", io_params);
@@ -116,6 +116,9 @@ int CVxParamThreshold::InitializeIO(vx_context context, vx_graph graph, vx_refer
 				ERROR_CHECK(vxSetThresholdAttribute(m_threshold, VX_THRESHOLD_ATTRIBUTE_THRESHOLD_VALUE, &value, sizeof(vx_int32)));
 			}
 		}
+		else if (!_stricmp(ioType, "directive") && !_stricmp(fileName, "readonly")) {
+			ERROR_CHECK(vxDirective((vx_reference)m_threshold, VX_DIRECTIVE_AMD_READ_ONLY));
+		}
 		else ReportError("ERROR: invalid threshold operation: %s\n", ioType);
 		if (*io_params == ':') io_params++;
 		else if (*io_params) ReportError("ERROR: unexpected character sequence in parameter specification: %s\n", io_params);
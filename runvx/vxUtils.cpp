@@ -87,6 +87,8 @@ static struct { const char * name; vx_enum value; } s_table_constants[] = {
 	{ "VX_DIRECTIVE_AMD_ENABLE_PROFILE_CAPTURE", VX_DIRECTIVE_AMD_ENABLE_PROFILE_CAPTURE },
 	{ "VX_DIRECTIVE_AMD_DISABLE_PROFILE_CAPTURE", VX_DIRECTIVE_AMD_DISABLE_PROFILE_CAPTURE },
 	{ "VX_DIRECTIVE_AMD_DISABLE_OPENCL_FLUSH", VX_DIRECTIVE_AMD_DISABLE_OPENCL_FLUSH },
+	{ "VX_DIRECTIVE_AMD_ENABLE_OPTIMIZER_LOG", VX_DIRECTIVE_AMD_ENABLE_OPTIMIZER_LOG },
+	{ "VX_DIRECTIVE_AMD_DISABLE_OPTIMIZER_LOG", VX_DIRECTIVE_AMD_DISABLE_OPTIMIZER_LOG },
 	{ "VX_MEMORY_TYPE_NONE", VX_MEMORY_TYPE_NONE },
 	{ "VX_MEMORY_TYPE_HOST", VX_MEMORY_TYPE_HOST },
 	{ "VX_MEMORY_TYPE_OPENCL", VX_MEMORY_TYPE_OPENCL },